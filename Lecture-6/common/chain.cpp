@@ -0,0 +1,532 @@
+/******************************************************************************\
+ *                                                                            *
+ * Copyright (c) 2012 Marat Dukhan                                            *
+ *                                                                            *
+ * This software is provided 'as-is', without any express or implied          *
+ * warranty. In no event will the authors be held liable for any damages      *
+ * arising from the use of this software.                                     *
+ *                                                                            *
+ * Permission is granted to anyone to use this software for any purpose,      *
+ * including commercial applications, and to alter it and redistribute it     *
+ * freely, subject to the following restrictions:                             *
+ *                                                                            *
+ * 1. The origin of this software must not be misrepresented; you must not    *
+ * claim that you wrote the original software. If you use this software       *
+ * in a product, an acknowledgment in the product documentation would be      *
+ * appreciated but is not required.                                           *
+ *                                                                            *
+ * 2. Altered source versions must be plainly marked as such, and must not be *
+ * misrepresented as being the original software.                             *
+ *                                                                            *
+ * 3. This notice may not be removed or altered from any source               *
+ * distribution.                                                              *
+ *                                                                            *
+\******************************************************************************/
+
+#include <chain.hpp>
+#include <stdlib.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <math.h>
+#include <new>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <chrono>
+#include <vector>
+#include <condition_variable>
+
+// Tiles start at multiples of this many elements, so that they keep the alignment of the arrays
+static const size_t chain_tile_granularity = 64;
+// L2 cache size if the system does not report it
+static const size_t chain_default_l2_size = 256 * 1024;
+// Number of yields before an idle worker goes to sleep
+static const size_t idle_spins_limit = 256;
+
+enum chain_array_kind {
+	chain_array_input,
+	chain_array_output,
+	chain_array_temporary
+};
+
+struct chain_array_info {
+	chain_array_kind kind;
+	double* pointer; // NULL for temporaries
+	size_t components;
+	size_t temporaryIndex;
+	bool written; // Set when a stage writes the array
+};
+
+enum chain_stage_kind {
+	chain_stage_map,
+	chain_stage_accumulate,
+	chain_stage_max
+};
+
+struct chain_stage {
+	chain_stage_kind kind;
+	chain_map_function map;
+	chain_accumulate_function accumulate;
+	chain_max_function max;
+	chain_array x;
+	chain_array y;
+	chain_array result;
+	double* maxPointer;
+	size_t reductionIndex;
+};
+
+struct kernel_chain {
+	size_t length;
+	size_t tileLength;
+	chain_array_info arrays[chain_max_arrays];
+	size_t arraysCount;
+	size_t temporariesCount;
+	chain_stage stages[chain_max_stages];
+	size_t stagesCount;
+	size_t reductionsCount;
+};
+
+// Range of tiles [begin, end) of a thread, packed as begin << 32 | end.
+// The owner takes tiles from the beginning, and other threads steal from the end.
+struct chain_range {
+	std::atomic<uint64_t> bounds;
+	char padding[64 - sizeof(std::atomic<uint64_t>)];
+};
+
+// State of one thread of a run. Temporary buffers are kept between runs of the same pool.
+struct chain_participant {
+	double* scratch;
+	size_t scratchCapacity;
+	double partials[chain_max_stages];
+};
+
+struct chain_run {
+	const kernel_chain* chain;
+	size_t tileLength;
+	size_t tilesCount;
+	size_t participantsCount;
+	chain_range* ranges;
+	chain_participant* participants;
+};
+
+struct chain_pool {
+	std::vector<std::thread> workers;
+	std::vector<chain_participant> participants; // participants[0] is the thread which calls kernel_chain_run
+	chain_run* run;
+	std::atomic<size_t> generation; // Incremented for every run
+	std::atomic<size_t> activeCount;
+	std::atomic<size_t> sleepingCount;
+	std::atomic<bool> stopping;
+	std::mutex sleepMutex;
+	std::condition_variable wakeup;
+};
+
+static size_t l2_cache_size() {
+#ifdef _SC_LEVEL2_CACHE_SIZE
+	const long size = sysconf(_SC_LEVEL2_CACHE_SIZE);
+	if (size > 0) {
+		return size_t(size);
+	}
+#endif
+	return chain_default_l2_size;
+}
+
+// Number of elements per tile for which all arrays of the chain take half of the L2 cache
+static size_t automatic_tile_length(const kernel_chain* chain) {
+	static const size_t cacheBudget = l2_cache_size() / 2;
+	size_t bytesPerElement = 0;
+	for (size_t array = 0; array < chain->arraysCount; array++) {
+		bytesPerElement += chain->arrays[array].components * sizeof(double);
+	}
+	if (bytesPerElement == 0) {
+		return chain_tile_granularity;
+	}
+	const size_t tileLength = cacheBudget / bytesPerElement / chain_tile_granularity * chain_tile_granularity;
+	return (tileLength != 0) ? tileLength : chain_tile_granularity;
+}
+
+static bool is_readable(const kernel_chain* chain, chain_array array) {
+	return (array < chain->arraysCount) && ((chain->arrays[array].kind == chain_array_input) || chain->arrays[array].written);
+}
+
+static bool is_writable(const kernel_chain* chain, chain_array array) {
+	return (array < chain->arraysCount) && (chain->arrays[array].kind != chain_array_input);
+}
+
+static chain_array add_array(kernel_chain* chain, chain_array_kind kind, double* pointer, size_t components) {
+	if (chain->arraysCount == chain_max_arrays) {
+		return chain_array_invalid;
+	}
+	chain_array_info& info = chain->arrays[chain->arraysCount];
+	info.kind = kind;
+	info.pointer = pointer;
+	info.components = components;
+	info.temporaryIndex = 0;
+	info.written = false;
+	if (kind == chain_array_temporary) {
+		info.temporaryIndex = chain->temporariesCount++;
+	}
+	return chain->arraysCount++;
+}
+
+static chain_stage* add_stage(kernel_chain* chain, chain_stage_kind kind) {
+	if (chain->stagesCount == chain_max_stages) {
+		return NULL;
+	}
+	chain_stage* stage = &chain->stages[chain->stagesCount++];
+	stage->kind = kind;
+	stage->map = NULL;
+	stage->accumulate = NULL;
+	stage->max = NULL;
+	stage->x = chain_array_invalid;
+	stage->y = chain_array_invalid;
+	stage->result = chain_array_invalid;
+	stage->maxPointer = NULL;
+	stage->reductionIndex = 0;
+	return stage;
+}
+
+void chain_accumulate_naive(const double* xPointer, double* yPointer, size_t length) {
+	for (size_t i = 0; i < length; i++) {
+		yPointer[i] += xPointer[i];
+	}
+}
+
+void chain_max_naive(const double* arrayPointer, double* maxPointer, size_t length) {
+	double max = -INFINITY;
+	for (size_t i = 0; i < length; i++) {
+		max = fmax(max, arrayPointer[i]);
+	}
+	*maxPointer = max;
+}
+
+kernel_chain* kernel_chain_create(size_t length) {
+	kernel_chain* chain = new (std::nothrow) kernel_chain;
+	if (chain == NULL) {
+		return NULL;
+	}
+	chain->length = length;
+	chain->tileLength = 0;
+	chain->arraysCount = 0;
+	chain->temporariesCount = 0;
+	chain->stagesCount = 0;
+	chain->reductionsCount = 0;
+	return chain;
+}
+
+void kernel_chain_destroy(kernel_chain* chain) {
+	delete chain;
+}
+
+void kernel_chain_set_tile_length(kernel_chain* chain, size_t tileLength) {
+	chain->tileLength = tileLength;
+}
+
+chain_array kernel_chain_input(kernel_chain* chain, const double* pointer, size_t components) {
+	if (components == 0) {
+		return chain_array_invalid;
+	}
+	return add_array(chain, chain_array_input, const_cast<double*>(pointer), components);
+}
+
+chain_array kernel_chain_output(kernel_chain* chain, double* pointer) {
+	return add_array(chain, chain_array_output, pointer, 1);
+}
+
+chain_array kernel_chain_temporary(kernel_chain* chain) {
+	return add_array(chain, chain_array_temporary, NULL, 1);
+}
+
+bool kernel_chain_map(kernel_chain* chain, chain_map_function map, chain_array x, chain_array y, chain_array result) {
+	if (!is_readable(chain, x) || !is_readable(chain, y) || !is_writable(chain, result) || (result == x) || (result == y)) {
+		return false;
+	}
+	chain_stage* stage = add_stage(chain, chain_stage_map);
+	if (stage == NULL) {
+		return false;
+	}
+	stage->map = map;
+	stage->x = x;
+	stage->y = y;
+	stage->result = result;
+	chain->arrays[result].written = true;
+	return true;
+}
+
+bool kernel_chain_accumulate(kernel_chain* chain, chain_accumulate_function accumulate, chain_array x, chain_array y) {
+	if (!is_readable(chain, x) || !is_readable(chain, y) || !is_writable(chain, y) || (x == y) || (chain->arrays[x].components != 1)) {
+		return false;
+	}
+	chain_stage* stage = add_stage(chain, chain_stage_accumulate);
+	if (stage == NULL) {
+		return false;
+	}
+	stage->accumulate = accumulate;
+	stage->x = x;
+	stage->y = y;
+	return true;
+}
+
+bool kernel_chain_max(kernel_chain* chain, chain_max_function max, chain_array x, double* maxPointer) {
+	if (!is_readable(chain, x) || (chain->arrays[x].components != 1)) {
+		return false;
+	}
+	chain_stage* stage = add_stage(chain, chain_stage_max);
+	if (stage == NULL) {
+		return false;
+	}
+	stage->max = max;
+	stage->x = x;
+	stage->maxPointer = maxPointer;
+	stage->reductionIndex = chain->reductionsCount++;
+	return true;
+}
+
+static bool take_front(chain_range& range, size_t& tile) {
+	uint64_t bounds = range.bounds.load(std::memory_order_relaxed);
+	for (;;) {
+		const uint64_t begin = bounds >> 32;
+		const uint64_t end = bounds & UINT32_MAX;
+		if (begin >= end) {
+			return false;
+		}
+		if (range.bounds.compare_exchange_weak(bounds, ((begin + 1) << 32) | end, std::memory_order_relaxed)) {
+			tile = size_t(begin);
+			return true;
+		}
+	}
+}
+
+static bool steal_back(chain_range& range, size_t& tile) {
+	uint64_t bounds = range.bounds.load(std::memory_order_relaxed);
+	for (;;) {
+		const uint64_t begin = bounds >> 32;
+		const uint64_t end = bounds & UINT32_MAX;
+		if (begin >= end) {
+			return false;
+		}
+		if (range.bounds.compare_exchange_weak(bounds, (begin << 32) | (end - 1), std::memory_order_relaxed)) {
+			tile = size_t(end - 1);
+			return true;
+		}
+	}
+}
+
+static void run_tile(const kernel_chain* chain, size_t tileStart, size_t tileLength, double* scratch, size_t scratchStride, double* partials) {
+	double* pointers[chain_max_arrays];
+	for (size_t array = 0; array < chain->arraysCount; array++) {
+		const chain_array_info& info = chain->arrays[array];
+		if (info.kind == chain_array_temporary) {
+			pointers[array] = scratch + info.temporaryIndex * scratchStride;
+		} else {
+			pointers[array] = info.pointer + tileStart * info.components;
+		}
+	}
+	for (size_t stageNumber = 0; stageNumber < chain->stagesCount; stageNumber++) {
+		const chain_stage& stage = chain->stages[stageNumber];
+		switch (stage.kind) {
+			case chain_stage_map:
+				stage.map(pointers[stage.x], pointers[stage.y], pointers[stage.result], tileLength);
+				break;
+			case chain_stage_accumulate:
+				stage.accumulate(pointers[stage.x], pointers[stage.y], tileLength);
+				break;
+			case chain_stage_max:
+			{
+				double tileMax;
+				stage.max(pointers[stage.x], &tileMax, tileLength);
+				partials[stage.reductionIndex] = fmax(partials[stage.reductionIndex], tileMax);
+				break;
+			}
+		}
+	}
+}
+
+static void run_participant(chain_run* run, size_t participantNumber) {
+	const kernel_chain* chain = run->chain;
+	chain_participant& participant = run->participants[participantNumber];
+	for (size_t reduction = 0; reduction < chain->reductionsCount; reduction++) {
+		participant.partials[reduction] = -INFINITY;
+	}
+	// Temporary buffers are allocated by the thread which uses them, so that they are local to its NUMA node
+	const size_t scratchSize = chain->temporariesCount * run->tileLength;
+	if (participant.scratchCapacity < scratchSize) {
+		free(participant.scratch);
+		void* scratch = NULL;
+		if (posix_memalign(&scratch, 4096, scratchSize * sizeof(double)) != 0) {
+			scratch = NULL;
+		}
+		participant.scratch = static_cast<double*>(scratch);
+		participant.scratchCapacity = (scratch != NULL) ? scratchSize : 0;
+		if (scratch == NULL) {
+			// Other threads steal the tiles of this thread
+			return;
+		}
+	}
+
+	size_t tile;
+	for (;;) {
+		if (!take_front(run->ranges[participantNumber], tile)) {
+			bool stolen = false;
+			for (size_t offset = 1; offset < run->participantsCount; offset++) {
+				if (steal_back(run->ranges[(participantNumber + offset) % run->participantsCount], tile)) {
+					stolen = true;
+					break;
+				}
+			}
+			if (!stolen) {
+				return;
+			}
+		}
+		const size_t tileStart = tile * run->tileLength;
+		const size_t tileLength = (chain->length - tileStart < run->tileLength) ? (chain->length - tileStart) : run->tileLength;
+		run_tile(chain, tileStart, tileLength, participant.scratch, run->tileLength, participant.partials);
+	}
+}
+
+static void worker_thread(chain_pool* pool, size_t participantNumber) {
+	size_t generation = 0;
+	size_t idleSpins = 0;
+	for (;;) {
+		const size_t currentGeneration = pool->generation.load(std::memory_order_acquire);
+		if (currentGeneration != generation) {
+			generation = currentGeneration;
+			run_participant(pool->run, participantNumber);
+			pool->activeCount.fetch_sub(1, std::memory_order_release);
+			idleSpins = 0;
+			continue;
+		}
+		if (pool->stopping.load(std::memory_order_acquire)) {
+			return;
+		}
+		if (++idleSpins < idle_spins_limit) {
+			std::this_thread::yield();
+			continue;
+		}
+		// Sleep until the next run. The timeout guards against a run which starts right after the check.
+		std::unique_lock<std::mutex> lock(pool->sleepMutex);
+		pool->sleepingCount.fetch_add(1);
+		if ((pool->generation.load() == generation) && !pool->stopping.load()) {
+			pool->wakeup.wait_for(lock, std::chrono::milliseconds(1));
+		}
+		pool->sleepingCount.fetch_sub(1);
+		idleSpins = 0;
+	}
+}
+
+chain_pool* chain_pool_create(size_t threadsCount) {
+	if (threadsCount == 0) {
+		threadsCount = std::thread::hardware_concurrency();
+		if (threadsCount == 0) {
+			threadsCount = 1;
+		}
+	}
+	chain_pool* pool = new (std::nothrow) chain_pool;
+	if (pool == NULL) {
+		return NULL;
+	}
+	pool->participants.resize(threadsCount);
+	for (size_t participantNumber = 0; participantNumber < threadsCount; participantNumber++) {
+		pool->participants[participantNumber].scratch = NULL;
+		pool->participants[participantNumber].scratchCapacity = 0;
+	}
+	pool->run = NULL;
+	pool->generation.store(0, std::memory_order_relaxed);
+	pool->activeCount.store(0, std::memory_order_relaxed);
+	pool->sleepingCount.store(0, std::memory_order_relaxed);
+	pool->stopping.store(false, std::memory_order_relaxed);
+	for (size_t participantNumber = 1; participantNumber < threadsCount; participantNumber++) {
+		pool->workers.push_back(std::thread(worker_thread, pool, participantNumber));
+	}
+	return pool;
+}
+
+void chain_pool_destroy(chain_pool* pool) {
+	if (pool == NULL) {
+		return;
+	}
+	{
+		std::lock_guard<std::mutex> lock(pool->sleepMutex);
+		pool->stopping.store(true, std::memory_order_release);
+		pool->wakeup.notify_all();
+	}
+	for (size_t workerNumber = 0; workerNumber < pool->workers.size(); workerNumber++) {
+		pool->workers[workerNumber].join();
+	}
+	for (size_t participantNumber = 0; participantNumber < pool->participants.size(); participantNumber++) {
+		free(pool->participants[participantNumber].scratch);
+	}
+	delete pool;
+}
+
+bool kernel_chain_run(kernel_chain* chain, chain_pool* pool) {
+	size_t tileLength = (chain->tileLength != 0) ? chain->tileLength : automatic_tile_length(chain);
+	// Tile numbers must fit into 32 bits
+	if (chain->length / tileLength >= UINT32_MAX) {
+		tileLength = chain->length / (UINT32_MAX - 1) + 1;
+	}
+	const size_t tilesCount = (chain->length + tileLength - 1) / tileLength;
+
+	chain_participant localParticipant;
+	localParticipant.scratch = NULL;
+	localParticipant.scratchCapacity = 0;
+	size_t participantsCount = 1;
+	chain_participant* participants = &localParticipant;
+	if (pool != NULL) {
+		participantsCount = pool->participants.size();
+		participants = &pool->participants[0];
+	}
+	std::vector<chain_range> ranges(participantsCount);
+	for (size_t participantNumber = 0; participantNumber < participantsCount; participantNumber++) {
+		const uint64_t begin = tilesCount * participantNumber / participantsCount;
+		const uint64_t end = tilesCount * (participantNumber + 1) / participantsCount;
+		ranges[participantNumber].bounds.store((begin << 32) | end, std::memory_order_relaxed);
+	}
+
+	chain_run run;
+	run.chain = chain;
+	run.tileLength = tileLength;
+	run.tilesCount = tilesCount;
+	run.participantsCount = participantsCount;
+	run.ranges = &ranges[0];
+	run.participants = participants;
+	if (participantsCount > 1) {
+		pool->run = &run;
+		pool->activeCount.store(participantsCount - 1, std::memory_order_relaxed);
+		pool->generation.fetch_add(1, std::memory_order_release);
+		if (pool->sleepingCount.load() != 0) {
+			std::lock_guard<std::mutex> lock(pool->sleepMutex);
+			pool->wakeup.notify_all();
+		}
+	}
+	run_participant(&run, 0);
+	if (participantsCount > 1) {
+		while (pool->activeCount.load(std::memory_order_acquire) != 0) {
+			std::this_thread::yield();
+		}
+		pool->run = NULL;
+	}
+
+	// Tiles are left over only if no thread could allocate its temporary buffers
+	bool completed = true;
+	for (size_t participantNumber = 0; participantNumber < participantsCount; participantNumber++) {
+		const uint64_t bounds = ranges[participantNumber].bounds.load(std::memory_order_relaxed);
+		if ((bounds >> 32) < (bounds & UINT32_MAX)) {
+			completed = false;
+		}
+	}
+	if (completed) {
+		for (size_t stageNumber = 0; stageNumber < chain->stagesCount; stageNumber++) {
+			const chain_stage& stage = chain->stages[stageNumber];
+			if (stage.kind == chain_stage_max) {
+				double max = -INFINITY;
+				for (size_t participantNumber = 0; participantNumber < participantsCount; participantNumber++) {
+					max = fmax(max, participants[participantNumber].partials[stage.reductionIndex]);
+				}
+				*stage.maxPointer = max;
+			}
+		}
+	}
+	free(localParticipant.scratch);
+	return completed;
+}
@@ -0,0 +1,100 @@
+/******************************************************************************\
+ *                                                                            *
+ * Copyright (c) 2012 Marat Dukhan                                            *
+ *                                                                            *
+ * This software is provided 'as-is', without any express or implied          *
+ * warranty. In no event will the authors be held liable for any damages      *
+ * arising from the use of this software.                                     *
+ *                                                                            *
+ * Permission is granted to anyone to use this software for any purpose,      *
+ * including commercial applications, and to alter it and redistribute it     *
+ * freely, subject to the following restrictions:                             *
+ *                                                                            *
+ * 1. The origin of this software must not be misrepresented; you must not    *
+ * claim that you wrote the original software. If you use this software       *
+ * in a product, an acknowledgment in the product documentation would be      *
+ * appreciated but is not required.                                           *
+ *                                                                            *
+ * 2. Altered source versions must be plainly marked as such, and must not be *
+ * misrepresented as being the original software.                             *
+ *                                                                            *
+ * 3. This notice may not be removed or altered from any source               *
+ * distribution.                                                              *
+ *                                                                            *
+\******************************************************************************/
+
+#pragma once
+
+#include <stddef.h>
+
+// Cache-blocked execution of chains of kernels over arrays of the same length.
+// Running every kernel of a chain over the whole arrays evicts the intermediate results from the caches before the next
+// kernel reads them. A kernel chain instead splits the arrays into tiles which fit into the L2 cache, and runs all stages
+// of the chain on a tile before it moves on to the next tile. Intermediate results which are only needed inside the chain
+// are kept in tile-sized temporary buffers and never written to memory. The tiles are distributed over the threads of a
+// work-stealing pool. Stages call the existing kernels unchanged on sub-ranges of the arrays: the stage function types
+// match vector_add and vector3d_dot_products, vector_accumulate and vector_max of the examples.
+//
+// Example: max(dot(v, u) + b) for arrays of 3D vectors v and u
+//   kernel_chain* chain = kernel_chain_create(length);
+//   const chain_array dp = kernel_chain_temporary(chain);
+//   kernel_chain_map(chain, &vector3d_dot_products_sse2, kernel_chain_input(chain, v, 3), kernel_chain_input(chain, u, 3), dp);
+//   kernel_chain_accumulate(chain, &chain_accumulate_naive, kernel_chain_input(chain, b, 1), dp);
+//   kernel_chain_max(chain, &chain_max_naive, dp, &max);
+//   kernel_chain_run(chain, pool);
+
+struct kernel_chain;
+struct chain_pool;
+
+// Handle of an array operand of a kernel chain
+typedef size_t chain_array;
+static const chain_array chain_array_invalid = ~size_t(0);
+
+static const size_t chain_max_arrays = 16;
+static const size_t chain_max_stages = 16;
+
+// Kernel which reads two arrays and writes one, e.g. vector_add, or vector3d_dot_products on inputs with 3 components
+typedef void (*chain_map_function)(const double*, const double*, double*, size_t);
+// Kernel which adds the first array to the second one, e.g. vector_accumulate
+typedef void (*chain_accumulate_function)(const double*, double*, size_t);
+// Kernel which computes the maximum of an array, e.g. vector_max
+typedef void (*chain_max_function)(const double*, double*, size_t);
+
+// Scalar accumulate and max stages for programs without their own kernels. Like vector_max_naive, the max ignores NaNs.
+extern "C" void chain_accumulate_naive(const double* xPointer, double* yPointer, size_t length);
+extern "C" void chain_max_naive(const double* arrayPointer, double* maxPointer, size_t length);
+
+// Creates a chain over arrays of length elements. Returns NULL if memory can not be allocated.
+extern "C" kernel_chain* kernel_chain_create(size_t length);
+extern "C" void kernel_chain_destroy(kernel_chain* chain);
+// Sets the number of elements per tile. The default (0) picks the tile length so that one tile of all arrays of the chain
+// takes half of the L2 cache.
+extern "C" void kernel_chain_set_tile_length(kernel_chain* chain, size_t tileLength);
+
+// Operand declarations return chain_array_invalid if the chain already has chain_max_arrays arrays.
+// Input array in memory with the specified number of doubles per element
+extern "C" chain_array kernel_chain_input(kernel_chain* chain, const double* pointer, size_t components);
+// Output array in memory with one double per element
+extern "C" chain_array kernel_chain_output(kernel_chain* chain, double* pointer);
+// Intermediate array with one double per element, which only exists tile by tile
+extern "C" chain_array kernel_chain_temporary(kernel_chain* chain);
+
+// Stages run in the order they are added. A stage may only read inputs and output or temporary arrays written by an earlier
+// stage, and outputs must be distinct from the inputs of the same stage. Stage declarations return false if an operand
+// breaks these rules or the chain already has chain_max_stages stages.
+// result = map(x, y)
+extern "C" bool kernel_chain_map(kernel_chain* chain, chain_map_function map, chain_array x, chain_array y, chain_array result);
+// y += x
+extern "C" bool kernel_chain_accumulate(kernel_chain* chain, chain_accumulate_function accumulate, chain_array x, chain_array y);
+// *maxPointer = maximum element of x, or -inf if the chain is empty. *maxPointer is written when the run completes.
+extern "C" bool kernel_chain_max(kernel_chain* chain, chain_max_function max, chain_array x, double* maxPointer);
+
+// Creates a pool for threadsCount threads (0 = all CPUs) including the thread which calls kernel_chain_run,
+// i.e. the pool starts threadsCount - 1 worker threads. Returns NULL if memory can not be allocated.
+extern "C" chain_pool* chain_pool_create(size_t threadsCount);
+extern "C" void chain_pool_destroy(chain_pool* pool);
+
+// Runs the chain on the threads of the pool, or on the calling thread only if pool is NULL.
+// Every thread starts with a contiguous range of tiles and steals tiles from the end of other threads' ranges when its range
+// is exhausted. A pool runs one chain at a time. Returns false if the temporary buffers can not be allocated.
+extern "C" bool kernel_chain_run(kernel_chain* chain, chain_pool* pool);
@@ -0,0 +1,56 @@
+/******************************************************************************\
+ *                                                                            *
+ * Copyright (c) 2012 Marat Dukhan                                            *
+ *                                                                            *
+ * This software is provided 'as-is', without any express or implied          *
+ * warranty. In no event will the authors be held liable for any damages      *
+ * arising from the use of this software.                                     *
+ *                                                                            *
+ * Permission is granted to anyone to use this software for any purpose,      *
+ * including commercial applications, and to alter it and redistribute it     *
+ * freely, subject to the following restrictions:                             *
+ *                                                                            *
+ * 1. The origin of this software must not be misrepresented; you must not    *
+ * claim that you wrote the original software. If you use this software       *
+ * in a product, an acknowledgment in the product documentation would be      *
+ * appreciated but is not required.                                           *
+ *                                                                            *
+ * 2. Altered source versions must be plainly marked as such, and must not be *
+ * misrepresented as being the original software.                             *
+ *                                                                            *
+ * 3. This notice may not be removed or altered from any source               *
+ * distribution.                                                              *
+ *                                                                            *
+\******************************************************************************/
+
+#pragma once
+
+#include <registry.hpp>
+#include <atomic>
+
+// Kernel selection of the dispatchers. The dispatchers call the kernel which kernel_registry_best returns for the operation
+// and the alignment of the array arguments. The registry is searched on the first call with each alignment class
+// (8, 16, 32 and at least 64 bytes), and the selected kernel is cached.
+static const size_t dispatch_alignment_classes_count = 4;
+
+// Must have static storage duration, so that the cached kernels start as NULL
+template <typename Function>
+struct dispatch_cache {
+	std::atomic<Function> kernels[dispatch_alignment_classes_count];
+};
+
+// pointerBits is the bitwise OR of the addresses of all array arguments, which are arrays of double.
+// fallbackKernel is called if the registry has no kernel for the operation.
+template <typename Function>
+inline Function dispatch_select(dispatch_cache<Function>& cache, kernel_registry_operation operation, uintptr_t pointerBits, Function fallbackKernel) {
+	const size_t alignmentShift = size_t(__builtin_ctzll(uint64_t(pointerBits) | 64));
+	const size_t alignmentClass = (alignmentShift > 3) ? alignmentShift - 3 : 0;
+	Function kernel = cache.kernels[alignmentClass].load(std::memory_order_relaxed);
+	if (kernel == NULL) {
+		// Concurrent first calls may search the registry several times, but they select the same kernel
+		const kernel_info* best = kernel_registry_best(operation, sizeof(double) << alignmentClass);
+		kernel = (best != NULL) ? reinterpret_cast<Function>(best->function) : fallbackKernel;
+		cache.kernels[alignmentClass].store(kernel, std::memory_order_relaxed);
+	}
+	return kernel;
+}
@@ -0,0 +1,66 @@
+/******************************************************************************\
+ *                                                                            *
+ * Copyright (c) 2012 Marat Dukhan                                            *
+ *                                                                            *
+ * This software is provided 'as-is', without any express or implied          *
+ * warranty. In no event will the authors be held liable for any damages      *
+ * arising from the use of this software.                                     *
+ *                                                                            *
+ * Permission is granted to anyone to use this software for any purpose,      *
+ * including commercial applications, and to alter it and redistribute it     *
+ * freely, subject to the following restrictions:                             *
+ *                                                                            *
+ * 1. The origin of this software must not be misrepresented; you must not    *
+ * claim that you wrote the original software. If you use this software       *
+ * in a product, an acknowledgment in the product documentation would be      *
+ * appreciated but is not required.                                           *
+ *                                                                            *
+ * 2. Altered source versions must be plainly marked as such, and must not be *
+ * misrepresented as being the original software.                             *
+ *                                                                            *
+ * 3. This notice may not be removed or altered from any source               *
+ * distribution.                                                              *
+ *                                                                            *
+\******************************************************************************/
+
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+
+// Reduced-precision floating-point formats and their conversions
+
+// bfloat16 numbers are stored as the upper 16 bits of an IEEE single-precision number
+struct bfloat16 {
+	uint16_t bits;
+};
+
+inline static float bfloat16_to_float(bfloat16 x) {
+	const uint32_t bits = uint32_t(x.bits) << 16;
+	float result;
+	memcpy(&result, &bits, sizeof(result));
+	return result;
+}
+
+// Converts an IEEE half-precision number to double precision. The conversion is exact.
+inline static double half_to_double(uint16_t half) {
+	const uint64_t sign = uint64_t(half >> 15) << 63;
+	const uint32_t exponent = (half >> 10) & 0x1F;
+	const uint64_t mantissa = half & 0x3FF;
+	uint64_t bits;
+	if (exponent == 0) {
+		// Zero or subnormal number: mantissa * 2**-24 is exact in double precision
+		const double magnitude = double(mantissa) * (1.0 / 16777216.0);
+		memcpy(&bits, &magnitude, sizeof(bits));
+	} else if (exponent == 31) {
+		// Infinity or NaN
+		bits = 0x7FF0000000000000ull | (mantissa << 42);
+	} else {
+		// Normal number: rebias the exponent from 15 to 1023
+		bits = (uint64_t(exponent + 1008) << 52) | (mantissa << 42);
+	}
+	bits |= sign;
+	double result;
+	memcpy(&result, &bits, sizeof(result));
+	return result;
+}
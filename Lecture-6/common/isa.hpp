@@ -0,0 +1,92 @@
+/******************************************************************************\
+ *                                                                            *
+ * Copyright (c) 2012 Marat Dukhan                                            *
+ *                                                                            *
+ * This software is provided 'as-is', without any express or implied          *
+ * warranty. In no event will the authors be held liable for any damages      *
+ * arising from the use of this software.                                     *
+ *                                                                            *
+ * Permission is granted to anyone to use this software for any purpose,      *
+ * including commercial applications, and to alter it and redistribute it     *
+ * freely, subject to the following restrictions:                             *
+ *                                                                            *
+ * 1. The origin of this software must not be misrepresented; you must not    *
+ * claim that you wrote the original software. If you use this software       *
+ * in a product, an acknowledgment in the product documentation would be      *
+ * appreciated but is not required.                                           *
+ *                                                                            *
+ * 2. Altered source versions must be plainly marked as such, and must not be *
+ * misrepresented as being the original software.                             *
+ *                                                                            *
+ * 3. This notice may not be removed or altered from any source               *
+ * distribution.                                                              *
+ *                                                                            *
+\******************************************************************************/
+
+#pragma once
+
+// Compiler and instruction set macros of the kernels in all examples
+
+#if defined(__GNUC__)
+	// gcc or gcc-compatible compiler
+	#define CSE6230_RESTRICT __restrict__
+#elif defined(_MSC_VER)
+	// msvc or msvc-compatible compiler
+	#define CSE6230_RESTRICT __restrict
+#else
+	#warning Compiler is not recognized and restrict qualifier is not used.
+	#define CSE6230_RESTRICT
+#endif
+
+#if defined(__GNUC__)
+	#if defined(__SSE2__)
+		#define CSE6230_SSE2_INTRINSICS_SUPPORTED
+	#endif
+	#if defined(__SSE3__)
+		#define CSE6230_SSE3_INTRINSICS_SUPPORTED
+	#endif
+	#if defined(__AVX__)
+		#define CSE6230_AVX_INTRINSICS_SUPPORTED
+	#endif
+	#if defined(__FMA4__)
+		#define CSE6230_FMA4_INTRINSICS_SUPPORTED
+	#endif
+	#if defined(__F16C__)
+		#define CSE6230_F16C_INTRINSICS_SUPPORTED
+	#endif
+	#if defined(__AVX2__)
+		#define CSE6230_AVX2_INTRINSICS_SUPPORTED
+	#endif
+	#if defined(__FMA__)
+		#define CSE6230_FMA3_INTRINSICS_SUPPORTED
+	#endif
+	#if defined(__AVX512F__)
+		#define CSE6230_AVX512F_INTRINSICS_SUPPORTED
+	#endif
+#elif defined(_MSC_VER)
+	#if defined(_M_IX86) || defined(_M_X64)
+		#define CSE6230_SSE2_INTRINSICS_SUPPORTED
+		#define CSE6230_SSE3_INTRINSICS_SUPPORTED
+		#define CSE6230_AVX_INTRINSICS_SUPPORTED
+		#define CSE6230_FMA4_INTRINSICS_SUPPORTED
+		// msvc defines __AVX2__ and __AVX512F__ only when the code may use these instruction sets (/arch:AVX2 and /arch:AVX512).
+		// It has no macros for F16C and FMA3, which every processor with AVX2 supports.
+		#if defined(__AVX2__)
+			#define CSE6230_F16C_INTRINSICS_SUPPORTED
+			#define CSE6230_AVX2_INTRINSICS_SUPPORTED
+			#define CSE6230_FMA3_INTRINSICS_SUPPORTED
+		#endif
+		#if defined(__AVX512F__)
+			#define CSE6230_AVX512F_INTRINSICS_SUPPORTED
+		#endif
+	#endif
+#else
+	#warning Compiler is not recognized and intrinsic functions are not used.
+#endif
+
+// Instruction set tags for the templates of the kernels
+struct isa_naive {};
+struct isa_sse2 {};
+struct isa_avx {};
+struct isa_avx2 {};
+struct isa_avx512f {};
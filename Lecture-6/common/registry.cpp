@@ -0,0 +1,175 @@
+/******************************************************************************\
+ *                                                                            *
+ * Copyright (c) 2012 Marat Dukhan                                            *
+ *                                                                            *
+ * This software is provided 'as-is', without any express or implied          *
+ * warranty. In no event will the authors be held liable for any damages      *
+ * arising from the use of this software.                                     *
+ *                                                                            *
+ * Permission is granted to anyone to use this software for any purpose,      *
+ * including commercial applications, and to alter it and redistribute it     *
+ * freely, subject to the following restrictions:                             *
+ *                                                                            *
+ * 1. The origin of this software must not be misrepresented; you must not    *
+ * claim that you wrote the original software. If you use this software       *
+ * in a product, an acknowledgment in the product documentation would be      *
+ * appreciated but is not required.                                           *
+ *                                                                            *
+ * 2. Altered source versions must be plainly marked as such, and must not be *
+ * misrepresented as being the original software.                             *
+ *                                                                            *
+ * 3. This notice may not be removed or altered from any source               *
+ * distribution.                                                              *
+ *                                                                            *
+\******************************************************************************/
+
+#include <registry_table.hpp>
+#include <string.h>
+
+static const char* const registry_operation_names[] = {
+	"vector_add",
+	"vector_accumulate",
+	"vector_axpy",
+	"vector_max",
+	"vector_max_f32",
+	"vector_max_f16",
+	"vector3d_dot_products",
+	"vector3d_dot_products_f32",
+	"vector3d_dot_products_f16",
+	"typed_vector_add_f32",
+	"typed_vector_add_i32",
+	"typed_vector_add_u32",
+	"typed_vector_add_i64",
+	"typed_vector_add_u64",
+	"typed_vector_add_bf16",
+	"typed_vector_max_f32",
+	"typed_vector_max_i32",
+	"typed_vector_max_u32",
+	"typed_vector_max_i64",
+	"typed_vector_max_u64",
+	"typed_vector_max_bf16",
+	"typed_vector_add_saturated_i32",
+	"typed_vector_add_saturated_u32",
+	"typed_vector_add_saturated_i64",
+	"typed_vector_add_saturated_u64",
+	"vector_add_fixed",
+	"vector_max_fixed",
+	"reduction_max_update",
+	"reduction_min_update",
+	"reduction_argmax_update",
+	"reduction_sum_update",
+	"reproducible_sum",
+	"vector_topk",
+	"vector_inclusive_scan",
+	"vector_exclusive_scan",
+	"vector_add_strided",
+	"vector_max_strided",
+	"typed_vector3d_dot_products_f32",
+	"typed_vector3d_dot_products_i32",
+	"typed_vector3d_dot_products_i64",
+	"typed_vector3d_dot_products_bf16",
+	"vectornd_dot_products",
+	"reproducible_dot_products_sum",
+	"vector3d_dot_products_argmax",
+	"vector3d_query_argmax",
+	"vector3d_query_topk",
+	"vector3d_dot_products_filter",
+	"vector3d_gram_matrix",
+	"matvec",
+	"matvec_transposed",
+	"batched_matmul_3x3",
+	"batched_matmul_4x4",
+	"batched_matmul_8x8"
+};
+
+static const char* const registry_isa_names[] = {
+	"Naive",
+	"Compiler",
+	"SSE2",
+	"SSE3",
+	"AVX",
+	"FMA4",
+	"F16C",
+	"AVX2",
+	"AVX-512F",
+	"AVX2+FMA3"
+};
+
+size_t kernel_registry_count(void) {
+	return vector_registry_kernels_count + vector3d_registry_kernels_count;
+}
+
+const kernel_info* kernel_registry_get(size_t index) {
+	if (index < vector_registry_kernels_count) {
+		return &vector_registry_kernels[index];
+	}
+	index -= vector_registry_kernels_count;
+	return (index < vector3d_registry_kernels_count) ? &vector3d_registry_kernels[index] : NULL;
+}
+
+const kernel_info* kernel_registry_find(const char* name) {
+	for (size_t index = 0; index < kernel_registry_count(); index++) {
+		const kernel_info* kernel = kernel_registry_get(index);
+		if (strcmp(kernel->name, name) == 0) {
+			return kernel;
+		}
+	}
+	return NULL;
+}
+
+bool kernel_registry_is_available(const kernel_info* kernel) {
+#if defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+	__builtin_cpu_init();
+	switch (kernel->isa) {
+		case kernel_registry_isa_naive:
+		case kernel_registry_isa_compiler:
+			return true;
+		case kernel_registry_isa_sse2:
+			return __builtin_cpu_supports("sse2");
+		case kernel_registry_isa_sse3:
+			return __builtin_cpu_supports("sse3");
+		case kernel_registry_isa_avx:
+			return __builtin_cpu_supports("avx");
+		case kernel_registry_isa_fma4:
+			return __builtin_cpu_supports("fma4");
+		case kernel_registry_isa_f16c:
+			return __builtin_cpu_supports("avx") && __builtin_cpu_supports("f16c");
+		case kernel_registry_isa_avx2:
+			return __builtin_cpu_supports("avx2");
+		case kernel_registry_isa_avx512f:
+			return __builtin_cpu_supports("avx512f");
+		case kernel_registry_isa_avx2_fma3:
+			return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+	}
+	return false;
+#else
+	// Without a way to query the processor, assume that it supports the instruction sets which the library was built for
+	return kernel != NULL;
+#endif
+}
+
+const kernel_info* kernel_registry_best(kernel_registry_operation operation, size_t alignment) {
+	const kernel_info* best = NULL;
+	for (size_t index = 0; index < kernel_registry_count(); index++) {
+		const kernel_info* kernel = kernel_registry_get(index);
+		if ((kernel->operation != operation) || (kernel->isa == kernel_registry_isa_compiler) ||
+			(alignment % kernel->alignment != 0) || !kernel_registry_is_available(kernel))
+		{
+			continue;
+		}
+		if ((best == NULL) || (kernel->vectorWidth > best->vectorWidth) ||
+			((kernel->vectorWidth == best->vectorWidth) && (kernel->alignment > best->alignment)))
+		{
+			best = kernel;
+		}
+	}
+	return best;
+}
+
+const char* kernel_registry_operation_name(kernel_registry_operation operation) {
+	return (size_t(operation) < sizeof(registry_operation_names) / sizeof(registry_operation_names[0])) ? registry_operation_names[operation] : NULL;
+}
+
+const char* kernel_registry_isa_name(kernel_registry_isa isa) {
+	return (size_t(isa) < sizeof(registry_isa_names) / sizeof(registry_isa_names[0])) ? registry_isa_names[isa] : NULL;
+}
@@ -0,0 +1,151 @@
+/******************************************************************************\
+ *                                                                            *
+ * Copyright (c) 2012 Marat Dukhan                                            *
+ *                                                                            *
+ * This software is provided 'as-is', without any express or implied          *
+ * warranty. In no event will the authors be held liable for any damages      *
+ * arising from the use of this software.                                     *
+ *                                                                            *
+ * Permission is granted to anyone to use this software for any purpose,      *
+ * including commercial applications, and to alter it and redistribute it     *
+ * freely, subject to the following restrictions:                             *
+ *                                                                            *
+ * 1. The origin of this software must not be misrepresented; you must not    *
+ * claim that you wrote the original software. If you use this software       *
+ * in a product, an acknowledgment in the product documentation would be      *
+ * appreciated but is not required.                                           *
+ *                                                                            *
+ * 2. Altered source versions must be plainly marked as such, and must not be *
+ * misrepresented as being the original software.                             *
+ *                                                                            *
+ * 3. This notice may not be removed or altered from any source               *
+ * distribution.                                                              *
+ *                                                                            *
+\******************************************************************************/
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+
+// Runtime registry of the kernels in libcse6230, which holds the kernels of both examples. The registry lists every
+// variant of every kernel which the library was built with, together with the properties a caller needs to pick one.
+// Callers iterate the registry instead of naming the variants, so new variants are picked up without changes to the callers.
+// The interface is a stable C ABI and this header compiles as C and C++: enumeration values are never renumbered,
+// new values and new fields of kernel_info are only appended, and kernel_info structures are only accessed through
+// pointers returned by the library.
+
+typedef enum kernel_registry_operation {
+	kernel_registry_operation_vector_add = 0, // vector_add_function
+	kernel_registry_operation_vector_accumulate = 1, // vector_accumulate_function
+	kernel_registry_operation_vector_axpy = 2, // vector_axpy_function
+	kernel_registry_operation_vector_max = 3, // vector_max_function
+	kernel_registry_operation_vector_max_f32 = 4, // vector_max_f32_function
+	kernel_registry_operation_vector_max_f16 = 5, // vector_max_f16_function
+	kernel_registry_operation_vector3d_dot_products = 6, // vector3d_dot_products_function
+	kernel_registry_operation_vector3d_dot_products_f32 = 7, // vector3d_dot_products_f32_function
+	kernel_registry_operation_vector3d_dot_products_f16 = 8, // vector3d_dot_products_f16_function
+	// Typed kernels of example1 (typed.hpp): vector_add<T, ISA>, vector_max<T, ISA> and vector_add_saturated<T, ISA>
+	kernel_registry_operation_typed_vector_add_f32 = 9,
+	kernel_registry_operation_typed_vector_add_i32 = 10,
+	kernel_registry_operation_typed_vector_add_u32 = 11,
+	kernel_registry_operation_typed_vector_add_i64 = 12,
+	kernel_registry_operation_typed_vector_add_u64 = 13,
+	kernel_registry_operation_typed_vector_add_bf16 = 14,
+	kernel_registry_operation_typed_vector_max_f32 = 15,
+	kernel_registry_operation_typed_vector_max_i32 = 16,
+	kernel_registry_operation_typed_vector_max_u32 = 17,
+	kernel_registry_operation_typed_vector_max_i64 = 18,
+	kernel_registry_operation_typed_vector_max_u64 = 19,
+	kernel_registry_operation_typed_vector_max_bf16 = 20,
+	kernel_registry_operation_typed_vector_add_saturated_i32 = 21,
+	kernel_registry_operation_typed_vector_add_saturated_u32 = 22,
+	kernel_registry_operation_typed_vector_add_saturated_i64 = 23,
+	kernel_registry_operation_typed_vector_add_saturated_u64 = 24,
+	kernel_registry_operation_vector_add_fixed = 25, // vector_add_fixed_function
+	kernel_registry_operation_vector_max_fixed = 26, // vector_max_fixed_function
+	kernel_registry_operation_reduction_max_update = 27, // reduction_update_function
+	kernel_registry_operation_reduction_min_update = 28, // reduction_update_function
+	kernel_registry_operation_reduction_argmax_update = 29, // reduction_update_function
+	kernel_registry_operation_reduction_sum_update = 30, // reduction_update_function
+	kernel_registry_operation_reproducible_sum = 31, // reproducible_sum_function
+	kernel_registry_operation_vector_topk = 32, // vector_topk_function
+	kernel_registry_operation_vector_inclusive_scan = 33, // vector_scan_function
+	kernel_registry_operation_vector_exclusive_scan = 34, // vector_scan_function
+	kernel_registry_operation_vector_add_strided = 35, // vector_add_strided_function
+	kernel_registry_operation_vector_max_strided = 36, // vector_max_strided_function
+	// Typed kernels of example2 (typed.hpp): vector3d_dot_products<T, ISA>
+	kernel_registry_operation_typed_vector3d_dot_products_f32 = 37,
+	kernel_registry_operation_typed_vector3d_dot_products_i32 = 38,
+	kernel_registry_operation_typed_vector3d_dot_products_i64 = 39,
+	kernel_registry_operation_typed_vector3d_dot_products_bf16 = 40,
+	kernel_registry_operation_vectornd_dot_products = 41, // vectornd_dot_products_function
+	kernel_registry_operation_reproducible_dot_products_sum = 42, // reproducible_dot_products_sum_function
+	kernel_registry_operation_vector3d_dot_products_argmax = 43, // vector3d_dot_products_argmax_function
+	kernel_registry_operation_vector3d_query_argmax = 44, // vector3d_query_argmax_function
+	kernel_registry_operation_vector3d_query_topk = 45, // vector3d_query_topk_function
+	kernel_registry_operation_vector3d_dot_products_filter = 46, // vector3d_dot_products_filter_function
+	kernel_registry_operation_vector3d_gram_matrix = 47, // vector3d_gram_matrix_function
+	kernel_registry_operation_matvec = 48, // matvec_function
+	kernel_registry_operation_matvec_transposed = 49, // matvec_function
+	kernel_registry_operation_batched_matmul_3x3 = 50, // batched_matmul_function
+	kernel_registry_operation_batched_matmul_4x4 = 51, // batched_matmul_function
+	kernel_registry_operation_batched_matmul_8x8 = 52 // batched_matmul_function
+} kernel_registry_operation;
+
+typedef enum kernel_registry_isa {
+	kernel_registry_isa_naive = 0, // Scalar code
+	kernel_registry_isa_compiler = 1, // Vectorized by the compiler or the standard library for the target of the build
+	kernel_registry_isa_sse2 = 2,
+	kernel_registry_isa_sse3 = 3,
+	kernel_registry_isa_avx = 4,
+	kernel_registry_isa_fma4 = 5,
+	kernel_registry_isa_f16c = 6, // AVX and F16C
+	kernel_registry_isa_avx2 = 7,
+	kernel_registry_isa_avx512f = 8,
+	kernel_registry_isa_avx2_fma3 = 9 // AVX2 and FMA3
+} kernel_registry_isa;
+
+typedef struct kernel_info {
+	// Name of the exported function, e.g. "vector_add_avx_aligned", or of the template instance, e.g. "vector_add<float, isa_avx>"
+	const char* name;
+	const char* description; // Short name for reports, e.g. "AVX + aligned array"
+	kernel_registry_operation operation;
+	kernel_registry_isa isa;
+	// Alignment in bytes which all array pointers must have. Kernels without requirements report the size of the array elements.
+	size_t alignment;
+	// Number of array elements (of dot products for vector3d_dot_products) per SIMD vector: 1 for scalar code,
+	// 0 if the compiler chooses the width
+	size_t vectorWidth;
+	// Must be cast to the function type of the operation
+	void (*function)(void);
+	// Number of elements which fixed-length kernels process, 0 for kernels which take the length as an argument
+	size_t length;
+} kernel_info;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+size_t kernel_registry_count(void);
+// Returns NULL if index >= kernel_registry_count()
+const kernel_info* kernel_registry_get(size_t index);
+// Returns NULL if there is no kernel with this function name
+const kernel_info* kernel_registry_find(const char* name);
+// Checks if the processor and the operating system support the instruction set of the kernel
+bool kernel_registry_is_available(const kernel_info* kernel);
+// Returns the available kernel of the operation with the widest SIMD vectors which accepts arrays aligned on alignment bytes,
+// preferring kernels which need more alignment, or NULL if the library has no kernels for the operation.
+// Compiler-vectorized kernels are not considered.
+const kernel_info* kernel_registry_best(kernel_registry_operation operation, size_t alignment);
+
+const char* kernel_registry_operation_name(kernel_registry_operation operation);
+const char* kernel_registry_isa_name(kernel_registry_isa isa);
+
+// Prints one line per kernel with its name, operation, instruction set, alignment, vector width and availability
+void kernel_registry_print(FILE* file);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,37 @@
+/******************************************************************************\
+ *                                                                            *
+ * Copyright (c) 2012 Marat Dukhan                                            *
+ *                                                                            *
+ * This software is provided 'as-is', without any express or implied          *
+ * warranty. In no event will the authors be held liable for any damages      *
+ * arising from the use of this software.                                     *
+ *                                                                            *
+ * Permission is granted to anyone to use this software for any purpose,      *
+ * including commercial applications, and to alter it and redistribute it     *
+ * freely, subject to the following restrictions:                             *
+ *                                                                            *
+ * 1. The origin of this software must not be misrepresented; you must not    *
+ * claim that you wrote the original software. If you use this software       *
+ * in a product, an acknowledgment in the product documentation would be      *
+ * appreciated but is not required.                                           *
+ *                                                                            *
+ * 2. Altered source versions must be plainly marked as such, and must not be *
+ * misrepresented as being the original software.                             *
+ *                                                                            *
+ * 3. This notice may not be removed or altered from any source               *
+ * distribution.                                                              *
+ *                                                                            *
+\******************************************************************************/
+
+// Compiled as C, so that registry.hpp stays usable from C callers
+#include <registry.hpp>
+
+void kernel_registry_print(FILE* file) {
+	fprintf(file, "%40s\t%32s\t%10s\t%10s\t%10s\t%10s\n", "Kernel", "Operation", "ISA", "Alignment", "Width", "Available");
+	for (size_t index = 0; index < kernel_registry_count(); index++) {
+		const kernel_info* kernel = kernel_registry_get(index);
+		fprintf(file, "%40s\t%32s\t%10s\t%10zu\t%10zu\t%10s\n", kernel->name,
+			kernel_registry_operation_name(kernel->operation), kernel_registry_isa_name(kernel->isa),
+			kernel->alignment, kernel->vectorWidth, kernel_registry_is_available(kernel) ? "yes" : "no");
+	}
+}
@@ -0,0 +1,44 @@
+/******************************************************************************\
+ *                                                                            *
+ * Copyright (c) 2012 Marat Dukhan                                            *
+ *                                                                            *
+ * This software is provided 'as-is', without any express or implied          *
+ * warranty. In no event will the authors be held liable for any damages      *
+ * arising from the use of this software.                                     *
+ *                                                                            *
+ * Permission is granted to anyone to use this software for any purpose,      *
+ * including commercial applications, and to alter it and redistribute it     *
+ * freely, subject to the following restrictions:                             *
+ *                                                                            *
+ * 1. The origin of this software must not be misrepresented; you must not    *
+ * claim that you wrote the original software. If you use this software       *
+ * in a product, an acknowledgment in the product documentation would be      *
+ * appreciated but is not required.                                           *
+ *                                                                            *
+ * 2. Altered source versions must be plainly marked as such, and must not be *
+ * misrepresented as being the original software.                             *
+ *                                                                            *
+ * 3. This notice may not be removed or altered from any source               *
+ * distribution.                                                              *
+ *                                                                            *
+\******************************************************************************/
+
+#pragma once
+
+#include <registry.hpp>
+
+// Tables of the kernels behind the registry functions in registry.cpp. Each example defines the table of its kernels
+// in its registry_kernels.cpp, and the registry lists the kernels of example1 before the kernels of example2.
+#define REGISTRY_KERNEL(function, description, operation, isa, alignment, vectorWidth) \
+	{ #function, description, kernel_registry_operation_##operation, kernel_registry_isa_##isa, alignment, vectorWidth, reinterpret_cast<void (*)(void)>(&function), 0 }
+// Template instances are passed last, as the commas between their arguments would split them into several macro arguments
+#define REGISTRY_TEMPLATE_KERNEL(description, operation, isa, alignment, vectorWidth, length, ...) \
+	{ #__VA_ARGS__, description, kernel_registry_operation_##operation, kernel_registry_isa_##isa, alignment, vectorWidth, reinterpret_cast<void (*)(void)>(&__VA_ARGS__), length }
+
+// Kernels of example1
+extern const kernel_info vector_registry_kernels[];
+extern const size_t vector_registry_kernels_count;
+
+// Kernels of example2
+extern const kernel_info vector3d_registry_kernels[];
+extern const size_t vector3d_registry_kernels_count;
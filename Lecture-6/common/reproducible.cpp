@@ -0,0 +1,217 @@
+/******************************************************************************\
+ *                                                                            *
+ * Copyright (c) 2012 Marat Dukhan                                            *
+ *                                                                            *
+ * This software is provided 'as-is', without any express or implied          *
+ * warranty. In no event will the authors be held liable for any damages      *
+ * arising from the use of this software.                                     *
+ *                                                                            *
+ * Permission is granted to anyone to use this software for any purpose,      *
+ * including commercial applications, and to alter it and redistribute it     *
+ * freely, subject to the following restrictions:                             *
+ *                                                                            *
+ * 1. The origin of this software must not be misrepresented; you must not    *
+ * claim that you wrote the original software. If you use this software       *
+ * in a product, an acknowledgment in the product documentation would be      *
+ * appreciated but is not required.                                           *
+ *                                                                            *
+ * 2. Altered source versions must be plainly marked as such, and must not be *
+ * misrepresented as being the original software.                             *
+ *                                                                            *
+ * 3. This notice may not be removed or altered from any source               *
+ * distribution.                                                              *
+ *                                                                            *
+\******************************************************************************/
+
+#include <reproducible.hpp>
+#include <stdint.h>
+#include <thread>
+#include <vector>
+#if defined(CSE6230_SSE2_INTRINSICS_SUPPORTED) || defined(CSE6230_AVX_INTRINSICS_SUPPORTED)
+	#if defined(__GNUC__)
+		#include <x86intrin.h>
+	#elif defined(_MSC_VER)
+		#include <intrin.h>
+	#else
+		#error Intrinsics headers are not included: unknown compiler
+	#endif
+#endif
+
+static const size_t reproducible_lanes = 8;
+
+// Combines the lanes with the tree ((l0 + l4) + (l2 + l6)) + ((l1 + l5) + (l3 + l7)),
+// which is the order of the usual horizontal reduction of an 8-wide vector
+static double combine_lanes(const double lanes[reproducible_lanes]) {
+	const double sum04 = lanes[0] + lanes[4];
+	const double sum15 = lanes[1] + lanes[5];
+	const double sum26 = lanes[2] + lanes[6];
+	const double sum37 = lanes[3] + lanes[7];
+	return (sum04 + sum26) + (sum15 + sum37);
+}
+
+// Adds the elements after the last full group of 8 lanes
+static void add_lanes_tail(double lanes[reproducible_lanes], const double* arrayPointer, size_t length) {
+	for (size_t i = 0; i < length; i++) {
+		lanes[i % reproducible_lanes] += arrayPointer[i];
+	}
+}
+
+static double block_sum_naive(const double* arrayPointer, size_t length) {
+	double lanes[reproducible_lanes] = { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };
+	size_t i = 0;
+	for (; i + reproducible_lanes <= length; i += reproducible_lanes) {
+		for (size_t lane = 0; lane < reproducible_lanes; lane++) {
+			lanes[lane] += arrayPointer[i + lane];
+		}
+	}
+	// Process remaining elements (if any)
+	add_lanes_tail(lanes, arrayPointer + i, length - i);
+	return combine_lanes(lanes);
+}
+
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+static double block_sum_sse2(const double* arrayPointer, size_t length) {
+	__m128d lanes01 = _mm_setzero_pd();
+	__m128d lanes23 = _mm_setzero_pd();
+	__m128d lanes45 = _mm_setzero_pd();
+	__m128d lanes67 = _mm_setzero_pd();
+	size_t i = 0;
+	for (; i + reproducible_lanes <= length; i += reproducible_lanes) {
+		lanes01 = _mm_add_pd(lanes01, _mm_loadu_pd(arrayPointer + i));
+		lanes23 = _mm_add_pd(lanes23, _mm_loadu_pd(arrayPointer + i + 2));
+		lanes45 = _mm_add_pd(lanes45, _mm_loadu_pd(arrayPointer + i + 4));
+		lanes67 = _mm_add_pd(lanes67, _mm_loadu_pd(arrayPointer + i + 6));
+	}
+	double lanes[reproducible_lanes];
+	_mm_storeu_pd(lanes, lanes01);
+	_mm_storeu_pd(lanes + 2, lanes23);
+	_mm_storeu_pd(lanes + 4, lanes45);
+	_mm_storeu_pd(lanes + 6, lanes67);
+	// Process remaining elements (if any)
+	add_lanes_tail(lanes, arrayPointer + i, length - i);
+	return combine_lanes(lanes);
+}
+#endif
+
+#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+static double block_sum_avx(const double* arrayPointer, size_t length) {
+	__m256d lanes0123 = _mm256_setzero_pd();
+	__m256d lanes4567 = _mm256_setzero_pd();
+	size_t i = 0;
+	for (; i + reproducible_lanes <= length; i += reproducible_lanes) {
+		lanes0123 = _mm256_add_pd(lanes0123, _mm256_loadu_pd(arrayPointer + i));
+		lanes4567 = _mm256_add_pd(lanes4567, _mm256_loadu_pd(arrayPointer + i + 4));
+	}
+	double lanes[reproducible_lanes];
+	_mm256_storeu_pd(lanes, lanes0123);
+	_mm256_storeu_pd(lanes + 4, lanes4567);
+	// Process remaining elements (if any)
+	add_lanes_tail(lanes, arrayPointer + i, length - i);
+	return combine_lanes(lanes);
+}
+#endif
+
+#ifdef CSE6230_AVX512F_INTRINSICS_SUPPORTED
+static double block_sum_avx512f(const double* arrayPointer, size_t length) {
+	__m512d lanes01234567 = _mm512_setzero_pd();
+	size_t i = 0;
+	for (; i + reproducible_lanes <= length; i += reproducible_lanes) {
+		lanes01234567 = _mm512_add_pd(lanes01234567, _mm512_loadu_pd(arrayPointer + i));
+	}
+	double lanes[reproducible_lanes];
+	_mm512_storeu_pd(lanes, lanes01234567);
+	// Process remaining elements (if any)
+	add_lanes_tail(lanes, arrayPointer + i, length - i);
+	return combine_lanes(lanes);
+}
+#endif
+
+template <double (*BlockSum)(const double*, size_t)>
+static double reproducible_sum(const double* arrayPointer, size_t length) {
+	reproducible_pairwise_sum sum;
+	for (size_t blockStart = 0; blockStart < length; blockStart += reproducible_block_length) {
+		const size_t blockLength = (length - blockStart < reproducible_block_length) ? length - blockStart : reproducible_block_length;
+		sum.add_block(BlockSum(arrayPointer + blockStart, blockLength));
+	}
+	return sum.get();
+}
+
+double reproducible_sum_naive(const double* arrayPointer, size_t length) {
+	return reproducible_sum<block_sum_naive>(arrayPointer, length);
+}
+
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+double reproducible_sum_sse2(const double* arrayPointer, size_t length) {
+	return reproducible_sum<block_sum_sse2>(arrayPointer, length);
+}
+#endif
+
+#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+double reproducible_sum_avx(const double* arrayPointer, size_t length) {
+	return reproducible_sum<block_sum_avx>(arrayPointer, length);
+}
+#endif
+
+#ifdef CSE6230_AVX512F_INTRINSICS_SUPPORTED
+double reproducible_sum_avx512f(const double* arrayPointer, size_t length) {
+	return reproducible_sum<block_sum_avx512f>(arrayPointer, length);
+}
+#endif
+
+double reproducible_parallel_sum(size_t blocksCount, size_t threadsCount, reproducible_block_sum_function blockSum, void* context) {
+	if (blocksCount == 0) {
+		return 0.0;
+	}
+	if (threadsCount == 0) {
+		threadsCount = std::thread::hardware_concurrency();
+	}
+	if (threadsCount == 0) {
+		threadsCount = 1;
+	}
+	if (threadsCount > blocksCount) {
+		threadsCount = blocksCount;
+	}
+
+	std::vector<double> blockSums(blocksCount);
+	const auto sumBlocks = [&blockSums, blockSum, context](size_t firstBlock, size_t lastBlock) {
+		for (size_t block = firstBlock; block < lastBlock; block++) {
+			blockSums[block] = blockSum(context, block);
+		}
+	};
+	// The calling thread sums the first range of blocks
+	std::vector<std::thread> threads;
+	for (size_t thread = 1; thread < threadsCount; thread++) {
+		threads.push_back(std::thread(sumBlocks, blocksCount * thread / threadsCount, blocksCount * (thread + 1) / threadsCount));
+	}
+	sumBlocks(0, blocksCount / threadsCount);
+	for (size_t thread = 0; thread < threads.size(); thread++) {
+		threads[thread].join();
+	}
+
+	reproducible_pairwise_sum sum;
+	for (size_t block = 0; block < blocksCount; block++) {
+		sum.add_block(blockSums[block]);
+	}
+	return sum.get();
+}
+
+struct parallel_sum_context {
+	reproducible_sum_function sum;
+	const double* arrayPointer;
+	size_t length;
+};
+
+// The sum of one block is the block sum, so any reproducible sum function computes the block sums
+static double parallel_sum_block(void* context, size_t block) {
+	const parallel_sum_context* sumContext = static_cast<const parallel_sum_context*>(context);
+	return sumContext->sum(sumContext->arrayPointer + block * reproducible_block_length, reproducible_block_size(sumContext->length, block));
+}
+
+double reproducible_sum_parallel(reproducible_sum_function sum, const double* arrayPointer, size_t length, size_t threadsCount) {
+	parallel_sum_context context;
+	context.sum = sum;
+	context.arrayPointer = arrayPointer;
+	context.length = length;
+	const size_t blocksCount = (length + reproducible_block_length - 1) / reproducible_block_length;
+	return reproducible_parallel_sum(blocksCount, threadsCount, parallel_sum_block, &context);
+}
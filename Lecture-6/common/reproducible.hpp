@@ -0,0 +1,102 @@
+/******************************************************************************\
+ *                                                                            *
+ * Copyright (c) 2012 Marat Dukhan                                            *
+ *                                                                            *
+ * This software is provided 'as-is', without any express or implied          *
+ * warranty. In no event will the authors be held liable for any damages      *
+ * arising from the use of this software.                                     *
+ *                                                                            *
+ * Permission is granted to anyone to use this software for any purpose,      *
+ * including commercial applications, and to alter it and redistribute it     *
+ * freely, subject to the following restrictions:                             *
+ *                                                                            *
+ * 1. The origin of this software must not be misrepresented; you must not    *
+ * claim that you wrote the original software. If you use this software       *
+ * in a product, an acknowledgment in the product documentation would be      *
+ * appreciated but is not required.                                           *
+ *                                                                            *
+ * 2. Altered source versions must be plainly marked as such, and must not be *
+ * misrepresented as being the original software.                             *
+ *                                                                            *
+ * 3. This notice may not be removed or altered from any source               *
+ * distribution.                                                              *
+ *                                                                            *
+\******************************************************************************/
+
+#pragma once
+
+#include <stddef.h>
+
+#include <isa.hpp>
+
+// Reproducible sums: the result is bitwise-identical for every instruction set, thread count and array alignment.
+// The array is split into blocks of reproducible_block_length elements at fixed indices. Within a block, element i is
+// added to lane i % 8 in order of the indices, and the 8 lanes are combined with a fixed tree. The block sums are
+// combined with a pairwise tree whose shape only depends on the number of blocks: the left subtree always covers
+// the largest power of two blocks which is smaller than the number of blocks in the tree.
+// SIMD versions keep the 8 lanes in vectors of any width, so they add the same numbers in the same order as the naive
+// version. The source file must be compiled without contraction of multiplications and additions (-ffp-contract=off).
+static const size_t reproducible_block_length = 1024;
+
+typedef double (*reproducible_sum_function)(const double*, size_t);
+
+extern "C" double reproducible_sum_naive(const double* arrayPointer, size_t length);
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+extern "C" double reproducible_sum_sse2(const double* arrayPointer, size_t length);
+#endif
+#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+extern "C" double reproducible_sum_avx(const double* arrayPointer, size_t length);
+#endif
+#ifdef CSE6230_AVX512F_INTRINSICS_SUPPORTED
+extern "C" double reproducible_sum_avx512f(const double* arrayPointer, size_t length);
+#endif
+// Sums the blocks on threadsCount threads (0 = all CPUs) with any of the functions above. The result equals the serial one.
+extern "C" double reproducible_sum_parallel(reproducible_sum_function sum, const double* arrayPointer, size_t length, size_t threadsCount);
+
+// Building blocks of other reproducible reductions, e.g. sums of dot products: they compute the sum of every block
+// with a reproducible_sum_* function, and combine the block sums with the same pairwise tree.
+
+// Number of elements in the block with index block of an array with length elements
+static inline size_t reproducible_block_size(size_t length, size_t block) {
+	const size_t blockStart = block * reproducible_block_length;
+	return (length - blockStart < reproducible_block_length) ? length - blockStart : reproducible_block_length;
+}
+
+// Pairwise sum of the block sums, built as a binary counter: subtrees of 2^k blocks are merged as soon as
+// they are complete, and the incomplete subtrees are merged from the right when the sum is read.
+// This gives the same tree as splitting off the largest power of two smaller than the number of blocks.
+struct reproducible_pairwise_sum {
+	double subtreeSums[64];
+	size_t blocksCount;
+	size_t subtreesCount;
+
+	reproducible_pairwise_sum() : blocksCount(0), subtreesCount(0) {}
+
+	void add_block(double blockSum) {
+		double sum = blockSum;
+		// Every trailing 1 bit of the block number is a complete subtree of the same size as the new one
+		for (size_t blocks = blocksCount; (blocks & 1) != 0; blocks >>= 1) {
+			sum = subtreeSums[--subtreesCount] + sum;
+		}
+		subtreeSums[subtreesCount++] = sum;
+		blocksCount += 1;
+	}
+
+	double get() const {
+		if (subtreesCount == 0) {
+			return 0.0;
+		}
+		double sum = subtreeSums[subtreesCount - 1];
+		for (size_t subtree = subtreesCount - 1; subtree != 0; subtree--) {
+			sum = subtreeSums[subtree - 1] + sum;
+		}
+		return sum;
+	}
+};
+
+// Returns the sum of the block with index block
+typedef double (*reproducible_block_sum_function)(void* context, size_t block);
+
+// Computes the sums of blocksCount blocks with blockSum on threadsCount threads (0 = all CPUs),
+// then adds them in order with reproducible_pairwise_sum
+double reproducible_parallel_sum(size_t blocksCount, size_t threadsCount, reproducible_block_sum_function blockSum, void* context);
@@ -0,0 +1,350 @@
+/******************************************************************************\
+ *                                                                            *
+ * Copyright (c) 2012 Marat Dukhan                                            *
+ *                                                                            *
+ * This software is provided 'as-is', without any express or implied          *
+ * warranty. In no event will the authors be held liable for any damages      *
+ * arising from the use of this software.                                     *
+ *                                                                            *
+ * Permission is granted to anyone to use this software for any purpose,      *
+ * including commercial applications, and to alter it and redistribute it     *
+ * freely, subject to the following restrictions:                             *
+ *                                                                            *
+ * 1. The origin of this software must not be misrepresented; you must not    *
+ * claim that you wrote the original software. If you use this software       *
+ * in a product, an acknowledgment in the product documentation would be      *
+ * appreciated but is not required.                                           *
+ *                                                                            *
+ * 2. Altered source versions must be plainly marked as such, and must not be *
+ * misrepresented as being the original software.                             *
+ *                                                                            *
+ * 3. This notice may not be removed or altered from any source               *
+ * distribution.                                                              *
+ *                                                                            *
+\******************************************************************************/
+
+#include <scaling.hpp>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <mutex>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <condition_variable>
+#if defined(__x86_64__) || defined(__i386__)
+	#include <x86intrin.h>
+#endif
+
+// Timed calls of the kernel on every thread, after one warm-up call
+static const size_t scaling_repetitions = 10;
+// A configuration saturates the memory bandwidth at the smallest thread count which reaches this fraction of the peak
+static const double saturation_fraction = 0.9;
+
+inline static uint64_t read_ticks() {
+#if defined(__x86_64__) || defined(__i386__)
+	return __rdtsc();
+#else
+	return 0;
+#endif
+}
+
+// CPUs the process may run on, sorted by NUMA node
+struct cpu_topology {
+	std::vector<int> cpus;
+	std::vector<int> nodes; // NUMA node of every CPU in cpus
+	int nodesCount;
+};
+
+// Parses a Linux CPU list such as "0-3,8,10-11"
+static void parse_cpu_list(const char* text, std::vector<int>& cpus) {
+	while (*text != '\0' && *text != '\n') {
+		char* end;
+		const long first = strtol(text, &end, 10);
+		if (end == text) {
+			return;
+		}
+		long last = first;
+		text = end;
+		if (*text == '-') {
+			last = strtol(text + 1, &end, 10);
+			text = end;
+		}
+		for (long cpu = first; cpu <= last; cpu++) {
+			cpus.push_back(int(cpu));
+		}
+		if (*text == ',') {
+			text += 1;
+		}
+	}
+}
+
+static cpu_topology detect_topology() {
+	cpu_topology topology;
+	topology.nodesCount = 0;
+
+	cpu_set_t allowed;
+	CPU_ZERO(&allowed);
+	if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) {
+		CPU_SET(0, &allowed);
+	}
+
+	for (int node = 0; ; node++) {
+		char path[64];
+		snprintf(path, sizeof(path), "/sys/devices/system/node/node%d/cpulist", node);
+		FILE* file = fopen(path, "r");
+		if (file == NULL) {
+			break;
+		}
+		char line[4096];
+		std::vector<int> nodeCpus;
+		if (fgets(line, sizeof(line), file) != NULL) {
+			parse_cpu_list(line, nodeCpus);
+		}
+		fclose(file);
+
+		bool nodeUsed = false;
+		for (size_t index = 0; index < nodeCpus.size(); index++) {
+			if (CPU_ISSET(nodeCpus[index], &allowed)) {
+				topology.cpus.push_back(nodeCpus[index]);
+				topology.nodes.push_back(topology.nodesCount);
+				nodeUsed = true;
+			}
+		}
+		if (nodeUsed) {
+			topology.nodesCount += 1;
+		}
+	}
+
+	// Without NUMA information, all allowed CPUs are on one node
+	if (topology.nodesCount == 0) {
+		for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+			if (CPU_ISSET(cpu, &allowed)) {
+				topology.cpus.push_back(cpu);
+				topology.nodes.push_back(0);
+			}
+		}
+		topology.nodesCount = 1;
+	}
+	return topology;
+}
+
+// A CPU on the next NUMA node after the node of the CPU with the given index
+static int remote_cpu(const cpu_topology& topology, size_t cpuIndex) {
+	const int remoteNode = (topology.nodes[cpuIndex] + 1) % topology.nodesCount;
+	for (size_t index = 0; index < topology.cpus.size(); index++) {
+		if (topology.nodes[index] == remoteNode) {
+			return topology.cpus[index];
+		}
+	}
+	return topology.cpus[cpuIndex];
+}
+
+static bool pin_to_cpu(int cpu) {
+	cpu_set_t cpus;
+	CPU_ZERO(&cpus);
+	CPU_SET(cpu, &cpus);
+	return sched_setaffinity(0, sizeof(cpus), &cpus) == 0;
+}
+
+// Page-granular array which is not touched on allocation, so that its pages go to the NUMA node of the first writer
+struct numa_array {
+	double* pointer;
+	size_t size;
+};
+
+static numa_array allocate_untouched(size_t length) {
+	numa_array array;
+	array.size = length * sizeof(double);
+	void* mapping = mmap(NULL, array.size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	array.pointer = (mapping == MAP_FAILED) ? NULL : static_cast<double*>(mapping);
+	return array;
+}
+
+static void free_array(numa_array& array) {
+	if (array.pointer != NULL) {
+		munmap(array.pointer, array.size);
+		array.pointer = NULL;
+	}
+}
+
+// Writes the arrays from a thread pinned to the CPU, which places their pages on the NUMA node of the CPU
+static void first_touch(int cpu, numa_array* arrays, size_t arraysCount) {
+	std::thread toucher([cpu, arrays, arraysCount]() {
+		pin_to_cpu(cpu);
+		for (size_t index = 0; index < arraysCount; index++) {
+			double* pointer = arrays[index].pointer;
+			const size_t length = arrays[index].size / sizeof(double);
+			for (size_t element = 0; element < length; element++) {
+				pointer[element] = 1.0;
+			}
+		}
+	});
+	toucher.join();
+}
+
+class thread_barrier {
+public:
+	explicit thread_barrier(size_t threadsCount) : threadsCount(threadsCount), waitingCount(0), generation(0) {}
+
+	void wait() {
+		std::unique_lock<std::mutex> lock(mutex);
+		const size_t arrivalGeneration = generation;
+		if (++waitingCount == threadsCount) {
+			waitingCount = 0;
+			generation += 1;
+			condition.notify_all();
+		} else {
+			condition.wait(lock, [this, arrivalGeneration]() { return generation != arrivalGeneration; });
+		}
+	}
+
+private:
+	std::mutex mutex;
+	std::condition_variable condition;
+	const size_t threadsCount;
+	size_t waitingCount;
+	size_t generation;
+};
+
+struct scaling_worker {
+	int cpu;
+	const double* vPointer;
+	const double* uPointer;
+	double* outputPointer;
+	uint64_t ticks;
+};
+
+struct scaling_measurement {
+	double gigabytesPerSecond;
+	double cyclesPerElement;
+};
+
+// Runs the kernel on threadsCount threads. Returns a negative bandwidth if the buffers can not be allocated.
+static scaling_measurement measure_scaling(const cpu_topology& topology, const scaling_kernel& kernel, size_t threadsCount, bool sharedBuffers, bool remoteBuffers, size_t outputsPerThread) {
+	scaling_measurement measurement = { -1.0, 0.0 };
+	const size_t inputLength = outputsPerThread * kernel.inputComponents;
+
+	// Every buffer set is three arrays: v, u and output
+	const size_t buffersCount = sharedBuffers ? 1 : threadsCount;
+	const size_t buffersThreads = sharedBuffers ? threadsCount : 1;
+	std::vector<numa_array> arrays(3 * buffersCount);
+	bool allocated = true;
+	for (size_t buffer = 0; buffer < buffersCount; buffer++) {
+		arrays[3 * buffer + 0] = allocate_untouched(inputLength * buffersThreads);
+		arrays[3 * buffer + 1] = allocate_untouched(inputLength * buffersThreads);
+		arrays[3 * buffer + 2] = allocate_untouched(outputsPerThread * buffersThreads);
+		allocated = allocated && arrays[3 * buffer].pointer != NULL && arrays[3 * buffer + 1].pointer != NULL && arrays[3 * buffer + 2].pointer != NULL;
+	}
+	if (allocated) {
+		for (size_t buffer = 0; buffer < buffersCount; buffer++) {
+			const int cpu = remoteBuffers ? remote_cpu(topology, buffer) : topology.cpus[buffer];
+			first_touch(cpu, &arrays[3 * buffer], 3);
+		}
+
+		std::vector<scaling_worker> workers(threadsCount);
+		for (size_t thread = 0; thread < threadsCount; thread++) {
+			const size_t buffer = sharedBuffers ? 0 : thread;
+			const size_t slice = sharedBuffers ? thread : 0;
+			workers[thread].cpu = topology.cpus[thread];
+			workers[thread].vPointer = arrays[3 * buffer + 0].pointer + slice * inputLength;
+			workers[thread].uPointer = arrays[3 * buffer + 1].pointer + slice * inputLength;
+			workers[thread].outputPointer = arrays[3 * buffer + 2].pointer + slice * outputsPerThread;
+			workers[thread].ticks = 0;
+		}
+
+		// The main thread takes part in the barriers to measure the wall time of the timed calls
+		thread_barrier barrier(threadsCount + 1);
+		std::vector<std::thread> threads;
+		for (size_t thread = 0; thread < threadsCount; thread++) {
+			scaling_worker* worker = &workers[thread];
+			threads.push_back(std::thread([worker, &kernel, &barrier, outputsPerThread]() {
+				pin_to_cpu(worker->cpu);
+				kernel.function(worker->vPointer, worker->uPointer, worker->outputPointer, outputsPerThread);
+				barrier.wait();
+				const uint64_t startTicks = read_ticks();
+				for (size_t repetition = 0; repetition < scaling_repetitions; repetition++) {
+					kernel.function(worker->vPointer, worker->uPointer, worker->outputPointer, outputsPerThread);
+				}
+				worker->ticks = read_ticks() - startTicks;
+				barrier.wait();
+			}));
+		}
+		barrier.wait();
+		const std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+		barrier.wait();
+		const std::chrono::steady_clock::time_point endTime = std::chrono::steady_clock::now();
+		for (size_t thread = 0; thread < threadsCount; thread++) {
+			threads[thread].join();
+		}
+
+		const double seconds = std::chrono::duration<double>(endTime - startTime).count();
+		const double bytesPerOutput = double((2 * kernel.inputComponents + 1) * sizeof(double));
+		const double totalBytes = double(threadsCount) * double(scaling_repetitions) * double(outputsPerThread) * bytesPerOutput;
+		measurement.gigabytesPerSecond = totalBytes / seconds * 1.0e-9;
+		uint64_t totalTicks = 0;
+		for (size_t thread = 0; thread < threadsCount; thread++) {
+			totalTicks += workers[thread].ticks;
+		}
+		measurement.cyclesPerElement = double(totalTicks) / double(threadsCount * scaling_repetitions * outputsPerThread);
+	}
+	for (size_t index = 0; index < arrays.size(); index++) {
+		free_array(arrays[index]);
+	}
+	return measurement;
+}
+
+void run_scaling_benchmark(const scaling_kernel* kernels, size_t kernelsCount, size_t maxThreads, size_t outputsPerThread) {
+	const cpu_topology topology = detect_topology();
+	if (maxThreads == 0 || maxThreads > topology.cpus.size()) {
+		maxThreads = topology.cpus.size();
+	}
+	printf("Scaling: %zu threads on %d NUMA nodes, %zu outputs per thread\n", maxThreads, topology.nodesCount, outputsPerThread);
+	printf("%30s\t%8s\t%8s\t%8s\t%10s\t%10s\n", "Scaling Method", "Buffers", "NUMA", "Threads", "GB/s", "Thread CPE");
+
+	for (size_t kernelIndex = 0; kernelIndex < kernelsCount; kernelIndex++) {
+		const scaling_kernel& kernel = kernels[kernelIndex];
+		for (int shared = 0; shared <= 1; shared++) {
+			for (int remote = 0; remote <= 1; remote++) {
+				const char* buffersName = shared ? "shared" : "private";
+				const char* numaName = remote ? "remote" : "local";
+				if (remote && topology.nodesCount < 2) {
+					printf("%30s\t%8s\t%8s\tskipped: single NUMA node\n", kernel.name, buffersName, numaName);
+					continue;
+				}
+
+				std::vector<double> bandwidths;
+				for (size_t threadsCount = 1; threadsCount <= maxThreads; threadsCount++) {
+					const scaling_measurement measurement = measure_scaling(topology, kernel, threadsCount, shared != 0, remote != 0, outputsPerThread);
+					if (measurement.gigabytesPerSecond < 0.0) {
+						printf("%30s\t%8s\t%8s\t%8zu\tfailed to allocate buffers\n", kernel.name, buffersName, numaName, threadsCount);
+						break;
+					}
+					printf("%30s\t%8s\t%8s\t%8zu\t%10.2lf\t%10.2lf\n", kernel.name, buffersName, numaName, threadsCount,
+						measurement.gigabytesPerSecond, measurement.cyclesPerElement);
+					bandwidths.push_back(measurement.gigabytesPerSecond);
+				}
+
+				if (!bandwidths.empty()) {
+					double peakBandwidth = 0.0;
+					for (size_t index = 0; index < bandwidths.size(); index++) {
+						if (bandwidths[index] > peakBandwidth) {
+							peakBandwidth = bandwidths[index];
+						}
+					}
+					size_t saturationThreads = bandwidths.size();
+					for (size_t index = 0; index < bandwidths.size(); index++) {
+						if (bandwidths[index] >= saturation_fraction * peakBandwidth) {
+							saturationThreads = index + 1;
+							break;
+						}
+					}
+					printf("%30s\t%8s\t%8s\tsaturates at %zu threads (%.2lf of %.2lf GB/s peak)\n", kernel.name, buffersName, numaName,
+						saturationThreads, bandwidths[saturationThreads - 1], peakBandwidth);
+				}
+			}
+		}
+	}
+}
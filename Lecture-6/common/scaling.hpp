@@ -0,0 +1,50 @@
+/******************************************************************************\
+ *                                                                            *
+ * Copyright (c) 2012 Marat Dukhan                                            *
+ *                                                                            *
+ * This software is provided 'as-is', without any express or implied          *
+ * warranty. In no event will the authors be held liable for any damages      *
+ * arising from the use of this software.                                     *
+ *                                                                            *
+ * Permission is granted to anyone to use this software for any purpose,      *
+ * including commercial applications, and to alter it and redistribute it     *
+ * freely, subject to the following restrictions:                             *
+ *                                                                            *
+ * 1. The origin of this software must not be misrepresented; you must not    *
+ * claim that you wrote the original software. If you use this software       *
+ * in a product, an acknowledgment in the product documentation would be      *
+ * appreciated but is not required.                                           *
+ *                                                                            *
+ * 2. Altered source versions must be plainly marked as such, and must not be *
+ * misrepresented as being the original software.                             *
+ *                                                                            *
+ * 3. This notice may not be removed or altered from any source               *
+ * distribution.                                                              *
+ *                                                                            *
+\******************************************************************************/
+
+#pragma once
+
+#include <compute.hpp>
+
+// Thread-scaling benchmark for streaming kernels with two input arrays and one output array,
+// e.g. vector_add and vector3d_dot_products.
+typedef void (*streaming_kernel_function)(const double*, const double*, double*, size_t);
+
+struct scaling_kernel {
+	const char* name;
+	streaming_kernel_function function;
+	// Number of doubles in each input array per output element: 1 for vector_add, 3 for vector3d_dot_products
+	size_t inputComponents;
+};
+
+// Runs every kernel on 1, 2, ..., maxThreads threads, pinned to separate CPUs which fill one NUMA node before the next.
+// Every thread count is measured with
+//   private buffers: each thread has its own arrays, first touched by a thread on its NUMA node (local)
+//                    or on the next NUMA node (remote)
+//   shared buffers: all threads process slices of the same arrays, first touched by one thread on the NUMA node of
+//                   the first worker (local) or on the next NUMA node (remote)
+// Remote placements are skipped on single-node systems. For every configuration, prints the aggregate bandwidth in GB/s,
+// the average cycles per element of a thread, and the smallest thread count which reaches 90% of the peak bandwidth.
+// maxThreads = 0 means all CPUs the process may run on. Each thread computes outputsPerThread output elements per call.
+void run_scaling_benchmark(const scaling_kernel* kernels, size_t kernelsCount, size_t maxThreads, size_t outputsPerThread);
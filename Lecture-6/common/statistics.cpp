@@ -0,0 +1,163 @@
+/******************************************************************************\
+ *                                                                            *
+ * Copyright (c) 2012 Marat Dukhan                                            *
+ *                                                                            *
+ * This software is provided 'as-is', without any express or implied          *
+ * warranty. In no event will the authors be held liable for any damages      *
+ * arising from the use of this software.                                     *
+ *                                                                            *
+ * Permission is granted to anyone to use this software for any purpose,      *
+ * including commercial applications, and to alter it and redistribute it     *
+ * freely, subject to the following restrictions:                             *
+ *                                                                            *
+ * 1. The origin of this software must not be misrepresented; you must not    *
+ * claim that you wrote the original software. If you use this software       *
+ * in a product, an acknowledgment in the product documentation would be      *
+ * appreciated but is not required.                                           *
+ *                                                                            *
+ * 2. Altered source versions must be plainly marked as such, and must not be *
+ * misrepresented as being the original software.                             *
+ *                                                                            *
+ * 3. This notice may not be removed or altered from any source               *
+ * distribution.                                                              *
+ *                                                                            *
+\******************************************************************************/
+
+#include <statistics.hpp>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <algorithm>
+
+// Nearest-rank percentile of sorted samples
+static double percentile(const double* sortedSamples, size_t count, double percent) {
+	size_t rank = size_t(ceil(percent / 100.0 * double(count)));
+	if (rank == 0) {
+		rank = 1;
+	}
+	return sortedSamples[rank - 1];
+}
+
+static double median(const double* sortedSamples, size_t count) {
+	if (count % 2 == 0) {
+		return 0.5 * (sortedSamples[count / 2 - 1] + sortedSamples[count / 2]);
+	} else {
+		return sortedSamples[count / 2];
+	}
+}
+
+// Median absolute deviation of sorted samples from their median
+static double median_absolute_deviation(const double* sortedSamples, size_t count, double center) {
+	double* deviations = static_cast<double*>(malloc(count * sizeof(double)));
+	if (deviations == NULL) {
+		return 0.0;
+	}
+	for (size_t index = 0; index < count; index++) {
+		deviations[index] = fabs(sortedSamples[index] - center);
+	}
+	std::sort(deviations, deviations + count);
+	const double mad = median(deviations, count);
+	free(deviations);
+	return mad;
+}
+
+sample_statistics compute_sample_statistics(double* samples, size_t count) {
+	sample_statistics statistics;
+	memset(&statistics, 0, sizeof(statistics));
+	if (count == 0) {
+		return statistics;
+	}
+	std::sort(samples, samples + count);
+
+	// Outliers are at both ends of the sorted samples: keep the range [first, last)
+	size_t first = 0;
+	size_t last = count;
+	const double center = median(samples, count);
+	const double mad = median_absolute_deviation(samples, count, center);
+	if (mad > 0.0) {
+		const double threshold = 3.5 / 0.6745 * mad;
+		while (center - samples[first] > threshold) {
+			first += 1;
+		}
+		while (samples[last - 1] - center > threshold) {
+			last -= 1;
+		}
+	}
+
+	const double* kept = samples + first;
+	const size_t keptCount = last - first;
+	statistics.count = keptCount;
+	statistics.outliers_count = count - keptCount;
+	statistics.min = kept[0];
+	statistics.p10 = percentile(kept, keptCount, 10.0);
+	statistics.median = median(kept, keptCount);
+	statistics.p90 = percentile(kept, keptCount, 90.0);
+	statistics.p99 = percentile(kept, keptCount, 99.0);
+	statistics.mad = median_absolute_deviation(kept, keptCount, statistics.median);
+	return statistics;
+}
+
+static double median_standard_error(const sample_statistics& statistics) {
+	if (statistics.count == 0) {
+		return 0.0;
+	}
+	return 1.2533 * 1.4826 * statistics.mad / sqrt(double(statistics.count));
+}
+
+comparison_result compare_sample_statistics(const sample_statistics& baseline, const sample_statistics& current) {
+	const double difference = current.median - baseline.median;
+	const double baselineError = median_standard_error(baseline);
+	const double currentError = median_standard_error(current);
+	const double standardError = sqrt(baselineError * baselineError + currentError * currentError);
+	if (fabs(difference) <= 0.01 * baseline.median || fabs(difference) <= 3.0 * standardError) {
+		return comparison_not_significant;
+	}
+	return difference < 0.0 ? comparison_speedup : comparison_regression;
+}
+
+bool save_benchmark_results(const char* path, const benchmark_result* results, size_t count) {
+	FILE* file = fopen(path, "w");
+	if (file == NULL) {
+		return false;
+	}
+	fprintf(file, "# name\tcount\toutliers\tmin\tp10\tmedian\tp90\tp99\tmad\n");
+	for (size_t index = 0; index < count; index++) {
+		const sample_statistics& statistics = results[index].statistics;
+		fprintf(file, "%s\t%zu\t%zu\t%.17g\t%.17g\t%.17g\t%.17g\t%.17g\t%.17g\n", results[index].name,
+			statistics.count, statistics.outliers_count,
+			statistics.min, statistics.p10, statistics.median, statistics.p90, statistics.p99, statistics.mad);
+	}
+	const bool success = ferror(file) == 0;
+	return (fclose(file) == 0) && success;
+}
+
+size_t load_benchmark_results(const char* path, benchmark_result* results, size_t capacity) {
+	FILE* file = fopen(path, "r");
+	if (file == NULL) {
+		return 0;
+	}
+	size_t count = 0;
+	char line[1024];
+	while (count < capacity && fgets(line, sizeof(line), file) != NULL) {
+		if (line[0] == '#') {
+			continue;
+		}
+		char* tab = strchr(line, '\t');
+		if (tab == NULL || size_t(tab - line) >= benchmark_result_name_size) {
+			continue;
+		}
+		benchmark_result& result = results[count];
+		memcpy(result.name, line, tab - line);
+		result.name[tab - line] = '\0';
+		sample_statistics& statistics = result.statistics;
+		if (sscanf(tab + 1, "%zu\t%zu\t%lf\t%lf\t%lf\t%lf\t%lf\t%lf",
+			&statistics.count, &statistics.outliers_count,
+			&statistics.min, &statistics.p10, &statistics.median, &statistics.p90, &statistics.p99, &statistics.mad) == 8)
+		{
+			count += 1;
+		}
+	}
+	fclose(file);
+	return count;
+}
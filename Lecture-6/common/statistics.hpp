@@ -0,0 +1,69 @@
+/******************************************************************************\
+ *                                                                            *
+ * Copyright (c) 2012 Marat Dukhan                                            *
+ *                                                                            *
+ * This software is provided 'as-is', without any express or implied          *
+ * warranty. In no event will the authors be held liable for any damages      *
+ * arising from the use of this software.                                     *
+ *                                                                            *
+ * Permission is granted to anyone to use this software for any purpose,      *
+ * including commercial applications, and to alter it and redistribute it     *
+ * freely, subject to the following restrictions:                             *
+ *                                                                            *
+ * 1. The origin of this software must not be misrepresented; you must not    *
+ * claim that you wrote the original software. If you use this software       *
+ * in a product, an acknowledgment in the product documentation would be      *
+ * appreciated but is not required.                                           *
+ *                                                                            *
+ * 2. Altered source versions must be plainly marked as such, and must not be *
+ * misrepresented as being the original software.                             *
+ *                                                                            *
+ * 3. This notice may not be removed or altered from any source               *
+ * distribution.                                                              *
+ *                                                                            *
+\******************************************************************************/
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Robust statistics of benchmark samples (e.g. cycles per element of individual repetitions)
+struct sample_statistics {
+	size_t count; // samples left after outlier rejection
+	size_t outliers_count;
+	double min;
+	double p10;
+	double median;
+	double p90;
+	double p99;
+	double mad; // median absolute deviation from the median
+};
+
+// Sorts the samples and rejects outliers with a modified z-score 0.6745 * |x - median| / MAD above 3.5.
+// If MAD is zero no samples are rejected. Returns all-zero statistics if count is 0.
+sample_statistics compute_sample_statistics(double* samples, size_t count);
+
+enum comparison_result {
+	comparison_not_significant,
+	comparison_speedup,
+	comparison_regression
+};
+
+// Compares the medians of two sets of samples of a lower-is-better metric.
+// The difference is significant if it exceeds both 1% of the baseline median and three standard errors,
+// where the standard error of each median is estimated from its MAD as 1.2533 * 1.4826 * MAD / sqrt(count).
+comparison_result compare_sample_statistics(const sample_statistics& baseline, const sample_statistics& current);
+
+static const size_t benchmark_result_name_size = 128;
+
+struct benchmark_result {
+	char name[benchmark_result_name_size];
+	sample_statistics statistics;
+};
+
+// Result files have one tab-separated line per result: name, count, outliers_count, min, p10, median, p90, p99, mad.
+// Lines starting with # are comments. save_benchmark_results returns false if the file can not be written.
+// load_benchmark_results returns the number of loaded results (at most capacity), or 0 if the file can not be read.
+bool save_benchmark_results(const char* path, const benchmark_result* results, size_t count);
+size_t load_benchmark_results(const char* path, benchmark_result* results, size_t capacity);
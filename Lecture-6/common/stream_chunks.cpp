@@ -0,0 +1,187 @@
+/******************************************************************************\
+ *                                                                            *
+ * Copyright (c) 2012 Marat Dukhan                                            *
+ *                                                                            *
+ * This software is provided 'as-is', without any express or implied          *
+ * warranty. In no event will the authors be held liable for any damages      *
+ * arising from the use of this software.                                     *
+ *                                                                            *
+ * Permission is granted to anyone to use this software for any purpose,      *
+ * including commercial applications, and to alter it and redistribute it     *
+ * freely, subject to the following restrictions:                             *
+ *                                                                            *
+ * 1. The origin of this software must not be misrepresented; you must not    *
+ * claim that you wrote the original software. If you use this software       *
+ * in a product, an acknowledgment in the product documentation would be      *
+ * appreciated but is not required.                                           *
+ *                                                                            *
+ * 2. Altered source versions must be plainly marked as such, and must not be *
+ * misrepresented as being the original software.                             *
+ *                                                                            *
+ * 3. This notice may not be removed or altered from any source               *
+ * distribution.                                                              *
+ *                                                                            *
+\******************************************************************************/
+
+#include <stream_chunks.hpp>
+#include <stdlib.h>
+#include <errno.h>
+#include <unistd.h>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+
+// Chunk buffers are aligned on pages and sized in multiples of pages, as required for files opened with O_DIRECT
+static const size_t stream_alignment = 4096;
+// Reads are rounded up to a multiple of the logical block size, so the read of the last partial chunk is valid with O_DIRECT
+static const size_t stream_read_granularity = 512;
+static const size_t stream_max_inputs = 4;
+
+enum stream_slot_status {
+	stream_slot_empty,
+	stream_slot_loaded,
+	stream_slot_failed
+};
+
+struct stream_slot {
+	double* inputs[stream_max_inputs];
+	stream_slot_status status;
+};
+
+struct stream_buffers {
+	stream_slot slots[2];
+	std::mutex mutex;
+	std::condition_variable changed;
+	bool cancelled;
+};
+
+// Reads at least requiredSize and at most size bytes. Fails if the file ends or fails before requiredSize bytes.
+static bool read_at_least(int file, void* buffer, size_t requiredSize, size_t size, off_t offset) {
+	char* pointer = static_cast<char*>(buffer);
+	while (requiredSize != 0) {
+		const ssize_t bytesRead = pread(file, pointer, size, offset);
+		if (bytesRead < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			return false;
+		}
+		if (bytesRead == 0) {
+			return false;
+		}
+		pointer += bytesRead;
+		size -= size_t(bytesRead);
+		requiredSize = (requiredSize > size_t(bytesRead)) ? requiredSize - size_t(bytesRead) : 0;
+		offset += off_t(bytesRead);
+	}
+	return true;
+}
+
+bool write_fully(int file, const void* buffer, size_t size, off_t offset) {
+	const char* pointer = static_cast<const char*>(buffer);
+	while (size != 0) {
+		const ssize_t bytesWritten = pwrite(file, pointer, size, offset);
+		if (bytesWritten < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			return false;
+		}
+		pointer += bytesWritten;
+		size -= size_t(bytesWritten);
+		offset += off_t(bytesWritten);
+	}
+	return true;
+}
+
+// Loads chunk after chunk of every input file into the two slots in turn
+static void load_chunks(stream_buffers* buffers, const int* files, const size_t* components, size_t inputsCount, size_t length, size_t chunkLength) {
+	size_t chunkNumber = 0;
+	for (size_t chunkStart = 0; chunkStart < length; chunkStart += chunkLength, chunkNumber += 1) {
+		stream_slot& slot = buffers->slots[chunkNumber % 2];
+		{
+			std::unique_lock<std::mutex> lock(buffers->mutex);
+			buffers->changed.wait(lock, [buffers, &slot]() { return buffers->cancelled || (slot.status == stream_slot_empty); });
+			if (buffers->cancelled) {
+				return;
+			}
+		}
+
+		const size_t currentLength = (length - chunkStart < chunkLength) ? length - chunkStart : chunkLength;
+		bool loaded = true;
+		for (size_t input = 0; loaded && (input < inputsCount); input++) {
+			// Only the last chunk can end in the middle of a block: the bytes past the array are read and ignored
+			const size_t elementSize = components[input] * sizeof(double);
+			const size_t size = currentLength * elementSize;
+			const size_t roundedSize = (size + stream_read_granularity - 1) / stream_read_granularity * stream_read_granularity;
+			loaded = read_at_least(files[input], slot.inputs[input], size, roundedSize, off_t(chunkStart * elementSize));
+		}
+
+		std::lock_guard<std::mutex> lock(buffers->mutex);
+		slot.status = loaded ? stream_slot_loaded : stream_slot_failed;
+		buffers->changed.notify_all();
+		if (!loaded) {
+			return;
+		}
+	}
+}
+
+bool stream_chunks(const int* files, const size_t* components, size_t inputsCount, size_t length, size_t chunkLength, stream_chunk_function function, void* context) {
+	if (chunkLength == 0) {
+		chunkLength = stream_default_chunk_length;
+	}
+
+	stream_buffers buffers;
+	buffers.cancelled = false;
+	bool allocated = true;
+	for (size_t slotNumber = 0; slotNumber < 2; slotNumber++) {
+		stream_slot& slot = buffers.slots[slotNumber];
+		slot.status = stream_slot_empty;
+		for (size_t input = 0; input < stream_max_inputs; input++) {
+			slot.inputs[input] = NULL;
+		}
+		for (size_t input = 0; input < inputsCount; input++) {
+			const size_t size = chunkLength * components[input] * sizeof(double);
+			const size_t alignedSize = (size + stream_alignment - 1) / stream_alignment * stream_alignment;
+			void* buffer = NULL;
+			if (posix_memalign(&buffer, stream_alignment, alignedSize) != 0) {
+				allocated = false;
+				break;
+			}
+			slot.inputs[input] = static_cast<double*>(buffer);
+		}
+	}
+
+	bool succeeded = allocated;
+	if (allocated) {
+		std::thread reader(load_chunks, &buffers, files, components, inputsCount, length, chunkLength);
+		size_t chunkNumber = 0;
+		for (size_t chunkStart = 0; succeeded && (chunkStart < length); chunkStart += chunkLength, chunkNumber += 1) {
+			stream_slot& slot = buffers.slots[chunkNumber % 2];
+			{
+				std::unique_lock<std::mutex> lock(buffers.mutex);
+				buffers.changed.wait(lock, [&slot]() { return slot.status != stream_slot_empty; });
+			}
+			if (slot.status == stream_slot_failed) {
+				succeeded = false;
+				break;
+			}
+
+			const size_t currentLength = (length - chunkStart < chunkLength) ? length - chunkStart : chunkLength;
+			succeeded = function(context, slot.inputs, chunkStart, currentLength);
+
+			std::lock_guard<std::mutex> lock(buffers.mutex);
+			slot.status = stream_slot_empty;
+			buffers.cancelled = !succeeded;
+			buffers.changed.notify_all();
+		}
+		reader.join();
+	}
+
+	for (size_t slotNumber = 0; slotNumber < 2; slotNumber++) {
+		for (size_t input = 0; input < stream_max_inputs; input++) {
+			free(buffers.slots[slotNumber].inputs[input]);
+		}
+	}
+	return succeeded;
+}
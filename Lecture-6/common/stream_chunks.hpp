@@ -0,0 +1,46 @@
+/******************************************************************************\
+ *                                                                            *
+ * Copyright (c) 2012 Marat Dukhan                                            *
+ *                                                                            *
+ * This software is provided 'as-is', without any express or implied          *
+ * warranty. In no event will the authors be held liable for any damages      *
+ * arising from the use of this software.                                     *
+ *                                                                            *
+ * Permission is granted to anyone to use this software for any purpose,      *
+ * including commercial applications, and to alter it and redistribute it     *
+ * freely, subject to the following restrictions:                             *
+ *                                                                            *
+ * 1. The origin of this software must not be misrepresented; you must not    *
+ * claim that you wrote the original software. If you use this software       *
+ * in a product, an acknowledgment in the product documentation would be      *
+ * appreciated but is not required.                                           *
+ *                                                                            *
+ * 2. Altered source versions must be plainly marked as such, and must not be *
+ * misrepresented as being the original software.                             *
+ *                                                                            *
+ * 3. This notice may not be removed or altered from any source               *
+ * distribution.                                                              *
+ *                                                                            *
+\******************************************************************************/
+
+#pragma once
+
+#include <stddef.h>
+#include <sys/types.h>
+
+// Double-buffered chunk engine of the streaming kernels. Every input i is an array of components[i] doubles per element
+// at offset 0 of its file; at most stream_max_inputs inputs are supported.
+static const size_t stream_default_chunk_length = 1024 * 1024;
+
+// Called on the caller's thread for every loaded chunk. inputs[i] points to chunkLength * components[i] doubles
+// of input i, starting from element chunkStart. Returns false to stop streaming.
+typedef bool (*stream_chunk_function)(void* context, const double* const* inputs, size_t chunkStart, size_t chunkLength);
+
+// Streams length elements of the input files through function in chunks of chunkLength elements (0 = default).
+// A reader thread loads the next chunk into one half of a double buffer while function processes the other half,
+// so the throughput is limited by the slower of storage and compute rather than their sum.
+// Returns false if an input can not be read in full or function stops the stream.
+bool stream_chunks(const int* files, const size_t* components, size_t inputsCount, size_t length, size_t chunkLength, stream_chunk_function function, void* context);
+
+// Writes exactly size bytes at offset, retrying interrupted and partial writes. Returns false if the file fails.
+bool write_fully(int file, const void* buffer, size_t size, off_t offset);
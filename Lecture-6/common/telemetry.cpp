@@ -0,0 +1,327 @@
+/******************************************************************************\
+ *                                                                            *
+ * Copyright (c) 2012 Marat Dukhan                                            *
+ *                                                                            *
+ * This software is provided 'as-is', without any express or implied          *
+ * warranty. In no event will the authors be held liable for any damages      *
+ * arising from the use of this software.                                     *
+ *                                                                            *
+ * Permission is granted to anyone to use this software for any purpose,      *
+ * including commercial applications, and to alter it and redistribute it     *
+ * freely, subject to the following restrictions:                             *
+ *                                                                            *
+ * 1. The origin of this software must not be misrepresented; you must not    *
+ * claim that you wrote the original software. If you use this software       *
+ * in a product, an acknowledgment in the product documentation would be      *
+ * appreciated but is not required.                                           *
+ *                                                                            *
+ * 2. Altered source versions must be plainly marked as such, and must not be *
+ * misrepresented as being the original software.                             *
+ *                                                                            *
+ * 3. This notice may not be removed or altered from any source               *
+ * distribution.                                                              *
+ *                                                                            *
+\******************************************************************************/
+
+#include <telemetry.hpp>
+#include <new>
+#include <errno.h>
+#include <signal.h>
+#include <string.h>
+#include <unistd.h>
+#if defined(CSE6230_SSE2_INTRINSICS_SUPPORTED)
+	#include <x86intrin.h>
+#else
+	#include <chrono>
+#endif
+
+// Histograms are indexed by kernel_registry_operation
+static const size_t operations_count = size_t(kernel_registry_operation_batched_matmul_8x8) + 1;
+// Bucket 0 counts zeros, and bucket b > 0 counts values in [2**(b-1), 2**b)
+static const size_t buckets_count = 65;
+// Alignments of 1, 2, 4, ..., 32 and at least 64 bytes
+static const size_t alignment_classes_count = 7;
+
+struct operation_histograms {
+	size_t callsUntilSample; // Only accessed by the owning thread
+	std::atomic<uint64_t> calls;
+	std::atomic<uint64_t> lengths[buckets_count];
+	std::atomic<uint64_t> alignments[alignment_classes_count];
+	std::atomic<uint64_t> ticks[buckets_count];
+};
+
+// Histograms of one thread. Blocks are never freed, as the dump may traverse the list in a signal handler:
+// when a thread exits, its counts move to the retired histograms and the block is reused by the next new thread.
+struct thread_telemetry {
+	thread_telemetry* next; // Link in the list of all blocks, immutable after publication
+	std::atomic<bool> owned; // Set while a thread records its calls in the block
+	operation_histograms operations[operations_count];
+};
+
+// Releases the histograms of the thread when it exits
+struct thread_telemetry_owner {
+	thread_telemetry* telemetry;
+
+	~thread_telemetry_owner();
+};
+
+std::atomic<bool> kernel_telemetry_enabled(false);
+
+static std::atomic<thread_telemetry*> threads_head(NULL);
+// Sums of the histograms of the exited threads
+static operation_histograms retired_operations[operations_count];
+// The recording functions only use the plain pointer: the owner has a destructor, and accessing it costs an initialization check
+static thread_local thread_telemetry* current_thread = NULL;
+static thread_local thread_telemetry_owner current_owner;
+// Calls from the destructors of other thread_local objects, which may run after the owner, are not recorded
+static thread_local bool current_thread_exited = false;
+static volatile sig_atomic_t dump_signal_fd = -1;
+
+static inline uint64_t read_ticks() {
+#if defined(CSE6230_SSE2_INTRINSICS_SUPPORTED)
+	// Not serializing: the durations of very short calls are approximate
+	return __rdtsc();
+#else
+	return std::chrono::steady_clock::now().time_since_epoch().count();
+#endif
+}
+
+static inline size_t bucket_of(uint64_t value) {
+	return (value == 0) ? 0 : size_t(64 - __builtin_clzll(value));
+}
+
+// Only the owning thread modifies the counters, so a plain load and store is enough
+static inline void increment(std::atomic<uint64_t>& counter) {
+	counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+// Claims a block which an exited thread released, or allocates a new one
+static thread_telemetry* register_thread() {
+	if (current_thread_exited) {
+		return NULL;
+	}
+	thread_telemetry* telemetry = NULL;
+	for (thread_telemetry* candidate = threads_head.load(std::memory_order_acquire); candidate != NULL; candidate = candidate->next) {
+		bool owned = false;
+		if (!candidate->owned.load(std::memory_order_relaxed) &&
+			candidate->owned.compare_exchange_strong(owned, true, std::memory_order_acquire, std::memory_order_relaxed))
+		{
+			telemetry = candidate;
+			break;
+		}
+	}
+	if (telemetry == NULL) {
+		telemetry = new (std::nothrow) thread_telemetry();
+		if (telemetry == NULL) {
+			return NULL;
+		}
+		for (size_t operation = 0; operation < operations_count; operation++) {
+			telemetry->operations[operation].callsUntilSample = 1;
+		}
+		telemetry->owned.store(true, std::memory_order_relaxed);
+		thread_telemetry* head = threads_head.load(std::memory_order_relaxed);
+		do {
+			telemetry->next = head;
+		} while (!threads_head.compare_exchange_weak(head, telemetry, std::memory_order_release, std::memory_order_relaxed));
+	}
+	current_owner.telemetry = telemetry;
+	current_thread = telemetry;
+	return telemetry;
+}
+
+// Several threads may exit at the same time, so the retired histograms need atomic additions
+static inline void retire(std::atomic<uint64_t>& retiredCounter, std::atomic<uint64_t>& counter) {
+	const uint64_t count = counter.exchange(0, std::memory_order_relaxed);
+	if (count != 0) {
+		retiredCounter.fetch_add(count, std::memory_order_relaxed);
+	}
+}
+
+thread_telemetry_owner::~thread_telemetry_owner() {
+	current_thread_exited = true;
+	current_thread = NULL;
+	if (telemetry == NULL) {
+		return;
+	}
+	for (size_t operation = 0; operation < operations_count; operation++) {
+		operation_histograms* histograms = &telemetry->operations[operation];
+		operation_histograms* retiredHistograms = &retired_operations[operation];
+		retire(retiredHistograms->calls, histograms->calls);
+		for (size_t bucket = 0; bucket < buckets_count; bucket++) {
+			retire(retiredHistograms->lengths[bucket], histograms->lengths[bucket]);
+			retire(retiredHistograms->ticks[bucket], histograms->ticks[bucket]);
+		}
+		for (size_t alignmentClass = 0; alignmentClass < alignment_classes_count; alignmentClass++) {
+			retire(retiredHistograms->alignments[alignmentClass], histograms->alignments[alignmentClass]);
+		}
+		histograms->callsUntilSample = 1;
+	}
+	// Release ordering publishes the zeroed counters to the thread which claims the block next
+	telemetry->owned.store(false, std::memory_order_release);
+	telemetry = NULL;
+}
+
+void kernel_telemetry_enable(bool enabled) {
+	kernel_telemetry_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+uint64_t kernel_telemetry_begin(kernel_registry_operation operation, size_t length, uintptr_t pointerBits) {
+	thread_telemetry* telemetry = current_thread;
+	if (telemetry == NULL) {
+		telemetry = register_thread();
+		if (telemetry == NULL) {
+			return 0;
+		}
+	}
+	operation_histograms* histograms = &telemetry->operations[operation];
+	increment(histograms->calls);
+	increment(histograms->lengths[bucket_of(length)]);
+	increment(histograms->alignments[__builtin_ctzll(uint64_t(pointerBits) | 64)]);
+	if (--histograms->callsUntilSample != 0) {
+		return 0;
+	}
+	histograms->callsUntilSample = kernel_telemetry_sampling_period;
+	return read_ticks();
+}
+
+void kernel_telemetry_end(kernel_registry_operation operation, uint64_t startTicks) {
+	if (startTicks == 0) {
+		return;
+	}
+	const uint64_t elapsedTicks = read_ticks() - startTicks;
+	increment(current_thread->operations[operation].ticks[bucket_of(elapsedTicks)]);
+}
+
+// Formatting for kernel_telemetry_dump: only async-signal-safe functions may be used
+
+struct dump_buffer {
+	int fd;
+	size_t length;
+	char data[256];
+};
+
+static void dump_flush(dump_buffer* buffer) {
+	const char* pointer = buffer->data;
+	size_t size = buffer->length;
+	while (size != 0) {
+		const ssize_t bytesWritten = write(buffer->fd, pointer, size);
+		if (bytesWritten < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			break;
+		}
+		pointer += bytesWritten;
+		size -= size_t(bytesWritten);
+	}
+	buffer->length = 0;
+}
+
+static void dump_char(dump_buffer* buffer, char character) {
+	if (buffer->length == sizeof(buffer->data)) {
+		dump_flush(buffer);
+	}
+	buffer->data[buffer->length++] = character;
+}
+
+static void dump_string(dump_buffer* buffer, const char* string) {
+	while (*string != '\0') {
+		dump_char(buffer, *string++);
+	}
+}
+
+static void dump_number(dump_buffer* buffer, uint64_t number) {
+	char digits[20];
+	size_t digitsCount = 0;
+	do {
+		digits[digitsCount++] = char('0' + number % 10);
+		number /= 10;
+	} while (number != 0);
+	while (digitsCount != 0) {
+		dump_char(buffer, digits[--digitsCount]);
+	}
+}
+
+static void dump_line(dump_buffer* buffer, const char* operationName, const char* histogramName, uint64_t bound, uint64_t count) {
+	dump_string(buffer, operationName);
+	dump_char(buffer, '\t');
+	dump_string(buffer, histogramName);
+	dump_char(buffer, '\t');
+	dump_number(buffer, bound);
+	dump_char(buffer, '\t');
+	dump_number(buffer, count);
+	dump_char(buffer, '\n');
+}
+
+struct operation_totals {
+	uint64_t calls;
+	uint64_t lengths[buckets_count];
+	uint64_t alignments[alignment_classes_count];
+	uint64_t ticks[buckets_count];
+};
+
+static void add_histograms(operation_totals* totals, const operation_histograms* histograms) {
+	totals->calls += histograms->calls.load(std::memory_order_relaxed);
+	for (size_t bucket = 0; bucket < buckets_count; bucket++) {
+		totals->lengths[bucket] += histograms->lengths[bucket].load(std::memory_order_relaxed);
+		totals->ticks[bucket] += histograms->ticks[bucket].load(std::memory_order_relaxed);
+	}
+	for (size_t alignmentClass = 0; alignmentClass < alignment_classes_count; alignmentClass++) {
+		totals->alignments[alignmentClass] += histograms->alignments[alignmentClass].load(std::memory_order_relaxed);
+	}
+}
+
+static void dump_buckets(dump_buffer* buffer, const char* operationName, const char* histogramName, const uint64_t counts[buckets_count]) {
+	for (size_t bucket = 0; bucket < buckets_count; bucket++) {
+		if (counts[bucket] != 0) {
+			dump_line(buffer, operationName, histogramName, (bucket == 0) ? 0 : uint64_t(1) << (bucket - 1), counts[bucket]);
+		}
+	}
+}
+
+void kernel_telemetry_dump(int fd) {
+	dump_buffer buffer;
+	buffer.fd = fd;
+	buffer.length = 0;
+	for (size_t operation = 0; operation < operations_count; operation++) {
+		operation_totals totals;
+		memset(&totals, 0, sizeof(totals));
+		add_histograms(&totals, &retired_operations[operation]);
+		for (const thread_telemetry* telemetry = threads_head.load(std::memory_order_acquire); telemetry != NULL; telemetry = telemetry->next) {
+			add_histograms(&totals, &telemetry->operations[operation]);
+		}
+		if (totals.calls == 0) {
+			continue;
+		}
+
+		const char* operationName = kernel_registry_operation_name(kernel_registry_operation(operation));
+		dump_string(&buffer, operationName);
+		dump_string(&buffer, "\tcalls\t");
+		dump_number(&buffer, totals.calls);
+		dump_char(&buffer, '\n');
+		dump_buckets(&buffer, operationName, "length", totals.lengths);
+		for (size_t alignmentClass = 0; alignmentClass < alignment_classes_count; alignmentClass++) {
+			if (totals.alignments[alignmentClass] != 0) {
+				dump_line(&buffer, operationName, "alignment", uint64_t(1) << alignmentClass, totals.alignments[alignmentClass]);
+			}
+		}
+		dump_buckets(&buffer, operationName, "ticks", totals.ticks);
+	}
+	dump_flush(&buffer);
+}
+
+static void dump_signal_handler(int) {
+	const int savedErrno = errno;
+	kernel_telemetry_dump(dump_signal_fd);
+	errno = savedErrno;
+}
+
+bool kernel_telemetry_dump_on_signal(int signalNumber, int fd) {
+	dump_signal_fd = fd;
+	struct sigaction action;
+	memset(&action, 0, sizeof(action));
+	action.sa_handler = &dump_signal_handler;
+	action.sa_flags = SA_RESTART;
+	sigemptyset(&action.sa_mask);
+	return sigaction(signalNumber, &action, NULL) == 0;
+}
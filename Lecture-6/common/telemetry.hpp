@@ -0,0 +1,66 @@
+/******************************************************************************\
+ *                                                                            *
+ * Copyright (c) 2012 Marat Dukhan                                            *
+ *                                                                            *
+ * This software is provided 'as-is', without any express or implied          *
+ * warranty. In no event will the authors be held liable for any damages      *
+ * arising from the use of this software.                                     *
+ *                                                                            *
+ * Permission is granted to anyone to use this software for any purpose,      *
+ * including commercial applications, and to alter it and redistribute it     *
+ * freely, subject to the following restrictions:                             *
+ *                                                                            *
+ * 1. The origin of this software must not be misrepresented; you must not    *
+ * claim that you wrote the original software. If you use this software       *
+ * in a product, an acknowledgment in the product documentation would be      *
+ * appreciated but is not required.                                           *
+ *                                                                            *
+ * 2. Altered source versions must be plainly marked as such, and must not be *
+ * misrepresented as being the original software.                             *
+ *                                                                            *
+ * 3. This notice may not be removed or altered from any source               *
+ * distribution.                                                              *
+ *                                                                            *
+\******************************************************************************/
+
+#pragma once
+
+#include <registry.hpp>
+#include <atomic>
+
+// Opt-in telemetry of the kernel calls which go through the dispatchers.
+// Every thread which calls a dispatcher keeps its own histograms for every operation: the number of calls,
+// array lengths in power-of-two buckets, the alignment of the array pointers, and the durations of sampled calls
+// in time stamp counter ticks, also in power-of-two buckets. Only the owning thread writes its histograms,
+// so recording takes no locks and no atomic read-modify-write operations. When a thread exits, its counts are added
+// to the totals of the exited threads, and its histograms are reused by the next thread which calls a dispatcher.
+// Telemetry is disabled by default; then the dispatchers only check one flag.
+
+// Every thread measures the duration of one in this many of its recorded calls of each operation
+static const size_t kernel_telemetry_sampling_period = 64;
+
+extern "C" void kernel_telemetry_enable(bool enabled);
+// Writes the histograms, summed over all threads, to the file descriptor as lines of tab-separated fields:
+//   "<operation>\tcalls\t<count>"
+//   "<operation>\tlength\t<lower bound of the bucket>\t<count>"
+//   "<operation>\talignment\t<bytes>\t<count>"
+//   "<operation>\tticks\t<lower bound of the bucket>\t<count>"
+// Alignment is the largest power of two, up to 64, which divides the addresses of all array arguments.
+// Operations without calls and empty buckets are skipped. The function is async-signal-safe.
+// Calls which are recorded concurrently may be partially included,
+// and the counts of a thread which exits concurrently may be missing.
+extern "C" void kernel_telemetry_dump(int fd);
+// Installs a handler which dumps the histograms to the file descriptor when the process receives the signal.
+// Returns false if the handler could not be installed.
+extern "C" bool kernel_telemetry_dump_on_signal(int signalNumber, int fd);
+
+// Recording interface of the dispatchers. length is the number of array elements, or of dot products for vector3d_dot_products,
+// and pointerBits is the bitwise OR of the addresses of all array arguments.
+// kernel_telemetry_begin returns the start time if the duration of the call is sampled, and 0 otherwise.
+extern std::atomic<bool> kernel_telemetry_enabled;
+extern "C" uint64_t kernel_telemetry_begin(kernel_registry_operation operation, size_t length, uintptr_t pointerBits);
+extern "C" void kernel_telemetry_end(kernel_registry_operation operation, uint64_t startTicks);
+
+inline bool kernel_telemetry_is_enabled() {
+	return kernel_telemetry_enabled.load(std::memory_order_relaxed);
+}
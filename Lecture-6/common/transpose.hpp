@@ -0,0 +1,49 @@
+/******************************************************************************\
+ *                                                                            *
+ * Copyright (c) 2012 Marat Dukhan                                            *
+ *                                                                            *
+ * This software is provided 'as-is', without any express or implied          *
+ * warranty. In no event will the authors be held liable for any damages      *
+ * arising from the use of this software.                                     *
+ *                                                                            *
+ * Permission is granted to anyone to use this software for any purpose,      *
+ * including commercial applications, and to alter it and redistribute it     *
+ * freely, subject to the following restrictions:                             *
+ *                                                                            *
+ * 1. The origin of this software must not be misrepresented; you must not    *
+ * claim that you wrote the original software. If you use this software       *
+ * in a product, an acknowledgment in the product documentation would be      *
+ * appreciated but is not required.                                           *
+ *                                                                            *
+ * 2. Altered source versions must be plainly marked as such, and must not be *
+ * misrepresented as being the original software.                             *
+ *                                                                            *
+ * 3. This notice may not be removed or altered from any source               *
+ * distribution.                                                              *
+ *                                                                            *
+\******************************************************************************/
+
+#pragma once
+
+#include <compute.hpp>
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+	#if defined(__GNUC__)
+		#include <x86intrin.h>
+	#elif defined(_MSC_VER)
+		#include <intrin.h>
+	#else
+		#error Intrinsics headers are not included: unknown compiler
+	#endif
+
+// Transposes four single-precision 3D vectors stored as x0 y0 z0 x1 | y1 z1 x2 y2 | z2 x3 y3 z3
+inline static void transpose3_ps(__m128 x0y0z0x1, __m128 y1z1x2y2, __m128 z2x3y3z3, __m128& x, __m128& y, __m128& z) {
+	const __m128 x2_y1_x3_z2 = _mm_shuffle_ps(y1z1x2y2, z2x3y3z3, _MM_SHUFFLE(0, 1, 0, 2));
+	x = _mm_shuffle_ps(x0y0z0x1, x2_y1_x3_z2, _MM_SHUFFLE(2, 0, 3, 0));
+	const __m128 y0_y0_y1_y1 = _mm_shuffle_ps(x0y0z0x1, y1z1x2y2, _MM_SHUFFLE(0, 0, 1, 1));
+	const __m128 y2_y2_y3_y3 = _mm_shuffle_ps(y1z1x2y2, z2x3y3z3, _MM_SHUFFLE(2, 2, 3, 3));
+	y = _mm_shuffle_ps(y0_y0_y1_y1, y2_y2_y3_y3, _MM_SHUFFLE(2, 0, 2, 0));
+	const __m128 z0_z0_z1_z1 = _mm_shuffle_ps(x0y0z0x1, y1z1x2y2, _MM_SHUFFLE(1, 1, 2, 2));
+	const __m128 z2_z2_z3_z3 = _mm_shuffle_ps(z2x3y3z3, z2x3y3z3, _MM_SHUFFLE(3, 3, 0, 0));
+	z = _mm_shuffle_ps(z0_z0_z1_z1, z2_z2_z3_z3, _MM_SHUFFLE(2, 0, 2, 0));
+}
+#endif
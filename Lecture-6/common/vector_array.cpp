@@ -0,0 +1,50 @@
+/******************************************************************************\
+ *                                                                            *
+ * Copyright (c) 2012 Marat Dukhan                                            *
+ *                                                                            *
+ * This software is provided 'as-is', without any express or implied          *
+ * warranty. In no event will the authors be held liable for any damages      *
+ * arising from the use of this software.                                     *
+ *                                                                            *
+ * Permission is granted to anyone to use this software for any purpose,      *
+ * including commercial applications, and to alter it and redistribute it     *
+ * freely, subject to the following restrictions:                             *
+ *                                                                            *
+ * 1. The origin of this software must not be misrepresented; you must not    *
+ * claim that you wrote the original software. If you use this software       *
+ * in a product, an acknowledgment in the product documentation would be      *
+ * appreciated but is not required.                                           *
+ *                                                                            *
+ * 2. Altered source versions must be plainly marked as such, and must not be *
+ * misrepresented as being the original software.                             *
+ *                                                                            *
+ * 3. This notice may not be removed or altered from any source               *
+ * distribution.                                                              *
+ *                                                                            *
+\******************************************************************************/
+
+#include <vector_array.hpp>
+#include <stdlib.h>
+#include <malloc.h>
+
+size_t vector_array_page_offset(size_t arrayIndex) {
+	// Spread consecutive arrays by a quarter of a page, and shift each group of four arrays by a cache line
+	return (arrayIndex * 1024 + (arrayIndex / 4) * 64) % 4096;
+}
+
+double* allocate_vector_array(size_t length, size_t arrayIndex) {
+	// The first page is reserved for the pointer to the allocated block
+	char* block = (char*)memalign(4096, length * sizeof(double) + 2 * 4096);
+	if (block == NULL) {
+		return NULL;
+	}
+	double* array = (double*)(block + 4096 + vector_array_page_offset(arrayIndex));
+	((char**)array)[-1] = block;
+	return array;
+}
+
+void free_vector_array(double* array) {
+	if (array != NULL) {
+		free(((char**)array)[-1]);
+	}
+}
@@ -0,0 +1,37 @@
+/******************************************************************************\
+ *                                                                            *
+ * Copyright (c) 2012 Marat Dukhan                                            *
+ *                                                                            *
+ * This software is provided 'as-is', without any express or implied          *
+ * warranty. In no event will the authors be held liable for any damages      *
+ * arising from the use of this software.                                     *
+ *                                                                            *
+ * Permission is granted to anyone to use this software for any purpose,      *
+ * including commercial applications, and to alter it and redistribute it     *
+ * freely, subject to the following restrictions:                             *
+ *                                                                            *
+ * 1. The origin of this software must not be misrepresented; you must not    *
+ * claim that you wrote the original software. If you use this software       *
+ * in a product, an acknowledgment in the product documentation would be      *
+ * appreciated but is not required.                                           *
+ *                                                                            *
+ * 2. Altered source versions must be plainly marked as such, and must not be *
+ * misrepresented as being the original software.                             *
+ *                                                                            *
+ * 3. This notice may not be removed or altered from any source               *
+ * distribution.                                                              *
+ *                                                                            *
+\******************************************************************************/
+
+#pragma once
+
+#include <stddef.h>
+
+// Allocates an array of doubles which starts vector_array_page_offset(arrayIndex) bytes after a 4 KiB page boundary.
+// The offsets are multiples of 64, so every array is aligned on a cache line, and arrays with indexes 0..63 get distinct
+// offsets: elements with the same index in two of these arrays are never a multiple of 4096 bytes apart. Elements with
+// different indexes still can be, and for indexes 64 and above the offsets repeat.
+extern "C" double* allocate_vector_array(size_t length, size_t arrayIndex);
+extern "C" void free_vector_array(double* array);
+// Returns the offset within a 4 KiB page of the array with the specified index allocated by allocate_vector_array
+extern "C" size_t vector_array_page_offset(size_t arrayIndex);
@@ -0,0 +1,341 @@
+/******************************************************************************\
+ *                                                                            *
+ * Copyright (c) 2012 Marat Dukhan                                            *
+ *                                                                            *
+ * This software is provided 'as-is', without any express or implied          *
+ * warranty. In no event will the authors be held liable for any damages      *
+ * arising from the use of this software.                                     *
+ *                                                                            *
+ * Permission is granted to anyone to use this software for any purpose,      *
+ * including commercial applications, and to alter it and redistribute it     *
+ * freely, subject to the following restrictions:                             *
+ *                                                                            *
+ * 1. The origin of this software must not be misrepresented; you must not    *
+ * claim that you wrote the original software. If you use this software       *
+ * in a product, an acknowledgment in the product documentation would be      *
+ * appreciated but is not required.                                           *
+ *                                                                            *
+ * 2. Altered source versions must be plainly marked as such, and must not be *
+ * misrepresented as being the original software.                             *
+ *                                                                            *
+ * 3. This notice may not be removed or altered from any source               *
+ * distribution.                                                              *
+ *                                                                            *
+\******************************************************************************/
+
+#include <async.hpp>
+#include <new>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <chrono>
+#include <vector>
+#include <condition_variable>
+
+// Maximum number of jobs a worker takes from the queue at once
+static const size_t batch_capacity = 64;
+// A worker stops taking jobs from the queue after it accumulates this many elements
+static const size_t batch_elements_limit = 65536;
+// Number of yields before an idle worker goes to sleep
+static const size_t idle_spins_limit = 256;
+// Number of yields before a thread which waits for a future blocks
+static const size_t wait_spins_limit = 256;
+
+enum kernel_operation {
+	kernel_operation_vector_add,
+	kernel_operation_vector_max
+};
+
+struct kernel_future {
+	std::atomic<kernel_future*> next; // Link to the next job in the queue
+	kernel_queue* queue;
+	kernel_operation operation;
+	vector_add_function vector_add;
+	vector_max_function vector_max;
+	const double* xPointer;
+	const double* yPointer;
+	double* outputPointer;
+	size_t length;
+	kernel_callback callback;
+	void* context;
+	std::atomic<bool> ready;
+	std::atomic<bool> waiting; // Set when the caller blocks in kernel_future_wait
+	std::atomic<unsigned> references; // One reference is held by the caller and one by the queue
+};
+
+struct kernel_queue {
+	// Intrusive lock-free multi-producer single-consumer queue (D. Vyukov).
+	// Producers only touch head, and the consumer side is serialized through the draining flag.
+	std::atomic<kernel_future*> head;
+	kernel_future* tail;
+	kernel_future stub;
+	std::atomic<bool> draining;
+
+	std::atomic<size_t> pendingCount;
+	std::atomic<size_t> sleepingCount;
+	std::atomic<bool> stopping;
+	std::mutex sleepMutex;
+	std::condition_variable wakeup;
+	std::vector<std::thread> workers;
+
+	// Threads blocked in kernel_future_wait sleep on completed until the worker marks their job ready
+	std::mutex completionMutex;
+	std::condition_variable completed;
+};
+
+static void release_future(kernel_future* future) {
+	if (future->references.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+		delete future;
+	}
+}
+
+static void queue_push(kernel_queue* queue, kernel_future* job) {
+	job->next.store(NULL, std::memory_order_relaxed);
+	kernel_future* previous = queue->head.exchange(job, std::memory_order_acq_rel);
+	previous->next.store(job, std::memory_order_release);
+}
+
+// Must only be called by the thread which set the draining flag
+static kernel_future* queue_pop(kernel_queue* queue) {
+	kernel_future* tail = queue->tail;
+	kernel_future* next = tail->next.load(std::memory_order_acquire);
+	if (tail == &queue->stub) {
+		if (next == NULL) {
+			return NULL;
+		}
+		// Skip the stub node
+		queue->tail = next;
+		tail = next;
+		next = next->next.load(std::memory_order_acquire);
+	}
+	if (next != NULL) {
+		queue->tail = next;
+		return tail;
+	}
+	if (tail != queue->head.load(std::memory_order_acquire)) {
+		// A producer exchanged the head, but did not link the job yet. Try again later.
+		return NULL;
+	}
+	// tail is the last job in the queue: push the stub behind it so that tail can be unlinked
+	queue_push(queue, &queue->stub);
+	next = tail->next.load(std::memory_order_acquire);
+	if (next != NULL) {
+		queue->tail = next;
+		return tail;
+	}
+	return NULL;
+}
+
+static size_t drain_batch(kernel_queue* queue, kernel_future** batch) {
+	if (queue->draining.exchange(true, std::memory_order_acquire)) {
+		// Another worker is draining the queue
+		return 0;
+	}
+	size_t batchSize = 0;
+	size_t batchElements = 0;
+	while ((batchSize < batch_capacity) && (batchElements < batch_elements_limit)) {
+		kernel_future* job = queue_pop(queue);
+		if (job == NULL) {
+			break;
+		}
+		batch[batchSize++] = job;
+		batchElements += job->length;
+	}
+	queue->draining.store(false, std::memory_order_release);
+	if (batchSize != 0) {
+		queue->pendingCount.fetch_sub(batchSize);
+	}
+	return batchSize;
+}
+
+// Checks if job continues the same arrays right after the first job of a merged group of the specified length
+static bool is_adjacent(const kernel_future* job, const kernel_future* first, size_t length) {
+	return (job->operation == kernel_operation_vector_add) &&
+		(job->vector_add == first->vector_add) &&
+		(job->xPointer == first->xPointer + length) &&
+		(job->yPointer == first->yPointer + length) &&
+		(job->outputPointer == first->outputPointer + length);
+}
+
+static void complete_job(kernel_future* job) {
+	if (job->callback != NULL) {
+		job->callback(job->context);
+	}
+	// Sequentially consistent accesses to ready and waiting: either the waiter sees the job ready before it blocks,
+	// or the worker sees the waiter and wakes it up under the mutex
+	job->ready.store(true);
+	if (job->waiting.load()) {
+		kernel_queue* queue = job->queue;
+		std::lock_guard<std::mutex> lock(queue->completionMutex);
+		queue->completed.notify_all();
+	}
+	release_future(job);
+}
+
+static void execute_batch(kernel_future** batch, size_t batchSize) {
+	for (size_t first = 0; first < batchSize; ) {
+		kernel_future* job = batch[first];
+		size_t last = first + 1;
+		switch (job->operation) {
+			case kernel_operation_vector_add:
+			{
+				// Merge the following jobs on contiguous parts of the same arrays into one call
+				size_t length = job->length;
+				for (; (last < batchSize) && is_adjacent(batch[last], job, length); last += 1) {
+					length += batch[last]->length;
+				}
+				job->vector_add(job->xPointer, job->yPointer, job->outputPointer, length);
+				break;
+			}
+			case kernel_operation_vector_max:
+				job->vector_max(job->xPointer, job->outputPointer, job->length);
+				break;
+		}
+		for (; first != last; first += 1) {
+			complete_job(batch[first]);
+		}
+	}
+}
+
+static void worker_thread(kernel_queue* queue) {
+	kernel_future* batch[batch_capacity];
+	size_t idleSpins = 0;
+	for (;;) {
+		const size_t batchSize = drain_batch(queue, batch);
+		if (batchSize != 0) {
+			execute_batch(batch, batchSize);
+			idleSpins = 0;
+			continue;
+		}
+		if (queue->stopping.load(std::memory_order_acquire) && (queue->pendingCount.load() == 0)) {
+			return;
+		}
+		if (++idleSpins < idle_spins_limit) {
+			std::this_thread::yield();
+			continue;
+		}
+		// Sleep until a producer submits a job. The timeout guards against a producer which has not linked its job yet.
+		std::unique_lock<std::mutex> lock(queue->sleepMutex);
+		queue->sleepingCount.fetch_add(1);
+		if ((queue->pendingCount.load() == 0) && !queue->stopping.load()) {
+			queue->wakeup.wait_for(lock, std::chrono::milliseconds(1));
+		}
+		queue->sleepingCount.fetch_sub(1);
+		idleSpins = 0;
+	}
+}
+
+static kernel_future* submit_job(kernel_queue* queue, kernel_future* job) {
+	job->queue = queue;
+	job->ready.store(false, std::memory_order_relaxed);
+	job->waiting.store(false, std::memory_order_relaxed);
+	job->references.store(2, std::memory_order_relaxed);
+	queue_push(queue, job);
+	queue->pendingCount.fetch_add(1);
+	if (queue->sleepingCount.load() != 0) {
+		std::lock_guard<std::mutex> lock(queue->sleepMutex);
+		queue->wakeup.notify_one();
+	}
+	return job;
+}
+
+kernel_queue* kernel_queue_create(size_t workersCount) {
+	if (workersCount == 0) {
+		workersCount = std::thread::hardware_concurrency();
+		if (workersCount == 0) {
+			workersCount = 1;
+		}
+	}
+	kernel_queue* queue = new (std::nothrow) kernel_queue;
+	if (queue == NULL) {
+		return NULL;
+	}
+	queue->stub.next.store(NULL, std::memory_order_relaxed);
+	queue->head.store(&queue->stub, std::memory_order_relaxed);
+	queue->tail = &queue->stub;
+	queue->draining.store(false, std::memory_order_relaxed);
+	queue->pendingCount.store(0, std::memory_order_relaxed);
+	queue->sleepingCount.store(0, std::memory_order_relaxed);
+	queue->stopping.store(false, std::memory_order_relaxed);
+	for (size_t workerNumber = 0; workerNumber < workersCount; workerNumber += 1) {
+		queue->workers.push_back(std::thread(worker_thread, queue));
+	}
+	return queue;
+}
+
+void kernel_queue_destroy(kernel_queue* queue) {
+	if (queue == NULL) {
+		return;
+	}
+	{
+		std::lock_guard<std::mutex> lock(queue->sleepMutex);
+		queue->stopping.store(true, std::memory_order_release);
+		queue->wakeup.notify_all();
+	}
+	for (size_t workerNumber = 0; workerNumber < queue->workers.size(); workerNumber += 1) {
+		queue->workers[workerNumber].join();
+	}
+	delete queue;
+}
+
+kernel_future* kernel_queue_submit_vector_add(kernel_queue* queue, vector_add_function vector_add, const double* xPointer, const double* yPointer, double* sumPointer, size_t length, kernel_callback callback, void* context) {
+	kernel_future* job = new (std::nothrow) kernel_future;
+	if (job == NULL) {
+		return NULL;
+	}
+	job->operation = kernel_operation_vector_add;
+	job->vector_add = vector_add;
+	job->vector_max = NULL;
+	job->xPointer = xPointer;
+	job->yPointer = yPointer;
+	job->outputPointer = sumPointer;
+	job->length = length;
+	job->callback = callback;
+	job->context = context;
+	return submit_job(queue, job);
+}
+
+kernel_future* kernel_queue_submit_vector_max(kernel_queue* queue, vector_max_function vector_max, const double* arrayPointer, double* maxPointer, size_t length, kernel_callback callback, void* context) {
+	kernel_future* job = new (std::nothrow) kernel_future;
+	if (job == NULL) {
+		return NULL;
+	}
+	job->operation = kernel_operation_vector_max;
+	job->vector_add = NULL;
+	job->vector_max = vector_max;
+	job->xPointer = arrayPointer;
+	job->yPointer = NULL;
+	job->outputPointer = maxPointer;
+	job->length = length;
+	job->callback = callback;
+	job->context = context;
+	return submit_job(queue, job);
+}
+
+bool kernel_future_is_ready(const kernel_future* future) {
+	return future->ready.load(std::memory_order_acquire);
+}
+
+void kernel_future_wait(kernel_future* future) {
+	// Short jobs complete within a few yields; longer ones must not keep a core busy
+	for (size_t spins = 0; spins < wait_spins_limit; spins += 1) {
+		if (future->ready.load(std::memory_order_acquire)) {
+			release_future(future);
+			return;
+		}
+		std::this_thread::yield();
+	}
+	kernel_queue* queue = future->queue;
+	{
+		std::unique_lock<std::mutex> lock(queue->completionMutex);
+		future->waiting.store(true);
+		while (!future->ready.load()) {
+			queue->completed.wait(lock);
+		}
+	}
+	release_future(future);
+}
+
+void kernel_future_release(kernel_future* future) {
+	release_future(future);
+}
@@ -0,0 +1,55 @@
+/******************************************************************************\
+ *                                                                            *
+ * Copyright (c) 2012 Marat Dukhan                                            *
+ *                                                                            *
+ * This software is provided 'as-is', without any express or implied          *
+ * warranty. In no event will the authors be held liable for any damages      *
+ * arising from the use of this software.                                     *
+ *                                                                            *
+ * Permission is granted to anyone to use this software for any purpose,      *
+ * including commercial applications, and to alter it and redistribute it     *
+ * freely, subject to the following restrictions:                             *
+ *                                                                            *
+ * 1. The origin of this software must not be misrepresented; you must not    *
+ * claim that you wrote the original software. If you use this software       *
+ * in a product, an acknowledgment in the product documentation would be      *
+ * appreciated but is not required.                                           *
+ *                                                                            *
+ * 2. Altered source versions must be plainly marked as such, and must not be *
+ * misrepresented as being the original software.                             *
+ *                                                                            *
+ * 3. This notice may not be removed or altered from any source               *
+ * distribution.                                                              *
+ *                                                                            *
+\******************************************************************************/
+
+#pragma once
+
+#include <compute.hpp>
+
+// Asynchronous execution of vector_add and vector_max kernels.
+// Any number of threads may submit jobs concurrently: jobs are pushed into a lock-free multi-producer queue,
+// and the worker threads of the queue drain it in batches. Jobs on contiguous parts of the same arrays
+// which are adjacent in the queue are merged and executed with a single kernel call.
+
+struct kernel_queue;
+struct kernel_future;
+
+typedef void (*kernel_callback)(void* context);
+
+extern "C" kernel_queue* kernel_queue_create(size_t workersCount);
+// Waits for completion of all submitted jobs and stops the worker threads
+extern "C" void kernel_queue_destroy(kernel_queue* queue);
+
+// Submit functions return a future for the job. The caller must eventually pass it to kernel_future_wait or kernel_future_release.
+// If callback is not NULL, it is called on the worker thread after the job completes.
+extern "C" kernel_future* kernel_queue_submit_vector_add(kernel_queue* queue, vector_add_function vector_add, const double* xPointer, const double* yPointer, double* sumPointer, size_t length, kernel_callback callback, void* context);
+extern "C" kernel_future* kernel_queue_submit_vector_max(kernel_queue* queue, vector_max_function vector_max, const double* arrayPointer, double* maxPointer, size_t length, kernel_callback callback, void* context);
+
+// Returns true if the job completed. Does not block.
+extern "C" bool kernel_future_is_ready(const kernel_future* future);
+// Blocks until the job completes and releases the future. The caller yields for a short time, then sleeps until the
+// worker which completes the job wakes it up.
+extern "C" void kernel_future_wait(kernel_future* future);
+// Releases the future without waiting: the job still runs, and its callback (if any) is still called
+extern "C" void kernel_future_release(kernel_future* future);
@@ -0,0 +1,230 @@
+/******************************************************************************\
+ *                                                                            *
+ * Copyright (c) 2012 Marat Dukhan                                            *
+ *                                                                            *
+ * This software is provided 'as-is', without any express or implied          *
+ * warranty. In no event will the authors be held liable for any damages      *
+ * arising from the use of this software.                                     *
+ *                                                                            *
+ * Permission is granted to anyone to use this software for any purpose,      *
+ * including commercial applications, and to alter it and redistribute it     *
+ * freely, subject to the following restrictions:                             *
+ *                                                                            *
+ * 1. The origin of this software must not be misrepresented; you must not    *
+ * claim that you wrote the original software. If you use this software       *
+ * in a product, an acknowledgment in the product documentation would be      *
+ * appreciated but is not required.                                           *
+ *                                                                            *
+ * 2. Altered source versions must be plainly marked as such, and must not be *
+ * misrepresented as being the original software.                             *
+ *                                                                            *
+ * 3. This notice may not be removed or altered from any source               *
+ * distribution.                                                              *
+ *                                                                            *
+\******************************************************************************/
+
+#include <baseline.hpp>
+#include <string.h>
+#include <limits>
+#include <algorithm>
+#include <functional>
+#if defined(CSE6230_UNSEQ_SUPPORTED) || defined(CSE6230_PAR_UNSEQ_SUPPORTED)
+	#include <execution>
+	#include <numeric>
+#endif
+
+inline static double minus_inf() {
+	return -std::numeric_limits<double>::infinity();
+}
+
+// Skips NaN arguments as fmax in vector_max_naive does, but compiles to compare and select, which vectorize
+inline static double scalar_max(double a, double b) {
+	return (a > b || b != b) ? a : b;
+}
+
+// Loops annotated with #pragma omp simd
+
+void vector_add_omp_simd(const double *CSE6230_RESTRICT xPointer, const double *CSE6230_RESTRICT yPointer, double *CSE6230_RESTRICT sumPointer, size_t length) {
+	#pragma omp simd
+	for (size_t i = 0; i < length; i++) {
+		sumPointer[i] = xPointer[i] + yPointer[i];
+	}
+}
+
+void vector_accumulate_omp_simd(const double *CSE6230_RESTRICT xPointer, double *CSE6230_RESTRICT yPointer, size_t length) {
+	#pragma omp simd
+	for (size_t i = 0; i < length; i++) {
+		yPointer[i] += xPointer[i];
+	}
+}
+
+void vector_axpy_omp_simd(double a, const double *CSE6230_RESTRICT xPointer, double *CSE6230_RESTRICT yPointer, size_t length) {
+	#pragma omp simd
+	for (size_t i = 0; i < length; i++) {
+		yPointer[i] += a * xPointer[i];
+	}
+}
+
+void vector_max_omp_simd(const double *CSE6230_RESTRICT arrayPointer, double *CSE6230_RESTRICT maxPointer, size_t length) {
+	double max = minus_inf();
+	#pragma omp simd reduction(max:max)
+	for (size_t i = 0; i < length; i++) {
+		max = scalar_max(max, arrayPointer[i]);
+	}
+	*maxPointer = max;
+}
+
+// Standard library algorithms with an execution policy
+
+#if defined(CSE6230_UNSEQ_SUPPORTED) || defined(CSE6230_PAR_UNSEQ_SUPPORTED)
+template <typename ExecutionPolicy>
+inline static void std_vector_add(ExecutionPolicy&& policy, const double* xPointer, const double* yPointer, double* sumPointer, size_t length) {
+	std::transform(policy, xPointer, xPointer + length, yPointer, sumPointer, std::plus<double>());
+}
+
+template <typename ExecutionPolicy>
+inline static void std_vector_accumulate(ExecutionPolicy&& policy, const double* xPointer, double* yPointer, size_t length) {
+	std::transform(policy, xPointer, xPointer + length, yPointer, yPointer, std::plus<double>());
+}
+
+template <typename ExecutionPolicy>
+inline static void std_vector_axpy(ExecutionPolicy&& policy, double a, const double* xPointer, double* yPointer, size_t length) {
+	std::transform(policy, xPointer, xPointer + length, yPointer, yPointer,
+		[a](double x, double y) { return y + a * x; });
+}
+
+template <typename ExecutionPolicy>
+inline static void std_vector_max(ExecutionPolicy&& policy, const double* arrayPointer, double* maxPointer, size_t length) {
+	*maxPointer = std::reduce(policy, arrayPointer, arrayPointer + length, minus_inf(),
+		[](double a, double b) { return scalar_max(a, b); });
+}
+#endif
+
+#ifdef CSE6230_UNSEQ_SUPPORTED
+void vector_add_unseq(const double *CSE6230_RESTRICT xPointer, const double *CSE6230_RESTRICT yPointer, double *CSE6230_RESTRICT sumPointer, size_t length) {
+	std_vector_add(std::execution::unseq, xPointer, yPointer, sumPointer, length);
+}
+
+void vector_accumulate_unseq(const double *CSE6230_RESTRICT xPointer, double *CSE6230_RESTRICT yPointer, size_t length) {
+	std_vector_accumulate(std::execution::unseq, xPointer, yPointer, length);
+}
+
+void vector_axpy_unseq(double a, const double *CSE6230_RESTRICT xPointer, double *CSE6230_RESTRICT yPointer, size_t length) {
+	std_vector_axpy(std::execution::unseq, a, xPointer, yPointer, length);
+}
+
+void vector_max_unseq(const double *CSE6230_RESTRICT arrayPointer, double *CSE6230_RESTRICT maxPointer, size_t length) {
+	std_vector_max(std::execution::unseq, arrayPointer, maxPointer, length);
+}
+#endif
+
+#ifdef CSE6230_PAR_UNSEQ_SUPPORTED
+void vector_add_par_unseq(const double *CSE6230_RESTRICT xPointer, const double *CSE6230_RESTRICT yPointer, double *CSE6230_RESTRICT sumPointer, size_t length) {
+	std_vector_add(std::execution::par_unseq, xPointer, yPointer, sumPointer, length);
+}
+
+void vector_accumulate_par_unseq(const double *CSE6230_RESTRICT xPointer, double *CSE6230_RESTRICT yPointer, size_t length) {
+	std_vector_accumulate(std::execution::par_unseq, xPointer, yPointer, length);
+}
+
+void vector_axpy_par_unseq(double a, const double *CSE6230_RESTRICT xPointer, double *CSE6230_RESTRICT yPointer, size_t length) {
+	std_vector_axpy(std::execution::par_unseq, a, xPointer, yPointer, length);
+}
+
+void vector_max_par_unseq(const double *CSE6230_RESTRICT arrayPointer, double *CSE6230_RESTRICT maxPointer, size_t length) {
+	std_vector_max(std::execution::par_unseq, arrayPointer, maxPointer, length);
+}
+#endif
+
+// Generic vector types. The compiler lowers them to the widest instruction set enabled by the compiler flags.
+
+#ifdef CSE6230_VECTOR_EXTENSIONS_SUPPORTED
+typedef double double4 __attribute__((vector_size(32)));
+
+// memcpy compiles into an unaligned vector load/store.
+// Vectors are passed by reference: passing 32-byte vectors by value has a different ABI with and without AVX.
+inline static void load_double4(double4& v, const double* pointer) {
+	memcpy(&v, pointer, sizeof(v));
+}
+
+inline static void store_double4(double* pointer, const double4& v) {
+	memcpy(pointer, &v, sizeof(v));
+}
+
+void vector_add_vector_extensions(const double *CSE6230_RESTRICT xPointer, const double *CSE6230_RESTRICT yPointer, double *CSE6230_RESTRICT sumPointer, size_t length) {
+	// Process arrays by four elements at an iteration
+	for (; length >= 4; length -= 4) {
+		double4 x, y;
+		load_double4(x, xPointer);
+		load_double4(y, yPointer);
+		const double4 sum = x + y;
+		store_double4(sumPointer, sum);
+
+		xPointer += 4;
+		yPointer += 4;
+		sumPointer += 4;
+	}
+	// Process remaining elements (if any)
+	for (; length != 0; length -= 1) {
+		*sumPointer++ = *xPointer++ + *yPointer++;
+	}
+}
+
+void vector_accumulate_vector_extensions(const double *CSE6230_RESTRICT xPointer, double *CSE6230_RESTRICT yPointer, size_t length) {
+	// Process arrays by four elements at an iteration
+	for (; length >= 4; length -= 4) {
+		double4 x, y;
+		load_double4(x, xPointer);
+		load_double4(y, yPointer);
+		const double4 sum = y + x;
+		store_double4(yPointer, sum);
+
+		xPointer += 4;
+		yPointer += 4;
+	}
+	// Process remaining elements (if any)
+	for (; length != 0; length -= 1) {
+		*yPointer++ += *xPointer++;
+	}
+}
+
+void vector_axpy_vector_extensions(double a, const double *CSE6230_RESTRICT xPointer, double *CSE6230_RESTRICT yPointer, size_t length) {
+	const double4 aX4 = { a, a, a, a };
+	// Process arrays by four elements at an iteration
+	for (; length >= 4; length -= 4) {
+		double4 x, y;
+		load_double4(x, xPointer);
+		load_double4(y, yPointer);
+		const double4 axpy = y + aX4 * x;
+		store_double4(yPointer, axpy);
+
+		xPointer += 4;
+		yPointer += 4;
+	}
+	// Process remaining elements (if any)
+	for (; length != 0; length -= 1) {
+		*yPointer++ += a * *xPointer++;
+	}
+}
+
+void vector_max_vector_extensions(const double *CSE6230_RESTRICT arrayPointer, double *CSE6230_RESTRICT maxPointer, size_t length) {
+	double max = minus_inf();
+	if (length >= 4) {
+		double4 maxX4 = { max, max, max, max };
+		// Process array by four elements at an iteration. The comparison is false for NaN elements, so they are skipped.
+		for (; length >= 4; length -= 4) {
+			double4 elements;
+			load_double4(elements, arrayPointer);
+			maxX4 = elements > maxX4 ? elements : maxX4;
+
+			arrayPointer += 4;
+		}
+		max = scalar_max(scalar_max(maxX4[0], maxX4[1]), scalar_max(maxX4[2], maxX4[3]));
+	}
+	// Process remaining elements (if any)
+	for (; length != 0; length -= 1) {
+		max = scalar_max(max, *arrayPointer++);
+	}
+	*maxPointer = max;
+}
+#endif
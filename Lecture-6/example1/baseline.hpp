@@ -0,0 +1,93 @@
+/******************************************************************************\
+ *                                                                            *
+ * Copyright (c) 2012 Marat Dukhan                                            *
+ *                                                                            *
+ * This software is provided 'as-is', without any express or implied          *
+ * warranty. In no event will the authors be held liable for any damages      *
+ * arising from the use of this software.                                     *
+ *                                                                            *
+ * Permission is granted to anyone to use this software for any purpose,      *
+ * including commercial applications, and to alter it and redistribute it     *
+ * freely, subject to the following restrictions:                             *
+ *                                                                            *
+ * 1. The origin of this software must not be misrepresented; you must not    *
+ * claim that you wrote the original software. If you use this software       *
+ * in a product, an acknowledgment in the product documentation would be      *
+ * appreciated but is not required.                                           *
+ *                                                                            *
+ * 2. Altered source versions must be plainly marked as such, and must not be *
+ * misrepresented as being the original software.                             *
+ *                                                                            *
+ * 3. This notice may not be removed or altered from any source               *
+ * distribution.                                                              *
+ *                                                                            *
+\******************************************************************************/
+
+#pragma once
+
+#include <compute.hpp>
+
+// Baseline versions of the kernels which leave vectorization to the compiler or the standard library:
+//   *_omp_simd: plain loops annotated with #pragma omp simd (compile with -fopenmp-simd)
+//   *_unseq, *_par_unseq: std::transform and std::reduce with std::execution::unseq and std::execution::par_unseq
+//   *_vector_extensions: GCC/Clang generic vector types of 32 bytes
+
+#if defined(__GNUC__)
+	#define CSE6230_VECTOR_EXTENSIONS_SUPPORTED
+#endif
+
+#if defined(__has_include)
+	#if __has_include(<version>)
+		#include <version>
+	#endif
+#endif
+#if defined(__cpp_lib_execution)
+	#define CSE6230_PAR_UNSEQ_SUPPORTED
+	#if __cpp_lib_execution >= 201902L
+		#define CSE6230_UNSEQ_SUPPORTED
+	#endif
+#endif
+
+extern "C" void vector_add_omp_simd(const double *CSE6230_RESTRICT xPointer, const double *CSE6230_RESTRICT yPointer, double *CSE6230_RESTRICT sumPointer, size_t length);
+#ifdef CSE6230_UNSEQ_SUPPORTED
+extern "C" void vector_add_unseq(const double *CSE6230_RESTRICT xPointer, const double *CSE6230_RESTRICT yPointer, double *CSE6230_RESTRICT sumPointer, size_t length);
+#endif
+#ifdef CSE6230_PAR_UNSEQ_SUPPORTED
+extern "C" void vector_add_par_unseq(const double *CSE6230_RESTRICT xPointer, const double *CSE6230_RESTRICT yPointer, double *CSE6230_RESTRICT sumPointer, size_t length);
+#endif
+#ifdef CSE6230_VECTOR_EXTENSIONS_SUPPORTED
+extern "C" void vector_add_vector_extensions(const double *CSE6230_RESTRICT xPointer, const double *CSE6230_RESTRICT yPointer, double *CSE6230_RESTRICT sumPointer, size_t length);
+#endif
+
+extern "C" void vector_accumulate_omp_simd(const double *CSE6230_RESTRICT xPointer, double *CSE6230_RESTRICT yPointer, size_t length);
+#ifdef CSE6230_UNSEQ_SUPPORTED
+extern "C" void vector_accumulate_unseq(const double *CSE6230_RESTRICT xPointer, double *CSE6230_RESTRICT yPointer, size_t length);
+#endif
+#ifdef CSE6230_PAR_UNSEQ_SUPPORTED
+extern "C" void vector_accumulate_par_unseq(const double *CSE6230_RESTRICT xPointer, double *CSE6230_RESTRICT yPointer, size_t length);
+#endif
+#ifdef CSE6230_VECTOR_EXTENSIONS_SUPPORTED
+extern "C" void vector_accumulate_vector_extensions(const double *CSE6230_RESTRICT xPointer, double *CSE6230_RESTRICT yPointer, size_t length);
+#endif
+
+extern "C" void vector_axpy_omp_simd(double a, const double *CSE6230_RESTRICT xPointer, double *CSE6230_RESTRICT yPointer, size_t length);
+#ifdef CSE6230_UNSEQ_SUPPORTED
+extern "C" void vector_axpy_unseq(double a, const double *CSE6230_RESTRICT xPointer, double *CSE6230_RESTRICT yPointer, size_t length);
+#endif
+#ifdef CSE6230_PAR_UNSEQ_SUPPORTED
+extern "C" void vector_axpy_par_unseq(double a, const double *CSE6230_RESTRICT xPointer, double *CSE6230_RESTRICT yPointer, size_t length);
+#endif
+#ifdef CSE6230_VECTOR_EXTENSIONS_SUPPORTED
+extern "C" void vector_axpy_vector_extensions(double a, const double *CSE6230_RESTRICT xPointer, double *CSE6230_RESTRICT yPointer, size_t length);
+#endif
+
+extern "C" void vector_max_omp_simd(const double *CSE6230_RESTRICT arrayPointer, double *CSE6230_RESTRICT maxPointer, size_t length);
+#ifdef CSE6230_UNSEQ_SUPPORTED
+extern "C" void vector_max_unseq(const double *CSE6230_RESTRICT arrayPointer, double *CSE6230_RESTRICT maxPointer, size_t length);
+#endif
+#ifdef CSE6230_PAR_UNSEQ_SUPPORTED
+extern "C" void vector_max_par_unseq(const double *CSE6230_RESTRICT arrayPointer, double *CSE6230_RESTRICT maxPointer, size_t length);
+#endif
+#ifdef CSE6230_VECTOR_EXTENSIONS_SUPPORTED
+extern "C" void vector_max_vector_extensions(const double *CSE6230_RESTRICT arrayPointer, double *CSE6230_RESTRICT maxPointer, size_t length);
+#endif
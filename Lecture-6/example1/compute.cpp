@@ -24,6 +24,7 @@
 \******************************************************************************/
 
 #include <compute.hpp>
+#include <formats.hpp>
 #include <math.h>
 #if defined(CSE6230_SSE2_INTRINSICS_SUPPORTED) || defined(CSE6230_AVX_INTRINSICS_SUPPORTED)
 	#if defined(__GNUC__)
@@ -331,6 +332,544 @@ void vector_add_avx_store_aligned(const double *CSE6230_RESTRICT xPointer, const
 }
 #endif
 
+void vector_accumulate_naive(const double *CSE6230_RESTRICT xPointer, double *CSE6230_RESTRICT yPointer, size_t length) {
+	for (; length != 0; length -= 1) {
+		const double x = *xPointer; // Load x
+		const double y = *yPointer; // Load y
+		const double sum = x + y; // Compute sum
+		*yPointer = sum; // Store sum over y
+
+		// Advance pointers to the next elements
+		xPointer += 1;
+		yPointer += 1;
+	}
+}
+
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+void vector_accumulate_sse2(const double *CSE6230_RESTRICT xPointer, double *CSE6230_RESTRICT yPointer, size_t length) {
+	// Process arrays by two elements at an iteration
+	for (; length >= 2; length -= 2) {
+		const __m128d x = _mm_loadu_pd(xPointer); // Load two x elements
+		const __m128d y = _mm_loadu_pd(yPointer); // Load two y elements
+		const __m128d sum = _mm_add_pd(x, y); // Compute two sum elements
+		_mm_storeu_pd(yPointer, sum); // Store two elements over y
+		
+		// Advance pointers to the next two elements
+		xPointer += 2;
+		yPointer += 2;
+	}
+	// Process remaining elements (if any)
+	for (; length != 0; length -= 1) {
+		const double x = *xPointer; // Load x
+		const double y = *yPointer; // Load y
+		const double sum = x + y; // Compute sum
+		*yPointer = sum; // Store sum over y
+
+		// Advance pointers to the next elements
+		xPointer += 1;
+		yPointer += 1;
+	}
+}
+
+void vector_accumulate_sse2_aligned(const double *CSE6230_RESTRICT xPointer, double *CSE6230_RESTRICT yPointer, size_t length) {
+	// Process arrays by two elements at an iteration
+	for (; length >= 2; length -= 2) {
+		const __m128d x = _mm_load_pd(xPointer); // Aligned (!) load two x elements
+		const __m128d y = _mm_load_pd(yPointer); // Aligned (!) load two y elements
+		const __m128d sum = _mm_add_pd(x, y); // Compute two sum elements
+		_mm_store_pd(yPointer, sum); // Aligned (!) store two elements over y
+		
+		// Advance pointers to the next two elements
+		xPointer += 2;
+		yPointer += 2;
+	}
+	// Process remaining elements (if any)
+	for (; length != 0; length -= 1) {
+		const double x = *xPointer; // Load x
+		const double y = *yPointer; // Load y
+		const double sum = x + y; // Compute sum
+		*yPointer = sum; // Store sum over y
+
+		// Advance pointers to the next elements
+		xPointer += 1;
+		yPointer += 1;
+	}
+}
+
+void vector_accumulate_sse2_load_aligned(const double *CSE6230_RESTRICT xPointer, double *CSE6230_RESTRICT yPointer, size_t length) {
+	// Process by one element until xPointer (the input array) is aligned on 16
+	for (; (size_t(xPointer) % size_t(16) != 0) && (length != 0); length -= 1) {
+		const double x = *xPointer; // Load x
+		const double y = *yPointer; // Load y
+		const double sum = x + y; // Compute sum
+		*yPointer = sum; // Store sum over y
+
+		// Advance pointers to the next elements
+		xPointer += 1;
+		yPointer += 1;
+	}
+	// Process arrays by two elements at an iteration
+	// xPointer is aligned on 16, so we can use aligned load instruction
+	for (; length >= 2; length -= 2) {
+		const __m128d x = _mm_load_pd(xPointer); // Aligned (!) load two x elements
+		const __m128d y = _mm_loadu_pd(yPointer); // Load two y elements
+		const __m128d sum = _mm_add_pd(x, y); // Compute two sum elements
+		_mm_storeu_pd(yPointer, sum); // Store two elements over y
+		
+		// Advance pointers to the next two elements
+		xPointer += 2;
+		yPointer += 2;
+	}
+	// Process remaining elements (if any)
+	for (; length != 0; length -= 1) {
+		const double x = *xPointer; // Load x
+		const double y = *yPointer; // Load y
+		const double sum = x + y; // Compute sum
+		*yPointer = sum; // Store sum over y
+
+		// Advance pointers to the next elements
+		xPointer += 1;
+		yPointer += 1;
+	}
+}
+
+void vector_accumulate_sse2_store_aligned(const double *CSE6230_RESTRICT xPointer, double *CSE6230_RESTRICT yPointer, size_t length) {
+	// Process by one element until yPointer (the output array) is aligned on 16
+	for (; (size_t(yPointer) % size_t(16) != 0) && (length != 0); length -= 1) {
+		const double x = *xPointer; // Load x
+		const double y = *yPointer; // Load y
+		const double sum = x + y; // Compute sum
+		*yPointer = sum; // Store sum over y
+
+		// Advance pointers to the next elements
+		xPointer += 1;
+		yPointer += 1;
+	}
+	// Process arrays by two elements at an iteration
+	// yPointer is aligned on 16, so we can use aligned load and store instructions for y
+	for (; length >= 2; length -= 2) {
+		const __m128d x = _mm_loadu_pd(xPointer); // Load two x elements
+		const __m128d y = _mm_load_pd(yPointer); // Aligned (!) load two y elements
+		const __m128d sum = _mm_add_pd(x, y); // Compute two sum elements
+		_mm_store_pd(yPointer, sum); // Aligned (!) store two elements over y
+		
+		// Advance pointers to the next two elements
+		xPointer += 2;
+		yPointer += 2;
+	}
+	// Process remaining elements (if any)
+	for (; length != 0; length -= 1) {
+		const double x = *xPointer; // Load x
+		const double y = *yPointer; // Load y
+		const double sum = x + y; // Compute sum
+		*yPointer = sum; // Store sum over y
+
+		// Advance pointers to the next elements
+		xPointer += 1;
+		yPointer += 1;
+	}
+}
+#endif
+
+#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+void vector_accumulate_avx(const double *CSE6230_RESTRICT xPointer, double *CSE6230_RESTRICT yPointer, size_t length) {
+	// Process arrays by four elements at an iteration
+	for (; length >= 4; length -= 4) {
+		const __m256d x = _mm256_loadu_pd(xPointer); // Load four x elements
+		const __m256d y = _mm256_loadu_pd(yPointer); // Load four y elements
+		const __m256d sum = _mm256_add_pd(x, y); // Compute four sum elements
+		_mm256_storeu_pd(yPointer, sum); // Store four elements over y
+		
+		// Advance pointers to the next four elements
+		xPointer += 4;
+		yPointer += 4;
+	}
+	// Process remaining elements (if any)
+	for (; length != 0; length -= 1) {
+		const double x = *xPointer; // Load x
+		const double y = *yPointer; // Load y
+		const double sum = x + y; // Compute sum
+		*yPointer = sum; // Store sum over y
+
+		// Advance pointers to the next elements
+		xPointer += 1;
+		yPointer += 1;
+	}
+}
+
+void vector_accumulate_avx_aligned(const double *CSE6230_RESTRICT xPointer, double *CSE6230_RESTRICT yPointer, size_t length) {
+	// Process arrays by four elements at an iteration
+	for (; length >= 4; length -= 4) {
+		const __m256d x = _mm256_load_pd(xPointer); // Aligned (!) load four x elements
+		const __m256d y = _mm256_load_pd(yPointer); // Aligned (!) load four y elements
+		const __m256d sum = _mm256_add_pd(x, y); // Compute four sum elements
+		_mm256_store_pd(yPointer, sum); // Aligned (!) store four elements over y
+		
+		// Advance pointers to the next four elements
+		xPointer += 4;
+		yPointer += 4;
+	}
+	// Process remaining elements (if any)
+	for (; length != 0; length -= 1) {
+		const double x = *xPointer; // Load x
+		const double y = *yPointer; // Load y
+		const double sum = x + y; // Compute sum
+		*yPointer = sum; // Store sum over y
+
+		// Advance pointers to the next elements
+		xPointer += 1;
+		yPointer += 1;
+	}
+}
+
+void vector_accumulate_avx_load_aligned(const double *CSE6230_RESTRICT xPointer, double *CSE6230_RESTRICT yPointer, size_t length) {
+	// Process by one element until xPointer (the input array) is aligned on 32
+	for (; (size_t(xPointer) % size_t(32) != 0) && (length != 0); length -= 1) {
+		const double x = *xPointer; // Load x
+		const double y = *yPointer; // Load y
+		const double sum = x + y; // Compute sum
+		*yPointer = sum; // Store sum over y
+
+		// Advance pointers to the next elements
+		xPointer += 1;
+		yPointer += 1;
+	}
+	// Process arrays by four elements at an iteration
+	// xPointer is aligned on 32, so we can use aligned load instruction
+	for (; length >= 4; length -= 4) {
+		const __m256d x = _mm256_load_pd(xPointer); // Aligned (!) load four x elements
+		const __m256d y = _mm256_loadu_pd(yPointer); // Load four y elements
+		const __m256d sum = _mm256_add_pd(x, y); // Compute four sum elements
+		_mm256_storeu_pd(yPointer, sum); // Store four elements over y
+		
+		// Advance pointers to the next four elements
+		xPointer += 4;
+		yPointer += 4;
+	}
+	// Process remaining elements (if any)
+	for (; length != 0; length -= 1) {
+		const double x = *xPointer; // Load x
+		const double y = *yPointer; // Load y
+		const double sum = x + y; // Compute sum
+		*yPointer = sum; // Store sum over y
+
+		// Advance pointers to the next elements
+		xPointer += 1;
+		yPointer += 1;
+	}
+}
+
+void vector_accumulate_avx_store_aligned(const double *CSE6230_RESTRICT xPointer, double *CSE6230_RESTRICT yPointer, size_t length) {
+	// Process by one element until yPointer (the output array) is aligned on 32
+	for (; (size_t(yPointer) % size_t(32) != 0) && (length != 0); length -= 1) {
+		const double x = *xPointer; // Load x
+		const double y = *yPointer; // Load y
+		const double sum = x + y; // Compute sum
+		*yPointer = sum; // Store sum over y
+
+		// Advance pointers to the next elements
+		xPointer += 1;
+		yPointer += 1;
+	}
+	// Process arrays by four elements at an iteration
+	// yPointer is aligned on 32, so we can use aligned load and store instructions for y
+	for (; length >= 4; length -= 4) {
+		const __m256d x = _mm256_loadu_pd(xPointer); // Load four x elements
+		const __m256d y = _mm256_load_pd(yPointer); // Aligned (!) load four y elements
+		const __m256d sum = _mm256_add_pd(x, y); // Compute four sum elements
+		_mm256_store_pd(yPointer, sum); // Aligned (!) store four elements over y
+		
+		// Advance pointers to the next four elements
+		xPointer += 4;
+		yPointer += 4;
+	}
+	// Process remaining elements (if any)
+	for (; length != 0; length -= 1) {
+		const double x = *xPointer; // Load x
+		const double y = *yPointer; // Load y
+		const double sum = x + y; // Compute sum
+		*yPointer = sum; // Store sum over y
+
+		// Advance pointers to the next elements
+		xPointer += 1;
+		yPointer += 1;
+	}
+}
+#endif
+
+void vector_axpy_naive(double a, const double *CSE6230_RESTRICT xPointer, double *CSE6230_RESTRICT yPointer, size_t length) {
+	for (; length != 0; length -= 1) {
+		const double x = *xPointer; // Load x
+		const double y = *yPointer; // Load y
+		const double result = a * x + y; // Compute a * x + y
+		*yPointer = result; // Store result over y
+
+		// Advance pointers to the next elements
+		xPointer += 1;
+		yPointer += 1;
+	}
+}
+
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+void vector_axpy_sse2(double a, const double *CSE6230_RESTRICT xPointer, double *CSE6230_RESTRICT yPointer, size_t length) {
+	const __m128d aX2 = _mm_set1_pd(a); // Broadcast a to all elements
+	// Process arrays by two elements at an iteration
+	for (; length >= 2; length -= 2) {
+		const __m128d x = _mm_loadu_pd(xPointer); // Load two x elements
+		const __m128d y = _mm_loadu_pd(yPointer); // Load two y elements
+		const __m128d result = _mm_add_pd(_mm_mul_pd(aX2, x), y); // Compute two elements of a * x + y
+		_mm_storeu_pd(yPointer, result); // Store two elements over y
+		
+		// Advance pointers to the next two elements
+		xPointer += 2;
+		yPointer += 2;
+	}
+	// Process remaining elements (if any)
+	for (; length != 0; length -= 1) {
+		const double x = *xPointer; // Load x
+		const double y = *yPointer; // Load y
+		const double result = a * x + y; // Compute a * x + y
+		*yPointer = result; // Store result over y
+
+		// Advance pointers to the next elements
+		xPointer += 1;
+		yPointer += 1;
+	}
+}
+
+void vector_axpy_sse2_aligned(double a, const double *CSE6230_RESTRICT xPointer, double *CSE6230_RESTRICT yPointer, size_t length) {
+	const __m128d aX2 = _mm_set1_pd(a); // Broadcast a to all elements
+	// Process arrays by two elements at an iteration
+	for (; length >= 2; length -= 2) {
+		const __m128d x = _mm_load_pd(xPointer); // Aligned (!) load two x elements
+		const __m128d y = _mm_load_pd(yPointer); // Aligned (!) load two y elements
+		const __m128d result = _mm_add_pd(_mm_mul_pd(aX2, x), y); // Compute two elements of a * x + y
+		_mm_store_pd(yPointer, result); // Aligned (!) store two elements over y
+		
+		// Advance pointers to the next two elements
+		xPointer += 2;
+		yPointer += 2;
+	}
+	// Process remaining elements (if any)
+	for (; length != 0; length -= 1) {
+		const double x = *xPointer; // Load x
+		const double y = *yPointer; // Load y
+		const double result = a * x + y; // Compute a * x + y
+		*yPointer = result; // Store result over y
+
+		// Advance pointers to the next elements
+		xPointer += 1;
+		yPointer += 1;
+	}
+}
+
+void vector_axpy_sse2_load_aligned(double a, const double *CSE6230_RESTRICT xPointer, double *CSE6230_RESTRICT yPointer, size_t length) {
+	// Process by one element until xPointer (the input array) is aligned on 16
+	for (; (size_t(xPointer) % size_t(16) != 0) && (length != 0); length -= 1) {
+		const double x = *xPointer; // Load x
+		const double y = *yPointer; // Load y
+		const double result = a * x + y; // Compute a * x + y
+		*yPointer = result; // Store result over y
+
+		// Advance pointers to the next elements
+		xPointer += 1;
+		yPointer += 1;
+	}
+	const __m128d aX2 = _mm_set1_pd(a); // Broadcast a to all elements
+	// Process arrays by two elements at an iteration
+	// xPointer is aligned on 16, so we can use aligned load instruction
+	for (; length >= 2; length -= 2) {
+		const __m128d x = _mm_load_pd(xPointer); // Aligned (!) load two x elements
+		const __m128d y = _mm_loadu_pd(yPointer); // Load two y elements
+		const __m128d result = _mm_add_pd(_mm_mul_pd(aX2, x), y); // Compute two elements of a * x + y
+		_mm_storeu_pd(yPointer, result); // Store two elements over y
+		
+		// Advance pointers to the next two elements
+		xPointer += 2;
+		yPointer += 2;
+	}
+	// Process remaining elements (if any)
+	for (; length != 0; length -= 1) {
+		const double x = *xPointer; // Load x
+		const double y = *yPointer; // Load y
+		const double result = a * x + y; // Compute a * x + y
+		*yPointer = result; // Store result over y
+
+		// Advance pointers to the next elements
+		xPointer += 1;
+		yPointer += 1;
+	}
+}
+
+void vector_axpy_sse2_store_aligned(double a, const double *CSE6230_RESTRICT xPointer, double *CSE6230_RESTRICT yPointer, size_t length) {
+	// Process by one element until yPointer (the output array) is aligned on 16
+	for (; (size_t(yPointer) % size_t(16) != 0) && (length != 0); length -= 1) {
+		const double x = *xPointer; // Load x
+		const double y = *yPointer; // Load y
+		const double result = a * x + y; // Compute a * x + y
+		*yPointer = result; // Store result over y
+
+		// Advance pointers to the next elements
+		xPointer += 1;
+		yPointer += 1;
+	}
+	const __m128d aX2 = _mm_set1_pd(a); // Broadcast a to all elements
+	// Process arrays by two elements at an iteration
+	// yPointer is aligned on 16, so we can use aligned load and store instructions for y
+	for (; length >= 2; length -= 2) {
+		const __m128d x = _mm_loadu_pd(xPointer); // Load two x elements
+		const __m128d y = _mm_load_pd(yPointer); // Aligned (!) load two y elements
+		const __m128d result = _mm_add_pd(_mm_mul_pd(aX2, x), y); // Compute two elements of a * x + y
+		_mm_store_pd(yPointer, result); // Aligned (!) store two elements over y
+		
+		// Advance pointers to the next two elements
+		xPointer += 2;
+		yPointer += 2;
+	}
+	// Process remaining elements (if any)
+	for (; length != 0; length -= 1) {
+		const double x = *xPointer; // Load x
+		const double y = *yPointer; // Load y
+		const double result = a * x + y; // Compute a * x + y
+		*yPointer = result; // Store result over y
+
+		// Advance pointers to the next elements
+		xPointer += 1;
+		yPointer += 1;
+	}
+}
+#endif
+
+#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+void vector_axpy_avx(double a, const double *CSE6230_RESTRICT xPointer, double *CSE6230_RESTRICT yPointer, size_t length) {
+	const __m256d aX4 = _mm256_set1_pd(a); // Broadcast a to all elements
+	// Process arrays by four elements at an iteration
+	for (; length >= 4; length -= 4) {
+		const __m256d x = _mm256_loadu_pd(xPointer); // Load four x elements
+		const __m256d y = _mm256_loadu_pd(yPointer); // Load four y elements
+		const __m256d result = _mm256_add_pd(_mm256_mul_pd(aX4, x), y); // Compute four elements of a * x + y
+		_mm256_storeu_pd(yPointer, result); // Store four elements over y
+		
+		// Advance pointers to the next four elements
+		xPointer += 4;
+		yPointer += 4;
+	}
+	// Process remaining elements (if any)
+	for (; length != 0; length -= 1) {
+		const double x = *xPointer; // Load x
+		const double y = *yPointer; // Load y
+		const double result = a * x + y; // Compute a * x + y
+		*yPointer = result; // Store result over y
+
+		// Advance pointers to the next elements
+		xPointer += 1;
+		yPointer += 1;
+	}
+}
+
+void vector_axpy_avx_aligned(double a, const double *CSE6230_RESTRICT xPointer, double *CSE6230_RESTRICT yPointer, size_t length) {
+	const __m256d aX4 = _mm256_set1_pd(a); // Broadcast a to all elements
+	// Process arrays by four elements at an iteration
+	for (; length >= 4; length -= 4) {
+		const __m256d x = _mm256_load_pd(xPointer); // Aligned (!) load four x elements
+		const __m256d y = _mm256_load_pd(yPointer); // Aligned (!) load four y elements
+		const __m256d result = _mm256_add_pd(_mm256_mul_pd(aX4, x), y); // Compute four elements of a * x + y
+		_mm256_store_pd(yPointer, result); // Aligned (!) store four elements over y
+		
+		// Advance pointers to the next four elements
+		xPointer += 4;
+		yPointer += 4;
+	}
+	// Process remaining elements (if any)
+	for (; length != 0; length -= 1) {
+		const double x = *xPointer; // Load x
+		const double y = *yPointer; // Load y
+		const double result = a * x + y; // Compute a * x + y
+		*yPointer = result; // Store result over y
+
+		// Advance pointers to the next elements
+		xPointer += 1;
+		yPointer += 1;
+	}
+}
+
+void vector_axpy_avx_load_aligned(double a, const double *CSE6230_RESTRICT xPointer, double *CSE6230_RESTRICT yPointer, size_t length) {
+	// Process by one element until xPointer (the input array) is aligned on 32
+	for (; (size_t(xPointer) % size_t(32) != 0) && (length != 0); length -= 1) {
+		const double x = *xPointer; // Load x
+		const double y = *yPointer; // Load y
+		const double result = a * x + y; // Compute a * x + y
+		*yPointer = result; // Store result over y
+
+		// Advance pointers to the next elements
+		xPointer += 1;
+		yPointer += 1;
+	}
+	const __m256d aX4 = _mm256_set1_pd(a); // Broadcast a to all elements
+	// Process arrays by four elements at an iteration
+	// xPointer is aligned on 32, so we can use aligned load instruction
+	for (; length >= 4; length -= 4) {
+		const __m256d x = _mm256_load_pd(xPointer); // Aligned (!) load four x elements
+		const __m256d y = _mm256_loadu_pd(yPointer); // Load four y elements
+		const __m256d result = _mm256_add_pd(_mm256_mul_pd(aX4, x), y); // Compute four elements of a * x + y
+		_mm256_storeu_pd(yPointer, result); // Store four elements over y
+		
+		// Advance pointers to the next four elements
+		xPointer += 4;
+		yPointer += 4;
+	}
+	// Process remaining elements (if any)
+	for (; length != 0; length -= 1) {
+		const double x = *xPointer; // Load x
+		const double y = *yPointer; // Load y
+		const double result = a * x + y; // Compute a * x + y
+		*yPointer = result; // Store result over y
+
+		// Advance pointers to the next elements
+		xPointer += 1;
+		yPointer += 1;
+	}
+}
+
+void vector_axpy_avx_store_aligned(double a, const double *CSE6230_RESTRICT xPointer, double *CSE6230_RESTRICT yPointer, size_t length) {
+	// Process by one element until yPointer (the output array) is aligned on 32
+	for (; (size_t(yPointer) % size_t(32) != 0) && (length != 0); length -= 1) {
+		const double x = *xPointer; // Load x
+		const double y = *yPointer; // Load y
+		const double result = a * x + y; // Compute a * x + y
+		*yPointer = result; // Store result over y
+
+		// Advance pointers to the next elements
+		xPointer += 1;
+		yPointer += 1;
+	}
+	const __m256d aX4 = _mm256_set1_pd(a); // Broadcast a to all elements
+	// Process arrays by four elements at an iteration
+	// yPointer is aligned on 32, so we can use aligned load and store instructions for y
+	for (; length >= 4; length -= 4) {
+		const __m256d x = _mm256_loadu_pd(xPointer); // Load four x elements
+		const __m256d y = _mm256_load_pd(yPointer); // Aligned (!) load four y elements
+		const __m256d result = _mm256_add_pd(_mm256_mul_pd(aX4, x), y); // Compute four elements of a * x + y
+		_mm256_store_pd(yPointer, result); // Aligned (!) store four elements over y
+		
+		// Advance pointers to the next four elements
+		xPointer += 4;
+		yPointer += 4;
+	}
+	// Process remaining elements (if any)
+	for (; length != 0; length -= 1) {
+		const double x = *xPointer; // Load x
+		const double y = *yPointer; // Load y
+		const double result = a * x + y; // Compute a * x + y
+		*yPointer = result; // Store result over y
+
+		// Advance pointers to the next elements
+		xPointer += 1;
+		yPointer += 1;
+	}
+}
+#endif
+
 void vector_max_naive(const double *CSE6230_RESTRICT arrayPointer, double *CSE6230_RESTRICT maxPointer, size_t length) {
 	double max = minus_inf();
 	// Process remaining elements (if any)
@@ -574,3 +1113,117 @@ void vector_max_avx_load_aligned_unrolled(const double *CSE6230_RESTRICT arrayPo
 	*maxPointer = max;
 }
 #endif
+
+void vector_max_f32_naive(const float *CSE6230_RESTRICT arrayPointer, double *CSE6230_RESTRICT maxPointer, size_t length) {
+	double max = minus_inf();
+	for (; length != 0; length -= 1) {
+		const double element = *arrayPointer; // Load and widen array element
+		max = fmax(max, element);
+
+		// Advance pointers to the next element
+		arrayPointer += 1;
+	}
+	*maxPointer = max;
+}
+
+// Widening is exact and preserves the order of elements, so the SIMD kernels below find the maximum in the storage
+// precision (with twice as many elements per vector) and widen only the final result. The elements are the first operand
+// of max instructions, which return the second operand if either one is NaN, so NaN elements are skipped as in fmax.
+
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+void vector_max_f32_sse2(const float *CSE6230_RESTRICT arrayPointer, double *CSE6230_RESTRICT maxPointer, size_t length) {
+	// Process arrays by four elements at an iteration
+	__m128 maxX4 = _mm_set1_ps(float(minus_inf()));
+	for (; length >= 4; length -= 4) {
+		const __m128 elementX4 = _mm_loadu_ps(arrayPointer); // Load four array elements
+		maxX4 = _mm_max_ps(elementX4, maxX4);
+		
+		// Advance pointers to the next four elements
+		arrayPointer += 4;
+	}
+	const __m128 maxX4PartiallyReduced = _mm_max_ps(maxX4, _mm_movehl_ps(maxX4, maxX4)); // The two low elements contain the max of the low and high halves of maxX4
+	const __m128 maxX4PartiallyReducedHigh = _mm_shuffle_ps(maxX4PartiallyReduced, maxX4PartiallyReduced, _MM_SHUFFLE(1, 1, 1, 1));
+	const __m128 maxX4Reduced = _mm_max_ss(maxX4PartiallyReduced, maxX4PartiallyReducedHigh); // The low element of maxX4Reduced contains the max of four elements in maxX4
+	double max = _mm_cvtsd_f64(_mm_cvtss_sd(_mm_setzero_pd(), maxX4Reduced)); // Widen the result to double precision
+	// Process remaining elements (if any)
+	for (; length != 0; length -= 1) {
+		const double element = *arrayPointer; // Load and widen array element
+		max = fmax(max, element);
+
+		// Advance pointers to the next element
+		arrayPointer += 1;
+	}
+	*maxPointer = max;
+}
+#endif
+
+#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+// Returns the max of eight single-precision elements in double precision
+inline static double reduce_max_ps(__m256 maxX8) {
+	const __m128 maxX8Low = _mm256_castps256_ps128(maxX8); // Contains the four low elements of maxX8
+	const __m128 maxX8High = _mm256_extractf128_ps(maxX8, 1); // Contains the four high elements of maxX8
+	const __m128 maxX4 = _mm_max_ps(maxX8Low, maxX8High);
+	const __m128 maxX4PartiallyReduced = _mm_max_ps(maxX4, _mm_movehl_ps(maxX4, maxX4));
+	const __m128 maxX4PartiallyReducedHigh = _mm_shuffle_ps(maxX4PartiallyReduced, maxX4PartiallyReduced, _MM_SHUFFLE(1, 1, 1, 1));
+	const __m128 maxX4Reduced = _mm_max_ss(maxX4PartiallyReduced, maxX4PartiallyReducedHigh);
+	return _mm_cvtsd_f64(_mm_cvtss_sd(_mm_setzero_pd(), maxX4Reduced));
+}
+
+void vector_max_f32_avx(const float *CSE6230_RESTRICT arrayPointer, double *CSE6230_RESTRICT maxPointer, size_t length) {
+	// Process arrays by eight elements at an iteration
+	__m256 maxX8 = _mm256_set1_ps(float(minus_inf()));
+	for (; length >= 8; length -= 8) {
+		const __m256 elementX8 = _mm256_loadu_ps(arrayPointer); // Load eight array elements
+		maxX8 = _mm256_max_ps(elementX8, maxX8);
+		
+		// Advance pointers to the next eight elements
+		arrayPointer += 8;
+	}
+	double max = reduce_max_ps(maxX8);
+	// Process remaining elements (if any)
+	for (; length != 0; length -= 1) {
+		const double element = *arrayPointer; // Load and widen array element
+		max = fmax(max, element);
+
+		// Advance pointers to the next element
+		arrayPointer += 1;
+	}
+	*maxPointer = max;
+}
+#endif
+
+void vector_max_f16_naive(const uint16_t *CSE6230_RESTRICT arrayPointer, double *CSE6230_RESTRICT maxPointer, size_t length) {
+	double max = minus_inf();
+	for (; length != 0; length -= 1) {
+		const double element = half_to_double(*arrayPointer); // Load and widen array element
+		max = fmax(max, element);
+
+		// Advance pointers to the next element
+		arrayPointer += 1;
+	}
+	*maxPointer = max;
+}
+
+#if defined(CSE6230_AVX_INTRINSICS_SUPPORTED) && defined(CSE6230_F16C_INTRINSICS_SUPPORTED)
+void vector_max_f16_f16c(const uint16_t *CSE6230_RESTRICT arrayPointer, double *CSE6230_RESTRICT maxPointer, size_t length) {
+	// Process arrays by eight elements at an iteration
+	__m256 maxX8 = _mm256_set1_ps(float(minus_inf()));
+	for (; length >= 8; length -= 8) {
+		const __m256 elementX8 = _mm256_cvtph_ps(_mm_loadu_si128((const __m128i*)arrayPointer)); // Load and widen eight array elements
+		maxX8 = _mm256_max_ps(elementX8, maxX8);
+		
+		// Advance pointers to the next eight elements
+		arrayPointer += 8;
+	}
+	double max = reduce_max_ps(maxX8);
+	// Process remaining elements (if any)
+	for (; length != 0; length -= 1) {
+		const double element = half_to_double(*arrayPointer); // Load and widen array element
+		max = fmax(max, element);
+
+		// Advance pointers to the next element
+		arrayPointer += 1;
+	}
+	*maxPointer = max;
+}
+#endif
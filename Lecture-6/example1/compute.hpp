@@ -28,32 +28,7 @@
 #include <stddef.h>
 #include <stdint.h>
 
-#if defined(__GNUC__)
-	// gcc or gcc-compatible compiler
-	#define CSE6230_RESTRICT __restrict__
-#elif defined(_MSC_VER)
-	// msvc or msvc-compatible compiler
-	#define CSE6230_RESTRICT __restrict
-#else
-	#warning Compiler is not recognized and restrict qualifier is not used.
-	#define CSE6230_RESTRICT
-#endif
-
-#if defined(__GNUC__)
-	#if defined(__SSE2__)
-		#define CSE6230_SSE2_INTRINSICS_SUPPORTED
-	#endif
-	#if defined(__AVX__)
-		#define CSE6230_AVX_INTRINSICS_SUPPORTED
-	#endif
-#elif defined(_MSC_VER)
-	#if defined(_M_IX86) || defined(_M_X64)
-		#define CSE6230_SSE2_INTRINSICS_SUPPORTED
-		#define CSE6230_AVX_INTRINSICS_SUPPORTED
-	#endif
-#else
-	#warning Compiler is not recognized and intrinsic functions are not used.
-#endif
+#include <isa.hpp>
 
 
 typedef void (*vector_add_function)(const double*, const double*, double*, size_t);
@@ -72,6 +47,38 @@ extern "C" void vector_add_avx_load_aligned(const double *CSE6230_RESTRICT xPoin
 extern "C" void vector_add_avx_store_aligned(const double *CSE6230_RESTRICT xPointer, const double *CSE6230_RESTRICT yPointer, double *CSE6230_RESTRICT sumPointer, size_t length);
 #endif
 
+typedef void (*vector_accumulate_function)(const double*, double*, size_t);
+
+extern "C" void vector_accumulate_naive(const double *CSE6230_RESTRICT xPointer, double *CSE6230_RESTRICT yPointer, size_t length);
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+extern "C" void vector_accumulate_sse2(const double *CSE6230_RESTRICT xPointer, double *CSE6230_RESTRICT yPointer, size_t length);
+extern "C" void vector_accumulate_sse2_aligned(const double *CSE6230_RESTRICT xPointer, double *CSE6230_RESTRICT yPointer, size_t length);
+extern "C" void vector_accumulate_sse2_load_aligned(const double *CSE6230_RESTRICT xPointer, double *CSE6230_RESTRICT yPointer, size_t length);
+extern "C" void vector_accumulate_sse2_store_aligned(const double *CSE6230_RESTRICT xPointer, double *CSE6230_RESTRICT yPointer, size_t length);
+#endif
+#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+extern "C" void vector_accumulate_avx(const double *CSE6230_RESTRICT xPointer, double *CSE6230_RESTRICT yPointer, size_t length);
+extern "C" void vector_accumulate_avx_aligned(const double *CSE6230_RESTRICT xPointer, double *CSE6230_RESTRICT yPointer, size_t length);
+extern "C" void vector_accumulate_avx_load_aligned(const double *CSE6230_RESTRICT xPointer, double *CSE6230_RESTRICT yPointer, size_t length);
+extern "C" void vector_accumulate_avx_store_aligned(const double *CSE6230_RESTRICT xPointer, double *CSE6230_RESTRICT yPointer, size_t length);
+#endif
+
+typedef void (*vector_axpy_function)(double, const double*, double*, size_t);
+
+extern "C" void vector_axpy_naive(double a, const double *CSE6230_RESTRICT xPointer, double *CSE6230_RESTRICT yPointer, size_t length);
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+extern "C" void vector_axpy_sse2(double a, const double *CSE6230_RESTRICT xPointer, double *CSE6230_RESTRICT yPointer, size_t length);
+extern "C" void vector_axpy_sse2_aligned(double a, const double *CSE6230_RESTRICT xPointer, double *CSE6230_RESTRICT yPointer, size_t length);
+extern "C" void vector_axpy_sse2_load_aligned(double a, const double *CSE6230_RESTRICT xPointer, double *CSE6230_RESTRICT yPointer, size_t length);
+extern "C" void vector_axpy_sse2_store_aligned(double a, const double *CSE6230_RESTRICT xPointer, double *CSE6230_RESTRICT yPointer, size_t length);
+#endif
+#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+extern "C" void vector_axpy_avx(double a, const double *CSE6230_RESTRICT xPointer, double *CSE6230_RESTRICT yPointer, size_t length);
+extern "C" void vector_axpy_avx_aligned(double a, const double *CSE6230_RESTRICT xPointer, double *CSE6230_RESTRICT yPointer, size_t length);
+extern "C" void vector_axpy_avx_load_aligned(double a, const double *CSE6230_RESTRICT xPointer, double *CSE6230_RESTRICT yPointer, size_t length);
+extern "C" void vector_axpy_avx_store_aligned(double a, const double *CSE6230_RESTRICT xPointer, double *CSE6230_RESTRICT yPointer, size_t length);
+#endif
+
 typedef void (*vector_max_function)(const double*, double*, size_t);
 
 extern "C" void vector_max_naive(const double *CSE6230_RESTRICT arrayPointer, double *CSE6230_RESTRICT maxPointer, size_t length);
@@ -85,3 +92,20 @@ extern "C" void vector_max_avx(const double *CSE6230_RESTRICT arrayPointer, doub
 extern "C" void vector_max_avx_load_aligned(const double *CSE6230_RESTRICT arrayPointer, double *CSE6230_RESTRICT maxPointer, size_t length);
 extern "C" void vector_max_avx_load_aligned_unrolled(const double *CSE6230_RESTRICT arrayPointer, double *CSE6230_RESTRICT maxPointer, size_t length);
 #endif
+
+// Mixed-precision max: elements are stored in single (f32) or half (f16, IEEE binary16) precision, and the maximum is
+// returned in double precision. Both formats widen exactly to double, so the result equals the maximum of the widened elements.
+typedef void (*vector_max_f32_function)(const float*, double*, size_t);
+typedef void (*vector_max_f16_function)(const uint16_t*, double*, size_t);
+
+extern "C" void vector_max_f32_naive(const float *CSE6230_RESTRICT arrayPointer, double *CSE6230_RESTRICT maxPointer, size_t length);
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+extern "C" void vector_max_f32_sse2(const float *CSE6230_RESTRICT arrayPointer, double *CSE6230_RESTRICT maxPointer, size_t length);
+#endif
+#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+extern "C" void vector_max_f32_avx(const float *CSE6230_RESTRICT arrayPointer, double *CSE6230_RESTRICT maxPointer, size_t length);
+#endif
+extern "C" void vector_max_f16_naive(const uint16_t *CSE6230_RESTRICT arrayPointer, double *CSE6230_RESTRICT maxPointer, size_t length);
+#if defined(CSE6230_AVX_INTRINSICS_SUPPORTED) && defined(CSE6230_F16C_INTRINSICS_SUPPORTED)
+extern "C" void vector_max_f16_f16c(const uint16_t *CSE6230_RESTRICT arrayPointer, double *CSE6230_RESTRICT maxPointer, size_t length);
+#endif
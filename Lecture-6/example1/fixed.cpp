@@ -0,0 +1,370 @@
+/******************************************************************************\
+ *                                                                            *
+ * Copyright (c) 2012 Marat Dukhan                                            *
+ *                                                                            *
+ * This software is provided 'as-is', without any express or implied          *
+ * warranty. In no event will the authors be held liable for any damages      *
+ * arising from the use of this software.                                     *
+ *                                                                            *
+ * Permission is granted to anyone to use this software for any purpose,      *
+ * including commercial applications, and to alter it and redistribute it     *
+ * freely, subject to the following restrictions:                             *
+ *                                                                            *
+ * 1. The origin of this software must not be misrepresented; you must not    *
+ * claim that you wrote the original software. If you use this software       *
+ * in a product, an acknowledgment in the product documentation would be      *
+ * appreciated but is not required.                                           *
+ *                                                                            *
+ * 2. Altered source versions must be plainly marked as such, and must not be *
+ * misrepresented as being the original software.                             *
+ *                                                                            *
+ * 3. This notice may not be removed or altered from any source               *
+ * distribution.                                                              *
+ *                                                                            *
+\******************************************************************************/
+
+#include <fixed.hpp>
+#include <dispatch.hpp>
+#include <telemetry.hpp>
+#include <limits>
+#if defined(CSE6230_SSE2_INTRINSICS_SUPPORTED) || defined(CSE6230_AVX_INTRINSICS_SUPPORTED)
+	#if defined(__GNUC__)
+		#include <x86intrin.h>
+	#elif defined(_MSC_VER)
+		#include <intrin.h>
+	#else
+		#error Intrinsics headers are not included: unknown compiler
+	#endif
+#endif
+
+// The unrolled code is generated by recursive templates: the whole recursion must be inlined to get straight-line code
+#if defined(__GNUC__)
+	#define CSE6230_UNROLLED inline __attribute__((always_inline))
+#elif defined(_MSC_VER)
+	#define CSE6230_UNROLLED __forceinline
+#else
+	#define CSE6230_UNROLLED inline
+#endif
+
+// Operations on SIMD vectors of doubles. Each specialization provides:
+//   narrower: the instruction set used for arrays shorter than width
+//   load, store (unaligned), add, max
+//   load_ordered: unaligned load which replaces NaN elements with -infinity. fmax in vector_max_naive skips NaN, and so
+//     does the maximum of the loaded elements. The x86 max instructions return their second operand if either one is NaN.
+//   reduce_max: the maximum element of a vector
+template <typename ISA>
+struct simd_pd;
+
+template <>
+struct simd_pd<isa_naive> {
+	typedef double vector;
+	typedef isa_naive narrower;
+	static const size_t width = 1;
+
+	static vector load(const double* pointer) { return *pointer; }
+	static void store(double* pointer, vector v) { *pointer = v; }
+	static vector add(vector a, vector b) { return a + b; }
+	static vector max(vector a, vector b) { return a > b ? a : b; }
+	static vector load_ordered(const double* pointer) {
+		const double element = *pointer;
+		return (element == element) ? element : -std::numeric_limits<double>::infinity();
+	}
+	static double reduce_max(vector v) { return v; }
+};
+
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+template <>
+struct simd_pd<isa_sse2> {
+	typedef __m128d vector;
+	typedef isa_naive narrower;
+	static const size_t width = 2;
+
+	static vector load(const double* pointer) { return _mm_loadu_pd(pointer); }
+	static void store(double* pointer, vector v) { _mm_storeu_pd(pointer, v); }
+	static vector add(vector a, vector b) { return _mm_add_pd(a, b); }
+	static vector max(vector a, vector b) { return _mm_max_pd(a, b); }
+	static vector load_ordered(const double* pointer) {
+		return _mm_max_pd(_mm_loadu_pd(pointer), _mm_set1_pd(-std::numeric_limits<double>::infinity()));
+	}
+	static double reduce_max(vector v) {
+		return _mm_cvtsd_f64(_mm_max_sd(v, _mm_unpackhi_pd(v, v)));
+	}
+};
+#endif
+
+#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+template <>
+struct simd_pd<isa_avx> {
+	typedef __m256d vector;
+	typedef isa_sse2 narrower;
+	static const size_t width = 4;
+
+	static vector load(const double* pointer) { return _mm256_loadu_pd(pointer); }
+	static void store(double* pointer, vector v) { _mm256_storeu_pd(pointer, v); }
+	static vector add(vector a, vector b) { return _mm256_add_pd(a, b); }
+	static vector max(vector a, vector b) { return _mm256_max_pd(a, b); }
+	static vector load_ordered(const double* pointer) {
+		return _mm256_max_pd(_mm256_loadu_pd(pointer), _mm256_set1_pd(-std::numeric_limits<double>::infinity()));
+	}
+	static double reduce_max(vector v) {
+		return simd_pd<isa_sse2>::reduce_max(_mm_max_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1)));
+	}
+};
+#endif
+
+#ifdef CSE6230_AVX512F_INTRINSICS_SUPPORTED
+template <>
+struct simd_pd<isa_avx512f> {
+	typedef __m512d vector;
+	typedef isa_avx narrower;
+	static const size_t width = 8;
+
+	static vector load(const double* pointer) { return _mm512_loadu_pd(pointer); }
+	static void store(double* pointer, vector v) { _mm512_storeu_pd(pointer, v); }
+	static vector add(vector a, vector b) { return _mm512_add_pd(a, b); }
+	static vector max(vector a, vector b) { return _mm512_max_pd(a, b); }
+	static vector load_ordered(const double* pointer) {
+		return _mm512_max_pd(_mm512_loadu_pd(pointer), _mm512_set1_pd(-std::numeric_limits<double>::infinity()));
+	}
+	static double reduce_max(vector v) {
+		return simd_pd<isa_avx>::reduce_max(_mm256_max_pd(_mm512_castpd512_pd256(v), _mm512_extractf64x4_pd(v, 1)));
+	}
+};
+#endif
+
+// Adds Count elements starting at Offset; Count is a multiple of the SIMD width
+template <typename ISA, size_t Offset, size_t Count>
+struct add_block {
+	static CSE6230_UNROLLED void run(const double* xPointer, const double* yPointer, double* sumPointer) {
+		typedef simd_pd<ISA> simd;
+		simd::store(sumPointer + Offset, simd::add(simd::load(xPointer + Offset), simd::load(yPointer + Offset)));
+		add_block<ISA, Offset + simd::width, Count - simd::width>::run(xPointer, yPointer, sumPointer);
+	}
+};
+
+template <typename ISA, size_t Offset>
+struct add_block<ISA, Offset, 0> {
+	static CSE6230_UNROLLED void run(const double*, const double*, double*) {}
+};
+
+// Adds the last N % width elements with a vector operation on elements [N - width, N)
+template <typename ISA, size_t N, bool HasTail>
+struct add_tail {
+	static CSE6230_UNROLLED void run(const double* xPointer, const double* yPointer, double* sumPointer) {
+		add_block<ISA, N - simd_pd<ISA>::width, simd_pd<ISA>::width>::run(xPointer, yPointer, sumPointer);
+	}
+};
+
+template <typename ISA, size_t N>
+struct add_tail<ISA, N, false> {
+	static CSE6230_UNROLLED void run(const double*, const double*, double*) {}
+};
+
+template <typename ISA, size_t N, bool Wide = (N >= simd_pd<ISA>::width)>
+struct add_fixed {
+	static CSE6230_UNROLLED void run(const double* xPointer, const double* yPointer, double* sumPointer) {
+		const size_t width = simd_pd<ISA>::width;
+		add_block<ISA, 0, N - N % width>::run(xPointer, yPointer, sumPointer);
+		add_tail<ISA, N, N % width != 0>::run(xPointer, yPointer, sumPointer);
+	}
+};
+
+// Arrays shorter than one SIMD vector
+template <typename ISA, size_t N>
+struct add_fixed<ISA, N, false> {
+	static CSE6230_UNROLLED void run(const double* xPointer, const double* yPointer, double* sumPointer) {
+		add_fixed<typename simd_pd<ISA>::narrower, N>::run(xPointer, yPointer, sumPointer);
+	}
+};
+
+// Maximum of Count elements starting at Offset; Count is a non-zero multiple of the SIMD width.
+// The elements are reduced as a balanced tree to keep the dependency chains short.
+template <typename ISA, size_t Offset, size_t Count, bool Single = (Count == simd_pd<ISA>::width)>
+struct max_block {
+	static CSE6230_UNROLLED typename simd_pd<ISA>::vector run(const double* arrayPointer) {
+		typedef simd_pd<ISA> simd;
+		const size_t half = Count / simd::width / 2 * simd::width;
+		return simd::max(max_block<ISA, Offset, half>::run(arrayPointer), max_block<ISA, Offset + half, Count - half>::run(arrayPointer));
+	}
+};
+
+template <typename ISA, size_t Offset, size_t Count>
+struct max_block<ISA, Offset, Count, true> {
+	static CSE6230_UNROLLED typename simd_pd<ISA>::vector run(const double* arrayPointer) {
+		return simd_pd<ISA>::load_ordered(arrayPointer + Offset);
+	}
+};
+
+template <typename ISA, size_t N, bool Wide = (N >= simd_pd<ISA>::width)>
+struct max_fixed {
+	static CSE6230_UNROLLED double run(const double* arrayPointer) {
+		typedef simd_pd<ISA> simd;
+		typename simd::vector max = max_block<ISA, 0, N - N % simd::width>::run(arrayPointer);
+		if (N % simd::width != 0) {
+			// The overlapping elements do not change the maximum
+			max = simd::max(max, simd::load_ordered(arrayPointer + N - simd::width));
+		}
+		return simd::reduce_max(max);
+	}
+};
+
+// Arrays shorter than one SIMD vector
+template <typename ISA, size_t N>
+struct max_fixed<ISA, N, false> {
+	static CSE6230_UNROLLED double run(const double* arrayPointer) {
+		return max_fixed<typename simd_pd<ISA>::narrower, N>::run(arrayPointer);
+	}
+};
+
+template <size_t N, typename ISA>
+void vector_add_fixed(const double *CSE6230_RESTRICT xPointer, const double *CSE6230_RESTRICT yPointer, double *CSE6230_RESTRICT sumPointer) {
+	add_fixed<ISA, N>::run(xPointer, yPointer, sumPointer);
+}
+
+template <size_t N, typename ISA>
+void vector_max_fixed(const double *CSE6230_RESTRICT arrayPointer, double *CSE6230_RESTRICT maxPointer) {
+	*maxPointer = max_fixed<ISA, N>::run(arrayPointer);
+}
+
+#define CSE6230_INSTANTIATE_FIXED(N, ISA) \
+	template void vector_add_fixed<N, ISA>(const double*, const double*, double*); \
+	template void vector_max_fixed<N, ISA>(const double*, double*);
+
+CSE6230_FOREACH_FIXED_LENGTH(CSE6230_INSTANTIATE_FIXED, isa_naive)
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+	CSE6230_FOREACH_FIXED_LENGTH(CSE6230_INSTANTIATE_FIXED, isa_sse2)
+#endif
+#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+	CSE6230_FOREACH_FIXED_LENGTH(CSE6230_INSTANTIATE_FIXED, isa_avx)
+#endif
+#ifdef CSE6230_AVX512F_INTRINSICS_SUPPORTED
+	CSE6230_FOREACH_FIXED_LENGTH(CSE6230_INSTANTIATE_FIXED, isa_avx512f)
+#endif
+
+#define CSE6230_LIST_LENGTH(N, ISA) N,
+const size_t vector_fixed_lengths[] = { CSE6230_FOREACH_FIXED_LENGTH(CSE6230_LIST_LENGTH, isa_naive) };
+const size_t vector_fixed_lengths_count = sizeof(vector_fixed_lengths) / sizeof(vector_fixed_lengths[0]);
+
+// Registry
+
+#if defined(CSE6230_AVX512F_INTRINSICS_SUPPORTED)
+	typedef isa_avx512f isa_best;
+#elif defined(CSE6230_AVX_INTRINSICS_SUPPORTED)
+	typedef isa_avx isa_best;
+#elif defined(CSE6230_SSE2_INTRINSICS_SUPPORTED)
+	typedef isa_sse2 isa_best;
+#else
+	typedef isa_naive isa_best;
+#endif
+
+struct vector_add_fixed_entry {
+	size_t length;
+	vector_add_fixed_function function;
+};
+
+struct vector_max_fixed_entry {
+	size_t length;
+	vector_max_fixed_function function;
+};
+
+#define CSE6230_ADD_ENTRY(N, ISA) { N, &vector_add_fixed<N, ISA> },
+#define CSE6230_MAX_ENTRY(N, ISA) { N, &vector_max_fixed<N, ISA> },
+
+static vector_add_fixed_entry vector_add_fixed_registry[vector_fixed_registry_capacity] = {
+	CSE6230_FOREACH_FIXED_LENGTH(CSE6230_ADD_ENTRY, isa_best)
+};
+static size_t vector_add_fixed_registry_size = vector_fixed_lengths_count;
+
+static vector_max_fixed_entry vector_max_fixed_registry[vector_fixed_registry_capacity] = {
+	CSE6230_FOREACH_FIXED_LENGTH(CSE6230_MAX_ENTRY, isa_best)
+};
+static size_t vector_max_fixed_registry_size = vector_fixed_lengths_count;
+
+template <typename Entry, typename Function>
+static Function registry_lookup(const Entry* registry, size_t registrySize, size_t length) {
+	for (size_t index = 0; index < registrySize; index++) {
+		if (registry[index].length == length) {
+			return registry[index].function;
+		}
+	}
+	return NULL;
+}
+
+template <typename Entry, typename Function>
+static bool registry_register(Entry* registry, size_t& registrySize, size_t length, Function function) {
+	for (size_t index = 0; index < registrySize; index++) {
+		if (registry[index].length == length) {
+			registry[index].function = function;
+			return true;
+		}
+	}
+	if (registrySize == vector_fixed_registry_capacity) {
+		return false;
+	}
+	registry[registrySize].length = length;
+	registry[registrySize].function = function;
+	registrySize += 1;
+	return true;
+}
+
+vector_add_fixed_function vector_add_fixed_lookup(size_t length) {
+	return registry_lookup<vector_add_fixed_entry, vector_add_fixed_function>(vector_add_fixed_registry, vector_add_fixed_registry_size, length);
+}
+
+vector_max_fixed_function vector_max_fixed_lookup(size_t length) {
+	return registry_lookup<vector_max_fixed_entry, vector_max_fixed_function>(vector_max_fixed_registry, vector_max_fixed_registry_size, length);
+}
+
+bool vector_add_fixed_register(size_t length, vector_add_fixed_function function) {
+	return registry_register(vector_add_fixed_registry, vector_add_fixed_registry_size, length, function);
+}
+
+bool vector_max_fixed_register(size_t length, vector_max_fixed_function function) {
+	return registry_register(vector_max_fixed_registry, vector_max_fixed_registry_size, length, function);
+}
+
+// Dispatchers
+
+static dispatch_cache<vector_add_function> vector_add_dispatch_cache;
+static dispatch_cache<vector_max_function> vector_max_dispatch_cache;
+
+static inline void vector_add_dispatch_kernel(const double *CSE6230_RESTRICT xPointer, const double *CSE6230_RESTRICT yPointer, double *CSE6230_RESTRICT sumPointer, size_t length, uintptr_t pointerBits) {
+	const vector_add_fixed_function vector_add_fixed = vector_add_fixed_lookup(length);
+	if (vector_add_fixed != NULL) {
+		vector_add_fixed(xPointer, yPointer, sumPointer);
+		return;
+	}
+	const vector_add_function kernel = dispatch_select(vector_add_dispatch_cache, kernel_registry_operation_vector_add, pointerBits, &vector_add_naive);
+	kernel(xPointer, yPointer, sumPointer, length);
+}
+
+static inline void vector_max_dispatch_kernel(const double *CSE6230_RESTRICT arrayPointer, double *CSE6230_RESTRICT maxPointer, size_t length) {
+	const vector_max_fixed_function vector_max_fixed = vector_max_fixed_lookup(length);
+	if (vector_max_fixed != NULL) {
+		vector_max_fixed(arrayPointer, maxPointer);
+		return;
+	}
+	const vector_max_function kernel = dispatch_select(vector_max_dispatch_cache, kernel_registry_operation_vector_max, uintptr_t(arrayPointer), &vector_max_naive);
+	kernel(arrayPointer, maxPointer, length);
+}
+
+void vector_add_dispatch(const double *CSE6230_RESTRICT xPointer, const double *CSE6230_RESTRICT yPointer, double *CSE6230_RESTRICT sumPointer, size_t length) {
+	const uintptr_t pointerBits = uintptr_t(xPointer) | uintptr_t(yPointer) | uintptr_t(sumPointer);
+	if (kernel_telemetry_is_enabled()) {
+		const uint64_t startTicks = kernel_telemetry_begin(kernel_registry_operation_vector_add, length, pointerBits);
+		vector_add_dispatch_kernel(xPointer, yPointer, sumPointer, length, pointerBits);
+		kernel_telemetry_end(kernel_registry_operation_vector_add, startTicks);
+	} else {
+		vector_add_dispatch_kernel(xPointer, yPointer, sumPointer, length, pointerBits);
+	}
+}
+
+void vector_max_dispatch(const double *CSE6230_RESTRICT arrayPointer, double *CSE6230_RESTRICT maxPointer, size_t length) {
+	if (kernel_telemetry_is_enabled()) {
+		const uint64_t startTicks = kernel_telemetry_begin(kernel_registry_operation_vector_max, length, uintptr_t(arrayPointer));
+		vector_max_dispatch_kernel(arrayPointer, maxPointer, length);
+		kernel_telemetry_end(kernel_registry_operation_vector_max, startTicks);
+	} else {
+		vector_max_dispatch_kernel(arrayPointer, maxPointer, length);
+	}
+}
@@ -0,0 +1,77 @@
+/******************************************************************************\
+ *                                                                            *
+ * Copyright (c) 2012 Marat Dukhan                                            *
+ *                                                                            *
+ * This software is provided 'as-is', without any express or implied          *
+ * warranty. In no event will the authors be held liable for any damages      *
+ * arising from the use of this software.                                     *
+ *                                                                            *
+ * Permission is granted to anyone to use this software for any purpose,      *
+ * including commercial applications, and to alter it and redistribute it     *
+ * freely, subject to the following restrictions:                             *
+ *                                                                            *
+ * 1. The origin of this software must not be misrepresented; you must not    *
+ * claim that you wrote the original software. If you use this software       *
+ * in a product, an acknowledgment in the product documentation would be      *
+ * appreciated but is not required.                                           *
+ *                                                                            *
+ * 2. Altered source versions must be plainly marked as such, and must not be *
+ * misrepresented as being the original software.                             *
+ *                                                                            *
+ * 3. This notice may not be removed or altered from any source               *
+ * distribution.                                                              *
+ *                                                                            *
+\******************************************************************************/
+
+#pragma once
+
+#include <compute.hpp>
+#include <typed.hpp>
+
+// Fixed-length versions of vector_add and vector_max for double arrays of exactly N elements.
+// The loops are fully unrolled at compile time into straight-line SIMD code without branches:
+// full SIMD vectors cover the first N - N % width elements, and the remaining ones are processed
+// with one more vector operation which overlaps the previous one (or with a narrower instruction set if N < width).
+// vector_max_fixed skips NaN elements like vector_max_naive: each load costs one more max instruction outside the
+// dependency chains of the reduction.
+// Instantiated for the lengths in CSE6230_FOREACH_FIXED_LENGTH and instruction set tags isa_naive, isa_sse2, isa_avx and isa_avx512f.
+template <size_t N, typename ISA>
+void vector_add_fixed(const double *CSE6230_RESTRICT xPointer, const double *CSE6230_RESTRICT yPointer, double *CSE6230_RESTRICT sumPointer);
+
+template <size_t N, typename ISA>
+void vector_max_fixed(const double *CSE6230_RESTRICT arrayPointer, double *CSE6230_RESTRICT maxPointer);
+
+// Expands MACRO(N, ...) for every instantiated length N, with the other arguments passed through
+#define CSE6230_FOREACH_FIXED_LENGTH(MACRO, ...) \
+	MACRO(4, __VA_ARGS__) \
+	MACRO(8, __VA_ARGS__) \
+	MACRO(16, __VA_ARGS__) \
+	MACRO(32, __VA_ARGS__) \
+	MACRO(64, __VA_ARGS__) \
+	MACRO(128, __VA_ARGS__) \
+	MACRO(150, __VA_ARGS__) \
+	MACRO(256, __VA_ARGS__) \
+	MACRO(500, __VA_ARGS__)
+
+extern const size_t vector_fixed_lengths[];
+extern const size_t vector_fixed_lengths_count;
+
+typedef void (*vector_add_fixed_function)(const double*, const double*, double*);
+typedef void (*vector_max_fixed_function)(const double*, double*);
+
+// Registry of fixed-length kernels. It initially contains the instantiations for the best supported instruction set.
+// Registration is not thread-safe: register kernels before the dispatchers are called from several threads.
+// Lookups return NULL if no kernel is registered for the length. Registration replaces the kernel for the same length and
+// returns false if the registry is full (at most vector_fixed_registry_capacity lengths per kernel).
+static const size_t vector_fixed_registry_capacity = 32;
+
+extern "C" vector_add_fixed_function vector_add_fixed_lookup(size_t length);
+extern "C" vector_max_fixed_function vector_max_fixed_lookup(size_t length);
+extern "C" bool vector_add_fixed_register(size_t length, vector_add_fixed_function function);
+extern "C" bool vector_max_fixed_register(size_t length, vector_max_fixed_function function);
+
+// Dispatchers: call the registered fixed-length kernel if there is one for length, and otherwise the runtime-length
+// kernel which the registry selects for the alignment of the arrays.
+// The calls are recorded in the histograms of telemetry.hpp when telemetry is enabled.
+extern "C" void vector_add_dispatch(const double *CSE6230_RESTRICT xPointer, const double *CSE6230_RESTRICT yPointer, double *CSE6230_RESTRICT sumPointer, size_t length);
+extern "C" void vector_max_dispatch(const double *CSE6230_RESTRICT arrayPointer, double *CSE6230_RESTRICT maxPointer, size_t length);
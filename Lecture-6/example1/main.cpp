@@ -1,6 +1,36 @@
 #include <compute.hpp>
+#include <vector_array.hpp>
+#include <async.hpp>
+#include <typed.hpp>
+#include <formats.hpp>
+#include <fixed.hpp>
+#include <reduction.hpp>
+#include <reproducible.hpp>
+#include <topk.hpp>
+#include <scan.hpp>
+#include <strided.hpp>
+#include <chain.hpp>
+#include <server.hpp>
+#include <baseline.hpp>
+#include <statistics.hpp>
+#include <scaling.hpp>
+#include <stream.hpp>
+#include <registry.hpp>
+#include <telemetry.hpp>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
 #include <malloc.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <signal.h>
+#include <chrono>
+#if defined(CSE6230_SSE2_INTRINSICS_SUPPORTED)
+	#include <x86intrin.h>
+#endif
 
 inline static uint64_t get_cpu_ticks_start() {
 #ifdef __x86_64__
@@ -29,32 +59,339 @@ inline static uint64_t max(uint64_t a, uint64_t b) {
 	return a > b ? a : b;
 }
 
+static const size_t page_size = 4096;
+static const size_t cache_line_size = 64;
+
+// State of the operand arrays at the start of every repetition of a kernel:
+//   hot: whatever the previous repetition left, normally in L1 cache
+//   cold: flushed from all cache levels
+//   first-touch: pages discarded, so that the kernel takes page faults on first access and reads zero-filled pages
+enum cache_mode {
+	cache_mode_hot,
+	cache_mode_cold,
+	cache_mode_first_touch,
+	cache_mode_count
+};
+
+static const char* cache_mode_names[cache_mode_count] = {
+	"hot",
+	"cold",
+	"first-touch"
+};
+
+// Repetitions are much slower in the cold and first-touch modes, so they run fewer of them
+static const size_t cache_mode_experiments_divisor[cache_mode_count] = { 1, 100, 1000 };
+
+static cache_mode benchmark_cache_mode = cache_mode_hot;
+
+// Benchmark arrays are mapped separately and start at a page boundary after a header page with the mapping size:
+// first-touch mode discards the pages of the arrays, and must not discard other data sharing the same pages.
+static void* allocate_benchmark_array(size_t size) {
+	const size_t mapping_size = page_size + (size + page_size - 1) / page_size * page_size;
+	void* mapping = mmap(NULL, mapping_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (mapping == MAP_FAILED) {
+		return NULL;
+	}
+	*static_cast<size_t*>(mapping) = mapping_size;
+	return static_cast<char*>(mapping) + page_size;
+}
+
+static void free_benchmark_array(void* array) {
+	if (array != NULL) {
+		void* mapping = static_cast<char*>(array) - page_size;
+		munmap(mapping, *static_cast<size_t*>(mapping));
+	}
+}
+
+#ifndef CSE6230_SSE2_INTRINSICS_SUPPORTED
+// Without clflush, the cache is flushed by writing a buffer larger than the last-level cache
+static const size_t eviction_buffer_size = 64 * 1024 * 1024;
+static char* eviction_buffer = NULL;
+#endif
+
+static void flush_array(const void* array, size_t size) {
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+	const char* line = static_cast<const char*>(array) - reinterpret_cast<uintptr_t>(array) % cache_line_size;
+	for (; line < static_cast<const char*>(array) + size; line += cache_line_size) {
+		_mm_clflush(line);
+	}
+	_mm_mfence();
+#else
+	if (eviction_buffer == NULL) {
+		eviction_buffer = static_cast<char*>(malloc(eviction_buffer_size));
+	}
+	for (size_t offset = 0; offset < eviction_buffer_size; offset += cache_line_size) {
+		eviction_buffer[offset] += 1;
+	}
+#endif
+}
+
+// The array must be allocated with allocate_benchmark_array
+static void discard_array(const void* array, size_t size) {
+	const uintptr_t start = reinterpret_cast<uintptr_t>(array) / page_size * page_size;
+	const uintptr_t end = (reinterpret_cast<uintptr_t>(array) + size + page_size - 1) / page_size * page_size;
+	madvise(reinterpret_cast<void*>(start), end - start, MADV_DONTNEED);
+}
+
+// Brings an operand array into the state required by benchmark_cache_mode. Called before every repetition of a kernel.
+static void prepare_array(const void* array, size_t size) {
+	switch (benchmark_cache_mode) {
+		case cache_mode_hot:
+			break;
+		case cache_mode_cold:
+			flush_array(array, size);
+			break;
+		case cache_mode_first_touch:
+			discard_array(array, size);
+			break;
+		case cache_mode_count:
+			break;
+	}
+}
+
+// Samples of individual repetitions, for the statistics. Only the first timing loop after a report or the start of a section
+// is sampled: for rows with misalignment sweeps this is the aligned measurement, for rows with two timings the first one.
+static const size_t max_samples_count = 100000;
+static uint64_t samples[max_samples_count];
+static double samples_cpe[max_samples_count];
+static size_t samples_count = 0;
+static size_t samples_stride = 1;
+static bool samples_taken = false;
+
+// Returns true if the timing loop which calls it should record samples
+static bool start_samples(size_t experiments_count) {
+	if (samples_taken) {
+		return false;
+	}
+	samples_taken = true;
+	samples_count = 0;
+	samples_stride = experiments_count / max_samples_count + 1;
+	return true;
+}
+
+static void add_sample(bool sampling, size_t experiment_number, uint64_t ticks) {
+	if (sampling && experiment_number % samples_stride == 0 && samples_count < max_samples_count) {
+		samples[samples_count++] = ticks;
+	}
+}
+
+static const size_t max_results_count = 1024;
+static benchmark_result results[max_results_count];
+static size_t results_count = 0;
+static const char* report_section = "";
+
+static void begin_section(const char* section_name) {
+	report_section = section_name;
+	samples_taken = false;
+}
+
+// Adds statistics of the recorded samples, in cycles per element, to the results
+static void record_result(const char* method_name, size_t array_size) {
+	if (samples_count != 0 && results_count < max_results_count) {
+		for (size_t sample_number = 0; sample_number < samples_count; sample_number++) {
+			samples_cpe[sample_number] = double(samples[sample_number]) / double(array_size);
+		}
+		benchmark_result& result = results[results_count++];
+		snprintf(result.name, sizeof(result.name), "%s | %s | %s", cache_mode_names[benchmark_cache_mode], report_section, method_name);
+		result.statistics = compute_sample_statistics(samples_cpe, samples_count);
+	}
+	samples_taken = false;
+	samples_count = 0;
+}
+
+static const benchmark_result* find_result(const benchmark_result* results, size_t results_count, const char* name) {
+	for (size_t result_number = 0; result_number < results_count; result_number++) {
+		if (strcmp(results[result_number].name, name) == 0) {
+			return &results[result_number];
+		}
+	}
+	return NULL;
+}
+
+static void print_statistics(const benchmark_result* baseline_results, size_t baseline_results_count) {
+	printf("%-60s\t%8s\t%8s\t%10s\t%10s\t%10s\t%10s\t%10s\t%10s\t%s\n", "Statistics",
+		"Samples", "Outliers", "Min CPE", "P10 CPE", "Median CPE", "P90 CPE", "P99 CPE", "MAD CPE", "vs Baseline");
+	for (size_t result_number = 0; result_number < results_count; result_number++) {
+		const benchmark_result& result = results[result_number];
+		const sample_statistics& statistics = result.statistics;
+		printf("%-60s\t%8zu\t%8zu\t%10.2lf\t%10.2lf\t%10.2lf\t%10.2lf\t%10.2lf\t%10.2lf", result.name,
+			statistics.count, statistics.outliers_count,
+			statistics.min, statistics.p10, statistics.median, statistics.p90, statistics.p99, statistics.mad);
+		const benchmark_result* baseline = find_result(baseline_results, baseline_results_count, result.name);
+		if (baseline != NULL) {
+			const double speedup = baseline->statistics.median / statistics.median;
+			switch (compare_sample_statistics(baseline->statistics, statistics)) {
+				case comparison_not_significant:
+					printf("\t%.3lfx (not significant)", speedup);
+					break;
+				case comparison_speedup:
+					printf("\t%.3lfx SPEEDUP", speedup);
+					break;
+				case comparison_regression:
+					printf("\t%.3lfx REGRESSION", speedup);
+					break;
+			}
+		}
+		printf("\n");
+	}
+}
+
 static uint64_t time_vector_add(vector_add_function vector_add, const double* x_array, const double* y_array, double* sum_array, size_t array_size, size_t experiments_count) {
 	uint64_t best_ticks = uint64_t(-1);
+	const bool sampling = start_samples(experiments_count);
 	for (size_t experiment_number = 1; experiment_number <= experiments_count; experiment_number++) {
+		prepare_array(x_array, array_size * sizeof(double));
+		prepare_array(y_array, array_size * sizeof(double));
+		prepare_array(sum_array, array_size * sizeof(double));
 		const uint64_t start_ticks = get_cpu_ticks_start();
 		vector_add(x_array, y_array, sum_array, array_size);
 		const uint64_t end_ticks = get_cpu_ticks_end();
 		const uint64_t elapsed_ticks = end_ticks - start_ticks;
 		best_ticks = min(best_ticks, elapsed_ticks);
+		add_sample(sampling, experiment_number, elapsed_ticks);
+	}
+	return best_ticks;
+}
+
+static uint64_t time_vector_accumulate(vector_accumulate_function vector_accumulate, const double* x_array, double* y_array, size_t array_size, size_t experiments_count) {
+	uint64_t best_ticks = uint64_t(-1);
+	const bool sampling = start_samples(experiments_count);
+	for (size_t experiment_number = 1; experiment_number <= experiments_count; experiment_number++) {
+		prepare_array(x_array, array_size * sizeof(double));
+		prepare_array(y_array, array_size * sizeof(double));
+		const uint64_t start_ticks = get_cpu_ticks_start();
+		vector_accumulate(x_array, y_array, array_size);
+		const uint64_t end_ticks = get_cpu_ticks_end();
+		const uint64_t elapsed_ticks = end_ticks - start_ticks;
+		best_ticks = min(best_ticks, elapsed_ticks);
+		add_sample(sampling, experiment_number, elapsed_ticks);
+	}
+	return best_ticks;
+}
+
+static uint64_t time_vector_axpy(vector_axpy_function vector_axpy, double a, const double* x_array, double* y_array, size_t array_size, size_t experiments_count) {
+	uint64_t best_ticks = uint64_t(-1);
+	const bool sampling = start_samples(experiments_count);
+	for (size_t experiment_number = 1; experiment_number <= experiments_count; experiment_number++) {
+		prepare_array(x_array, array_size * sizeof(double));
+		prepare_array(y_array, array_size * sizeof(double));
+		const uint64_t start_ticks = get_cpu_ticks_start();
+		vector_axpy(a, x_array, y_array, array_size);
+		const uint64_t end_ticks = get_cpu_ticks_end();
+		const uint64_t elapsed_ticks = end_ticks - start_ticks;
+		best_ticks = min(best_ticks, elapsed_ticks);
+		add_sample(sampling, experiment_number, elapsed_ticks);
 	}
 	return best_ticks;
 }
 
 static uint64_t time_vector_max(vector_max_function vector_max, const double* elements_array, size_t array_size, size_t experiments_count) {
 	uint64_t best_ticks = uint64_t(-1);
+	const bool sampling = start_samples(experiments_count);
 	for (size_t experiment_number = 1; experiment_number <= experiments_count; experiment_number++) {
 		double max_element;
+		prepare_array(elements_array, array_size * sizeof(double));
 		const uint64_t start_ticks = get_cpu_ticks_start();
 		vector_max(elements_array, &max_element, array_size);
 		const uint64_t end_ticks = get_cpu_ticks_end();
 		const uint64_t elapsed_ticks = end_ticks - start_ticks;
 		best_ticks = min(best_ticks, elapsed_ticks);
+		add_sample(sampling, experiment_number, elapsed_ticks);
+	}
+	return best_ticks;
+}
+
+// Strides of the three columns of the strided benchmarks. Stride 0 broadcasts the first element.
+static const size_t strided_add_strides[3] = { 3, 0, 5 };
+static const size_t strided_max_strides[3] = { 1, 3, 5 };
+static const size_t max_benchmark_stride = 5;
+
+static uint64_t time_vector_add_strided(vector_add_strided_function vector_add_strided, const double* x_array, size_t x_stride, const double* y_array, double* sum_array, size_t array_size, size_t experiments_count) {
+	uint64_t best_ticks = uint64_t(-1);
+	const bool sampling = start_samples(experiments_count);
+	for (size_t experiment_number = 1; experiment_number <= experiments_count; experiment_number++) {
+		prepare_array(x_array, array_size * max(x_stride, 1) * sizeof(double));
+		prepare_array(y_array, array_size * sizeof(double));
+		prepare_array(sum_array, array_size * sizeof(double));
+		const uint64_t start_ticks = get_cpu_ticks_start();
+		vector_add_strided(x_array, x_stride, y_array, 1, sum_array, 1, array_size);
+		const uint64_t end_ticks = get_cpu_ticks_end();
+		const uint64_t elapsed_ticks = end_ticks - start_ticks;
+		best_ticks = min(best_ticks, elapsed_ticks);
+		add_sample(sampling, experiment_number, elapsed_ticks);
+	}
+	return best_ticks;
+}
+
+// The staged add copies the strided operand into a contiguous temporary array, and then calls the contiguous kernel
+static uint64_t time_vector_add_staged(vector_add_function vector_add, const double* x_array, size_t x_stride, const double* y_array, double* sum_array, double* staging_array, size_t array_size, size_t experiments_count) {
+	uint64_t best_ticks = uint64_t(-1);
+	const bool sampling = start_samples(experiments_count);
+	for (size_t experiment_number = 1; experiment_number <= experiments_count; experiment_number++) {
+		prepare_array(x_array, array_size * max(x_stride, 1) * sizeof(double));
+		prepare_array(y_array, array_size * sizeof(double));
+		prepare_array(sum_array, array_size * sizeof(double));
+		prepare_array(staging_array, array_size * sizeof(double));
+		const uint64_t start_ticks = get_cpu_ticks_start();
+		for (size_t i = 0; i < array_size; i++) {
+			staging_array[i] = x_array[i * x_stride];
+		}
+		vector_add(staging_array, y_array, sum_array, array_size);
+		const uint64_t end_ticks = get_cpu_ticks_end();
+		const uint64_t elapsed_ticks = end_ticks - start_ticks;
+		best_ticks = min(best_ticks, elapsed_ticks);
+		add_sample(sampling, experiment_number, elapsed_ticks);
+	}
+	return best_ticks;
+}
+
+static uint64_t time_vector_max_strided(vector_max_strided_function vector_max_strided, const double* elements_array, size_t stride, size_t array_size, size_t experiments_count) {
+	uint64_t best_ticks = uint64_t(-1);
+	const bool sampling = start_samples(experiments_count);
+	for (size_t experiment_number = 1; experiment_number <= experiments_count; experiment_number++) {
+		double max_element;
+		prepare_array(elements_array, array_size * stride * sizeof(double));
+		const uint64_t start_ticks = get_cpu_ticks_start();
+		vector_max_strided(elements_array, stride, &max_element, array_size);
+		const uint64_t end_ticks = get_cpu_ticks_end();
+		const uint64_t elapsed_ticks = end_ticks - start_ticks;
+		best_ticks = min(best_ticks, elapsed_ticks);
+		add_sample(sampling, experiment_number, elapsed_ticks);
+	}
+	return best_ticks;
+}
+
+static const size_t max_async_jobs_count = 64;
+
+static uint64_t time_vector_add_async(kernel_queue* queue, vector_add_function vector_add, const double* x_array, const double* y_array, double* sum_array, size_t array_size, size_t jobs_count, size_t experiments_count) {
+	kernel_future* futures[max_async_jobs_count];
+	const size_t job_size = array_size / jobs_count;
+	uint64_t best_ticks = uint64_t(-1);
+	const bool sampling = start_samples(experiments_count);
+	for (size_t experiment_number = 1; experiment_number <= experiments_count; experiment_number++) {
+		prepare_array(x_array, array_size * sizeof(double));
+		prepare_array(y_array, array_size * sizeof(double));
+		prepare_array(sum_array, array_size * sizeof(double));
+		const uint64_t start_ticks = get_cpu_ticks_start();
+		for (size_t job_number = 0; job_number < jobs_count; job_number++) {
+			const size_t job_offset = job_number * job_size;
+			const size_t job_length = (job_number + 1 == jobs_count) ? array_size - job_offset : job_size;
+			futures[job_number] = kernel_queue_submit_vector_add(queue, vector_add,
+				x_array + job_offset, y_array + job_offset, sum_array + job_offset, job_length, NULL, NULL);
+		}
+		for (size_t job_number = 0; job_number < jobs_count; job_number++) {
+			kernel_future_wait(futures[job_number]);
+		}
+		const uint64_t end_ticks = get_cpu_ticks_end();
+		const uint64_t elapsed_ticks = end_ticks - start_ticks;
+		best_ticks = min(best_ticks, elapsed_ticks);
+		add_sample(sampling, experiment_number, elapsed_ticks);
 	}
 	return best_ticks;
 }
 
 static void report_timings(const char* method_name, uint64_t aligned_ticks, uint64_t min_ticks, uint64_t max_ticks, size_t array_size) {
+	record_result(method_name, array_size);
 	printf("%30s\t%10.2lf\t%10.2lf\t%10.2lf\n", method_name,
 		double(aligned_ticks) / double(array_size),
 		double(min_ticks) / double(array_size),
@@ -82,6 +419,187 @@ static void test_vector_add(const char* method_name, vector_add_function vector_
 	report_timings(method_name, aligned_vector_add_ticks, min_vector_add_ticks, max_vector_add_ticks, array_size);
 }
 
+static void test_vector_accumulate(const char* method_name, vector_accumulate_function vector_accumulate, const double* x_array, double* y_array, size_t array_size, size_t experiments_count, size_t misalignment_bound) {
+	const uint64_t aligned_vector_accumulate_ticks = time_vector_accumulate(vector_accumulate, x_array, y_array, array_size, experiments_count);
+	uint64_t min_vector_accumulate_ticks = uint64_t(-1);
+	uint64_t max_vector_accumulate_ticks = 0;
+	for (size_t x_array_misalignment = 0; x_array_misalignment < misalignment_bound / sizeof(double); x_array_misalignment += 1) {
+		for (size_t y_array_misalignment = 0; y_array_misalignment < misalignment_bound / sizeof(double); y_array_misalignment += 1) {
+			const uint64_t vector_accumulate_ticks = time_vector_accumulate(vector_accumulate,
+				x_array + x_array_misalignment,
+				y_array + y_array_misalignment,
+				array_size, experiments_count);
+			min_vector_accumulate_ticks = min(min_vector_accumulate_ticks, vector_accumulate_ticks);
+			max_vector_accumulate_ticks = max(max_vector_accumulate_ticks, vector_accumulate_ticks);
+		}
+	}
+	report_timings(method_name, aligned_vector_accumulate_ticks, min_vector_accumulate_ticks, max_vector_accumulate_ticks, array_size);
+}
+
+static void test_vector_axpy(const char* method_name, vector_axpy_function vector_axpy, const double* x_array, double* y_array, size_t array_size, size_t experiments_count, size_t misalignment_bound) {
+	const double a = 1.0;
+	const uint64_t aligned_vector_axpy_ticks = time_vector_axpy(vector_axpy, a, x_array, y_array, array_size, experiments_count);
+	uint64_t min_vector_axpy_ticks = uint64_t(-1);
+	uint64_t max_vector_axpy_ticks = 0;
+	for (size_t x_array_misalignment = 0; x_array_misalignment < misalignment_bound / sizeof(double); x_array_misalignment += 1) {
+		for (size_t y_array_misalignment = 0; y_array_misalignment < misalignment_bound / sizeof(double); y_array_misalignment += 1) {
+			const uint64_t vector_axpy_ticks = time_vector_axpy(vector_axpy, a,
+				x_array + x_array_misalignment,
+				y_array + y_array_misalignment,
+				array_size, experiments_count);
+			min_vector_axpy_ticks = min(min_vector_axpy_ticks, vector_axpy_ticks);
+			max_vector_axpy_ticks = max(max_vector_axpy_ticks, vector_axpy_ticks);
+		}
+	}
+	report_timings(method_name, aligned_vector_axpy_ticks, min_vector_axpy_ticks, max_vector_axpy_ticks, array_size);
+}
+
+static uint64_t time_vector_scan(vector_scan_function vector_scan, size_t threads_count, const double* x_array, double* y_array, size_t array_size, size_t experiments_count, bool exclusive) {
+	uint64_t best_ticks = uint64_t(-1);
+	const bool sampling = start_samples(experiments_count);
+	for (size_t experiment_number = 1; experiment_number <= experiments_count; experiment_number++) {
+		prepare_array(x_array, array_size * sizeof(double));
+		prepare_array(y_array, array_size * sizeof(double));
+		const uint64_t start_ticks = get_cpu_ticks_start();
+		if (threads_count == 1) {
+			vector_scan(x_array, y_array, array_size);
+		} else if (exclusive) {
+			vector_exclusive_scan_parallel(vector_scan, x_array, y_array, array_size, threads_count);
+		} else {
+			vector_inclusive_scan_parallel(vector_scan, x_array, y_array, array_size, threads_count);
+		}
+		const uint64_t end_ticks = get_cpu_ticks_end();
+		const uint64_t elapsed_ticks = end_ticks - start_ticks;
+		best_ticks = min(best_ticks, elapsed_ticks);
+		add_sample(sampling, experiment_number, elapsed_ticks);
+	}
+	return best_ticks;
+}
+
+static void test_vector_scan(const char* method_name, vector_scan_function vector_scan, const double* x_array, double* y_array, size_t array_size, size_t experiments_count, size_t misalignment_bound) {
+	const uint64_t aligned_vector_scan_ticks = time_vector_scan(vector_scan, 1, x_array, y_array, array_size, experiments_count, false);
+	uint64_t min_vector_scan_ticks = uint64_t(-1);
+	uint64_t max_vector_scan_ticks = 0;
+	for (size_t x_array_misalignment = 0; x_array_misalignment < misalignment_bound / sizeof(double); x_array_misalignment += 1) {
+		for (size_t y_array_misalignment = 0; y_array_misalignment < misalignment_bound / sizeof(double); y_array_misalignment += 1) {
+			const uint64_t vector_scan_ticks = time_vector_scan(vector_scan, 1,
+				x_array + x_array_misalignment,
+				y_array + y_array_misalignment,
+				array_size, experiments_count, false);
+			min_vector_scan_ticks = min(min_vector_scan_ticks, vector_scan_ticks);
+			max_vector_scan_ticks = max(max_vector_scan_ticks, vector_scan_ticks);
+		}
+	}
+	report_timings(method_name, aligned_vector_scan_ticks, min_vector_scan_ticks, max_vector_scan_ticks, array_size);
+}
+
+// A load which follows a store to an address with the same 12 low bits within this distance may be falsely blocked by it
+static const size_t aliasing_window = 256;
+
+enum placement_cause {
+	placement_cause_aligned,
+	placement_cause_line_split,
+	placement_cause_page_split,
+	placement_cause_same_offset,
+	placement_cause_4k_aliasing,
+	placement_cause_count
+};
+
+static const char* placement_cause_names[placement_cause_count] = {
+	"Aligned",
+	"Cache line split",
+	"Page split",
+	"Same offset",
+	"4K aliasing"
+};
+
+struct placement_report {
+	size_t placements_count;
+	uint64_t best_ticks;
+	uint64_t worst_ticks;
+	size_t worst_offsets[3];
+};
+
+static placement_cause classify_placement(const size_t* load_offsets, size_t loads_count, size_t store_offset, size_t array_bytes, size_t vector_size) {
+	// Offsets are measured from the start of a page, so (store - load) modulo page size is the aliasing distance.
+	// At distance 0 each element is stored after it is loaded, and later loads are ahead of the store, so this placement is reported on its own.
+	bool same_offset = false;
+	for (size_t load_number = 0; load_number < loads_count; load_number++) {
+		const size_t aliasing_distance = (store_offset - load_offsets[load_number]) % page_size;
+		if (aliasing_distance == 0) {
+			same_offset = true;
+		} else if (aliasing_distance < aliasing_window) {
+			return placement_cause_4k_aliasing;
+		}
+	}
+	if (same_offset) {
+		return placement_cause_same_offset;
+	}
+	bool line_split = false;
+	bool page_split = false;
+	for (size_t array_number = 0; array_number <= loads_count; array_number++) {
+		const size_t offset = (array_number == loads_count) ? store_offset : load_offsets[array_number];
+		if (offset % vector_size != 0) {
+			line_split = true;
+			// A misaligned array which spans a page boundary has a vector access straddling it
+			if (offset + array_bytes > page_size) {
+				page_split = true;
+			}
+		}
+	}
+	if (page_split) {
+		return placement_cause_page_split;
+	} else if (line_split) {
+		return placement_cause_line_split;
+	} else {
+		return placement_cause_aligned;
+	}
+}
+
+static void update_placement_report(placement_report* report, uint64_t ticks, const size_t* offsets) {
+	report->placements_count += 1;
+	report->best_ticks = min(report->best_ticks, ticks);
+	if (ticks >= report->worst_ticks) {
+		report->worst_ticks = ticks;
+		report->worst_offsets[0] = offsets[0];
+		report->worst_offsets[1] = offsets[1];
+		report->worst_offsets[2] = offsets[2];
+	}
+}
+
+// Sweeps the offset of each array within a page while the other arrays stay at their allocator placements, and reports the best and the worst CPE for each cause of slowdown.
+// Buffers must be aligned on page size and have a page of padding.
+static void test_vector_add_placements(const char* method_name, vector_add_function vector_add, size_t vector_size, char* x_buffer, char* y_buffer, char* sum_buffer, size_t array_size, size_t experiments_count) {
+	placement_report reports[placement_cause_count];
+	for (size_t cause = 0; cause < placement_cause_count; cause++) {
+		reports[cause].placements_count = 0;
+		reports[cause].best_ticks = uint64_t(-1);
+		reports[cause].worst_ticks = 0;
+	}
+	for (size_t swept_array = 0; swept_array < 3; swept_array++) {
+		for (size_t swept_offset = 0; swept_offset < page_size; swept_offset += sizeof(double)) {
+			size_t offsets[3] = { vector_array_page_offset(0), vector_array_page_offset(1), vector_array_page_offset(2) };
+			offsets[swept_array] = swept_offset;
+			const uint64_t ticks = time_vector_add(vector_add,
+				(const double*)(x_buffer + offsets[0]),
+				(const double*)(y_buffer + offsets[1]),
+				(double*)(sum_buffer + offsets[2]),
+				array_size, experiments_count);
+			const placement_cause cause = classify_placement(offsets, 2, offsets[2], array_size * sizeof(double), vector_size);
+			update_placement_report(&reports[cause], ticks, offsets);
+		}
+	}
+	for (size_t cause = 0; cause < placement_cause_count; cause++) {
+		if (reports[cause].placements_count != 0) {
+			printf("%30s\t%16s\t%10zu\t%10.2lf\t%10.2lf\tx+%zu y+%zu sum+%zu\n", method_name, placement_cause_names[cause],
+				reports[cause].placements_count,
+				double(reports[cause].best_ticks) / double(array_size),
+				double(reports[cause].worst_ticks) / double(array_size),
+				reports[cause].worst_offsets[0], reports[cause].worst_offsets[1], reports[cause].worst_offsets[2]);
+		}
+	}
+}
+
 static void test_vector_max(const char* method_name, vector_max_function vector_max, const double* x_array, size_t array_size, size_t experiments_count, size_t misalignment_bound) {
 	const uint64_t aligned_vector_max_ticks = time_vector_max(vector_max, x_array, array_size, experiments_count);
 	uint64_t min_vector_max_ticks = uint64_t(-1);
@@ -96,65 +614,2048 @@ static void test_vector_max(const char* method_name, vector_max_function vector_
 	report_timings(method_name, aligned_vector_max_ticks, min_vector_max_ticks, max_vector_max_ticks, array_size);
 }
 
+static void test_vector_add_strided(const char* method_name, vector_add_strided_function vector_add_strided, const double* x_array, const double* y_array, double* sum_array, size_t array_size, size_t experiments_count) {
+	uint64_t ticks[3];
+	for (size_t column = 0; column < 3; column++) {
+		ticks[column] = time_vector_add_strided(vector_add_strided, x_array, strided_add_strides[column], y_array, sum_array, array_size, experiments_count);
+	}
+	report_timings(method_name, ticks[0], ticks[1], ticks[2], array_size);
+}
+
+static void test_vector_add_staged(const char* method_name, vector_add_function vector_add, const double* x_array, const double* y_array, double* sum_array, double* staging_array, size_t array_size, size_t experiments_count) {
+	uint64_t ticks[3];
+	for (size_t column = 0; column < 3; column++) {
+		ticks[column] = time_vector_add_staged(vector_add, x_array, strided_add_strides[column], y_array, sum_array, staging_array, array_size, experiments_count);
+	}
+	report_timings(method_name, ticks[0], ticks[1], ticks[2], array_size);
+}
+
+static void test_vector_max_strided(const char* method_name, vector_max_strided_function vector_max_strided, const double* elements_array, size_t array_size, size_t experiments_count) {
+	uint64_t ticks[3];
+	for (size_t column = 0; column < 3; column++) {
+		ticks[column] = time_vector_max_strided(vector_max_strided, elements_array, strided_max_strides[column], array_size, experiments_count);
+	}
+	report_timings(method_name, ticks[0], ticks[1], ticks[2], array_size);
+}
+
 static void report_timings(const char* method_name, uint64_t aligned_ticks, size_t array_size) {
+	record_result(method_name, array_size);
 	printf("%30s\t%10.2lf\n", method_name, double(aligned_ticks) / double(array_size));
 }
 
-int main(int argc, char** argv) {
-	size_t experiments_count = 10000000;
-	
-	size_t array_size = 500;
-	double *x_array = (double*)memalign(32, array_size * sizeof(double) + 32);
-	double *y_array = (double*)memalign(32, array_size * sizeof(double) + 32);
-	double *sum_array = (double*)memalign(32, array_size * sizeof(double) + 32);
-	
-	printf("%30s\t%10s\t%10s\t%10s\n", "Add Method", "Aligned CPE", "Min CPE", "Max CPE");
-	
-	test_vector_add("Naive", &vector_add_naive, x_array, y_array, sum_array, array_size, experiments_count, 16);
-	
-	#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
-		test_vector_add("SSE2", &vector_add_sse2, x_array, y_array, sum_array, array_size, experiments_count, 16);
+// Correctness checks run before the benchmarks. Every check compares kernels with the naive kernel of their operation
+// on inputs of several lengths, reports the mismatches on stderr and returns their number.
 
-		const uint64_t aligned_vector_add_sse2_aligned_ticks = time_vector_add(&vector_add_sse2_aligned, x_array, y_array, sum_array, array_size, experiments_count);
-		report_timings("SSE2 + aligned array", aligned_vector_add_sse2_aligned_ticks, array_size);
+// Lengths of the checks: shorter than one vector, full vectors with and without a remainder, and long arrays
+static const size_t check_lengths[] = { 1, 3, 8, 17, 64, 1001 };
+static const size_t check_lengths_count = sizeof(check_lengths) / sizeof(check_lengths[0]);
+static const size_t check_max_length = 1001;
 
-		test_vector_add("SSE2 + aligned load", &vector_add_sse2_load_aligned, x_array, y_array, sum_array, array_size, experiments_count, 16);
+// Fills the array with pseudo-random multiples of 2**-13 in [-1024, 1024) which depend only on the seed.
+// Sums and products of a few of these numbers are exact in double precision, so their order does not matter.
+static void fill_check_array(double* array, size_t length, uint32_t seed) {
+	uint32_t state = seed;
+	for (size_t index = 0; index < length; index++) {
+		state = state * 1664525u + 1013904223u;
+		array[index] = double(int32_t(state >> 8) - (1 << 23)) / 8192.0;
+	}
+}
 
-		test_vector_add("SSE2 + aligned store", &vector_add_sse2_store_aligned, x_array, y_array, sum_array, array_size, experiments_count, 16);
-	#endif
-	
-	#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
-		test_vector_add("AVX", &vector_add_avx, x_array, y_array, sum_array, array_size, experiments_count, 32);
+static void set_flag(void* context) {
+	*static_cast<bool*>(context) = true;
+}
 
-		const uint64_t aligned_vector_add_avx_aligned_ticks = time_vector_add(&vector_add_avx_aligned, x_array, y_array, sum_array, array_size, experiments_count);
-		report_timings("AVX + aligned array", aligned_vector_add_avx_aligned_ticks, array_size);
-		
-		test_vector_add("AVX + aligned load", &vector_add_avx_load_aligned, x_array, y_array, sum_array, array_size, experiments_count, 32);
-		
-		test_vector_add("AVX + aligned store", &vector_add_avx_store_aligned, x_array, y_array, sum_array, array_size, experiments_count, 32);
-	#endif
-	
-	printf("%30s\t%10s\t%10s\t%10s\n", "Max Method", "Aligned CPE", "Min CPE", "Max CPE");
+// Submits vector_add jobs of growing lengths on adjacent parts of the same arrays, which the workers may merge,
+// then vector_max on the sums, and compares the results with direct calls of the naive kernels
+static size_t check_async_queue() {
+	double *x_array = (double*)memalign(64, check_max_length * sizeof(double));
+	double *y_array = (double*)memalign(64, check_max_length * sizeof(double));
+	double *sum_array = (double*)memalign(64, check_max_length * sizeof(double));
+	double *expected_sum_array = (double*)memalign(64, check_max_length * sizeof(double));
+	fill_check_array(x_array, check_max_length, 1);
+	fill_check_array(y_array, check_max_length, 2);
+	vector_add_naive(x_array, y_array, expected_sum_array, check_max_length);
+	double expected_max;
+	vector_max_naive(expected_sum_array, &expected_max, check_max_length);
 
-	test_vector_max("Naive", &vector_max_naive, x_array, array_size, experiments_count, 16);
+	size_t mismatches_count = 0;
+	kernel_queue* queue = kernel_queue_create(2);
+	kernel_future* futures[max_async_jobs_count];
+	bool callbacks_called[max_async_jobs_count];
+	size_t jobs_count = 0;
+	for (size_t job_offset = 0; job_offset < check_max_length; jobs_count++) {
+		const size_t job_length = min(2 * jobs_count + 1, check_max_length - job_offset);
+		callbacks_called[jobs_count] = false;
+		futures[jobs_count] = kernel_queue_submit_vector_add(queue, &vector_add_naive,
+			x_array + job_offset, y_array + job_offset, sum_array + job_offset, job_length, &set_flag, &callbacks_called[jobs_count]);
+		job_offset += job_length;
+	}
+	for (size_t job_number = 0; job_number < jobs_count; job_number++) {
+		kernel_future_wait(futures[job_number]);
+		if (!callbacks_called[job_number]) {
+			fprintf(stderr, "Kernel queue: callback of job %zu was not called before its future became ready\n", job_number);
+			mismatches_count++;
+		}
+	}
+	for (size_t index = 0; index < check_max_length; index++) {
+		if (sum_array[index] != expected_sum_array[index]) {
+			fprintf(stderr, "Kernel queue: element %zu of the sum is %.17g, the naive kernel computes %.17g\n", index, sum_array[index], expected_sum_array[index]);
+			mismatches_count++;
+			break;
+		}
+	}
+	double max = 0.0;
+	kernel_future_wait(kernel_queue_submit_vector_max(queue, &vector_max_naive, sum_array, &max, check_max_length, NULL, NULL));
+	if (max != expected_max) {
+		fprintf(stderr, "Kernel queue: maximum is %.17g, the naive kernel computes %.17g\n", max, expected_max);
+		mismatches_count++;
+	}
+	kernel_queue_destroy(queue);
 
-	#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
-		test_vector_max("SSE2", &vector_max_sse2, x_array, array_size, experiments_count, 16);
+	free(x_array);
+	free(y_array);
+	free(sum_array);
+	free(expected_sum_array);
+	return mismatches_count;
+}
 
-		test_vector_max("SSE2 + aligned load", &vector_max_sse2_load_aligned, x_array, array_size, experiments_count, 16);
+// Floating-point results must agree within a few units in the last place: kernels may round differently, e.g. with FMA
+static bool nearly_equal(double value, double expected) {
+	return (value == expected) || (fabs(value - expected) <= 4.0 * DBL_EPSILON * fmax(fabs(value), fabs(expected)));
+}
 
-		test_vector_max("SSE2 + aligned load + unrolling", &vector_max_sse2_load_aligned_unrolled, x_array, array_size, experiments_count, 16);
-	#endif
+// Compares the buffers and reports the first element which differs. Returns the number of mismatches (0 or 1).
+static size_t compare_check_buffers(const char* kernel_name, size_t length, const double* buffer, const double* expected_buffer, size_t buffer_length) {
+	for (size_t index = 0; index < buffer_length; index++) {
+		if (!nearly_equal(buffer[index], expected_buffer[index])) {
+			fprintf(stderr, "%s: element %zu of the buffer for length %zu is %.17g, the naive kernel computes %.17g\n",
+				kernel_name, index, length, buffer[index], expected_buffer[index]);
+			return 1;
+		}
+	}
+	return 0;
+}
 
-	#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
-		test_vector_max("AVX", &vector_max_avx, x_array, array_size, experiments_count, 32);
+// Check buffers are aligned on 64 bytes. Kernels run on every offset (in elements) below check_max_offset which keeps the
+// alignment they require, and the buffers have check_max_offset spare elements so that overruns are detected.
+static const size_t check_max_offset = 4;
 
-		test_vector_max("AVX + aligned load", &vector_max_avx_load_aligned, x_array, array_size, experiments_count, 32);
+static bool is_check_offset_allowed(size_t offset, size_t alignment) {
+	return (offset * sizeof(double)) % alignment == 0;
+}
 
-		test_vector_max("AVX + aligned load + unrolling", &vector_max_avx_load_aligned_unrolled, x_array, array_size, experiments_count, 32);
-	#endif
+static const double check_axpy_factor = 0.75;
 
-	free(x_array);
-	free(y_array);
-	free(sum_array);	
+// Runs the in-place kernel (vector_accumulate or vector_axpy, the other one is NULL) on every check length and allowed
+// offsets of x and y, and compares the whole y buffer with the naive kernel
+static size_t check_in_place_kernel(const char* kernel_name, vector_accumulate_function vector_accumulate, vector_axpy_function vector_axpy, size_t alignment) {
+	const size_t buffer_length = check_max_length + check_max_offset;
+	double *x_buffer = (double*)memalign(64, buffer_length * sizeof(double));
+	double *y_buffer = (double*)memalign(64, buffer_length * sizeof(double));
+	double *expected_buffer = (double*)memalign(64, buffer_length * sizeof(double));
+	size_t mismatches_count = 0;
+	for (size_t length_number = 0; length_number < check_lengths_count; length_number++) {
+		const size_t length = check_lengths[length_number];
+		for (size_t x_offset = 0; x_offset < check_max_offset; x_offset++) {
+			for (size_t y_offset = 0; y_offset < check_max_offset; y_offset++) {
+				if (!is_check_offset_allowed(x_offset, alignment) || !is_check_offset_allowed(y_offset, alignment)) {
+					continue;
+				}
+				fill_check_array(x_buffer, buffer_length, 3);
+				fill_check_array(y_buffer, buffer_length, 4);
+				memcpy(expected_buffer, y_buffer, buffer_length * sizeof(double));
+				if (vector_accumulate != NULL) {
+					vector_accumulate_naive(x_buffer + x_offset, expected_buffer + y_offset, length);
+					vector_accumulate(x_buffer + x_offset, y_buffer + y_offset, length);
+				} else {
+					vector_axpy_naive(check_axpy_factor, x_buffer + x_offset, expected_buffer + y_offset, length);
+					vector_axpy(check_axpy_factor, x_buffer + x_offset, y_buffer + y_offset, length);
+				}
+				mismatches_count += compare_check_buffers(kernel_name, length, y_buffer, expected_buffer, buffer_length);
+			}
+		}
+	}
+	free(x_buffer);
+	free(y_buffer);
+	free(expected_buffer);
+	return mismatches_count;
+}
+
+// Typed kernels are checked on buffers with check_max_offset spare elements at every offset below check_max_offset,
+// so most runs have misaligned loads and stores. Every check_nan_period-th floating-point element is NaN, and every
+// check_tie_period-th element is check_tie_value, which is above the other check numbers and makes ties in the maximum.
+static const size_t check_nan_period = 13;
+static const size_t check_tie_period = 61;
+static const float check_tie_value = 1024.0f;
+
+static uint32_t next_check_bits(uint64_t* state) {
+	*state = *state * 6364136223846793005ull + 1442695040888963407ull;
+	return uint32_t(*state >> 32);
+}
+
+static float typed_check_float(uint64_t* state, size_t index) {
+	const uint32_t bits = next_check_bits(state);
+	if (index % check_nan_period == 1) {
+		return NAN;
+	} else if (index % check_tie_period == 3) {
+		return check_tie_value;
+	} else {
+		// Multiples of 2**-13 in [-1024, 1024) with 24-bit mantissas
+		return float(double(int32_t(bits >> 8) - (1 << 23)) / 8192.0);
+	}
+}
+
+// Integer elements get random bits, so that sums overflow
+template <typename T>
+static void fill_typed_check_array(T* array, size_t length, uint32_t seed) {
+	uint64_t state = seed;
+	for (size_t index = 0; index < length; index++) {
+		const uint64_t high_bits = next_check_bits(&state);
+		const uint64_t low_bits = next_check_bits(&state);
+		array[index] = T((high_bits << 32) | low_bits);
+	}
+}
+
+static void fill_typed_check_array(float* array, size_t length, uint32_t seed) {
+	uint64_t state = seed;
+	for (size_t index = 0; index < length; index++) {
+		array[index] = typed_check_float(&state, index);
+	}
+}
+
+// bfloat16 elements are check floats with the low 16 bits of the mantissa dropped
+static void fill_typed_check_array(bfloat16* array, size_t length, uint32_t seed) {
+	uint64_t state = seed;
+	for (size_t index = 0; index < length; index++) {
+		const float value = typed_check_float(&state, index);
+		uint32_t bits;
+		memcpy(&bits, &value, sizeof(bits));
+		array[index].bits = uint16_t(bits >> 16);
+	}
+}
+
+template <typename T>
+static bool is_same_check_element(T x, T y) {
+	return x == y;
+}
+
+// Kernels may produce NaN with different payloads
+static bool is_same_check_element(float x, float y) {
+	return (x == y) || ((x != x) && (y != y));
+}
+
+static bool is_same_check_element(bfloat16 x, bfloat16 y) {
+	return is_same_check_element(bfloat16_to_float(x), bfloat16_to_float(y));
+}
+
+template <typename T>
+static double check_element_value(T x) {
+	return double(x);
+}
+
+static double check_element_value(bfloat16 x) {
+	return double(bfloat16_to_float(x));
+}
+
+// Runs the typed vector_add or vector_add_saturated kernel on every check length and offset of x, y and sum, and
+// compares the whole sum buffer with the naive kernel
+template <typename T>
+static size_t check_typed_add_kernel(const char* method_name, const char* operation_name, void (*vector_add)(const T*, const T*, T*, size_t), void (*naive_vector_add)(const T*, const T*, T*, size_t)) {
+	const size_t buffer_length = check_max_length + check_max_offset;
+	T *x_buffer = (T*)memalign(64, buffer_length * sizeof(T));
+	T *y_buffer = (T*)memalign(64, buffer_length * sizeof(T));
+	T *sum_buffer = (T*)memalign(64, buffer_length * sizeof(T));
+	T *expected_buffer = (T*)memalign(64, buffer_length * sizeof(T));
+	fill_typed_check_array(x_buffer, buffer_length, 5);
+	fill_typed_check_array(y_buffer, buffer_length, 6);
+	size_t mismatches_count = 0;
+	for (size_t length_number = 0; length_number < check_lengths_count; length_number++) {
+		const size_t length = check_lengths[length_number];
+		for (size_t offset = 0; offset < check_max_offset; offset++) {
+			// x and y are shifted against sum, so their misalignments differ
+			const size_t x_offset = offset;
+			const size_t y_offset = (offset + 1) % check_max_offset;
+			fill_typed_check_array(sum_buffer, buffer_length, 7);
+			fill_typed_check_array(expected_buffer, buffer_length, 7);
+			naive_vector_add(x_buffer + x_offset, y_buffer + y_offset, expected_buffer + offset, length);
+			vector_add(x_buffer + x_offset, y_buffer + y_offset, sum_buffer + offset, length);
+			for (size_t index = 0; index < buffer_length; index++) {
+				if (!is_same_check_element(sum_buffer[index], expected_buffer[index])) {
+					fprintf(stderr, "%s %s: element %zu of the buffer for length %zu at offset %zu is %.17g, the naive kernel computes %.17g\n",
+						method_name, operation_name, index, length, offset, check_element_value(sum_buffer[index]), check_element_value(expected_buffer[index]));
+					mismatches_count++;
+					break;
+				}
+			}
+		}
+	}
+	free(x_buffer);
+	free(y_buffer);
+	free(sum_buffer);
+	free(expected_buffer);
+	return mismatches_count;
+}
+
+// Runs the typed vector_max kernel on every check length and offset, and compares the maximum with the naive kernel
+template <typename T>
+static size_t check_typed_max_kernel(const char* method_name, void (*vector_max)(const T*, T*, size_t), void (*naive_vector_max)(const T*, T*, size_t)) {
+	const size_t buffer_length = check_max_length + check_max_offset;
+	T *x_buffer = (T*)memalign(64, buffer_length * sizeof(T));
+	fill_typed_check_array(x_buffer, buffer_length, 8);
+	size_t mismatches_count = 0;
+	for (size_t length_number = 0; length_number < check_lengths_count; length_number++) {
+		const size_t length = check_lengths[length_number];
+		for (size_t offset = 0; offset < check_max_offset; offset++) {
+			T max, expected_max;
+			naive_vector_max(x_buffer + offset, &expected_max, length);
+			vector_max(x_buffer + offset, &max, length);
+			if (!is_same_check_element(max, expected_max)) {
+				fprintf(stderr, "%s vector_max: maximum for length %zu at offset %zu is %.17g, the naive kernel computes %.17g\n",
+					method_name, length, offset, check_element_value(max), check_element_value(expected_max));
+				mismatches_count++;
+			}
+		}
+	}
+	free(x_buffer);
+	return mismatches_count;
+}
+
+// Checks vector_add and vector_max of the element type and instruction set against their isa_naive versions
+template <typename T, typename ISA>
+static size_t check_typed(const char* method_name) {
+	size_t mismatches_count = 0;
+	mismatches_count += check_typed_add_kernel<T>(method_name, "vector_add", &vector_add<T, ISA>, &vector_add<T, isa_naive>);
+	mismatches_count += check_typed_max_kernel<T>(method_name, &vector_max<T, ISA>, &vector_max<T, isa_naive>);
+	return mismatches_count;
+}
+
+// Also checks vector_add_saturated, which is instantiated only for integer element types
+template <typename T, typename ISA>
+static size_t check_typed_integer(const char* method_name) {
+	size_t mismatches_count = check_typed<T, ISA>(method_name);
+	mismatches_count += check_typed_add_kernel<T>(method_name, "vector_add_saturated", &vector_add_saturated<T, ISA>, &vector_add_saturated<T, isa_naive>);
+	return mismatches_count;
+}
+
+// Finite half-precision numbers of both signs, normal and subnormal, and NaN in every check_nan_period-th element
+static uint16_t check_half(size_t index) {
+	if (index % check_nan_period == 1) {
+		return 0x7E00;
+	}
+	uint16_t bits = uint16_t((index * 2654435761u) >> 16);
+	if ((bits & 0x7C00) == 0x7C00) {
+		// Infinity or NaN: clear the high bit of the exponent
+		bits &= ~uint16_t(0x4000);
+	}
+	return bits;
+}
+
+// Mixed-precision max kernels must find the same maximum as the naive double-precision kernel on the widened elements:
+// widening is exact and keeps the order of the elements. Runs the kernel on every check length and offset.
+template <typename T>
+static size_t check_mixed_vector_max(const char* kernel_name, void (*vector_max)(const T*, double*, size_t), const T* elements_buffer, const double* widened_buffer) {
+	size_t mismatches_count = 0;
+	for (size_t length_number = 0; length_number < check_lengths_count; length_number++) {
+		const size_t length = check_lengths[length_number];
+		for (size_t offset = 0; offset < check_max_offset; offset++) {
+			double max, expected_max;
+			vector_max_naive(widened_buffer + offset, &expected_max, length);
+			vector_max(elements_buffer + offset, &max, length);
+			if (max != expected_max) {
+				fprintf(stderr, "%s: maximum for length %zu at offset %zu is %.17g, the naive kernel computes %.17g\n",
+					kernel_name, length, offset, max, expected_max);
+				mismatches_count++;
+			}
+		}
+	}
+	return mismatches_count;
+}
+
+// Checks every mixed-precision kernel against the naive kernel. Returns the number of mismatches.
+static size_t check_mixed_precision_kernels() {
+	const size_t buffer_length = check_max_length + check_max_offset;
+	uint16_t *half_buffer = (uint16_t*)memalign(64, buffer_length * sizeof(uint16_t));
+	float *float_buffer = (float*)memalign(64, buffer_length * sizeof(float));
+	double *widened_buffer = (double*)memalign(64, buffer_length * sizeof(double));
+	for (size_t index = 0; index < buffer_length; index++) {
+		half_buffer[index] = check_half(index);
+		widened_buffer[index] = half_to_double(half_buffer[index]);
+		float_buffer[index] = float(widened_buffer[index]);
+	}
+
+	// Half-precision numbers are exact in single precision, so all kernels compare with the same widened elements
+	size_t mismatches_count = 0;
+	mismatches_count += check_mixed_vector_max<float>("vector_max_f32_naive", &vector_max_f32_naive, float_buffer, widened_buffer);
+	#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+		mismatches_count += check_mixed_vector_max<float>("vector_max_f32_sse2", &vector_max_f32_sse2, float_buffer, widened_buffer);
+	#endif
+	#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+		mismatches_count += check_mixed_vector_max<float>("vector_max_f32_avx", &vector_max_f32_avx, float_buffer, widened_buffer);
+	#endif
+	mismatches_count += check_mixed_vector_max<uint16_t>("vector_max_f16_naive", &vector_max_f16_naive, half_buffer, widened_buffer);
+	#if defined(CSE6230_AVX_INTRINSICS_SUPPORTED) && defined(CSE6230_F16C_INTRINSICS_SUPPORTED)
+		mismatches_count += check_mixed_vector_max<uint16_t>("vector_max_f16_f16c", &vector_max_f16_f16c, half_buffer, widened_buffer);
+	#endif
+
+	free(half_buffer);
+	free(float_buffer);
+	free(widened_buffer);
+	return mismatches_count;
+}
+
+// Fills the array with check numbers, NaN in every check_nan_period-th element (if with_nan is true) and
+// check_tie_value in every check_tie_period-th element
+static void fill_max_check_array(double* array, size_t length, uint32_t seed, bool with_nan) {
+	fill_check_array(array, length, seed);
+	for (size_t index = 0; index < length; index++) {
+		if (with_nan && (index % check_nan_period == 1)) {
+			array[index] = NAN;
+		} else if (index % check_tie_period == 3) {
+			array[index] = check_tie_value;
+		}
+	}
+}
+
+// Compares a fixed-length or dispatched add and max with the naive kernels at every offset below check_max_offset.
+// The sum buffer is compared as a whole, so that stores past the end of the array are detected.
+static size_t check_add_max(const char* kernel_name, size_t length, vector_add_fixed_function vector_add_fixed, vector_max_fixed_function vector_max_fixed, vector_add_function vector_add, vector_max_function vector_max, bool with_nan) {
+	const size_t buffer_length = check_max_length + check_max_offset;
+	double *x_buffer = (double*)memalign(64, buffer_length * sizeof(double));
+	double *y_buffer = (double*)memalign(64, buffer_length * sizeof(double));
+	double *sum_buffer = (double*)memalign(64, buffer_length * sizeof(double));
+	double *expected_buffer = (double*)memalign(64, buffer_length * sizeof(double));
+	fill_check_array(x_buffer, buffer_length, 11);
+	fill_check_array(y_buffer, buffer_length, 12);
+	size_t mismatches_count = 0;
+	for (size_t offset = 0; offset < check_max_offset; offset++) {
+		const size_t y_offset = (offset + 1) % check_max_offset;
+		fill_check_array(sum_buffer, buffer_length, 13);
+		fill_check_array(expected_buffer, buffer_length, 13);
+		vector_add_naive(x_buffer + offset, y_buffer + y_offset, expected_buffer + offset, length);
+		if (vector_add_fixed != NULL) {
+			vector_add_fixed(x_buffer + offset, y_buffer + y_offset, sum_buffer + offset);
+		} else {
+			vector_add(x_buffer + offset, y_buffer + y_offset, sum_buffer + offset, length);
+		}
+		mismatches_count += compare_check_buffers(kernel_name, length, sum_buffer, expected_buffer, buffer_length);
+	}
+	fill_max_check_array(x_buffer, buffer_length, 14, with_nan);
+	for (size_t offset = 0; offset < check_max_offset; offset++) {
+		double max, expected_max;
+		vector_max_naive(x_buffer + offset, &expected_max, length);
+		if (vector_max_fixed != NULL) {
+			vector_max_fixed(x_buffer + offset, &max);
+		} else {
+			vector_max(x_buffer + offset, &max, length);
+		}
+		if (max != expected_max) {
+			fprintf(stderr, "%s: maximum for length %zu at offset %zu is %.17g, the naive kernel computes %.17g\n",
+				kernel_name, length, offset, max, expected_max);
+			mismatches_count++;
+		}
+	}
+	free(x_buffer);
+	free(y_buffer);
+	free(sum_buffer);
+	free(expected_buffer);
+	return mismatches_count;
+}
+
+template <size_t N, typename ISA>
+static size_t check_fixed(const char* method_name) {
+	char kernel_name[64];
+	snprintf(kernel_name, sizeof(kernel_name), "%s fixed-length kernels", method_name);
+	return check_add_max(kernel_name, N, &vector_add_fixed<N, ISA>, &vector_max_fixed<N, ISA>, NULL, NULL, true);
+}
+
+// Checks the instantiations for every length in vector_fixed_lengths
+template <typename ISA>
+static size_t check_fixed_lengths(const char* method_name) {
+	size_t mismatches_count = 0;
+	mismatches_count += check_fixed<4, ISA>(method_name);
+	mismatches_count += check_fixed<8, ISA>(method_name);
+	mismatches_count += check_fixed<16, ISA>(method_name);
+	mismatches_count += check_fixed<32, ISA>(method_name);
+	mismatches_count += check_fixed<64, ISA>(method_name);
+	mismatches_count += check_fixed<128, ISA>(method_name);
+	mismatches_count += check_fixed<150, ISA>(method_name);
+	mismatches_count += check_fixed<256, ISA>(method_name);
+	mismatches_count += check_fixed<500, ISA>(method_name);
+	return mismatches_count;
+}
+
+// Checks the dispatchers on the check lengths, which use the runtime-length kernels, and on the registered lengths.
+// The runtime-length max kernels do not skip NaN elements as the naive kernel does, so the inputs have no NaN.
+static size_t check_dispatch() {
+	size_t mismatches_count = 0;
+	for (size_t length_number = 0; length_number < check_lengths_count; length_number++) {
+		mismatches_count += check_add_max("Dispatch", check_lengths[length_number], NULL, NULL, &vector_add_dispatch, &vector_max_dispatch, false);
+	}
+	for (size_t length_number = 0; length_number < vector_fixed_lengths_count; length_number++) {
+		mismatches_count += check_add_max("Dispatch", vector_fixed_lengths[length_number], NULL, NULL, &vector_add_dispatch, &vector_max_dispatch, false);
+	}
+	return mismatches_count;
+}
+
+// Checks one way of writing the baseline kernels on every check length
+static size_t check_baseline(const char* method_name, vector_add_function vector_add, vector_accumulate_function vector_accumulate, vector_axpy_function vector_axpy, vector_max_function vector_max) {
+	char kernel_name[64];
+	snprintf(kernel_name, sizeof(kernel_name), "%s baseline kernels", method_name);
+	size_t mismatches_count = 0;
+	for (size_t length_number = 0; length_number < check_lengths_count; length_number++) {
+		mismatches_count += check_add_max(kernel_name, check_lengths[length_number], NULL, NULL, vector_add, vector_max, true);
+	}
+	mismatches_count += check_in_place_kernel(kernel_name, vector_accumulate, NULL, sizeof(double));
+	mismatches_count += check_in_place_kernel(kernel_name, NULL, vector_axpy, sizeof(double));
+	return mismatches_count;
+}
+
+// Reports a reduction result which differs from the expected one. Returns the number of mismatches (0 or 1).
+static size_t compare_reduction_result(const char* method_name, const char* reduction_name, size_t length, size_t offset, double value, double expected) {
+	if (value == expected) {
+		return 0;
+	}
+	fprintf(stderr, "%s %s: the result for length %zu at offset %zu is %.17g, a scalar loop computes %.17g\n",
+		method_name, reduction_name, length, offset, value, expected);
+	return 1;
+}
+
+// Runs the reduction updates of one instruction set on every check length and offset. The array is split into a
+// piece at its start, a piece in the middle and a piece in a second state, which is merged into the first one.
+// The check numbers are multiples of 1/8192 below 1024 in magnitude, so the sums are exact in every order, and every
+// check_tie_period-th element ties for the maximum, so argmax must return the first of them.
+static size_t check_reductions(const char* method_name, reduction_update_function max_update, reduction_update_function min_update, reduction_update_function argmax_update, reduction_update_function sum_update) {
+	double *buffer = (double*)memalign(64, (check_max_length + check_max_offset) * sizeof(double));
+	fill_max_check_array(buffer, check_max_length + check_max_offset, 11, false);
+	size_t mismatches_count = 0;
+	for (size_t length_number = 0; length_number < check_lengths_count; length_number++) {
+		const size_t length = check_lengths[length_number];
+		const size_t first_split = length / 3;
+		const size_t second_split = 2 * length / 3;
+		for (size_t offset = 0; offset < check_max_offset; offset++) {
+			const double* array = buffer + offset;
+			double expected_max = -INFINITY;
+			double expected_min = INFINITY;
+			size_t expected_argmax = 0;
+			double expected_sum = 0.0;
+			for (size_t index = 0; index < length; index++) {
+				if (array[index] > expected_max) {
+					expected_max = array[index];
+					expected_argmax = index;
+				}
+				expected_min = fmin(expected_min, array[index]);
+				expected_sum += array[index];
+			}
+
+			reduction_state state, other_state;
+			reduction_max_init(&state);
+			reduction_max_init(&other_state);
+			max_update(&state, array, first_split);
+			max_update(&state, array + first_split, second_split - first_split);
+			max_update(&other_state, array + second_split, length - second_split);
+			reduction_max_merge(&state, &other_state);
+			mismatches_count += compare_reduction_result(method_name, "reduction_max", length, offset, reduction_max_finalize(&state), expected_max);
+
+			reduction_min_init(&state);
+			reduction_min_init(&other_state);
+			min_update(&state, array, first_split);
+			min_update(&state, array + first_split, second_split - first_split);
+			min_update(&other_state, array + second_split, length - second_split);
+			reduction_min_merge(&state, &other_state);
+			mismatches_count += compare_reduction_result(method_name, "reduction_min", length, offset, reduction_min_finalize(&state), expected_min);
+
+			reduction_argmax_init(&state);
+			reduction_argmax_init(&other_state);
+			argmax_update(&state, array, first_split);
+			argmax_update(&state, array + first_split, second_split - first_split);
+			argmax_update(&other_state, array + second_split, length - second_split);
+			reduction_argmax_merge(&state, &other_state);
+			double argmax_value;
+			const size_t argmax = reduction_argmax_finalize(&state, &argmax_value);
+			mismatches_count += compare_reduction_result(method_name, "reduction_argmax", length, offset, double(argmax), double(expected_argmax));
+			mismatches_count += compare_reduction_result(method_name, "reduction_argmax maximum", length, offset, argmax_value, expected_max);
+
+			reduction_sum_init(&state);
+			reduction_sum_init(&other_state);
+			sum_update(&state, array, first_split);
+			sum_update(&state, array + first_split, second_split - first_split);
+			sum_update(&other_state, array + second_split, length - second_split);
+			reduction_sum_merge(&state, &other_state);
+			mismatches_count += compare_reduction_result(method_name, "reduction_sum", length, offset, reduction_sum_finalize(&state), expected_sum);
+		}
+	}
+	free(buffer);
+	return mismatches_count;
+}
+
+// Lengths of the reproducible sum checks: within the first block, around the block boundary and over several blocks
+static const size_t check_reproducible_lengths[] = { 1, 7, 9, 1023, 1025, 4100 };
+static const size_t check_reproducible_lengths_count = sizeof(check_reproducible_lengths) / sizeof(check_reproducible_lengths[0]);
+static const size_t check_max_reproducible_length = 4100;
+
+// Checks a reproducible sum on every reproducible check length and offset. On the check numbers the sum is exact,
+// so it must equal a scalar loop. On the check numbers divided by 3 the additions round, and the result must be
+// bitwise identical to the naive version, both serial and split among 2 and 3 threads.
+static size_t check_reproducible_sum(const char* method_name, reproducible_sum_function sum) {
+	const size_t buffer_length = check_max_reproducible_length + check_max_offset;
+	double *exact_buffer = (double*)memalign(64, buffer_length * sizeof(double));
+	double *rounded_buffer = (double*)memalign(64, buffer_length * sizeof(double));
+	fill_check_array(exact_buffer, buffer_length, 12);
+	for (size_t index = 0; index < buffer_length; index++) {
+		rounded_buffer[index] = exact_buffer[index] / 3.0;
+	}
+	size_t mismatches_count = 0;
+	for (size_t length_number = 0; length_number < check_reproducible_lengths_count; length_number++) {
+		const size_t length = check_reproducible_lengths[length_number];
+		for (size_t offset = 0; offset < check_max_offset; offset++) {
+			double expected_sum = 0.0;
+			for (size_t index = 0; index < length; index++) {
+				expected_sum += exact_buffer[offset + index];
+			}
+			mismatches_count += compare_reduction_result(method_name, "reproducible_sum", length, offset, sum(exact_buffer + offset, length), expected_sum);
+
+			const double naive_sum = reproducible_sum_naive(rounded_buffer + offset, length);
+			const double rounded_sum = sum(rounded_buffer + offset, length);
+			const double two_threads_sum = reproducible_sum_parallel(sum, rounded_buffer + offset, length, 2);
+			const double three_threads_sum = reproducible_sum_parallel(sum, rounded_buffer + offset, length, 3);
+			if ((rounded_sum != naive_sum) || (two_threads_sum != naive_sum) || (three_threads_sum != naive_sum)) {
+				fprintf(stderr, "%s reproducible_sum: the sums for length %zu at offset %zu are %.17g, %.17g on 2 threads and %.17g on 3 threads, the naive version computes %.17g\n",
+					method_name, length, offset, rounded_sum, two_threads_sum, three_threads_sum, naive_sum);
+				mismatches_count++;
+			}
+		}
+	}
+	free(exact_buffer);
+	free(rounded_buffer);
+	return mismatches_count;
+}
+
+// Values of k in the top-k checks: a single element, counts which are not multiples of the SIMD width, and the maximum
+static const size_t check_topk_ks[] = { 1, 3, 8, 64 };
+static const size_t check_topk_ks_count = sizeof(check_topk_ks) / sizeof(check_topk_ks[0]);
+
+// Selects the top k of the array with repeated scans: every step takes the largest element after the previous one
+// in the order of the results (larger values first, then smaller indices). Returns the number of results.
+static size_t select_check_topk(const double* array, size_t length, size_t k, double* values, size_t* indices) {
+	const size_t count = (k < length) ? k : length;
+	for (size_t result = 0; result < count; result++) {
+		size_t best_index = length;
+		for (size_t index = 0; index < length; index++) {
+			// Elements before the previous result in the order were selected already
+			if (result != 0) {
+				const double previous = values[result - 1];
+				if ((array[index] > previous) || ((array[index] == previous) && (index <= indices[result - 1]))) {
+					continue;
+				}
+			}
+			if ((best_index == length) || (array[index] > array[best_index])) {
+				best_index = index;
+			}
+		}
+		values[result] = array[best_index];
+		indices[result] = best_index;
+	}
+	return count;
+}
+
+// Checks a top-k kernel on every check length, offset and k, directly and through vector_topk_parallel on 3 threads.
+// The first input has a few ties at the top, the second one has 8 distinct values,
+// so most elements tie with the smallest selected value and the order of the indices matters.
+static size_t check_topk(const char* method_name, vector_topk_function topk) {
+	const size_t buffer_length = check_max_length + check_max_offset;
+	double *tie_buffer = (double*)memalign(64, buffer_length * sizeof(double));
+	double *level_buffer = (double*)memalign(64, buffer_length * sizeof(double));
+	fill_max_check_array(tie_buffer, buffer_length, 13, false);
+	fill_check_array(level_buffer, buffer_length, 14);
+	for (size_t index = 0; index < buffer_length; index++) {
+		level_buffer[index] = floor(level_buffer[index] / 256.0);
+	}
+	const double* buffers[2] = { tie_buffer, level_buffer };
+	size_t mismatches_count = 0;
+	for (size_t buffer_number = 0; buffer_number < 2; buffer_number++) {
+		for (size_t threads_count = 1; threads_count <= 3; threads_count += 2) {
+			for (size_t length_number = 0; length_number < check_lengths_count; length_number++) {
+				const size_t length = check_lengths[length_number];
+				for (size_t offset = 0; offset < check_max_offset; offset++) {
+					const double* array = buffers[buffer_number] + offset;
+					for (size_t k_number = 0; k_number < check_topk_ks_count; k_number++) {
+						const size_t k = check_topk_ks[k_number];
+						double values[vector_topk_max_k], expected_values[vector_topk_max_k];
+						size_t indices[vector_topk_max_k], expected_indices[vector_topk_max_k];
+						const size_t expected_count = select_check_topk(array, length, k, expected_values, expected_indices);
+						const size_t count = (threads_count == 1) ?
+							topk(array, length, k, values, indices) :
+							vector_topk_parallel(topk, array, length, k, values, indices, threads_count);
+						size_t result = 0;
+						if (count == expected_count) {
+							while ((result < count) && (values[result] == expected_values[result]) && (indices[result] == expected_indices[result])) {
+								result++;
+							}
+						}
+						if ((count != expected_count) || (result != count)) {
+							fprintf(stderr, "%s top-k on %zu threads: k = %zu for length %zu at offset %zu returns %zu results, the first wrong one is %zu; %zu results are expected\n",
+								method_name, threads_count, k, length, offset, count, result, expected_count);
+							mismatches_count++;
+						}
+					}
+				}
+			}
+		}
+	}
+	free(tie_buffer);
+	free(level_buffer);
+	return mismatches_count;
+}
+
+// Runs the scan kernel on every check length and allowed offsets of x and y, directly (threads_count = 1) or through
+// the parallel block scan, and compares the whole y buffer with the naive scan. The prefix sums of the check numbers
+// are exact, so the order of the additions does not matter.
+static size_t check_scan(const char* kernel_name, vector_scan_function scan, bool exclusive, size_t threads_count, size_t alignment) {
+	const size_t buffer_length = check_max_length + check_max_offset;
+	double *x_buffer = (double*)memalign(64, buffer_length * sizeof(double));
+	double *y_buffer = (double*)memalign(64, buffer_length * sizeof(double));
+	double *expected_buffer = (double*)memalign(64, buffer_length * sizeof(double));
+	fill_check_array(x_buffer, buffer_length, 15);
+	size_t mismatches_count = 0;
+	for (size_t length_number = 0; length_number < check_lengths_count; length_number++) {
+		const size_t length = check_lengths[length_number];
+		for (size_t x_offset = 0; x_offset < check_max_offset; x_offset++) {
+			for (size_t y_offset = 0; y_offset < check_max_offset; y_offset++) {
+				if (!is_check_offset_allowed(x_offset, alignment) || !is_check_offset_allowed(y_offset, alignment)) {
+					continue;
+				}
+				fill_check_array(y_buffer, buffer_length, 16);
+				memcpy(expected_buffer, y_buffer, buffer_length * sizeof(double));
+				if (exclusive) {
+					vector_exclusive_scan_naive(x_buffer + x_offset, expected_buffer + y_offset, length);
+				} else {
+					vector_inclusive_scan_naive(x_buffer + x_offset, expected_buffer + y_offset, length);
+				}
+				if (threads_count == 1) {
+					scan(x_buffer + x_offset, y_buffer + y_offset, length);
+				} else if (exclusive) {
+					vector_exclusive_scan_parallel(scan, x_buffer + x_offset, y_buffer + y_offset, length, threads_count);
+				} else {
+					vector_inclusive_scan_parallel(scan, x_buffer + x_offset, y_buffer + y_offset, length, threads_count);
+				}
+				mismatches_count += compare_check_buffers(kernel_name, length, y_buffer, expected_buffer, buffer_length);
+			}
+		}
+	}
+	free(x_buffer);
+	free(y_buffer);
+	free(expected_buffer);
+	return mismatches_count;
+}
+
+// Strides of the strided checks: broadcast, contiguous, the stride-3 path and gathers. Outputs must not have stride 0.
+static const size_t check_strides[] = { 0, 1, 2, 3, 5 };
+static const size_t check_strides_count = sizeof(check_strides) / sizeof(check_strides[0]);
+static const size_t check_max_stride = 5;
+
+// Checks the strided add and max kernels on every check length, combination of strides and offset against the naive
+// kernels. Whole buffers are compared, so elements between the strided outputs must keep their values. The max inputs
+// include NaNs and ties.
+static size_t check_strided(const char* method_name, vector_add_strided_function vector_add_strided, vector_max_strided_function vector_max_strided) {
+	const size_t buffer_length = check_max_length * check_max_stride + check_max_offset;
+	double *x_buffer = (double*)memalign(64, buffer_length * sizeof(double));
+	double *y_buffer = (double*)memalign(64, buffer_length * sizeof(double));
+	double *sum_buffer = (double*)memalign(64, buffer_length * sizeof(double));
+	double *expected_buffer = (double*)memalign(64, buffer_length * sizeof(double));
+	double *max_buffer = (double*)memalign(64, buffer_length * sizeof(double));
+	fill_check_array(x_buffer, buffer_length, 17);
+	fill_check_array(y_buffer, buffer_length, 18);
+	fill_max_check_array(max_buffer, buffer_length, 19, true);
+	char kernel_name[128];
+	size_t mismatches_count = 0;
+	for (size_t length_number = 0; length_number < check_lengths_count; length_number++) {
+		const size_t length = check_lengths[length_number];
+		for (size_t offset = 0; offset < check_max_offset; offset++) {
+			const double* x = x_buffer + offset;
+			const double* y = y_buffer + (offset + 1) % check_max_offset;
+			const size_t sum_offset = (offset + 2) % check_max_offset;
+			for (size_t x_number = 0; x_number < check_strides_count; x_number++) {
+				const size_t x_stride = check_strides[x_number];
+				for (size_t y_number = 0; y_number < check_strides_count; y_number++) {
+					const size_t y_stride = check_strides[y_number];
+					for (size_t sum_number = 0; sum_number < check_strides_count; sum_number++) {
+						const size_t sum_stride = check_strides[sum_number];
+						if (sum_stride == 0) {
+							continue;
+						}
+						fill_check_array(sum_buffer, buffer_length, 20);
+						memcpy(expected_buffer, sum_buffer, buffer_length * sizeof(double));
+						vector_add_strided_naive(x, x_stride, y, y_stride, expected_buffer + sum_offset, sum_stride, length);
+						vector_add_strided(x, x_stride, y, y_stride, sum_buffer + sum_offset, sum_stride, length);
+						snprintf(kernel_name, sizeof(kernel_name), "%s strided add with strides %zu, %zu and %zu at offset %zu",
+							method_name, x_stride, y_stride, sum_stride, offset);
+						mismatches_count += compare_check_buffers(kernel_name, length, sum_buffer, expected_buffer, buffer_length);
+					}
+				}
+
+				double max, expected_max;
+				vector_max_strided_naive(max_buffer + offset, x_stride, &expected_max, length);
+				vector_max_strided(max_buffer + offset, x_stride, &max, length);
+				if (max != expected_max) {
+					fprintf(stderr, "%s strided max: stride %zu for length %zu at offset %zu is %.17g, the naive kernel computes %.17g\n",
+						method_name, x_stride, length, offset, max, expected_max);
+					mismatches_count++;
+				}
+			}
+		}
+	}
+	free(x_buffer);
+	free(y_buffer);
+	free(sum_buffer);
+	free(expected_buffer);
+	free(max_buffer);
+	return mismatches_count;
+}
+
+// Tile lengths of the chain checks: the automatic length, with a single tile for the check lengths, and the minimum,
+// with many tiles for the threads of the pool to steal
+static const size_t check_chain_tile_lengths[] = { 0, 64 };
+static const size_t check_chain_tile_lengths_count = sizeof(check_chain_tile_lengths) / sizeof(check_chain_tile_lengths[0]);
+
+// Runs max((x + y) + w) as a kernel chain on every check length, tile length and offset of the arrays, on the calling
+// thread and on a pool of 3 threads, and compares the result and the output array (x + y) + w with the kernels run one
+// after another over the whole arrays. Each run is a full round trip: the run is submitted to the pool and waited for.
+static size_t check_chain(const char* method_name, vector_add_function vector_add, vector_accumulate_function vector_accumulate, vector_max_function vector_max) {
+	chain_pool* pool = chain_pool_create(3);
+	if (pool == NULL) {
+		fprintf(stderr, "%s chain: failed to create a pool of 3 threads\n", method_name);
+		return 1;
+	}
+	const size_t buffer_length = check_max_length + check_max_offset;
+	double *x_buffer = (double*)memalign(64, buffer_length * sizeof(double));
+	double *y_buffer = (double*)memalign(64, buffer_length * sizeof(double));
+	double *w_buffer = (double*)memalign(64, buffer_length * sizeof(double));
+	double *sum_buffer = (double*)memalign(64, buffer_length * sizeof(double));
+	double *expected_buffer = (double*)memalign(64, buffer_length * sizeof(double));
+	fill_check_array(x_buffer, buffer_length, 21);
+	fill_check_array(y_buffer, buffer_length, 22);
+	fill_check_array(w_buffer, buffer_length, 23);
+	size_t mismatches_count = 0;
+	for (size_t length_number = 0; length_number < check_lengths_count; length_number++) {
+		const size_t length = check_lengths[length_number];
+		for (size_t offset = 0; offset < check_max_offset; offset++) {
+			const double* x = x_buffer + offset;
+			const double* y = y_buffer + (offset + 1) % check_max_offset;
+			const double* w = w_buffer + (offset + 2) % check_max_offset;
+			const size_t sum_offset = (offset + 3) % check_max_offset;
+			fill_check_array(expected_buffer, buffer_length, 24);
+			double expected_max;
+			vector_add(x, y, expected_buffer + sum_offset, length);
+			vector_accumulate(w, expected_buffer + sum_offset, length);
+			vector_max(expected_buffer + sum_offset, &expected_max, length);
+			for (size_t tile_number = 0; tile_number < check_chain_tile_lengths_count; tile_number++) {
+				for (size_t pool_number = 0; pool_number < 2; pool_number++) {
+					fill_check_array(sum_buffer, buffer_length, 24);
+					double max = 0.0;
+					bool succeeded = false;
+					kernel_chain* chain = kernel_chain_create(length);
+					if (chain != NULL) {
+						kernel_chain_set_tile_length(chain, check_chain_tile_lengths[tile_number]);
+						const chain_array sum = kernel_chain_output(chain, sum_buffer + sum_offset);
+						succeeded = kernel_chain_map(chain, vector_add, kernel_chain_input(chain, x, 1), kernel_chain_input(chain, y, 1), sum) &&
+							kernel_chain_accumulate(chain, vector_accumulate, kernel_chain_input(chain, w, 1), sum) &&
+							kernel_chain_max(chain, vector_max, sum, &max) &&
+							kernel_chain_run(chain, (pool_number == 0) ? NULL : pool);
+						kernel_chain_destroy(chain);
+					}
+					char kernel_name[128];
+					snprintf(kernel_name, sizeof(kernel_name), "%s chain with tile length %zu on %s at offset %zu",
+						method_name, check_chain_tile_lengths[tile_number], (pool_number == 0) ? "1 thread" : "a pool of 3 threads", offset);
+					if (!succeeded || (max != expected_max)) {
+						fprintf(stderr, "%s: the maximum for length %zu is %.17g, the kernels compute %.17g\n",
+							kernel_name, length, succeeded ? max : NAN, expected_max);
+						mismatches_count++;
+					}
+					mismatches_count += compare_check_buffers(kernel_name, length, sum_buffer, expected_buffer, buffer_length);
+				}
+			}
+		}
+	}
+	chain_pool_destroy(pool);
+	free(x_buffer);
+	free(y_buffer);
+	free(w_buffer);
+	free(sum_buffer);
+	free(expected_buffer);
+	return mismatches_count;
+}
+
+// Starts a kernel server with 2 workers and the specified kernels, attaches it as a client of the same process, and
+// posts a vector_add and a vector_max job for every check length and offset of the operands in the arena. Each job is
+// a full round trip: it is posted to the ring and waited for. The results are compared with the naive kernels.
+// Also checks that a job with an operand outside of the arena is not posted.
+static size_t check_server(const char* method_name, vector_add_function vector_add, vector_max_function vector_max) {
+	char server_name[64];
+	snprintf(server_name, sizeof(server_name), "/cse6230-check-%d", int(getpid()));
+	const size_t buffer_length = check_max_length + check_max_offset;
+	const size_t arena_size = 4 * (buffer_length + 64) * sizeof(double);
+	kernel_server* server = kernel_server_create(server_name, arena_size, 2, vector_add, vector_max);
+	kernel_client* client = (server != NULL) ? kernel_client_connect(server_name) : NULL;
+	double* x_buffer = (client != NULL) ? kernel_client_allocate(client, buffer_length) : NULL;
+	double* y_buffer = (client != NULL) ? kernel_client_allocate(client, buffer_length) : NULL;
+	double* sum_buffer = (client != NULL) ? kernel_client_allocate(client, buffer_length) : NULL;
+	double* max_pointer = (client != NULL) ? kernel_client_allocate(client, 1) : NULL;
+	kernel_server_job* job = (client != NULL) ? kernel_client_create_job(client) : NULL;
+	if ((x_buffer == NULL) || (y_buffer == NULL) || (sum_buffer == NULL) || (max_pointer == NULL) || (job == NULL)) {
+		fprintf(stderr, "%s server: failed to start the server or to allocate the operands\n", method_name);
+		kernel_client_disconnect(client);
+		kernel_server_destroy(server);
+		return 1;
+	}
+	double *expected_buffer = (double*)memalign(64, buffer_length * sizeof(double));
+	fill_check_array(x_buffer, buffer_length, 25);
+	fill_max_check_array(y_buffer, buffer_length, 26, false);
+	size_t mismatches_count = 0;
+	for (size_t length_number = 0; length_number < check_lengths_count; length_number++) {
+		const size_t length = check_lengths[length_number];
+		for (size_t offset = 0; offset < check_max_offset; offset++) {
+			const double* x = x_buffer + offset;
+			const double* y = y_buffer + (offset + 1) % check_max_offset;
+			const size_t sum_offset = (offset + 2) % check_max_offset;
+			fill_check_array(sum_buffer, buffer_length, 27);
+			memcpy(expected_buffer, sum_buffer, buffer_length * sizeof(double));
+			vector_add_naive(x, y, expected_buffer + sum_offset, length);
+			double expected_max;
+			vector_max_naive(expected_buffer + sum_offset, &expected_max, length);
+
+			char kernel_name[128];
+			snprintf(kernel_name, sizeof(kernel_name), "%s server vector_add at offset %zu", method_name, offset);
+			if (!kernel_client_post_vector_add(client, job, x, y, sum_buffer + sum_offset, length) || !kernel_server_job_wait(job)) {
+				fprintf(stderr, "%s: the job for length %zu failed\n", kernel_name, length);
+				mismatches_count++;
+				continue;
+			}
+			mismatches_count += compare_check_buffers(kernel_name, length, sum_buffer, expected_buffer, buffer_length);
+
+			*max_pointer = 0.0;
+			const bool max_succeeded = kernel_client_post_vector_max(client, job, sum_buffer + sum_offset, max_pointer, length) && kernel_server_job_wait(job);
+			if (!max_succeeded || (*max_pointer != expected_max)) {
+				fprintf(stderr, "%s server vector_max: length %zu at offset %zu is %.17g, the naive kernel computes %.17g\n",
+					method_name, length, offset, max_succeeded ? *max_pointer : NAN, expected_max);
+				mismatches_count++;
+			}
+		}
+	}
+	// Operands must be in the arena, where the workers can address them
+	if (kernel_client_post_vector_add(client, job, expected_buffer, y_buffer, sum_buffer, 1)) {
+		fprintf(stderr, "%s server: a job with an operand outside of the arena is posted\n", method_name);
+		kernel_server_job_wait(job);
+		mismatches_count++;
+	}
+	free(expected_buffer);
+	kernel_client_disconnect(client);
+	kernel_server_destroy(server);
+	return mismatches_count;
+}
+
+// Every kernel in the registry must be found by its name, and have names for its operation and instruction set
+static size_t check_registry() {
+	size_t mismatches_count = 0;
+	for (size_t index = 0; index < kernel_registry_count(); index++) {
+		const kernel_info* kernel = kernel_registry_get(index);
+		if ((kernel_registry_find(kernel->name) != kernel) || (kernel_registry_operation_name(kernel->operation) == NULL) || (kernel_registry_isa_name(kernel->isa) == NULL)) {
+			fprintf(stderr, "Registry entry %zu (%s) is not found by its name or has an unknown operation or instruction set\n", index, kernel->name);
+			mismatches_count += 1;
+		}
+	}
+	return mismatches_count;
+}
+
+// Runs all correctness checks. Returns the number of mismatches.
+static size_t check_kernels() {
+	size_t mismatches_count = 0;
+	mismatches_count += check_registry();
+	mismatches_count += check_async_queue();
+	#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+		mismatches_count += check_in_place_kernel("vector_accumulate_sse2", &vector_accumulate_sse2, NULL, sizeof(double));
+		mismatches_count += check_in_place_kernel("vector_accumulate_sse2_aligned", &vector_accumulate_sse2_aligned, NULL, 16);
+		mismatches_count += check_in_place_kernel("vector_accumulate_sse2_load_aligned", &vector_accumulate_sse2_load_aligned, NULL, sizeof(double));
+		mismatches_count += check_in_place_kernel("vector_accumulate_sse2_store_aligned", &vector_accumulate_sse2_store_aligned, NULL, sizeof(double));
+		mismatches_count += check_in_place_kernel("vector_axpy_sse2", NULL, &vector_axpy_sse2, sizeof(double));
+		mismatches_count += check_in_place_kernel("vector_axpy_sse2_aligned", NULL, &vector_axpy_sse2_aligned, 16);
+		mismatches_count += check_in_place_kernel("vector_axpy_sse2_load_aligned", NULL, &vector_axpy_sse2_load_aligned, sizeof(double));
+		mismatches_count += check_in_place_kernel("vector_axpy_sse2_store_aligned", NULL, &vector_axpy_sse2_store_aligned, sizeof(double));
+	#endif
+	#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+		mismatches_count += check_in_place_kernel("vector_accumulate_avx", &vector_accumulate_avx, NULL, sizeof(double));
+		mismatches_count += check_in_place_kernel("vector_accumulate_avx_aligned", &vector_accumulate_avx_aligned, NULL, 32);
+		mismatches_count += check_in_place_kernel("vector_accumulate_avx_load_aligned", &vector_accumulate_avx_load_aligned, NULL, sizeof(double));
+		mismatches_count += check_in_place_kernel("vector_accumulate_avx_store_aligned", &vector_accumulate_avx_store_aligned, NULL, sizeof(double));
+		mismatches_count += check_in_place_kernel("vector_axpy_avx", NULL, &vector_axpy_avx, sizeof(double));
+		mismatches_count += check_in_place_kernel("vector_axpy_avx_aligned", NULL, &vector_axpy_avx_aligned, 32);
+		mismatches_count += check_in_place_kernel("vector_axpy_avx_load_aligned", NULL, &vector_axpy_avx_load_aligned, sizeof(double));
+		mismatches_count += check_in_place_kernel("vector_axpy_avx_store_aligned", NULL, &vector_axpy_avx_store_aligned, sizeof(double));
+	#endif
+	#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+		mismatches_count += check_typed<float, isa_sse2>("float + SSE2");
+		mismatches_count += check_typed<bfloat16, isa_sse2>("bfloat16 + SSE2");
+		mismatches_count += check_typed_integer<int32_t, isa_sse2>("int32 + SSE2");
+		mismatches_count += check_typed_integer<uint32_t, isa_sse2>("uint32 + SSE2");
+		mismatches_count += check_typed_integer<int64_t, isa_sse2>("int64 + SSE2");
+		mismatches_count += check_typed_integer<uint64_t, isa_sse2>("uint64 + SSE2");
+	#endif
+	#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+		mismatches_count += check_typed<float, isa_avx>("float + AVX");
+		mismatches_count += check_typed<bfloat16, isa_avx>("bfloat16 + AVX");
+	#endif
+	#ifdef CSE6230_AVX2_INTRINSICS_SUPPORTED
+		mismatches_count += check_typed<float, isa_avx2>("float + AVX2");
+		mismatches_count += check_typed<bfloat16, isa_avx2>("bfloat16 + AVX2");
+		mismatches_count += check_typed_integer<int32_t, isa_avx2>("int32 + AVX2");
+		mismatches_count += check_typed_integer<uint32_t, isa_avx2>("uint32 + AVX2");
+		mismatches_count += check_typed_integer<int64_t, isa_avx2>("int64 + AVX2");
+		mismatches_count += check_typed_integer<uint64_t, isa_avx2>("uint64 + AVX2");
+	#endif
+	#ifdef CSE6230_AVX512F_INTRINSICS_SUPPORTED
+		mismatches_count += check_typed<float, isa_avx512f>("float + AVX-512");
+		mismatches_count += check_typed<bfloat16, isa_avx512f>("bfloat16 + AVX-512");
+		mismatches_count += check_typed_integer<int32_t, isa_avx512f>("int32 + AVX-512");
+		mismatches_count += check_typed_integer<uint32_t, isa_avx512f>("uint32 + AVX-512");
+		mismatches_count += check_typed_integer<int64_t, isa_avx512f>("int64 + AVX-512");
+		mismatches_count += check_typed_integer<uint64_t, isa_avx512f>("uint64 + AVX-512");
+	#endif
+	mismatches_count += check_mixed_precision_kernels();
+	mismatches_count += check_fixed_lengths<isa_naive>("Naive");
+	#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+		mismatches_count += check_fixed_lengths<isa_sse2>("SSE2");
+	#endif
+	#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+		mismatches_count += check_fixed_lengths<isa_avx>("AVX");
+	#endif
+	#ifdef CSE6230_AVX512F_INTRINSICS_SUPPORTED
+		mismatches_count += check_fixed_lengths<isa_avx512f>("AVX-512");
+	#endif
+	mismatches_count += check_dispatch();
+	mismatches_count += check_reductions("Naive", &reduction_max_update_naive, &reduction_min_update_naive, &reduction_argmax_update_naive, &reduction_sum_update_naive);
+	#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+		mismatches_count += check_reductions("SSE2", &reduction_max_update_sse2, &reduction_min_update_sse2, &reduction_argmax_update_sse2, &reduction_sum_update_sse2);
+	#endif
+	#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+		mismatches_count += check_reductions("AVX", &reduction_max_update_avx, &reduction_min_update_avx, &reduction_argmax_update_avx, &reduction_sum_update_avx);
+	#endif
+	#ifdef CSE6230_AVX512F_INTRINSICS_SUPPORTED
+		mismatches_count += check_reductions("AVX-512", &reduction_max_update_avx512f, &reduction_min_update_avx512f, &reduction_argmax_update_avx512f, &reduction_sum_update_avx512f);
+	#endif
+	mismatches_count += check_reproducible_sum("Naive", &reproducible_sum_naive);
+	#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+		mismatches_count += check_reproducible_sum("SSE2", &reproducible_sum_sse2);
+	#endif
+	#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+		mismatches_count += check_reproducible_sum("AVX", &reproducible_sum_avx);
+	#endif
+	#ifdef CSE6230_AVX512F_INTRINSICS_SUPPORTED
+		mismatches_count += check_reproducible_sum("AVX-512", &reproducible_sum_avx512f);
+	#endif
+	mismatches_count += check_topk("Naive", &vector_topk_naive);
+	#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+		mismatches_count += check_topk("SSE2", &vector_topk_sse2);
+	#endif
+	#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+		mismatches_count += check_topk("AVX", &vector_topk_avx);
+	#endif
+	#ifdef CSE6230_AVX512F_INTRINSICS_SUPPORTED
+		mismatches_count += check_topk("AVX-512", &vector_topk_avx512f);
+	#endif
+	mismatches_count += check_scan("vector_inclusive_scan_naive + 3 threads", &vector_inclusive_scan_naive, false, 3, sizeof(double));
+	mismatches_count += check_scan("vector_exclusive_scan_naive + 3 threads", &vector_exclusive_scan_naive, true, 3, sizeof(double));
+	#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+		mismatches_count += check_scan("vector_inclusive_scan_sse2", &vector_inclusive_scan_sse2, false, 1, sizeof(double));
+		mismatches_count += check_scan("vector_inclusive_scan_sse2_aligned", &vector_inclusive_scan_sse2_aligned, false, 1, 16);
+		mismatches_count += check_scan("vector_exclusive_scan_sse2", &vector_exclusive_scan_sse2, true, 1, sizeof(double));
+	#endif
+	#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+		mismatches_count += check_scan("vector_inclusive_scan_avx", &vector_inclusive_scan_avx, false, 1, sizeof(double));
+		mismatches_count += check_scan("vector_inclusive_scan_avx_aligned", &vector_inclusive_scan_avx_aligned, false, 1, 32);
+		mismatches_count += check_scan("vector_inclusive_scan_avx_unrolled", &vector_inclusive_scan_avx_unrolled, false, 1, sizeof(double));
+		mismatches_count += check_scan("vector_exclusive_scan_avx", &vector_exclusive_scan_avx, true, 1, sizeof(double));
+		mismatches_count += check_scan("vector_inclusive_scan_avx + 3 threads", &vector_inclusive_scan_avx, false, 3, sizeof(double));
+		mismatches_count += check_scan("vector_exclusive_scan_avx + 3 threads", &vector_exclusive_scan_avx, true, 3, sizeof(double));
+	#endif
+	#ifdef CSE6230_AVX512F_INTRINSICS_SUPPORTED
+		mismatches_count += check_scan("vector_inclusive_scan_avx512f", &vector_inclusive_scan_avx512f, false, 1, sizeof(double));
+		mismatches_count += check_scan("vector_exclusive_scan_avx512f", &vector_exclusive_scan_avx512f, true, 1, sizeof(double));
+	#endif
+	mismatches_count += check_server("Naive", &vector_add_naive, &vector_max_naive);
+	#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+		mismatches_count += check_server("AVX", &vector_add_avx, &vector_max_avx);
+	#endif
+	mismatches_count += check_chain("Naive", &vector_add_naive, &vector_accumulate_naive, &vector_max_naive);
+	#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+		mismatches_count += check_chain("AVX", &vector_add_avx, &vector_accumulate_avx, &vector_max_avx);
+	#endif
+	mismatches_count += check_strided("Naive", &vector_add_strided_naive, &vector_max_strided_naive);
+	#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+		mismatches_count += check_strided("SSE2", &vector_add_strided_sse2, &vector_max_strided_sse2);
+	#endif
+	#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+		mismatches_count += check_strided("AVX", &vector_add_strided_avx, &vector_max_strided_avx);
+	#endif
+	#ifdef CSE6230_AVX2_INTRINSICS_SUPPORTED
+		mismatches_count += check_strided("AVX2", &vector_add_strided_avx2, &vector_max_strided_avx2);
+	#endif
+	#ifdef CSE6230_AVX512F_INTRINSICS_SUPPORTED
+		mismatches_count += check_strided("AVX-512", &vector_add_strided_avx512f, &vector_max_strided_avx512f);
+	#endif
+	mismatches_count += check_baseline("OpenMP SIMD", &vector_add_omp_simd, &vector_accumulate_omp_simd, &vector_axpy_omp_simd, &vector_max_omp_simd);
+	#ifdef CSE6230_UNSEQ_SUPPORTED
+		mismatches_count += check_baseline("unseq", &vector_add_unseq, &vector_accumulate_unseq, &vector_axpy_unseq, &vector_max_unseq);
+	#endif
+	#ifdef CSE6230_PAR_UNSEQ_SUPPORTED
+		mismatches_count += check_baseline("par_unseq", &vector_add_par_unseq, &vector_accumulate_par_unseq, &vector_axpy_par_unseq, &vector_max_par_unseq);
+	#endif
+	#ifdef CSE6230_VECTOR_EXTENSIONS_SUPPORTED
+		mismatches_count += check_baseline("Vector extensions", &vector_add_vector_extensions, &vector_accumulate_vector_extensions, &vector_axpy_vector_extensions, &vector_max_vector_extensions);
+	#endif
+	return mismatches_count;
+}
+
+template <typename T>
+static uint64_t time_typed_vector_add(void (*vector_add)(const T*, const T*, T*, size_t), const T* x_array, const T* y_array, T* sum_array, size_t array_size, size_t experiments_count) {
+	uint64_t best_ticks = uint64_t(-1);
+	const bool sampling = start_samples(experiments_count);
+	for (size_t experiment_number = 1; experiment_number <= experiments_count; experiment_number++) {
+		prepare_array(x_array, array_size * sizeof(T));
+		prepare_array(y_array, array_size * sizeof(T));
+		prepare_array(sum_array, array_size * sizeof(T));
+		const uint64_t start_ticks = get_cpu_ticks_start();
+		vector_add(x_array, y_array, sum_array, array_size);
+		const uint64_t end_ticks = get_cpu_ticks_end();
+		const uint64_t elapsed_ticks = end_ticks - start_ticks;
+		best_ticks = min(best_ticks, elapsed_ticks);
+		add_sample(sampling, experiment_number, elapsed_ticks);
+	}
+	return best_ticks;
+}
+
+template <typename T>
+static uint64_t time_typed_vector_max(void (*vector_max)(const T*, T*, size_t), const T* elements_array, size_t array_size, size_t experiments_count) {
+	uint64_t best_ticks = uint64_t(-1);
+	const bool sampling = start_samples(experiments_count);
+	for (size_t experiment_number = 1; experiment_number <= experiments_count; experiment_number++) {
+		T max_element;
+		prepare_array(elements_array, array_size * sizeof(T));
+		const uint64_t start_ticks = get_cpu_ticks_start();
+		vector_max(elements_array, &max_element, array_size);
+		const uint64_t end_ticks = get_cpu_ticks_end();
+		const uint64_t elapsed_ticks = end_ticks - start_ticks;
+		best_ticks = min(best_ticks, elapsed_ticks);
+		add_sample(sampling, experiment_number, elapsed_ticks);
+	}
+	return best_ticks;
+}
+
+static void report_timings(const char* method_name, uint64_t add_ticks, uint64_t max_ticks, size_t array_size) {
+	record_result(method_name, array_size);
+	printf("%30s\t%10.2lf\t%10.2lf\n", method_name, double(add_ticks) / double(array_size), double(max_ticks) / double(array_size));
+}
+
+// The arrays must have space for array_size elements of type T
+template <typename T>
+static void test_typed(const char* method_name, void (*vector_add)(const T*, const T*, T*, size_t), void (*vector_max)(const T*, T*, size_t), const void* x_array, const void* y_array, void* sum_array, size_t array_size, size_t experiments_count) {
+	const uint64_t add_ticks = time_typed_vector_add<T>(vector_add, (const T*)x_array, (const T*)y_array, (T*)sum_array, array_size, experiments_count);
+	const uint64_t max_ticks = time_typed_vector_max<T>(vector_max, (const T*)x_array, array_size, experiments_count);
+	report_timings(method_name, add_ticks, max_ticks, array_size);
+}
+
+// Must be one of vector_fixed_lengths
+static const size_t fixed_array_size = 500;
+
+static uint64_t time_vector_add_fixed(vector_add_fixed_function vector_add_fixed, const double* x_array, const double* y_array, double* sum_array, size_t experiments_count) {
+	uint64_t best_ticks = uint64_t(-1);
+	const bool sampling = start_samples(experiments_count);
+	for (size_t experiment_number = 1; experiment_number <= experiments_count; experiment_number++) {
+		prepare_array(x_array, fixed_array_size * sizeof(double));
+		prepare_array(y_array, fixed_array_size * sizeof(double));
+		prepare_array(sum_array, fixed_array_size * sizeof(double));
+		const uint64_t start_ticks = get_cpu_ticks_start();
+		vector_add_fixed(x_array, y_array, sum_array);
+		const uint64_t end_ticks = get_cpu_ticks_end();
+		const uint64_t elapsed_ticks = end_ticks - start_ticks;
+		best_ticks = min(best_ticks, elapsed_ticks);
+		add_sample(sampling, experiment_number, elapsed_ticks);
+	}
+	return best_ticks;
+}
+
+static uint64_t time_vector_max_fixed(vector_max_fixed_function vector_max_fixed, const double* elements_array, size_t experiments_count) {
+	uint64_t best_ticks = uint64_t(-1);
+	const bool sampling = start_samples(experiments_count);
+	for (size_t experiment_number = 1; experiment_number <= experiments_count; experiment_number++) {
+		double max_element;
+		prepare_array(elements_array, fixed_array_size * sizeof(double));
+		const uint64_t start_ticks = get_cpu_ticks_start();
+		vector_max_fixed(elements_array, &max_element);
+		const uint64_t end_ticks = get_cpu_ticks_end();
+		const uint64_t elapsed_ticks = end_ticks - start_ticks;
+		best_ticks = min(best_ticks, elapsed_ticks);
+		add_sample(sampling, experiment_number, elapsed_ticks);
+	}
+	return best_ticks;
+}
+
+static void test_fixed(const char* method_name, vector_add_fixed_function vector_add_fixed, vector_max_fixed_function vector_max_fixed, const double* x_array, const double* y_array, double* sum_array, size_t experiments_count) {
+	const uint64_t add_ticks = time_vector_add_fixed(vector_add_fixed, x_array, y_array, sum_array, experiments_count);
+	const uint64_t max_ticks = time_vector_max_fixed(vector_max_fixed, x_array, experiments_count);
+	report_timings(method_name, add_ticks, max_ticks, fixed_array_size);
+}
+
+// The array is passed to the update function in reduction_pieces_count pieces, as by a streaming caller
+static const size_t reduction_pieces_count = 10;
+
+static uint64_t time_reduction(reduction_init_function init, reduction_update_function update, const double* elements_array, size_t array_size, size_t experiments_count) {
+	uint64_t best_ticks = uint64_t(-1);
+	const bool sampling = start_samples(experiments_count);
+	const size_t piece_size = (array_size + reduction_pieces_count - 1) / reduction_pieces_count;
+	for (size_t experiment_number = 1; experiment_number <= experiments_count; experiment_number++) {
+		reduction_state state;
+		prepare_array(elements_array, array_size * sizeof(double));
+		const uint64_t start_ticks = get_cpu_ticks_start();
+		init(&state);
+		for (size_t piece_start = 0; piece_start < array_size; piece_start += piece_size) {
+			update(&state, elements_array + piece_start, min(piece_size, array_size - piece_start));
+		}
+		const uint64_t end_ticks = get_cpu_ticks_end();
+		const uint64_t elapsed_ticks = end_ticks - start_ticks;
+		best_ticks = min(best_ticks, elapsed_ticks);
+		add_sample(sampling, experiment_number, elapsed_ticks);
+	}
+	return best_ticks;
+}
+
+static void report_timings(const char* method_name, uint64_t max_ticks, uint64_t min_ticks, uint64_t argmax_ticks, uint64_t sum_ticks, size_t array_size) {
+	record_result(method_name, array_size);
+	printf("%30s\t%10.2lf\t%10.2lf\t%10.2lf\t%10.2lf\n", method_name,
+		double(max_ticks) / double(array_size), double(min_ticks) / double(array_size),
+		double(argmax_ticks) / double(array_size), double(sum_ticks) / double(array_size));
+}
+
+static void test_reduction(const char* method_name, reduction_update_function max_update, reduction_update_function min_update, reduction_update_function argmax_update, reduction_update_function sum_update, const double* x_array, size_t array_size, size_t experiments_count) {
+	const uint64_t max_ticks = time_reduction(&reduction_max_init, max_update, x_array, array_size, experiments_count);
+	const uint64_t min_ticks = time_reduction(&reduction_min_init, min_update, x_array, array_size, experiments_count);
+	const uint64_t argmax_ticks = time_reduction(&reduction_argmax_init, argmax_update, x_array, array_size, experiments_count);
+	const uint64_t sum_ticks = time_reduction(&reduction_sum_init, sum_update, x_array, array_size, experiments_count);
+	report_timings(method_name, max_ticks, min_ticks, argmax_ticks, sum_ticks, array_size);
+}
+
+static uint64_t time_reproducible_sum(reproducible_sum_function sum, size_t threads_count, const double* elements_array, size_t array_size, size_t experiments_count) {
+	uint64_t best_ticks = uint64_t(-1);
+	const bool sampling = start_samples(experiments_count);
+	for (size_t experiment_number = 1; experiment_number <= experiments_count; experiment_number++) {
+		prepare_array(elements_array, array_size * sizeof(double));
+		const uint64_t start_ticks = get_cpu_ticks_start();
+		if (threads_count == 1) {
+			sum(elements_array, array_size);
+		} else {
+			reproducible_sum_parallel(sum, elements_array, array_size, threads_count);
+		}
+		const uint64_t end_ticks = get_cpu_ticks_end();
+		const uint64_t elapsed_ticks = end_ticks - start_ticks;
+		best_ticks = min(best_ticks, elapsed_ticks);
+		add_sample(sampling, experiment_number, elapsed_ticks);
+	}
+	return best_ticks;
+}
+
+// threads_count = 1 calls the kernel directly, other values run it through vector_topk_parallel
+static uint64_t time_vector_topk(vector_topk_function topk, size_t threads_count, size_t k, const double* elements_array, size_t array_size, size_t experiments_count) {
+	uint64_t best_ticks = uint64_t(-1);
+	const bool sampling = start_samples(experiments_count);
+	for (size_t experiment_number = 1; experiment_number <= experiments_count; experiment_number++) {
+		double values[vector_topk_max_k];
+		size_t indices[vector_topk_max_k];
+		prepare_array(elements_array, array_size * sizeof(double));
+		const uint64_t start_ticks = get_cpu_ticks_start();
+		if (threads_count == 1) {
+			topk(elements_array, array_size, k, values, indices);
+		} else {
+			vector_topk_parallel(topk, elements_array, array_size, k, values, indices, threads_count);
+		}
+		const uint64_t end_ticks = get_cpu_ticks_end();
+		const uint64_t elapsed_ticks = end_ticks - start_ticks;
+		best_ticks = min(best_ticks, elapsed_ticks);
+		add_sample(sampling, experiment_number, elapsed_ticks);
+	}
+	return best_ticks;
+}
+
+static void test_vector_topk(const char* method_name, vector_topk_function topk, size_t threads_count, const double* x_array, size_t array_size, size_t experiments_count) {
+	const uint64_t top1_ticks = time_vector_topk(topk, threads_count, 1, x_array, array_size, experiments_count);
+	const uint64_t top8_ticks = time_vector_topk(topk, threads_count, 8, x_array, array_size, experiments_count);
+	const uint64_t top64_ticks = time_vector_topk(topk, threads_count, 64, x_array, array_size, experiments_count);
+	// Same columns as the misalignment reports
+	report_timings(method_name, top1_ticks, top8_ticks, top64_ticks, array_size);
+}
+
+template <typename T>
+static uint64_t time_mixed_vector_max(void (*vector_max)(const T*, double*, size_t), const T* elements_array, size_t array_size, size_t experiments_count) {
+	uint64_t best_ticks = uint64_t(-1);
+	const bool sampling = start_samples(experiments_count);
+	for (size_t experiment_number = 1; experiment_number <= experiments_count; experiment_number++) {
+		double max_element;
+		prepare_array(elements_array, array_size * sizeof(T));
+		const uint64_t start_ticks = get_cpu_ticks_start();
+		vector_max(elements_array, &max_element, array_size);
+		const uint64_t end_ticks = get_cpu_ticks_end();
+		const uint64_t elapsed_ticks = end_ticks - start_ticks;
+		best_ticks = min(best_ticks, elapsed_ticks);
+		add_sample(sampling, experiment_number, elapsed_ticks);
+	}
+	return best_ticks;
+}
+
+// Upper bound on the number of kernels of one operation in the registry
+static const size_t max_operation_kernels = 64;
+
+// Collects the kernels of the operation which can run on this processor, in registry order
+static size_t find_kernels(kernel_registry_operation operation, const kernel_info* kernels[max_operation_kernels]) {
+	size_t kernels_count = 0;
+	for (size_t index = 0; index < kernel_registry_count(); index++) {
+		const kernel_info* kernel = kernel_registry_get(index);
+		if ((kernel->operation == operation) && kernel_registry_is_available(kernel) && (kernels_count < max_operation_kernels)) {
+			kernels[kernels_count++] = kernel;
+		}
+	}
+	return kernels_count;
+}
+
+// Returns the available kernel of the operation with the same instruction set and length as the kernel, or NULL.
+// Benchmarks of several operations report them in one row, e.g. vector_add and vector_max of one element type.
+static const kernel_info* find_matching_kernel(kernel_registry_operation operation, const kernel_info* kernel) {
+	for (size_t index = 0; index < kernel_registry_count(); index++) {
+		const kernel_info* match = kernel_registry_get(index);
+		if ((match->operation == operation) && (match->isa == kernel->isa) && (match->length == kernel->length) && kernel_registry_is_available(match)) {
+			return match;
+		}
+	}
+	return NULL;
+}
+
+// Misaligned benchmarks shift the arrays by every offset within one SIMD register of the kernel
+static size_t misalignment_bound(const kernel_info* kernel) {
+	if (kernel->vectorWidth == 0) {
+		// The compiler may vectorize with registers up to 32 bytes wide
+		return 32;
+	}
+	return max(kernel->vectorWidth * sizeof(double), 16);
+}
+
+// Benchmarks the typed kernels of one element type: every vector_add kernel with the vector_max kernel of its instruction set
+template <typename T>
+static void test_typed_kernels(kernel_registry_operation add_operation, kernel_registry_operation max_operation, const void* x_array, const void* y_array, void* sum_array, size_t array_size, size_t experiments_count) {
+	const kernel_info* kernels[max_operation_kernels];
+	const size_t kernels_count = find_kernels(add_operation, kernels);
+	for (size_t kernel_number = 0; kernel_number < kernels_count; kernel_number++) {
+		const kernel_info* max_kernel = find_matching_kernel(max_operation, kernels[kernel_number]);
+		if (max_kernel != NULL) {
+			test_typed<T>(kernels[kernel_number]->description,
+				reinterpret_cast<void (*)(const T*, const T*, T*, size_t)>(kernels[kernel_number]->function),
+				reinterpret_cast<void (*)(const T*, T*, size_t)>(max_kernel->function),
+				x_array, y_array, sum_array, array_size, experiments_count);
+		}
+	}
+}
+
+// Benchmarks the saturating typed kernels of one integer type
+template <typename T>
+static void test_saturated_kernels(kernel_registry_operation operation, const void* x_array, const void* y_array, void* sum_array, size_t array_size, size_t experiments_count) {
+	const kernel_info* kernels[max_operation_kernels];
+	const size_t kernels_count = find_kernels(operation, kernels);
+	for (size_t kernel_number = 0; kernel_number < kernels_count; kernel_number++) {
+		void (*vector_add_saturated)(const T*, const T*, T*, size_t) = reinterpret_cast<void (*)(const T*, const T*, T*, size_t)>(kernels[kernel_number]->function);
+		report_timings(kernels[kernel_number]->description, time_typed_vector_add<T>(vector_add_saturated, (const T*)x_array, (const T*)y_array, (T*)sum_array, array_size, experiments_count), array_size);
+	}
+}
+
+static void run_benchmarks(cache_mode mode, size_t experiments_count) {
+	benchmark_cache_mode = mode;
+	printf("Cache mode: %s\n", cache_mode_names[mode]);
+	
+	size_t array_size = 500;
+	double *x_array = (double*)allocate_benchmark_array(array_size * sizeof(double) + 32);
+	double *y_array = (double*)allocate_benchmark_array(array_size * sizeof(double) + 32);
+	double *sum_array = (double*)allocate_benchmark_array(array_size * sizeof(double) + 32);
+	// Random inputs: the maximum of an array of zeros would not depend on the data
+	fill_check_array(x_array, array_size, 9);
+	fill_check_array(y_array, array_size, 10);
+	const kernel_info* kernels[max_operation_kernels];
+	size_t kernels_count;
+	
+	begin_section("Add Method");
+	printf("%30s\t%10s\t%10s\t%10s\n", "Add Method", "Aligned CPE", "Min CPE", "Max CPE");
+
+	kernels_count = find_kernels(kernel_registry_operation_vector_add, kernels);
+	for (size_t kernel_number = 0; kernel_number < kernels_count; kernel_number++) {
+		const vector_add_function vector_add = reinterpret_cast<vector_add_function>(kernels[kernel_number]->function);
+		if (kernels[kernel_number]->alignment > sizeof(double)) {
+			report_timings(kernels[kernel_number]->description, time_vector_add(vector_add, x_array, y_array, sum_array, array_size, experiments_count), array_size);
+		} else {
+			test_vector_add(kernels[kernel_number]->description, vector_add, x_array, y_array, sum_array, array_size, experiments_count, misalignment_bound(kernels[kernel_number]));
+		}
+	}
+	
+	begin_section("Add Placement");
+	printf("%30s\t%16s\t%10s\t%10s\t%10s\t%s\n", "Add Placement", "Cause", "Placements", "Best CPE", "Worst CPE", "Worst offsets");
+
+	char *x_buffer = (char*)allocate_benchmark_array(array_size * sizeof(double) + page_size);
+	char *y_buffer = (char*)allocate_benchmark_array(array_size * sizeof(double) + page_size);
+	char *sum_buffer = (char*)allocate_benchmark_array(array_size * sizeof(double) + page_size);
+	const size_t placement_experiments_count = max(experiments_count / 1000, 1);
+
+	for (size_t kernel_number = 0; kernel_number < kernels_count; kernel_number++) {
+		// The first kernel of every instruction set which accepts arrays at any offset. Placements are classified by
+		// the SIMD vectors of the kernel, which only hand-written kernels define.
+		const kernel_info* kernel = kernels[kernel_number];
+		if ((kernel->isa != kernel_registry_isa_compiler) && (kernel->alignment == sizeof(double)) &&
+			((kernel_number == 0) || (kernels[kernel_number - 1]->isa != kernel->isa)))
+		{
+			const vector_add_function vector_add = reinterpret_cast<vector_add_function>(kernel->function);
+			test_vector_add_placements(kernel->description, vector_add, kernel->vectorWidth * sizeof(double), x_buffer, y_buffer, sum_buffer, array_size, placement_experiments_count);
+		}
+	}
+
+	free_benchmark_array(x_buffer);
+	free_benchmark_array(y_buffer);
+	free_benchmark_array(sum_buffer);
+
+	begin_section("Accumulate Method");
+	printf("%30s\t%10s\t%10s\t%10s\n", "Accumulate Method", "Aligned CPE", "Min CPE", "Max CPE");
+
+	kernels_count = find_kernels(kernel_registry_operation_vector_accumulate, kernels);
+	for (size_t kernel_number = 0; kernel_number < kernels_count; kernel_number++) {
+		const vector_accumulate_function vector_accumulate = reinterpret_cast<vector_accumulate_function>(kernels[kernel_number]->function);
+		if (kernels[kernel_number]->alignment > sizeof(double)) {
+			report_timings(kernels[kernel_number]->description, time_vector_accumulate(vector_accumulate, x_array, y_array, array_size, experiments_count), array_size);
+		} else {
+			test_vector_accumulate(kernels[kernel_number]->description, vector_accumulate, x_array, y_array, array_size, experiments_count, misalignment_bound(kernels[kernel_number]));
+		}
+	}
+
+	begin_section("AXPY Method");
+	printf("%30s\t%10s\t%10s\t%10s\n", "AXPY Method", "Aligned CPE", "Min CPE", "Max CPE");
+
+	kernels_count = find_kernels(kernel_registry_operation_vector_axpy, kernels);
+	for (size_t kernel_number = 0; kernel_number < kernels_count; kernel_number++) {
+		const vector_axpy_function vector_axpy = reinterpret_cast<vector_axpy_function>(kernels[kernel_number]->function);
+		if (kernels[kernel_number]->alignment > sizeof(double)) {
+			report_timings(kernels[kernel_number]->description, time_vector_axpy(vector_axpy, 1.0, x_array, y_array, array_size, experiments_count), array_size);
+		} else {
+			test_vector_axpy(kernels[kernel_number]->description, vector_axpy, x_array, y_array, array_size, experiments_count, misalignment_bound(kernels[kernel_number]));
+		}
+	}
+
+	begin_section("Scan Method");
+	printf("%30s\t%10s\t%10s\t%10s\n", "Scan Method", "Aligned CPE", "Min CPE", "Max CPE");
+
+	kernels_count = find_kernels(kernel_registry_operation_vector_inclusive_scan, kernels);
+	for (size_t kernel_number = 0; kernel_number < kernels_count; kernel_number++) {
+		const vector_scan_function vector_scan = reinterpret_cast<vector_scan_function>(kernels[kernel_number]->function);
+		if (kernels[kernel_number]->alignment > sizeof(double)) {
+			report_timings(kernels[kernel_number]->description, time_vector_scan(vector_scan, 1, x_array, y_array, array_size, experiments_count, false), array_size);
+		} else {
+			test_vector_scan(kernels[kernel_number]->description, vector_scan, x_array, y_array, array_size, experiments_count, misalignment_bound(kernels[kernel_number]));
+		}
+	}
+	// Threads are started on every call
+	const kernel_info* inclusive_scan_naive = kernel_registry_find("vector_inclusive_scan_naive");
+	if (inclusive_scan_naive != NULL) {
+		report_timings("Naive + all threads", time_vector_scan(reinterpret_cast<vector_scan_function>(inclusive_scan_naive->function), 0, x_array, y_array, array_size, max(experiments_count / 1000, 1), false), array_size);
+	}
+
+	begin_section("Exclusive Scan Method");
+	printf("%30s\t%10s\n", "Exclusive Scan Method", "Aligned CPE");
+
+	kernels_count = find_kernels(kernel_registry_operation_vector_exclusive_scan, kernels);
+	for (size_t kernel_number = 0; kernel_number < kernels_count; kernel_number++) {
+		const vector_scan_function vector_scan = reinterpret_cast<vector_scan_function>(kernels[kernel_number]->function);
+		report_timings(kernels[kernel_number]->description, time_vector_scan(vector_scan, 1, x_array, y_array, array_size, experiments_count, true), array_size);
+	}
+	const kernel_info* exclusive_scan_naive = kernel_registry_find("vector_exclusive_scan_naive");
+	if (exclusive_scan_naive != NULL) {
+		report_timings("Naive + all threads", time_vector_scan(reinterpret_cast<vector_scan_function>(exclusive_scan_naive->function), 0, x_array, y_array, array_size, max(experiments_count / 1000, 1), true), array_size);
+	}
+
+	begin_section("Max Method");
+	printf("%30s\t%10s\t%10s\t%10s\n", "Max Method", "Aligned CPE", "Min CPE", "Max CPE");
+
+	kernels_count = find_kernels(kernel_registry_operation_vector_max, kernels);
+	for (size_t kernel_number = 0; kernel_number < kernels_count; kernel_number++) {
+		const vector_max_function vector_max = reinterpret_cast<vector_max_function>(kernels[kernel_number]->function);
+		if (kernels[kernel_number]->alignment > sizeof(double)) {
+			report_timings(kernels[kernel_number]->description, time_vector_max(vector_max, x_array, array_size, experiments_count), array_size);
+		} else {
+			test_vector_max(kernels[kernel_number]->description, vector_max, x_array, array_size, experiments_count, misalignment_bound(kernels[kernel_number]));
+		}
+	}
+
+	begin_section("Strided Add Method");
+	printf("%30s\t%10s\t%10s\t%10s\n", "Strided Add Method", "Stride 3", "Broadcast", "Stride 5");
+
+	// x is strided, y and sum are contiguous
+	double *strided_array = (double*)allocate_benchmark_array(array_size * max_benchmark_stride * sizeof(double));
+	double *staging_array = (double*)allocate_benchmark_array(array_size * sizeof(double));
+
+	// Copies of x into a contiguous array, added with the naive and the fastest vector_add kernel
+	const kernel_info* staged_kernels[2] = { kernel_registry_find("vector_add_naive"), kernel_registry_best(kernel_registry_operation_vector_add, sizeof(double)) };
+	for (size_t kernel_number = 0; kernel_number < 2; kernel_number++) {
+		if ((staged_kernels[kernel_number] != NULL) && ((kernel_number == 0) || (staged_kernels[1] != staged_kernels[0]))) {
+			char method_name[64];
+			snprintf(method_name, sizeof(method_name), "Staged %s", staged_kernels[kernel_number]->description);
+			test_vector_add_staged(method_name, reinterpret_cast<vector_add_function>(staged_kernels[kernel_number]->function), strided_array, y_array, sum_array, staging_array, array_size, experiments_count);
+		}
+	}
+	kernels_count = find_kernels(kernel_registry_operation_vector_add_strided, kernels);
+	for (size_t kernel_number = 0; kernel_number < kernels_count; kernel_number++) {
+		const vector_add_strided_function vector_add_strided = reinterpret_cast<vector_add_strided_function>(kernels[kernel_number]->function);
+		test_vector_add_strided(kernels[kernel_number]->description, vector_add_strided, strided_array, y_array, sum_array, array_size, experiments_count);
+	}
+
+	begin_section("Strided Max Method");
+	printf("%30s\t%10s\t%10s\t%10s\n", "Strided Max Method", "Stride 1", "Stride 3", "Stride 5");
+
+	kernels_count = find_kernels(kernel_registry_operation_vector_max_strided, kernels);
+	for (size_t kernel_number = 0; kernel_number < kernels_count; kernel_number++) {
+		const vector_max_strided_function vector_max_strided = reinterpret_cast<vector_max_strided_function>(kernels[kernel_number]->function);
+		test_vector_max_strided(kernels[kernel_number]->description, vector_max_strided, strided_array, array_size, experiments_count);
+	}
+
+	free_benchmark_array(strided_array);
+	free_benchmark_array(staging_array);
+
+	begin_section("Reduction State Method");
+	printf("%30s\t%10s\t%10s\t%10s\t%10s\n", "Reduction State Method", "Max CPE", "Min CPE", "Argmax CPE", "Sum CPE");
+
+	kernels_count = find_kernels(kernel_registry_operation_reduction_max_update, kernels);
+	for (size_t kernel_number = 0; kernel_number < kernels_count; kernel_number++) {
+		const kernel_info* min_kernel = find_matching_kernel(kernel_registry_operation_reduction_min_update, kernels[kernel_number]);
+		const kernel_info* argmax_kernel = find_matching_kernel(kernel_registry_operation_reduction_argmax_update, kernels[kernel_number]);
+		const kernel_info* sum_kernel = find_matching_kernel(kernel_registry_operation_reduction_sum_update, kernels[kernel_number]);
+		if ((min_kernel != NULL) && (argmax_kernel != NULL) && (sum_kernel != NULL)) {
+			test_reduction(kernels[kernel_number]->description,
+				reinterpret_cast<reduction_update_function>(kernels[kernel_number]->function),
+				reinterpret_cast<reduction_update_function>(min_kernel->function),
+				reinterpret_cast<reduction_update_function>(argmax_kernel->function),
+				reinterpret_cast<reduction_update_function>(sum_kernel->function),
+				x_array, array_size, experiments_count);
+		}
+	}
+
+	begin_section("Reproducible Sum Method");
+	printf("%30s\t%10s\n", "Reproducible Sum Method", "Aligned CPE");
+
+	kernels_count = find_kernels(kernel_registry_operation_reproducible_sum, kernels);
+	for (size_t kernel_number = 0; kernel_number < kernels_count; kernel_number++) {
+		const reproducible_sum_function sum = reinterpret_cast<reproducible_sum_function>(kernels[kernel_number]->function);
+		report_timings(kernels[kernel_number]->description, time_reproducible_sum(sum, 1, x_array, array_size, experiments_count), array_size);
+	}
+	// Threads are started on every call
+	const kernel_info* reproducible_sum_naive = kernel_registry_find("reproducible_sum_naive");
+	if (reproducible_sum_naive != NULL) {
+		report_timings("Naive + all threads", time_reproducible_sum(reinterpret_cast<reproducible_sum_function>(reproducible_sum_naive->function), 0, x_array, array_size, max(experiments_count / 1000, 1)), array_size);
+	}
+
+	// x_array holds random values, so the kernels insert fewer elements into their buffer as the scan proceeds
+	begin_section("Top-k Method");
+	printf("%30s\t%10s\t%10s\t%10s\n", "Top-k Method", "k=1 CPE", "k=8 CPE", "k=64 CPE");
+
+	kernels_count = find_kernels(kernel_registry_operation_vector_topk, kernels);
+	for (size_t kernel_number = 0; kernel_number < kernels_count; kernel_number++) {
+		const vector_topk_function topk = reinterpret_cast<vector_topk_function>(kernels[kernel_number]->function);
+		test_vector_topk(kernels[kernel_number]->description, topk, 1, x_array, array_size, experiments_count);
+	}
+	// Threads are started on every call
+	const kernel_info* topk_naive = kernel_registry_find("vector_topk_naive");
+	if (topk_naive != NULL) {
+		test_vector_topk("Naive + all threads", reinterpret_cast<vector_topk_function>(topk_naive->function), 0, x_array, array_size, max(experiments_count / 1000, 1));
+	}
+
+	begin_section("Mixed Precision Max Method");
+	printf("%30s\t%10s\n", "Mixed Precision Max Method", "Aligned CPE");
+
+	kernels_count = find_kernels(kernel_registry_operation_vector_max_f32, kernels);
+	for (size_t kernel_number = 0; kernel_number < kernels_count; kernel_number++) {
+		const vector_max_f32_function vector_max_f32 = reinterpret_cast<vector_max_f32_function>(kernels[kernel_number]->function);
+		report_timings(kernels[kernel_number]->description, time_mixed_vector_max<float>(vector_max_f32, (const float*)x_array, array_size, experiments_count), array_size);
+	}
+	kernels_count = find_kernels(kernel_registry_operation_vector_max_f16, kernels);
+	for (size_t kernel_number = 0; kernel_number < kernels_count; kernel_number++) {
+		const vector_max_f16_function vector_max_f16 = reinterpret_cast<vector_max_f16_function>(kernels[kernel_number]->function);
+		report_timings(kernels[kernel_number]->description, time_mixed_vector_max<uint16_t>(vector_max_f16, (const uint16_t*)x_array, array_size, experiments_count), array_size);
+	}
+
+	begin_section("Typed Method");
+	printf("%30s\t%10s\t%10s\n", "Typed Method", "Add CPE", "Max CPE");
+
+	test_typed_kernels<float>(kernel_registry_operation_typed_vector_add_f32, kernel_registry_operation_typed_vector_max_f32, x_array, y_array, sum_array, array_size, experiments_count);
+	test_typed_kernels<int32_t>(kernel_registry_operation_typed_vector_add_i32, kernel_registry_operation_typed_vector_max_i32, x_array, y_array, sum_array, array_size, experiments_count);
+	test_typed_kernels<uint32_t>(kernel_registry_operation_typed_vector_add_u32, kernel_registry_operation_typed_vector_max_u32, x_array, y_array, sum_array, array_size, experiments_count);
+	test_typed_kernels<int64_t>(kernel_registry_operation_typed_vector_add_i64, kernel_registry_operation_typed_vector_max_i64, x_array, y_array, sum_array, array_size, experiments_count);
+	test_typed_kernels<uint64_t>(kernel_registry_operation_typed_vector_add_u64, kernel_registry_operation_typed_vector_max_u64, x_array, y_array, sum_array, array_size, experiments_count);
+	test_typed_kernels<bfloat16>(kernel_registry_operation_typed_vector_add_bf16, kernel_registry_operation_typed_vector_max_bf16, x_array, y_array, sum_array, array_size, experiments_count);
+
+	begin_section("Saturated Add Method");
+	printf("%30s\t%10s\n", "Saturated Add Method", "Aligned CPE");
+
+	test_saturated_kernels<int32_t>(kernel_registry_operation_typed_vector_add_saturated_i32, x_array, y_array, sum_array, array_size, experiments_count);
+	test_saturated_kernels<uint32_t>(kernel_registry_operation_typed_vector_add_saturated_u32, x_array, y_array, sum_array, array_size, experiments_count);
+	test_saturated_kernels<int64_t>(kernel_registry_operation_typed_vector_add_saturated_i64, x_array, y_array, sum_array, array_size, experiments_count);
+	test_saturated_kernels<uint64_t>(kernel_registry_operation_typed_vector_add_saturated_u64, x_array, y_array, sum_array, array_size, experiments_count);
+
+	begin_section("Fixed-Length Method");
+	printf("%30s\t%10s\t%10s\n", "Fixed-Length Method", "Add CPE", "Max CPE");
+
+	kernels_count = find_kernels(kernel_registry_operation_vector_add_fixed, kernels);
+	for (size_t kernel_number = 0; kernel_number < kernels_count; kernel_number++) {
+		const kernel_info* max_kernel = find_matching_kernel(kernel_registry_operation_vector_max_fixed, kernels[kernel_number]);
+		if ((kernels[kernel_number]->length == fixed_array_size) && (max_kernel != NULL)) {
+			test_fixed(kernels[kernel_number]->description,
+				reinterpret_cast<vector_add_fixed_function>(kernels[kernel_number]->function),
+				reinterpret_cast<vector_max_fixed_function>(max_kernel->function),
+				x_array, y_array, sum_array, experiments_count);
+		}
+	}
+	const uint64_t dispatch_add_ticks = time_vector_add(&vector_add_dispatch, x_array, y_array, sum_array, fixed_array_size, experiments_count);
+	const uint64_t dispatch_max_ticks = time_vector_max(&vector_max_dispatch, x_array, fixed_array_size, experiments_count);
+	report_timings("Dispatch", dispatch_add_ticks, dispatch_max_ticks, fixed_array_size);
+	const uint64_t unregistered_dispatch_add_ticks = time_vector_add(&vector_add_dispatch, x_array, y_array, sum_array, fixed_array_size - 1, experiments_count);
+	const uint64_t unregistered_dispatch_max_ticks = time_vector_max(&vector_max_dispatch, x_array, fixed_array_size - 1, experiments_count);
+	report_timings("Dispatch, unregistered length", unregistered_dispatch_add_ticks, unregistered_dispatch_max_ticks, fixed_array_size - 1);
+	// The telemetry mode keeps telemetry enabled for all benchmarks
+	const bool telemetry_enabled = kernel_telemetry_is_enabled();
+	kernel_telemetry_enable(true);
+	const uint64_t telemetry_dispatch_add_ticks = time_vector_add(&vector_add_dispatch, x_array, y_array, sum_array, fixed_array_size, experiments_count);
+	const uint64_t telemetry_dispatch_max_ticks = time_vector_max(&vector_max_dispatch, x_array, fixed_array_size, experiments_count);
+	kernel_telemetry_enable(telemetry_enabled);
+	report_timings("Dispatch + telemetry", telemetry_dispatch_add_ticks, telemetry_dispatch_max_ticks, fixed_array_size);
+
+	begin_section("Async Add Method");
+	printf("%30s\t%10s\n", "Async Add Method", "Aligned CPE");
+
+	kernel_queue* queue = kernel_queue_create(0);
+	const size_t async_experiments_count = max(experiments_count / 100, 1);
+
+	// The naive and the fastest vector_add kernel
+	const kernel_info* async_kernels[2] = { kernel_registry_find("vector_add_naive"), kernel_registry_best(kernel_registry_operation_vector_add, sizeof(double)) };
+	for (size_t kernel_number = 0; kernel_number < 2; kernel_number++) {
+		if ((async_kernels[kernel_number] != NULL) && ((kernel_number == 0) || (async_kernels[1] != async_kernels[0]))) {
+			const vector_add_function vector_add = reinterpret_cast<vector_add_function>(async_kernels[kernel_number]->function);
+			char method_name[64];
+			snprintf(method_name, sizeof(method_name), "%s + queue, 1 job", async_kernels[kernel_number]->description);
+			report_timings(method_name, time_vector_add_async(queue, vector_add, x_array, y_array, sum_array, array_size, 1, async_experiments_count), array_size);
+			snprintf(method_name, sizeof(method_name), "%s + queue, 10 jobs", async_kernels[kernel_number]->description);
+			report_timings(method_name, time_vector_add_async(queue, vector_add, x_array, y_array, sum_array, array_size, 10, async_experiments_count), array_size);
+		}
+	}
+
+	kernel_queue_destroy(queue);
+
+	free_benchmark_array(x_array);
+	free_benchmark_array(y_array);
+	free_benchmark_array(sum_array);	
+}
+
+// Streaming benchmark: arrays in temporary files, which are evicted from the page cache before every run
+static const size_t stream_array_size = 16 * 1024 * 1024;
+static const size_t stream_chunk_length = 1024 * 1024;
+
+// Creates an unlinked temporary file in $TMPDIR (or the current directory) with the contents of the array
+static int create_stream_file(const double* array, size_t array_size) {
+	const char* directory = getenv("TMPDIR");
+	char path[4096];
+	snprintf(path, sizeof(path), "%s/cse6230-stream-XXXXXX", (directory != NULL) ? directory : ".");
+	const int file = mkstemp(path);
+	if (file < 0) {
+		return -1;
+	}
+	unlink(path);
+	const size_t size = array_size * sizeof(double);
+	if ((array != NULL) && (pwrite(file, array, size, 0) != ssize_t(size))) {
+		close(file);
+		return -1;
+	}
+	return file;
+}
+
+static void evict_stream_file(int file) {
+	fdatasync(file);
+	posix_fadvise(file, 0, 0, POSIX_FADV_DONTNEED);
+}
+
+static double seconds_since(std::chrono::steady_clock::time_point start_time) {
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+}
+
+// Reads and processes the chunks one after another, without overlapping storage and compute
+static bool serial_vector_add(int x_file, int y_file, int sum_file, size_t array_size, vector_add_function vector_add, double* x_chunk, double* y_chunk, double* sum_chunk) {
+	for (size_t chunk_start = 0; chunk_start < array_size; chunk_start += stream_chunk_length) {
+		const size_t chunk_length = min(array_size - chunk_start, stream_chunk_length);
+		const size_t chunk_size = chunk_length * sizeof(double);
+		const off_t chunk_offset = off_t(chunk_start * sizeof(double));
+		if ((pread(x_file, x_chunk, chunk_size, chunk_offset) != ssize_t(chunk_size)) || (pread(y_file, y_chunk, chunk_size, chunk_offset) != ssize_t(chunk_size))) {
+			return false;
+		}
+		vector_add(x_chunk, y_chunk, sum_chunk, chunk_length);
+		if (pwrite(sum_file, sum_chunk, chunk_size, chunk_offset) != ssize_t(chunk_size)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+static bool serial_vector_max(int file, size_t array_size, vector_max_function vector_max, double* chunk, double* max_pointer) {
+	for (size_t chunk_start = 0; chunk_start < array_size; chunk_start += stream_chunk_length) {
+		const size_t chunk_length = min(array_size - chunk_start, stream_chunk_length);
+		const size_t chunk_size = chunk_length * sizeof(double);
+		if (pread(file, chunk, chunk_size, off_t(chunk_start * sizeof(double))) != ssize_t(chunk_size)) {
+			return false;
+		}
+		double chunk_max;
+		vector_max(chunk, &chunk_max, chunk_length);
+		if ((chunk_start == 0) || (chunk_max > *max_pointer)) {
+			*max_pointer = chunk_max;
+		}
+	}
+	return true;
+}
+
+static void run_stream_benchmark() {
+	// The chunks are not aligned beyond their elements
+	const vector_add_function vector_add = reinterpret_cast<vector_add_function>(kernel_registry_best(kernel_registry_operation_vector_add, sizeof(double))->function);
+	const vector_max_function vector_max = reinterpret_cast<vector_max_function>(kernel_registry_best(kernel_registry_operation_vector_max, sizeof(double))->function);
+	const reduction_update_function reduction_max_update = reinterpret_cast<reduction_update_function>(kernel_registry_best(kernel_registry_operation_reduction_max_update, sizeof(double))->function);
+
+	double* x_array = static_cast<double*>(malloc(stream_array_size * sizeof(double)));
+	double* y_array = static_cast<double*>(malloc(stream_array_size * sizeof(double)));
+	double* chunks = static_cast<double*>(malloc(3 * stream_chunk_length * sizeof(double)));
+	if ((x_array == NULL) || (y_array == NULL) || (chunks == NULL)) {
+		fprintf(stderr, "Failed to allocate memory for the streaming benchmark\n");
+		free(x_array);
+		free(y_array);
+		free(chunks);
+		return;
+	}
+	for (size_t i = 0; i < stream_array_size; i++) {
+		x_array[i] = double(rand()) / double(RAND_MAX);
+		y_array[i] = double(rand()) / double(RAND_MAX);
+	}
+	double expected_max;
+	vector_max_naive(x_array, &expected_max, stream_array_size);
+
+	const int x_file = create_stream_file(x_array, stream_array_size);
+	const int y_file = create_stream_file(y_array, stream_array_size);
+	const int sum_file = create_stream_file(NULL, 0);
+	if ((x_file < 0) || (y_file < 0) || (sum_file < 0)) {
+		fprintf(stderr, "Failed to create temporary files for the streaming benchmark\n");
+	} else {
+		// Bytes read and written by every kernel
+		const double add_bytes = double(3 * stream_array_size * sizeof(double));
+		const double max_bytes = double(stream_array_size * sizeof(double));
+		printf("%30s\t%10s\n", "Streaming Method", "GB/s");
+
+		evict_stream_file(x_file);
+		evict_stream_file(y_file);
+		std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+		bool succeeded = serial_vector_add(x_file, y_file, sum_file, stream_array_size, vector_add, chunks, chunks + stream_chunk_length, chunks + 2 * stream_chunk_length);
+		printf("%30s\t%10.2lf\n", "vector_add serial", succeeded ? add_bytes / seconds_since(start_time) * 1.0e-9 : 0.0);
+
+		evict_stream_file(x_file);
+		evict_stream_file(y_file);
+		evict_stream_file(sum_file);
+		start_time = std::chrono::steady_clock::now();
+		succeeded = stream_vector_add(x_file, y_file, sum_file, stream_array_size, vector_add, stream_chunk_length);
+		printf("%30s\t%10.2lf\n", "vector_add streamed", succeeded ? add_bytes / seconds_since(start_time) * 1.0e-9 : 0.0);
+
+		double max_value = 0.0;
+		evict_stream_file(x_file);
+		start_time = std::chrono::steady_clock::now();
+		succeeded = serial_vector_max(x_file, stream_array_size, vector_max, chunks, &max_value) && (max_value == expected_max);
+		printf("%30s\t%10.2lf\n", "vector_max serial", succeeded ? max_bytes / seconds_since(start_time) * 1.0e-9 : 0.0);
+
+		max_value = 0.0;
+		evict_stream_file(x_file);
+		start_time = std::chrono::steady_clock::now();
+		succeeded = stream_vector_max(x_file, stream_array_size, vector_max, stream_chunk_length, &max_value) && (max_value == expected_max);
+		printf("%30s\t%10.2lf\n", "vector_max streamed", succeeded ? max_bytes / seconds_since(start_time) * 1.0e-9 : 0.0);
+
+		reduction_state state;
+		reduction_max_init(&state);
+		evict_stream_file(x_file);
+		start_time = std::chrono::steady_clock::now();
+		succeeded = stream_reduction(x_file, stream_array_size, reduction_max_update, stream_chunk_length, &state) && (reduction_max_finalize(&state) == expected_max);
+		printf("%30s\t%10.2lf\n", "reduction_max streamed", succeeded ? max_bytes / seconds_since(start_time) * 1.0e-9 : 0.0);
+	}
+
+	if (x_file >= 0) {
+		close(x_file);
+	}
+	if (y_file >= 0) {
+		close(y_file);
+	}
+	if (sum_file >= 0) {
+		close(sum_file);
+	}
+	free(x_array);
+	free(y_array);
+	free(chunks);
+}
+
+// Chain benchmark: max((x + y) + w) on arrays which are much larger than the caches
+static const size_t chain_array_size = 8 * 1024 * 1024;
+static const size_t chain_repetitions = 10;
+
+// Runs the kernels of the chain one after another over the whole arrays, with a full-size intermediate array
+static double unfused_chain(vector_add_function vector_add, vector_accumulate_function vector_accumulate, vector_max_function vector_max, const double* x_array, const double* y_array, const double* w_array, double* sum_array) {
+	double max_value;
+	vector_add(x_array, y_array, sum_array, chain_array_size);
+	vector_accumulate(w_array, sum_array, chain_array_size);
+	vector_max(sum_array, &max_value, chain_array_size);
+	return max_value;
+}
+
+static void run_chain_benchmark(size_t threads_count) {
+	// The chain passes slices of the arrays which are not aligned beyond their elements
+	const vector_add_function vector_add = reinterpret_cast<vector_add_function>(kernel_registry_best(kernel_registry_operation_vector_add, sizeof(double))->function);
+	const vector_accumulate_function vector_accumulate = reinterpret_cast<vector_accumulate_function>(kernel_registry_best(kernel_registry_operation_vector_accumulate, sizeof(double))->function);
+	const vector_max_function vector_max = reinterpret_cast<vector_max_function>(kernel_registry_best(kernel_registry_operation_vector_max, sizeof(double))->function);
+
+	double* x_array = allocate_vector_array(chain_array_size, 0);
+	double* y_array = allocate_vector_array(chain_array_size, 1);
+	double* w_array = allocate_vector_array(chain_array_size, 2);
+	double* sum_array = allocate_vector_array(chain_array_size, 3);
+	kernel_chain* chain = kernel_chain_create(chain_array_size);
+	chain_pool* pool = chain_pool_create(threads_count);
+	if ((x_array == NULL) || (y_array == NULL) || (w_array == NULL) || (sum_array == NULL) || (chain == NULL) || (pool == NULL)) {
+		fprintf(stderr, "Failed to allocate memory for the chain benchmark\n");
+	} else {
+		for (size_t i = 0; i < chain_array_size; i++) {
+			x_array[i] = double(rand()) / double(RAND_MAX);
+			y_array[i] = double(rand()) / double(RAND_MAX);
+			w_array[i] = double(rand()) / double(RAND_MAX);
+		}
+		double chain_max = 0.0;
+		const chain_array sum = kernel_chain_temporary(chain);
+		const chain_array w = kernel_chain_input(chain, w_array, 1);
+		kernel_chain_map(chain, vector_add, kernel_chain_input(chain, x_array, 1), kernel_chain_input(chain, y_array, 1), sum);
+		kernel_chain_accumulate(chain, vector_accumulate, w, sum);
+		kernel_chain_max(chain, vector_max, sum, &chain_max);
+
+		// Bytes of the inputs read by the chain
+		const double chain_bytes = double(3 * chain_array_size * sizeof(double));
+		printf("%30s\t%10s\n", "Chain Method", "GB/s");
+
+		const double expected_max = unfused_chain(vector_add, vector_accumulate, vector_max, x_array, y_array, w_array, sum_array);
+		double best_seconds = 0.0;
+		bool succeeded = true;
+		for (size_t repetition = 0; repetition < chain_repetitions; repetition++) {
+			const std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+			succeeded = succeeded && (unfused_chain(vector_add, vector_accumulate, vector_max, x_array, y_array, w_array, sum_array) == expected_max);
+			const double seconds = seconds_since(start_time);
+			if ((repetition == 0) || (seconds < best_seconds)) {
+				best_seconds = seconds;
+			}
+		}
+		printf("%30s\t%10.2lf\n", "Unfused", succeeded ? chain_bytes / best_seconds * 1.0e-9 : 0.0);
+
+		for (size_t pool_number = 0; pool_number < 2; pool_number++) {
+			chain_pool* run_pool = (pool_number == 0) ? NULL : pool;
+			succeeded = true;
+			for (size_t repetition = 0; repetition < chain_repetitions; repetition++) {
+				chain_max = 0.0;
+				const std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+				succeeded = succeeded && kernel_chain_run(chain, run_pool) && (chain_max == expected_max);
+				const double seconds = seconds_since(start_time);
+				if ((repetition == 0) || (seconds < best_seconds)) {
+					best_seconds = seconds;
+				}
+			}
+			printf("%30s\t%10.2lf\n", (pool_number == 0) ? "Chain, 1 thread" : "Chain, pool", succeeded ? chain_bytes / best_seconds * 1.0e-9 : 0.0);
+		}
+	}
+
+	chain_pool_destroy(pool);
+	kernel_chain_destroy(chain);
+	free_vector_array(x_array);
+	free_vector_array(y_array);
+	free_vector_array(w_array);
+	free_vector_array(sum_array);
+}
+
+// Server benchmark: client processes compute sum = x + y and max(sum), either with their own kernel calls or through the server
+static const size_t server_array_sizes[2] = { 1024, 64 * 1024 };
+// Bytes read and written by every client in one run
+static const size_t server_bytes_per_client = 256 * 1024 * 1024;
+static const size_t server_max_clients = 16;
+
+static void run_server_benchmark(size_t threads_count) {
+	const vector_add_function vector_add = reinterpret_cast<vector_add_function>(kernel_registry_best(kernel_registry_operation_vector_add, sizeof(double))->function);
+	const vector_max_function vector_max = reinterpret_cast<vector_max_function>(kernel_registry_best(kernel_registry_operation_vector_max, sizeof(double))->function);
+
+	char server_name[64];
+	snprintf(server_name, sizeof(server_name), "/cse6230-server-%d", int(getpid()));
+	// Arena memory is not reused: every client of every run allocates 3 arrays, a result and a job
+	const size_t arena_size = 2 * server_max_clients * (3 * (server_array_sizes[0] + server_array_sizes[1]) + 64) * sizeof(double);
+	kernel_server* server = kernel_server_create(server_name, arena_size, threads_count, vector_add, vector_max);
+	if (server == NULL) {
+		fprintf(stderr, "Failed to create the kernel server\n");
+		return;
+	}
+
+	printf("%30s\t%10s\t%10s\t%10s\t%10s\n", "Server Method", "Direct 1K", "Server 1K", "Direct 64K", "Server 64K");
+	for (size_t clients_count = 1; clients_count <= server_max_clients; clients_count *= 2) {
+		double bandwidths[4];
+		for (size_t size_number = 0; size_number < 2; size_number++) {
+			const size_t array_size = server_array_sizes[size_number];
+			// vector_add reads 2 arrays and writes 1, and vector_max reads 1 array
+			const double iteration_bytes = double(4 * array_size * sizeof(double));
+			const size_t iterations_count = max(server_bytes_per_client / (4 * array_size * sizeof(double)), 1);
+			const double bytes = iteration_bytes * double(iterations_count * clients_count);
+			for (size_t mode = 0; mode < 2; mode++) {
+				const double seconds = kernel_server_generate_load((mode == 0) ? NULL : server_name, vector_add, vector_max, clients_count, iterations_count, array_size);
+				bandwidths[size_number * 2 + mode] = (seconds != 0.0) ? bytes / seconds * 1.0e-9 : 0.0;
+			}
+		}
+		char method_name[64];
+		snprintf(method_name, sizeof(method_name), "%zu client%s, GB/s", clients_count, (clients_count == 1) ? "" : "s");
+		printf("%30s\t%10.2lf\t%10.2lf\t%10.2lf\t%10.2lf\n", method_name, bandwidths[0], bandwidths[1], bandwidths[2], bandwidths[3]);
+	}
+
+	kernel_server_destroy(server);
+}
+
+// Outputs of every thread in the scaling benchmark: 1M doubles in each input array
+static const size_t scaling_outputs_per_thread = 1024 * 1024;
+
+// Runs the thread-scaling benchmark with the naive and the fastest vector_add kernel
+static void run_vector_add_scaling_benchmark(size_t threads_count) {
+	const kernel_info* registry_kernels[2] = { kernel_registry_find("vector_add_naive"), kernel_registry_best(kernel_registry_operation_vector_add, sizeof(double)) };
+	scaling_kernel scaling_kernels[2];
+	size_t kernels_count = 0;
+	for (size_t kernel_number = 0; kernel_number < 2; kernel_number++) {
+		if ((registry_kernels[kernel_number] != NULL) && ((kernel_number == 0) || (registry_kernels[1] != registry_kernels[0]))) {
+			const scaling_kernel kernel = { registry_kernels[kernel_number]->name, reinterpret_cast<streaming_kernel_function>(registry_kernels[kernel_number]->function), 1 };
+			scaling_kernels[kernels_count++] = kernel;
+		}
+	}
+	run_scaling_benchmark(scaling_kernels, kernels_count, threads_count, scaling_outputs_per_thread);
+}
+
+// Usage: main [--save FILE] [--baseline FILE] [--threads N] [hot] [cold] [first-touch] [scaling] [stream] [chain] [server] [kernels] [telemetry]
+// Runs all benchmarks once for every listed cache mode, or only in the hot mode without modes.
+// Then prints statistics of every kernel, compared with the results in the baseline file (if any),
+// and saves them to the results file (if any). With scaling, runs the thread-scaling benchmark on up to N threads
+// (all CPUs by default), with stream runs the streaming benchmark, and with chain runs the kernel chain benchmark with
+// a pool of N threads. With server, compares client processes which call the kernels themselves with clients of a
+// kernel server with N workers. With kernels, lists the kernels in the registry of libcse6230 and whether this
+// processor supports them. Cache modes then run only when they are listed. With telemetry, records the calls to the
+// dispatchers during the benchmarks and prints the histograms at the end; they are also printed to stderr on SIGUSR1.
+int main(int argc, char** argv) {
+	const size_t experiments_count = 10000000;
+	const char* save_path = NULL;
+	static benchmark_result baseline_results[max_results_count];
+	size_t baseline_results_count = 0;
+	cache_mode modes[cache_mode_count];
+	size_t modes_count = 0;
+	bool run_scaling = false;
+	bool run_stream = false;
+	bool run_chain = false;
+	bool run_server = false;
+	bool list_kernels = false;
+	bool record_telemetry = false;
+	size_t scaling_threads = 0;
+	for (int argument_number = 1; argument_number < argc; argument_number++) {
+		if (strcmp(argv[argument_number], "--save") == 0 && argument_number + 1 < argc) {
+			save_path = argv[++argument_number];
+		} else if (strcmp(argv[argument_number], "--baseline") == 0 && argument_number + 1 < argc) {
+			const char* baseline_path = argv[++argument_number];
+			baseline_results_count = load_benchmark_results(baseline_path, baseline_results, max_results_count);
+			if (baseline_results_count == 0) {
+				fprintf(stderr, "No results loaded from baseline file \"%s\"\n", baseline_path);
+				return 1;
+			}
+		} else if (strcmp(argv[argument_number], "--threads") == 0 && argument_number + 1 < argc) {
+			scaling_threads = strtoul(argv[++argument_number], NULL, 10);
+		} else if (strcmp(argv[argument_number], "scaling") == 0) {
+			run_scaling = true;
+		} else if (strcmp(argv[argument_number], "stream") == 0) {
+			run_stream = true;
+		} else if (strcmp(argv[argument_number], "chain") == 0) {
+			run_chain = true;
+		} else if (strcmp(argv[argument_number], "server") == 0) {
+			run_server = true;
+		} else if (strcmp(argv[argument_number], "kernels") == 0) {
+			list_kernels = true;
+		} else if (strcmp(argv[argument_number], "telemetry") == 0) {
+			record_telemetry = true;
+		} else {
+			size_t mode = 0;
+			while (mode < cache_mode_count && strcmp(argv[argument_number], cache_mode_names[mode]) != 0) {
+				mode += 1;
+			}
+			if (mode == cache_mode_count) {
+				fprintf(stderr, "Unknown argument \"%s\": expected --save FILE, --baseline FILE, --threads N, hot, cold, first-touch, scaling, stream, chain, server, kernels or telemetry\n", argv[argument_number]);
+				return 1;
+			}
+			if (modes_count < cache_mode_count) {
+				modes[modes_count++] = cache_mode(mode);
+			}
+		}
+	}
+	if (list_kernels) {
+		kernel_registry_print(stdout);
+	}
+	if (record_telemetry) {
+		kernel_telemetry_enable(true);
+		if (!kernel_telemetry_dump_on_signal(SIGUSR1, STDERR_FILENO)) {
+			fprintf(stderr, "Failed to install the telemetry signal handler\n");
+		}
+	}
+	if (modes_count == 0 && !run_scaling && !run_stream && !run_chain && !run_server && !list_kernels) {
+		modes[modes_count++] = cache_mode_hot;
+	}
+
+	// Wrong results fail the run, but do not stop the benchmarks
+	const size_t mismatches_count = check_kernels();
+
+	for (size_t mode_number = 0; mode_number < modes_count; mode_number++) {
+		const cache_mode mode = modes[mode_number];
+		run_benchmarks(mode, experiments_count / cache_mode_experiments_divisor[mode]);
+	}
+
+	if (run_scaling) {
+		run_vector_add_scaling_benchmark(scaling_threads);
+	}
+	if (run_stream) {
+		run_stream_benchmark();
+	}
+	if (run_chain) {
+		run_chain_benchmark(scaling_threads);
+	}
+	if (run_server) {
+		run_server_benchmark(scaling_threads);
+	}
+
+	if (record_telemetry) {
+		kernel_telemetry_enable(false);
+		printf("Telemetry\tHistogram\tBucket\tCount\n");
+		fflush(stdout);
+		kernel_telemetry_dump(STDOUT_FILENO);
+	}
+
+	if (results_count != 0) {
+		print_statistics(baseline_results, baseline_results_count);
+	}
+	if (save_path != NULL && !save_benchmark_results(save_path, results, results_count)) {
+		fprintf(stderr, "Failed to save results to \"%s\"\n", save_path);
+		return 1;
+	}
+
+	if (mismatches_count != 0) {
+		fprintf(stderr, "%zu results differ from the naive kernels\n", mismatches_count);
+		return 1;
+	}
+	return 0;
 }
\ No newline at end of file
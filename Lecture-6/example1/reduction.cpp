@@ -0,0 +1,375 @@
+/******************************************************************************\
+ *                                                                            *
+ * Copyright (c) 2012 Marat Dukhan                                            *
+ *                                                                            *
+ * This software is provided 'as-is', without any express or implied          *
+ * warranty. In no event will the authors be held liable for any damages      *
+ * arising from the use of this software.                                     *
+ *                                                                            *
+ * Permission is granted to anyone to use this software for any purpose,      *
+ * including commercial applications, and to alter it and redistribute it     *
+ * freely, subject to the following restrictions:                             *
+ *                                                                            *
+ * 1. The origin of this software must not be misrepresented; you must not    *
+ * claim that you wrote the original software. If you use this software       *
+ * in a product, an acknowledgment in the product documentation would be      *
+ * appreciated but is not required.                                           *
+ *                                                                            *
+ * 2. Altered source versions must be plainly marked as such, and must not be *
+ * misrepresented as being the original software.                             *
+ *                                                                            *
+ * 3. This notice may not be removed or altered from any source               *
+ * distribution.                                                              *
+ *                                                                            *
+\******************************************************************************/
+
+#include <reduction.hpp>
+#include <math.h>
+#include <stdint.h>
+#if defined(CSE6230_SSE2_INTRINSICS_SUPPORTED) || defined(CSE6230_AVX_INTRINSICS_SUPPORTED)
+	#if defined(__GNUC__)
+		#include <x86intrin.h>
+	#elif defined(_MSC_VER)
+		#include <intrin.h>
+	#else
+		#error Intrinsics headers are not included: unknown compiler
+	#endif
+#endif
+
+// Operations on SIMD vectors of doubles for the reductions. Each specialization provides:
+//   load, store (unaligned), broadcast, add, max, min
+//   greater: a mask of lanes where a > b, and select: the lanes of a where the mask is set, and of b elsewhere
+template <typename ISA>
+struct reduction_pd;
+
+template <>
+struct reduction_pd<isa_naive> {
+	typedef double vector;
+	typedef bool mask;
+	static const size_t width = 1;
+
+	static vector load(const double* pointer) { return *pointer; }
+	static void store(double* pointer, vector v) { *pointer = v; }
+	static vector broadcast(double value) { return value; }
+	static vector add(vector a, vector b) { return a + b; }
+	static vector max(vector a, vector b) { return a > b ? a : b; }
+	static vector min(vector a, vector b) { return a < b ? a : b; }
+	static mask greater(vector a, vector b) { return a > b; }
+	static vector select(mask m, vector a, vector b) { return m ? a : b; }
+};
+
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+template <>
+struct reduction_pd<isa_sse2> {
+	typedef __m128d vector;
+	typedef __m128d mask;
+	static const size_t width = 2;
+
+	static vector load(const double* pointer) { return _mm_loadu_pd(pointer); }
+	static void store(double* pointer, vector v) { _mm_storeu_pd(pointer, v); }
+	static vector broadcast(double value) { return _mm_set1_pd(value); }
+	static vector add(vector a, vector b) { return _mm_add_pd(a, b); }
+	static vector max(vector a, vector b) { return _mm_max_pd(a, b); }
+	static vector min(vector a, vector b) { return _mm_min_pd(a, b); }
+	static mask greater(vector a, vector b) { return _mm_cmpgt_pd(a, b); }
+	static vector select(mask m, vector a, vector b) { return _mm_or_pd(_mm_and_pd(m, a), _mm_andnot_pd(m, b)); }
+};
+#endif
+
+#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+template <>
+struct reduction_pd<isa_avx> {
+	typedef __m256d vector;
+	typedef __m256d mask;
+	static const size_t width = 4;
+
+	static vector load(const double* pointer) { return _mm256_loadu_pd(pointer); }
+	static void store(double* pointer, vector v) { _mm256_storeu_pd(pointer, v); }
+	static vector broadcast(double value) { return _mm256_set1_pd(value); }
+	static vector add(vector a, vector b) { return _mm256_add_pd(a, b); }
+	static vector max(vector a, vector b) { return _mm256_max_pd(a, b); }
+	static vector min(vector a, vector b) { return _mm256_min_pd(a, b); }
+	static mask greater(vector a, vector b) { return _mm256_cmp_pd(a, b, _CMP_GT_OQ); }
+	static vector select(mask m, vector a, vector b) { return _mm256_blendv_pd(b, a, m); }
+};
+#endif
+
+#ifdef CSE6230_AVX512F_INTRINSICS_SUPPORTED
+template <>
+struct reduction_pd<isa_avx512f> {
+	typedef __m512d vector;
+	typedef __mmask8 mask;
+	static const size_t width = 8;
+
+	static vector load(const double* pointer) { return _mm512_loadu_pd(pointer); }
+	static void store(double* pointer, vector v) { _mm512_storeu_pd(pointer, v); }
+	static vector broadcast(double value) { return _mm512_set1_pd(value); }
+	static vector add(vector a, vector b) { return _mm512_add_pd(a, b); }
+	static vector max(vector a, vector b) { return _mm512_max_pd(a, b); }
+	static vector min(vector a, vector b) { return _mm512_min_pd(a, b); }
+	static mask greater(vector a, vector b) { return _mm512_cmp_pd_mask(a, b, _CMP_GT_OQ); }
+	static vector select(mask m, vector a, vector b) { return _mm512_mask_blend_pd(m, b, a); }
+};
+#endif
+
+// Offsets of the SIMD lanes, for the indices of argmax
+static const double lane_offsets[reduction_lanes] = { 0.0, 1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0 };
+
+static void init_state(reduction_state* state, double value) {
+	for (size_t lane = 0; lane < reduction_lanes; lane++) {
+		state->values[lane] = value;
+		state->indices[lane] = 0.0;
+	}
+	state->count = 0;
+}
+
+// Elements which do not fill a SIMD vector go to lane 0
+template <typename ISA>
+static void update_max(reduction_state *CSE6230_RESTRICT state, const double *CSE6230_RESTRICT arrayPointer, size_t length) {
+	typedef reduction_pd<ISA> simd;
+	typename simd::vector max = simd::load(state->values);
+	size_t i = 0;
+	for (; i + simd::width <= length; i += simd::width) {
+		max = simd::max(max, simd::load(arrayPointer + i));
+	}
+	simd::store(state->values, max);
+	// Process remaining elements (if any)
+	for (; i < length; i++) {
+		state->values[0] = reduction_pd<isa_naive>::max(state->values[0], arrayPointer[i]);
+	}
+	state->count += length;
+}
+
+template <typename ISA>
+static void update_min(reduction_state *CSE6230_RESTRICT state, const double *CSE6230_RESTRICT arrayPointer, size_t length) {
+	typedef reduction_pd<ISA> simd;
+	typename simd::vector min = simd::load(state->values);
+	size_t i = 0;
+	for (; i + simd::width <= length; i += simd::width) {
+		min = simd::min(min, simd::load(arrayPointer + i));
+	}
+	simd::store(state->values, min);
+	// Process remaining elements (if any)
+	for (; i < length; i++) {
+		state->values[0] = reduction_pd<isa_naive>::min(state->values[0], arrayPointer[i]);
+	}
+	state->count += length;
+}
+
+// Every lane keeps the first maximum of its elements: later elements replace it only if they are strictly greater
+template <typename ISA>
+static void update_argmax(reduction_state *CSE6230_RESTRICT state, const double *CSE6230_RESTRICT arrayPointer, size_t length) {
+	typedef reduction_pd<ISA> simd;
+	typename simd::vector max = simd::load(state->values);
+	typename simd::vector maxIndices = simd::load(state->indices);
+	typename simd::vector indices = simd::add(simd::broadcast(double(state->count)), simd::load(lane_offsets));
+	const typename simd::vector indicesStep = simd::broadcast(double(simd::width));
+	size_t i = 0;
+	for (; i + simd::width <= length; i += simd::width) {
+		const typename simd::vector elements = simd::load(arrayPointer + i);
+		const typename simd::mask greater = simd::greater(elements, max);
+		max = simd::select(greater, elements, max);
+		maxIndices = simd::select(greater, indices, maxIndices);
+		indices = simd::add(indices, indicesStep);
+	}
+	simd::store(state->values, max);
+	simd::store(state->indices, maxIndices);
+	// Process remaining elements (if any)
+	for (; i < length; i++) {
+		if (arrayPointer[i] > state->values[0]) {
+			state->values[0] = arrayPointer[i];
+			state->indices[0] = double(state->count + i);
+		}
+	}
+	state->count += length;
+}
+
+template <typename ISA>
+static void update_sum(reduction_state *CSE6230_RESTRICT state, const double *CSE6230_RESTRICT arrayPointer, size_t length) {
+	typedef reduction_pd<ISA> simd;
+	typename simd::vector sum = simd::load(state->values);
+	size_t i = 0;
+	for (; i + simd::width <= length; i += simd::width) {
+		sum = simd::add(sum, simd::load(arrayPointer + i));
+	}
+	simd::store(state->values, sum);
+	// Process remaining elements (if any)
+	for (; i < length; i++) {
+		state->values[0] += arrayPointer[i];
+	}
+	state->count += length;
+}
+
+void reduction_max_init(reduction_state* state) {
+	init_state(state, -INFINITY);
+}
+
+void reduction_max_update_naive(reduction_state *CSE6230_RESTRICT state, const double *CSE6230_RESTRICT arrayPointer, size_t length) {
+	update_max<isa_naive>(state, arrayPointer, length);
+}
+
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+void reduction_max_update_sse2(reduction_state *CSE6230_RESTRICT state, const double *CSE6230_RESTRICT arrayPointer, size_t length) {
+	update_max<isa_sse2>(state, arrayPointer, length);
+}
+#endif
+
+#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+void reduction_max_update_avx(reduction_state *CSE6230_RESTRICT state, const double *CSE6230_RESTRICT arrayPointer, size_t length) {
+	update_max<isa_avx>(state, arrayPointer, length);
+}
+#endif
+
+#ifdef CSE6230_AVX512F_INTRINSICS_SUPPORTED
+void reduction_max_update_avx512f(reduction_state *CSE6230_RESTRICT state, const double *CSE6230_RESTRICT arrayPointer, size_t length) {
+	update_max<isa_avx512f>(state, arrayPointer, length);
+}
+#endif
+
+void reduction_max_merge(reduction_state *CSE6230_RESTRICT state, const reduction_state *CSE6230_RESTRICT other) {
+	for (size_t lane = 0; lane < reduction_lanes; lane++) {
+		state->values[lane] = reduction_pd<isa_naive>::max(state->values[lane], other->values[lane]);
+	}
+	state->count += other->count;
+}
+
+double reduction_max_finalize(const reduction_state* state) {
+	double max = state->values[0];
+	for (size_t lane = 1; lane < reduction_lanes; lane++) {
+		max = reduction_pd<isa_naive>::max(max, state->values[lane]);
+	}
+	return max;
+}
+
+void reduction_min_init(reduction_state* state) {
+	init_state(state, INFINITY);
+}
+
+void reduction_min_update_naive(reduction_state *CSE6230_RESTRICT state, const double *CSE6230_RESTRICT arrayPointer, size_t length) {
+	update_min<isa_naive>(state, arrayPointer, length);
+}
+
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+void reduction_min_update_sse2(reduction_state *CSE6230_RESTRICT state, const double *CSE6230_RESTRICT arrayPointer, size_t length) {
+	update_min<isa_sse2>(state, arrayPointer, length);
+}
+#endif
+
+#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+void reduction_min_update_avx(reduction_state *CSE6230_RESTRICT state, const double *CSE6230_RESTRICT arrayPointer, size_t length) {
+	update_min<isa_avx>(state, arrayPointer, length);
+}
+#endif
+
+#ifdef CSE6230_AVX512F_INTRINSICS_SUPPORTED
+void reduction_min_update_avx512f(reduction_state *CSE6230_RESTRICT state, const double *CSE6230_RESTRICT arrayPointer, size_t length) {
+	update_min<isa_avx512f>(state, arrayPointer, length);
+}
+#endif
+
+void reduction_min_merge(reduction_state *CSE6230_RESTRICT state, const reduction_state *CSE6230_RESTRICT other) {
+	for (size_t lane = 0; lane < reduction_lanes; lane++) {
+		state->values[lane] = reduction_pd<isa_naive>::min(state->values[lane], other->values[lane]);
+	}
+	state->count += other->count;
+}
+
+double reduction_min_finalize(const reduction_state* state) {
+	double min = state->values[0];
+	for (size_t lane = 1; lane < reduction_lanes; lane++) {
+		min = reduction_pd<isa_naive>::min(min, state->values[lane]);
+	}
+	return min;
+}
+
+void reduction_argmax_init(reduction_state* state) {
+	init_state(state, -INFINITY);
+}
+
+void reduction_argmax_update_naive(reduction_state *CSE6230_RESTRICT state, const double *CSE6230_RESTRICT arrayPointer, size_t length) {
+	update_argmax<isa_naive>(state, arrayPointer, length);
+}
+
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+void reduction_argmax_update_sse2(reduction_state *CSE6230_RESTRICT state, const double *CSE6230_RESTRICT arrayPointer, size_t length) {
+	update_argmax<isa_sse2>(state, arrayPointer, length);
+}
+#endif
+
+#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+void reduction_argmax_update_avx(reduction_state *CSE6230_RESTRICT state, const double *CSE6230_RESTRICT arrayPointer, size_t length) {
+	update_argmax<isa_avx>(state, arrayPointer, length);
+}
+#endif
+
+#ifdef CSE6230_AVX512F_INTRINSICS_SUPPORTED
+void reduction_argmax_update_avx512f(reduction_state *CSE6230_RESTRICT state, const double *CSE6230_RESTRICT arrayPointer, size_t length) {
+	update_argmax<isa_avx512f>(state, arrayPointer, length);
+}
+#endif
+
+// The indices of other are shifted by the number of elements in state. On equal values the smaller index wins.
+void reduction_argmax_merge(reduction_state *CSE6230_RESTRICT state, const reduction_state *CSE6230_RESTRICT other) {
+	const double indexOffset = double(state->count);
+	for (size_t lane = 0; lane < reduction_lanes; lane++) {
+		if (other->values[lane] > state->values[lane]) {
+			state->values[lane] = other->values[lane];
+			state->indices[lane] = other->indices[lane] + indexOffset;
+		}
+	}
+	state->count += other->count;
+}
+
+size_t reduction_argmax_finalize(const reduction_state *CSE6230_RESTRICT state, double *CSE6230_RESTRICT maxPointer) {
+	double max = -INFINITY;
+	double maxIndex = 0.0;
+	for (size_t lane = 0; lane < reduction_lanes; lane++) {
+		if ((state->values[lane] > max) || ((state->values[lane] == max) && (state->indices[lane] < maxIndex))) {
+			max = state->values[lane];
+			maxIndex = state->indices[lane];
+		}
+	}
+	*maxPointer = max;
+	return (state->count == 0) ? SIZE_MAX : size_t(maxIndex);
+}
+
+void reduction_sum_init(reduction_state* state) {
+	init_state(state, 0.0);
+}
+
+void reduction_sum_update_naive(reduction_state *CSE6230_RESTRICT state, const double *CSE6230_RESTRICT arrayPointer, size_t length) {
+	update_sum<isa_naive>(state, arrayPointer, length);
+}
+
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+void reduction_sum_update_sse2(reduction_state *CSE6230_RESTRICT state, const double *CSE6230_RESTRICT arrayPointer, size_t length) {
+	update_sum<isa_sse2>(state, arrayPointer, length);
+}
+#endif
+
+#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+void reduction_sum_update_avx(reduction_state *CSE6230_RESTRICT state, const double *CSE6230_RESTRICT arrayPointer, size_t length) {
+	update_sum<isa_avx>(state, arrayPointer, length);
+}
+#endif
+
+#ifdef CSE6230_AVX512F_INTRINSICS_SUPPORTED
+void reduction_sum_update_avx512f(reduction_state *CSE6230_RESTRICT state, const double *CSE6230_RESTRICT arrayPointer, size_t length) {
+	update_sum<isa_avx512f>(state, arrayPointer, length);
+}
+#endif
+
+void reduction_sum_merge(reduction_state *CSE6230_RESTRICT state, const reduction_state *CSE6230_RESTRICT other) {
+	for (size_t lane = 0; lane < reduction_lanes; lane++) {
+		state->values[lane] += other->values[lane];
+	}
+	state->count += other->count;
+}
+
+double reduction_sum_finalize(const reduction_state* state) {
+	double sum = 0.0;
+	for (size_t lane = 0; lane < reduction_lanes; lane++) {
+		sum += state->values[lane];
+	}
+	return sum;
+}
@@ -0,0 +1,110 @@
+/******************************************************************************\
+ *                                                                            *
+ * Copyright (c) 2012 Marat Dukhan                                            *
+ *                                                                            *
+ * This software is provided 'as-is', without any express or implied          *
+ * warranty. In no event will the authors be held liable for any damages      *
+ * arising from the use of this software.                                     *
+ *                                                                            *
+ * Permission is granted to anyone to use this software for any purpose,      *
+ * including commercial applications, and to alter it and redistribute it     *
+ * freely, subject to the following restrictions:                             *
+ *                                                                            *
+ * 1. The origin of this software must not be misrepresented; you must not    *
+ * claim that you wrote the original software. If you use this software       *
+ * in a product, an acknowledgment in the product documentation would be      *
+ * appreciated but is not required.                                           *
+ *                                                                            *
+ * 2. Altered source versions must be plainly marked as such, and must not be *
+ * misrepresented as being the original software.                             *
+ *                                                                            *
+ * 3. This notice may not be removed or altered from any source               *
+ * distribution.                                                              *
+ *                                                                            *
+\******************************************************************************/
+
+#pragma once
+
+#include <compute.hpp>
+#include <typed.hpp>
+
+// Incremental reductions of double arrays which arrive in pieces: init, then update with every piece, then finalize.
+// The state keeps the partial results of every SIMD lane (up to the 8 lanes of AVX-512), so an update resumes from
+// the vector accumulators of the previous one instead of reducing them to one value after every piece.
+// States of different instruction sets are compatible: an update only uses the lanes of its SIMD width.
+// Merging combines two states, e.g. from different threads; the elements of other follow the elements of state,
+// which only matters for argmax indices. The sum depends on the instruction set and the split into pieces,
+// because the lanes add the elements in different order. NaN elements are not supported.
+static const size_t reduction_lanes = 8;
+
+struct reduction_state {
+	double values[reduction_lanes];
+	// Indices of the values in argmax, stored as doubles so that SIMD instructions can update them with the values
+	double indices[reduction_lanes];
+	// Number of elements in all updates
+	size_t count;
+};
+
+typedef void (*reduction_init_function)(reduction_state*);
+typedef void (*reduction_update_function)(reduction_state*, const double*, size_t);
+typedef void (*reduction_merge_function)(reduction_state*, const reduction_state*);
+
+extern "C" void reduction_max_init(reduction_state* state);
+extern "C" void reduction_max_update_naive(reduction_state *CSE6230_RESTRICT state, const double *CSE6230_RESTRICT arrayPointer, size_t length);
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+extern "C" void reduction_max_update_sse2(reduction_state *CSE6230_RESTRICT state, const double *CSE6230_RESTRICT arrayPointer, size_t length);
+#endif
+#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+extern "C" void reduction_max_update_avx(reduction_state *CSE6230_RESTRICT state, const double *CSE6230_RESTRICT arrayPointer, size_t length);
+#endif
+#ifdef CSE6230_AVX512F_INTRINSICS_SUPPORTED
+extern "C" void reduction_max_update_avx512f(reduction_state *CSE6230_RESTRICT state, const double *CSE6230_RESTRICT arrayPointer, size_t length);
+#endif
+extern "C" void reduction_max_merge(reduction_state *CSE6230_RESTRICT state, const reduction_state *CSE6230_RESTRICT other);
+// Returns -infinity if there were no elements
+extern "C" double reduction_max_finalize(const reduction_state* state);
+
+extern "C" void reduction_min_init(reduction_state* state);
+extern "C" void reduction_min_update_naive(reduction_state *CSE6230_RESTRICT state, const double *CSE6230_RESTRICT arrayPointer, size_t length);
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+extern "C" void reduction_min_update_sse2(reduction_state *CSE6230_RESTRICT state, const double *CSE6230_RESTRICT arrayPointer, size_t length);
+#endif
+#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+extern "C" void reduction_min_update_avx(reduction_state *CSE6230_RESTRICT state, const double *CSE6230_RESTRICT arrayPointer, size_t length);
+#endif
+#ifdef CSE6230_AVX512F_INTRINSICS_SUPPORTED
+extern "C" void reduction_min_update_avx512f(reduction_state *CSE6230_RESTRICT state, const double *CSE6230_RESTRICT arrayPointer, size_t length);
+#endif
+extern "C" void reduction_min_merge(reduction_state *CSE6230_RESTRICT state, const reduction_state *CSE6230_RESTRICT other);
+// Returns +infinity if there were no elements
+extern "C" double reduction_min_finalize(const reduction_state* state);
+
+extern "C" void reduction_argmax_init(reduction_state* state);
+extern "C" void reduction_argmax_update_naive(reduction_state *CSE6230_RESTRICT state, const double *CSE6230_RESTRICT arrayPointer, size_t length);
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+extern "C" void reduction_argmax_update_sse2(reduction_state *CSE6230_RESTRICT state, const double *CSE6230_RESTRICT arrayPointer, size_t length);
+#endif
+#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+extern "C" void reduction_argmax_update_avx(reduction_state *CSE6230_RESTRICT state, const double *CSE6230_RESTRICT arrayPointer, size_t length);
+#endif
+#ifdef CSE6230_AVX512F_INTRINSICS_SUPPORTED
+extern "C" void reduction_argmax_update_avx512f(reduction_state *CSE6230_RESTRICT state, const double *CSE6230_RESTRICT arrayPointer, size_t length);
+#endif
+extern "C" void reduction_argmax_merge(reduction_state *CSE6230_RESTRICT state, const reduction_state *CSE6230_RESTRICT other);
+// Returns the index of the first maximum element (counted from the start of the first update) and stores the maximum
+// to *maxPointer. Returns SIZE_MAX and stores -infinity if there were no elements.
+extern "C" size_t reduction_argmax_finalize(const reduction_state *CSE6230_RESTRICT state, double *CSE6230_RESTRICT maxPointer);
+
+extern "C" void reduction_sum_init(reduction_state* state);
+extern "C" void reduction_sum_update_naive(reduction_state *CSE6230_RESTRICT state, const double *CSE6230_RESTRICT arrayPointer, size_t length);
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+extern "C" void reduction_sum_update_sse2(reduction_state *CSE6230_RESTRICT state, const double *CSE6230_RESTRICT arrayPointer, size_t length);
+#endif
+#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+extern "C" void reduction_sum_update_avx(reduction_state *CSE6230_RESTRICT state, const double *CSE6230_RESTRICT arrayPointer, size_t length);
+#endif
+#ifdef CSE6230_AVX512F_INTRINSICS_SUPPORTED
+extern "C" void reduction_sum_update_avx512f(reduction_state *CSE6230_RESTRICT state, const double *CSE6230_RESTRICT arrayPointer, size_t length);
+#endif
+extern "C" void reduction_sum_merge(reduction_state *CSE6230_RESTRICT state, const reduction_state *CSE6230_RESTRICT other);
+extern "C" double reduction_sum_finalize(const reduction_state* state);
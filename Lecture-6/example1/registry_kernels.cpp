@@ -0,0 +1,479 @@
+/******************************************************************************\
+ *                                                                            *
+ * Copyright (c) 2012 Marat Dukhan                                            *
+ *                                                                            *
+ * This software is provided 'as-is', without any express or implied          *
+ * warranty. In no event will the authors be held liable for any damages      *
+ * arising from the use of this software.                                     *
+ *                                                                            *
+ * Permission is granted to anyone to use this software for any purpose,      *
+ * including commercial applications, and to alter it and redistribute it     *
+ * freely, subject to the following restrictions:                             *
+ *                                                                            *
+ * 1. The origin of this software must not be misrepresented; you must not    *
+ * claim that you wrote the original software. If you use this software       *
+ * in a product, an acknowledgment in the product documentation would be      *
+ * appreciated but is not required.                                           *
+ *                                                                            *
+ * 2. Altered source versions must be plainly marked as such, and must not be *
+ * misrepresented as being the original software.                             *
+ *                                                                            *
+ * 3. This notice may not be removed or altered from any source               *
+ * distribution.                                                              *
+ *                                                                            *
+\******************************************************************************/
+
+#include <registry_table.hpp>
+#include <baseline.hpp>
+#include <typed.hpp>
+#include <fixed.hpp>
+#include <reduction.hpp>
+#include <reproducible.hpp>
+#include <topk.hpp>
+#include <scan.hpp>
+#include <strided.hpp>
+
+// Fixed-length kernels are registered for every instantiated length
+#define REGISTRY_FIXED_KERNEL(N, function, operation, isaTag, isa, description, vectorWidth) \
+	REGISTRY_TEMPLATE_KERNEL(description, operation, isa, sizeof(double), vectorWidth, N, function<N, isaTag>),
+
+// Kernels of every operation are listed in the order in which the benchmark reports them
+const kernel_info vector_registry_kernels[] = {
+	REGISTRY_KERNEL(vector_add_naive, "Naive", vector_add, naive, sizeof(double), 1),
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+	REGISTRY_KERNEL(vector_add_sse2, "SSE2", vector_add, sse2, sizeof(double), 2),
+	REGISTRY_KERNEL(vector_add_sse2_aligned, "SSE2 + aligned array", vector_add, sse2, 16, 2),
+	REGISTRY_KERNEL(vector_add_sse2_load_aligned, "SSE2 + aligned load", vector_add, sse2, sizeof(double), 2),
+	REGISTRY_KERNEL(vector_add_sse2_store_aligned, "SSE2 + aligned store", vector_add, sse2, sizeof(double), 2),
+#endif
+#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+	REGISTRY_KERNEL(vector_add_avx, "AVX", vector_add, avx, sizeof(double), 4),
+	REGISTRY_KERNEL(vector_add_avx_aligned, "AVX + aligned array", vector_add, avx, 32, 4),
+	REGISTRY_KERNEL(vector_add_avx_load_aligned, "AVX + aligned load", vector_add, avx, sizeof(double), 4),
+	REGISTRY_KERNEL(vector_add_avx_store_aligned, "AVX + aligned store", vector_add, avx, sizeof(double), 4),
+#endif
+	REGISTRY_KERNEL(vector_add_omp_simd, "omp simd", vector_add, compiler, sizeof(double), 0),
+#ifdef CSE6230_UNSEQ_SUPPORTED
+	REGISTRY_KERNEL(vector_add_unseq, "std::execution::unseq", vector_add, compiler, sizeof(double), 0),
+#endif
+#ifdef CSE6230_PAR_UNSEQ_SUPPORTED
+	REGISTRY_KERNEL(vector_add_par_unseq, "std::execution::par_unseq", vector_add, compiler, sizeof(double), 0),
+#endif
+#ifdef CSE6230_VECTOR_EXTENSIONS_SUPPORTED
+	REGISTRY_KERNEL(vector_add_vector_extensions, "Vector extensions", vector_add, compiler, sizeof(double), 4),
+#endif
+
+	REGISTRY_KERNEL(vector_accumulate_naive, "Naive", vector_accumulate, naive, sizeof(double), 1),
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+	REGISTRY_KERNEL(vector_accumulate_sse2, "SSE2", vector_accumulate, sse2, sizeof(double), 2),
+	REGISTRY_KERNEL(vector_accumulate_sse2_aligned, "SSE2 + aligned array", vector_accumulate, sse2, 16, 2),
+	REGISTRY_KERNEL(vector_accumulate_sse2_load_aligned, "SSE2 + aligned load", vector_accumulate, sse2, sizeof(double), 2),
+	REGISTRY_KERNEL(vector_accumulate_sse2_store_aligned, "SSE2 + aligned store", vector_accumulate, sse2, sizeof(double), 2),
+#endif
+#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+	REGISTRY_KERNEL(vector_accumulate_avx, "AVX", vector_accumulate, avx, sizeof(double), 4),
+	REGISTRY_KERNEL(vector_accumulate_avx_aligned, "AVX + aligned array", vector_accumulate, avx, 32, 4),
+	REGISTRY_KERNEL(vector_accumulate_avx_load_aligned, "AVX + aligned load", vector_accumulate, avx, sizeof(double), 4),
+	REGISTRY_KERNEL(vector_accumulate_avx_store_aligned, "AVX + aligned store", vector_accumulate, avx, sizeof(double), 4),
+#endif
+	REGISTRY_KERNEL(vector_accumulate_omp_simd, "omp simd", vector_accumulate, compiler, sizeof(double), 0),
+#ifdef CSE6230_UNSEQ_SUPPORTED
+	REGISTRY_KERNEL(vector_accumulate_unseq, "std::execution::unseq", vector_accumulate, compiler, sizeof(double), 0),
+#endif
+#ifdef CSE6230_PAR_UNSEQ_SUPPORTED
+	REGISTRY_KERNEL(vector_accumulate_par_unseq, "std::execution::par_unseq", vector_accumulate, compiler, sizeof(double), 0),
+#endif
+#ifdef CSE6230_VECTOR_EXTENSIONS_SUPPORTED
+	REGISTRY_KERNEL(vector_accumulate_vector_extensions, "Vector extensions", vector_accumulate, compiler, sizeof(double), 4),
+#endif
+
+	REGISTRY_KERNEL(vector_axpy_naive, "Naive", vector_axpy, naive, sizeof(double), 1),
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+	REGISTRY_KERNEL(vector_axpy_sse2, "SSE2", vector_axpy, sse2, sizeof(double), 2),
+	REGISTRY_KERNEL(vector_axpy_sse2_aligned, "SSE2 + aligned array", vector_axpy, sse2, 16, 2),
+	REGISTRY_KERNEL(vector_axpy_sse2_load_aligned, "SSE2 + aligned load", vector_axpy, sse2, sizeof(double), 2),
+	REGISTRY_KERNEL(vector_axpy_sse2_store_aligned, "SSE2 + aligned store", vector_axpy, sse2, sizeof(double), 2),
+#endif
+#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+	REGISTRY_KERNEL(vector_axpy_avx, "AVX", vector_axpy, avx, sizeof(double), 4),
+	REGISTRY_KERNEL(vector_axpy_avx_aligned, "AVX + aligned array", vector_axpy, avx, 32, 4),
+	REGISTRY_KERNEL(vector_axpy_avx_load_aligned, "AVX + aligned load", vector_axpy, avx, sizeof(double), 4),
+	REGISTRY_KERNEL(vector_axpy_avx_store_aligned, "AVX + aligned store", vector_axpy, avx, sizeof(double), 4),
+#endif
+	REGISTRY_KERNEL(vector_axpy_omp_simd, "omp simd", vector_axpy, compiler, sizeof(double), 0),
+#ifdef CSE6230_UNSEQ_SUPPORTED
+	REGISTRY_KERNEL(vector_axpy_unseq, "std::execution::unseq", vector_axpy, compiler, sizeof(double), 0),
+#endif
+#ifdef CSE6230_PAR_UNSEQ_SUPPORTED
+	REGISTRY_KERNEL(vector_axpy_par_unseq, "std::execution::par_unseq", vector_axpy, compiler, sizeof(double), 0),
+#endif
+#ifdef CSE6230_VECTOR_EXTENSIONS_SUPPORTED
+	REGISTRY_KERNEL(vector_axpy_vector_extensions, "Vector extensions", vector_axpy, compiler, sizeof(double), 4),
+#endif
+
+	REGISTRY_KERNEL(vector_max_naive, "Naive", vector_max, naive, sizeof(double), 1),
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+	REGISTRY_KERNEL(vector_max_sse2, "SSE2", vector_max, sse2, sizeof(double), 2),
+	REGISTRY_KERNEL(vector_max_sse2_load_aligned, "SSE2 + aligned load", vector_max, sse2, sizeof(double), 2),
+	REGISTRY_KERNEL(vector_max_sse2_load_aligned_unrolled, "SSE2 + aligned load + unrolling", vector_max, sse2, sizeof(double), 2),
+#endif
+#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+	REGISTRY_KERNEL(vector_max_avx, "AVX", vector_max, avx, sizeof(double), 4),
+	REGISTRY_KERNEL(vector_max_avx_load_aligned, "AVX + aligned load", vector_max, avx, sizeof(double), 4),
+	REGISTRY_KERNEL(vector_max_avx_load_aligned_unrolled, "AVX + aligned load + unrolling", vector_max, avx, sizeof(double), 4),
+#endif
+	REGISTRY_KERNEL(vector_max_omp_simd, "omp simd", vector_max, compiler, sizeof(double), 0),
+#ifdef CSE6230_UNSEQ_SUPPORTED
+	REGISTRY_KERNEL(vector_max_unseq, "std::execution::unseq", vector_max, compiler, sizeof(double), 0),
+#endif
+#ifdef CSE6230_PAR_UNSEQ_SUPPORTED
+	REGISTRY_KERNEL(vector_max_par_unseq, "std::execution::par_unseq", vector_max, compiler, sizeof(double), 0),
+#endif
+#ifdef CSE6230_VECTOR_EXTENSIONS_SUPPORTED
+	REGISTRY_KERNEL(vector_max_vector_extensions, "Vector extensions", vector_max, compiler, sizeof(double), 4),
+#endif
+
+	REGISTRY_KERNEL(vector_max_f32_naive, "F32 Naive", vector_max_f32, naive, sizeof(float), 1),
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+	REGISTRY_KERNEL(vector_max_f32_sse2, "F32 SSE2", vector_max_f32, sse2, sizeof(float), 4),
+#endif
+#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+	REGISTRY_KERNEL(vector_max_f32_avx, "F32 AVX", vector_max_f32, avx, sizeof(float), 8),
+#endif
+
+	REGISTRY_KERNEL(vector_max_f16_naive, "F16 Naive", vector_max_f16, naive, sizeof(uint16_t), 1),
+#if defined(CSE6230_AVX_INTRINSICS_SUPPORTED) && defined(CSE6230_F16C_INTRINSICS_SUPPORTED)
+	REGISTRY_KERNEL(vector_max_f16_f16c, "F16 F16C", vector_max_f16, f16c, sizeof(uint16_t), 8),
+#endif
+
+	REGISTRY_TEMPLATE_KERNEL("float", typed_vector_add_f32, naive, sizeof(float), 1, 0, vector_add<float, isa_naive>),
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+	REGISTRY_TEMPLATE_KERNEL("float + SSE2", typed_vector_add_f32, sse2, sizeof(float), 4, 0, vector_add<float, isa_sse2>),
+#endif
+#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+	REGISTRY_TEMPLATE_KERNEL("float + AVX", typed_vector_add_f32, avx, sizeof(float), 8, 0, vector_add<float, isa_avx>),
+#endif
+#ifdef CSE6230_AVX2_INTRINSICS_SUPPORTED
+	REGISTRY_TEMPLATE_KERNEL("float + AVX2", typed_vector_add_f32, avx2, sizeof(float), 8, 0, vector_add<float, isa_avx2>),
+#endif
+#ifdef CSE6230_AVX512F_INTRINSICS_SUPPORTED
+	REGISTRY_TEMPLATE_KERNEL("float + AVX-512", typed_vector_add_f32, avx512f, sizeof(float), 16, 0, vector_add<float, isa_avx512f>),
+#endif
+
+	REGISTRY_TEMPLATE_KERNEL("int32", typed_vector_add_i32, naive, sizeof(int32_t), 1, 0, vector_add<int32_t, isa_naive>),
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+	REGISTRY_TEMPLATE_KERNEL("int32 + SSE2", typed_vector_add_i32, sse2, sizeof(int32_t), 4, 0, vector_add<int32_t, isa_sse2>),
+#endif
+#ifdef CSE6230_AVX2_INTRINSICS_SUPPORTED
+	REGISTRY_TEMPLATE_KERNEL("int32 + AVX2", typed_vector_add_i32, avx2, sizeof(int32_t), 8, 0, vector_add<int32_t, isa_avx2>),
+#endif
+#ifdef CSE6230_AVX512F_INTRINSICS_SUPPORTED
+	REGISTRY_TEMPLATE_KERNEL("int32 + AVX-512", typed_vector_add_i32, avx512f, sizeof(int32_t), 16, 0, vector_add<int32_t, isa_avx512f>),
+#endif
+
+	REGISTRY_TEMPLATE_KERNEL("uint32", typed_vector_add_u32, naive, sizeof(uint32_t), 1, 0, vector_add<uint32_t, isa_naive>),
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+	REGISTRY_TEMPLATE_KERNEL("uint32 + SSE2", typed_vector_add_u32, sse2, sizeof(uint32_t), 4, 0, vector_add<uint32_t, isa_sse2>),
+#endif
+#ifdef CSE6230_AVX2_INTRINSICS_SUPPORTED
+	REGISTRY_TEMPLATE_KERNEL("uint32 + AVX2", typed_vector_add_u32, avx2, sizeof(uint32_t), 8, 0, vector_add<uint32_t, isa_avx2>),
+#endif
+#ifdef CSE6230_AVX512F_INTRINSICS_SUPPORTED
+	REGISTRY_TEMPLATE_KERNEL("uint32 + AVX-512", typed_vector_add_u32, avx512f, sizeof(uint32_t), 16, 0, vector_add<uint32_t, isa_avx512f>),
+#endif
+
+	REGISTRY_TEMPLATE_KERNEL("int64", typed_vector_add_i64, naive, sizeof(int64_t), 1, 0, vector_add<int64_t, isa_naive>),
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+	REGISTRY_TEMPLATE_KERNEL("int64 + SSE2", typed_vector_add_i64, sse2, sizeof(int64_t), 2, 0, vector_add<int64_t, isa_sse2>),
+#endif
+#ifdef CSE6230_AVX2_INTRINSICS_SUPPORTED
+	REGISTRY_TEMPLATE_KERNEL("int64 + AVX2", typed_vector_add_i64, avx2, sizeof(int64_t), 4, 0, vector_add<int64_t, isa_avx2>),
+#endif
+#ifdef CSE6230_AVX512F_INTRINSICS_SUPPORTED
+	REGISTRY_TEMPLATE_KERNEL("int64 + AVX-512", typed_vector_add_i64, avx512f, sizeof(int64_t), 8, 0, vector_add<int64_t, isa_avx512f>),
+#endif
+
+	REGISTRY_TEMPLATE_KERNEL("uint64", typed_vector_add_u64, naive, sizeof(uint64_t), 1, 0, vector_add<uint64_t, isa_naive>),
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+	REGISTRY_TEMPLATE_KERNEL("uint64 + SSE2", typed_vector_add_u64, sse2, sizeof(uint64_t), 2, 0, vector_add<uint64_t, isa_sse2>),
+#endif
+#ifdef CSE6230_AVX2_INTRINSICS_SUPPORTED
+	REGISTRY_TEMPLATE_KERNEL("uint64 + AVX2", typed_vector_add_u64, avx2, sizeof(uint64_t), 4, 0, vector_add<uint64_t, isa_avx2>),
+#endif
+#ifdef CSE6230_AVX512F_INTRINSICS_SUPPORTED
+	REGISTRY_TEMPLATE_KERNEL("uint64 + AVX-512", typed_vector_add_u64, avx512f, sizeof(uint64_t), 8, 0, vector_add<uint64_t, isa_avx512f>),
+#endif
+
+	REGISTRY_TEMPLATE_KERNEL("bfloat16", typed_vector_add_bf16, naive, sizeof(bfloat16), 1, 0, vector_add<bfloat16, isa_naive>),
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+	REGISTRY_TEMPLATE_KERNEL("bfloat16 + SSE2", typed_vector_add_bf16, sse2, sizeof(bfloat16), 4, 0, vector_add<bfloat16, isa_sse2>),
+#endif
+#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+	REGISTRY_TEMPLATE_KERNEL("bfloat16 + AVX", typed_vector_add_bf16, avx, sizeof(bfloat16), 8, 0, vector_add<bfloat16, isa_avx>),
+#endif
+#ifdef CSE6230_AVX2_INTRINSICS_SUPPORTED
+	REGISTRY_TEMPLATE_KERNEL("bfloat16 + AVX2", typed_vector_add_bf16, avx2, sizeof(bfloat16), 8, 0, vector_add<bfloat16, isa_avx2>),
+#endif
+#ifdef CSE6230_AVX512F_INTRINSICS_SUPPORTED
+	REGISTRY_TEMPLATE_KERNEL("bfloat16 + AVX-512", typed_vector_add_bf16, avx512f, sizeof(bfloat16), 16, 0, vector_add<bfloat16, isa_avx512f>),
+#endif
+
+	REGISTRY_TEMPLATE_KERNEL("float", typed_vector_max_f32, naive, sizeof(float), 1, 0, vector_max<float, isa_naive>),
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+	REGISTRY_TEMPLATE_KERNEL("float + SSE2", typed_vector_max_f32, sse2, sizeof(float), 4, 0, vector_max<float, isa_sse2>),
+#endif
+#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+	REGISTRY_TEMPLATE_KERNEL("float + AVX", typed_vector_max_f32, avx, sizeof(float), 8, 0, vector_max<float, isa_avx>),
+#endif
+#ifdef CSE6230_AVX2_INTRINSICS_SUPPORTED
+	REGISTRY_TEMPLATE_KERNEL("float + AVX2", typed_vector_max_f32, avx2, sizeof(float), 8, 0, vector_max<float, isa_avx2>),
+#endif
+#ifdef CSE6230_AVX512F_INTRINSICS_SUPPORTED
+	REGISTRY_TEMPLATE_KERNEL("float + AVX-512", typed_vector_max_f32, avx512f, sizeof(float), 16, 0, vector_max<float, isa_avx512f>),
+#endif
+
+	REGISTRY_TEMPLATE_KERNEL("int32", typed_vector_max_i32, naive, sizeof(int32_t), 1, 0, vector_max<int32_t, isa_naive>),
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+	REGISTRY_TEMPLATE_KERNEL("int32 + SSE2", typed_vector_max_i32, sse2, sizeof(int32_t), 4, 0, vector_max<int32_t, isa_sse2>),
+#endif
+#ifdef CSE6230_AVX2_INTRINSICS_SUPPORTED
+	REGISTRY_TEMPLATE_KERNEL("int32 + AVX2", typed_vector_max_i32, avx2, sizeof(int32_t), 8, 0, vector_max<int32_t, isa_avx2>),
+#endif
+#ifdef CSE6230_AVX512F_INTRINSICS_SUPPORTED
+	REGISTRY_TEMPLATE_KERNEL("int32 + AVX-512", typed_vector_max_i32, avx512f, sizeof(int32_t), 16, 0, vector_max<int32_t, isa_avx512f>),
+#endif
+
+	REGISTRY_TEMPLATE_KERNEL("uint32", typed_vector_max_u32, naive, sizeof(uint32_t), 1, 0, vector_max<uint32_t, isa_naive>),
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+	REGISTRY_TEMPLATE_KERNEL("uint32 + SSE2", typed_vector_max_u32, sse2, sizeof(uint32_t), 4, 0, vector_max<uint32_t, isa_sse2>),
+#endif
+#ifdef CSE6230_AVX2_INTRINSICS_SUPPORTED
+	REGISTRY_TEMPLATE_KERNEL("uint32 + AVX2", typed_vector_max_u32, avx2, sizeof(uint32_t), 8, 0, vector_max<uint32_t, isa_avx2>),
+#endif
+#ifdef CSE6230_AVX512F_INTRINSICS_SUPPORTED
+	REGISTRY_TEMPLATE_KERNEL("uint32 + AVX-512", typed_vector_max_u32, avx512f, sizeof(uint32_t), 16, 0, vector_max<uint32_t, isa_avx512f>),
+#endif
+
+	REGISTRY_TEMPLATE_KERNEL("int64", typed_vector_max_i64, naive, sizeof(int64_t), 1, 0, vector_max<int64_t, isa_naive>),
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+	REGISTRY_TEMPLATE_KERNEL("int64 + SSE2", typed_vector_max_i64, sse2, sizeof(int64_t), 2, 0, vector_max<int64_t, isa_sse2>),
+#endif
+#ifdef CSE6230_AVX2_INTRINSICS_SUPPORTED
+	REGISTRY_TEMPLATE_KERNEL("int64 + AVX2", typed_vector_max_i64, avx2, sizeof(int64_t), 4, 0, vector_max<int64_t, isa_avx2>),
+#endif
+#ifdef CSE6230_AVX512F_INTRINSICS_SUPPORTED
+	REGISTRY_TEMPLATE_KERNEL("int64 + AVX-512", typed_vector_max_i64, avx512f, sizeof(int64_t), 8, 0, vector_max<int64_t, isa_avx512f>),
+#endif
+
+	REGISTRY_TEMPLATE_KERNEL("uint64", typed_vector_max_u64, naive, sizeof(uint64_t), 1, 0, vector_max<uint64_t, isa_naive>),
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+	REGISTRY_TEMPLATE_KERNEL("uint64 + SSE2", typed_vector_max_u64, sse2, sizeof(uint64_t), 2, 0, vector_max<uint64_t, isa_sse2>),
+#endif
+#ifdef CSE6230_AVX2_INTRINSICS_SUPPORTED
+	REGISTRY_TEMPLATE_KERNEL("uint64 + AVX2", typed_vector_max_u64, avx2, sizeof(uint64_t), 4, 0, vector_max<uint64_t, isa_avx2>),
+#endif
+#ifdef CSE6230_AVX512F_INTRINSICS_SUPPORTED
+	REGISTRY_TEMPLATE_KERNEL("uint64 + AVX-512", typed_vector_max_u64, avx512f, sizeof(uint64_t), 8, 0, vector_max<uint64_t, isa_avx512f>),
+#endif
+
+	REGISTRY_TEMPLATE_KERNEL("bfloat16", typed_vector_max_bf16, naive, sizeof(bfloat16), 1, 0, vector_max<bfloat16, isa_naive>),
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+	REGISTRY_TEMPLATE_KERNEL("bfloat16 + SSE2", typed_vector_max_bf16, sse2, sizeof(bfloat16), 4, 0, vector_max<bfloat16, isa_sse2>),
+#endif
+#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+	REGISTRY_TEMPLATE_KERNEL("bfloat16 + AVX", typed_vector_max_bf16, avx, sizeof(bfloat16), 8, 0, vector_max<bfloat16, isa_avx>),
+#endif
+#ifdef CSE6230_AVX2_INTRINSICS_SUPPORTED
+	REGISTRY_TEMPLATE_KERNEL("bfloat16 + AVX2", typed_vector_max_bf16, avx2, sizeof(bfloat16), 8, 0, vector_max<bfloat16, isa_avx2>),
+#endif
+#ifdef CSE6230_AVX512F_INTRINSICS_SUPPORTED
+	REGISTRY_TEMPLATE_KERNEL("bfloat16 + AVX-512", typed_vector_max_bf16, avx512f, sizeof(bfloat16), 16, 0, vector_max<bfloat16, isa_avx512f>),
+#endif
+
+	REGISTRY_TEMPLATE_KERNEL("int32", typed_vector_add_saturated_i32, naive, sizeof(int32_t), 1, 0, vector_add_saturated<int32_t, isa_naive>),
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+	REGISTRY_TEMPLATE_KERNEL("int32 + SSE2", typed_vector_add_saturated_i32, sse2, sizeof(int32_t), 4, 0, vector_add_saturated<int32_t, isa_sse2>),
+#endif
+#ifdef CSE6230_AVX2_INTRINSICS_SUPPORTED
+	REGISTRY_TEMPLATE_KERNEL("int32 + AVX2", typed_vector_add_saturated_i32, avx2, sizeof(int32_t), 8, 0, vector_add_saturated<int32_t, isa_avx2>),
+#endif
+#ifdef CSE6230_AVX512F_INTRINSICS_SUPPORTED
+	REGISTRY_TEMPLATE_KERNEL("int32 + AVX-512", typed_vector_add_saturated_i32, avx512f, sizeof(int32_t), 16, 0, vector_add_saturated<int32_t, isa_avx512f>),
+#endif
+
+	REGISTRY_TEMPLATE_KERNEL("uint32", typed_vector_add_saturated_u32, naive, sizeof(uint32_t), 1, 0, vector_add_saturated<uint32_t, isa_naive>),
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+	REGISTRY_TEMPLATE_KERNEL("uint32 + SSE2", typed_vector_add_saturated_u32, sse2, sizeof(uint32_t), 4, 0, vector_add_saturated<uint32_t, isa_sse2>),
+#endif
+#ifdef CSE6230_AVX2_INTRINSICS_SUPPORTED
+	REGISTRY_TEMPLATE_KERNEL("uint32 + AVX2", typed_vector_add_saturated_u32, avx2, sizeof(uint32_t), 8, 0, vector_add_saturated<uint32_t, isa_avx2>),
+#endif
+#ifdef CSE6230_AVX512F_INTRINSICS_SUPPORTED
+	REGISTRY_TEMPLATE_KERNEL("uint32 + AVX-512", typed_vector_add_saturated_u32, avx512f, sizeof(uint32_t), 16, 0, vector_add_saturated<uint32_t, isa_avx512f>),
+#endif
+
+	REGISTRY_TEMPLATE_KERNEL("int64", typed_vector_add_saturated_i64, naive, sizeof(int64_t), 1, 0, vector_add_saturated<int64_t, isa_naive>),
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+	REGISTRY_TEMPLATE_KERNEL("int64 + SSE2", typed_vector_add_saturated_i64, sse2, sizeof(int64_t), 2, 0, vector_add_saturated<int64_t, isa_sse2>),
+#endif
+#ifdef CSE6230_AVX2_INTRINSICS_SUPPORTED
+	REGISTRY_TEMPLATE_KERNEL("int64 + AVX2", typed_vector_add_saturated_i64, avx2, sizeof(int64_t), 4, 0, vector_add_saturated<int64_t, isa_avx2>),
+#endif
+#ifdef CSE6230_AVX512F_INTRINSICS_SUPPORTED
+	REGISTRY_TEMPLATE_KERNEL("int64 + AVX-512", typed_vector_add_saturated_i64, avx512f, sizeof(int64_t), 8, 0, vector_add_saturated<int64_t, isa_avx512f>),
+#endif
+
+	REGISTRY_TEMPLATE_KERNEL("uint64", typed_vector_add_saturated_u64, naive, sizeof(uint64_t), 1, 0, vector_add_saturated<uint64_t, isa_naive>),
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+	REGISTRY_TEMPLATE_KERNEL("uint64 + SSE2", typed_vector_add_saturated_u64, sse2, sizeof(uint64_t), 2, 0, vector_add_saturated<uint64_t, isa_sse2>),
+#endif
+#ifdef CSE6230_AVX2_INTRINSICS_SUPPORTED
+	REGISTRY_TEMPLATE_KERNEL("uint64 + AVX2", typed_vector_add_saturated_u64, avx2, sizeof(uint64_t), 4, 0, vector_add_saturated<uint64_t, isa_avx2>),
+#endif
+#ifdef CSE6230_AVX512F_INTRINSICS_SUPPORTED
+	REGISTRY_TEMPLATE_KERNEL("uint64 + AVX-512", typed_vector_add_saturated_u64, avx512f, sizeof(uint64_t), 8, 0, vector_add_saturated<uint64_t, isa_avx512f>),
+#endif
+
+	CSE6230_FOREACH_FIXED_LENGTH(REGISTRY_FIXED_KERNEL, vector_add_fixed, vector_add_fixed, isa_naive, naive, "Naive", 1)
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+	CSE6230_FOREACH_FIXED_LENGTH(REGISTRY_FIXED_KERNEL, vector_add_fixed, vector_add_fixed, isa_sse2, sse2, "SSE2", 2)
+#endif
+#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+	CSE6230_FOREACH_FIXED_LENGTH(REGISTRY_FIXED_KERNEL, vector_add_fixed, vector_add_fixed, isa_avx, avx, "AVX", 4)
+#endif
+#ifdef CSE6230_AVX512F_INTRINSICS_SUPPORTED
+	CSE6230_FOREACH_FIXED_LENGTH(REGISTRY_FIXED_KERNEL, vector_add_fixed, vector_add_fixed, isa_avx512f, avx512f, "AVX-512", 8)
+#endif
+
+	CSE6230_FOREACH_FIXED_LENGTH(REGISTRY_FIXED_KERNEL, vector_max_fixed, vector_max_fixed, isa_naive, naive, "Naive", 1)
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+	CSE6230_FOREACH_FIXED_LENGTH(REGISTRY_FIXED_KERNEL, vector_max_fixed, vector_max_fixed, isa_sse2, sse2, "SSE2", 2)
+#endif
+#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+	CSE6230_FOREACH_FIXED_LENGTH(REGISTRY_FIXED_KERNEL, vector_max_fixed, vector_max_fixed, isa_avx, avx, "AVX", 4)
+#endif
+#ifdef CSE6230_AVX512F_INTRINSICS_SUPPORTED
+	CSE6230_FOREACH_FIXED_LENGTH(REGISTRY_FIXED_KERNEL, vector_max_fixed, vector_max_fixed, isa_avx512f, avx512f, "AVX-512", 8)
+#endif
+
+	REGISTRY_KERNEL(reduction_max_update_naive, "Naive", reduction_max_update, naive, sizeof(double), 1),
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+	REGISTRY_KERNEL(reduction_max_update_sse2, "SSE2", reduction_max_update, sse2, sizeof(double), 2),
+#endif
+#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+	REGISTRY_KERNEL(reduction_max_update_avx, "AVX", reduction_max_update, avx, sizeof(double), 4),
+#endif
+#ifdef CSE6230_AVX512F_INTRINSICS_SUPPORTED
+	REGISTRY_KERNEL(reduction_max_update_avx512f, "AVX-512", reduction_max_update, avx512f, sizeof(double), 8),
+#endif
+
+	REGISTRY_KERNEL(reduction_min_update_naive, "Naive", reduction_min_update, naive, sizeof(double), 1),
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+	REGISTRY_KERNEL(reduction_min_update_sse2, "SSE2", reduction_min_update, sse2, sizeof(double), 2),
+#endif
+#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+	REGISTRY_KERNEL(reduction_min_update_avx, "AVX", reduction_min_update, avx, sizeof(double), 4),
+#endif
+#ifdef CSE6230_AVX512F_INTRINSICS_SUPPORTED
+	REGISTRY_KERNEL(reduction_min_update_avx512f, "AVX-512", reduction_min_update, avx512f, sizeof(double), 8),
+#endif
+
+	REGISTRY_KERNEL(reduction_argmax_update_naive, "Naive", reduction_argmax_update, naive, sizeof(double), 1),
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+	REGISTRY_KERNEL(reduction_argmax_update_sse2, "SSE2", reduction_argmax_update, sse2, sizeof(double), 2),
+#endif
+#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+	REGISTRY_KERNEL(reduction_argmax_update_avx, "AVX", reduction_argmax_update, avx, sizeof(double), 4),
+#endif
+#ifdef CSE6230_AVX512F_INTRINSICS_SUPPORTED
+	REGISTRY_KERNEL(reduction_argmax_update_avx512f, "AVX-512", reduction_argmax_update, avx512f, sizeof(double), 8),
+#endif
+
+	REGISTRY_KERNEL(reduction_sum_update_naive, "Naive", reduction_sum_update, naive, sizeof(double), 1),
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+	REGISTRY_KERNEL(reduction_sum_update_sse2, "SSE2", reduction_sum_update, sse2, sizeof(double), 2),
+#endif
+#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+	REGISTRY_KERNEL(reduction_sum_update_avx, "AVX", reduction_sum_update, avx, sizeof(double), 4),
+#endif
+#ifdef CSE6230_AVX512F_INTRINSICS_SUPPORTED
+	REGISTRY_KERNEL(reduction_sum_update_avx512f, "AVX-512", reduction_sum_update, avx512f, sizeof(double), 8),
+#endif
+
+	REGISTRY_KERNEL(reproducible_sum_naive, "Naive", reproducible_sum, naive, sizeof(double), 1),
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+	REGISTRY_KERNEL(reproducible_sum_sse2, "SSE2", reproducible_sum, sse2, sizeof(double), 2),
+#endif
+#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+	REGISTRY_KERNEL(reproducible_sum_avx, "AVX", reproducible_sum, avx, sizeof(double), 4),
+#endif
+#ifdef CSE6230_AVX512F_INTRINSICS_SUPPORTED
+	REGISTRY_KERNEL(reproducible_sum_avx512f, "AVX-512", reproducible_sum, avx512f, sizeof(double), 8),
+#endif
+
+	REGISTRY_KERNEL(vector_topk_naive, "Naive", vector_topk, naive, sizeof(double), 1),
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+	REGISTRY_KERNEL(vector_topk_sse2, "SSE2", vector_topk, sse2, sizeof(double), 2),
+#endif
+#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+	REGISTRY_KERNEL(vector_topk_avx, "AVX", vector_topk, avx, sizeof(double), 4),
+#endif
+#ifdef CSE6230_AVX512F_INTRINSICS_SUPPORTED
+	REGISTRY_KERNEL(vector_topk_avx512f, "AVX-512", vector_topk, avx512f, sizeof(double), 8),
+#endif
+
+	REGISTRY_KERNEL(vector_inclusive_scan_naive, "Naive", vector_inclusive_scan, naive, sizeof(double), 1),
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+	REGISTRY_KERNEL(vector_inclusive_scan_sse2, "SSE2", vector_inclusive_scan, sse2, sizeof(double), 2),
+	REGISTRY_KERNEL(vector_inclusive_scan_sse2_aligned, "SSE2 + aligned array", vector_inclusive_scan, sse2, 16, 2),
+#endif
+#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+	REGISTRY_KERNEL(vector_inclusive_scan_avx, "AVX", vector_inclusive_scan, avx, sizeof(double), 4),
+	REGISTRY_KERNEL(vector_inclusive_scan_avx_aligned, "AVX + aligned array", vector_inclusive_scan, avx, 32, 4),
+	REGISTRY_KERNEL(vector_inclusive_scan_avx_unrolled, "AVX + unrolling", vector_inclusive_scan, avx, sizeof(double), 4),
+#endif
+#ifdef CSE6230_AVX512F_INTRINSICS_SUPPORTED
+	REGISTRY_KERNEL(vector_inclusive_scan_avx512f, "AVX-512", vector_inclusive_scan, avx512f, sizeof(double), 8),
+#endif
+
+	REGISTRY_KERNEL(vector_exclusive_scan_naive, "Naive", vector_exclusive_scan, naive, sizeof(double), 1),
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+	REGISTRY_KERNEL(vector_exclusive_scan_sse2, "SSE2", vector_exclusive_scan, sse2, sizeof(double), 2),
+#endif
+#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+	REGISTRY_KERNEL(vector_exclusive_scan_avx, "AVX", vector_exclusive_scan, avx, sizeof(double), 4),
+#endif
+#ifdef CSE6230_AVX512F_INTRINSICS_SUPPORTED
+	REGISTRY_KERNEL(vector_exclusive_scan_avx512f, "AVX-512", vector_exclusive_scan, avx512f, sizeof(double), 8),
+#endif
+
+	REGISTRY_KERNEL(vector_add_strided_naive, "Naive", vector_add_strided, naive, sizeof(double), 1),
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+	REGISTRY_KERNEL(vector_add_strided_sse2, "SSE2", vector_add_strided, sse2, sizeof(double), 2),
+#endif
+#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+	REGISTRY_KERNEL(vector_add_strided_avx, "AVX", vector_add_strided, avx, sizeof(double), 4),
+#endif
+#ifdef CSE6230_AVX2_INTRINSICS_SUPPORTED
+	REGISTRY_KERNEL(vector_add_strided_avx2, "AVX2", vector_add_strided, avx2, sizeof(double), 4),
+#endif
+#ifdef CSE6230_AVX512F_INTRINSICS_SUPPORTED
+	REGISTRY_KERNEL(vector_add_strided_avx512f, "AVX-512", vector_add_strided, avx512f, sizeof(double), 8),
+#endif
+
+	REGISTRY_KERNEL(vector_max_strided_naive, "Naive", vector_max_strided, naive, sizeof(double), 1),
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+	REGISTRY_KERNEL(vector_max_strided_sse2, "SSE2", vector_max_strided, sse2, sizeof(double), 2),
+#endif
+#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+	REGISTRY_KERNEL(vector_max_strided_avx, "AVX", vector_max_strided, avx, sizeof(double), 4),
+#endif
+#ifdef CSE6230_AVX2_INTRINSICS_SUPPORTED
+	REGISTRY_KERNEL(vector_max_strided_avx2, "AVX2", vector_max_strided, avx2, sizeof(double), 4),
+#endif
+#ifdef CSE6230_AVX512F_INTRINSICS_SUPPORTED
+	REGISTRY_KERNEL(vector_max_strided_avx512f, "AVX-512", vector_max_strided, avx512f, sizeof(double), 8),
+#endif
+};
+
+const size_t vector_registry_kernels_count = sizeof(vector_registry_kernels) / sizeof(vector_registry_kernels[0]);
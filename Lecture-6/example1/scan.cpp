@@ -0,0 +1,387 @@
+/******************************************************************************\
+ *                                                                            *
+ * Copyright (c) 2012 Marat Dukhan                                            *
+ *                                                                            *
+ * This software is provided 'as-is', without any express or implied          *
+ * warranty. In no event will the authors be held liable for any damages      *
+ * arising from the use of this software.                                     *
+ *                                                                            *
+ * Permission is granted to anyone to use this software for any purpose,      *
+ * including commercial applications, and to alter it and redistribute it     *
+ * freely, subject to the following restrictions:                             *
+ *                                                                            *
+ * 1. The origin of this software must not be misrepresented; you must not    *
+ * claim that you wrote the original software. If you use this software       *
+ * in a product, an acknowledgment in the product documentation would be      *
+ * appreciated but is not required.                                           *
+ *                                                                            *
+ * 2. Altered source versions must be plainly marked as such, and must not be *
+ * misrepresented as being the original software.                             *
+ *                                                                            *
+ * 3. This notice may not be removed or altered from any source               *
+ * distribution.                                                              *
+ *                                                                            *
+\******************************************************************************/
+
+#include <scan.hpp>
+#include <thread>
+#include <vector>
+#if defined(CSE6230_SSE2_INTRINSICS_SUPPORTED) || defined(CSE6230_AVX_INTRINSICS_SUPPORTED)
+	#if defined(__GNUC__)
+		#include <x86intrin.h>
+	#elif defined(_MSC_VER)
+		#include <intrin.h>
+	#else
+		#error Intrinsics headers are not included: unknown compiler
+	#endif
+#endif
+
+// Every thread of the parallel scans gets at least this many elements
+static const size_t scan_parallel_min_length = 65536;
+
+void vector_inclusive_scan_naive(const double *CSE6230_RESTRICT xPointer, double *CSE6230_RESTRICT yPointer, size_t length) {
+	double sum = 0.0;
+	for (; length != 0; length -= 1) {
+		const double x = *xPointer; // Load x
+		sum += x; // Update running sum
+		*yPointer = sum; // Store prefix sum
+
+		// Advance pointers to the next elements
+		xPointer += 1;
+		yPointer += 1;
+	}
+}
+
+void vector_exclusive_scan_naive(const double *CSE6230_RESTRICT xPointer, double *CSE6230_RESTRICT yPointer, size_t length) {
+	double sum = 0.0;
+	for (; length != 0; length -= 1) {
+		const double x = *xPointer; // Load x
+		*yPointer = sum; // Store prefix sum of the previous elements
+		sum += x; // Update running sum
+
+		// Advance pointers to the next elements
+		xPointer += 1;
+		yPointer += 1;
+	}
+}
+
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+// Prefix sums of two elements: [x0, x0 + x1]
+static inline __m128d scan_sse2(__m128d x) {
+	return _mm_add_pd(x, _mm_unpacklo_pd(_mm_setzero_pd(), x));
+}
+
+void vector_inclusive_scan_sse2(const double *CSE6230_RESTRICT xPointer, double *CSE6230_RESTRICT yPointer, size_t length) {
+	__m128d sum = _mm_setzero_pd(); // Running sum in both elements
+	// Process arrays by two elements at an iteration
+	for (; length >= 2; length -= 2) {
+		const __m128d x = _mm_loadu_pd(xPointer); // Load two x elements
+		const __m128d y = _mm_add_pd(scan_sse2(x), sum); // Compute two prefix sums
+		_mm_storeu_pd(yPointer, y); // Store two prefix sums
+		sum = _mm_unpackhi_pd(y, y); // Broadcast the last prefix sum
+
+		// Advance pointers to the next two elements
+		xPointer += 2;
+		yPointer += 2;
+	}
+	// Process remaining element (if any)
+	if (length != 0) {
+		*yPointer = _mm_cvtsd_f64(sum) + *xPointer;
+	}
+}
+
+void vector_inclusive_scan_sse2_aligned(const double *CSE6230_RESTRICT xPointer, double *CSE6230_RESTRICT yPointer, size_t length) {
+	__m128d sum = _mm_setzero_pd(); // Running sum in both elements
+	// Process arrays by two elements at an iteration
+	for (; length >= 2; length -= 2) {
+		const __m128d x = _mm_load_pd(xPointer); // Aligned (!) load two x elements
+		const __m128d y = _mm_add_pd(scan_sse2(x), sum); // Compute two prefix sums
+		_mm_store_pd(yPointer, y); // Aligned (!) store two prefix sums
+		sum = _mm_unpackhi_pd(y, y); // Broadcast the last prefix sum
+
+		// Advance pointers to the next two elements
+		xPointer += 2;
+		yPointer += 2;
+	}
+	// Process remaining element (if any)
+	if (length != 0) {
+		*yPointer = _mm_cvtsd_f64(sum) + *xPointer;
+	}
+}
+
+void vector_exclusive_scan_sse2(const double *CSE6230_RESTRICT xPointer, double *CSE6230_RESTRICT yPointer, size_t length) {
+	__m128d sum = _mm_setzero_pd(); // Running sum in both elements
+	// Process arrays by two elements at an iteration
+	for (; length >= 2; length -= 2) {
+		const __m128d x = _mm_loadu_pd(xPointer); // Load two x elements
+		const __m128d y = _mm_add_pd(_mm_unpacklo_pd(_mm_setzero_pd(), x), sum); // Compute two prefix sums of the previous elements
+		_mm_storeu_pd(yPointer, y); // Store two prefix sums
+		sum = _mm_add_pd(sum, _mm_add_pd(x, _mm_shuffle_pd(x, x, 1))); // Add both elements to the running sum
+
+		// Advance pointers to the next two elements
+		xPointer += 2;
+		yPointer += 2;
+	}
+	// Process remaining element (if any)
+	if (length != 0) {
+		*yPointer = _mm_cvtsd_f64(sum);
+	}
+}
+#endif
+
+#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+// Shifts the elements up by one: [0, x0, x1, x2]
+static inline __m256d shift1_avx(__m256d x) {
+	const __m256d x01 = _mm256_permute2f128_pd(x, x, 0x08); // [0, 0, x0, x1]
+	return _mm256_shuffle_pd(x01, x, 0x4);
+}
+
+// Shifts the elements up by two: [0, 0, x0, x1]
+static inline __m256d shift2_avx(__m256d x) {
+	return _mm256_permute2f128_pd(x, x, 0x08);
+}
+
+// Broadcasts the last element: [x3, x3, x3, x3]
+static inline __m256d broadcast3_avx(__m256d x) {
+	const __m256d x3 = _mm256_permute_pd(x, 0xF); // [x1, x1, x3, x3]
+	return _mm256_permute2f128_pd(x3, x3, 0x11);
+}
+
+// Prefix sums of four elements: [x0, x0 + x1, x0 + x1 + x2, x0 + x1 + x2 + x3]
+static inline __m256d scan_avx(__m256d x) {
+	x = _mm256_add_pd(x, shift1_avx(x));
+	return _mm256_add_pd(x, shift2_avx(x));
+}
+
+void vector_inclusive_scan_avx(const double *CSE6230_RESTRICT xPointer, double *CSE6230_RESTRICT yPointer, size_t length) {
+	__m256d sum = _mm256_setzero_pd(); // Running sum in all elements
+	// Process arrays by four elements at an iteration
+	for (; length >= 4; length -= 4) {
+		const __m256d x = _mm256_loadu_pd(xPointer); // Load four x elements
+		const __m256d y = _mm256_add_pd(scan_avx(x), sum); // Compute four prefix sums
+		_mm256_storeu_pd(yPointer, y); // Store four prefix sums
+		sum = broadcast3_avx(y); // Broadcast the last prefix sum
+
+		// Advance pointers to the next four elements
+		xPointer += 4;
+		yPointer += 4;
+	}
+	// Process remaining elements (if any)
+	double runningSum = _mm256_cvtsd_f64(sum);
+	for (; length != 0; length -= 1) {
+		runningSum += *xPointer;
+		*yPointer = runningSum;
+
+		// Advance pointers to the next elements
+		xPointer += 1;
+		yPointer += 1;
+	}
+}
+
+void vector_inclusive_scan_avx_aligned(const double *CSE6230_RESTRICT xPointer, double *CSE6230_RESTRICT yPointer, size_t length) {
+	__m256d sum = _mm256_setzero_pd(); // Running sum in all elements
+	// Process arrays by four elements at an iteration
+	for (; length >= 4; length -= 4) {
+		const __m256d x = _mm256_load_pd(xPointer); // Aligned (!) load four x elements
+		const __m256d y = _mm256_add_pd(scan_avx(x), sum); // Compute four prefix sums
+		_mm256_store_pd(yPointer, y); // Aligned (!) store four prefix sums
+		sum = broadcast3_avx(y); // Broadcast the last prefix sum
+
+		// Advance pointers to the next four elements
+		xPointer += 4;
+		yPointer += 4;
+	}
+	// Process remaining elements (if any)
+	double runningSum = _mm256_cvtsd_f64(sum);
+	for (; length != 0; length -= 1) {
+		runningSum += *xPointer;
+		*yPointer = runningSum;
+
+		// Advance pointers to the next elements
+		xPointer += 1;
+		yPointer += 1;
+	}
+}
+
+void vector_inclusive_scan_avx_unrolled(const double *CSE6230_RESTRICT xPointer, double *CSE6230_RESTRICT yPointer, size_t length) {
+	__m256d sum = _mm256_setzero_pd(); // Running sum in all elements
+	// Process arrays by eight elements at an iteration
+	// The in-register scans of the two vectors are independent: only the additions of the running sum form a dependency chain
+	for (; length >= 8; length -= 8) {
+		const __m256d xLow = _mm256_loadu_pd(xPointer); // Load four x elements
+		const __m256d xHigh = _mm256_loadu_pd(xPointer + 4); // Load four more x elements
+		const __m256d scanLow = scan_avx(xLow);
+		const __m256d scanHigh = scan_avx(xHigh);
+		const __m256d yLow = _mm256_add_pd(scanLow, sum); // Compute four prefix sums
+		const __m256d yHigh = _mm256_add_pd(scanHigh, broadcast3_avx(yLow)); // Compute four more prefix sums
+		_mm256_storeu_pd(yPointer, yLow); // Store four prefix sums
+		_mm256_storeu_pd(yPointer + 4, yHigh); // Store four more prefix sums
+		sum = broadcast3_avx(yHigh); // Broadcast the last prefix sum
+
+		// Advance pointers to the next eight elements
+		xPointer += 8;
+		yPointer += 8;
+	}
+	// Process remaining elements (if any)
+	double runningSum = _mm256_cvtsd_f64(sum);
+	for (; length != 0; length -= 1) {
+		runningSum += *xPointer;
+		*yPointer = runningSum;
+
+		// Advance pointers to the next elements
+		xPointer += 1;
+		yPointer += 1;
+	}
+}
+
+void vector_exclusive_scan_avx(const double *CSE6230_RESTRICT xPointer, double *CSE6230_RESTRICT yPointer, size_t length) {
+	__m256d sum = _mm256_setzero_pd(); // Running sum in all elements
+	// Process arrays by four elements at an iteration
+	for (; length >= 4; length -= 4) {
+		const __m256d x = _mm256_loadu_pd(xPointer); // Load four x elements
+		const __m256d scan = scan_avx(x);
+		const __m256d y = _mm256_add_pd(shift1_avx(scan), sum); // Compute four prefix sums of the previous elements
+		_mm256_storeu_pd(yPointer, y); // Store four prefix sums
+		sum = _mm256_add_pd(sum, broadcast3_avx(scan)); // Add all four elements to the running sum
+
+		// Advance pointers to the next four elements
+		xPointer += 4;
+		yPointer += 4;
+	}
+	// Process remaining elements (if any)
+	double runningSum = _mm256_cvtsd_f64(sum);
+	for (; length != 0; length -= 1) {
+		*yPointer = runningSum;
+		runningSum += *xPointer;
+
+		// Advance pointers to the next elements
+		xPointer += 1;
+		yPointer += 1;
+	}
+}
+#endif
+
+#ifdef CSE6230_AVX512F_INTRINSICS_SUPPORTED
+// Shifts the elements up by count, filling the lower elements with zeroes
+template <int Count>
+static inline __m512d shift_avx512f(__m512d x) {
+	const __m512i indices = _mm512_set_epi64(7 - Count, 6 - Count, 5 - Count, 4 - Count, 3 - Count, 2 - Count, 1 - Count, 0 - Count);
+	return _mm512_maskz_permutexvar_pd(__mmask8(0xFF << Count), indices, x);
+}
+
+static inline __m512d broadcast7_avx512f(__m512d x) {
+	return _mm512_permutexvar_pd(_mm512_set1_epi64(7), x);
+}
+
+// Prefix sums of eight elements
+static inline __m512d scan_avx512f(__m512d x) {
+	x = _mm512_add_pd(x, shift_avx512f<1>(x));
+	x = _mm512_add_pd(x, shift_avx512f<2>(x));
+	return _mm512_add_pd(x, shift_avx512f<4>(x));
+}
+
+void vector_inclusive_scan_avx512f(const double *CSE6230_RESTRICT xPointer, double *CSE6230_RESTRICT yPointer, size_t length) {
+	__m512d sum = _mm512_setzero_pd(); // Running sum in all elements
+	// Process arrays by eight elements at an iteration
+	for (; length >= 8; length -= 8) {
+		const __m512d x = _mm512_loadu_pd(xPointer); // Load eight x elements
+		const __m512d y = _mm512_add_pd(scan_avx512f(x), sum); // Compute eight prefix sums
+		_mm512_storeu_pd(yPointer, y); // Store eight prefix sums
+		sum = broadcast7_avx512f(y); // Broadcast the last prefix sum
+
+		// Advance pointers to the next eight elements
+		xPointer += 8;
+		yPointer += 8;
+	}
+	// Process remaining elements (if any) with masked operations
+	if (length != 0) {
+		const __mmask8 mask = __mmask8((1u << length) - 1);
+		const __m512d x = _mm512_maskz_loadu_pd(mask, xPointer);
+		_mm512_mask_storeu_pd(yPointer, mask, _mm512_add_pd(scan_avx512f(x), sum));
+	}
+}
+
+void vector_exclusive_scan_avx512f(const double *CSE6230_RESTRICT xPointer, double *CSE6230_RESTRICT yPointer, size_t length) {
+	__m512d sum = _mm512_setzero_pd(); // Running sum in all elements
+	// Process arrays by eight elements at an iteration
+	for (; length >= 8; length -= 8) {
+		const __m512d x = _mm512_loadu_pd(xPointer); // Load eight x elements
+		const __m512d scan = scan_avx512f(x);
+		const __m512d y = _mm512_add_pd(shift_avx512f<1>(scan), sum); // Compute eight prefix sums of the previous elements
+		_mm512_storeu_pd(yPointer, y); // Store eight prefix sums
+		sum = _mm512_add_pd(sum, broadcast7_avx512f(scan)); // Add all eight elements to the running sum
+
+		// Advance pointers to the next eight elements
+		xPointer += 8;
+		yPointer += 8;
+	}
+	// Process remaining elements (if any) with masked operations
+	if (length != 0) {
+		const __mmask8 mask = __mmask8((1u << length) - 1);
+		const __m512d x = _mm512_maskz_loadu_pd(mask, xPointer);
+		_mm512_mask_storeu_pd(yPointer, mask, _mm512_add_pd(shift_avx512f<1>(scan_avx512f(x)), sum));
+	}
+}
+#endif
+
+// Runs function(block) for every block on its own thread; the calling thread takes block 0
+template <typename Function>
+static void run_blocks(size_t blocksCount, const Function& function) {
+	std::vector<std::thread> threads;
+	for (size_t block = 1; block < blocksCount; block++) {
+		threads.push_back(std::thread(function, block));
+	}
+	function(size_t(0));
+	for (size_t thread = 0; thread < threads.size(); thread++) {
+		threads[thread].join();
+	}
+}
+
+static void parallel_scan(vector_scan_function scan, bool exclusive, const double *CSE6230_RESTRICT xPointer, double *CSE6230_RESTRICT yPointer, size_t length, size_t threadsCount) {
+	if (threadsCount == 0) {
+		threadsCount = std::thread::hardware_concurrency();
+	}
+	const size_t maxThreadsCount = length / scan_parallel_min_length;
+	if (threadsCount > maxThreadsCount) {
+		threadsCount = maxThreadsCount;
+	}
+	if (threadsCount <= 1) {
+		scan(xPointer, yPointer, length);
+		return;
+	}
+
+	// Pass 1: scan every block independently
+	run_blocks(threadsCount, [=](size_t block) {
+		const size_t blockStart = length * block / threadsCount;
+		const size_t blockEnd = length * (block + 1) / threadsCount;
+		scan(xPointer + blockStart, yPointer + blockStart, blockEnd - blockStart);
+	});
+
+	// Sums of the blocks before every block
+	std::vector<double> offsets(threadsCount);
+	double sum = 0.0;
+	for (size_t block = 0; block < threadsCount; block++) {
+		offsets[block] = sum;
+		const size_t blockLast = length * (block + 1) / threadsCount - 1;
+		sum += exclusive ? yPointer[blockLast] + xPointer[blockLast] : yPointer[blockLast];
+	}
+
+	// Pass 2: add the offsets to the blocks after the first
+	run_blocks(threadsCount - 1, [=, &offsets](size_t block) {
+		block += 1;
+		const size_t blockStart = length * block / threadsCount;
+		const size_t blockEnd = length * (block + 1) / threadsCount;
+		const double offset = offsets[block];
+		for (size_t i = blockStart; i < blockEnd; i++) {
+			yPointer[i] += offset;
+		}
+	});
+}
+
+void vector_inclusive_scan_parallel(vector_scan_function scan, const double *CSE6230_RESTRICT xPointer, double *CSE6230_RESTRICT yPointer, size_t length, size_t threadsCount) {
+	parallel_scan(scan, false, xPointer, yPointer, length, threadsCount);
+}
+
+void vector_exclusive_scan_parallel(vector_scan_function scan, const double *CSE6230_RESTRICT xPointer, double *CSE6230_RESTRICT yPointer, size_t length, size_t threadsCount) {
+	parallel_scan(scan, true, xPointer, yPointer, length, threadsCount);
+}
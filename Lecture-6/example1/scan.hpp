@@ -0,0 +1,66 @@
+/******************************************************************************\
+ *                                                                            *
+ * Copyright (c) 2012 Marat Dukhan                                            *
+ *                                                                            *
+ * This software is provided 'as-is', without any express or implied          *
+ * warranty. In no event will the authors be held liable for any damages      *
+ * arising from the use of this software.                                     *
+ *                                                                            *
+ * Permission is granted to anyone to use this software for any purpose,      *
+ * including commercial applications, and to alter it and redistribute it     *
+ * freely, subject to the following restrictions:                             *
+ *                                                                            *
+ * 1. The origin of this software must not be misrepresented; you must not    *
+ * claim that you wrote the original software. If you use this software       *
+ * in a product, an acknowledgment in the product documentation would be      *
+ * appreciated but is not required.                                           *
+ *                                                                            *
+ * 2. Altered source versions must be plainly marked as such, and must not be *
+ * misrepresented as being the original software.                             *
+ *                                                                            *
+ * 3. This notice may not be removed or altered from any source               *
+ * distribution.                                                              *
+ *                                                                            *
+\******************************************************************************/
+
+#pragma once
+
+#include <compute.hpp>
+
+// Prefix sums of double arrays: the inclusive scan computes y[i] = x[0] + ... + x[i],
+// and the exclusive scan computes y[0] = 0, y[i] = x[0] + ... + x[i - 1].
+// SIMD versions compute the prefix sums of a vector in registers with shifts and adds, and add the running sum
+// of the previous vectors. Their results may differ from the naive version in the last bits because of rounding.
+// "aligned" versions require both arrays to be aligned on the vector size.
+typedef void (*vector_scan_function)(const double*, double*, size_t);
+
+extern "C" void vector_inclusive_scan_naive(const double *CSE6230_RESTRICT xPointer, double *CSE6230_RESTRICT yPointer, size_t length);
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+extern "C" void vector_inclusive_scan_sse2(const double *CSE6230_RESTRICT xPointer, double *CSE6230_RESTRICT yPointer, size_t length);
+extern "C" void vector_inclusive_scan_sse2_aligned(const double *CSE6230_RESTRICT xPointer, double *CSE6230_RESTRICT yPointer, size_t length);
+#endif
+#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+extern "C" void vector_inclusive_scan_avx(const double *CSE6230_RESTRICT xPointer, double *CSE6230_RESTRICT yPointer, size_t length);
+extern "C" void vector_inclusive_scan_avx_aligned(const double *CSE6230_RESTRICT xPointer, double *CSE6230_RESTRICT yPointer, size_t length);
+extern "C" void vector_inclusive_scan_avx_unrolled(const double *CSE6230_RESTRICT xPointer, double *CSE6230_RESTRICT yPointer, size_t length);
+#endif
+#ifdef CSE6230_AVX512F_INTRINSICS_SUPPORTED
+extern "C" void vector_inclusive_scan_avx512f(const double *CSE6230_RESTRICT xPointer, double *CSE6230_RESTRICT yPointer, size_t length);
+#endif
+
+extern "C" void vector_exclusive_scan_naive(const double *CSE6230_RESTRICT xPointer, double *CSE6230_RESTRICT yPointer, size_t length);
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+extern "C" void vector_exclusive_scan_sse2(const double *CSE6230_RESTRICT xPointer, double *CSE6230_RESTRICT yPointer, size_t length);
+#endif
+#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+extern "C" void vector_exclusive_scan_avx(const double *CSE6230_RESTRICT xPointer, double *CSE6230_RESTRICT yPointer, size_t length);
+#endif
+#ifdef CSE6230_AVX512F_INTRINSICS_SUPPORTED
+extern "C" void vector_exclusive_scan_avx512f(const double *CSE6230_RESTRICT xPointer, double *CSE6230_RESTRICT yPointer, size_t length);
+#endif
+
+// Two-pass block scans on threadsCount threads (0 = all CPUs): every thread scans its block of the array with scan,
+// then every block except the first is offset by the sum of the previous blocks.
+// scan must be an inclusive scan for vector_inclusive_scan_parallel, and an exclusive scan for vector_exclusive_scan_parallel.
+extern "C" void vector_inclusive_scan_parallel(vector_scan_function scan, const double *CSE6230_RESTRICT xPointer, double *CSE6230_RESTRICT yPointer, size_t length, size_t threadsCount);
+extern "C" void vector_exclusive_scan_parallel(vector_scan_function scan, const double *CSE6230_RESTRICT xPointer, double *CSE6230_RESTRICT yPointer, size_t length, size_t threadsCount);
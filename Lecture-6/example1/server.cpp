@@ -0,0 +1,627 @@
+/******************************************************************************\
+ *                                                                            *
+ * Copyright (c) 2012 Marat Dukhan                                            *
+ *                                                                            *
+ * This software is provided 'as-is', without any express or implied          *
+ * warranty. In no event will the authors be held liable for any damages      *
+ * arising from the use of this software.                                     *
+ *                                                                            *
+ * Permission is granted to anyone to use this software for any purpose,      *
+ * including commercial applications, and to alter it and redistribute it     *
+ * freely, subject to the following restrictions:                             *
+ *                                                                            *
+ * 1. The origin of this software must not be misrepresented; you must not    *
+ * claim that you wrote the original software. If you use this software       *
+ * in a product, an acknowledgment in the product documentation would be      *
+ * appreciated but is not required.                                           *
+ *                                                                            *
+ * 2. Altered source versions must be plainly marked as such, and must not be *
+ * misrepresented as being the original software.                             *
+ *                                                                            *
+ * 3. This notice may not be removed or altered from any source               *
+ * distribution.                                                              *
+ *                                                                            *
+\******************************************************************************/
+
+#include <server.hpp>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <limits.h>
+#include <math.h>
+#include <fcntl.h>
+#include <sched.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#include <new>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+// Atomics in the shared segment are accessed from several processes, which only works if they are lock-free
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "64-bit atomics must be lock-free");
+static_assert(std::atomic<uint32_t>::is_always_lock_free, "32-bit atomics must be lock-free");
+
+static const uint64_t server_magic = 0x43534536323330ull; // "CSE6230"
+// Number of cells in the job ring, must be a power of 2
+static const size_t server_ring_capacity = 1024;
+static const size_t server_cache_line = 64;
+static const size_t server_page_size = 4096;
+// Number of yields before an idle worker goes to sleep
+static const size_t idle_spins_limit = 256;
+
+enum server_operation {
+	server_operation_vector_add,
+	server_operation_vector_max
+};
+
+enum server_job_status {
+	server_job_posted,
+	server_job_done,
+	server_job_failed
+};
+
+struct kernel_server_job {
+	std::atomic<uint32_t> status;
+	uint32_t operation;
+	// Offsets of the operands from the beginning of the segment
+	uint64_t xOffset;
+	uint64_t yOffset;
+	uint64_t outputOffset;
+	uint64_t length;
+};
+
+struct server_cell {
+	std::atomic<uint64_t> sequence;
+	uint64_t jobOffset;
+};
+
+struct server_counter {
+	std::atomic<uint64_t> value;
+	char padding[server_cache_line - sizeof(std::atomic<uint64_t>)];
+};
+
+// Beginning of the shared segment, followed by the cells of the ring and the arena
+struct server_header {
+	std::atomic<uint64_t> magic; // Set when the segment is initialized
+	uint64_t segmentSize;
+	uint64_t cellsOffset;
+	uint64_t arenaOffset;
+	uint64_t arenaSize;
+	std::atomic<uint32_t> wakeups; // Futex for sleeping workers
+	std::atomic<uint32_t> sleepingCount;
+	server_counter enqueuePosition;
+	server_counter dequeuePosition;
+	server_counter arenaUsed;
+};
+
+struct kernel_server {
+	char* base;
+	size_t segmentSize;
+	// Private copy of the arena offset: the header is writable by the clients
+	size_t arenaOffset;
+	server_header* header;
+	server_cell* cells;
+	char name[NAME_MAX];
+	vector_add_function vector_add;
+	vector_max_function vector_max;
+	std::atomic<bool> stopping;
+	std::vector<std::thread> workers;
+};
+
+struct kernel_client {
+	char* base;
+	size_t segmentSize;
+	server_header* header;
+	server_cell* cells;
+};
+
+static size_t round_up(size_t size, size_t alignment) {
+	return (size + alignment - 1) / alignment * alignment;
+}
+
+// Futexes are shared between processes, so the private futex operations can not be used
+static void futex_wait(std::atomic<uint32_t>* word, uint32_t value) {
+	// The timeout guards against a wakeup which is missed between the check of the ring and the wait
+	const struct timespec timeout = { 0, 1000000 };
+	syscall(SYS_futex, reinterpret_cast<uint32_t*>(word), FUTEX_WAIT, value, &timeout, NULL, 0);
+}
+
+static void futex_wake(std::atomic<uint32_t>* word, int waitersCount) {
+	syscall(SYS_futex, reinterpret_cast<uint32_t*>(word), FUTEX_WAKE, waitersCount, NULL, NULL, 0);
+}
+
+static bool ring_push(server_header* header, server_cell* cells, uint64_t jobOffset) {
+	uint64_t position = header->enqueuePosition.value.load(std::memory_order_relaxed);
+	server_cell* cell;
+	for (;;) {
+		cell = &cells[position & (server_ring_capacity - 1)];
+		const uint64_t sequence = cell->sequence.load(std::memory_order_acquire);
+		const int64_t difference = int64_t(sequence - position);
+		if (difference == 0) {
+			if (header->enqueuePosition.value.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+				break;
+			}
+		} else if (difference < 0) {
+			// The ring is full
+			return false;
+		} else {
+			position = header->enqueuePosition.value.load(std::memory_order_relaxed);
+		}
+	}
+	cell->jobOffset = jobOffset;
+	cell->sequence.store(position + 1, std::memory_order_release);
+	return true;
+}
+
+static bool ring_pop(server_header* header, server_cell* cells, uint64_t& jobOffset) {
+	uint64_t position = header->dequeuePosition.value.load(std::memory_order_relaxed);
+	server_cell* cell;
+	for (;;) {
+		cell = &cells[position & (server_ring_capacity - 1)];
+		const uint64_t sequence = cell->sequence.load(std::memory_order_acquire);
+		const int64_t difference = int64_t(sequence - (position + 1));
+		if (difference == 0) {
+			if (header->dequeuePosition.value.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+				break;
+			}
+		} else if (difference < 0) {
+			// The ring is empty
+			return false;
+		} else {
+			position = header->dequeuePosition.value.load(std::memory_order_relaxed);
+		}
+	}
+	jobOffset = cell->jobOffset;
+	cell->sequence.store(position + server_ring_capacity, std::memory_order_release);
+	return true;
+}
+
+static bool is_ring_empty(const server_header* header) {
+	return header->enqueuePosition.value.load() == header->dequeuePosition.value.load();
+}
+
+// Returns true if count objects of size bytes starting at offset from the beginning of the segment are in the arena
+static bool is_in_arena(const kernel_server* server, uint64_t offset, uint64_t count, size_t size) {
+	if ((offset < server->arenaOffset) || (offset > server->segmentSize)) {
+		return false;
+	}
+	return count <= (server->segmentSize - offset) / size;
+}
+
+// Jobs come from other processes, so their fields are read once and checked before any operand is accessed.
+// Jobs with an unknown operation or operands outside of the arena fail without running a kernel.
+static void execute_job(kernel_server* server, kernel_server_job* job) {
+	const uint32_t operation = job->operation;
+	const uint64_t xOffset = job->xOffset;
+	const uint64_t yOffset = job->yOffset;
+	const uint64_t outputOffset = job->outputOffset;
+	const uint64_t length = job->length;
+	bool valid = false;
+	switch (operation) {
+		case server_operation_vector_add:
+			valid = is_in_arena(server, xOffset, length, sizeof(double)) &&
+				is_in_arena(server, yOffset, length, sizeof(double)) &&
+				is_in_arena(server, outputOffset, length, sizeof(double));
+			break;
+		case server_operation_vector_max:
+			valid = is_in_arena(server, xOffset, length, sizeof(double)) && is_in_arena(server, outputOffset, 1, sizeof(double));
+			break;
+	}
+	if (!valid) {
+		job->status.store(server_job_failed, std::memory_order_release);
+		return;
+	}
+
+	const double* xPointer = reinterpret_cast<const double*>(server->base + xOffset);
+	double* outputPointer = reinterpret_cast<double*>(server->base + outputOffset);
+	if (operation == server_operation_vector_add) {
+		server->vector_add(xPointer, reinterpret_cast<const double*>(server->base + yOffset), outputPointer, size_t(length));
+	} else {
+		server->vector_max(xPointer, outputPointer, size_t(length));
+	}
+	job->status.store(server_job_done, std::memory_order_release);
+}
+
+static void worker_thread(kernel_server* server, int cpu) {
+	if (cpu >= 0) {
+		cpu_set_t cpus;
+		CPU_ZERO(&cpus);
+		CPU_SET(cpu, &cpus);
+		sched_setaffinity(0, sizeof(cpus), &cpus);
+	}
+	server_header* header = server->header;
+	size_t idleSpins = 0;
+	for (;;) {
+		uint64_t jobOffset;
+		if (ring_pop(header, server->cells, jobOffset)) {
+			// A job outside of the arena can not even be marked as failed, so it is dropped
+			if (is_in_arena(server, jobOffset, 1, sizeof(kernel_server_job)) && (jobOffset % alignof(kernel_server_job) == 0)) {
+				execute_job(server, reinterpret_cast<kernel_server_job*>(server->base + jobOffset));
+			}
+			idleSpins = 0;
+			continue;
+		}
+		if (server->stopping.load(std::memory_order_acquire) && is_ring_empty(header)) {
+			return;
+		}
+		if (++idleSpins < idle_spins_limit) {
+			std::this_thread::yield();
+			continue;
+		}
+		// Sleep until a client posts a job
+		header->sleepingCount.fetch_add(1);
+		const uint32_t wakeups = header->wakeups.load();
+		if (is_ring_empty(header) && !server->stopping.load()) {
+			futex_wait(&header->wakeups, wakeups);
+		}
+		header->sleepingCount.fetch_sub(1);
+		idleSpins = 0;
+	}
+}
+
+kernel_server* kernel_server_create(const char* name, size_t arenaSize, size_t workersCount, vector_add_function vector_add, vector_max_function vector_max) {
+	if (strlen(name) >= NAME_MAX) {
+		return NULL;
+	}
+	cpu_set_t allowed;
+	CPU_ZERO(&allowed);
+	std::vector<int> cpus;
+	if (sched_getaffinity(0, sizeof(allowed), &allowed) == 0) {
+		for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+			if (CPU_ISSET(cpu, &allowed)) {
+				cpus.push_back(cpu);
+			}
+		}
+	}
+	if (workersCount == 0) {
+		workersCount = cpus.empty() ? 1 : cpus.size();
+	}
+
+	const size_t cellsOffset = round_up(sizeof(server_header), server_page_size);
+	const size_t arenaOffset = round_up(cellsOffset + server_ring_capacity * sizeof(server_cell), server_page_size);
+	arenaSize = round_up(arenaSize, server_page_size);
+	const size_t segmentSize = arenaOffset + arenaSize;
+
+	const int file = shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0600);
+	if (file < 0) {
+		return NULL;
+	}
+	if (ftruncate(file, off_t(segmentSize)) != 0) {
+		close(file);
+		shm_unlink(name);
+		return NULL;
+	}
+	void* segment = mmap(NULL, segmentSize, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+	close(file);
+	if (segment == MAP_FAILED) {
+		shm_unlink(name);
+		return NULL;
+	}
+	kernel_server* server = new (std::nothrow) kernel_server;
+	if (server == NULL) {
+		munmap(segment, segmentSize);
+		shm_unlink(name);
+		return NULL;
+	}
+	server->base = static_cast<char*>(segment);
+	server->segmentSize = segmentSize;
+	server->arenaOffset = arenaOffset;
+	server->header = new (segment) server_header;
+	server->cells = reinterpret_cast<server_cell*>(server->base + cellsOffset);
+	strcpy(server->name, name);
+	server->vector_add = vector_add;
+	server->vector_max = vector_max;
+	server->stopping.store(false, std::memory_order_relaxed);
+
+	server_header* header = server->header;
+	header->segmentSize = segmentSize;
+	header->cellsOffset = cellsOffset;
+	header->arenaOffset = arenaOffset;
+	header->arenaSize = arenaSize;
+	header->wakeups.store(0, std::memory_order_relaxed);
+	header->sleepingCount.store(0, std::memory_order_relaxed);
+	header->enqueuePosition.value.store(0, std::memory_order_relaxed);
+	header->dequeuePosition.value.store(0, std::memory_order_relaxed);
+	header->arenaUsed.value.store(0, std::memory_order_relaxed);
+	for (size_t cell = 0; cell < server_ring_capacity; cell++) {
+		new (&server->cells[cell]) server_cell;
+		server->cells[cell].sequence.store(cell, std::memory_order_relaxed);
+		server->cells[cell].jobOffset = 0;
+	}
+	header->magic.store(server_magic, std::memory_order_release);
+
+	for (size_t workerNumber = 0; workerNumber < workersCount; workerNumber++) {
+		const int cpu = cpus.empty() ? -1 : cpus[workerNumber % cpus.size()];
+		server->workers.push_back(std::thread(worker_thread, server, cpu));
+	}
+	return server;
+}
+
+void kernel_server_destroy(kernel_server* server) {
+	if (server == NULL) {
+		return;
+	}
+	server->stopping.store(true, std::memory_order_release);
+	server->header->wakeups.fetch_add(1);
+	futex_wake(&server->header->wakeups, INT_MAX);
+	for (size_t workerNumber = 0; workerNumber < server->workers.size(); workerNumber++) {
+		server->workers[workerNumber].join();
+	}
+	munmap(server->base, server->segmentSize);
+	shm_unlink(server->name);
+	delete server;
+}
+
+kernel_client* kernel_client_connect(const char* name) {
+	const int file = shm_open(name, O_RDWR, 0);
+	if (file < 0) {
+		return NULL;
+	}
+	struct stat status;
+	if ((fstat(file, &status) != 0) || (size_t(status.st_size) < sizeof(server_header))) {
+		close(file);
+		return NULL;
+	}
+	const size_t segmentSize = size_t(status.st_size);
+	void* segment = mmap(NULL, segmentSize, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+	close(file);
+	if (segment == MAP_FAILED) {
+		return NULL;
+	}
+	server_header* header = static_cast<server_header*>(segment);
+	if ((header->magic.load(std::memory_order_acquire) != server_magic) || (header->segmentSize != segmentSize)) {
+		munmap(segment, segmentSize);
+		return NULL;
+	}
+	kernel_client* client = new (std::nothrow) kernel_client;
+	if (client == NULL) {
+		munmap(segment, segmentSize);
+		return NULL;
+	}
+	client->base = static_cast<char*>(segment);
+	client->segmentSize = segmentSize;
+	client->header = header;
+	client->cells = reinterpret_cast<server_cell*>(client->base + header->cellsOffset);
+	return client;
+}
+
+void kernel_client_disconnect(kernel_client* client) {
+	if (client == NULL) {
+		return;
+	}
+	munmap(client->base, client->segmentSize);
+	delete client;
+}
+
+static void* arena_allocate(kernel_client* client, size_t size) {
+	server_header* header = client->header;
+	size = round_up(size, server_cache_line);
+	uint64_t used = header->arenaUsed.value.load(std::memory_order_relaxed);
+	do {
+		if (size > header->arenaSize - used) {
+			return NULL;
+		}
+	} while (!header->arenaUsed.value.compare_exchange_weak(used, used + size, std::memory_order_relaxed));
+	return client->base + header->arenaOffset + used;
+}
+
+double* kernel_client_allocate(kernel_client* client, size_t length) {
+	if (length > client->header->arenaSize / sizeof(double)) {
+		return NULL;
+	}
+	return static_cast<double*>(arena_allocate(client, length * sizeof(double)));
+}
+
+kernel_server_job* kernel_client_create_job(kernel_client* client) {
+	void* memory = arena_allocate(client, sizeof(kernel_server_job));
+	if (memory == NULL) {
+		return NULL;
+	}
+	kernel_server_job* job = new (memory) kernel_server_job;
+	job->status.store(server_job_done, std::memory_order_relaxed);
+	return job;
+}
+
+// Converts a pointer to an array of length doubles into its offset in the segment, or returns false if it is not in the arena
+static bool arena_offset(const kernel_client* client, const void* pointer, size_t length, uint64_t& offset) {
+	const char* arenaStart = client->base + client->header->arenaOffset;
+	const char* bytes = static_cast<const char*>(pointer);
+	if ((bytes < arenaStart) || (bytes > client->base + client->segmentSize)) {
+		return false;
+	}
+	offset = uint64_t(bytes - client->base);
+	return length <= (client->segmentSize - offset) / sizeof(double);
+}
+
+// Operands of the job must be set by the caller
+static bool post_job(kernel_client* client, kernel_server_job* job) {
+	uint64_t jobOffset;
+	if (!arena_offset(client, job, sizeof(kernel_server_job) / sizeof(double), jobOffset)) {
+		return false;
+	}
+	job->status.store(server_job_posted, std::memory_order_relaxed);
+	if (!ring_push(client->header, client->cells, jobOffset)) {
+		job->status.store(server_job_done, std::memory_order_relaxed);
+		return false;
+	}
+	if (client->header->sleepingCount.load() != 0) {
+		client->header->wakeups.fetch_add(1);
+		futex_wake(&client->header->wakeups, 1);
+	}
+	return true;
+}
+
+bool kernel_client_post_vector_add(kernel_client* client, kernel_server_job* job, const double* xPointer, const double* yPointer, double* sumPointer, size_t length) {
+	uint64_t xOffset, yOffset, sumOffset;
+	if (!kernel_server_job_is_done(job) ||
+		!arena_offset(client, xPointer, length, xOffset) ||
+		!arena_offset(client, yPointer, length, yOffset) ||
+		!arena_offset(client, sumPointer, length, sumOffset))
+	{
+		return false;
+	}
+	job->operation = server_operation_vector_add;
+	job->xOffset = xOffset;
+	job->yOffset = yOffset;
+	job->outputOffset = sumOffset;
+	job->length = length;
+	return post_job(client, job);
+}
+
+bool kernel_client_post_vector_max(kernel_client* client, kernel_server_job* job, const double* arrayPointer, double* maxPointer, size_t length) {
+	uint64_t arrayOffset, maxOffset;
+	if (!kernel_server_job_is_done(job) || !arena_offset(client, arrayPointer, length, arrayOffset) || !arena_offset(client, maxPointer, 1, maxOffset)) {
+		return false;
+	}
+	job->operation = server_operation_vector_max;
+	job->xOffset = arrayOffset;
+	job->yOffset = 0;
+	job->outputOffset = maxOffset;
+	job->length = length;
+	return post_job(client, job);
+}
+
+bool kernel_server_job_is_done(const kernel_server_job* job) {
+	return job->status.load(std::memory_order_acquire) != server_job_posted;
+}
+
+bool kernel_server_job_wait(const kernel_server_job* job) {
+	uint32_t status;
+	while ((status = job->status.load(std::memory_order_acquire)) == server_job_posted) {
+		std::this_thread::yield();
+	}
+	return status == server_job_done;
+}
+
+// Start barrier of the load generator, in memory shared with the client processes
+struct load_barrier {
+	std::atomic<uint32_t> readyCount;
+	std::atomic<uint32_t> started;
+};
+
+static void* map_anonymous(size_t size) {
+	void* memory = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+	return (memory != MAP_FAILED) ? memory : NULL;
+}
+
+// Operands of one client process, allocated by the parent before fork()
+struct load_client_operands {
+	double* arrays; // x, y, sum and max
+	kernel_server_job* job; // NULL if the client calls the kernels in its own process
+};
+
+// Body of a client process. The client only uses memory which the parent allocated and the connection which the parent
+// opened before fork(): the parent runs other threads, e.g. the workers of the server, and one of them may hold the lock
+// of the heap at the time of the fork, so malloc or new in the child could deadlock.
+static bool run_load_client(load_barrier* barrier, size_t clientNumber, kernel_client* client, const load_client_operands& operands, vector_add_function vector_add, vector_max_function vector_max, size_t iterationsCount, size_t length) {
+	double* arrays = operands.arrays;
+	kernel_server_job* job = operands.job;
+	double expectedMax = -INFINITY;
+	for (size_t i = 0; i < length; i++) {
+		arrays[i] = double((i * 7 + clientNumber) % 1024);
+		arrays[length + i] = double((i * 13) % 512);
+		expectedMax = fmax(expectedMax, arrays[i] + arrays[length + i]);
+	}
+	barrier->readyCount.fetch_add(1);
+	while (barrier->started.load(std::memory_order_acquire) == 0) {
+		std::this_thread::yield();
+	}
+
+	const double* xPointer = arrays;
+	const double* yPointer = arrays + length;
+	double* sumPointer = arrays + 2 * length;
+	double* maxPointer = arrays + 3 * length;
+	bool succeeded = true;
+	for (size_t iteration = 0; succeeded && (iteration < iterationsCount); iteration++) {
+		if (job != NULL) {
+			while (!kernel_client_post_vector_add(client, job, xPointer, yPointer, sumPointer, length)) {
+				std::this_thread::yield();
+			}
+			succeeded = kernel_server_job_wait(job);
+			while (succeeded && !kernel_client_post_vector_max(client, job, sumPointer, maxPointer, length)) {
+				std::this_thread::yield();
+			}
+			succeeded = succeeded && kernel_server_job_wait(job);
+		} else {
+			vector_add(xPointer, yPointer, sumPointer, length);
+			vector_max(sumPointer, maxPointer, length);
+		}
+		succeeded = succeeded && ((*maxPointer == expectedMax) || (length == 0));
+	}
+	return succeeded;
+}
+
+double kernel_server_generate_load(const char* serverName, vector_add_function vector_add, vector_max_function vector_max, size_t clientsCount, size_t iterationsCount, size_t length) {
+	load_barrier* barrier = static_cast<load_barrier*>(map_anonymous(sizeof(load_barrier)));
+	if (barrier == NULL) {
+		return 0.0;
+	}
+	new (barrier) load_barrier;
+	barrier->readyCount.store(0, std::memory_order_relaxed);
+	barrier->started.store(0, std::memory_order_relaxed);
+
+	// Connect and allocate the operands of all clients in the parent: the children inherit the mappings
+	kernel_client* client = NULL;
+	const size_t arraysLength = 3 * length + 1;
+	std::vector<load_client_operands> operands(clientsCount);
+	bool prepared = true;
+	if (serverName != NULL) {
+		client = kernel_client_connect(serverName);
+		prepared = (client != NULL);
+	}
+	for (size_t clientNumber = 0; prepared && (clientNumber < clientsCount); clientNumber++) {
+		if (client != NULL) {
+			operands[clientNumber].arrays = kernel_client_allocate(client, arraysLength);
+			operands[clientNumber].job = kernel_client_create_job(client);
+			prepared = (operands[clientNumber].arrays != NULL) && (operands[clientNumber].job != NULL);
+		} else {
+			operands[clientNumber].arrays = static_cast<double*>(map_anonymous(arraysLength * sizeof(double)));
+			operands[clientNumber].job = NULL;
+			prepared = (operands[clientNumber].arrays != NULL);
+		}
+	}
+
+	std::vector<pid_t> clients;
+	for (size_t clientNumber = 0; prepared && (clientNumber < clientsCount); clientNumber++) {
+		const pid_t pid = fork();
+		if (pid == 0) {
+			const bool succeeded = run_load_client(barrier, clientNumber, client, operands[clientNumber], vector_add, vector_max, iterationsCount, length);
+			_exit(succeeded ? 0 : 1);
+		}
+		if (pid < 0) {
+			break;
+		}
+		clients.push_back(pid);
+	}
+	while (barrier->readyCount.load() != clients.size()) {
+		std::this_thread::yield();
+	}
+	const std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+	barrier->started.store(1, std::memory_order_release);
+
+	bool succeeded = (clients.size() == clientsCount);
+	for (size_t clientNumber = 0; clientNumber < clients.size(); clientNumber++) {
+		int status = 0;
+		if ((waitpid(clients[clientNumber], &status, 0) != clients[clientNumber]) || !WIFEXITED(status) || (WEXITSTATUS(status) != 0)) {
+			succeeded = false;
+		}
+	}
+	const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+	if (client == NULL) {
+		for (size_t clientNumber = 0; clientNumber < clientsCount; clientNumber++) {
+			if (operands[clientNumber].arrays != NULL) {
+				munmap(operands[clientNumber].arrays, arraysLength * sizeof(double));
+			}
+		}
+	}
+	kernel_client_disconnect(client);
+	munmap(barrier, sizeof(load_barrier));
+	return succeeded ? seconds : 0.0;
+}
@@ -0,0 +1,71 @@
+/******************************************************************************\
+ *                                                                            *
+ * Copyright (c) 2012 Marat Dukhan                                            *
+ *                                                                            *
+ * This software is provided 'as-is', without any express or implied          *
+ * warranty. In no event will the authors be held liable for any damages      *
+ * arising from the use of this software.                                     *
+ *                                                                            *
+ * Permission is granted to anyone to use this software for any purpose,      *
+ * including commercial applications, and to alter it and redistribute it     *
+ * freely, subject to the following restrictions:                             *
+ *                                                                            *
+ * 1. The origin of this software must not be misrepresented; you must not    *
+ * claim that you wrote the original software. If you use this software       *
+ * in a product, an acknowledgment in the product documentation would be      *
+ * appreciated but is not required.                                           *
+ *                                                                            *
+ * 2. Altered source versions must be plainly marked as such, and must not be *
+ * misrepresented as being the original software.                             *
+ *                                                                            *
+ * 3. This notice may not be removed or altered from any source               *
+ * distribution.                                                              *
+ *                                                                            *
+\******************************************************************************/
+
+#pragma once
+
+#include <compute.hpp>
+
+// Local kernel server for multiple processes on the same machine.
+// The server process owns worker threads pinned to separate CPUs, and a POSIX shared-memory segment with a lock-free
+// multi-producer multi-consumer job ring (D. Vyukov's bounded queue) and an arena for operands. Client processes attach
+// the segment, place their operands in the arena, and post jobs which refer to the operands by arena offsets. Workers
+// write the results to the arena, so neither operands nor results are copied between processes.
+// Arena memory is allocated with a bump pointer and is not reused until the server is restarted.
+
+struct kernel_server;
+struct kernel_client;
+// Job descriptor in the arena. A job can be posted again once it is done.
+struct kernel_server_job;
+
+// Creates the shared-memory segment name (e.g. "/cse6230") with an arena of arenaSize bytes, and starts workersCount
+// worker threads (0 = all CPUs) which execute jobs with the specified kernels. Fails (returns NULL) if the segment exists.
+extern "C" kernel_server* kernel_server_create(const char* name, size_t arenaSize, size_t workersCount, vector_add_function vector_add, vector_max_function vector_max);
+// Waits for completion of all posted jobs, stops the workers and removes the shared-memory segment.
+// Clients must disconnect before the server is destroyed.
+extern "C" void kernel_server_destroy(kernel_server* server);
+
+// Attaches the shared-memory segment of a server. Returns NULL if there is no server with this name.
+extern "C" kernel_client* kernel_client_connect(const char* name);
+extern "C" void kernel_client_disconnect(kernel_client* client);
+// Allocates an array of length doubles in the arena, aligned on a cache line. Returns NULL if the arena is full.
+extern "C" double* kernel_client_allocate(kernel_client* client, size_t length);
+// Allocates a job descriptor in the arena. Returns NULL if the arena is full.
+extern "C" kernel_server_job* kernel_client_create_job(kernel_client* client);
+
+// Post functions return false if an operand is outside of the arena, the job is still in progress, or the ring is full.
+extern "C" bool kernel_client_post_vector_add(kernel_client* client, kernel_server_job* job, const double* xPointer, const double* yPointer, double* sumPointer, size_t length);
+extern "C" bool kernel_client_post_vector_max(kernel_client* client, kernel_server_job* job, const double* arrayPointer, double* maxPointer, size_t length);
+// Returns true if the job completed or failed. Does not block.
+extern "C" bool kernel_server_job_is_done(const kernel_server_job* job);
+// Blocks until the job completes. Returns false if the server rejected the job because its operation is unknown or
+// an operand is outside of the arena: the server checks every job, as the arena is writable by all clients.
+extern "C" bool kernel_server_job_wait(const kernel_server_job* job);
+
+// Load generator: forks clientsCount processes, each of which computes sum = x + y and max(sum) on its own arrays of
+// length elements iterationsCount times. If serverName is NULL, the clients call the kernels in their own process;
+// otherwise the arrays are allocated in the arena of the server and the clients post jobs to it. The arrays are allocated
+// and the server is attached before the clients are forked. All clients start at the same time.
+// Returns the time in seconds from the start until the last client finished, or 0 if a client failed.
+extern "C" double kernel_server_generate_load(const char* serverName, vector_add_function vector_add, vector_max_function vector_max, size_t clientsCount, size_t iterationsCount, size_t length);
@@ -0,0 +1,106 @@
+/******************************************************************************\
+ *                                                                            *
+ * Copyright (c) 2012 Marat Dukhan                                            *
+ *                                                                            *
+ * This software is provided 'as-is', without any express or implied          *
+ * warranty. In no event will the authors be held liable for any damages      *
+ * arising from the use of this software.                                     *
+ *                                                                            *
+ * Permission is granted to anyone to use this software for any purpose,      *
+ * including commercial applications, and to alter it and redistribute it     *
+ * freely, subject to the following restrictions:                             *
+ *                                                                            *
+ * 1. The origin of this software must not be misrepresented; you must not    *
+ * claim that you wrote the original software. If you use this software       *
+ * in a product, an acknowledgment in the product documentation would be      *
+ * appreciated but is not required.                                           *
+ *                                                                            *
+ * 2. Altered source versions must be plainly marked as such, and must not be *
+ * misrepresented as being the original software.                             *
+ *                                                                            *
+ * 3. This notice may not be removed or altered from any source               *
+ * distribution.                                                              *
+ *                                                                            *
+\******************************************************************************/
+
+#include <stream.hpp>
+#include <stream_chunks.hpp>
+#include <stdlib.h>
+
+struct stream_add_context {
+	vector_add_function vector_add;
+	int sumFile;
+	double* sumChunk;
+};
+
+static bool add_chunk(void* context, const double* const* inputs, size_t chunkStart, size_t chunkLength) {
+	stream_add_context* addContext = static_cast<stream_add_context*>(context);
+	addContext->vector_add(inputs[0], inputs[1], addContext->sumChunk, chunkLength);
+	return write_fully(addContext->sumFile, addContext->sumChunk, chunkLength * sizeof(double), off_t(chunkStart * sizeof(double)));
+}
+
+bool stream_vector_add(int xFile, int yFile, int sumFile, size_t length, vector_add_function vector_add, size_t chunkLength) {
+	if (chunkLength == 0) {
+		chunkLength = stream_default_chunk_length;
+	}
+	stream_add_context context;
+	context.vector_add = vector_add;
+	context.sumFile = sumFile;
+	context.sumChunk = static_cast<double*>(malloc(chunkLength * sizeof(double)));
+	if (context.sumChunk == NULL) {
+		return false;
+	}
+	const int files[2] = { xFile, yFile };
+	const size_t components[2] = { 1, 1 };
+	const bool succeeded = stream_chunks(files, components, 2, length, chunkLength, add_chunk, &context);
+	free(context.sumChunk);
+	return succeeded;
+}
+
+struct stream_max_context {
+	vector_max_function vector_max;
+	double runningMax;
+	bool empty;
+};
+
+static bool max_chunk(void* context, const double* const* inputs, size_t, size_t chunkLength) {
+	stream_max_context* maxContext = static_cast<stream_max_context*>(context);
+	double chunkMax;
+	maxContext->vector_max(inputs[0], &chunkMax, chunkLength);
+	if (maxContext->empty || (chunkMax > maxContext->runningMax)) {
+		maxContext->runningMax = chunkMax;
+		maxContext->empty = false;
+	}
+	return true;
+}
+
+bool stream_vector_max(int arrayFile, size_t length, vector_max_function vector_max, size_t chunkLength, double* maxPointer) {
+	stream_max_context context;
+	context.vector_max = vector_max;
+	context.empty = true;
+	const size_t components[1] = { 1 };
+	const bool succeeded = stream_chunks(&arrayFile, components, 1, length, chunkLength, max_chunk, &context);
+	if (succeeded && !context.empty) {
+		*maxPointer = context.runningMax;
+	}
+	return succeeded;
+}
+
+struct stream_reduction_context {
+	reduction_update_function update;
+	reduction_state* state;
+};
+
+static bool reduction_chunk(void* context, const double* const* inputs, size_t, size_t chunkLength) {
+	stream_reduction_context* reductionContext = static_cast<stream_reduction_context*>(context);
+	reductionContext->update(reductionContext->state, inputs[0], chunkLength);
+	return true;
+}
+
+bool stream_reduction(int arrayFile, size_t length, reduction_update_function update, size_t chunkLength, reduction_state* state) {
+	stream_reduction_context context;
+	context.update = update;
+	context.state = state;
+	const size_t components[1] = { 1 };
+	return stream_chunks(&arrayFile, components, 1, length, chunkLength, reduction_chunk, &context);
+}
@@ -0,0 +1,386 @@
+/******************************************************************************\
+ *                                                                            *
+ * Copyright (c) 2012 Marat Dukhan                                            *
+ *                                                                            *
+ * This software is provided 'as-is', without any express or implied          *
+ * warranty. In no event will the authors be held liable for any damages      *
+ * arising from the use of this software.                                     *
+ *                                                                            *
+ * Permission is granted to anyone to use this software for any purpose,      *
+ * including commercial applications, and to alter it and redistribute it     *
+ * freely, subject to the following restrictions:                             *
+ *                                                                            *
+ * 1. The origin of this software must not be misrepresented; you must not    *
+ * claim that you wrote the original software. If you use this software       *
+ * in a product, an acknowledgment in the product documentation would be      *
+ * appreciated but is not required.                                           *
+ *                                                                            *
+ * 2. Altered source versions must be plainly marked as such, and must not be *
+ * misrepresented as being the original software.                             *
+ *                                                                            *
+ * 3. This notice may not be removed or altered from any source               *
+ * distribution.                                                              *
+ *                                                                            *
+\******************************************************************************/
+
+#include <strided.hpp>
+#include <typed.hpp>
+#include <math.h>
+#include <limits>
+#if defined(CSE6230_SSE2_INTRINSICS_SUPPORTED) || defined(CSE6230_AVX_INTRINSICS_SUPPORTED)
+	#if defined(__GNUC__)
+		#include <x86intrin.h>
+	#elif defined(_MSC_VER)
+		#include <intrin.h>
+	#else
+		#error Intrinsics headers are not included: unknown compiler
+	#endif
+#endif
+
+// Operations on SIMD vectors of doubles for strided operands. Each specialization provides:
+//   load_stride3: loads elements 0, 3, 6, ... (one component of an array of 3D vectors)
+//   gather_index, make_gather_index: what a gather of elements 0, stride, 2 * stride, ... needs besides the pointer
+//   gather, scatter: load and store elements 0, stride, 2 * stride, ...
+//   max: the maximum of an element and a running maximum, which is returned if the element is NaN, as with fmax
+//   reduce_max: the maximum of the elements of a vector
+template <typename ISA>
+struct strided_pd;
+
+template <>
+struct strided_pd<isa_naive> {
+	typedef double vector;
+	typedef size_t gather_index;
+	static const size_t width = 1;
+
+	static vector load(const double* pointer) { return *pointer; }
+	static vector load_stride3(const double* pointer) { return *pointer; }
+	static gather_index make_gather_index(size_t stride) { return stride; }
+	static vector gather(const double* pointer, gather_index) { return *pointer; }
+	static void store(double* pointer, vector a) { *pointer = a; }
+	static void scatter(double* pointer, size_t, gather_index, vector a) { *pointer = a; }
+	static vector broadcast(double value) { return value; }
+	static vector add(vector a, vector b) { return a + b; }
+	static vector max(vector element, vector max) { return fmax(element, max); }
+	static double reduce_max(vector a) { return a; }
+};
+
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+template <>
+struct strided_pd<isa_sse2> {
+	typedef __m128d vector;
+	typedef size_t gather_index;
+	static const size_t width = 2;
+
+	static vector load(const double* pointer) { return _mm_loadu_pd(pointer); }
+	static vector load_stride3(const double* pointer) { return _mm_loadh_pd(_mm_load_sd(pointer), pointer + 3); }
+	static gather_index make_gather_index(size_t stride) { return stride; }
+	static vector gather(const double* pointer, gather_index stride) { return _mm_loadh_pd(_mm_load_sd(pointer), pointer + stride); }
+	static void store(double* pointer, vector a) { _mm_storeu_pd(pointer, a); }
+	static void scatter(double* pointer, size_t stride, gather_index, vector a) {
+		_mm_storel_pd(pointer, a);
+		_mm_storeh_pd(pointer + stride, a);
+	}
+	static vector broadcast(double value) { return _mm_set1_pd(value); }
+	static vector add(vector a, vector b) { return _mm_add_pd(a, b); }
+	static vector max(vector element, vector max) { return _mm_max_pd(element, max); }
+	static double reduce_max(vector a) { return _mm_cvtsd_f64(_mm_max_sd(a, _mm_unpackhi_pd(a, a))); }
+};
+#endif
+
+#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+template <>
+struct strided_pd<isa_avx> {
+	typedef __m256d vector;
+	typedef size_t gather_index;
+	static const size_t width = 4;
+
+	// AVX has no gather: the elements are loaded into the halves of the vector one by one
+	static vector load_halves(const double* pointer, size_t stride) {
+		const __m128d low = _mm_loadh_pd(_mm_load_sd(pointer), pointer + stride);
+		const __m128d high = _mm_loadh_pd(_mm_load_sd(pointer + 2 * stride), pointer + 3 * stride);
+		return _mm256_insertf128_pd(_mm256_castpd128_pd256(low), high, 1);
+	}
+	static void store_halves(double* pointer, size_t stride, vector a) {
+		const __m128d low = _mm256_castpd256_pd128(a);
+		const __m128d high = _mm256_extractf128_pd(a, 1);
+		_mm_storel_pd(pointer, low);
+		_mm_storeh_pd(pointer + stride, low);
+		_mm_storel_pd(pointer + 2 * stride, high);
+		_mm_storeh_pd(pointer + 3 * stride, high);
+	}
+
+	static vector load(const double* pointer) { return _mm256_loadu_pd(pointer); }
+	static vector load_stride3(const double* pointer) { return load_halves(pointer, 3); }
+	static gather_index make_gather_index(size_t stride) { return stride; }
+	static vector gather(const double* pointer, gather_index stride) { return load_halves(pointer, stride); }
+	static void store(double* pointer, vector a) { _mm256_storeu_pd(pointer, a); }
+	static void scatter(double* pointer, size_t stride, gather_index, vector a) { store_halves(pointer, stride, a); }
+	static vector broadcast(double value) { return _mm256_set1_pd(value); }
+	static vector add(vector a, vector b) { return _mm256_add_pd(a, b); }
+	static vector max(vector element, vector max) { return _mm256_max_pd(element, max); }
+	static double reduce_max(vector a) { return strided_pd<isa_sse2>::reduce_max(_mm_max_pd(_mm256_castpd256_pd128(a), _mm256_extractf128_pd(a, 1))); }
+};
+#endif
+
+#ifdef CSE6230_AVX2_INTRINSICS_SUPPORTED
+// Uses the gather instruction for generic strides (AVX2 has no scatter); everything else is the same as in AVX
+template <>
+struct strided_pd<isa_avx2> : strided_pd<isa_avx> {
+	typedef __m256i gather_index;
+
+	static gather_index make_gather_index(size_t stride) { return _mm256_setr_epi64x(0, stride, 2 * stride, 3 * stride); }
+	static vector gather(const double* pointer, gather_index index) { return _mm256_i64gather_pd(pointer, index, 8); }
+	static void scatter(double* pointer, size_t stride, gather_index, vector a) { store_halves(pointer, stride, a); }
+};
+#endif
+
+#ifdef CSE6230_AVX512F_INTRINSICS_SUPPORTED
+template <>
+struct strided_pd<isa_avx512f> {
+	typedef __m512d vector;
+	typedef __m512i gather_index;
+	static const size_t width = 8;
+
+	static vector load(const double* pointer) { return _mm512_loadu_pd(pointer); }
+	static vector load_stride3(const double* pointer) {
+		// Masked loads read only elements 0, 3, 6 of the first 8, 9, 12, 15 of the next 8, and 18, 21 of the last 8
+		const __m512d a = _mm512_maskz_loadu_pd(0x49, pointer);
+		const __m512d b = _mm512_maskz_loadu_pd(0x92, pointer + 8);
+		const __m512d c = _mm512_maskz_loadu_pd(0x24, pointer + 16);
+		const __m512d elements = _mm512_permutex2var_pd(a, _mm512_setr_epi64(0, 3, 6, 9, 12, 15, 0, 0), b);
+		return _mm512_mask_permutexvar_pd(elements, 0xC0, _mm512_setr_epi64(0, 0, 0, 0, 0, 0, 2, 5), c);
+	}
+	static gather_index make_gather_index(size_t stride) {
+		return _mm512_setr_epi64(0, stride, 2 * stride, 3 * stride, 4 * stride, 5 * stride, 6 * stride, 7 * stride);
+	}
+	static vector gather(const double* pointer, gather_index index) { return _mm512_i64gather_pd(index, pointer, 8); }
+	static void store(double* pointer, vector a) { _mm512_storeu_pd(pointer, a); }
+	static void scatter(double* pointer, size_t, gather_index index, vector a) { _mm512_i64scatter_pd(pointer, index, a, 8); }
+	static vector broadcast(double value) { return _mm512_set1_pd(value); }
+	static vector add(vector a, vector b) { return _mm512_add_pd(a, b); }
+	static vector max(vector element, vector max) { return _mm512_max_pd(element, max); }
+	static double reduce_max(vector a) { return _mm512_reduce_max_pd(a); }
+};
+#endif
+
+// Operands provide load (a SIMD vector of elements i, i + 1, ...) and load_scalar (element i)
+template <typename ISA>
+struct contiguous_operand {
+	typedef strided_pd<ISA> simd;
+	const double* pointer;
+
+	explicit contiguous_operand(const double* pointer) : pointer(pointer) {}
+	typename simd::vector load(size_t i) const { return simd::load(pointer + i); }
+	double load_scalar(size_t i) const { return pointer[i]; }
+};
+
+template <typename ISA>
+struct stride3_operand {
+	typedef strided_pd<ISA> simd;
+	const double* pointer;
+
+	explicit stride3_operand(const double* pointer) : pointer(pointer) {}
+	typename simd::vector load(size_t i) const { return simd::load_stride3(pointer + 3 * i); }
+	double load_scalar(size_t i) const { return pointer[3 * i]; }
+};
+
+template <typename ISA>
+struct broadcast_operand {
+	typedef strided_pd<ISA> simd;
+	double value;
+	typename simd::vector values;
+
+	explicit broadcast_operand(const double* pointer) : value(*pointer), values(simd::broadcast(*pointer)) {}
+	typename simd::vector load(size_t) const { return values; }
+	double load_scalar(size_t) const { return value; }
+};
+
+template <typename ISA>
+struct gather_operand {
+	typedef strided_pd<ISA> simd;
+	const double* pointer;
+	size_t stride;
+	typename simd::gather_index index;
+
+	gather_operand(const double* pointer, size_t stride) : pointer(pointer), stride(stride), index(simd::make_gather_index(stride)) {}
+	typename simd::vector load(size_t i) const { return simd::gather(pointer + i * stride, index); }
+	double load_scalar(size_t i) const { return pointer[i * stride]; }
+};
+
+// Outputs provide store (a SIMD vector of elements i, i + 1, ...) and store_scalar (element i)
+template <typename ISA>
+struct contiguous_output {
+	typedef strided_pd<ISA> simd;
+	double* pointer;
+
+	explicit contiguous_output(double* pointer) : pointer(pointer) {}
+	void store(size_t i, typename simd::vector a) const { simd::store(pointer + i, a); }
+	void store_scalar(size_t i, double a) const { pointer[i] = a; }
+};
+
+template <typename ISA>
+struct scatter_output {
+	typedef strided_pd<ISA> simd;
+	double* pointer;
+	size_t stride;
+	typename simd::gather_index index;
+
+	scatter_output(double* pointer, size_t stride) : pointer(pointer), stride(stride), index(simd::make_gather_index(stride)) {}
+	void store(size_t i, typename simd::vector a) const { simd::scatter(pointer + i * stride, stride, index, a); }
+	void store_scalar(size_t i, double a) const { pointer[i * stride] = a; }
+};
+
+template <typename ISA, typename X, typename Y, typename Sum>
+static void vector_add_strided(const X& x, const Y& y, const Sum& sum, size_t length) {
+	typedef strided_pd<ISA> simd;
+	size_t i = 0;
+	for (; i + simd::width <= length; i += simd::width) {
+		sum.store(i, simd::add(x.load(i), y.load(i)));
+	}
+	// Process remaining elements (if any)
+	for (; i < length; i++) {
+		sum.store_scalar(i, x.load_scalar(i) + y.load_scalar(i));
+	}
+}
+
+// Chooses the kind of the output, then of y, then of x, and calls the kernel for the combination
+template <typename ISA, typename X, typename Y>
+static void vector_add_strided_output(const X& x, const Y& y, double* sumPointer, size_t sumStride, size_t length) {
+	if (sumStride == 1) {
+		vector_add_strided<ISA>(x, y, contiguous_output<ISA>(sumPointer), length);
+	} else {
+		vector_add_strided<ISA>(x, y, scatter_output<ISA>(sumPointer, sumStride), length);
+	}
+}
+
+template <typename ISA, typename X>
+static void vector_add_strided_y(const X& x, const double* yPointer, size_t yStride, double* sumPointer, size_t sumStride, size_t length) {
+	switch (yStride) {
+		case 0:
+			vector_add_strided_output<ISA>(x, broadcast_operand<ISA>(yPointer), sumPointer, sumStride, length);
+			break;
+		case 1:
+			vector_add_strided_output<ISA>(x, contiguous_operand<ISA>(yPointer), sumPointer, sumStride, length);
+			break;
+		case 3:
+			vector_add_strided_output<ISA>(x, stride3_operand<ISA>(yPointer), sumPointer, sumStride, length);
+			break;
+		default:
+			vector_add_strided_output<ISA>(x, gather_operand<ISA>(yPointer, yStride), sumPointer, sumStride, length);
+			break;
+	}
+}
+
+template <typename ISA>
+static void vector_add_strided_x(const double* xPointer, size_t xStride, const double* yPointer, size_t yStride, double* sumPointer, size_t sumStride, size_t length) {
+	if (length == 0) {
+		return;
+	}
+	switch (xStride) {
+		case 0:
+			vector_add_strided_y<ISA>(broadcast_operand<ISA>(xPointer), yPointer, yStride, sumPointer, sumStride, length);
+			break;
+		case 1:
+			vector_add_strided_y<ISA>(contiguous_operand<ISA>(xPointer), yPointer, yStride, sumPointer, sumStride, length);
+			break;
+		case 3:
+			vector_add_strided_y<ISA>(stride3_operand<ISA>(xPointer), yPointer, yStride, sumPointer, sumStride, length);
+			break;
+		default:
+			vector_add_strided_y<ISA>(gather_operand<ISA>(xPointer, xStride), yPointer, yStride, sumPointer, sumStride, length);
+			break;
+	}
+}
+
+// Keeps two accumulators to hide the latency of max
+template <typename ISA, typename Array>
+static double vector_max_strided(const Array& array, size_t length) {
+	typedef strided_pd<ISA> simd;
+	const double minusInfinity = -std::numeric_limits<double>::infinity();
+	typename simd::vector maxX = simd::broadcast(minusInfinity);
+	typename simd::vector maxY = simd::broadcast(minusInfinity);
+	size_t i = 0;
+	for (; i + 2 * simd::width <= length; i += 2 * simd::width) {
+		maxX = simd::max(array.load(i), maxX);
+		maxY = simd::max(array.load(i + simd::width), maxY);
+	}
+	double max = simd::reduce_max(simd::max(maxX, maxY));
+	// Process remaining elements (if any)
+	for (; i < length; i++) {
+		max = fmax(max, array.load_scalar(i));
+	}
+	return max;
+}
+
+template <typename ISA>
+static void vector_max_strided_dispatch(const double* arrayPointer, size_t stride, double* maxPointer, size_t length) {
+	const double minusInfinity = -std::numeric_limits<double>::infinity();
+	switch (stride) {
+		case 0:
+			*maxPointer = (length != 0) ? fmax(*arrayPointer, minusInfinity) : minusInfinity;
+			break;
+		case 1:
+			*maxPointer = vector_max_strided<ISA>(contiguous_operand<ISA>(arrayPointer), length);
+			break;
+		case 3:
+			*maxPointer = vector_max_strided<ISA>(stride3_operand<ISA>(arrayPointer), length);
+			break;
+		default:
+			*maxPointer = vector_max_strided<ISA>(gather_operand<ISA>(arrayPointer, stride), length);
+			break;
+	}
+}
+
+void vector_add_strided_naive(const double *CSE6230_RESTRICT xPointer, size_t xStride, const double *CSE6230_RESTRICT yPointer, size_t yStride, double *CSE6230_RESTRICT sumPointer, size_t sumStride, size_t length) {
+	for (size_t i = 0; i < length; i++) {
+		sumPointer[i * sumStride] = xPointer[i * xStride] + yPointer[i * yStride];
+	}
+}
+
+void vector_max_strided_naive(const double *CSE6230_RESTRICT arrayPointer, size_t stride, double *CSE6230_RESTRICT maxPointer, size_t length) {
+	double max = -std::numeric_limits<double>::infinity();
+	for (size_t i = 0; i < length; i++) {
+		max = fmax(max, arrayPointer[i * stride]);
+	}
+	*maxPointer = max;
+}
+
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+void vector_add_strided_sse2(const double *CSE6230_RESTRICT xPointer, size_t xStride, const double *CSE6230_RESTRICT yPointer, size_t yStride, double *CSE6230_RESTRICT sumPointer, size_t sumStride, size_t length) {
+	vector_add_strided_x<isa_sse2>(xPointer, xStride, yPointer, yStride, sumPointer, sumStride, length);
+}
+
+void vector_max_strided_sse2(const double *CSE6230_RESTRICT arrayPointer, size_t stride, double *CSE6230_RESTRICT maxPointer, size_t length) {
+	vector_max_strided_dispatch<isa_sse2>(arrayPointer, stride, maxPointer, length);
+}
+#endif
+
+#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+void vector_add_strided_avx(const double *CSE6230_RESTRICT xPointer, size_t xStride, const double *CSE6230_RESTRICT yPointer, size_t yStride, double *CSE6230_RESTRICT sumPointer, size_t sumStride, size_t length) {
+	vector_add_strided_x<isa_avx>(xPointer, xStride, yPointer, yStride, sumPointer, sumStride, length);
+}
+
+void vector_max_strided_avx(const double *CSE6230_RESTRICT arrayPointer, size_t stride, double *CSE6230_RESTRICT maxPointer, size_t length) {
+	vector_max_strided_dispatch<isa_avx>(arrayPointer, stride, maxPointer, length);
+}
+#endif
+
+#ifdef CSE6230_AVX2_INTRINSICS_SUPPORTED
+void vector_add_strided_avx2(const double *CSE6230_RESTRICT xPointer, size_t xStride, const double *CSE6230_RESTRICT yPointer, size_t yStride, double *CSE6230_RESTRICT sumPointer, size_t sumStride, size_t length) {
+	vector_add_strided_x<isa_avx2>(xPointer, xStride, yPointer, yStride, sumPointer, sumStride, length);
+}
+
+void vector_max_strided_avx2(const double *CSE6230_RESTRICT arrayPointer, size_t stride, double *CSE6230_RESTRICT maxPointer, size_t length) {
+	vector_max_strided_dispatch<isa_avx2>(arrayPointer, stride, maxPointer, length);
+}
+#endif
+
+#ifdef CSE6230_AVX512F_INTRINSICS_SUPPORTED
+void vector_add_strided_avx512f(const double *CSE6230_RESTRICT xPointer, size_t xStride, const double *CSE6230_RESTRICT yPointer, size_t yStride, double *CSE6230_RESTRICT sumPointer, size_t sumStride, size_t length) {
+	vector_add_strided_x<isa_avx512f>(xPointer, xStride, yPointer, yStride, sumPointer, sumStride, length);
+}
+
+void vector_max_strided_avx512f(const double *CSE6230_RESTRICT arrayPointer, size_t stride, double *CSE6230_RESTRICT maxPointer, size_t length) {
+	vector_max_strided_dispatch<isa_avx512f>(arrayPointer, stride, maxPointer, length);
+}
+#endif
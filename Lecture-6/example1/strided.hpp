@@ -0,0 +1,70 @@
+/******************************************************************************\
+ *                                                                            *
+ * Copyright (c) 2012 Marat Dukhan                                            *
+ *                                                                            *
+ * This software is provided 'as-is', without any express or implied          *
+ * warranty. In no event will the authors be held liable for any damages      *
+ * arising from the use of this software.                                     *
+ *                                                                            *
+ * Permission is granted to anyone to use this software for any purpose,      *
+ * including commercial applications, and to alter it and redistribute it     *
+ * freely, subject to the following restrictions:                             *
+ *                                                                            *
+ * 1. The origin of this software must not be misrepresented; you must not    *
+ * claim that you wrote the original software. If you use this software       *
+ * in a product, an acknowledgment in the product documentation would be      *
+ * appreciated but is not required.                                           *
+ *                                                                            *
+ * 2. Altered source versions must be plainly marked as such, and must not be *
+ * misrepresented as being the original software.                             *
+ *                                                                            *
+ * 3. This notice may not be removed or altered from any source               *
+ * distribution.                                                              *
+ *                                                                            *
+\******************************************************************************/
+
+#pragma once
+
+#include <compute.hpp>
+
+// Strided and broadcast operands: element i of an operand with stride s is pointer[i * s], in elements.
+// Stride 0 broadcasts pointer[0] to all elements. Matrix columns, a component of an array of 3D vectors or a scalar
+// can be passed directly, without copying them into a contiguous temporary array first.
+// Strides 0 (broadcast), 1 (contiguous) and 3 (a component of xyz vectors) have fast paths, other strides load the
+// elements with gathers: gather instructions in the AVX2 and AVX-512 versions, and separate loads in SSE2 and AVX versions.
+// Operands are only read at the addresses of their elements.
+
+// sumPointer[i * sumStride] = xPointer[i * xStride] + yPointer[i * yStride]. sumStride must not be 0.
+typedef void (*vector_add_strided_function)(const double*, size_t, const double*, size_t, double*, size_t, size_t);
+
+extern "C" void vector_add_strided_naive(const double *CSE6230_RESTRICT xPointer, size_t xStride, const double *CSE6230_RESTRICT yPointer, size_t yStride, double *CSE6230_RESTRICT sumPointer, size_t sumStride, size_t length);
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+extern "C" void vector_add_strided_sse2(const double *CSE6230_RESTRICT xPointer, size_t xStride, const double *CSE6230_RESTRICT yPointer, size_t yStride, double *CSE6230_RESTRICT sumPointer, size_t sumStride, size_t length);
+#endif
+#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+extern "C" void vector_add_strided_avx(const double *CSE6230_RESTRICT xPointer, size_t xStride, const double *CSE6230_RESTRICT yPointer, size_t yStride, double *CSE6230_RESTRICT sumPointer, size_t sumStride, size_t length);
+#endif
+#ifdef CSE6230_AVX2_INTRINSICS_SUPPORTED
+extern "C" void vector_add_strided_avx2(const double *CSE6230_RESTRICT xPointer, size_t xStride, const double *CSE6230_RESTRICT yPointer, size_t yStride, double *CSE6230_RESTRICT sumPointer, size_t sumStride, size_t length);
+#endif
+#ifdef CSE6230_AVX512F_INTRINSICS_SUPPORTED
+extern "C" void vector_add_strided_avx512f(const double *CSE6230_RESTRICT xPointer, size_t xStride, const double *CSE6230_RESTRICT yPointer, size_t yStride, double *CSE6230_RESTRICT sumPointer, size_t sumStride, size_t length);
+#endif
+
+// *maxPointer = the maximum of arrayPointer[i * stride], or -infinity if length is 0.
+// NaN elements are ignored, as by fmax in vector_max_naive: if all elements are NaN, the result is -infinity.
+typedef void (*vector_max_strided_function)(const double*, size_t, double*, size_t);
+
+extern "C" void vector_max_strided_naive(const double *CSE6230_RESTRICT arrayPointer, size_t stride, double *CSE6230_RESTRICT maxPointer, size_t length);
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+extern "C" void vector_max_strided_sse2(const double *CSE6230_RESTRICT arrayPointer, size_t stride, double *CSE6230_RESTRICT maxPointer, size_t length);
+#endif
+#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+extern "C" void vector_max_strided_avx(const double *CSE6230_RESTRICT arrayPointer, size_t stride, double *CSE6230_RESTRICT maxPointer, size_t length);
+#endif
+#ifdef CSE6230_AVX2_INTRINSICS_SUPPORTED
+extern "C" void vector_max_strided_avx2(const double *CSE6230_RESTRICT arrayPointer, size_t stride, double *CSE6230_RESTRICT maxPointer, size_t length);
+#endif
+#ifdef CSE6230_AVX512F_INTRINSICS_SUPPORTED
+extern "C" void vector_max_strided_avx512f(const double *CSE6230_RESTRICT arrayPointer, size_t stride, double *CSE6230_RESTRICT maxPointer, size_t length);
+#endif
@@ -0,0 +1,260 @@
+/******************************************************************************\
+ *                                                                            *
+ * Copyright (c) 2012 Marat Dukhan                                            *
+ *                                                                            *
+ * This software is provided 'as-is', without any express or implied          *
+ * warranty. In no event will the authors be held liable for any damages      *
+ * arising from the use of this software.                                     *
+ *                                                                            *
+ * Permission is granted to anyone to use this software for any purpose,      *
+ * including commercial applications, and to alter it and redistribute it     *
+ * freely, subject to the following restrictions:                             *
+ *                                                                            *
+ * 1. The origin of this software must not be misrepresented; you must not    *
+ * claim that you wrote the original software. If you use this software       *
+ * in a product, an acknowledgment in the product documentation would be      *
+ * appreciated but is not required.                                           *
+ *                                                                            *
+ * 2. Altered source versions must be plainly marked as such, and must not be *
+ * misrepresented as being the original software.                             *
+ *                                                                            *
+ * 3. This notice may not be removed or altered from any source               *
+ * distribution.                                                              *
+ *                                                                            *
+\******************************************************************************/
+
+#include <topk.hpp>
+#include <thread>
+#include <vector>
+#if defined(CSE6230_SSE2_INTRINSICS_SUPPORTED) || defined(CSE6230_AVX_INTRINSICS_SUPPORTED)
+	#if defined(__GNUC__)
+		#include <x86intrin.h>
+	#elif defined(_MSC_VER)
+		#include <intrin.h>
+	#else
+		#error Intrinsics headers are not included: unknown compiler
+	#endif
+#endif
+
+// Operations on SIMD vectors of doubles for the prefilter. Each specialization provides:
+//   load (unaligned), broadcast
+//   greater: a mask of lanes where a > b, merge: combines two masks, and any: true if a lane of the mask is set
+template <typename ISA>
+struct topk_pd;
+
+template <>
+struct topk_pd<isa_naive> {
+	typedef double vector;
+	typedef bool mask;
+	static const size_t width = 1;
+
+	static vector load(const double* pointer) { return *pointer; }
+	static vector broadcast(double value) { return value; }
+	static mask greater(vector a, vector b) { return a > b; }
+	static mask merge(mask a, mask b) { return a || b; }
+	static bool any(mask m) { return m; }
+};
+
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+template <>
+struct topk_pd<isa_sse2> {
+	typedef __m128d vector;
+	typedef __m128d mask;
+	static const size_t width = 2;
+
+	static vector load(const double* pointer) { return _mm_loadu_pd(pointer); }
+	static vector broadcast(double value) { return _mm_set1_pd(value); }
+	static mask greater(vector a, vector b) { return _mm_cmpgt_pd(a, b); }
+	static mask merge(mask a, mask b) { return _mm_or_pd(a, b); }
+	static bool any(mask m) { return _mm_movemask_pd(m) != 0; }
+};
+#endif
+
+#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+template <>
+struct topk_pd<isa_avx> {
+	typedef __m256d vector;
+	typedef __m256d mask;
+	static const size_t width = 4;
+
+	static vector load(const double* pointer) { return _mm256_loadu_pd(pointer); }
+	static vector broadcast(double value) { return _mm256_set1_pd(value); }
+	static mask greater(vector a, vector b) { return _mm256_cmp_pd(a, b, _CMP_GT_OQ); }
+	static mask merge(mask a, mask b) { return _mm256_or_pd(a, b); }
+	static bool any(mask m) { return _mm256_movemask_pd(m) != 0; }
+};
+#endif
+
+#ifdef CSE6230_AVX512F_INTRINSICS_SUPPORTED
+template <>
+struct topk_pd<isa_avx512f> {
+	typedef __m512d vector;
+	typedef __mmask8 mask;
+	static const size_t width = 8;
+
+	static vector load(const double* pointer) { return _mm512_loadu_pd(pointer); }
+	static vector broadcast(double value) { return _mm512_set1_pd(value); }
+	static mask greater(vector a, vector b) { return _mm512_cmp_pd_mask(a, b, _CMP_GT_OQ); }
+	static mask merge(mask a, mask b) { return a | b; }
+	static bool any(mask m) { return m != 0; }
+};
+#endif
+
+// The k largest elements seen so far, in descending order of values and ascending order of indices for equal values
+struct topk_buffer {
+	double values[vector_topk_max_k];
+	size_t indices[vector_topk_max_k];
+	size_t count;
+	size_t k;
+
+	explicit topk_buffer(size_t k) : count(0), k(k) {}
+
+	bool is_full() const {
+		return count == k;
+	}
+
+	// The elements must be greater than this value to get into a full buffer, if their indices are greater than all in the buffer
+	double threshold() const {
+		return values[k - 1];
+	}
+
+	void insert(double value, size_t index) {
+		size_t position = count;
+		if (is_full()) {
+			if ((value < values[k - 1]) || ((value == values[k - 1]) && (index > indices[k - 1]))) {
+				return;
+			}
+			position = k - 1;
+		} else {
+			count += 1;
+		}
+		// Shift the smaller elements by one position
+		for (; (position != 0) && ((values[position - 1] < value) || ((values[position - 1] == value) && (indices[position - 1] > index))); position--) {
+			values[position] = values[position - 1];
+			indices[position] = indices[position - 1];
+		}
+		values[position] = value;
+		indices[position] = index;
+	}
+
+	size_t store(double* valuesPointer, size_t* indicesPointer) const {
+		for (size_t i = 0; i < count; i++) {
+			valuesPointer[i] = values[i];
+			indicesPointer[i] = indices[i];
+		}
+		return count;
+	}
+};
+
+// Processes the array by four SIMD vectors at an iteration: the elements of the vectors are inserted one by one
+// only if any of them is greater than the threshold
+template <typename ISA>
+static size_t vector_topk(const double *CSE6230_RESTRICT arrayPointer, size_t length, size_t k, double *CSE6230_RESTRICT valuesPointer, size_t *CSE6230_RESTRICT indicesPointer) {
+	typedef topk_pd<ISA> simd;
+	if ((k == 0) || (k > vector_topk_max_k)) {
+		return 0;
+	}
+	topk_buffer buffer(k);
+	size_t i = 0;
+	// The first k elements fill the buffer
+	for (; (i < length) && !buffer.is_full(); i++) {
+		buffer.insert(arrayPointer[i], i);
+	}
+
+	const size_t blockLength = 4 * simd::width;
+	typename simd::vector threshold = simd::broadcast(buffer.threshold());
+	for (; i + blockLength <= length; i += blockLength) {
+		const typename simd::mask greaterX = simd::greater(simd::load(arrayPointer + i), threshold);
+		const typename simd::mask greaterY = simd::greater(simd::load(arrayPointer + i + simd::width), threshold);
+		const typename simd::mask greaterZ = simd::greater(simd::load(arrayPointer + i + 2 * simd::width), threshold);
+		const typename simd::mask greaterW = simd::greater(simd::load(arrayPointer + i + 3 * simd::width), threshold);
+		if (simd::any(simd::merge(simd::merge(greaterX, greaterY), simd::merge(greaterZ, greaterW)))) {
+			for (size_t j = i; j < i + blockLength; j++) {
+				if (arrayPointer[j] > buffer.threshold()) {
+					buffer.insert(arrayPointer[j], j);
+				}
+			}
+			threshold = simd::broadcast(buffer.threshold());
+		}
+	}
+	// Process remaining elements (if any)
+	for (; i < length; i++) {
+		if (arrayPointer[i] > buffer.threshold()) {
+			buffer.insert(arrayPointer[i], i);
+		}
+	}
+	return buffer.store(valuesPointer, indicesPointer);
+}
+
+size_t vector_topk_naive(const double *CSE6230_RESTRICT arrayPointer, size_t length, size_t k, double *CSE6230_RESTRICT valuesPointer, size_t *CSE6230_RESTRICT indicesPointer) {
+	return vector_topk<isa_naive>(arrayPointer, length, k, valuesPointer, indicesPointer);
+}
+
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+size_t vector_topk_sse2(const double *CSE6230_RESTRICT arrayPointer, size_t length, size_t k, double *CSE6230_RESTRICT valuesPointer, size_t *CSE6230_RESTRICT indicesPointer) {
+	return vector_topk<isa_sse2>(arrayPointer, length, k, valuesPointer, indicesPointer);
+}
+#endif
+
+#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+size_t vector_topk_avx(const double *CSE6230_RESTRICT arrayPointer, size_t length, size_t k, double *CSE6230_RESTRICT valuesPointer, size_t *CSE6230_RESTRICT indicesPointer) {
+	return vector_topk<isa_avx>(arrayPointer, length, k, valuesPointer, indicesPointer);
+}
+#endif
+
+#ifdef CSE6230_AVX512F_INTRINSICS_SUPPORTED
+size_t vector_topk_avx512f(const double *CSE6230_RESTRICT arrayPointer, size_t length, size_t k, double *CSE6230_RESTRICT valuesPointer, size_t *CSE6230_RESTRICT indicesPointer) {
+	return vector_topk<isa_avx512f>(arrayPointer, length, k, valuesPointer, indicesPointer);
+}
+#endif
+
+// Part of the array for one thread of vector_topk_parallel
+struct topk_part {
+	double values[vector_topk_max_k];
+	size_t indices[vector_topk_max_k];
+	size_t count;
+};
+
+size_t vector_topk_parallel(vector_topk_function topk, const double *CSE6230_RESTRICT arrayPointer, size_t length, size_t k, double *CSE6230_RESTRICT valuesPointer, size_t *CSE6230_RESTRICT indicesPointer, size_t threadsCount) {
+	if ((k == 0) || (k > vector_topk_max_k)) {
+		return 0;
+	}
+	if (threadsCount == 0) {
+		threadsCount = std::thread::hardware_concurrency();
+	}
+	// Every part should be long enough to amortize the first k insertions
+	const size_t maxThreadsCount = length / (16 * vector_topk_max_k);
+	if (threadsCount > maxThreadsCount) {
+		threadsCount = maxThreadsCount;
+	}
+	if (threadsCount <= 1) {
+		return topk(arrayPointer, length, k, valuesPointer, indicesPointer);
+	}
+
+	std::vector<topk_part> parts(threadsCount);
+	const auto selectPart = [topk, arrayPointer, length, k, threadsCount, &parts](size_t part) {
+		const size_t partStart = length * part / threadsCount;
+		const size_t partEnd = length * (part + 1) / threadsCount;
+		parts[part].count = topk(arrayPointer + partStart, partEnd - partStart, k, parts[part].values, parts[part].indices);
+		for (size_t i = 0; i < parts[part].count; i++) {
+			parts[part].indices[i] += partStart;
+		}
+	};
+	// The calling thread processes the first part
+	std::vector<std::thread> threads;
+	for (size_t part = 1; part < threadsCount; part++) {
+		threads.push_back(std::thread(selectPart, part));
+	}
+	selectPart(0);
+	for (size_t thread = 0; thread < threads.size(); thread++) {
+		threads[thread].join();
+	}
+
+	topk_buffer buffer(k);
+	for (size_t part = 0; part < threadsCount; part++) {
+		for (size_t i = 0; i < parts[part].count; i++) {
+			buffer.insert(parts[part].values[i], parts[part].indices[i]);
+		}
+	}
+	return buffer.store(valuesPointer, indicesPointer);
+}
@@ -0,0 +1,55 @@
+/******************************************************************************\
+ *                                                                            *
+ * Copyright (c) 2012 Marat Dukhan                                            *
+ *                                                                            *
+ * This software is provided 'as-is', without any express or implied          *
+ * warranty. In no event will the authors be held liable for any damages      *
+ * arising from the use of this software.                                     *
+ *                                                                            *
+ * Permission is granted to anyone to use this software for any purpose,      *
+ * including commercial applications, and to alter it and redistribute it     *
+ * freely, subject to the following restrictions:                             *
+ *                                                                            *
+ * 1. The origin of this software must not be misrepresented; you must not    *
+ * claim that you wrote the original software. If you use this software       *
+ * in a product, an acknowledgment in the product documentation would be      *
+ * appreciated but is not required.                                           *
+ *                                                                            *
+ * 2. Altered source versions must be plainly marked as such, and must not be *
+ * misrepresented as being the original software.                             *
+ *                                                                            *
+ * 3. This notice may not be removed or altered from any source               *
+ * distribution.                                                              *
+ *                                                                            *
+\******************************************************************************/
+
+#pragma once
+
+#include <compute.hpp>
+#include <typed.hpp>
+
+// Selection of the k largest elements of a double array, for 1 <= k <= vector_topk_max_k.
+// The kernels keep the k largest elements seen so far in a sorted buffer. SIMD versions compare several vectors of elements
+// with the smallest element in the buffer at once, and only go through the elements of the vectors which pass to update
+// the buffer, so on most inputs the scan runs at the speed of vector_max.
+// The values are written in descending order to valuesPointer, and their indices to indicesPointer. Of equal values,
+// the one with the smaller index comes first. The functions return the number of elements written, i.e. min(k, length),
+// or 0 if k is not in the supported range. NaN elements are not supported.
+static const size_t vector_topk_max_k = 64;
+
+typedef size_t (*vector_topk_function)(const double*, size_t, size_t, double*, size_t*);
+
+extern "C" size_t vector_topk_naive(const double *CSE6230_RESTRICT arrayPointer, size_t length, size_t k, double *CSE6230_RESTRICT valuesPointer, size_t *CSE6230_RESTRICT indicesPointer);
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+extern "C" size_t vector_topk_sse2(const double *CSE6230_RESTRICT arrayPointer, size_t length, size_t k, double *CSE6230_RESTRICT valuesPointer, size_t *CSE6230_RESTRICT indicesPointer);
+#endif
+#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+extern "C" size_t vector_topk_avx(const double *CSE6230_RESTRICT arrayPointer, size_t length, size_t k, double *CSE6230_RESTRICT valuesPointer, size_t *CSE6230_RESTRICT indicesPointer);
+#endif
+#ifdef CSE6230_AVX512F_INTRINSICS_SUPPORTED
+extern "C" size_t vector_topk_avx512f(const double *CSE6230_RESTRICT arrayPointer, size_t length, size_t k, double *CSE6230_RESTRICT valuesPointer, size_t *CSE6230_RESTRICT indicesPointer);
+#endif
+
+// Splits the array into threadsCount parts (0 = all CPUs), selects the top k of every part with topk on its own thread,
+// and merges the results. The output is the same as from topk on the whole array.
+extern "C" size_t vector_topk_parallel(vector_topk_function topk, const double *CSE6230_RESTRICT arrayPointer, size_t length, size_t k, double *CSE6230_RESTRICT valuesPointer, size_t *CSE6230_RESTRICT indicesPointer, size_t threadsCount);
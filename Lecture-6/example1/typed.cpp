@@ -0,0 +1,594 @@
+/******************************************************************************\
+ *                                                                            *
+ * Copyright (c) 2012 Marat Dukhan                                            *
+ *                                                                            *
+ * This software is provided 'as-is', without any express or implied          *
+ * warranty. In no event will the authors be held liable for any damages      *
+ * arising from the use of this software.                                     *
+ *                                                                            *
+ * Permission is granted to anyone to use this software for any purpose,      *
+ * including commercial applications, and to alter it and redistribute it     *
+ * freely, subject to the following restrictions:                             *
+ *                                                                            *
+ * 1. The origin of this software must not be misrepresented; you must not    *
+ * claim that you wrote the original software. If you use this software       *
+ * in a product, an acknowledgment in the product documentation would be      *
+ * appreciated but is not required.                                           *
+ *                                                                            *
+ * 2. Altered source versions must be plainly marked as such, and must not be *
+ * misrepresented as being the original software.                             *
+ *                                                                            *
+ * 3. This notice may not be removed or altered from any source               *
+ * distribution.                                                              *
+ *                                                                            *
+\******************************************************************************/
+
+#include <typed.hpp>
+#include <math.h>
+#include <string.h>
+#include <limits>
+#if defined(CSE6230_SSE2_INTRINSICS_SUPPORTED) || defined(CSE6230_AVX_INTRINSICS_SUPPORTED)
+	#if defined(__GNUC__)
+		#include <x86intrin.h>
+	#elif defined(_MSC_VER)
+		#include <intrin.h>
+	#else
+		#error Intrinsics headers are not included: unknown compiler
+	#endif
+#endif
+
+inline static bfloat16 float_to_bfloat16(float x) {
+	uint32_t bits;
+	memcpy(&bits, &x, sizeof(bits));
+	bfloat16 result;
+	if (x != x) {
+		// Keep NaN a (quiet) NaN after truncation
+		result.bits = uint16_t((bits >> 16) | 0x0040);
+	} else {
+		// Round to nearest-even
+		bits += 0x7FFF + ((bits >> 16) & 1);
+		result.bits = uint16_t(bits >> 16);
+	}
+	return result;
+}
+
+// Scalar operations
+
+template <typename T>
+inline static T scalar_add(T x, T y) {
+	return x + y;
+}
+
+inline static int32_t scalar_add(int32_t x, int32_t y) {
+	// Signed overflow is undefined in C++, so wrap in unsigned arithmetic
+	return int32_t(uint32_t(x) + uint32_t(y));
+}
+
+inline static int64_t scalar_add(int64_t x, int64_t y) {
+	return int64_t(uint64_t(x) + uint64_t(y));
+}
+
+inline static bfloat16 scalar_add(bfloat16 x, bfloat16 y) {
+	return float_to_bfloat16(bfloat16_to_float(x) + bfloat16_to_float(y));
+}
+
+template <typename T>
+inline static T scalar_add_saturated(T x, T y) {
+	if (std::numeric_limits<T>::is_signed) {
+		if ((y > 0) && (x > std::numeric_limits<T>::max() - y)) {
+			return std::numeric_limits<T>::max();
+		} else if ((y < 0) && (x < std::numeric_limits<T>::min() - y)) {
+			return std::numeric_limits<T>::min();
+		} else {
+			return x + y;
+		}
+	} else {
+		const T sum = x + y;
+		return (sum < x) ? std::numeric_limits<T>::max() : sum;
+	}
+}
+
+template <typename T>
+inline static T scalar_max(T x, T y) {
+	return (x > y) ? x : y;
+}
+
+inline static float scalar_max(float x, float y) {
+	return fmaxf(x, y);
+}
+
+inline static bfloat16 scalar_max(bfloat16 x, bfloat16 y) {
+	// Maximum of bfloat16 numbers is exact, so there is no need to round it
+	const float xFloat = bfloat16_to_float(x);
+	const float yFloat = bfloat16_to_float(y);
+	return (fmaxf(xFloat, yFloat) == xFloat) ? x : y;
+}
+
+template <typename T>
+inline static T scalar_lowest() {
+	return std::numeric_limits<T>::min();
+}
+
+template <>
+inline float scalar_lowest<float>() {
+	return -std::numeric_limits<float>::infinity();
+}
+
+template <>
+inline bfloat16 scalar_lowest<bfloat16>() {
+	bfloat16 minusInfinity;
+	minusInfinity.bits = 0xFF80;
+	return minusInfinity;
+}
+
+// SIMD operations: each specialization defines the vector type, the number of elements in a vector,
+// and unaligned load and store, add, add_saturated (for integer types), max and lowest (broadcast of scalar_lowest).
+// Floating-point max(x, y) follows the x86 max instructions: it returns y if either x or y is NaN.
+
+template <typename T, typename ISA>
+struct simd;
+
+template <typename T>
+struct simd<T, isa_naive> {
+	typedef T vector;
+	static const size_t width = 1;
+
+	static vector load(const T* pointer) { return *pointer; }
+	static void store(T* pointer, vector x) { *pointer = x; }
+	static vector add(vector x, vector y) { return scalar_add(x, y); }
+	static vector add_saturated(vector x, vector y) { return scalar_add_saturated(x, y); }
+	static vector max(vector x, vector y) { return scalar_max(x, y); }
+	static vector lowest() { return scalar_lowest<T>(); }
+};
+
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+template <>
+struct simd<float, isa_sse2> {
+	typedef __m128 vector;
+	static const size_t width = 4;
+
+	static vector load(const float* pointer) { return _mm_loadu_ps(pointer); }
+	static void store(float* pointer, vector x) { _mm_storeu_ps(pointer, x); }
+	static vector add(vector x, vector y) { return _mm_add_ps(x, y); }
+	static vector max(vector x, vector y) { return _mm_max_ps(x, y); }
+	static vector lowest() { return _mm_set1_ps(scalar_lowest<float>()); }
+};
+
+// Selects y where mask is set and x elsewhere
+inline static __m128i sse2_select(__m128i mask, __m128i x, __m128i y) {
+	return _mm_or_si128(_mm_andnot_si128(mask, x), _mm_and_si128(mask, y));
+}
+
+// Broadcasts the sign bit of each 64-bit element to all its bits
+inline static __m128i sse2_sign_mask_epi64(__m128i x) {
+	return _mm_shuffle_epi32(_mm_srai_epi32(x, 31), _MM_SHUFFLE(3, 3, 1, 1));
+}
+
+// Signed 64-bit x > y. SSE2 compares only up to 32-bit elements, so the low halves are compared as unsigned numbers and
+// combined with the comparison of the high halves.
+inline static __m128i sse2_cmpgt_epi64(__m128i x, __m128i y) {
+	const __m128i lowSignBits = _mm_set_epi32(0, 0x80000000, 0, 0x80000000);
+	const __m128i greater = _mm_cmpgt_epi32(_mm_xor_si128(x, lowSignBits), _mm_xor_si128(y, lowSignBits));
+	const __m128i equal = _mm_cmpeq_epi32(x, y);
+	// The high half of each element is greater.high | (equal.high & greater.low)
+	const __m128i result = _mm_or_si128(greater, _mm_and_si128(equal, _mm_slli_epi64(greater, 32)));
+	return _mm_shuffle_epi32(result, _MM_SHUFFLE(3, 3, 1, 1));
+}
+
+template <bool Signed>
+struct sse2_int32 {
+	typedef __m128i vector;
+	static const size_t width = 4;
+
+	static vector add(vector x, vector y) { return _mm_add_epi32(x, y); }
+	static vector add_saturated(vector x, vector y) {
+		const vector sum = _mm_add_epi32(x, y);
+		if (Signed) {
+			// Overflow if x and y have the same sign, and sum has the opposite sign
+			const vector overflowMask = _mm_srai_epi32(_mm_and_si128(_mm_xor_si128(x, sum), _mm_xor_si128(y, sum)), 31);
+			const vector saturated = _mm_xor_si128(_mm_srai_epi32(x, 31), _mm_set1_epi32(0x7FFFFFFF));
+			return sse2_select(overflowMask, sum, saturated);
+		} else {
+			// Overflow if sum < x as unsigned numbers
+			const vector signBits = _mm_set1_epi32(0x80000000);
+			const vector overflowMask = _mm_cmpgt_epi32(_mm_xor_si128(x, signBits), _mm_xor_si128(sum, signBits));
+			return _mm_or_si128(sum, overflowMask);
+		}
+	}
+	static vector max(vector x, vector y) {
+		const vector signBits = _mm_set1_epi32(Signed ? 0 : 0x80000000);
+		const vector greaterMask = _mm_cmpgt_epi32(_mm_xor_si128(x, signBits), _mm_xor_si128(y, signBits));
+		return sse2_select(greaterMask, y, x);
+	}
+};
+
+template <bool Signed>
+struct sse2_int64 {
+	typedef __m128i vector;
+	static const size_t width = 2;
+
+	static vector add(vector x, vector y) { return _mm_add_epi64(x, y); }
+	static vector add_saturated(vector x, vector y) {
+		const vector sum = _mm_add_epi64(x, y);
+		if (Signed) {
+			const vector overflowMask = sse2_sign_mask_epi64(_mm_and_si128(_mm_xor_si128(x, sum), _mm_xor_si128(y, sum)));
+			const vector saturated = _mm_xor_si128(sse2_sign_mask_epi64(x), _mm_set1_epi64x(0x7FFFFFFFFFFFFFFFll));
+			return sse2_select(overflowMask, sum, saturated);
+		} else {
+			const vector signBits = _mm_set1_epi64x(0x8000000000000000ull);
+			const vector overflowMask = sse2_cmpgt_epi64(_mm_xor_si128(x, signBits), _mm_xor_si128(sum, signBits));
+			return _mm_or_si128(sum, overflowMask);
+		}
+	}
+	static vector max(vector x, vector y) {
+		const vector signBits = _mm_set1_epi64x(Signed ? 0 : 0x8000000000000000ull);
+		const vector greaterMask = sse2_cmpgt_epi64(_mm_xor_si128(x, signBits), _mm_xor_si128(y, signBits));
+		return sse2_select(greaterMask, y, x);
+	}
+};
+
+template <> struct simd<int32_t, isa_sse2> : sse2_int32<true> {
+	static vector load(const int32_t* pointer) { return _mm_loadu_si128((const __m128i*)pointer); }
+	static void store(int32_t* pointer, vector x) { _mm_storeu_si128((__m128i*)pointer, x); }
+	static vector lowest() { return _mm_set1_epi32(std::numeric_limits<int32_t>::min()); }
+};
+
+template <> struct simd<uint32_t, isa_sse2> : sse2_int32<false> {
+	static vector load(const uint32_t* pointer) { return _mm_loadu_si128((const __m128i*)pointer); }
+	static void store(uint32_t* pointer, vector x) { _mm_storeu_si128((__m128i*)pointer, x); }
+	static vector lowest() { return _mm_setzero_si128(); }
+};
+
+template <> struct simd<int64_t, isa_sse2> : sse2_int64<true> {
+	static vector load(const int64_t* pointer) { return _mm_loadu_si128((const __m128i*)pointer); }
+	static void store(int64_t* pointer, vector x) { _mm_storeu_si128((__m128i*)pointer, x); }
+	static vector lowest() { return _mm_set1_epi64x(std::numeric_limits<int64_t>::min()); }
+};
+
+template <> struct simd<uint64_t, isa_sse2> : sse2_int64<false> {
+	static vector load(const uint64_t* pointer) { return _mm_loadu_si128((const __m128i*)pointer); }
+	static void store(uint64_t* pointer, vector x) { _mm_storeu_si128((__m128i*)pointer, x); }
+	static vector lowest() { return _mm_setzero_si128(); }
+};
+
+// Converts four single-precision numbers to bfloat16 with rounding to nearest-even.
+// Returns the bfloat16 numbers sign-extended to 32 bits, so they can be packed with signed saturation.
+inline static __m128i sse2_cvtps_bf16_epi32(__m128 x) {
+	const __m128i bits = _mm_castps_si128(x);
+	const __m128i roundingBias = _mm_add_epi32(_mm_and_si128(_mm_srli_epi32(bits, 16), _mm_set1_epi32(1)), _mm_set1_epi32(0x7FFF));
+	const __m128i rounded = _mm_add_epi32(bits, roundingBias);
+	const __m128i quietNaN = _mm_or_si128(bits, _mm_set1_epi32(0x00400000));
+	const __m128i nanMask = _mm_castps_si128(_mm_cmpunord_ps(x, x));
+	return _mm_srai_epi32(sse2_select(nanMask, rounded, quietNaN), 16);
+}
+
+template <>
+struct simd<bfloat16, isa_sse2> {
+	// bfloat16 numbers are widened to single precision in registers
+	typedef __m128 vector;
+	static const size_t width = 4;
+
+	static vector load(const bfloat16* pointer) {
+		const __m128i bits = _mm_loadl_epi64((const __m128i*)pointer);
+		return _mm_castsi128_ps(_mm_unpacklo_epi16(_mm_setzero_si128(), bits));
+	}
+	static void store(bfloat16* pointer, vector x) {
+		const __m128i bits = sse2_cvtps_bf16_epi32(x);
+		_mm_storel_epi64((__m128i*)pointer, _mm_packs_epi32(bits, bits));
+	}
+	static vector add(vector x, vector y) { return _mm_add_ps(x, y); }
+	static vector max(vector x, vector y) { return _mm_max_ps(x, y); }
+	static vector lowest() { return _mm_set1_ps(scalar_lowest<float>()); }
+};
+#endif
+
+#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+template <>
+struct simd<float, isa_avx> {
+	typedef __m256 vector;
+	static const size_t width = 8;
+
+	static vector load(const float* pointer) { return _mm256_loadu_ps(pointer); }
+	static void store(float* pointer, vector x) { _mm256_storeu_ps(pointer, x); }
+	static vector add(vector x, vector y) { return _mm256_add_ps(x, y); }
+	static vector max(vector x, vector y) { return _mm256_max_ps(x, y); }
+	static vector lowest() { return _mm256_set1_ps(scalar_lowest<float>()); }
+};
+
+template <>
+struct simd<bfloat16, isa_avx> {
+	// AVX has no 256-bit integer instructions, so conversions are done on 128-bit halves
+	typedef __m256 vector;
+	static const size_t width = 8;
+
+	static vector load(const bfloat16* pointer) {
+		const __m128i bits = _mm_loadu_si128((const __m128i*)pointer);
+		const __m128 low = _mm_castsi128_ps(_mm_unpacklo_epi16(_mm_setzero_si128(), bits));
+		const __m128 high = _mm_castsi128_ps(_mm_unpackhi_epi16(_mm_setzero_si128(), bits));
+		return _mm256_insertf128_ps(_mm256_castps128_ps256(low), high, 1);
+	}
+	static void store(bfloat16* pointer, vector x) {
+		const __m128i low = sse2_cvtps_bf16_epi32(_mm256_castps256_ps128(x));
+		const __m128i high = sse2_cvtps_bf16_epi32(_mm256_extractf128_ps(x, 1));
+		_mm_storeu_si128((__m128i*)pointer, _mm_packs_epi32(low, high));
+	}
+	static vector add(vector x, vector y) { return _mm256_add_ps(x, y); }
+	static vector max(vector x, vector y) { return _mm256_max_ps(x, y); }
+	static vector lowest() { return _mm256_set1_ps(scalar_lowest<float>()); }
+};
+#endif
+
+#ifdef CSE6230_AVX2_INTRINSICS_SUPPORTED
+template <> struct simd<float, isa_avx2> : simd<float, isa_avx> {};
+
+template <typename T>
+struct avx2_integer {
+	typedef __m256i vector;
+	static const size_t width = 32 / sizeof(T);
+
+	static vector load(const T* pointer) { return _mm256_loadu_si256((const __m256i*)pointer); }
+	static void store(T* pointer, vector x) { _mm256_storeu_si256((__m256i*)pointer, x); }
+	static vector lowest() { return _mm256_set1_epi64x(0); }
+};
+
+template <> struct simd<int32_t, isa_avx2> : avx2_integer<int32_t> {
+	static vector add(vector x, vector y) { return _mm256_add_epi32(x, y); }
+	static vector add_saturated(vector x, vector y) {
+		const vector sum = _mm256_add_epi32(x, y);
+		const vector overflowMask = _mm256_srai_epi32(_mm256_and_si256(_mm256_xor_si256(x, sum), _mm256_xor_si256(y, sum)), 31);
+		const vector saturated = _mm256_xor_si256(_mm256_srai_epi32(x, 31), _mm256_set1_epi32(0x7FFFFFFF));
+		return _mm256_blendv_epi8(sum, saturated, overflowMask);
+	}
+	static vector max(vector x, vector y) { return _mm256_max_epi32(x, y); }
+	static vector lowest() { return _mm256_set1_epi32(std::numeric_limits<int32_t>::min()); }
+};
+
+template <> struct simd<uint32_t, isa_avx2> : avx2_integer<uint32_t> {
+	static vector add(vector x, vector y) { return _mm256_add_epi32(x, y); }
+	static vector add_saturated(vector x, vector y) {
+		const vector sum = _mm256_add_epi32(x, y);
+		// Overflow if max(sum, x) != sum
+		const vector overflowMask = _mm256_xor_si256(_mm256_cmpeq_epi32(_mm256_max_epu32(sum, x), sum), _mm256_set1_epi32(-1));
+		return _mm256_or_si256(sum, overflowMask);
+	}
+	static vector max(vector x, vector y) { return _mm256_max_epu32(x, y); }
+};
+
+template <> struct simd<int64_t, isa_avx2> : avx2_integer<int64_t> {
+	static vector add(vector x, vector y) { return _mm256_add_epi64(x, y); }
+	static vector add_saturated(vector x, vector y) {
+		const vector sum = _mm256_add_epi64(x, y);
+		const vector zero = _mm256_setzero_si256();
+		const vector overflowMask = _mm256_cmpgt_epi64(zero, _mm256_and_si256(_mm256_xor_si256(x, sum), _mm256_xor_si256(y, sum)));
+		const vector saturated = _mm256_xor_si256(_mm256_cmpgt_epi64(zero, x), _mm256_set1_epi64x(0x7FFFFFFFFFFFFFFFll));
+		return _mm256_blendv_epi8(sum, saturated, overflowMask);
+	}
+	static vector max(vector x, vector y) { return _mm256_blendv_epi8(y, x, _mm256_cmpgt_epi64(x, y)); }
+	static vector lowest() { return _mm256_set1_epi64x(std::numeric_limits<int64_t>::min()); }
+};
+
+template <> struct simd<uint64_t, isa_avx2> : avx2_integer<uint64_t> {
+	static vector add(vector x, vector y) { return _mm256_add_epi64(x, y); }
+	static vector add_saturated(vector x, vector y) {
+		const vector sum = _mm256_add_epi64(x, y);
+		const vector signBits = _mm256_set1_epi64x(0x8000000000000000ull);
+		const vector overflowMask = _mm256_cmpgt_epi64(_mm256_xor_si256(x, signBits), _mm256_xor_si256(sum, signBits));
+		return _mm256_or_si256(sum, overflowMask);
+	}
+	static vector max(vector x, vector y) {
+		const vector signBits = _mm256_set1_epi64x(0x8000000000000000ull);
+		return _mm256_blendv_epi8(y, x, _mm256_cmpgt_epi64(_mm256_xor_si256(x, signBits), _mm256_xor_si256(y, signBits)));
+	}
+};
+
+template <>
+struct simd<bfloat16, isa_avx2> {
+	typedef __m256 vector;
+	static const size_t width = 8;
+
+	static vector load(const bfloat16* pointer) {
+		const __m256i bits = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*)pointer));
+		return _mm256_castsi256_ps(_mm256_slli_epi32(bits, 16));
+	}
+	static void store(bfloat16* pointer, vector x) {
+		const __m256i bits = _mm256_castps_si256(x);
+		const __m256i roundingBias = _mm256_add_epi32(_mm256_and_si256(_mm256_srli_epi32(bits, 16), _mm256_set1_epi32(1)), _mm256_set1_epi32(0x7FFF));
+		const __m256i rounded = _mm256_add_epi32(bits, roundingBias);
+		const __m256i quietNaN = _mm256_or_si256(bits, _mm256_set1_epi32(0x00400000));
+		const __m256i nanMask = _mm256_castps_si256(_mm256_cmp_ps(x, x, _CMP_UNORD_Q));
+		const __m256i result = _mm256_srai_epi32(_mm256_blendv_epi8(rounded, quietNaN, nanMask), 16);
+		_mm_storeu_si128((__m128i*)pointer, _mm_packs_epi32(_mm256_castsi256_si128(result), _mm256_extracti128_si256(result, 1)));
+	}
+	static vector add(vector x, vector y) { return _mm256_add_ps(x, y); }
+	static vector max(vector x, vector y) { return _mm256_max_ps(x, y); }
+	static vector lowest() { return _mm256_set1_ps(scalar_lowest<float>()); }
+};
+#endif
+
+#ifdef CSE6230_AVX512F_INTRINSICS_SUPPORTED
+template <>
+struct simd<float, isa_avx512f> {
+	typedef __m512 vector;
+	static const size_t width = 16;
+
+	static vector load(const float* pointer) { return _mm512_loadu_ps(pointer); }
+	static void store(float* pointer, vector x) { _mm512_storeu_ps(pointer, x); }
+	static vector add(vector x, vector y) { return _mm512_add_ps(x, y); }
+	static vector max(vector x, vector y) { return _mm512_max_ps(x, y); }
+	static vector lowest() { return _mm512_set1_ps(scalar_lowest<float>()); }
+};
+
+template <typename T>
+struct avx512f_integer {
+	typedef __m512i vector;
+	static const size_t width = 64 / sizeof(T);
+
+	static vector load(const T* pointer) { return _mm512_loadu_si512(pointer); }
+	static void store(T* pointer, vector x) { _mm512_storeu_si512(pointer, x); }
+	static vector lowest() { return _mm512_setzero_si512(); }
+};
+
+template <> struct simd<int32_t, isa_avx512f> : avx512f_integer<int32_t> {
+	static vector add(vector x, vector y) { return _mm512_add_epi32(x, y); }
+	static vector add_saturated(vector x, vector y) {
+		const vector sum = _mm512_add_epi32(x, y);
+		const __mmask16 overflowMask = _mm512_cmplt_epi32_mask(_mm512_and_si512(_mm512_xor_si512(x, sum), _mm512_xor_si512(y, sum)), _mm512_setzero_si512());
+		const vector saturated = _mm512_xor_si512(_mm512_srai_epi32(x, 31), _mm512_set1_epi32(0x7FFFFFFF));
+		return _mm512_mask_blend_epi32(overflowMask, sum, saturated);
+	}
+	static vector max(vector x, vector y) { return _mm512_max_epi32(x, y); }
+	static vector lowest() { return _mm512_set1_epi32(std::numeric_limits<int32_t>::min()); }
+};
+
+template <> struct simd<uint32_t, isa_avx512f> : avx512f_integer<uint32_t> {
+	static vector add(vector x, vector y) { return _mm512_add_epi32(x, y); }
+	static vector add_saturated(vector x, vector y) {
+		const vector sum = _mm512_add_epi32(x, y);
+		return _mm512_mask_blend_epi32(_mm512_cmplt_epu32_mask(sum, x), sum, _mm512_set1_epi32(-1));
+	}
+	static vector max(vector x, vector y) { return _mm512_max_epu32(x, y); }
+};
+
+template <> struct simd<int64_t, isa_avx512f> : avx512f_integer<int64_t> {
+	static vector add(vector x, vector y) { return _mm512_add_epi64(x, y); }
+	static vector add_saturated(vector x, vector y) {
+		const vector sum = _mm512_add_epi64(x, y);
+		const __mmask8 overflowMask = _mm512_cmplt_epi64_mask(_mm512_and_si512(_mm512_xor_si512(x, sum), _mm512_xor_si512(y, sum)), _mm512_setzero_si512());
+		const vector saturated = _mm512_xor_si512(_mm512_srai_epi64(x, 63), _mm512_set1_epi64(0x7FFFFFFFFFFFFFFFll));
+		return _mm512_mask_blend_epi64(overflowMask, sum, saturated);
+	}
+	static vector max(vector x, vector y) { return _mm512_max_epi64(x, y); }
+	static vector lowest() { return _mm512_set1_epi64(std::numeric_limits<int64_t>::min()); }
+};
+
+template <> struct simd<uint64_t, isa_avx512f> : avx512f_integer<uint64_t> {
+	static vector add(vector x, vector y) { return _mm512_add_epi64(x, y); }
+	static vector add_saturated(vector x, vector y) {
+		const vector sum = _mm512_add_epi64(x, y);
+		return _mm512_mask_blend_epi64(_mm512_cmplt_epu64_mask(sum, x), sum, _mm512_set1_epi64(-1));
+	}
+	static vector max(vector x, vector y) { return _mm512_max_epu64(x, y); }
+};
+
+template <>
+struct simd<bfloat16, isa_avx512f> {
+	typedef __m512 vector;
+	static const size_t width = 16;
+
+	static vector load(const bfloat16* pointer) {
+		const __m512i bits = _mm512_cvtepu16_epi32(_mm256_loadu_si256((const __m256i*)pointer));
+		return _mm512_castsi512_ps(_mm512_slli_epi32(bits, 16));
+	}
+	static void store(bfloat16* pointer, vector x) {
+		const __m512i bits = _mm512_castps_si512(x);
+		const __m512i roundingBias = _mm512_add_epi32(_mm512_and_si512(_mm512_srli_epi32(bits, 16), _mm512_set1_epi32(1)), _mm512_set1_epi32(0x7FFF));
+		const __m512i rounded = _mm512_add_epi32(bits, roundingBias);
+		const __m512i quietNaN = _mm512_or_si512(bits, _mm512_set1_epi32(0x00400000));
+		const __mmask16 nanMask = _mm512_cmp_ps_mask(x, x, _CMP_UNORD_Q);
+		const __m512i result = _mm512_srli_epi32(_mm512_mask_blend_epi32(nanMask, rounded, quietNaN), 16);
+		_mm256_storeu_si256((__m256i*)pointer, _mm512_cvtepi32_epi16(result));
+	}
+	static vector add(vector x, vector y) { return _mm512_add_ps(x, y); }
+	static vector max(vector x, vector y) { return _mm512_max_ps(x, y); }
+	static vector lowest() { return _mm512_set1_ps(scalar_lowest<float>()); }
+};
+#endif
+
+template <typename T, typename ISA>
+inline static T reduce_max(typename simd<T, ISA>::vector x) {
+	T lanes[simd<T, ISA>::width];
+	simd<T, ISA>::store(lanes, x);
+	T max = lanes[0];
+	for (size_t lane = 1; lane < simd<T, ISA>::width; lane += 1) {
+		max = scalar_max(max, lanes[lane]);
+	}
+	return max;
+}
+
+template <typename T, typename ISA>
+void vector_add(const T *CSE6230_RESTRICT xPointer, const T *CSE6230_RESTRICT yPointer, T *CSE6230_RESTRICT sumPointer, size_t length) {
+	typedef simd<T, ISA> simd;
+	// Process arrays by one SIMD vector at an iteration
+	for (; length >= simd::width; length -= simd::width) {
+		const typename simd::vector x = simd::load(xPointer);
+		const typename simd::vector y = simd::load(yPointer);
+		simd::store(sumPointer, simd::add(x, y));
+
+		xPointer += simd::width;
+		yPointer += simd::width;
+		sumPointer += simd::width;
+	}
+	// Process remaining elements (if any)
+	for (; length != 0; length -= 1) {
+		*sumPointer++ = scalar_add(*xPointer++, *yPointer++);
+	}
+}
+
+template <typename T, typename ISA>
+void vector_add_saturated(const T *CSE6230_RESTRICT xPointer, const T *CSE6230_RESTRICT yPointer, T *CSE6230_RESTRICT sumPointer, size_t length) {
+	typedef simd<T, ISA> simd;
+	// Process arrays by one SIMD vector at an iteration
+	for (; length >= simd::width; length -= simd::width) {
+		const typename simd::vector x = simd::load(xPointer);
+		const typename simd::vector y = simd::load(yPointer);
+		simd::store(sumPointer, simd::add_saturated(x, y));
+
+		xPointer += simd::width;
+		yPointer += simd::width;
+		sumPointer += simd::width;
+	}
+	// Process remaining elements (if any)
+	for (; length != 0; length -= 1) {
+		*sumPointer++ = scalar_add_saturated(*xPointer++, *yPointer++);
+	}
+}
+
+template <typename T, typename ISA>
+void vector_max(const T *CSE6230_RESTRICT arrayPointer, T *CSE6230_RESTRICT maxPointer, size_t length) {
+	typedef simd<T, ISA> simd;
+	// Process arrays by one SIMD vector at an iteration
+	typename simd::vector maxVector = simd::lowest();
+	for (; length >= simd::width; length -= simd::width) {
+		// The loaded elements go first, so NaN elements are skipped as in fmaxf
+		maxVector = simd::max(simd::load(arrayPointer), maxVector);
+
+		arrayPointer += simd::width;
+	}
+	T max = reduce_max<T, ISA>(maxVector);
+	// Process remaining elements (if any)
+	for (; length != 0; length -= 1) {
+		max = scalar_max(max, *arrayPointer++);
+	}
+	*maxPointer = max;
+}
+
+#define CSE6230_INSTANTIATE_ADD_MAX(T, ISA) \
+	template void vector_add<T, ISA>(const T*, const T*, T*, size_t); \
+	template void vector_max<T, ISA>(const T*, T*, size_t);
+
+#define CSE6230_INSTANTIATE_INTEGER(T, ISA) \
+	CSE6230_INSTANTIATE_ADD_MAX(T, ISA) \
+	template void vector_add_saturated<T, ISA>(const T*, const T*, T*, size_t);
+
+#define CSE6230_INSTANTIATE_ALL_TYPES(ISA) \
+	CSE6230_INSTANTIATE_ADD_MAX(float, ISA) \
+	CSE6230_INSTANTIATE_ADD_MAX(bfloat16, ISA) \
+	CSE6230_INSTANTIATE_INTEGER(int32_t, ISA) \
+	CSE6230_INSTANTIATE_INTEGER(uint32_t, ISA) \
+	CSE6230_INSTANTIATE_INTEGER(int64_t, ISA) \
+	CSE6230_INSTANTIATE_INTEGER(uint64_t, ISA)
+
+CSE6230_INSTANTIATE_ALL_TYPES(isa_naive)
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+	CSE6230_INSTANTIATE_ALL_TYPES(isa_sse2)
+#endif
+#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+	CSE6230_INSTANTIATE_ADD_MAX(float, isa_avx)
+	CSE6230_INSTANTIATE_ADD_MAX(bfloat16, isa_avx)
+#endif
+#ifdef CSE6230_AVX2_INTRINSICS_SUPPORTED
+	CSE6230_INSTANTIATE_ALL_TYPES(isa_avx2)
+#endif
+#ifdef CSE6230_AVX512F_INTRINSICS_SUPPORTED
+	CSE6230_INSTANTIATE_ALL_TYPES(isa_avx512f)
+#endif
@@ -0,0 +1,54 @@
+/******************************************************************************\
+ *                                                                            *
+ * Copyright (c) 2012 Marat Dukhan                                            *
+ *                                                                            *
+ * This software is provided 'as-is', without any express or implied          *
+ * warranty. In no event will the authors be held liable for any damages      *
+ * arising from the use of this software.                                     *
+ *                                                                            *
+ * Permission is granted to anyone to use this software for any purpose,      *
+ * including commercial applications, and to alter it and redistribute it     *
+ * freely, subject to the following restrictions:                             *
+ *                                                                            *
+ * 1. The origin of this software must not be misrepresented; you must not    *
+ * claim that you wrote the original software. If you use this software       *
+ * in a product, an acknowledgment in the product documentation would be      *
+ * appreciated but is not required.                                           *
+ *                                                                            *
+ * 2. Altered source versions must be plainly marked as such, and must not be *
+ * misrepresented as being the original software.                             *
+ *                                                                            *
+ * 3. This notice may not be removed or altered from any source               *
+ * distribution.                                                              *
+ *                                                                            *
+\******************************************************************************/
+
+#pragma once
+
+#include <compute.hpp>
+#include <formats.hpp>
+#include <isa.hpp>
+
+// Element-type-generic versions of the vector_add and vector_max kernels.
+// Supported element types are float, int32_t, uint32_t, int64_t, uint64_t and bfloat16.
+// Signed and unsigned integer types differ in vector_add_saturated and vector_max.
+
+// Kernels compute bfloat16 numbers (see formats.hpp) in single precision and round the results to nearest-even.
+
+// sum[i] = x[i] + y[i] (wrapping for integer types)
+template <typename T, typename ISA>
+void vector_add(const T *CSE6230_RESTRICT xPointer, const T *CSE6230_RESTRICT yPointer, T *CSE6230_RESTRICT sumPointer, size_t length);
+
+// sum[i] = x[i] + y[i] clamped to the range of the integer type
+template <typename T, typename ISA>
+void vector_add_saturated(const T *CSE6230_RESTRICT xPointer, const T *CSE6230_RESTRICT yPointer, T *CSE6230_RESTRICT sumPointer, size_t length);
+
+// *max = the maximum element of array, or the lowest value of T if length is 0
+template <typename T, typename ISA>
+void vector_max(const T *CSE6230_RESTRICT arrayPointer, T *CSE6230_RESTRICT maxPointer, size_t length);
+
+// Instantiations in typed.cpp:
+//   isa_naive and isa_sse2: all element types
+//   isa_avx: float and bfloat16 (AVX has no 256-bit integer instructions)
+//   isa_avx2 and isa_avx512f: all element types
+// vector_add_saturated is instantiated only for integer element types.
@@ -0,0 +1,107 @@
+/******************************************************************************\
+ *                                                                            *
+ * Copyright (c) 2012 Marat Dukhan                                            *
+ *                                                                            *
+ * This software is provided 'as-is', without any express or implied          *
+ * warranty. In no event will the authors be held liable for any damages      *
+ * arising from the use of this software.                                     *
+ *                                                                            *
+ * Permission is granted to anyone to use this software for any purpose,      *
+ * including commercial applications, and to alter it and redistribute it     *
+ * freely, subject to the following restrictions:                             *
+ *                                                                            *
+ * 1. The origin of this software must not be misrepresented; you must not    *
+ * claim that you wrote the original software. If you use this software       *
+ * in a product, an acknowledgment in the product documentation would be      *
+ * appreciated but is not required.                                           *
+ *                                                                            *
+ * 2. Altered source versions must be plainly marked as such, and must not be *
+ * misrepresented as being the original software.                             *
+ *                                                                            *
+ * 3. This notice may not be removed or altered from any source               *
+ * distribution.                                                              *
+ *                                                                            *
+\******************************************************************************/
+
+#include <baseline.hpp>
+#if defined(CSE6230_UNSEQ_SUPPORTED) || defined(CSE6230_PAR_UNSEQ_SUPPORTED)
+	#include <execution>
+	#include <algorithm>
+#endif
+
+// A loop annotated with #pragma omp simd
+
+void vector3d_dot_products_omp_simd(const double *CSE6230_RESTRICT vPointer, const double *CSE6230_RESTRICT uPointer, double *CSE6230_RESTRICT dpPointer, size_t vectorsCount) {
+	#pragma omp simd
+	for (size_t i = 0; i < vectorsCount; i++) {
+		dpPointer[i] = vPointer[3 * i] * uPointer[3 * i] + vPointer[3 * i + 1] * uPointer[3 * i + 1] + vPointer[3 * i + 2] * uPointer[3 * i + 2];
+	}
+}
+
+// Standard library algorithms with an execution policy
+
+#if defined(CSE6230_UNSEQ_SUPPORTED) || defined(CSE6230_PAR_UNSEQ_SUPPORTED)
+// Same layout as three consecutive doubles
+struct vector3d {
+	double x, y, z;
+};
+
+template <typename ExecutionPolicy>
+inline static void std_vector3d_dot_products(ExecutionPolicy&& policy, const double* vPointer, const double* uPointer, double* dpPointer, size_t vectorsCount) {
+	const vector3d* v = reinterpret_cast<const vector3d*>(vPointer);
+	const vector3d* u = reinterpret_cast<const vector3d*>(uPointer);
+	std::transform(policy, v, v + vectorsCount, u, dpPointer,
+		[](const vector3d& v, const vector3d& u) { return v.x * u.x + v.y * u.y + v.z * u.z; });
+}
+#endif
+
+#ifdef CSE6230_UNSEQ_SUPPORTED
+void vector3d_dot_products_unseq(const double *CSE6230_RESTRICT vPointer, const double *CSE6230_RESTRICT uPointer, double *CSE6230_RESTRICT dpPointer, size_t vectorsCount) {
+	std_vector3d_dot_products(std::execution::unseq, vPointer, uPointer, dpPointer, vectorsCount);
+}
+#endif
+
+#ifdef CSE6230_PAR_UNSEQ_SUPPORTED
+void vector3d_dot_products_par_unseq(const double *CSE6230_RESTRICT vPointer, const double *CSE6230_RESTRICT uPointer, double *CSE6230_RESTRICT dpPointer, size_t vectorsCount) {
+	std_vector3d_dot_products(std::execution::par_unseq, vPointer, uPointer, dpPointer, vectorsCount);
+}
+#endif
+
+// Generic vector types. The compiler chooses how to gather the coordinates and lowers the arithmetic
+// to the widest instruction set enabled by the compiler flags.
+
+#ifdef CSE6230_VECTOR_EXTENSIONS_SUPPORTED
+typedef double double4 __attribute__((vector_size(32)));
+
+void vector3d_dot_products_vector_extensions(const double *CSE6230_RESTRICT vPointer, const double *CSE6230_RESTRICT uPointer, double *CSE6230_RESTRICT dpPointer, size_t vectorsCount) {
+	// Process arrays by four vectors at an iteration
+	for (; vectorsCount >= 4; vectorsCount -= 4) {
+		const double4 vX = { vPointer[0], vPointer[3], vPointer[6], vPointer[9] };
+		const double4 vY = { vPointer[1], vPointer[4], vPointer[7], vPointer[10] };
+		const double4 vZ = { vPointer[2], vPointer[5], vPointer[8], vPointer[11] };
+		const double4 uX = { uPointer[0], uPointer[3], uPointer[6], uPointer[9] };
+		const double4 uY = { uPointer[1], uPointer[4], uPointer[7], uPointer[10] };
+		const double4 uZ = { uPointer[2], uPointer[5], uPointer[8], uPointer[11] };
+
+		const double4 dp = vX * uX + vY * uY + vZ * uZ;
+		dpPointer[0] = dp[0];
+		dpPointer[1] = dp[1];
+		dpPointer[2] = dp[2];
+		dpPointer[3] = dp[3];
+
+		vPointer += 12;
+		uPointer += 12;
+		dpPointer += 4;
+	}
+	// Process remaining vectors (if any)
+	for (; vectorsCount != 0; vectorsCount -= 1) {
+		*dpPointer = vPointer[0] * uPointer[0] + vPointer[1] * uPointer[1] + vPointer[2] * uPointer[2];
+
+		// Advance pointers to the next 3-element vectors
+		vPointer += 3;
+		uPointer += 3;
+		// Advance pointer to the next dot product
+		dpPointer += 1;
+	}
+}
+#endif
@@ -24,6 +24,10 @@
 \******************************************************************************/
 
 #include <compute.hpp>
+#include <formats.hpp>
+#include <transpose.hpp>
+#include <dispatch.hpp>
+#include <telemetry.hpp>
 #include <math.h>
 #if defined(CSE6230_SSE2_INTRINSICS_SUPPORTED) || defined(CSE6230_AVX_INTRINSICS_SUPPORTED)
 	#if defined(__GNUC__)
@@ -75,7 +79,7 @@ void vector3d_dot_products_sse2(const double *CSE6230_RESTRICT vPointer, const d
 		const __m128d uv0Z_uv1X = _mm_mul_pd(v0Z_v1X, u0Z_u1X);
 		const __m128d uv1Y_uv1Z = _mm_mul_pd(v1Y_v1Z, u1Y_u1Z);
 		
-		const __m128d uv0X_uv1Y = _mm_unpacklo_pd(uv0Z_uv1X, uv1Y_uv1Z);
+		const __m128d uv0X_uv1Y = _mm_unpacklo_pd(uv0X_uv0Y, uv1Y_uv1Z);
 		const __m128d uv0Y_uv1Z = _mm_unpackhi_pd(uv0X_uv0Y, uv1Y_uv1Z);
 		
 		const __m128d dp0_dp1 = _mm_add_pd(_mm_add_pd(uv0X_uv1Y, uv0Y_uv1Z), uv0Z_uv1X);
@@ -214,3 +218,151 @@ void vector3d_dot_products_fma4(const double *CSE6230_RESTRICT vPointer, const d
 }
 #endif
 
+static dispatch_cache<vector3d_dot_products_function> vector3d_dot_products_dispatch_cache;
+
+void vector3d_dot_products_dispatch(const double *CSE6230_RESTRICT v1Pointer, const double *CSE6230_RESTRICT v2Pointer, double *CSE6230_RESTRICT dpPointer, size_t vectorsCount) {
+	const uintptr_t pointerBits = uintptr_t(v1Pointer) | uintptr_t(v2Pointer) | uintptr_t(dpPointer);
+	const vector3d_dot_products_function kernel = dispatch_select(vector3d_dot_products_dispatch_cache,
+		kernel_registry_operation_vector3d_dot_products, pointerBits, &vector3d_dot_products_naive);
+	if (kernel_telemetry_is_enabled()) {
+		const uint64_t startTicks = kernel_telemetry_begin(kernel_registry_operation_vector3d_dot_products, vectorsCount, pointerBits);
+		kernel(v1Pointer, v2Pointer, dpPointer, vectorsCount);
+		kernel_telemetry_end(kernel_registry_operation_vector3d_dot_products, startTicks);
+	} else {
+		kernel(v1Pointer, v2Pointer, dpPointer, vectorsCount);
+	}
+}
+
+
+void vector3d_dot_products_f32_naive(const float *CSE6230_RESTRICT vPointer, const float *CSE6230_RESTRICT uPointer, double *CSE6230_RESTRICT dpPointer, size_t vectorsCount) {
+	for (; vectorsCount != 0; vectorsCount -= 1) {
+		const double vX = vPointer[0];
+		const double vY = vPointer[1];
+		const double vZ = vPointer[2];
+		
+		const double uX = uPointer[0];
+		const double uY = uPointer[1];
+		const double uZ = uPointer[2];
+
+		const double dotProduct = vX * uX + vY * uY + vZ * uZ;
+		*dpPointer = dotProduct;
+		
+		// Advance pointers to the next 3-element vectors
+		vPointer += 3;
+		uPointer += 3;
+		// Advance pointer to the next dot product
+		dpPointer += 1;
+	}
+}
+
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+void vector3d_dot_products_f32_sse2(const float *CSE6230_RESTRICT vPointer, const float *CSE6230_RESTRICT uPointer, double *CSE6230_RESTRICT dpPointer, size_t vectorsCount) {
+	// Process arrays by four elements at an iteration
+	for (; vectorsCount >= 4; vectorsCount -= 4) {
+		// Load four V and four U vectors and transpose them into components
+		__m128 vX4, vY4, vZ4, uX4, uY4, uZ4;
+		transpose3_ps(_mm_loadu_ps(vPointer), _mm_loadu_ps(vPointer + 4), _mm_loadu_ps(vPointer + 8), vX4, vY4, vZ4);
+		transpose3_ps(_mm_loadu_ps(uPointer), _mm_loadu_ps(uPointer + 4), _mm_loadu_ps(uPointer + 8), uX4, uY4, uZ4);
+		
+		// Convert the components of vectors 0 and 1 to double precision and compute two dot products
+		const __m128d dp0_dp1 = _mm_add_pd(_mm_add_pd(
+			_mm_mul_pd(_mm_cvtps_pd(vX4), _mm_cvtps_pd(uX4)),
+			_mm_mul_pd(_mm_cvtps_pd(vY4), _mm_cvtps_pd(uY4))),
+			_mm_mul_pd(_mm_cvtps_pd(vZ4), _mm_cvtps_pd(uZ4)));
+		// Same for vectors 2 and 3: movehl moves their components into the low half
+		const __m128d dp2_dp3 = _mm_add_pd(_mm_add_pd(
+			_mm_mul_pd(_mm_cvtps_pd(_mm_movehl_ps(vX4, vX4)), _mm_cvtps_pd(_mm_movehl_ps(uX4, uX4))),
+			_mm_mul_pd(_mm_cvtps_pd(_mm_movehl_ps(vY4, vY4)), _mm_cvtps_pd(_mm_movehl_ps(uY4, uY4)))),
+			_mm_mul_pd(_mm_cvtps_pd(_mm_movehl_ps(vZ4, vZ4)), _mm_cvtps_pd(_mm_movehl_ps(uZ4, uZ4))));
+		
+		_mm_storeu_pd(dpPointer, dp0_dp1); // Store four dot products
+		_mm_storeu_pd(dpPointer + 2, dp2_dp3);
+		
+		// Advance pointers to the next four elements
+		vPointer += 12;
+		uPointer += 12;
+		dpPointer += 4;
+	}
+	// Process remaining vectors (if any)
+	vector3d_dot_products_f32_naive(vPointer, uPointer, dpPointer, vectorsCount);
+}
+#endif
+
+#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+// Computes four double-precision dot products of vectors transposed into single-precision components
+inline static __m256d dot_products_ps_to_pd(__m128 vX4, __m128 vY4, __m128 vZ4, __m128 uX4, __m128 uY4, __m128 uZ4) {
+	const __m256d uvX = _mm256_mul_pd(_mm256_cvtps_pd(vX4), _mm256_cvtps_pd(uX4));
+	const __m256d uvY = _mm256_mul_pd(_mm256_cvtps_pd(vY4), _mm256_cvtps_pd(uY4));
+	const __m256d uvZ = _mm256_mul_pd(_mm256_cvtps_pd(vZ4), _mm256_cvtps_pd(uZ4));
+	return _mm256_add_pd(_mm256_add_pd(uvX, uvY), uvZ);
+}
+
+void vector3d_dot_products_f32_avx(const float *CSE6230_RESTRICT vPointer, const float *CSE6230_RESTRICT uPointer, double *CSE6230_RESTRICT dpPointer, size_t vectorsCount) {
+	// Process arrays by four elements at an iteration
+	for (; vectorsCount >= 4; vectorsCount -= 4) {
+		// Load four V and four U vectors and transpose them into components
+		__m128 vX4, vY4, vZ4, uX4, uY4, uZ4;
+		transpose3_ps(_mm_loadu_ps(vPointer), _mm_loadu_ps(vPointer + 4), _mm_loadu_ps(vPointer + 8), vX4, vY4, vZ4);
+		transpose3_ps(_mm_loadu_ps(uPointer), _mm_loadu_ps(uPointer + 4), _mm_loadu_ps(uPointer + 8), uX4, uY4, uZ4);
+		
+		_mm256_storeu_pd(dpPointer, dot_products_ps_to_pd(vX4, vY4, vZ4, uX4, uY4, uZ4)); // Store four dot products
+		
+		// Advance pointers to the next four elements
+		vPointer += 12;
+		uPointer += 12;
+		dpPointer += 4;
+	}
+	// Process remaining vectors (if any)
+	vector3d_dot_products_f32_naive(vPointer, uPointer, dpPointer, vectorsCount);
+}
+#endif
+
+void vector3d_dot_products_f16_naive(const uint16_t *CSE6230_RESTRICT vPointer, const uint16_t *CSE6230_RESTRICT uPointer, double *CSE6230_RESTRICT dpPointer, size_t vectorsCount) {
+	for (; vectorsCount != 0; vectorsCount -= 1) {
+		const double vX = half_to_double(vPointer[0]);
+		const double vY = half_to_double(vPointer[1]);
+		const double vZ = half_to_double(vPointer[2]);
+		
+		const double uX = half_to_double(uPointer[0]);
+		const double uY = half_to_double(uPointer[1]);
+		const double uZ = half_to_double(uPointer[2]);
+
+		const double dotProduct = vX * uX + vY * uY + vZ * uZ;
+		*dpPointer = dotProduct;
+		
+		// Advance pointers to the next 3-element vectors
+		vPointer += 3;
+		uPointer += 3;
+		// Advance pointer to the next dot product
+		dpPointer += 1;
+	}
+}
+
+#if defined(CSE6230_AVX_INTRINSICS_SUPPORTED) && defined(CSE6230_F16C_INTRINSICS_SUPPORTED)
+// Loads four half-precision 3D vectors and transposes them into single-precision components
+inline static void load3_ph(const uint16_t* pointer, __m128& x, __m128& y, __m128& z) {
+	const __m128i halfs01 = _mm_loadu_si128((const __m128i*)pointer);
+	const __m128i halfs2 = _mm_loadl_epi64((const __m128i*)(pointer + 8));
+	// Half-precision numbers are exactly representable in single precision
+	transpose3_ps(_mm_cvtph_ps(halfs01), _mm_cvtph_ps(_mm_unpackhi_epi64(halfs01, halfs01)), _mm_cvtph_ps(halfs2), x, y, z);
+}
+
+void vector3d_dot_products_f16_f16c(const uint16_t *CSE6230_RESTRICT vPointer, const uint16_t *CSE6230_RESTRICT uPointer, double *CSE6230_RESTRICT dpPointer, size_t vectorsCount) {
+	// Process arrays by four elements at an iteration
+	for (; vectorsCount >= 4; vectorsCount -= 4) {
+		// Load four V and four U vectors and transpose them into components
+		__m128 vX4, vY4, vZ4, uX4, uY4, uZ4;
+		load3_ph(vPointer, vX4, vY4, vZ4);
+		load3_ph(uPointer, uX4, uY4, uZ4);
+		
+		_mm256_storeu_pd(dpPointer, dot_products_ps_to_pd(vX4, vY4, vZ4, uX4, uY4, uZ4)); // Store four dot products
+		
+		// Advance pointers to the next four elements
+		vPointer += 12;
+		uPointer += 12;
+		dpPointer += 4;
+	}
+	// Process remaining vectors (if any)
+	vector3d_dot_products_f16_naive(vPointer, uPointer, dpPointer, vectorsCount);
+}
+#endif
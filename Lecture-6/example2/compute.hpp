@@ -28,40 +28,7 @@
 #include <stddef.h>
 #include <stdint.h>
 
-#if defined(__GNUC__)
-	// gcc or gcc-compatible compiler
-	#define CSE6230_RESTRICT __restrict__
-#elif defined(_MSC_VER)
-	// msvc or msvc-compatible compiler
-	#define CSE6230_RESTRICT __restrict
-#else
-	#warning Compiler is not recognized and restrict qualifier is not used.
-	#define CSE6230_RESTRICT
-#endif
-
-#if defined(__GNUC__)
-	#if defined(__SSE2__)
-		#define CSE6230_SSE2_INTRINSICS_SUPPORTED
-	#endif
-	#if defined(__SSE3__)
-		#define CSE6230_SSE3_INTRINSICS_SUPPORTED
-	#endif
-	#if defined(__AVX__)
-		#define CSE6230_AVX_INTRINSICS_SUPPORTED
-	#endif
-	#if defined(__FMA4__)
-		#define CSE6230_FMA4_INTRINSICS_SUPPORTED
-	#endif
-#elif defined(_MSC_VER)
-	#if defined(_M_IX86) || defined(_M_X64)
-		#define CSE6230_SSE2_INTRINSICS_SUPPORTED
-		#define CSE6230_SSE3_INTRINSICS_SUPPORTED
-		#define CSE6230_AVX_INTRINSICS_SUPPORTED
-		#define CSE6230_FMA4_INTRINSICS_SUPPORTED
-	#endif
-#else
-	#warning Compiler is not recognized and intrinsic functions are not used.
-#endif
+#include <isa.hpp>
 
 
 typedef void (*vector3d_dot_products_function)(const double*, const double*, double*, size_t);
@@ -76,3 +43,23 @@ extern "C" void vector3d_dot_products_sse3(const double *CSE6230_RESTRICT v1Poin
 #ifdef CSE6230_FMA4_INTRINSICS_SUPPORTED
 extern "C" void vector3d_dot_products_fma4(const double *CSE6230_RESTRICT v1Pointer, const double *CSE6230_RESTRICT v2Pointer, double *CSE6230_RESTRICT dpPointer, size_t vectorsCount);
 #endif
+// Dispatcher: calls the kernel which the registry selects for the alignment of the arrays.
+// The calls are recorded in the histograms of telemetry.hpp when telemetry is enabled.
+extern "C" void vector3d_dot_products_dispatch(const double *CSE6230_RESTRICT v1Pointer, const double *CSE6230_RESTRICT v2Pointer, double *CSE6230_RESTRICT dpPointer, size_t vectorsCount);
+
+// Mixed-precision dot products: vectors are stored in single (f32) or half (f16, IEEE binary16) precision,
+// and dot products are computed and stored in double precision.
+typedef void (*vector3d_dot_products_f32_function)(const float*, const float*, double*, size_t);
+typedef void (*vector3d_dot_products_f16_function)(const uint16_t*, const uint16_t*, double*, size_t);
+
+extern "C" void vector3d_dot_products_f32_naive(const float *CSE6230_RESTRICT vPointer, const float *CSE6230_RESTRICT uPointer, double *CSE6230_RESTRICT dpPointer, size_t vectorsCount);
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+extern "C" void vector3d_dot_products_f32_sse2(const float *CSE6230_RESTRICT vPointer, const float *CSE6230_RESTRICT uPointer, double *CSE6230_RESTRICT dpPointer, size_t vectorsCount);
+#endif
+#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+extern "C" void vector3d_dot_products_f32_avx(const float *CSE6230_RESTRICT vPointer, const float *CSE6230_RESTRICT uPointer, double *CSE6230_RESTRICT dpPointer, size_t vectorsCount);
+#endif
+extern "C" void vector3d_dot_products_f16_naive(const uint16_t *CSE6230_RESTRICT vPointer, const uint16_t *CSE6230_RESTRICT uPointer, double *CSE6230_RESTRICT dpPointer, size_t vectorsCount);
+#if defined(CSE6230_AVX_INTRINSICS_SUPPORTED) && defined(CSE6230_F16C_INTRINSICS_SUPPORTED)
+extern "C" void vector3d_dot_products_f16_f16c(const uint16_t *CSE6230_RESTRICT vPointer, const uint16_t *CSE6230_RESTRICT uPointer, double *CSE6230_RESTRICT dpPointer, size_t vectorsCount);
+#endif
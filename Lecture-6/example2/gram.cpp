@@ -0,0 +1,296 @@
+/******************************************************************************\
+ *                                                                            *
+ * Copyright (c) 2012 Marat Dukhan                                            *
+ *                                                                            *
+ * This software is provided 'as-is', without any express or implied          *
+ * warranty. In no event will the authors be held liable for any damages      *
+ * arising from the use of this software.                                     *
+ *                                                                            *
+ * Permission is granted to anyone to use this software for any purpose,      *
+ * including commercial applications, and to alter it and redistribute it     *
+ * freely, subject to the following restrictions:                             *
+ *                                                                            *
+ * 1. The origin of this software must not be misrepresented; you must not    *
+ * claim that you wrote the original software. If you use this software       *
+ * in a product, an acknowledgment in the product documentation would be      *
+ * appreciated but is not required.                                           *
+ *                                                                            *
+ * 2. Altered source versions must be plainly marked as such, and must not be *
+ * misrepresented as being the original software.                             *
+ *                                                                            *
+ * 3. This notice may not be removed or altered from any source               *
+ * distribution.                                                              *
+ *                                                                            *
+\******************************************************************************/
+
+#include <gram.hpp>
+#include <typed.hpp>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+#if defined(CSE6230_SSE2_INTRINSICS_SUPPORTED) || defined(CSE6230_AVX_INTRINSICS_SUPPORTED)
+	#if defined(__GNUC__)
+		#include <x86intrin.h>
+	#elif defined(_MSC_VER)
+		#include <intrin.h>
+	#else
+		#error Intrinsics headers are not included: unknown compiler
+	#endif
+#endif
+
+// Operations on SIMD vectors of doubles for the Gram matrix. Each specialization provides:
+//   multiply_add: a * b + c, fused where the instruction set has FMA
+template <typename ISA>
+struct gram_pd;
+
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+template <>
+struct gram_pd<isa_sse2> {
+	typedef __m128d vector;
+	static const size_t width = 2;
+
+	static vector load(const double* pointer) { return _mm_load_pd(pointer); }
+	static void store(double* pointer, vector a) { _mm_storeu_pd(pointer, a); }
+	static vector broadcast(double value) { return _mm_set1_pd(value); }
+	static vector mul(vector a, vector b) { return _mm_mul_pd(a, b); }
+	static vector multiply_add(vector a, vector b, vector c) { return _mm_add_pd(_mm_mul_pd(a, b), c); }
+};
+#endif
+
+#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+template <>
+struct gram_pd<isa_avx> {
+	typedef __m256d vector;
+	static const size_t width = 4;
+
+	static vector load(const double* pointer) { return _mm256_load_pd(pointer); }
+	static void store(double* pointer, vector a) { _mm256_storeu_pd(pointer, a); }
+	static vector broadcast(double value) { return _mm256_set1_pd(value); }
+	static vector mul(vector a, vector b) { return _mm256_mul_pd(a, b); }
+	static vector multiply_add(vector a, vector b, vector c) { return _mm256_add_pd(_mm256_mul_pd(a, b), c); }
+};
+#endif
+
+#if defined(CSE6230_AVX2_INTRINSICS_SUPPORTED) && defined(CSE6230_FMA3_INTRINSICS_SUPPORTED)
+template <>
+struct gram_pd<isa_avx2> {
+	typedef __m256d vector;
+	static const size_t width = 4;
+
+	static vector load(const double* pointer) { return _mm256_load_pd(pointer); }
+	static void store(double* pointer, vector a) { _mm256_storeu_pd(pointer, a); }
+	static vector broadcast(double value) { return _mm256_set1_pd(value); }
+	static vector mul(vector a, vector b) { return _mm256_mul_pd(a, b); }
+	static vector multiply_add(vector a, vector b, vector c) { return _mm256_fmadd_pd(a, b, c); }
+};
+#endif
+
+#ifdef CSE6230_AVX512F_INTRINSICS_SUPPORTED
+template <>
+struct gram_pd<isa_avx512f> {
+	typedef __m512d vector;
+	static const size_t width = 8;
+
+	static vector load(const double* pointer) { return _mm512_load_pd(pointer); }
+	static void store(double* pointer, vector a) { _mm512_storeu_pd(pointer, a); }
+	static vector broadcast(double value) { return _mm512_set1_pd(value); }
+	static vector mul(vector a, vector b) { return _mm512_mul_pd(a, b); }
+	static vector multiply_add(vector a, vector b, vector c) { return _mm512_fmadd_pd(a, b, c); }
+};
+#endif
+
+// Rows of the register block
+static const size_t gram_block_rows = 4;
+
+// Columns of a panel. Rows of the output are written in segments of the panel length, so long panels keep the stores sequential.
+static const size_t gram_panel_columns = 512;
+
+// Columns of a panel: the transposed u vectors of a tile, grouped by two SIMD vectors of columns as
+// [x of the group] [y of the group] [z of the group], and zero-padded to a whole group
+template <typename ISA>
+struct gram_panel {
+	typedef gram_pd<ISA> simd;
+	static const size_t group_columns = 2 * simd::width;
+
+	alignas(64) double components[3 * gram_panel_columns];
+	size_t columns;
+
+	gram_panel(const double* uPointer, size_t columns) : columns(columns) {
+		for (size_t group = 0; group < columns; group += group_columns) {
+			double* groupComponents = components + 3 * group;
+			for (size_t column = 0; column < group_columns; column++) {
+				const bool valid = group + column < columns;
+				const double* u = uPointer + 3 * (group + column);
+				groupComponents[column] = valid ? u[0] : 0.0;
+				groupComponents[group_columns + column] = valid ? u[1] : 0.0;
+				groupComponents[2 * group_columns + column] = valid ? u[2] : 0.0;
+			}
+		}
+	}
+};
+
+// Computes Rows rows of the dot products with a group of the panel. Only the first columns of the group are stored.
+template <typename ISA, size_t Rows>
+static void gram_block(const double* vPointer, const double* groupComponents, size_t columns, double* gramPointer, size_t gramStride) {
+	typedef gram_pd<ISA> simd;
+	const size_t groupColumns = gram_panel<ISA>::group_columns;
+	const typename simd::vector uX0 = simd::load(groupComponents);
+	const typename simd::vector uX1 = simd::load(groupComponents + simd::width);
+	const typename simd::vector uY0 = simd::load(groupComponents + groupColumns);
+	const typename simd::vector uY1 = simd::load(groupComponents + groupColumns + simd::width);
+	const typename simd::vector uZ0 = simd::load(groupComponents + 2 * groupColumns);
+	const typename simd::vector uZ1 = simd::load(groupComponents + 2 * groupColumns + simd::width);
+	typename simd::vector dotProducts0[Rows], dotProducts1[Rows];
+	for (size_t row = 0; row < Rows; row++) {
+		const typename simd::vector vX = simd::broadcast(vPointer[3 * row]);
+		const typename simd::vector vY = simd::broadcast(vPointer[3 * row + 1]);
+		const typename simd::vector vZ = simd::broadcast(vPointer[3 * row + 2]);
+		dotProducts0[row] = simd::multiply_add(vZ, uZ0, simd::multiply_add(vY, uY0, simd::mul(vX, uX0)));
+		dotProducts1[row] = simd::multiply_add(vZ, uZ1, simd::multiply_add(vY, uY1, simd::mul(vX, uX1)));
+	}
+	if (columns == groupColumns) {
+		for (size_t row = 0; row < Rows; row++) {
+			simd::store(gramPointer + row * gramStride, dotProducts0[row]);
+			simd::store(gramPointer + row * gramStride + simd::width, dotProducts1[row]);
+		}
+	} else {
+		// The last group of the panel
+		double rowDotProducts[groupColumns];
+		for (size_t row = 0; row < Rows; row++) {
+			simd::store(rowDotProducts, dotProducts0[row]);
+			simd::store(rowDotProducts + simd::width, dotProducts1[row]);
+			for (size_t column = 0; column < columns; column++) {
+				gramPointer[row * gramStride + column] = rowDotProducts[column];
+			}
+		}
+	}
+}
+
+template <typename ISA>
+static void gram_matrix(const double* vPointer, size_t vCount, const double* uPointer, size_t uCount, double* gramPointer, size_t gramStride) {
+	const size_t groupColumns = gram_panel<ISA>::group_columns;
+	for (size_t panelColumn = 0; panelColumn < uCount; panelColumn += gram_panel_columns) {
+		const size_t panelColumns = std::min(uCount - panelColumn, gram_panel_columns);
+		const gram_panel<ISA> panel(uPointer + 3 * panelColumn, panelColumns);
+		size_t row = 0;
+		for (; row + gram_block_rows <= vCount; row += gram_block_rows) {
+			for (size_t group = 0; group < panelColumns; group += groupColumns) {
+				gram_block<ISA, gram_block_rows>(vPointer + 3 * row, panel.components + 3 * group, std::min(panelColumns - group, groupColumns),
+					gramPointer + row * gramStride + panelColumn + group, gramStride);
+			}
+		}
+		// Process remaining rows (if any)
+		for (; row < vCount; row++) {
+			for (size_t group = 0; group < panelColumns; group += groupColumns) {
+				gram_block<ISA, 1>(vPointer + 3 * row, panel.components + 3 * group, std::min(panelColumns - group, groupColumns),
+					gramPointer + row * gramStride + panelColumn + group, gramStride);
+			}
+		}
+	}
+}
+
+void vector3d_gram_matrix_naive(const double *CSE6230_RESTRICT vPointer, size_t vCount, const double *CSE6230_RESTRICT uPointer, size_t uCount, double *CSE6230_RESTRICT gramPointer, size_t gramStride) {
+	for (size_t row = 0; row < vCount; row++) {
+		const double* v = vPointer + 3 * row;
+		for (size_t column = 0; column < uCount; column++) {
+			const double* u = uPointer + 3 * column;
+			gramPointer[row * gramStride + column] = (v[0] * u[0] + v[1] * u[1]) + v[2] * u[2];
+		}
+	}
+}
+
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+void vector3d_gram_matrix_sse2(const double *CSE6230_RESTRICT vPointer, size_t vCount, const double *CSE6230_RESTRICT uPointer, size_t uCount, double *CSE6230_RESTRICT gramPointer, size_t gramStride) {
+	gram_matrix<isa_sse2>(vPointer, vCount, uPointer, uCount, gramPointer, gramStride);
+}
+#endif
+
+#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+void vector3d_gram_matrix_avx(const double *CSE6230_RESTRICT vPointer, size_t vCount, const double *CSE6230_RESTRICT uPointer, size_t uCount, double *CSE6230_RESTRICT gramPointer, size_t gramStride) {
+	gram_matrix<isa_avx>(vPointer, vCount, uPointer, uCount, gramPointer, gramStride);
+}
+#endif
+
+#if defined(CSE6230_AVX2_INTRINSICS_SUPPORTED) && defined(CSE6230_FMA3_INTRINSICS_SUPPORTED)
+void vector3d_gram_matrix_avx2(const double *CSE6230_RESTRICT vPointer, size_t vCount, const double *CSE6230_RESTRICT uPointer, size_t uCount, double *CSE6230_RESTRICT gramPointer, size_t gramStride) {
+	gram_matrix<isa_avx2>(vPointer, vCount, uPointer, uCount, gramPointer, gramStride);
+}
+#endif
+
+#ifdef CSE6230_AVX512F_INTRINSICS_SUPPORTED
+void vector3d_gram_matrix_avx512f(const double *CSE6230_RESTRICT vPointer, size_t vCount, const double *CSE6230_RESTRICT uPointer, size_t uCount, double *CSE6230_RESTRICT gramPointer, size_t gramStride) {
+	gram_matrix<isa_avx512f>(vPointer, vCount, uPointer, uCount, gramPointer, gramStride);
+}
+#endif
+
+// Runs computeTile(tile) for tiles 0 ... tilesCount - 1 on threadsCount threads, which take the next tile from a shared counter.
+// The calling thread is one of the threads.
+template <typename ComputeTile>
+static void gram_schedule(size_t tilesCount, size_t threadsCount, const ComputeTile& computeTile) {
+	if (threadsCount == 0) {
+		threadsCount = std::thread::hardware_concurrency();
+	}
+	if (threadsCount > tilesCount) {
+		threadsCount = tilesCount;
+	}
+	std::atomic<size_t> nextTile(0);
+	const auto computeTiles = [tilesCount, &computeTile, &nextTile]() {
+		for (size_t tile = nextTile.fetch_add(1); tile < tilesCount; tile = nextTile.fetch_add(1)) {
+			computeTile(tile);
+		}
+	};
+	std::vector<std::thread> threads;
+	for (size_t thread = 1; thread < threadsCount; thread++) {
+		threads.push_back(std::thread(computeTiles));
+	}
+	computeTiles();
+	for (size_t thread = 0; thread < threads.size(); thread++) {
+		threads[thread].join();
+	}
+}
+
+void vector3d_gram_matrix_parallel(vector3d_gram_matrix_function gram, const double *CSE6230_RESTRICT vPointer, size_t vCount, const double *CSE6230_RESTRICT uPointer, size_t uCount, double *CSE6230_RESTRICT gramPointer, size_t gramStride, size_t threadsCount) {
+	// Tiles are bands of rows across all columns, so the function writes long segments of rows
+	const size_t tilesCount = (vCount + vector3d_gram_matrix_tile - 1) / vector3d_gram_matrix_tile;
+	gram_schedule(tilesCount, threadsCount, [=](size_t tile) {
+		const size_t row = tile * vector3d_gram_matrix_tile;
+		gram(vPointer + 3 * row, std::min(vCount - row, vector3d_gram_matrix_tile), uPointer, uCount, gramPointer + row * gramStride, gramStride);
+	});
+}
+
+void vector3d_gram_matrix_symmetric(vector3d_gram_matrix_function gram, const double *CSE6230_RESTRICT vPointer, size_t vectorsCount, double *CSE6230_RESTRICT gramPointer, size_t gramStride, size_t threadsCount) {
+	// Tiles on and above the diagonal are numbered row by row
+	const size_t tilesCount = (vectorsCount + vector3d_gram_matrix_tile - 1) / vector3d_gram_matrix_tile;
+	std::vector<size_t> tileRows, panelColumns;
+	for (size_t tileRow = 0; tileRow < tilesCount; tileRow++) {
+		for (size_t panelColumn = tileRow; panelColumn < tilesCount; panelColumn++) {
+			tileRows.push_back(tileRow);
+			panelColumns.push_back(panelColumn);
+		}
+	}
+	gram_schedule(tileRows.size(), threadsCount, [=, &tileRows, &panelColumns](size_t tile) {
+		const size_t row = tileRows[tile] * vector3d_gram_matrix_tile;
+		const size_t column = panelColumns[tile] * vector3d_gram_matrix_tile;
+		const size_t rows = std::min(vectorsCount - row, vector3d_gram_matrix_tile);
+		const size_t columns = std::min(vectorsCount - column, vector3d_gram_matrix_tile);
+		double* tilePointer = gramPointer + row * gramStride + column;
+		gram(vPointer + 3 * row, rows, vPointer + 3 * column, columns, tilePointer, gramStride);
+		if (row != column) {
+			// The tile is still in cache: write the transposed tile below the diagonal by blocks of 8 x 8 elements,
+			// so that both the rows read and the rows written stay in L1
+			double* transposedPointer = gramPointer + column * gramStride + row;
+			for (size_t blockColumn = 0; blockColumn < columns; blockColumn += 8) {
+				for (size_t blockRow = 0; blockRow < rows; blockRow += 8) {
+					const size_t blockColumns = std::min<size_t>(columns - blockColumn, 8);
+					const size_t blockRows = std::min<size_t>(rows - blockRow, 8);
+					for (size_t j = blockColumn; j < blockColumn + blockColumns; j++) {
+						for (size_t i = blockRow; i < blockRow + blockRows; i++) {
+							transposedPointer[j * gramStride + i] = tilePointer[i * gramStride + j];
+						}
+					}
+				}
+			}
+		}
+	});
+}
@@ -0,0 +1,61 @@
+/******************************************************************************\
+ *                                                                            *
+ * Copyright (c) 2012 Marat Dukhan                                            *
+ *                                                                            *
+ * This software is provided 'as-is', without any express or implied          *
+ * warranty. In no event will the authors be held liable for any damages      *
+ * arising from the use of this software.                                     *
+ *                                                                            *
+ * Permission is granted to anyone to use this software for any purpose,      *
+ * including commercial applications, and to alter it and redistribute it     *
+ * freely, subject to the following restrictions:                             *
+ *                                                                            *
+ * 1. The origin of this software must not be misrepresented; you must not    *
+ * claim that you wrote the original software. If you use this software       *
+ * in a product, an acknowledgment in the product documentation would be      *
+ * appreciated but is not required.                                           *
+ *                                                                            *
+ * 2. Altered source versions must be plainly marked as such, and must not be *
+ * misrepresented as being the original software.                             *
+ *                                                                            *
+ * 3. This notice may not be removed or altered from any source               *
+ * distribution.                                                              *
+ *                                                                            *
+\******************************************************************************/
+
+#pragma once
+
+#include <compute.hpp>
+
+// Gram matrices of 3D vectors: gramPointer[i * gramStride + j] is the dot product of vPointer[i] and uPointer[j].
+// SIMD versions transpose panels of uPointer into separate arrays of x, y and z components, and compute blocks of 4 rows by
+// two SIMD vectors of columns in registers, so each loaded component of u is used for 4 rows and each broadcast
+// component of v for two vectors of columns. Every output element is written once: for large matrices the stores of the
+// output, not loads of the vectors, limit the performance.
+// Dot products are computed as (x * x' + y * y') + z * z', and with fused multiply-adds in the AVX2 and AVX-512 versions.
+typedef void (*vector3d_gram_matrix_function)(const double*, size_t, const double*, size_t, double*, size_t);
+
+extern "C" void vector3d_gram_matrix_naive(const double *CSE6230_RESTRICT vPointer, size_t vCount, const double *CSE6230_RESTRICT uPointer, size_t uCount, double *CSE6230_RESTRICT gramPointer, size_t gramStride);
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+extern "C" void vector3d_gram_matrix_sse2(const double *CSE6230_RESTRICT vPointer, size_t vCount, const double *CSE6230_RESTRICT uPointer, size_t uCount, double *CSE6230_RESTRICT gramPointer, size_t gramStride);
+#endif
+#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+extern "C" void vector3d_gram_matrix_avx(const double *CSE6230_RESTRICT vPointer, size_t vCount, const double *CSE6230_RESTRICT uPointer, size_t uCount, double *CSE6230_RESTRICT gramPointer, size_t gramStride);
+#endif
+#if defined(CSE6230_AVX2_INTRINSICS_SUPPORTED) && defined(CSE6230_FMA3_INTRINSICS_SUPPORTED)
+extern "C" void vector3d_gram_matrix_avx2(const double *CSE6230_RESTRICT vPointer, size_t vCount, const double *CSE6230_RESTRICT uPointer, size_t uCount, double *CSE6230_RESTRICT gramPointer, size_t gramStride);
+#endif
+#ifdef CSE6230_AVX512F_INTRINSICS_SUPPORTED
+extern "C" void vector3d_gram_matrix_avx512f(const double *CSE6230_RESTRICT vPointer, size_t vCount, const double *CSE6230_RESTRICT uPointer, size_t uCount, double *CSE6230_RESTRICT gramPointer, size_t gramStride);
+#endif
+
+// Splits the output into tiles of vector3d_gram_matrix_tile rows, and computes them with the function on threadsCount threads
+// (0 = all CPUs, 1 = only the calling thread). The threads take the next tile from a shared counter.
+static const size_t vector3d_gram_matrix_tile = 128;
+
+extern "C" void vector3d_gram_matrix_parallel(vector3d_gram_matrix_function gram, const double *CSE6230_RESTRICT vPointer, size_t vCount, const double *CSE6230_RESTRICT uPointer, size_t uCount, double *CSE6230_RESTRICT gramPointer, size_t gramStride, size_t threadsCount);
+// The Gram matrix of a set of vectors with itself: computes only the square tiles of vector3d_gram_matrix_tile rows and columns
+// on and above the diagonal with the function, and copies the tiles above the diagonal into the transposed tiles below it.
+// The result is exactly symmetric. As 3D dot products are cheaper than the stores of the output, this saves arithmetic
+// but not memory traffic, and is faster than the full matrix only while the output stays in cache.
+extern "C" void vector3d_gram_matrix_symmetric(vector3d_gram_matrix_function gram, const double *CSE6230_RESTRICT vPointer, size_t vectorsCount, double *CSE6230_RESTRICT gramPointer, size_t gramStride, size_t threadsCount);
@@ -1,6 +1,33 @@
 #include <compute.hpp>
+#include <typed.hpp>
+#include <formats.hpp>
+#include <vectornd.hpp>
+#include <reproducible_dot_products.hpp>
+#include <search.hpp>
+#include <gram.hpp>
+#include <matrix.hpp>
+#include <chain.hpp>
+#include <baseline.hpp>
+#include <vector_array.hpp>
+#include <statistics.hpp>
+#include <scaling.hpp>
+#include <stream.hpp>
+#include <registry.hpp>
+#include <telemetry.hpp>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
 #include <malloc.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <signal.h>
+#include <chrono>
+#if defined(CSE6230_SSE2_INTRINSICS_SUPPORTED)
+	#include <x86intrin.h>
+#endif
 
 inline static uint64_t get_cpu_ticks_start() {
 #ifdef __x86_64__
@@ -40,19 +67,202 @@ inline static uint64_t max(uint64_t a, uint64_t b) {
 	return a > b ? a : b;
 }
 
+static const size_t page_size = 4096;
+static const size_t cache_line_size = 64;
+
+// State of the operand arrays at the start of every repetition of a kernel:
+//   hot: whatever the previous repetition left, normally in L1 cache
+//   cold: flushed from all cache levels
+//   first-touch: pages discarded, so that the kernel takes page faults on first access and reads zero-filled pages
+enum cache_mode {
+	cache_mode_hot,
+	cache_mode_cold,
+	cache_mode_first_touch,
+	cache_mode_count
+};
+
+static const char* cache_mode_names[cache_mode_count] = {
+	"hot",
+	"cold",
+	"first-touch"
+};
+
+// Repetitions are much slower in the cold and first-touch modes, so they run fewer of them
+static const size_t cache_mode_experiments_divisor[cache_mode_count] = { 1, 100, 1000 };
+
+static cache_mode benchmark_cache_mode = cache_mode_hot;
+
+// Benchmark arrays are mapped separately and start at a page boundary after a header page with the mapping size:
+// first-touch mode discards the pages of the arrays, and must not discard other data sharing the same pages.
+static void* allocate_benchmark_array(size_t size) {
+	const size_t mapping_size = page_size + (size + page_size - 1) / page_size * page_size;
+	void* mapping = mmap(NULL, mapping_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (mapping == MAP_FAILED) {
+		return NULL;
+	}
+	*static_cast<size_t*>(mapping) = mapping_size;
+	return static_cast<char*>(mapping) + page_size;
+}
+
+static void free_benchmark_array(void* array) {
+	if (array != NULL) {
+		void* mapping = static_cast<char*>(array) - page_size;
+		munmap(mapping, *static_cast<size_t*>(mapping));
+	}
+}
+
+#ifndef CSE6230_SSE2_INTRINSICS_SUPPORTED
+// Without clflush, the cache is flushed by writing a buffer larger than the last-level cache
+static const size_t eviction_buffer_size = 64 * 1024 * 1024;
+static char* eviction_buffer = NULL;
+#endif
+
+static void flush_array(const void* array, size_t size) {
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+	const char* line = static_cast<const char*>(array) - reinterpret_cast<uintptr_t>(array) % cache_line_size;
+	for (; line < static_cast<const char*>(array) + size; line += cache_line_size) {
+		_mm_clflush(line);
+	}
+	_mm_mfence();
+#else
+	if (eviction_buffer == NULL) {
+		eviction_buffer = static_cast<char*>(malloc(eviction_buffer_size));
+	}
+	for (size_t offset = 0; offset < eviction_buffer_size; offset += cache_line_size) {
+		eviction_buffer[offset] += 1;
+	}
+#endif
+}
+
+// The array must be allocated with allocate_benchmark_array
+static void discard_array(const void* array, size_t size) {
+	const uintptr_t start = reinterpret_cast<uintptr_t>(array) / page_size * page_size;
+	const uintptr_t end = (reinterpret_cast<uintptr_t>(array) + size + page_size - 1) / page_size * page_size;
+	madvise(reinterpret_cast<void*>(start), end - start, MADV_DONTNEED);
+}
+
+// Brings an operand array into the state required by benchmark_cache_mode. Called before every repetition of a kernel.
+static void prepare_array(const void* array, size_t size) {
+	switch (benchmark_cache_mode) {
+		case cache_mode_hot:
+			break;
+		case cache_mode_cold:
+			flush_array(array, size);
+			break;
+		case cache_mode_first_touch:
+			discard_array(array, size);
+			break;
+		case cache_mode_count:
+			break;
+	}
+}
+
+// Samples of individual repetitions, for the statistics. Only the first timing loop after a report or the start of a section
+// is sampled: for rows with misalignment sweeps this is the aligned measurement, for rows with two timings the first one.
+static const size_t max_samples_count = 100000;
+static uint64_t samples[max_samples_count];
+static double samples_cpe[max_samples_count];
+static size_t samples_count = 0;
+static size_t samples_stride = 1;
+static bool samples_taken = false;
+
+// Returns true if the timing loop which calls it should record samples
+static bool start_samples(size_t experiments_count) {
+	if (samples_taken) {
+		return false;
+	}
+	samples_taken = true;
+	samples_count = 0;
+	samples_stride = experiments_count / max_samples_count + 1;
+	return true;
+}
+
+static void add_sample(bool sampling, size_t experiment_number, uint64_t ticks) {
+	if (sampling && experiment_number % samples_stride == 0 && samples_count < max_samples_count) {
+		samples[samples_count++] = ticks;
+	}
+}
+
+static const size_t max_results_count = 1024;
+static benchmark_result results[max_results_count];
+static size_t results_count = 0;
+static const char* report_section = "";
+
+static void begin_section(const char* section_name) {
+	report_section = section_name;
+	samples_taken = false;
+}
+
+// Adds statistics of the recorded samples, in cycles per element, to the results
+static void record_result(const char* method_name, size_t array_size) {
+	if (samples_count != 0 && results_count < max_results_count) {
+		for (size_t sample_number = 0; sample_number < samples_count; sample_number++) {
+			samples_cpe[sample_number] = double(samples[sample_number]) / double(array_size);
+		}
+		benchmark_result& result = results[results_count++];
+		snprintf(result.name, sizeof(result.name), "%s | %s | %s", cache_mode_names[benchmark_cache_mode], report_section, method_name);
+		result.statistics = compute_sample_statistics(samples_cpe, samples_count);
+	}
+	samples_taken = false;
+	samples_count = 0;
+}
+
+static const benchmark_result* find_result(const benchmark_result* results, size_t results_count, const char* name) {
+	for (size_t result_number = 0; result_number < results_count; result_number++) {
+		if (strcmp(results[result_number].name, name) == 0) {
+			return &results[result_number];
+		}
+	}
+	return NULL;
+}
+
+static void print_statistics(const benchmark_result* baseline_results, size_t baseline_results_count) {
+	printf("%-60s\t%8s\t%8s\t%10s\t%10s\t%10s\t%10s\t%10s\t%10s\t%s\n", "Statistics",
+		"Samples", "Outliers", "Min CPE", "P10 CPE", "Median CPE", "P90 CPE", "P99 CPE", "MAD CPE", "vs Baseline");
+	for (size_t result_number = 0; result_number < results_count; result_number++) {
+		const benchmark_result& result = results[result_number];
+		const sample_statistics& statistics = result.statistics;
+		printf("%-60s\t%8zu\t%8zu\t%10.2lf\t%10.2lf\t%10.2lf\t%10.2lf\t%10.2lf\t%10.2lf", result.name,
+			statistics.count, statistics.outliers_count,
+			statistics.min, statistics.p10, statistics.median, statistics.p90, statistics.p99, statistics.mad);
+		const benchmark_result* baseline = find_result(baseline_results, baseline_results_count, result.name);
+		if (baseline != NULL) {
+			const double speedup = baseline->statistics.median / statistics.median;
+			switch (compare_sample_statistics(baseline->statistics, statistics)) {
+				case comparison_not_significant:
+					printf("\t%.3lfx (not significant)", speedup);
+					break;
+				case comparison_speedup:
+					printf("\t%.3lfx SPEEDUP", speedup);
+					break;
+				case comparison_regression:
+					printf("\t%.3lfx REGRESSION", speedup);
+					break;
+			}
+		}
+		printf("\n");
+	}
+}
+
 static uint64_t time_dot_product(vector3d_dot_products_function vector3d_dot_products, const double* v_vectors, const double* u_vectors, double* dp_array, size_t vectors_count, size_t experiments_count) {
 	uint64_t best_ticks = uint64_t(-1);
+	const bool sampling = start_samples(experiments_count);
 	for (size_t experiment_number = 1; experiment_number <= experiments_count; experiment_number++) {
+		prepare_array(v_vectors, vectors_count * 3 * sizeof(double));
+		prepare_array(u_vectors, vectors_count * 3 * sizeof(double));
+		prepare_array(dp_array, vectors_count * sizeof(double));
 		const uint64_t start_ticks = get_cpu_ticks_start();
 		vector3d_dot_products(v_vectors, u_vectors, dp_array, vectors_count);
 		const uint64_t end_ticks = get_cpu_ticks_end();
 		const uint64_t elapsed_ticks = end_ticks - start_ticks;
 		best_ticks = min(best_ticks, elapsed_ticks);
+		add_sample(sampling, experiment_number, elapsed_ticks);
 	}
 	return best_ticks;
 }
 
 static void report_timings(const char* method_name, uint64_t aligned_ticks, uint64_t min_ticks, uint64_t max_ticks, size_t array_size) {
+	record_result(method_name, array_size);
 	printf("%20s\t%2.2lf\t%2.2lf\t%2.2lf\n", method_name,
 		double(aligned_ticks) / double(array_size),
 		double(min_ticks) / double(array_size),
@@ -61,99 +271,2022 @@ static void report_timings(const char* method_name, uint64_t aligned_ticks, uint
 }
 
 static void report_timings(const char* method_name, uint64_t aligned_ticks, size_t array_size) {
+	record_result(method_name, array_size);
 	printf("%20s\t%2.2lf\n", method_name, double(aligned_ticks) / double(array_size));
 }
 
-int main(int argc, char** argv) {
-	size_t experiments_count = 1000000;
-	
-	size_t vectors_count = 150;
-	const size_t components_per_vector = 3;
-	double *v_vectors = (double*)memalign(32, vectors_count * components_per_vector * sizeof(double) + 32);
-	double *u_vectors = (double*)memalign(32, vectors_count * components_per_vector * sizeof(double) + 32);
-	double *dp_array = (double*)memalign(32, vectors_count * sizeof(double) + 32);
-	
-	printf("Method\tAligned CPE\tMin CPE\tMax CPE\n");
-	
-	const uint64_t aligned_vector3d_dot_products_naive_ticks = time_dot_product(&vector3d_dot_products_naive, v_vectors, u_vectors, dp_array, vectors_count, experiments_count);
-	uint64_t min_vector3d_dot_products_naive_ticks = uint64_t(-1);
-	uint64_t max_vector3d_dot_products_naive_ticks = 0;
+static void test_dot_product(const char* method_name, vector3d_dot_products_function vector3d_dot_products, const double* v_vectors, const double* u_vectors, double* dp_array, size_t vectors_count, size_t experiments_count) {
+	const uint64_t aligned_ticks = time_dot_product(vector3d_dot_products, v_vectors, u_vectors, dp_array, vectors_count, experiments_count);
+	uint64_t min_ticks = uint64_t(-1);
+	uint64_t max_ticks = 0;
 	for (size_t v_pointer_misalignment = 0; v_pointer_misalignment < 16 / sizeof(double); v_pointer_misalignment += 1) {
 		for (size_t u_pointer_misalignment = 0; u_pointer_misalignment < 16 / sizeof(double); u_pointer_misalignment += 1) {
 			for (size_t dp_array_misalignment = 0; dp_array_misalignment < 16 / sizeof(double); dp_array_misalignment += 1) {
-				const uint64_t vector3d_dot_products_naive_ticks = time_dot_product(&vector3d_dot_products_naive,
+				const uint64_t ticks = time_dot_product(vector3d_dot_products,
 					v_vectors + v_pointer_misalignment,
 					u_vectors + u_pointer_misalignment,
 					dp_array + dp_array_misalignment,
 					vectors_count, experiments_count);
-				min_vector3d_dot_products_naive_ticks = min(min_vector3d_dot_products_naive_ticks, vector3d_dot_products_naive_ticks);
-				max_vector3d_dot_products_naive_ticks = max(max_vector3d_dot_products_naive_ticks, vector3d_dot_products_naive_ticks);
+				min_ticks = min(min_ticks, ticks);
+				max_ticks = max(max_ticks, ticks);
 			}
 		}
 	}
-	report_timings("Naive", aligned_vector3d_dot_products_naive_ticks, min_vector3d_dot_products_naive_ticks, max_vector3d_dot_products_naive_ticks, vectors_count);
-	
-	#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
-	const uint64_t aligned_vector3d_dot_products_sse2_ticks = time_dot_product(&vector3d_dot_products_sse2, v_vectors, u_vectors, dp_array, vectors_count, experiments_count);
-	uint64_t min_vector3d_dot_products_sse2_ticks = uint64_t(-1);
-	uint64_t max_vector3d_dot_products_sse2_ticks = 0;
-	for (size_t v_pointer_misalignment = 0; v_pointer_misalignment < 16 / sizeof(double); v_pointer_misalignment += 1) {
-		for (size_t u_pointer_misalignment = 0; u_pointer_misalignment < 16 / sizeof(double); u_pointer_misalignment += 1) {
-			for (size_t dp_array_misalignment = 0; dp_array_misalignment < 16 / sizeof(double); dp_array_misalignment += 1) {
-				const uint64_t vector3d_dot_products_sse2_ticks = time_dot_product(&vector3d_dot_products_sse2,
-					v_vectors + v_pointer_misalignment,
-					u_vectors + u_pointer_misalignment,
-					dp_array + dp_array_misalignment,
-					vectors_count, experiments_count);
-				min_vector3d_dot_products_sse2_ticks = min(min_vector3d_dot_products_sse2_ticks, vector3d_dot_products_sse2_ticks);
-				max_vector3d_dot_products_sse2_ticks = max(max_vector3d_dot_products_sse2_ticks, vector3d_dot_products_sse2_ticks);
+	report_timings(method_name, aligned_ticks, min_ticks, max_ticks, vectors_count);
+}
+
+template <typename T>
+static uint64_t time_typed_dot_product(void (*vector3d_dot_products)(const T*, const T*, typename dot_product_result<T>::type*, size_t), const T* v_vectors, const T* u_vectors, typename dot_product_result<T>::type* dp_array, size_t vectors_count, size_t experiments_count) {
+	uint64_t best_ticks = uint64_t(-1);
+	const bool sampling = start_samples(experiments_count);
+	for (size_t experiment_number = 1; experiment_number <= experiments_count; experiment_number++) {
+		prepare_array(v_vectors, vectors_count * 3 * sizeof(T));
+		prepare_array(u_vectors, vectors_count * 3 * sizeof(T));
+		prepare_array(dp_array, vectors_count * sizeof(*dp_array));
+		const uint64_t start_ticks = get_cpu_ticks_start();
+		vector3d_dot_products(v_vectors, u_vectors, dp_array, vectors_count);
+		const uint64_t end_ticks = get_cpu_ticks_end();
+		const uint64_t elapsed_ticks = end_ticks - start_ticks;
+		best_ticks = min(best_ticks, elapsed_ticks);
+		add_sample(sampling, experiment_number, elapsed_ticks);
+	}
+	return best_ticks;
+}
+
+// The arrays must have space for vectors_count vectors (or dot products) of type T
+template <typename T>
+static void test_typed_dot_product(const char* method_name, void (*vector3d_dot_products)(const T*, const T*, typename dot_product_result<T>::type*, size_t), const void* v_vectors, const void* u_vectors, void* dp_array, size_t vectors_count, size_t experiments_count) {
+	typedef typename dot_product_result<T>::type result_type;
+	const uint64_t ticks = time_typed_dot_product<T>(vector3d_dot_products, (const T*)v_vectors, (const T*)u_vectors, (result_type*)dp_array, vectors_count, experiments_count);
+	report_timings(method_name, ticks, vectors_count);
+}
+
+template <typename T>
+static uint64_t time_mixed_dot_product(void (*vector3d_dot_products)(const T*, const T*, double*, size_t), const T* v_vectors, const T* u_vectors, double* dp_array, size_t vectors_count, size_t experiments_count) {
+	uint64_t best_ticks = uint64_t(-1);
+	const bool sampling = start_samples(experiments_count);
+	for (size_t experiment_number = 1; experiment_number <= experiments_count; experiment_number++) {
+		prepare_array(v_vectors, vectors_count * 3 * sizeof(T));
+		prepare_array(u_vectors, vectors_count * 3 * sizeof(T));
+		prepare_array(dp_array, vectors_count * sizeof(double));
+		const uint64_t start_ticks = get_cpu_ticks_start();
+		vector3d_dot_products(v_vectors, u_vectors, dp_array, vectors_count);
+		const uint64_t end_ticks = get_cpu_ticks_end();
+		const uint64_t elapsed_ticks = end_ticks - start_ticks;
+		best_ticks = min(best_ticks, elapsed_ticks);
+		add_sample(sampling, experiment_number, elapsed_ticks);
+	}
+	return best_ticks;
+}
+
+static uint64_t time_vectornd_dot_products(vectornd_dot_products_function vectornd_dot_products, const double* v_vectors, const double* u_vectors, double* dp_array, size_t vectors_count, size_t dimension, size_t experiments_count) {
+	uint64_t best_ticks = uint64_t(-1);
+	const bool sampling = start_samples(experiments_count);
+	for (size_t experiment_number = 1; experiment_number <= experiments_count; experiment_number++) {
+		prepare_array(v_vectors, vectors_count * dimension * sizeof(double));
+		prepare_array(u_vectors, vectors_count * dimension * sizeof(double));
+		prepare_array(dp_array, vectors_count * sizeof(double));
+		const uint64_t start_ticks = get_cpu_ticks_start();
+		vectornd_dot_products(v_vectors, u_vectors, dp_array, vectors_count, dimension);
+		const uint64_t end_ticks = get_cpu_ticks_end();
+		const uint64_t elapsed_ticks = end_ticks - start_ticks;
+		best_ticks = min(best_ticks, elapsed_ticks);
+		add_sample(sampling, experiment_number, elapsed_ticks);
+	}
+	return best_ticks;
+}
+
+static uint64_t time_reproducible_dot_products_sum(reproducible_dot_products_sum_function sum, size_t threads_count, const double* v_vectors, const double* u_vectors, size_t vectors_count, size_t experiments_count) {
+	uint64_t best_ticks = uint64_t(-1);
+	const bool sampling = start_samples(experiments_count);
+	for (size_t experiment_number = 1; experiment_number <= experiments_count; experiment_number++) {
+		prepare_array(v_vectors, vectors_count * 3 * sizeof(double));
+		prepare_array(u_vectors, vectors_count * 3 * sizeof(double));
+		const uint64_t start_ticks = get_cpu_ticks_start();
+		if (threads_count == 1) {
+			sum(v_vectors, u_vectors, vectors_count);
+		} else {
+			reproducible_dot_products_sum_parallel(sum, v_vectors, u_vectors, vectors_count, threads_count);
+		}
+		const uint64_t end_ticks = get_cpu_ticks_end();
+		const uint64_t elapsed_ticks = end_ticks - start_ticks;
+		best_ticks = min(best_ticks, elapsed_ticks);
+		add_sample(sampling, experiment_number, elapsed_ticks);
+	}
+	return best_ticks;
+}
+
+// The filter inputs are uniform in [-1, 1], so about half of the dot products pass in an unpredictable pattern
+static const double filter_threshold = 0.0;
+
+// Keeps the compiler from removing the search for the maximum in time_unfused_argmax
+static volatile size_t unfused_max_index;
+
+// The unfused search writes the dot products to dp_array and reads them back to find the maximum
+static uint64_t time_unfused_argmax(vector3d_dot_products_function vector3d_dot_products, const double* v_vectors, const double* u_vectors, double* dp_array, size_t vectors_count, size_t experiments_count) {
+	uint64_t best_ticks = uint64_t(-1);
+	const bool sampling = start_samples(experiments_count);
+	for (size_t experiment_number = 1; experiment_number <= experiments_count; experiment_number++) {
+		prepare_array(v_vectors, vectors_count * 3 * sizeof(double));
+		prepare_array(u_vectors, vectors_count * 3 * sizeof(double));
+		prepare_array(dp_array, vectors_count * sizeof(double));
+		const uint64_t start_ticks = get_cpu_ticks_start();
+		vector3d_dot_products(v_vectors, u_vectors, dp_array, vectors_count);
+		size_t max_index = 0;
+		for (size_t i = 1; i < vectors_count; i++) {
+			if (dp_array[i] > dp_array[max_index]) {
+				max_index = i;
 			}
 		}
+		unfused_max_index = max_index;
+		const uint64_t end_ticks = get_cpu_ticks_end();
+		const uint64_t elapsed_ticks = end_ticks - start_ticks;
+		best_ticks = min(best_ticks, elapsed_ticks);
+		add_sample(sampling, experiment_number, elapsed_ticks);
 	}
-	report_timings("SSE2", aligned_vector3d_dot_products_sse2_ticks, min_vector3d_dot_products_sse2_ticks, max_vector3d_dot_products_sse2_ticks, vectors_count);
-	#endif
-	
-	#ifdef CSE6230_SSE3_INTRINSICS_SUPPORTED
-	const uint64_t aligned_vector3d_dot_products_sse3_ticks = time_dot_product(&vector3d_dot_products_sse3, v_vectors, u_vectors, dp_array, vectors_count, experiments_count);
-	uint64_t min_vector3d_dot_products_sse3_ticks = uint64_t(-1);
-	uint64_t max_vector3d_dot_products_sse3_ticks = 0;
-	for (size_t v_pointer_misalignment = 0; v_pointer_misalignment < 16 / sizeof(double); v_pointer_misalignment += 1) {
-		for (size_t u_pointer_misalignment = 0; u_pointer_misalignment < 16 / sizeof(double); u_pointer_misalignment += 1) {
-			for (size_t dp_array_misalignment = 0; dp_array_misalignment < 16 / sizeof(double); dp_array_misalignment += 1) {
-				const uint64_t vector3d_dot_products_sse3_ticks = time_dot_product(&vector3d_dot_products_sse3,
-					v_vectors + v_pointer_misalignment,
-					u_vectors + u_pointer_misalignment,
-					dp_array + dp_array_misalignment,
-					vectors_count, experiments_count);
-				min_vector3d_dot_products_sse3_ticks = min(min_vector3d_dot_products_sse3_ticks, vector3d_dot_products_sse3_ticks);
-				max_vector3d_dot_products_sse3_ticks = max(max_vector3d_dot_products_sse3_ticks, vector3d_dot_products_sse3_ticks);
+	return best_ticks;
+}
+
+static uint64_t time_dot_products_argmax(vector3d_dot_products_argmax_function argmax, size_t threads_count, const double* v_vectors, const double* u_vectors, size_t vectors_count, size_t experiments_count) {
+	uint64_t best_ticks = uint64_t(-1);
+	const bool sampling = start_samples(experiments_count);
+	for (size_t experiment_number = 1; experiment_number <= experiments_count; experiment_number++) {
+		prepare_array(v_vectors, vectors_count * 3 * sizeof(double));
+		prepare_array(u_vectors, vectors_count * 3 * sizeof(double));
+		double max_value;
+		const uint64_t start_ticks = get_cpu_ticks_start();
+		if (threads_count == 1) {
+			argmax(v_vectors, u_vectors, vectors_count, &max_value);
+		} else {
+			vector3d_dot_products_argmax_parallel(argmax, v_vectors, u_vectors, vectors_count, &max_value, threads_count);
+		}
+		const uint64_t end_ticks = get_cpu_ticks_end();
+		const uint64_t elapsed_ticks = end_ticks - start_ticks;
+		best_ticks = min(best_ticks, elapsed_ticks);
+		add_sample(sampling, experiment_number, elapsed_ticks);
+	}
+	return best_ticks;
+}
+
+static uint64_t time_query_argmax(vector3d_query_argmax_function argmax, size_t threads_count, const double* query, const double* vectors, size_t vectors_count, size_t experiments_count) {
+	uint64_t best_ticks = uint64_t(-1);
+	const bool sampling = start_samples(experiments_count);
+	for (size_t experiment_number = 1; experiment_number <= experiments_count; experiment_number++) {
+		prepare_array(vectors, vectors_count * 3 * sizeof(double));
+		double max_value;
+		const uint64_t start_ticks = get_cpu_ticks_start();
+		if (threads_count == 1) {
+			argmax(query, vectors, vectors_count, &max_value);
+		} else {
+			vector3d_query_argmax_parallel(argmax, query, vectors, vectors_count, &max_value, threads_count);
+		}
+		const uint64_t end_ticks = get_cpu_ticks_end();
+		const uint64_t elapsed_ticks = end_ticks - start_ticks;
+		best_ticks = min(best_ticks, elapsed_ticks);
+		add_sample(sampling, experiment_number, elapsed_ticks);
+	}
+	return best_ticks;
+}
+
+static uint64_t time_query_topk(vector3d_query_topk_function topk, size_t threads_count, const double* query, const double* vectors, size_t vectors_count, size_t k, size_t experiments_count) {
+	double values[vector3d_query_topk_max_k];
+	size_t indices[vector3d_query_topk_max_k];
+	uint64_t best_ticks = uint64_t(-1);
+	const bool sampling = start_samples(experiments_count);
+	for (size_t experiment_number = 1; experiment_number <= experiments_count; experiment_number++) {
+		prepare_array(vectors, vectors_count * 3 * sizeof(double));
+		const uint64_t start_ticks = get_cpu_ticks_start();
+		if (threads_count == 1) {
+			topk(query, vectors, vectors_count, k, values, indices);
+		} else {
+			vector3d_query_topk_parallel(topk, query, vectors, vectors_count, k, values, indices, threads_count);
+		}
+		const uint64_t end_ticks = get_cpu_ticks_end();
+		const uint64_t elapsed_ticks = end_ticks - start_ticks;
+		best_ticks = min(best_ticks, elapsed_ticks);
+		add_sample(sampling, experiment_number, elapsed_ticks);
+	}
+	return best_ticks;
+}
+
+// Reports the fused search of pairs, and the argmax and top-8 search of the query u_vectors[0:3] in v_vectors
+static void test_search(const char* method_name, vector3d_dot_products_argmax_function dot_products_argmax, vector3d_query_argmax_function query_argmax, vector3d_query_topk_function query_topk, size_t threads_count, const double* v_vectors, const double* u_vectors, size_t vectors_count, size_t experiments_count) {
+	report_timings(method_name,
+		time_dot_products_argmax(dot_products_argmax, threads_count, v_vectors, u_vectors, vectors_count, experiments_count),
+		time_query_argmax(query_argmax, threads_count, u_vectors, v_vectors, vectors_count, experiments_count),
+		time_query_topk(query_topk, threads_count, u_vectors, v_vectors, vectors_count, 8, experiments_count),
+		vectors_count);
+}
+
+// The unfused filter writes all dot products to dp_array, and then copies the passing ones with a branch
+static uint64_t time_unfused_filter(vector3d_dot_products_function vector3d_dot_products, const double* v_vectors, const double* u_vectors, double* dp_array, double* values, size_t* indices, size_t vectors_count, size_t experiments_count) {
+	uint64_t best_ticks = uint64_t(-1);
+	const bool sampling = start_samples(experiments_count);
+	for (size_t experiment_number = 1; experiment_number <= experiments_count; experiment_number++) {
+		prepare_array(v_vectors, vectors_count * 3 * sizeof(double));
+		prepare_array(u_vectors, vectors_count * 3 * sizeof(double));
+		prepare_array(dp_array, vectors_count * sizeof(double));
+		prepare_array(values, vectors_count * sizeof(double));
+		prepare_array(indices, vectors_count * sizeof(size_t));
+		const uint64_t start_ticks = get_cpu_ticks_start();
+		vector3d_dot_products(v_vectors, u_vectors, dp_array, vectors_count);
+		size_t passed_count = 0;
+		for (size_t i = 0; i < vectors_count; i++) {
+			if (dp_array[i] > filter_threshold) {
+				values[passed_count] = dp_array[i];
+				indices[passed_count] = i;
+				passed_count += 1;
 			}
 		}
+		const uint64_t end_ticks = get_cpu_ticks_end();
+		const uint64_t elapsed_ticks = end_ticks - start_ticks;
+		best_ticks = min(best_ticks, elapsed_ticks);
+		add_sample(sampling, experiment_number, elapsed_ticks);
 	}
-	report_timings("SSE3", aligned_vector3d_dot_products_sse3_ticks, min_vector3d_dot_products_sse3_ticks, max_vector3d_dot_products_sse3_ticks, vectors_count);
-	#endif
+	return best_ticks;
+}
 
-	#ifdef CSE6230_FMA4_INTRINSICS_SUPPORTED
-	const uint64_t aligned_vector3d_dot_products_fma4_ticks = time_dot_product(&vector3d_dot_products_fma4, v_vectors, u_vectors, dp_array, vectors_count, experiments_count);
-	uint64_t min_vector3d_dot_products_fma4_ticks = uint64_t(-1);
-	uint64_t max_vector3d_dot_products_fma4_ticks = 0;
-	for (size_t v_pointer_misalignment = 0; v_pointer_misalignment < 16 / sizeof(double); v_pointer_misalignment += 1) {
-		for (size_t u_pointer_misalignment = 0; u_pointer_misalignment < 16 / sizeof(double); u_pointer_misalignment += 1) {
-			for (size_t dp_array_misalignment = 0; dp_array_misalignment < 16 / sizeof(double); dp_array_misalignment += 1) {
-				const uint64_t vector3d_dot_products_fma4_ticks = time_dot_product(&vector3d_dot_products_fma4,
-					v_vectors + v_pointer_misalignment,
-					u_vectors + u_pointer_misalignment,
-					dp_array + dp_array_misalignment,
-					vectors_count, experiments_count);
-				min_vector3d_dot_products_fma4_ticks = min(min_vector3d_dot_products_fma4_ticks, vector3d_dot_products_fma4_ticks);
-				max_vector3d_dot_products_fma4_ticks = max(max_vector3d_dot_products_fma4_ticks, vector3d_dot_products_fma4_ticks);
+static uint64_t time_dot_products_filter(vector3d_dot_products_filter_function filter, const double* v_vectors, const double* u_vectors, double* values, size_t* indices, size_t vectors_count, size_t experiments_count) {
+	uint64_t best_ticks = uint64_t(-1);
+	const bool sampling = start_samples(experiments_count);
+	for (size_t experiment_number = 1; experiment_number <= experiments_count; experiment_number++) {
+		prepare_array(v_vectors, vectors_count * 3 * sizeof(double));
+		prepare_array(u_vectors, vectors_count * 3 * sizeof(double));
+		prepare_array(values, vectors_count * sizeof(double));
+		prepare_array(indices, vectors_count * sizeof(size_t));
+		const uint64_t start_ticks = get_cpu_ticks_start();
+		filter(v_vectors, u_vectors, vectors_count, filter_threshold, values, indices);
+		const uint64_t end_ticks = get_cpu_ticks_end();
+		const uint64_t elapsed_ticks = end_ticks - start_ticks;
+		best_ticks = min(best_ticks, elapsed_ticks);
+		add_sample(sampling, experiment_number, elapsed_ticks);
+	}
+	return best_ticks;
+}
+
+// Times the Gram matrix of v_vectors and u_vectors, or of v_vectors with itself if symmetric is set
+static uint64_t time_gram_matrix(vector3d_gram_matrix_function gram, bool symmetric, size_t threads_count, const double* v_vectors, const double* u_vectors, double* gram_matrix, size_t vectors_count, size_t experiments_count) {
+	uint64_t best_ticks = uint64_t(-1);
+	const bool sampling = start_samples(experiments_count);
+	for (size_t experiment_number = 1; experiment_number <= experiments_count; experiment_number++) {
+		prepare_array(v_vectors, vectors_count * 3 * sizeof(double));
+		prepare_array(u_vectors, vectors_count * 3 * sizeof(double));
+		prepare_array(gram_matrix, vectors_count * vectors_count * sizeof(double));
+		const uint64_t start_ticks = get_cpu_ticks_start();
+		if (symmetric) {
+			vector3d_gram_matrix_symmetric(gram, v_vectors, vectors_count, gram_matrix, vectors_count, threads_count);
+		} else if (threads_count == 1) {
+			gram(v_vectors, vectors_count, u_vectors, vectors_count, gram_matrix, vectors_count);
+		} else {
+			vector3d_gram_matrix_parallel(gram, v_vectors, vectors_count, u_vectors, vectors_count, gram_matrix, vectors_count, threads_count);
+		}
+		const uint64_t end_ticks = get_cpu_ticks_end();
+		const uint64_t elapsed_ticks = end_ticks - start_ticks;
+		best_ticks = min(best_ticks, elapsed_ticks);
+		add_sample(sampling, experiment_number, elapsed_ticks);
+	}
+	return best_ticks;
+}
+
+static uint64_t time_matvec(matvec_function matvec, const double* matrix, size_t rows, size_t columns, const double* x, double* y, size_t experiments_count) {
+	uint64_t best_ticks = uint64_t(-1);
+	const bool sampling = start_samples(experiments_count);
+	for (size_t experiment_number = 1; experiment_number <= experiments_count; experiment_number++) {
+		prepare_array(matrix, rows * columns * sizeof(double));
+		prepare_array(x, max(rows, columns) * sizeof(double));
+		prepare_array(y, max(rows, columns) * sizeof(double));
+		const uint64_t start_ticks = get_cpu_ticks_start();
+		matvec(matrix, rows, columns, columns, x, y);
+		const uint64_t end_ticks = get_cpu_ticks_end();
+		const uint64_t elapsed_ticks = end_ticks - start_ticks;
+		best_ticks = min(best_ticks, elapsed_ticks);
+		add_sample(sampling, experiment_number, elapsed_ticks);
+	}
+	return best_ticks;
+}
+
+// Reports the matrix-vector and the transposed matrix-vector products
+static void test_matvec(const char* method_name, matvec_function matvec, matvec_function matvec_transposed, const double* matrix, size_t rows, size_t columns, const double* x, double* y, size_t experiments_count) {
+	const uint64_t ticks = time_matvec(matvec, matrix, rows, columns, x, y, experiments_count);
+	const uint64_t transposed_ticks = time_matvec(matvec_transposed, matrix, rows, columns, x, y, experiments_count);
+	record_result(method_name, rows * columns);
+	printf("%20s\t%2.2lf\t%2.2lf\n", method_name, double(ticks) / double(rows * columns), double(transposed_ticks) / double(rows * columns));
+}
+
+static uint64_t time_batched_matmul(batched_matmul_function batched_matmul, size_t matrix_size, const double* a_matrices, const double* b_matrices, double* c_matrices, size_t matrices_count, size_t experiments_count) {
+	const size_t matrices_bytes = matrices_count * matrix_size * matrix_size * sizeof(double);
+	uint64_t best_ticks = uint64_t(-1);
+	const bool sampling = start_samples(experiments_count);
+	for (size_t experiment_number = 1; experiment_number <= experiments_count; experiment_number++) {
+		prepare_array(a_matrices, matrices_bytes);
+		prepare_array(b_matrices, matrices_bytes);
+		prepare_array(c_matrices, matrices_bytes);
+		const uint64_t start_ticks = get_cpu_ticks_start();
+		batched_matmul(a_matrices, b_matrices, c_matrices, matrices_count);
+		const uint64_t end_ticks = get_cpu_ticks_end();
+		const uint64_t elapsed_ticks = end_ticks - start_ticks;
+		best_ticks = min(best_ticks, elapsed_ticks);
+		add_sample(sampling, experiment_number, elapsed_ticks);
+	}
+	return best_ticks;
+}
+
+// Reports cycles per matrix product for 3x3, 4x4 and 8x8 matrices
+static void test_batched_matmul(const char* method_name, batched_matmul_function batched_matmul_3x3, batched_matmul_function batched_matmul_4x4, batched_matmul_function batched_matmul_8x8, const double* a_matrices, const double* b_matrices, double* c_matrices, size_t matrices_count, size_t experiments_count) {
+	report_timings(method_name,
+		time_batched_matmul(batched_matmul_3x3, 3, a_matrices, b_matrices, c_matrices, matrices_count, experiments_count),
+		time_batched_matmul(batched_matmul_4x4, 4, a_matrices, b_matrices, c_matrices, matrices_count, experiments_count),
+		time_batched_matmul(batched_matmul_8x8, 8, a_matrices, b_matrices, c_matrices, matrices_count, experiments_count),
+		matrices_count);
+}
+
+static const size_t vectornd_dimensions[] = { 2, 3, 4, 6, 8, 12 };
+static const size_t max_vectornd_dimension = 12;
+
+// Reports one line per dimension, e.g. "4D AVX"
+static void test_vectornd_dot_products(const char* method_name, vectornd_dot_products_function vectornd_dot_products, const double* v_vectors, const double* u_vectors, double* dp_array, size_t vectors_count, size_t experiments_count) {
+	for (size_t i = 0; i < sizeof(vectornd_dimensions) / sizeof(vectornd_dimensions[0]); i++) {
+		const size_t dimension = vectornd_dimensions[i];
+		char name[32];
+		snprintf(name, sizeof(name), "%zuD %s", dimension, method_name);
+		report_timings(name, time_vectornd_dot_products(vectornd_dot_products, v_vectors, u_vectors, dp_array, vectors_count, dimension, experiments_count), vectors_count);
+	}
+}
+
+// A load which follows a store to an address with the same 12 low bits within this distance may be falsely blocked by it
+static const size_t aliasing_window = 256;
+
+enum placement_cause {
+	placement_cause_aligned,
+	placement_cause_line_split,
+	placement_cause_page_split,
+	placement_cause_same_offset,
+	placement_cause_4k_aliasing,
+	placement_cause_count
+};
+
+static const char* placement_cause_names[placement_cause_count] = {
+	"Aligned",
+	"Cache line split",
+	"Page split",
+	"Same offset",
+	"4K aliasing"
+};
+
+struct placement_report {
+	size_t placements_count;
+	uint64_t best_ticks;
+	uint64_t worst_ticks;
+	size_t worst_offsets[3];
+};
+
+static bool is_misaligned_across_page(size_t offset, size_t array_bytes, size_t vector_size, bool* line_split) {
+	if (offset % vector_size != 0) {
+		*line_split = true;
+		// A misaligned array which spans a page boundary has a vector access straddling it
+		return offset + array_bytes > page_size;
+	}
+	return false;
+}
+
+static placement_cause classify_placement(size_t v_offset, size_t u_offset, size_t dp_offset, size_t vectors_bytes, size_t dp_bytes, size_t vector_size) {
+	// Offsets are measured from the start of a page, so (store - load) modulo page size is the aliasing distance.
+	// At distance 0 each element is stored after it is loaded, and later loads are ahead of the store, so this placement is reported on its own.
+	const size_t v_aliasing_distance = (dp_offset - v_offset) % page_size;
+	const size_t u_aliasing_distance = (dp_offset - u_offset) % page_size;
+	if (((v_aliasing_distance != 0) && (v_aliasing_distance < aliasing_window)) || ((u_aliasing_distance != 0) && (u_aliasing_distance < aliasing_window))) {
+		return placement_cause_4k_aliasing;
+	}
+	if ((v_aliasing_distance == 0) || (u_aliasing_distance == 0)) {
+		return placement_cause_same_offset;
+	}
+	bool line_split = false;
+	bool page_split = false;
+	page_split |= is_misaligned_across_page(v_offset, vectors_bytes, vector_size, &line_split);
+	page_split |= is_misaligned_across_page(u_offset, vectors_bytes, vector_size, &line_split);
+	page_split |= is_misaligned_across_page(dp_offset, dp_bytes, vector_size, &line_split);
+	if (page_split) {
+		return placement_cause_page_split;
+	} else if (line_split) {
+		return placement_cause_line_split;
+	} else {
+		return placement_cause_aligned;
+	}
+}
+
+// Sweeps the offset of each array within a page while the other arrays stay at their allocator placements, and reports the best and the worst CPE for each cause of slowdown.
+// Buffers must be aligned on page size and have a page of padding.
+static void test_dot_product_placements(const char* method_name, vector3d_dot_products_function vector3d_dot_products, size_t vector_size, char* v_buffer, char* u_buffer, char* dp_buffer, size_t vectors_count, size_t experiments_count) {
+	placement_report reports[placement_cause_count];
+	for (size_t cause = 0; cause < placement_cause_count; cause++) {
+		reports[cause].placements_count = 0;
+		reports[cause].best_ticks = uint64_t(-1);
+		reports[cause].worst_ticks = 0;
+	}
+	for (size_t swept_array = 0; swept_array < 3; swept_array++) {
+		for (size_t swept_offset = 0; swept_offset < page_size; swept_offset += sizeof(double)) {
+			size_t offsets[3] = { vector_array_page_offset(0), vector_array_page_offset(1), vector_array_page_offset(2) };
+			offsets[swept_array] = swept_offset;
+			const uint64_t ticks = time_dot_product(vector3d_dot_products,
+				(const double*)(v_buffer + offsets[0]),
+				(const double*)(u_buffer + offsets[1]),
+				(double*)(dp_buffer + offsets[2]),
+				vectors_count, experiments_count);
+			const placement_cause cause = classify_placement(offsets[0], offsets[1], offsets[2], vectors_count * 3 * sizeof(double), vectors_count * sizeof(double), vector_size);
+			placement_report* report = &reports[cause];
+			report->placements_count += 1;
+			report->best_ticks = min(report->best_ticks, ticks);
+			if (ticks >= report->worst_ticks) {
+				report->worst_ticks = ticks;
+				report->worst_offsets[0] = offsets[0];
+				report->worst_offsets[1] = offsets[1];
+				report->worst_offsets[2] = offsets[2];
 			}
 		}
 	}
-	report_timings("FMA4", aligned_vector3d_dot_products_fma4_ticks, min_vector3d_dot_products_fma4_ticks, max_vector3d_dot_products_fma4_ticks, vectors_count);
-	#endif
+	for (size_t cause = 0; cause < placement_cause_count; cause++) {
+		if (reports[cause].placements_count != 0) {
+			printf("%20s\t%16s\t%zu\t%2.2lf\t%2.2lf\tv+%zu u+%zu dp+%zu\n", method_name, placement_cause_names[cause],
+				reports[cause].placements_count,
+				double(reports[cause].best_ticks) / double(vectors_count),
+				double(reports[cause].worst_ticks) / double(vectors_count),
+				reports[cause].worst_offsets[0], reports[cause].worst_offsets[1], reports[cause].worst_offsets[2]);
+		}
+	}
+}
+
+// Correctness checks run before the benchmarks. Every check compares kernels with the naive kernel of their operation
+// on inputs of several vector counts and offsets, reports the mismatches on stderr and returns their number.
 
-	free(v_vectors);
-	free(u_vectors);
-	free(dp_array);	
+// Vector counts of the checks: shorter than one SIMD vector, full vectors with and without a remainder, and long arrays
+static const size_t check_vectors_counts[] = { 1, 3, 8, 17, 64, 1001 };
+static const size_t check_vectors_counts_count = sizeof(check_vectors_counts) / sizeof(check_vectors_counts[0]);
+static const size_t check_max_vectors_count = 1001;
+// Buffers have check_max_offset spare elements, and kernels run on every offset (in elements) below it
+static const size_t check_max_offset = 4;
+// Every check_nan_period-th floating-point component is NaN
+static const size_t check_nan_period = 13;
+
+static uint32_t next_check_bits(uint64_t* state) {
+	*state = *state * 6364136223846793005ull + 1442695040888963407ull;
+	return uint32_t(*state >> 32);
+}
+
+// Multiples of 1/8 in [-16, 16): they fit into bfloat16, and dot products of them are exact in single precision
+static float typed_check_float(uint64_t* state, size_t index) {
+	const uint32_t bits = next_check_bits(state);
+	if (index % check_nan_period == 1) {
+		return NAN;
+	} else {
+		return float(int32_t(bits >> 24) - 128) / 8.0f;
+	}
+}
+
+// Integer components get random bits, so that products and sums wrap around
+template <typename T>
+static void fill_typed_check_array(T* array, size_t length, uint32_t seed) {
+	uint64_t state = seed;
+	for (size_t index = 0; index < length; index++) {
+		const uint64_t high_bits = next_check_bits(&state);
+		const uint64_t low_bits = next_check_bits(&state);
+		array[index] = T((high_bits << 32) | low_bits);
+	}
+}
+
+static void fill_typed_check_array(float* array, size_t length, uint32_t seed) {
+	uint64_t state = seed;
+	for (size_t index = 0; index < length; index++) {
+		array[index] = typed_check_float(&state, index);
+	}
+}
+
+static void fill_typed_check_array(bfloat16* array, size_t length, uint32_t seed) {
+	uint64_t state = seed;
+	for (size_t index = 0; index < length; index++) {
+		const float value = typed_check_float(&state, index);
+		uint32_t bits;
+		memcpy(&bits, &value, sizeof(bits));
+		array[index].bits = uint16_t(bits >> 16);
+	}
+}
+
+template <typename T>
+static bool is_same_check_element(T x, T y) {
+	return x == y;
+}
+
+// Kernels may produce NaN with different payloads
+static bool is_same_check_element(float x, float y) {
+	return (x == y) || ((x != x) && (y != y));
+}
+
+// Runs the typed vector3d_dot_products kernel on every check vector count and offset of v, u and dp, and compares the
+// whole dp buffer with the isa_naive kernel
+template <typename T, typename ISA>
+static size_t check_typed_dot_products(const char* method_name) {
+	typedef typename dot_product_result<T>::type R;
+	const size_t vectors_buffer_length = 3 * check_max_vectors_count + check_max_offset;
+	const size_t dp_buffer_length = check_max_vectors_count + check_max_offset;
+	T *v_buffer = (T*)memalign(64, vectors_buffer_length * sizeof(T));
+	T *u_buffer = (T*)memalign(64, vectors_buffer_length * sizeof(T));
+	R *dp_buffer = (R*)memalign(64, dp_buffer_length * sizeof(R));
+	R *expected_buffer = (R*)memalign(64, dp_buffer_length * sizeof(R));
+	fill_typed_check_array(v_buffer, vectors_buffer_length, 1);
+	fill_typed_check_array(u_buffer, vectors_buffer_length, 2);
+	size_t mismatches_count = 0;
+	for (size_t count_number = 0; count_number < check_vectors_counts_count; count_number++) {
+		const size_t vectors_count = check_vectors_counts[count_number];
+		for (size_t offset = 0; offset < check_max_offset; offset++) {
+			// v and u are shifted against dp, so their misalignments differ
+			const size_t v_offset = offset;
+			const size_t u_offset = (offset + 1) % check_max_offset;
+			fill_typed_check_array(dp_buffer, dp_buffer_length, 3);
+			fill_typed_check_array(expected_buffer, dp_buffer_length, 3);
+			vector3d_dot_products<T, isa_naive>(v_buffer + v_offset, u_buffer + u_offset, expected_buffer + offset, vectors_count);
+			vector3d_dot_products<T, ISA>(v_buffer + v_offset, u_buffer + u_offset, dp_buffer + offset, vectors_count);
+			for (size_t index = 0; index < dp_buffer_length; index++) {
+				if (!is_same_check_element(dp_buffer[index], expected_buffer[index])) {
+					fprintf(stderr, "%s: element %zu of the buffer for %zu vectors at offset %zu is %.17g, the naive kernel computes %.17g\n",
+						method_name, index, vectors_count, offset, double(dp_buffer[index]), double(expected_buffer[index]));
+					mismatches_count++;
+					break;
+				}
+			}
+		}
+	}
+	free(v_buffer);
+	free(u_buffer);
+	free(dp_buffer);
+	free(expected_buffer);
+	return mismatches_count;
+}
+
+// Finite half-precision numbers of both signs, normal and subnormal
+static uint16_t check_half(size_t index) {
+	uint16_t bits = uint16_t((index * 2654435761u) >> 16);
+	if ((bits & 0x7C00) == 0x7C00) {
+		// Infinity or NaN: clear the high bit of the exponent
+		bits &= ~uint16_t(0x4000);
+	}
+	return bits;
+}
+
+// Mixed-precision dot products must match the naive double-precision kernel on the widened vectors. Kernels may add
+// the products in another order or with FMA, so each dot product may differ by a few rounding errors of the sum of
+// absolute products. Runs the kernel on every check vector count and offset of v, u and dp.
+template <typename T>
+static size_t check_mixed_dot_products(const char* kernel_name, void (*vector3d_dot_products)(const T*, const T*, double*, size_t), const T* v_buffer, const T* u_buffer, const double* widened_v_buffer, const double* widened_u_buffer) {
+	double *dp_buffer = (double*)memalign(64, (check_max_vectors_count + check_max_offset) * sizeof(double));
+	double *expected_dp_array = (double*)memalign(64, check_max_vectors_count * sizeof(double));
+	size_t mismatches_count = 0;
+	for (size_t count_number = 0; count_number < check_vectors_counts_count; count_number++) {
+		const size_t vectors_count = check_vectors_counts[count_number];
+		for (size_t offset = 0; offset < check_max_offset; offset++) {
+			const size_t v_offset = offset;
+			const size_t u_offset = (offset + 1) % check_max_offset;
+			vector3d_dot_products_naive(widened_v_buffer + v_offset, widened_u_buffer + u_offset, expected_dp_array, vectors_count);
+			vector3d_dot_products(v_buffer + v_offset, u_buffer + u_offset, dp_buffer + offset, vectors_count);
+			for (size_t index = 0; index < vectors_count; index++) {
+				const double* v = &widened_v_buffer[v_offset + index * 3];
+				const double* u = &widened_u_buffer[u_offset + index * 3];
+				const double magnitude = fabs(v[0] * u[0]) + fabs(v[1] * u[1]) + fabs(v[2] * u[2]);
+				if (!(fabs(dp_buffer[offset + index] - expected_dp_array[index]) <= 4.0 * DBL_EPSILON * magnitude)) {
+					fprintf(stderr, "%s: dot product %zu of %zu vectors at offset %zu is %.17g, the naive kernel computes %.17g\n",
+						kernel_name, index, vectors_count, offset, dp_buffer[offset + index], expected_dp_array[index]);
+					mismatches_count++;
+					break;
+				}
+			}
+		}
+	}
+	free(dp_buffer);
+	free(expected_dp_array);
+	return mismatches_count;
+}
+
+// Checks every mixed-precision kernel against the naive kernel. Returns the number of mismatches.
+static size_t check_mixed_precision_kernels() {
+	const size_t buffer_length = 3 * check_max_vectors_count + check_max_offset;
+	uint16_t *half_v_buffer = (uint16_t*)memalign(64, buffer_length * sizeof(uint16_t));
+	uint16_t *half_u_buffer = (uint16_t*)memalign(64, buffer_length * sizeof(uint16_t));
+	float *float_v_buffer = (float*)memalign(64, buffer_length * sizeof(float));
+	float *float_u_buffer = (float*)memalign(64, buffer_length * sizeof(float));
+	double *widened_v_buffer = (double*)memalign(64, buffer_length * sizeof(double));
+	double *widened_u_buffer = (double*)memalign(64, buffer_length * sizeof(double));
+	for (size_t index = 0; index < buffer_length; index++) {
+		half_v_buffer[index] = check_half(index);
+		half_u_buffer[index] = check_half(index + buffer_length);
+		widened_v_buffer[index] = half_to_double(half_v_buffer[index]);
+		widened_u_buffer[index] = half_to_double(half_u_buffer[index]);
+		float_v_buffer[index] = float(widened_v_buffer[index]);
+		float_u_buffer[index] = float(widened_u_buffer[index]);
+	}
+
+	// Half-precision numbers are exact in single precision, so all kernels compare with the same widened vectors
+	size_t mismatches_count = 0;
+	mismatches_count += check_mixed_dot_products<float>("vector3d_dot_products_f32_naive", &vector3d_dot_products_f32_naive, float_v_buffer, float_u_buffer, widened_v_buffer, widened_u_buffer);
+	#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+		mismatches_count += check_mixed_dot_products<float>("vector3d_dot_products_f32_sse2", &vector3d_dot_products_f32_sse2, float_v_buffer, float_u_buffer, widened_v_buffer, widened_u_buffer);
+	#endif
+	#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+		mismatches_count += check_mixed_dot_products<float>("vector3d_dot_products_f32_avx", &vector3d_dot_products_f32_avx, float_v_buffer, float_u_buffer, widened_v_buffer, widened_u_buffer);
+	#endif
+	mismatches_count += check_mixed_dot_products<uint16_t>("vector3d_dot_products_f16_naive", &vector3d_dot_products_f16_naive, half_v_buffer, half_u_buffer, widened_v_buffer, widened_u_buffer);
+	#if defined(CSE6230_AVX_INTRINSICS_SUPPORTED) && defined(CSE6230_F16C_INTRINSICS_SUPPORTED)
+		mismatches_count += check_mixed_dot_products<uint16_t>("vector3d_dot_products_f16_f16c", &vector3d_dot_products_f16_f16c, half_v_buffer, half_u_buffer, widened_v_buffer, widened_u_buffer);
+	#endif
+
+	free(half_v_buffer);
+	free(half_u_buffer);
+	free(float_v_buffer);
+	free(float_u_buffer);
+	free(widened_v_buffer);
+	free(widened_u_buffer);
+	return mismatches_count;
+}
+
+// Dimensions of the N-D checks: every compile-time instantiation and a few sizes of the generic loop
+static const size_t check_max_vectornd_dimension = 12;
+
+// Runs the N-D dot products kernel on every dimension, or the 3D kernel (the other one is NULL), on every check vector
+// count and offset of v, u and dp, and compares the whole dp buffer with the naive kernel. Check components are
+// multiples of 1/8 in [-16, 16), so the dot products are exact.
+static size_t check_dot_products(const char* kernel_name, vectornd_dot_products_function vectornd_dot_products, vector3d_dot_products_function vector3d_dot_products) {
+	const size_t vectors_buffer_length = check_max_vectornd_dimension * check_max_vectors_count + check_max_offset;
+	const size_t dp_buffer_length = check_max_vectors_count + check_max_offset;
+	double *v_buffer = (double*)memalign(64, vectors_buffer_length * sizeof(double));
+	double *u_buffer = (double*)memalign(64, vectors_buffer_length * sizeof(double));
+	double *dp_buffer = (double*)memalign(64, dp_buffer_length * sizeof(double));
+	double *expected_buffer = (double*)memalign(64, dp_buffer_length * sizeof(double));
+	uint64_t state = 4;
+	for (size_t index = 0; index < vectors_buffer_length; index++) {
+		v_buffer[index] = double(int32_t(next_check_bits(&state) >> 24) - 128) / 8.0;
+		u_buffer[index] = double(int32_t(next_check_bits(&state) >> 24) - 128) / 8.0;
+	}
+	size_t mismatches_count = 0;
+	const size_t min_dimension = (vector3d_dot_products != NULL) ? 3 : 1;
+	const size_t max_dimension = (vector3d_dot_products != NULL) ? 3 : check_max_vectornd_dimension;
+	for (size_t dimension = min_dimension; dimension <= max_dimension; dimension++) {
+		for (size_t count_number = 0; count_number < check_vectors_counts_count; count_number++) {
+			const size_t vectors_count = check_vectors_counts[count_number];
+			for (size_t offset = 0; offset < check_max_offset; offset++) {
+				const size_t v_offset = offset;
+				const size_t u_offset = (offset + 1) % check_max_offset;
+				for (size_t index = 0; index < dp_buffer_length; index++) {
+					dp_buffer[index] = expected_buffer[index] = double(index);
+				}
+				vectornd_dot_products_naive(v_buffer + v_offset, u_buffer + u_offset, expected_buffer + offset, vectors_count, dimension);
+				if (vector3d_dot_products != NULL) {
+					vector3d_dot_products(v_buffer + v_offset, u_buffer + u_offset, dp_buffer + offset, vectors_count);
+				} else {
+					vectornd_dot_products(v_buffer + v_offset, u_buffer + u_offset, dp_buffer + offset, vectors_count, dimension);
+				}
+				for (size_t index = 0; index < dp_buffer_length; index++) {
+					if (dp_buffer[index] != expected_buffer[index]) {
+						fprintf(stderr, "%s: element %zu of the buffer for %zu %zuD vectors at offset %zu is %.17g, the naive kernel computes %.17g\n",
+							kernel_name, index, vectors_count, dimension, offset, dp_buffer[index], expected_buffer[index]);
+						mismatches_count++;
+						break;
+					}
+				}
+			}
+		}
+	}
+	free(v_buffer);
+	free(u_buffer);
+	free(dp_buffer);
+	free(expected_buffer);
+	return mismatches_count;
+}
+
+// Values of k in the top-k search checks: a single result, counts which are not multiples of the SIMD width, and the maximum
+static const size_t check_topk_ks[] = { 1, 3, 8, 64 };
+static const size_t check_topk_ks_count = sizeof(check_topk_ks) / sizeof(check_topk_ks[0]);
+
+// Selects the top k of the dot products with repeated scans: every step takes the largest dot product after the
+// previous one in the order of the results (larger values first, then smaller indices). Returns the number of results.
+static size_t select_check_topk(const double* dp_array, size_t vectors_count, size_t k, double* values, size_t* indices) {
+	const size_t count = (k < vectors_count) ? k : vectors_count;
+	for (size_t result = 0; result < count; result++) {
+		size_t best_index = vectors_count;
+		for (size_t index = 0; index < vectors_count; index++) {
+			// Dot products before the previous result in the order were selected already
+			if (result != 0) {
+				const double previous = values[result - 1];
+				if ((dp_array[index] > previous) || ((dp_array[index] == previous) && (index <= indices[result - 1]))) {
+					continue;
+				}
+			}
+			if ((best_index == vectors_count) || (dp_array[index] > dp_array[best_index])) {
+				best_index = index;
+			}
+		}
+		values[result] = dp_array[best_index];
+		indices[result] = best_index;
+	}
+	return count;
+}
+
+// Reports a search result which differs from the expected one. Returns the number of mismatches (0 or 1).
+static size_t compare_search_result(const char* method_name, const char* search_name, size_t threads_count, size_t vectors_count, size_t offset, size_t index, double value, size_t expected_index, double expected_value) {
+	if ((index == expected_index) && (value == expected_value)) {
+		return 0;
+	}
+	fprintf(stderr, "%s %s on %zu threads: the result for %zu vectors at offset %zu is %.17g at index %zu, a scalar loop finds %.17g at index %zu\n",
+		method_name, search_name, threads_count, vectors_count, offset, value, index, expected_value, expected_index);
+	return 1;
+}
+
+// Checks the search kernels of one instruction set on every check vector count and offset of v and u, directly and
+// on 3 threads, against scalar loops over the dot products. The first input has multiples of 1/8 in [-16, 16), the
+// second one integers in [-2, 2], so that many dot products tie and the smaller index must win.
+static size_t check_search(const char* method_name, vector3d_dot_products_argmax_function pairs_argmax, vector3d_query_argmax_function query_argmax, vector3d_query_topk_function query_topk) {
+	const size_t buffer_length = 3 * check_max_vectors_count + check_max_offset;
+	double *fine_v_buffer = (double*)memalign(64, buffer_length * sizeof(double));
+	double *fine_u_buffer = (double*)memalign(64, buffer_length * sizeof(double));
+	double *coarse_v_buffer = (double*)memalign(64, buffer_length * sizeof(double));
+	double *coarse_u_buffer = (double*)memalign(64, buffer_length * sizeof(double));
+	double *dp_array = (double*)memalign(64, check_max_vectors_count * sizeof(double));
+	uint64_t state = 6;
+	for (size_t index = 0; index < buffer_length; index++) {
+		fine_v_buffer[index] = double(int32_t(next_check_bits(&state) >> 24) - 128) / 8.0;
+		fine_u_buffer[index] = double(int32_t(next_check_bits(&state) >> 24) - 128) / 8.0;
+		coarse_v_buffer[index] = double(int32_t(next_check_bits(&state) % 5) - 2);
+		coarse_u_buffer[index] = double(int32_t(next_check_bits(&state) % 5) - 2);
+	}
+	const double* v_buffers[2] = { fine_v_buffer, coarse_v_buffer };
+	const double* u_buffers[2] = { fine_u_buffer, coarse_u_buffer };
+	size_t mismatches_count = 0;
+	for (size_t buffer_number = 0; buffer_number < 2; buffer_number++) {
+		for (size_t threads_count = 1; threads_count <= 3; threads_count += 2) {
+			for (size_t count_number = 0; count_number < check_vectors_counts_count; count_number++) {
+				const size_t vectors_count = check_vectors_counts[count_number];
+				for (size_t offset = 0; offset < check_max_offset; offset++) {
+					const double* v = v_buffers[buffer_number] + offset;
+					const double* u = u_buffers[buffer_number] + (offset + 1) % check_max_offset;
+					// The query is the first vector of u
+					for (size_t form = 0; form < 2; form++) {
+						for (size_t index = 0; index < vectors_count; index++) {
+							const double* w = (form == 0) ? &u[3 * index] : u;
+							dp_array[index] = (v[3 * index] * w[0] + v[3 * index + 1] * w[1]) + v[3 * index + 2] * w[2];
+						}
+						size_t expected_index = 0;
+						for (size_t index = 1; index < vectors_count; index++) {
+							if (dp_array[index] > dp_array[expected_index]) {
+								expected_index = index;
+							}
+						}
+						double max;
+						size_t index;
+						if (form == 0) {
+							index = (threads_count == 1) ?
+								pairs_argmax(v, u, vectors_count, &max) :
+								vector3d_dot_products_argmax_parallel(pairs_argmax, v, u, vectors_count, &max, threads_count);
+						} else {
+							index = (threads_count == 1) ?
+								query_argmax(u, v, vectors_count, &max) :
+								vector3d_query_argmax_parallel(query_argmax, u, v, vectors_count, &max, threads_count);
+						}
+						mismatches_count += compare_search_result(method_name, (form == 0) ? "vector3d_dot_products_argmax" : "vector3d_query_argmax",
+							threads_count, vectors_count, offset, index, max, expected_index, dp_array[expected_index]);
+					}
+
+					for (size_t k_number = 0; k_number < check_topk_ks_count; k_number++) {
+						const size_t k = check_topk_ks[k_number];
+						double values[vector3d_query_topk_max_k], expected_values[vector3d_query_topk_max_k];
+						size_t indices[vector3d_query_topk_max_k], expected_indices[vector3d_query_topk_max_k];
+						const size_t expected_count = select_check_topk(dp_array, vectors_count, k, expected_values, expected_indices);
+						const size_t count = (threads_count == 1) ?
+							query_topk(u, v, vectors_count, k, values, indices) :
+							vector3d_query_topk_parallel(query_topk, u, v, vectors_count, k, values, indices, threads_count);
+						if (count != expected_count) {
+							fprintf(stderr, "%s vector3d_query_topk on %zu threads: k = %zu for %zu vectors at offset %zu returns %zu results, %zu are expected\n",
+								method_name, threads_count, k, vectors_count, offset, count, expected_count);
+							mismatches_count++;
+							continue;
+						}
+						for (size_t result = 0; result < count; result++) {
+							if (compare_search_result(method_name, "vector3d_query_topk", threads_count, vectors_count, offset, indices[result], values[result], expected_indices[result], expected_values[result]) != 0) {
+								mismatches_count++;
+								break;
+							}
+						}
+					}
+				}
+			}
+		}
+	}
+	free(fine_v_buffer);
+	free(fine_u_buffer);
+	free(coarse_v_buffer);
+	free(coarse_u_buffer);
+	free(dp_array);
+	return mismatches_count;
+}
+
+// Thresholds of the filter checks: on the coarse inputs many dot products equal them, and must not pass
+static const double check_filter_thresholds[] = { -3.0, 0.0, 1.0 };
+static const size_t check_filter_thresholds_count = sizeof(check_filter_thresholds) / sizeof(check_filter_thresholds[0]);
+
+// Checks a filter kernel on every check vector count, offset of v, u and the outputs, and threshold against a scalar
+// loop. The output buffers are compared as a whole: the kernel may write anywhere in the first vectors_count elements,
+// but must not write past them.
+static size_t check_filter(const char* kernel_name, vector3d_dot_products_filter_function filter) {
+	const size_t buffer_length = 3 * check_max_vectors_count + check_max_offset;
+	const size_t output_length = check_max_vectors_count + check_max_offset;
+	double *fine_v_buffer = (double*)memalign(64, buffer_length * sizeof(double));
+	double *fine_u_buffer = (double*)memalign(64, buffer_length * sizeof(double));
+	double *coarse_v_buffer = (double*)memalign(64, buffer_length * sizeof(double));
+	double *coarse_u_buffer = (double*)memalign(64, buffer_length * sizeof(double));
+	double *values_buffer = (double*)memalign(64, output_length * sizeof(double));
+	size_t *indices_buffer = (size_t*)memalign(64, output_length * sizeof(size_t));
+	uint64_t state = 7;
+	for (size_t index = 0; index < buffer_length; index++) {
+		fine_v_buffer[index] = double(int32_t(next_check_bits(&state) >> 24) - 128) / 8.0;
+		fine_u_buffer[index] = double(int32_t(next_check_bits(&state) >> 24) - 128) / 8.0;
+		coarse_v_buffer[index] = double(int32_t(next_check_bits(&state) % 5) - 2);
+		coarse_u_buffer[index] = double(int32_t(next_check_bits(&state) % 5) - 2);
+	}
+	const double* v_buffers[2] = { fine_v_buffer, coarse_v_buffer };
+	const double* u_buffers[2] = { fine_u_buffer, coarse_u_buffer };
+	size_t mismatches_count = 0;
+	for (size_t buffer_number = 0; buffer_number < 2; buffer_number++) {
+		for (size_t threshold_number = 0; threshold_number < check_filter_thresholds_count; threshold_number++) {
+			const double threshold = check_filter_thresholds[threshold_number];
+			for (size_t count_number = 0; count_number < check_vectors_counts_count; count_number++) {
+				const size_t vectors_count = check_vectors_counts[count_number];
+				for (size_t offset = 0; offset < check_max_offset; offset++) {
+					const double* v = v_buffers[buffer_number] + offset;
+					const double* u = u_buffers[buffer_number] + (offset + 1) % check_max_offset;
+					const size_t output_offset = (offset + 2) % check_max_offset;
+					for (size_t index = 0; index < output_length; index++) {
+						values_buffer[index] = -1.0;
+						indices_buffer[index] = SIZE_MAX;
+					}
+					const size_t count = filter(v, u, vectors_count, threshold, values_buffer + output_offset, indices_buffer + output_offset);
+
+					size_t expected_count = 0;
+					size_t first_wrong = SIZE_MAX;
+					for (size_t index = 0; index < vectors_count; index++) {
+						const double dp = (v[3 * index] * u[3 * index] + v[3 * index + 1] * u[3 * index + 1]) + v[3 * index + 2] * u[3 * index + 2];
+						if (dp > threshold) {
+							const size_t position = output_offset + expected_count;
+							if ((first_wrong == SIZE_MAX) && ((values_buffer[position] != dp) || (indices_buffer[position] != index))) {
+								first_wrong = expected_count;
+							}
+							expected_count += 1;
+						}
+					}
+					// Elements outside of the output arrays keep their initial values
+					for (size_t position = 0; position < output_length; position++) {
+						const bool in_output = (position >= output_offset) && (position < output_offset + vectors_count);
+						if (!in_output && (first_wrong == SIZE_MAX) && ((values_buffer[position] != -1.0) || (indices_buffer[position] != SIZE_MAX))) {
+							first_wrong = position;
+						}
+					}
+					if (count != expected_count) {
+						fprintf(stderr, "%s: threshold %g for %zu vectors at offset %zu passes %zu dot products, a scalar loop passes %zu\n",
+							kernel_name, threshold, vectors_count, offset, count, expected_count);
+						mismatches_count++;
+					} else if (first_wrong != SIZE_MAX) {
+						fprintf(stderr, "%s: threshold %g for %zu vectors at offset %zu writes a wrong output element %zu\n",
+							kernel_name, threshold, vectors_count, offset, first_wrong);
+						mismatches_count++;
+					}
+				}
+			}
+		}
+	}
+	free(fine_v_buffer);
+	free(fine_u_buffer);
+	free(coarse_v_buffer);
+	free(coarse_u_buffer);
+	free(values_buffer);
+	free(indices_buffer);
+	return mismatches_count;
+}
+
+// Vector counts of the Gram matrix checks: row counts around the 4-row register blocks, and column counts around SIMD
+// vectors and the 512-column panels
+static const size_t check_gram_rows_counts[] = { 1, 3, 5, 17 };
+static const size_t check_gram_rows_counts_count = sizeof(check_gram_rows_counts) / sizeof(check_gram_rows_counts[0]);
+static const size_t check_gram_columns_counts[] = { 1, 7, 9, 515 };
+static const size_t check_gram_columns_counts_count = sizeof(check_gram_columns_counts) / sizeof(check_gram_columns_counts[0]);
+static const size_t check_max_gram_columns_count = 515;
+// Vector count of the parallel and symmetric Gram matrix checks: covers two full tiles and a partial one
+static const size_t check_gram_tiled_count = 2 * vector3d_gram_matrix_tile + 5;
+// Extra columns of the Gram matrix checks between the rows of the output, which the kernels must not write
+static const size_t check_gram_padding = 3;
+
+// Counts the elements of a Gram matrix that differ from a scalar loop, or that are written in the padding between rows.
+// The inputs are multiples of 1/8 below 16 in magnitude, so all dot products are exact, and fused multiply-adds do
+// not change them.
+static size_t count_gram_mismatches(const double* v, size_t v_count, const double* u, size_t u_count, const double* gram_matrix, size_t gram_stride) {
+	size_t mismatches_count = 0;
+	for (size_t row = 0; row < v_count; row++) {
+		for (size_t column = 0; column < gram_stride; column++) {
+			const double element = gram_matrix[row * gram_stride + column];
+			if (column < u_count) {
+				const double dp = (v[3 * row] * u[3 * column] + v[3 * row + 1] * u[3 * column + 1]) + v[3 * row + 2] * u[3 * column + 2];
+				mismatches_count += size_t(element != dp);
+			} else {
+				mismatches_count += size_t(element != -1.0);
+			}
+		}
+	}
+	return mismatches_count;
+}
+
+// Checks a Gram matrix kernel on every check row and column count and offset of v, u and the output against a scalar
+// loop, then on several tiles through vector3d_gram_matrix_parallel and vector3d_gram_matrix_symmetric on 3 threads
+static size_t check_gram(const char* kernel_name, vector3d_gram_matrix_function gram) {
+	const size_t buffer_length = 3 * max(check_gram_tiled_count, check_max_gram_columns_count) + check_max_offset;
+	const size_t gram_length = check_gram_tiled_count * (check_gram_tiled_count + check_gram_padding) + check_max_offset;
+	double *v_buffer = (double*)memalign(64, buffer_length * sizeof(double));
+	double *u_buffer = (double*)memalign(64, buffer_length * sizeof(double));
+	double *gram_buffer = (double*)memalign(64, gram_length * sizeof(double));
+	uint64_t state = 11;
+	for (size_t index = 0; index < buffer_length; index++) {
+		v_buffer[index] = double(int32_t(next_check_bits(&state) >> 24) - 128) / 8.0;
+		u_buffer[index] = double(int32_t(next_check_bits(&state) >> 24) - 128) / 8.0;
+	}
+	size_t mismatches_count = 0;
+	for (size_t rows_number = 0; rows_number < check_gram_rows_counts_count; rows_number++) {
+		const size_t v_count = check_gram_rows_counts[rows_number];
+		for (size_t columns_number = 0; columns_number < check_gram_columns_counts_count; columns_number++) {
+			const size_t u_count = check_gram_columns_counts[columns_number];
+			const size_t gram_stride = u_count + check_gram_padding;
+			for (size_t offset = 0; offset < check_max_offset; offset++) {
+				const double* v = v_buffer + offset;
+				const double* u = u_buffer + (offset + 1) % check_max_offset;
+				double* gram_matrix = gram_buffer + (offset + 2) % check_max_offset;
+				for (size_t index = 0; index < gram_length; index++) {
+					gram_buffer[index] = -1.0;
+				}
+				gram(v, v_count, u, u_count, gram_matrix, gram_stride);
+				const size_t wrong_count = count_gram_mismatches(v, v_count, u, u_count, gram_matrix, gram_stride);
+				if (wrong_count != 0) {
+					fprintf(stderr, "%s: %zu of the %zu x %zu Gram matrix elements at offset %zu are wrong\n",
+						kernel_name, wrong_count, v_count, u_count, offset);
+					mismatches_count++;
+				}
+			}
+		}
+	}
+
+	const size_t gram_stride = check_gram_tiled_count + check_gram_padding;
+	for (size_t symmetric = 0; symmetric <= 1; symmetric++) {
+		const double* u = symmetric ? v_buffer : u_buffer + 1;
+		for (size_t index = 0; index < gram_length; index++) {
+			gram_buffer[index] = -1.0;
+		}
+		if (symmetric) {
+			vector3d_gram_matrix_symmetric(gram, v_buffer, check_gram_tiled_count, gram_buffer, gram_stride, 3);
+		} else {
+			vector3d_gram_matrix_parallel(gram, v_buffer, check_gram_tiled_count, u, check_gram_tiled_count, gram_buffer, gram_stride, 3);
+		}
+		const size_t wrong_count = count_gram_mismatches(v_buffer, check_gram_tiled_count, u, check_gram_tiled_count, gram_buffer, gram_stride);
+		if (wrong_count != 0) {
+			fprintf(stderr, "%s: %zu of the %zu x %zu %s Gram matrix elements are wrong\n",
+				kernel_name, wrong_count, check_gram_tiled_count, check_gram_tiled_count, symmetric ? "symmetric" : "parallel");
+			mismatches_count++;
+		}
+	}
+	free(v_buffer);
+	free(u_buffer);
+	free(gram_buffer);
+	return mismatches_count;
+}
+
+// Shapes of the matrix-vector checks: row counts around the 4-row blocks, and column counts around SIMD vectors and the
+// two accumulators per row
+static const size_t check_matvec_rows_counts[] = { 1, 3, 4, 5, 9 };
+static const size_t check_matvec_rows_counts_count = sizeof(check_matvec_rows_counts) / sizeof(check_matvec_rows_counts[0]);
+static const size_t check_matvec_columns_counts[] = { 1, 3, 7, 8, 17, 33 };
+static const size_t check_matvec_columns_counts_count = sizeof(check_matvec_columns_counts) / sizeof(check_matvec_columns_counts[0]);
+static const size_t check_max_matvec_rows_count = 9;
+static const size_t check_max_matvec_columns_count = 33;
+// Extra elements of the matrix and output checks: between the rows of the matrix and after the end of the output
+static const size_t check_matrix_padding = 3;
+
+// Fills a check array with multiples of 1/8 below 16 in magnitude: the sums of the matrix checks are exact
+static void fill_check_matrix(double* array, size_t length, uint64_t* state) {
+	for (size_t index = 0; index < length; index++) {
+		array[index] = double(int32_t(next_check_bits(state) >> 24) - 128) / 8.0;
+	}
+}
+
+// Counts the elements of y that differ from expected_y, or that are written after its length elements
+static size_t count_matrix_mismatches(const double* y, const double* expected_y, size_t length) {
+	size_t mismatches_count = 0;
+	for (size_t index = 0; index < length; index++) {
+		mismatches_count += size_t(y[index] != expected_y[index]);
+	}
+	for (size_t index = length; index < length + check_matrix_padding; index++) {
+		mismatches_count += size_t(y[index] != -1.0);
+	}
+	return mismatches_count;
+}
+
+// Checks a matrix-vector and a transposed matrix-vector kernel on every check shape and offset of the matrix, x and y
+// against scalar loops. The padding between the rows of the matrix holds NaNs, so a kernel which reads it produces NaNs.
+static size_t check_matvec(const char* method_name, matvec_function matvec, matvec_function matvec_transposed) {
+	const size_t matrix_stride = check_max_matvec_columns_count + check_matrix_padding;
+	const size_t matrix_length = check_max_matvec_rows_count * matrix_stride + check_max_offset;
+	const size_t vector_length = max(check_max_matvec_rows_count, check_max_matvec_columns_count) + check_matrix_padding + check_max_offset;
+	double *matrix_buffer = (double*)memalign(64, matrix_length * sizeof(double));
+	double *x_buffer = (double*)memalign(64, vector_length * sizeof(double));
+	double *y_buffer = (double*)memalign(64, vector_length * sizeof(double));
+	double expected_y[max(check_max_matvec_rows_count, check_max_matvec_columns_count)];
+	uint64_t state = 13;
+	fill_check_matrix(x_buffer, vector_length, &state);
+	size_t mismatches_count = 0;
+	for (size_t rows_number = 0; rows_number < check_matvec_rows_counts_count; rows_number++) {
+		const size_t rows = check_matvec_rows_counts[rows_number];
+		for (size_t columns_number = 0; columns_number < check_matvec_columns_counts_count; columns_number++) {
+			const size_t columns = check_matvec_columns_counts[columns_number];
+			const size_t stride = columns + check_matrix_padding;
+			for (size_t offset = 0; offset < check_max_offset; offset++) {
+				double* matrix = matrix_buffer + offset;
+				const double* x = x_buffer + (offset + 1) % check_max_offset;
+				double* y = y_buffer + (offset + 2) % check_max_offset;
+				fill_check_matrix(matrix_buffer, matrix_length, &state);
+				for (size_t row = 0; row < rows; row++) {
+					for (size_t column = columns; column < stride; column++) {
+						matrix[row * stride + column] = nan("");
+					}
+				}
+
+				for (size_t index = 0; index < vector_length; index++) {
+					y_buffer[index] = -1.0;
+				}
+				matvec(matrix, rows, columns, stride, x, y);
+				for (size_t row = 0; row < rows; row++) {
+					double sum = 0.0;
+					for (size_t column = 0; column < columns; column++) {
+						sum += matrix[row * stride + column] * x[column];
+					}
+					expected_y[row] = sum;
+				}
+				const size_t wrong_count = count_matrix_mismatches(y, expected_y, rows);
+				if (wrong_count != 0) {
+					fprintf(stderr, "%s: %zu elements of the matrix-vector product of %zu x %zu elements at offset %zu are wrong\n",
+						method_name, wrong_count, rows, columns, offset);
+					mismatches_count++;
+				}
+
+				for (size_t index = 0; index < vector_length; index++) {
+					y_buffer[index] = -1.0;
+				}
+				matvec_transposed(matrix, rows, columns, stride, x, y);
+				for (size_t column = 0; column < columns; column++) {
+					double sum = 0.0;
+					for (size_t row = 0; row < rows; row++) {
+						sum += matrix[row * stride + column] * x[row];
+					}
+					expected_y[column] = sum;
+				}
+				const size_t transposed_wrong_count = count_matrix_mismatches(y, expected_y, columns);
+				if (transposed_wrong_count != 0) {
+					fprintf(stderr, "%s: %zu elements of the transposed matrix-vector product of %zu x %zu elements at offset %zu are wrong\n",
+						method_name, transposed_wrong_count, rows, columns, offset);
+					mismatches_count++;
+				}
+			}
+		}
+	}
+	free(matrix_buffer);
+	free(x_buffer);
+	free(y_buffer);
+	return mismatches_count;
+}
+
+// Matrix counts of the batched matrix product checks
+static const size_t check_matrices_counts[] = { 1, 2, 3, 5 };
+static const size_t check_matrices_counts_count = sizeof(check_matrices_counts) / sizeof(check_matrices_counts[0]);
+static const size_t check_max_matrices_count = 5;
+
+// Checks a batched product kernel of matrix_size x matrix_size matrices on every check matrix count and offset of A, B
+// and C against a scalar loop
+static size_t check_batched_matmul(const char* kernel_name, batched_matmul_function batched_matmul, size_t matrix_size) {
+	const size_t matrix_elements = matrix_size * matrix_size;
+	const size_t buffer_length = check_max_matrices_count * matrix_elements + check_matrix_padding + check_max_offset;
+	double *a_buffer = (double*)memalign(64, buffer_length * sizeof(double));
+	double *b_buffer = (double*)memalign(64, buffer_length * sizeof(double));
+	double *c_buffer = (double*)memalign(64, buffer_length * sizeof(double));
+	double *expected_c = (double*)memalign(64, check_max_matrices_count * matrix_elements * sizeof(double));
+	uint64_t state = 17;
+	size_t mismatches_count = 0;
+	for (size_t count_number = 0; count_number < check_matrices_counts_count; count_number++) {
+		const size_t matrices_count = check_matrices_counts[count_number];
+		for (size_t offset = 0; offset < check_max_offset; offset++) {
+			const double* a = a_buffer + offset;
+			const double* b = b_buffer + (offset + 1) % check_max_offset;
+			double* c = c_buffer + (offset + 2) % check_max_offset;
+			fill_check_matrix(a_buffer, buffer_length, &state);
+			fill_check_matrix(b_buffer, buffer_length, &state);
+			for (size_t index = 0; index < buffer_length; index++) {
+				c_buffer[index] = -1.0;
+			}
+			batched_matmul(a, b, c, matrices_count);
+			for (size_t matrix = 0; matrix < matrices_count; matrix++) {
+				const size_t start = matrix * matrix_elements;
+				for (size_t row = 0; row < matrix_size; row++) {
+					for (size_t column = 0; column < matrix_size; column++) {
+						double sum = 0.0;
+						for (size_t k = 0; k < matrix_size; k++) {
+							sum += a[start + row * matrix_size + k] * b[start + k * matrix_size + column];
+						}
+						expected_c[start + row * matrix_size + column] = sum;
+					}
+				}
+			}
+			const size_t wrong_count = count_matrix_mismatches(c, expected_c, matrices_count * matrix_elements);
+			if (wrong_count != 0) {
+				fprintf(stderr, "%s: %zu elements of %zu products at offset %zu are wrong\n",
+					kernel_name, wrong_count, matrices_count, offset);
+				mismatches_count++;
+			}
+		}
+	}
+	free(a_buffer);
+	free(b_buffer);
+	free(c_buffer);
+	free(expected_c);
+	return mismatches_count;
+}
+
+// Checks the batched product kernels of 3x3, 4x4 and 8x8 matrices of an instruction set
+static size_t check_batched_matmuls(const char* method_name, batched_matmul_function batched_matmul_3x3, batched_matmul_function batched_matmul_4x4, batched_matmul_function batched_matmul_8x8) {
+	char kernel_name[64];
+	size_t mismatches_count = 0;
+	snprintf(kernel_name, sizeof(kernel_name), "%s 3x3", method_name);
+	mismatches_count += check_batched_matmul(kernel_name, batched_matmul_3x3, 3);
+	snprintf(kernel_name, sizeof(kernel_name), "%s 4x4", method_name);
+	mismatches_count += check_batched_matmul(kernel_name, batched_matmul_4x4, 4);
+	snprintf(kernel_name, sizeof(kernel_name), "%s 8x8", method_name);
+	mismatches_count += check_batched_matmul(kernel_name, batched_matmul_8x8, 8);
+	return mismatches_count;
+}
+
+// Tile lengths of the chain checks: the automatic length, with a single tile for the check vector counts, and the
+// minimum, with many tiles for the threads of the pool to steal
+static const size_t check_chain_tile_lengths[] = { 0, 64 };
+static const size_t check_chain_tile_lengths_count = sizeof(check_chain_tile_lengths) / sizeof(check_chain_tile_lengths[0]);
+
+// Runs max(dot(v, u) + b) as a kernel chain on every check vector count, tile length and offset of the arrays, on the
+// calling thread and on a pool of 3 threads, and compares the result and the output array dot(v, u) + b with the kernels
+// run one after another over the whole arrays. Each run is a full round trip: the run is submitted to the pool and
+// waited for. The inputs are multiples of 1/8 below 16 in magnitude, so all dot products are exact.
+static size_t check_chain(const char* kernel_name, vector3d_dot_products_function vector3d_dot_products) {
+	chain_pool* pool = chain_pool_create(3);
+	if (pool == NULL) {
+		fprintf(stderr, "%s chain: failed to create a pool of 3 threads\n", kernel_name);
+		return 1;
+	}
+	const size_t buffer_length = 3 * check_max_vectors_count + check_max_offset;
+	const size_t output_length = check_max_vectors_count + check_max_offset;
+	double *v_buffer = (double*)memalign(64, buffer_length * sizeof(double));
+	double *u_buffer = (double*)memalign(64, buffer_length * sizeof(double));
+	double *b_buffer = (double*)memalign(64, output_length * sizeof(double));
+	double *dp_buffer = (double*)memalign(64, output_length * sizeof(double));
+	double *expected_buffer = (double*)memalign(64, output_length * sizeof(double));
+	uint64_t state = 19;
+	for (size_t index = 0; index < buffer_length; index++) {
+		v_buffer[index] = double(int32_t(next_check_bits(&state) >> 24) - 128) / 8.0;
+		u_buffer[index] = double(int32_t(next_check_bits(&state) >> 24) - 128) / 8.0;
+	}
+	for (size_t index = 0; index < output_length; index++) {
+		b_buffer[index] = double(int32_t(next_check_bits(&state) >> 24) - 128) / 8.0;
+	}
+	size_t mismatches_count = 0;
+	for (size_t count_number = 0; count_number < check_vectors_counts_count; count_number++) {
+		const size_t vectors_count = check_vectors_counts[count_number];
+		for (size_t offset = 0; offset < check_max_offset; offset++) {
+			const double* v = v_buffer + offset;
+			const double* u = u_buffer + (offset + 1) % check_max_offset;
+			const double* b = b_buffer + (offset + 2) % check_max_offset;
+			const size_t dp_offset = (offset + 3) % check_max_offset;
+			for (size_t index = 0; index < output_length; index++) {
+				expected_buffer[index] = -1.0;
+			}
+			double expected_max;
+			vector3d_dot_products(v, u, expected_buffer + dp_offset, vectors_count);
+			chain_accumulate_naive(b, expected_buffer + dp_offset, vectors_count);
+			chain_max_naive(expected_buffer + dp_offset, &expected_max, vectors_count);
+			for (size_t tile_number = 0; tile_number < check_chain_tile_lengths_count; tile_number++) {
+				for (size_t pool_number = 0; pool_number < 2; pool_number++) {
+					for (size_t index = 0; index < output_length; index++) {
+						dp_buffer[index] = -1.0;
+					}
+					double max = 0.0;
+					bool succeeded = false;
+					kernel_chain* chain = kernel_chain_create(vectors_count);
+					if (chain != NULL) {
+						kernel_chain_set_tile_length(chain, check_chain_tile_lengths[tile_number]);
+						const chain_array dp = kernel_chain_output(chain, dp_buffer + dp_offset);
+						succeeded = kernel_chain_map(chain, vector3d_dot_products, kernel_chain_input(chain, v, 3), kernel_chain_input(chain, u, 3), dp) &&
+							kernel_chain_accumulate(chain, &chain_accumulate_naive, kernel_chain_input(chain, b, 1), dp) &&
+							kernel_chain_max(chain, &chain_max_naive, dp, &max) &&
+							kernel_chain_run(chain, (pool_number == 0) ? NULL : pool);
+						kernel_chain_destroy(chain);
+					}
+					size_t first_wrong = output_length;
+					for (size_t index = 0; index < output_length; index++) {
+						if (dp_buffer[index] != expected_buffer[index]) {
+							first_wrong = index;
+							break;
+						}
+					}
+					if (!succeeded || (max != expected_max) || (first_wrong != output_length)) {
+						fprintf(stderr, "%s chain with tile length %zu on %s: the maximum for %zu vectors at offset %zu is %.17g, the kernels compute %.17g; the first wrong output element is %zu\n",
+							kernel_name, check_chain_tile_lengths[tile_number], (pool_number == 0) ? "1 thread" : "a pool of 3 threads",
+							vectors_count, offset, succeeded ? max : NAN, expected_max, first_wrong);
+						mismatches_count++;
+					}
+				}
+			}
+		}
+	}
+	chain_pool_destroy(pool);
+	free(v_buffer);
+	free(u_buffer);
+	free(b_buffer);
+	free(dp_buffer);
+	free(expected_buffer);
+	return mismatches_count;
+}
+
+// Vector counts of the reproducible sum checks: within the first block, around the block boundary and over several blocks
+static const size_t check_reproducible_vectors_counts[] = { 1, 7, 9, 1023, 1025, 4100 };
+static const size_t check_reproducible_vectors_counts_count = sizeof(check_reproducible_vectors_counts) / sizeof(check_reproducible_vectors_counts[0]);
+static const size_t check_max_reproducible_vectors_count = 4100;
+
+// Checks a reproducible dot products sum on every reproducible check vector count and offset of v and u. On multiples
+// of 1/8 in [-16, 16) the sum is exact, so it must equal a scalar loop. On these numbers divided by 3 the operations
+// round, and the result must be bitwise identical to the naive version, both serial and split among 2 and 3 threads.
+static size_t check_reproducible_dot_products_sum(const char* kernel_name, reproducible_dot_products_sum_function sum) {
+	const size_t buffer_length = 3 * check_max_reproducible_vectors_count + check_max_offset;
+	double *exact_v_buffer = (double*)memalign(64, buffer_length * sizeof(double));
+	double *exact_u_buffer = (double*)memalign(64, buffer_length * sizeof(double));
+	double *rounded_v_buffer = (double*)memalign(64, buffer_length * sizeof(double));
+	double *rounded_u_buffer = (double*)memalign(64, buffer_length * sizeof(double));
+	uint64_t state = 5;
+	for (size_t index = 0; index < buffer_length; index++) {
+		exact_v_buffer[index] = double(int32_t(next_check_bits(&state) >> 24) - 128) / 8.0;
+		exact_u_buffer[index] = double(int32_t(next_check_bits(&state) >> 24) - 128) / 8.0;
+		rounded_v_buffer[index] = exact_v_buffer[index] / 3.0;
+		rounded_u_buffer[index] = exact_u_buffer[index] / 3.0;
+	}
+	size_t mismatches_count = 0;
+	for (size_t count_number = 0; count_number < check_reproducible_vectors_counts_count; count_number++) {
+		const size_t vectors_count = check_reproducible_vectors_counts[count_number];
+		for (size_t offset = 0; offset < check_max_offset; offset++) {
+			const size_t v_offset = offset;
+			const size_t u_offset = (offset + 1) % check_max_offset;
+			double expected_sum = 0.0;
+			for (size_t index = 0; index < 3 * vectors_count; index++) {
+				expected_sum += exact_v_buffer[v_offset + index] * exact_u_buffer[u_offset + index];
+			}
+			const double exact_sum = sum(exact_v_buffer + v_offset, exact_u_buffer + u_offset, vectors_count);
+			if (exact_sum != expected_sum) {
+				fprintf(stderr, "%s: the sum of %zu dot products at offset %zu is %.17g, a scalar loop computes %.17g\n",
+					kernel_name, vectors_count, offset, exact_sum, expected_sum);
+				mismatches_count++;
+			}
+
+			const double naive_sum = reproducible_dot_products_sum_naive(rounded_v_buffer + v_offset, rounded_u_buffer + u_offset, vectors_count);
+			const double rounded_sum = sum(rounded_v_buffer + v_offset, rounded_u_buffer + u_offset, vectors_count);
+			const double two_threads_sum = reproducible_dot_products_sum_parallel(sum, rounded_v_buffer + v_offset, rounded_u_buffer + u_offset, vectors_count, 2);
+			const double three_threads_sum = reproducible_dot_products_sum_parallel(sum, rounded_v_buffer + v_offset, rounded_u_buffer + u_offset, vectors_count, 3);
+			if ((rounded_sum != naive_sum) || (two_threads_sum != naive_sum) || (three_threads_sum != naive_sum)) {
+				fprintf(stderr, "%s: the sums of %zu dot products at offset %zu are %.17g, %.17g on 2 threads and %.17g on 3 threads, the naive version computes %.17g\n",
+					kernel_name, vectors_count, offset, rounded_sum, two_threads_sum, three_threads_sum, naive_sum);
+				mismatches_count++;
+			}
+		}
+	}
+	free(exact_v_buffer);
+	free(exact_u_buffer);
+	free(rounded_v_buffer);
+	free(rounded_u_buffer);
+	return mismatches_count;
+}
+
+// Runs all correctness checks. Returns the number of mismatches.
+static size_t check_kernels() {
+	size_t mismatches_count = 0;
+	#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+		mismatches_count += check_typed_dot_products<float, isa_sse2>("float + SSE2");
+		mismatches_count += check_typed_dot_products<int32_t, isa_sse2>("int32 + SSE2");
+		mismatches_count += check_typed_dot_products<int64_t, isa_sse2>("int64 + SSE2");
+		mismatches_count += check_typed_dot_products<bfloat16, isa_sse2>("bfloat16 + SSE2");
+	#endif
+	#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+		mismatches_count += check_typed_dot_products<float, isa_avx>("float + AVX");
+		mismatches_count += check_typed_dot_products<bfloat16, isa_avx>("bfloat16 + AVX");
+	#endif
+	#ifdef CSE6230_AVX2_INTRINSICS_SUPPORTED
+		mismatches_count += check_typed_dot_products<float, isa_avx2>("float + AVX2");
+		mismatches_count += check_typed_dot_products<int32_t, isa_avx2>("int32 + AVX2");
+		mismatches_count += check_typed_dot_products<int64_t, isa_avx2>("int64 + AVX2");
+		mismatches_count += check_typed_dot_products<bfloat16, isa_avx2>("bfloat16 + AVX2");
+	#endif
+	#ifdef CSE6230_AVX512F_INTRINSICS_SUPPORTED
+		mismatches_count += check_typed_dot_products<float, isa_avx512f>("float + AVX-512");
+		mismatches_count += check_typed_dot_products<int32_t, isa_avx512f>("int32 + AVX-512");
+		mismatches_count += check_typed_dot_products<int64_t, isa_avx512f>("int64 + AVX-512");
+		mismatches_count += check_typed_dot_products<bfloat16, isa_avx512f>("bfloat16 + AVX-512");
+	#endif
+	mismatches_count += check_mixed_precision_kernels();
+	#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+		mismatches_count += check_dot_products("vectornd_dot_products_sse2", &vectornd_dot_products_sse2, NULL);
+	#endif
+	#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+		mismatches_count += check_dot_products("vectornd_dot_products_avx", &vectornd_dot_products_avx, NULL);
+	#endif
+	#ifdef CSE6230_AVX512F_INTRINSICS_SUPPORTED
+		mismatches_count += check_dot_products("vectornd_dot_products_avx512f", &vectornd_dot_products_avx512f, NULL);
+	#endif
+	mismatches_count += check_dot_products("vector3d_dot_products_dispatch", NULL, &vector3d_dot_products_dispatch);
+	mismatches_count += check_dot_products("vector3d_dot_products_omp_simd", NULL, &vector3d_dot_products_omp_simd);
+	#ifdef CSE6230_UNSEQ_SUPPORTED
+		mismatches_count += check_dot_products("vector3d_dot_products_unseq", NULL, &vector3d_dot_products_unseq);
+	#endif
+	#ifdef CSE6230_PAR_UNSEQ_SUPPORTED
+		mismatches_count += check_dot_products("vector3d_dot_products_par_unseq", NULL, &vector3d_dot_products_par_unseq);
+	#endif
+	#ifdef CSE6230_VECTOR_EXTENSIONS_SUPPORTED
+		mismatches_count += check_dot_products("vector3d_dot_products_vector_extensions", NULL, &vector3d_dot_products_vector_extensions);
+	#endif
+	mismatches_count += check_reproducible_dot_products_sum("reproducible_dot_products_sum_naive", &reproducible_dot_products_sum_naive);
+	#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+		mismatches_count += check_reproducible_dot_products_sum("reproducible_dot_products_sum_sse2", &reproducible_dot_products_sum_sse2);
+	#endif
+	#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+		mismatches_count += check_reproducible_dot_products_sum("reproducible_dot_products_sum_avx", &reproducible_dot_products_sum_avx);
+	#endif
+	#ifdef CSE6230_AVX512F_INTRINSICS_SUPPORTED
+		mismatches_count += check_reproducible_dot_products_sum("reproducible_dot_products_sum_avx512f", &reproducible_dot_products_sum_avx512f);
+	#endif
+	mismatches_count += check_search("Naive", &vector3d_dot_products_argmax_naive, &vector3d_query_argmax_naive, &vector3d_query_topk_naive);
+	#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+		mismatches_count += check_search("SSE2", &vector3d_dot_products_argmax_sse2, &vector3d_query_argmax_sse2, &vector3d_query_topk_sse2);
+	#endif
+	#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+		mismatches_count += check_search("AVX", &vector3d_dot_products_argmax_avx, &vector3d_query_argmax_avx, &vector3d_query_topk_avx);
+	#endif
+	#ifdef CSE6230_AVX512F_INTRINSICS_SUPPORTED
+		mismatches_count += check_search("AVX-512", &vector3d_dot_products_argmax_avx512f, &vector3d_query_argmax_avx512f, &vector3d_query_topk_avx512f);
+	#endif
+	mismatches_count += check_gram("vector3d_gram_matrix_naive", &vector3d_gram_matrix_naive);
+	#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+		mismatches_count += check_gram("vector3d_gram_matrix_sse2", &vector3d_gram_matrix_sse2);
+	#endif
+	#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+		mismatches_count += check_gram("vector3d_gram_matrix_avx", &vector3d_gram_matrix_avx);
+	#endif
+	#if defined(CSE6230_AVX2_INTRINSICS_SUPPORTED) && defined(CSE6230_FMA3_INTRINSICS_SUPPORTED)
+		mismatches_count += check_gram("vector3d_gram_matrix_avx2", &vector3d_gram_matrix_avx2);
+	#endif
+	#ifdef CSE6230_AVX512F_INTRINSICS_SUPPORTED
+		mismatches_count += check_gram("vector3d_gram_matrix_avx512f", &vector3d_gram_matrix_avx512f);
+	#endif
+	mismatches_count += check_matvec("Naive", &matvec_naive, &matvec_transposed_naive);
+	mismatches_count += check_batched_matmuls("Naive", &batched_matmul_3x3_naive, &batched_matmul_4x4_naive, &batched_matmul_8x8_naive);
+	#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+		mismatches_count += check_matvec("SSE2", &matvec_sse2, &matvec_transposed_sse2);
+		mismatches_count += check_batched_matmuls("SSE2", &batched_matmul_3x3_sse2, &batched_matmul_4x4_sse2, &batched_matmul_8x8_sse2);
+	#endif
+	#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+		mismatches_count += check_matvec("AVX", &matvec_avx, &matvec_transposed_avx);
+		mismatches_count += check_batched_matmuls("AVX", &batched_matmul_3x3_avx, &batched_matmul_4x4_avx, &batched_matmul_8x8_avx);
+	#endif
+	#if defined(CSE6230_AVX2_INTRINSICS_SUPPORTED) && defined(CSE6230_FMA3_INTRINSICS_SUPPORTED)
+		mismatches_count += check_matvec("AVX2 + FMA3", &matvec_avx2, &matvec_transposed_avx2);
+		mismatches_count += check_batched_matmuls("AVX2 + FMA3", &batched_matmul_3x3_avx2, &batched_matmul_4x4_avx2, &batched_matmul_8x8_avx2);
+	#endif
+	#ifdef CSE6230_AVX512F_INTRINSICS_SUPPORTED
+		mismatches_count += check_matvec("AVX-512", &matvec_avx512f, &matvec_transposed_avx512f);
+		mismatches_count += check_batched_matmuls("AVX-512", &batched_matmul_3x3_avx512f, &batched_matmul_4x4_avx512f, &batched_matmul_8x8_avx512f);
+	#endif
+	mismatches_count += check_chain("vector3d_dot_products_naive", &vector3d_dot_products_naive);
+	#if defined(CSE6230_AVX512F_INTRINSICS_SUPPORTED)
+		mismatches_count += check_chain("vectornd_dot_products<3>_avx512f", &vectornd_dot_products<3, isa_avx512f>);
+	#elif defined(CSE6230_AVX_INTRINSICS_SUPPORTED)
+		mismatches_count += check_chain("vectornd_dot_products<3>_avx", &vectornd_dot_products<3, isa_avx>);
+	#elif defined(CSE6230_SSE2_INTRINSICS_SUPPORTED)
+		mismatches_count += check_chain("vector3d_dot_products_sse2", &vector3d_dot_products_sse2);
+	#endif
+	mismatches_count += check_filter("vector3d_dot_products_filter_naive", &vector3d_dot_products_filter_naive);
+	#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+		mismatches_count += check_filter("vector3d_dot_products_filter_sse2", &vector3d_dot_products_filter_sse2);
+	#endif
+	#ifdef CSE6230_AVX2_INTRINSICS_SUPPORTED
+		mismatches_count += check_filter("vector3d_dot_products_filter_avx2", &vector3d_dot_products_filter_avx2);
+	#endif
+	#ifdef CSE6230_AVX512F_INTRINSICS_SUPPORTED
+		mismatches_count += check_filter("vector3d_dot_products_filter_avx512f", &vector3d_dot_products_filter_avx512f);
+	#endif
+	return mismatches_count;
+}
+
+// Upper bound on the number of kernels of one operation in the registry
+static const size_t max_operation_kernels = 64;
+
+// Collects the kernels of the operation which can run on this processor, in registry order
+static size_t find_kernels(kernel_registry_operation operation, const kernel_info* kernels[max_operation_kernels]) {
+	size_t kernels_count = 0;
+	for (size_t index = 0; index < kernel_registry_count(); index++) {
+		const kernel_info* kernel = kernel_registry_get(index);
+		if ((kernel->operation == operation) && kernel_registry_is_available(kernel) && (kernels_count < max_operation_kernels)) {
+			kernels[kernels_count++] = kernel;
+		}
+	}
+	return kernels_count;
+}
+
+// Returns the available kernel of the operation with the same instruction set as the kernel, or NULL.
+// Benchmarks of several operations report them in one row, e.g. matvec and matvec_transposed.
+static const kernel_info* find_matching_kernel(kernel_registry_operation operation, const kernel_info* kernel) {
+	for (size_t index = 0; index < kernel_registry_count(); index++) {
+		const kernel_info* match = kernel_registry_get(index);
+		if ((match->operation == operation) && (match->isa == kernel->isa) && kernel_registry_is_available(match)) {
+			return match;
+		}
+	}
+	return NULL;
+}
+
+// Benchmarks the typed kernels of one element type
+template <typename T>
+static void test_typed_kernels(kernel_registry_operation operation, const void* v_vectors, const void* u_vectors, void* dp_array, size_t vectors_count, size_t experiments_count) {
+	typedef void (*typed_dot_products_function)(const T*, const T*, typename dot_product_result<T>::type*, size_t);
+	const kernel_info* kernels[max_operation_kernels];
+	const size_t kernels_count = find_kernels(operation, kernels);
+	for (size_t kernel_number = 0; kernel_number < kernels_count; kernel_number++) {
+		test_typed_dot_product<T>(kernels[kernel_number]->description, reinterpret_cast<typed_dot_products_function>(kernels[kernel_number]->function),
+			v_vectors, u_vectors, dp_array, vectors_count, experiments_count);
+	}
+}
+
+static void run_benchmarks(cache_mode mode, size_t experiments_count) {
+	benchmark_cache_mode = mode;
+	printf("Cache mode: %s\n", cache_mode_names[mode]);
+	
+	size_t vectors_count = 150;
+	const size_t components_per_vector = 3;
+	double *v_vectors = (double*)allocate_benchmark_array(vectors_count * components_per_vector * sizeof(double) + 32);
+	double *u_vectors = (double*)allocate_benchmark_array(vectors_count * components_per_vector * sizeof(double) + 32);
+	double *dp_array = (double*)allocate_benchmark_array(vectors_count * sizeof(double) + 32);
+	// Random inputs: in vectors of zeros, all dot products would tie in the searches
+	for (size_t i = 0; i < vectors_count * components_per_vector; i++) {
+		v_vectors[i] = 2.0 * double(rand()) / double(RAND_MAX) - 1.0;
+		u_vectors[i] = 2.0 * double(rand()) / double(RAND_MAX) - 1.0;
+	}
+	const kernel_info* kernels[max_operation_kernels];
+	size_t kernels_count;
+	
+	begin_section("Dot Products");
+	printf("Method\tAligned CPE\tMin CPE\tMax CPE\n");
+	
+	kernels_count = find_kernels(kernel_registry_operation_vector3d_dot_products, kernels);
+	for (size_t kernel_number = 0; kernel_number < kernels_count; kernel_number++) {
+		const vector3d_dot_products_function vector3d_dot_products = reinterpret_cast<vector3d_dot_products_function>(kernels[kernel_number]->function);
+		test_dot_product(kernels[kernel_number]->description, vector3d_dot_products, v_vectors, u_vectors, dp_array, vectors_count, experiments_count);
+	}
+	test_dot_product("Dispatch", &vector3d_dot_products_dispatch, v_vectors, u_vectors, dp_array, vectors_count, experiments_count);
+	// The telemetry mode keeps telemetry enabled for all benchmarks
+	const bool telemetry_enabled = kernel_telemetry_is_enabled();
+	kernel_telemetry_enable(true);
+	test_dot_product("Dispatch + telemetry", &vector3d_dot_products_dispatch, v_vectors, u_vectors, dp_array, vectors_count, experiments_count);
+	kernel_telemetry_enable(telemetry_enabled);
+
+	begin_section("Reproducible Sum");
+	printf("Reproducible Sum Method\tAligned CPE\n");
+
+	kernels_count = find_kernels(kernel_registry_operation_reproducible_dot_products_sum, kernels);
+	for (size_t kernel_number = 0; kernel_number < kernels_count; kernel_number++) {
+		const reproducible_dot_products_sum_function sum = reinterpret_cast<reproducible_dot_products_sum_function>(kernels[kernel_number]->function);
+		report_timings(kernels[kernel_number]->description, time_reproducible_dot_products_sum(sum, 1, v_vectors, u_vectors, vectors_count, experiments_count), vectors_count);
+	}
+	// Threads are started on every call
+	const kernel_info* reproducible_sum_naive = kernel_registry_find("reproducible_dot_products_sum_naive");
+	if (reproducible_sum_naive != NULL) {
+		report_timings("Naive + all threads", time_reproducible_dot_products_sum(reinterpret_cast<reproducible_dot_products_sum_function>(reproducible_sum_naive->function), 0, v_vectors, u_vectors, vectors_count, max(experiments_count / 1000, 1)), vectors_count);
+	}
+
+	begin_section("Fused Argmax");
+	printf("Fused Argmax Method\tPairs CPE\tQuery CPE\tTop-8 CPE\n");
+
+	// Dot products of the naive and the fastest kernel, reduced by a separate pass
+	const kernel_info* unfused_kernels[2] = { kernel_registry_find("vector3d_dot_products_naive"), kernel_registry_best(kernel_registry_operation_vector3d_dot_products, sizeof(double)) };
+	for (size_t kernel_number = 0; kernel_number < 2; kernel_number++) {
+		if ((unfused_kernels[kernel_number] != NULL) && ((kernel_number == 0) || (unfused_kernels[1] != unfused_kernels[0]))) {
+			char method_name[64];
+			snprintf(method_name, sizeof(method_name), "Unfused %s", unfused_kernels[kernel_number]->description);
+			report_timings(method_name, time_unfused_argmax(reinterpret_cast<vector3d_dot_products_function>(unfused_kernels[kernel_number]->function), v_vectors, u_vectors, dp_array, vectors_count, experiments_count), vectors_count);
+		}
+	}
+	kernels_count = find_kernels(kernel_registry_operation_vector3d_dot_products_argmax, kernels);
+	for (size_t kernel_number = 0; kernel_number < kernels_count; kernel_number++) {
+		const kernel_info* query_argmax_kernel = find_matching_kernel(kernel_registry_operation_vector3d_query_argmax, kernels[kernel_number]);
+		const kernel_info* query_topk_kernel = find_matching_kernel(kernel_registry_operation_vector3d_query_topk, kernels[kernel_number]);
+		if ((query_argmax_kernel != NULL) && (query_topk_kernel != NULL)) {
+			test_search(kernels[kernel_number]->description,
+				reinterpret_cast<vector3d_dot_products_argmax_function>(kernels[kernel_number]->function),
+				reinterpret_cast<vector3d_query_argmax_function>(query_argmax_kernel->function),
+				reinterpret_cast<vector3d_query_topk_function>(query_topk_kernel->function),
+				1, v_vectors, u_vectors, vectors_count, experiments_count);
+		}
+	}
+	// Threads are started on every call
+	const kernel_info* argmax_naive = kernel_registry_find("vector3d_dot_products_argmax_naive");
+	const kernel_info* query_argmax_naive = kernel_registry_find("vector3d_query_argmax_naive");
+	const kernel_info* query_topk_naive = kernel_registry_find("vector3d_query_topk_naive");
+	if ((argmax_naive != NULL) && (query_argmax_naive != NULL) && (query_topk_naive != NULL)) {
+		test_search("Naive + all threads",
+			reinterpret_cast<vector3d_dot_products_argmax_function>(argmax_naive->function),
+			reinterpret_cast<vector3d_query_argmax_function>(query_argmax_naive->function),
+			reinterpret_cast<vector3d_query_topk_function>(query_topk_naive->function),
+			0, v_vectors, u_vectors, vectors_count, max(experiments_count / 1000, 1));
+	}
+
+	begin_section("Filter");
+	printf("Filter Method\tAligned CPE\n");
+
+	double *filter_v_vectors = (double*)allocate_benchmark_array(vectors_count * components_per_vector * sizeof(double));
+	double *filter_u_vectors = (double*)allocate_benchmark_array(vectors_count * components_per_vector * sizeof(double));
+	size_t *filter_indices = (size_t*)allocate_benchmark_array(vectors_count * sizeof(size_t));
+	for (size_t i = 0; i < vectors_count * components_per_vector; i++) {
+		filter_v_vectors[i] = 2.0 * double(rand()) / double(RAND_MAX) - 1.0;
+		filter_u_vectors[i] = 2.0 * double(rand()) / double(RAND_MAX) - 1.0;
+	}
+
+	if (unfused_kernels[0] != NULL) {
+		report_timings("Unfused Naive", time_unfused_filter(reinterpret_cast<vector3d_dot_products_function>(unfused_kernels[0]->function), filter_v_vectors, filter_u_vectors, dp_array, dp_array, filter_indices, vectors_count, experiments_count), vectors_count);
+	}
+	kernels_count = find_kernels(kernel_registry_operation_vector3d_dot_products_filter, kernels);
+	for (size_t kernel_number = 0; kernel_number < kernels_count; kernel_number++) {
+		const vector3d_dot_products_filter_function filter = reinterpret_cast<vector3d_dot_products_filter_function>(kernels[kernel_number]->function);
+		report_timings(kernels[kernel_number]->description, time_dot_products_filter(filter, filter_v_vectors, filter_u_vectors, dp_array, filter_indices, vectors_count, experiments_count), vectors_count);
+	}
+
+	free_benchmark_array(filter_v_vectors);
+	free_benchmark_array(filter_u_vectors);
+	free_benchmark_array(filter_indices);
+
+	begin_section("Gram Matrix");
+	printf("Gram Matrix Method\tCPE\n");
+
+	// Every call computes vectors_count^2 dot products
+	const size_t gram_experiments_count = max(experiments_count / 1000, 1);
+	const size_t gram_elements = vectors_count * vectors_count;
+	double *gram_matrix = (double*)allocate_benchmark_array(gram_elements * sizeof(double));
+
+	kernels_count = find_kernels(kernel_registry_operation_vector3d_gram_matrix, kernels);
+	for (size_t kernel_number = 0; kernel_number < kernels_count; kernel_number++) {
+		const vector3d_gram_matrix_function gram = reinterpret_cast<vector3d_gram_matrix_function>(kernels[kernel_number]->function);
+		report_timings(kernels[kernel_number]->description, time_gram_matrix(gram, false, 1, v_vectors, u_vectors, gram_matrix, vectors_count, gram_experiments_count), gram_elements);
+	}
+	// The symmetric product with the fastest kernel
+	const kernel_info* symmetric_kernel = kernel_registry_best(kernel_registry_operation_vector3d_gram_matrix, sizeof(double));
+	if (symmetric_kernel != NULL) {
+		char symmetric_method_name[64];
+		snprintf(symmetric_method_name, sizeof(symmetric_method_name), "%s symmetric", symmetric_kernel->description);
+		report_timings(symmetric_method_name, time_gram_matrix(reinterpret_cast<vector3d_gram_matrix_function>(symmetric_kernel->function), true, 1, v_vectors, u_vectors, gram_matrix, vectors_count, gram_experiments_count), gram_elements);
+	}
+	const kernel_info* gram_naive = kernel_registry_find("vector3d_gram_matrix_naive");
+	if (gram_naive != NULL) {
+		report_timings("Naive + all threads", time_gram_matrix(reinterpret_cast<vector3d_gram_matrix_function>(gram_naive->function), false, 0, v_vectors, u_vectors, gram_matrix, vectors_count, gram_experiments_count), gram_elements);
+	}
+
+	free_benchmark_array(gram_matrix);
+
+	begin_section("Matrix-Vector");
+	printf("Matrix-Vector Method\tCPE\tTransposed CPE\n");
+
+	// A matrix of matvec_rows x vectors_count elements
+	const size_t matvec_rows = 64;
+	const size_t matvec_experiments_count = max(experiments_count / 100, 1);
+	double *matvec_matrix = (double*)allocate_benchmark_array(matvec_rows * vectors_count * sizeof(double));
+	double *matvec_x = (double*)allocate_benchmark_array(vectors_count * sizeof(double));
+	double *matvec_y = (double*)allocate_benchmark_array(vectors_count * sizeof(double));
+
+	kernels_count = find_kernels(kernel_registry_operation_matvec, kernels);
+	for (size_t kernel_number = 0; kernel_number < kernels_count; kernel_number++) {
+		const kernel_info* transposed_kernel = find_matching_kernel(kernel_registry_operation_matvec_transposed, kernels[kernel_number]);
+		if (transposed_kernel != NULL) {
+			test_matvec(kernels[kernel_number]->description,
+				reinterpret_cast<matvec_function>(kernels[kernel_number]->function), reinterpret_cast<matvec_function>(transposed_kernel->function),
+				matvec_matrix, matvec_rows, vectors_count, matvec_x, matvec_y, matvec_experiments_count);
+		}
+	}
+
+	free_benchmark_array(matvec_matrix);
+	free_benchmark_array(matvec_x);
+	free_benchmark_array(matvec_y);
+
+	begin_section("Batched GEMM");
+	printf("Batched GEMM Method\t3x3 CPM\t4x4 CPM\t8x8 CPM\n");
+
+	// vectors_count independent products of matrices of up to 8x8 elements. CPM = cycles per matrix product.
+	const size_t matmul_elements = vectors_count * 8 * 8;
+	const size_t matmul_experiments_count = max(experiments_count / 100, 1);
+	double *a_matrices = (double*)allocate_benchmark_array(matmul_elements * sizeof(double));
+	double *b_matrices = (double*)allocate_benchmark_array(matmul_elements * sizeof(double));
+	double *c_matrices = (double*)allocate_benchmark_array(matmul_elements * sizeof(double));
+
+	kernels_count = find_kernels(kernel_registry_operation_batched_matmul_3x3, kernels);
+	for (size_t kernel_number = 0; kernel_number < kernels_count; kernel_number++) {
+		const kernel_info* matmul_4x4_kernel = find_matching_kernel(kernel_registry_operation_batched_matmul_4x4, kernels[kernel_number]);
+		const kernel_info* matmul_8x8_kernel = find_matching_kernel(kernel_registry_operation_batched_matmul_8x8, kernels[kernel_number]);
+		if ((matmul_4x4_kernel != NULL) && (matmul_8x8_kernel != NULL)) {
+			test_batched_matmul(kernels[kernel_number]->description,
+				reinterpret_cast<batched_matmul_function>(kernels[kernel_number]->function),
+				reinterpret_cast<batched_matmul_function>(matmul_4x4_kernel->function),
+				reinterpret_cast<batched_matmul_function>(matmul_8x8_kernel->function),
+				a_matrices, b_matrices, c_matrices, vectors_count, matmul_experiments_count);
+		}
+	}
+
+	free_benchmark_array(a_matrices);
+	free_benchmark_array(b_matrices);
+	free_benchmark_array(c_matrices);
+
+	begin_section("Mixed Precision");
+	printf("Mixed Precision Method\tAligned CPE\n");
+
+	kernels_count = find_kernels(kernel_registry_operation_vector3d_dot_products_f32, kernels);
+	for (size_t kernel_number = 0; kernel_number < kernels_count; kernel_number++) {
+		const vector3d_dot_products_f32_function vector3d_dot_products_f32 = reinterpret_cast<vector3d_dot_products_f32_function>(kernels[kernel_number]->function);
+		report_timings(kernels[kernel_number]->description, time_mixed_dot_product<float>(vector3d_dot_products_f32, (const float*)v_vectors, (const float*)u_vectors, dp_array, vectors_count, experiments_count), vectors_count);
+	}
+	kernels_count = find_kernels(kernel_registry_operation_vector3d_dot_products_f16, kernels);
+	for (size_t kernel_number = 0; kernel_number < kernels_count; kernel_number++) {
+		const vector3d_dot_products_f16_function vector3d_dot_products_f16 = reinterpret_cast<vector3d_dot_products_f16_function>(kernels[kernel_number]->function);
+		report_timings(kernels[kernel_number]->description, time_mixed_dot_product<uint16_t>(vector3d_dot_products_f16, (const uint16_t*)v_vectors, (const uint16_t*)u_vectors, dp_array, vectors_count, experiments_count), vectors_count);
+	}
+
+	begin_section("Typed");
+	printf("Typed Method\tAligned CPE\n");
+
+	test_typed_kernels<float>(kernel_registry_operation_typed_vector3d_dot_products_f32, v_vectors, u_vectors, dp_array, vectors_count, experiments_count);
+	test_typed_kernels<int32_t>(kernel_registry_operation_typed_vector3d_dot_products_i32, v_vectors, u_vectors, dp_array, vectors_count, experiments_count);
+	test_typed_kernels<int64_t>(kernel_registry_operation_typed_vector3d_dot_products_i64, v_vectors, u_vectors, dp_array, vectors_count, experiments_count);
+	test_typed_kernels<bfloat16>(kernel_registry_operation_typed_vector3d_dot_products_bf16, v_vectors, u_vectors, dp_array, vectors_count, experiments_count);
+
+	begin_section("N-D");
+	printf("N-D Method\tAligned CPE\n");
+
+	double *vnd_vectors = (double*)allocate_benchmark_array(vectors_count * max_vectornd_dimension * sizeof(double));
+	double *und_vectors = (double*)allocate_benchmark_array(vectors_count * max_vectornd_dimension * sizeof(double));
+
+	kernels_count = find_kernels(kernel_registry_operation_vectornd_dot_products, kernels);
+	for (size_t kernel_number = 0; kernel_number < kernels_count; kernel_number++) {
+		const vectornd_dot_products_function vectornd_dot_products = reinterpret_cast<vectornd_dot_products_function>(kernels[kernel_number]->function);
+		test_vectornd_dot_products(kernels[kernel_number]->description, vectornd_dot_products, vnd_vectors, und_vectors, dp_array, vectors_count, experiments_count);
+	}
+
+	free_benchmark_array(vnd_vectors);
+	free_benchmark_array(und_vectors);
+
+	begin_section("Placement");
+	printf("Method\tCause\tPlacements\tBest CPE\tWorst CPE\tWorst offsets\n");
+
+	char *v_buffer = (char*)allocate_benchmark_array(vectors_count * components_per_vector * sizeof(double) + page_size);
+	char *u_buffer = (char*)allocate_benchmark_array(vectors_count * components_per_vector * sizeof(double) + page_size);
+	char *dp_buffer = (char*)allocate_benchmark_array(vectors_count * sizeof(double) + page_size);
+	const size_t placement_experiments_count = max(experiments_count / 1000, 1);
+
+	kernels_count = find_kernels(kernel_registry_operation_vector3d_dot_products, kernels);
+	for (size_t kernel_number = 0; kernel_number < kernels_count; kernel_number++) {
+		// Placements are classified by the SIMD vectors of the kernel, which only hand-written kernels define
+		if (kernels[kernel_number]->isa != kernel_registry_isa_compiler) {
+			const vector3d_dot_products_function vector3d_dot_products = reinterpret_cast<vector3d_dot_products_function>(kernels[kernel_number]->function);
+			test_dot_product_placements(kernels[kernel_number]->description, vector3d_dot_products, kernels[kernel_number]->vectorWidth * sizeof(double), v_buffer, u_buffer, dp_buffer, vectors_count, placement_experiments_count);
+		}
+	}
+
+	free_benchmark_array(v_buffer);
+	free_benchmark_array(u_buffer);
+	free_benchmark_array(dp_buffer);
+
+	free_benchmark_array(v_vectors);
+	free_benchmark_array(u_vectors);
+	free_benchmark_array(dp_array);	
+}
+
+// Streaming benchmark: arrays in temporary files, which are evicted from the page cache before every run
+static const size_t stream_vectors_count = 4 * 1024 * 1024;
+static const size_t stream_chunk_length = 256 * 1024;
+
+// Creates an unlinked temporary file in $TMPDIR (or the current directory) with the contents of the array
+static int create_stream_file(const double* array, size_t array_size) {
+	const char* directory = getenv("TMPDIR");
+	char path[4096];
+	snprintf(path, sizeof(path), "%s/cse6230-stream-XXXXXX", (directory != NULL) ? directory : ".");
+	const int file = mkstemp(path);
+	if (file < 0) {
+		return -1;
+	}
+	unlink(path);
+	const size_t size = array_size * sizeof(double);
+	if ((array != NULL) && (pwrite(file, array, size, 0) != ssize_t(size))) {
+		close(file);
+		return -1;
+	}
+	return file;
+}
+
+static void evict_stream_file(int file) {
+	fdatasync(file);
+	posix_fadvise(file, 0, 0, POSIX_FADV_DONTNEED);
+}
+
+static double seconds_since(std::chrono::steady_clock::time_point start_time) {
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+}
+
+// Reads and processes the chunks one after another, without overlapping storage and compute
+static bool serial_vector3d_dot_products(int v_file, int u_file, int dp_file, size_t vectors_count, vector3d_dot_products_function vector3d_dot_products, double* v_chunk, double* u_chunk, double* dp_chunk) {
+	for (size_t chunk_start = 0; chunk_start < vectors_count; chunk_start += stream_chunk_length) {
+		const size_t chunk_length = min(vectors_count - chunk_start, stream_chunk_length);
+		const size_t vectors_size = chunk_length * 3 * sizeof(double);
+		const off_t vectors_offset = off_t(chunk_start * 3 * sizeof(double));
+		if ((pread(v_file, v_chunk, vectors_size, vectors_offset) != ssize_t(vectors_size)) || (pread(u_file, u_chunk, vectors_size, vectors_offset) != ssize_t(vectors_size))) {
+			return false;
+		}
+		vector3d_dot_products(v_chunk, u_chunk, dp_chunk, chunk_length);
+		if (pwrite(dp_file, dp_chunk, chunk_length * sizeof(double), off_t(chunk_start * sizeof(double))) != ssize_t(chunk_length * sizeof(double))) {
+			return false;
+		}
+	}
+	return true;
+}
+
+static void run_stream_benchmark() {
+	// The chunks are not aligned beyond their elements
+	const vector3d_dot_products_function vector3d_dot_products = reinterpret_cast<vector3d_dot_products_function>(kernel_registry_best(kernel_registry_operation_vector3d_dot_products, sizeof(double))->function);
+
+	const size_t components_count = stream_vectors_count * 3;
+	double* v_array = static_cast<double*>(malloc(components_count * sizeof(double)));
+	double* u_array = static_cast<double*>(malloc(components_count * sizeof(double)));
+	double* chunks = static_cast<double*>(malloc(7 * stream_chunk_length * sizeof(double)));
+	if ((v_array == NULL) || (u_array == NULL) || (chunks == NULL)) {
+		fprintf(stderr, "Failed to allocate memory for the streaming benchmark\n");
+		free(v_array);
+		free(u_array);
+		free(chunks);
+		return;
+	}
+	for (size_t i = 0; i < components_count; i++) {
+		v_array[i] = double(rand()) / double(RAND_MAX);
+		u_array[i] = double(rand()) / double(RAND_MAX);
+	}
+
+	const int v_file = create_stream_file(v_array, components_count);
+	const int u_file = create_stream_file(u_array, components_count);
+	const int dp_file = create_stream_file(NULL, 0);
+	if ((v_file < 0) || (u_file < 0) || (dp_file < 0)) {
+		fprintf(stderr, "Failed to create temporary files for the streaming benchmark\n");
+	} else {
+		// Bytes read and written by the kernel
+		const double bytes = double(7 * stream_vectors_count * sizeof(double));
+		printf("%20s\t%s\n", "Streaming Method", "GB/s");
+
+		evict_stream_file(v_file);
+		evict_stream_file(u_file);
+		std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+		bool succeeded = serial_vector3d_dot_products(v_file, u_file, dp_file, stream_vectors_count, vector3d_dot_products,
+			chunks, chunks + 3 * stream_chunk_length, chunks + 6 * stream_chunk_length);
+		printf("%20s\t%2.2lf\n", "Serial", succeeded ? bytes / seconds_since(start_time) * 1.0e-9 : 0.0);
+
+		evict_stream_file(v_file);
+		evict_stream_file(u_file);
+		evict_stream_file(dp_file);
+		start_time = std::chrono::steady_clock::now();
+		succeeded = stream_vector3d_dot_products(v_file, u_file, dp_file, stream_vectors_count, vector3d_dot_products, stream_chunk_length, NULL);
+		printf("%20s\t%2.2lf\n", "Streamed", succeeded ? bytes / seconds_since(start_time) * 1.0e-9 : 0.0);
+	}
+
+	if (v_file >= 0) {
+		close(v_file);
+	}
+	if (u_file >= 0) {
+		close(u_file);
+	}
+	if (dp_file >= 0) {
+		close(dp_file);
+	}
+	free(v_array);
+	free(u_array);
+	free(chunks);
+}
+
+// Chain benchmark: max(dot(v, u) + b) on arrays which are much larger than the caches
+static const size_t chain_vectors_count = 4 * 1024 * 1024;
+static const size_t chain_repetitions = 10;
+
+// Runs the kernels of the chain one after another over the whole arrays, with a full-size intermediate array
+static double unfused_chain(vector3d_dot_products_function vector3d_dot_products, const double* v_array, const double* u_array, const double* b_array, double* dp_array) {
+	double max_value;
+	vector3d_dot_products(v_array, u_array, dp_array, chain_vectors_count);
+	chain_accumulate_naive(b_array, dp_array, chain_vectors_count);
+	chain_max_naive(dp_array, &max_value, chain_vectors_count);
+	return max_value;
+}
+
+static void run_chain_benchmark(size_t threads_count) {
+	// The chain passes slices of the arrays which are not aligned beyond their elements
+	const vector3d_dot_products_function vector3d_dot_products = reinterpret_cast<vector3d_dot_products_function>(kernel_registry_best(kernel_registry_operation_vector3d_dot_products, sizeof(double))->function);
+
+	double* v_array = allocate_vector_array(chain_vectors_count * 3, 0);
+	double* u_array = allocate_vector_array(chain_vectors_count * 3, 1);
+	double* b_array = allocate_vector_array(chain_vectors_count, 2);
+	double* dp_array = allocate_vector_array(chain_vectors_count, 3);
+	kernel_chain* chain = kernel_chain_create(chain_vectors_count);
+	chain_pool* pool = chain_pool_create(threads_count);
+	if ((v_array == NULL) || (u_array == NULL) || (b_array == NULL) || (dp_array == NULL) || (chain == NULL) || (pool == NULL)) {
+		fprintf(stderr, "Failed to allocate memory for the chain benchmark\n");
+	} else {
+		for (size_t i = 0; i < chain_vectors_count * 3; i++) {
+			v_array[i] = double(rand()) / double(RAND_MAX);
+			u_array[i] = double(rand()) / double(RAND_MAX);
+		}
+		for (size_t i = 0; i < chain_vectors_count; i++) {
+			b_array[i] = double(rand()) / double(RAND_MAX);
+		}
+		double chain_max = 0.0;
+		const chain_array dp = kernel_chain_temporary(chain);
+		kernel_chain_map(chain, vector3d_dot_products, kernel_chain_input(chain, v_array, 3), kernel_chain_input(chain, u_array, 3), dp);
+		kernel_chain_accumulate(chain, &chain_accumulate_naive, kernel_chain_input(chain, b_array, 1), dp);
+		kernel_chain_max(chain, &chain_max_naive, dp, &chain_max);
+
+		// Bytes of the inputs read by the chain
+		const double chain_bytes = double(7 * chain_vectors_count * sizeof(double));
+		printf("%20s\t%s\n", "Chain Method", "GB/s");
+
+		const double expected_max = unfused_chain(vector3d_dot_products, v_array, u_array, b_array, dp_array);
+		double best_seconds = 0.0;
+		bool succeeded = true;
+		for (size_t repetition = 0; repetition < chain_repetitions; repetition++) {
+			const std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+			succeeded = succeeded && (unfused_chain(vector3d_dot_products, v_array, u_array, b_array, dp_array) == expected_max);
+			const double seconds = seconds_since(start_time);
+			if ((repetition == 0) || (seconds < best_seconds)) {
+				best_seconds = seconds;
+			}
+		}
+		printf("%20s\t%2.2lf\n", "Unfused", succeeded ? chain_bytes / best_seconds * 1.0e-9 : 0.0);
+
+		for (size_t pool_number = 0; pool_number < 2; pool_number++) {
+			chain_pool* run_pool = (pool_number == 0) ? NULL : pool;
+			succeeded = true;
+			for (size_t repetition = 0; repetition < chain_repetitions; repetition++) {
+				chain_max = 0.0;
+				const std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+				succeeded = succeeded && kernel_chain_run(chain, run_pool) && (chain_max == expected_max);
+				const double seconds = seconds_since(start_time);
+				if ((repetition == 0) || (seconds < best_seconds)) {
+					best_seconds = seconds;
+				}
+			}
+			printf("%20s\t%2.2lf\n", (pool_number == 0) ? "Chain, 1 thread" : "Chain, pool", succeeded ? chain_bytes / best_seconds * 1.0e-9 : 0.0);
+		}
+	}
+
+	chain_pool_destroy(pool);
+	kernel_chain_destroy(chain);
+	free_vector_array(v_array);
+	free_vector_array(u_array);
+	free_vector_array(b_array);
+	free_vector_array(dp_array);
+}
+
+// Outputs of every thread in the scaling benchmark: 1M doubles in each input array
+static const size_t scaling_outputs_per_thread = 1024 * 1024 / 3;
+
+// Runs the thread-scaling benchmark with the naive and the fastest vector3d_dot_products kernel
+static void run_dot_products_scaling_benchmark(size_t threads_count) {
+	const kernel_info* registry_kernels[2] = { kernel_registry_find("vector3d_dot_products_naive"), kernel_registry_best(kernel_registry_operation_vector3d_dot_products, sizeof(double)) };
+	scaling_kernel scaling_kernels[2];
+	size_t kernels_count = 0;
+	for (size_t kernel_number = 0; kernel_number < 2; kernel_number++) {
+		if ((registry_kernels[kernel_number] != NULL) && ((kernel_number == 0) || (registry_kernels[1] != registry_kernels[0]))) {
+			const scaling_kernel kernel = { registry_kernels[kernel_number]->name, reinterpret_cast<streaming_kernel_function>(registry_kernels[kernel_number]->function), 3 };
+			scaling_kernels[kernels_count++] = kernel;
+		}
+	}
+	run_scaling_benchmark(scaling_kernels, kernels_count, threads_count, scaling_outputs_per_thread);
+}
+
+// Usage: main [--save FILE] [--baseline FILE] [--threads N] [hot] [cold] [first-touch] [scaling] [stream] [chain] [kernels] [telemetry]
+// Runs all benchmarks once for every listed cache mode, or only in the hot mode without modes.
+// Then prints statistics of every kernel, compared with the results in the baseline file (if any),
+// and saves them to the results file (if any). With scaling, runs the thread-scaling benchmark on up to N threads
+// (all CPUs by default), with stream runs the streaming benchmark, and with chain runs the kernel chain benchmark with
+// a pool of N threads. With kernels, lists the kernels in the registry of libcse6230 and whether this processor
+// supports them. Cache modes then run only when they are listed. With telemetry, records the calls to the dispatcher
+// during the benchmarks and prints the histograms at the end; they are also printed to stderr on SIGUSR1.
+int main(int argc, char** argv) {
+	const size_t experiments_count = 1000000;
+	const char* save_path = NULL;
+	static benchmark_result baseline_results[max_results_count];
+	size_t baseline_results_count = 0;
+	cache_mode modes[cache_mode_count];
+	size_t modes_count = 0;
+	bool run_scaling = false;
+	bool run_stream = false;
+	bool run_chain = false;
+	bool list_kernels = false;
+	bool record_telemetry = false;
+	size_t scaling_threads = 0;
+	for (int argument_number = 1; argument_number < argc; argument_number++) {
+		if (strcmp(argv[argument_number], "--save") == 0 && argument_number + 1 < argc) {
+			save_path = argv[++argument_number];
+		} else if (strcmp(argv[argument_number], "--baseline") == 0 && argument_number + 1 < argc) {
+			const char* baseline_path = argv[++argument_number];
+			baseline_results_count = load_benchmark_results(baseline_path, baseline_results, max_results_count);
+			if (baseline_results_count == 0) {
+				fprintf(stderr, "No results loaded from baseline file \"%s\"\n", baseline_path);
+				return 1;
+			}
+		} else if (strcmp(argv[argument_number], "--threads") == 0 && argument_number + 1 < argc) {
+			scaling_threads = strtoul(argv[++argument_number], NULL, 10);
+		} else if (strcmp(argv[argument_number], "scaling") == 0) {
+			run_scaling = true;
+		} else if (strcmp(argv[argument_number], "stream") == 0) {
+			run_stream = true;
+		} else if (strcmp(argv[argument_number], "chain") == 0) {
+			run_chain = true;
+		} else if (strcmp(argv[argument_number], "kernels") == 0) {
+			list_kernels = true;
+		} else if (strcmp(argv[argument_number], "telemetry") == 0) {
+			record_telemetry = true;
+		} else {
+			size_t mode = 0;
+			while (mode < cache_mode_count && strcmp(argv[argument_number], cache_mode_names[mode]) != 0) {
+				mode += 1;
+			}
+			if (mode == cache_mode_count) {
+				fprintf(stderr, "Unknown argument \"%s\": expected --save FILE, --baseline FILE, --threads N, hot, cold, first-touch, scaling, stream, chain, kernels or telemetry\n", argv[argument_number]);
+				return 1;
+			}
+			if (modes_count < cache_mode_count) {
+				modes[modes_count++] = cache_mode(mode);
+			}
+		}
+	}
+	if (list_kernels) {
+		kernel_registry_print(stdout);
+	}
+	if (record_telemetry) {
+		kernel_telemetry_enable(true);
+		if (!kernel_telemetry_dump_on_signal(SIGUSR1, STDERR_FILENO)) {
+			fprintf(stderr, "Failed to install the telemetry signal handler\n");
+		}
+	}
+	if (modes_count == 0 && !run_scaling && !run_stream && !run_chain && !list_kernels) {
+		modes[modes_count++] = cache_mode_hot;
+	}
+
+	// Wrong results fail the run, but do not stop the benchmarks
+	const size_t mismatches_count = check_kernels();
+
+	for (size_t mode_number = 0; mode_number < modes_count; mode_number++) {
+		const cache_mode mode = modes[mode_number];
+		run_benchmarks(mode, experiments_count / cache_mode_experiments_divisor[mode]);
+	}
+
+	if (run_scaling) {
+		run_dot_products_scaling_benchmark(scaling_threads);
+	}
+	if (run_stream) {
+		run_stream_benchmark();
+	}
+	if (run_chain) {
+		run_chain_benchmark(scaling_threads);
+	}
+
+	if (record_telemetry) {
+		kernel_telemetry_enable(false);
+		printf("Telemetry\tHistogram\tBucket\tCount\n");
+		fflush(stdout);
+		kernel_telemetry_dump(STDOUT_FILENO);
+	}
+
+	if (results_count != 0) {
+		print_statistics(baseline_results, baseline_results_count);
+	}
+	if (save_path != NULL && !save_benchmark_results(save_path, results, results_count)) {
+		fprintf(stderr, "Failed to save results to \"%s\"\n", save_path);
+		return 1;
+	}
+
+	if (mismatches_count != 0) {
+		fprintf(stderr, "%zu results differ from the naive kernels\n", mismatches_count);
+		return 1;
+	}
+	return 0;
 }
\ No newline at end of file
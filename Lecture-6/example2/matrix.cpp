@@ -0,0 +1,403 @@
+/******************************************************************************\
+ *                                                                            *
+ * Copyright (c) 2012 Marat Dukhan                                            *
+ *                                                                            *
+ * This software is provided 'as-is', without any express or implied          *
+ * warranty. In no event will the authors be held liable for any damages      *
+ * arising from the use of this software.                                     *
+ *                                                                            *
+ * Permission is granted to anyone to use this software for any purpose,      *
+ * including commercial applications, and to alter it and redistribute it     *
+ * freely, subject to the following restrictions:                             *
+ *                                                                            *
+ * 1. The origin of this software must not be misrepresented; you must not    *
+ * claim that you wrote the original software. If you use this software       *
+ * in a product, an acknowledgment in the product documentation would be      *
+ * appreciated but is not required.                                           *
+ *                                                                            *
+ * 2. Altered source versions must be plainly marked as such, and must not be *
+ * misrepresented as being the original software.                             *
+ *                                                                            *
+ * 3. This notice may not be removed or altered from any source               *
+ * distribution.                                                              *
+ *                                                                            *
+\******************************************************************************/
+
+#include <matrix.hpp>
+#include <typed.hpp>
+#if defined(CSE6230_SSE2_INTRINSICS_SUPPORTED) || defined(CSE6230_AVX_INTRINSICS_SUPPORTED)
+	#if defined(__GNUC__)
+		#include <x86intrin.h>
+	#elif defined(_MSC_VER)
+		#include <intrin.h>
+	#else
+		#error Intrinsics headers are not included: unknown compiler
+	#endif
+#endif
+
+// Operations on SIMD vectors of doubles for matrix kernels. Each specialization provides:
+//   load_partial, store_partial: load (zeroing the other elements) and store the first count < width elements
+//   multiply_add: a * b + c, fused where the instruction set has FMA
+//   reduce_add: the sum of the elements of a vector
+template <typename ISA>
+struct matrix_pd;
+
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+template <>
+struct matrix_pd<isa_sse2> {
+	typedef __m128d vector;
+	static const size_t width = 2;
+
+	static vector zero() { return _mm_setzero_pd(); }
+	static vector load(const double* pointer) { return _mm_loadu_pd(pointer); }
+	static vector load_partial(const double* pointer, size_t) { return _mm_load_sd(pointer); }
+	static void store(double* pointer, vector a) { _mm_storeu_pd(pointer, a); }
+	static void store_partial(double* pointer, vector a, size_t) { _mm_store_sd(pointer, a); }
+	static vector broadcast(double value) { return _mm_set1_pd(value); }
+	static vector add(vector a, vector b) { return _mm_add_pd(a, b); }
+	static vector mul(vector a, vector b) { return _mm_mul_pd(a, b); }
+	static vector multiply_add(vector a, vector b, vector c) { return _mm_add_pd(_mm_mul_pd(a, b), c); }
+	static double reduce_add(vector a) { return _mm_cvtsd_f64(_mm_add_sd(a, _mm_unpackhi_pd(a, a))); }
+};
+#endif
+
+#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+// Masks for maskload and maskstore of the first 0...3 elements
+static const int64_t matrix_avx_masks[4][4] = {
+	{ 0, 0, 0, 0 },
+	{ -1, 0, 0, 0 },
+	{ -1, -1, 0, 0 },
+	{ -1, -1, -1, 0 }
+};
+
+template <>
+struct matrix_pd<isa_avx> {
+	typedef __m256d vector;
+	static const size_t width = 4;
+
+	static __m256i mask(size_t count) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(matrix_avx_masks[count])); }
+	static vector zero() { return _mm256_setzero_pd(); }
+	static vector load(const double* pointer) { return _mm256_loadu_pd(pointer); }
+	static vector load_partial(const double* pointer, size_t count) { return _mm256_maskload_pd(pointer, mask(count)); }
+	static void store(double* pointer, vector a) { _mm256_storeu_pd(pointer, a); }
+	static void store_partial(double* pointer, vector a, size_t count) { _mm256_maskstore_pd(pointer, mask(count), a); }
+	static vector broadcast(double value) { return _mm256_set1_pd(value); }
+	static vector add(vector a, vector b) { return _mm256_add_pd(a, b); }
+	static vector mul(vector a, vector b) { return _mm256_mul_pd(a, b); }
+	static vector multiply_add(vector a, vector b, vector c) { return _mm256_add_pd(_mm256_mul_pd(a, b), c); }
+	static double reduce_add(vector a) { return matrix_pd<isa_sse2>::reduce_add(_mm_add_pd(_mm256_castpd256_pd128(a), _mm256_extractf128_pd(a, 1))); }
+};
+#endif
+
+#if defined(CSE6230_AVX2_INTRINSICS_SUPPORTED) && defined(CSE6230_FMA3_INTRINSICS_SUPPORTED)
+template <>
+struct matrix_pd<isa_avx2> : matrix_pd<isa_avx> {
+	static vector multiply_add(vector a, vector b, vector c) { return _mm256_fmadd_pd(a, b, c); }
+};
+#endif
+
+#ifdef CSE6230_AVX512F_INTRINSICS_SUPPORTED
+template <>
+struct matrix_pd<isa_avx512f> {
+	typedef __m512d vector;
+	static const size_t width = 8;
+
+	static __mmask8 mask(size_t count) { return __mmask8((1u << count) - 1u); }
+	static vector zero() { return _mm512_setzero_pd(); }
+	static vector load(const double* pointer) { return _mm512_loadu_pd(pointer); }
+	static vector load_partial(const double* pointer, size_t count) { return _mm512_maskz_loadu_pd(mask(count), pointer); }
+	static void store(double* pointer, vector a) { _mm512_storeu_pd(pointer, a); }
+	static void store_partial(double* pointer, vector a, size_t count) { _mm512_mask_storeu_pd(pointer, mask(count), a); }
+	static vector broadcast(double value) { return _mm512_set1_pd(value); }
+	static vector add(vector a, vector b) { return _mm512_add_pd(a, b); }
+	static vector mul(vector a, vector b) { return _mm512_mul_pd(a, b); }
+	static vector multiply_add(vector a, vector b, vector c) { return _mm512_fmadd_pd(a, b, c); }
+	static double reduce_add(vector a) { return _mm512_reduce_add_pd(a); }
+};
+#endif
+
+// Rows of the register block in matrix-vector products
+static const size_t matvec_block_rows = 4;
+
+// Computes Rows elements of y with two accumulators per row
+template <typename ISA, size_t Rows>
+static void matvec_rows(const double* matrixPointer, size_t columns, size_t matrixStride, const double* xPointer, double* yPointer) {
+	typedef matrix_pd<ISA> simd;
+	typename simd::vector sumsX[Rows], sumsY[Rows];
+	for (size_t row = 0; row < Rows; row++) {
+		sumsX[row] = simd::zero();
+		sumsY[row] = simd::zero();
+	}
+	size_t column = 0;
+	for (; column + 2 * simd::width <= columns; column += 2 * simd::width) {
+		const typename simd::vector xX = simd::load(xPointer + column);
+		const typename simd::vector xY = simd::load(xPointer + column + simd::width);
+		for (size_t row = 0; row < Rows; row++) {
+			const double* rowPointer = matrixPointer + row * matrixStride + column;
+			sumsX[row] = simd::multiply_add(simd::load(rowPointer), xX, sumsX[row]);
+			sumsY[row] = simd::multiply_add(simd::load(rowPointer + simd::width), xY, sumsY[row]);
+		}
+	}
+	for (size_t row = 0; row < Rows; row++) {
+		double sum = simd::reduce_add(simd::add(sumsX[row], sumsY[row]));
+		// Process remaining elements (if any)
+		for (size_t remainingColumn = column; remainingColumn < columns; remainingColumn++) {
+			sum += matrixPointer[row * matrixStride + remainingColumn] * xPointer[remainingColumn];
+		}
+		yPointer[row] = sum;
+	}
+}
+
+template <typename ISA>
+static void matvec(const double* matrixPointer, size_t rows, size_t columns, size_t matrixStride, const double* xPointer, double* yPointer) {
+	size_t row = 0;
+	for (; row + matvec_block_rows <= rows; row += matvec_block_rows) {
+		matvec_rows<ISA, matvec_block_rows>(matrixPointer + row * matrixStride, columns, matrixStride, xPointer, yPointer + row);
+	}
+	// Process remaining rows (if any)
+	for (; row < rows; row++) {
+		matvec_rows<ISA, 1>(matrixPointer + row * matrixStride, columns, matrixStride, xPointer, yPointer + row);
+	}
+}
+
+// Adds Rows rows of the matrix scaled by the elements of x to y
+template <typename ISA, size_t Rows>
+static void matvec_transposed_rows(const double* matrixPointer, size_t columns, size_t matrixStride, const double* xPointer, double* yPointer) {
+	typedef matrix_pd<ISA> simd;
+	typename simd::vector x[Rows];
+	for (size_t row = 0; row < Rows; row++) {
+		x[row] = simd::broadcast(xPointer[row]);
+	}
+	size_t column = 0;
+	for (; column + simd::width <= columns; column += simd::width) {
+		typename simd::vector y = simd::load(yPointer + column);
+		for (size_t row = 0; row < Rows; row++) {
+			y = simd::multiply_add(simd::load(matrixPointer + row * matrixStride + column), x[row], y);
+		}
+		simd::store(yPointer + column, y);
+	}
+	// Process remaining elements (if any)
+	for (; column < columns; column++) {
+		double y = yPointer[column];
+		for (size_t row = 0; row < Rows; row++) {
+			y += matrixPointer[row * matrixStride + column] * xPointer[row];
+		}
+		yPointer[column] = y;
+	}
+}
+
+template <typename ISA>
+static void matvec_transposed(const double* matrixPointer, size_t rows, size_t columns, size_t matrixStride, const double* xPointer, double* yPointer) {
+	for (size_t column = 0; column < columns; column++) {
+		yPointer[column] = 0.0;
+	}
+	size_t row = 0;
+	for (; row + matvec_block_rows <= rows; row += matvec_block_rows) {
+		matvec_transposed_rows<ISA, matvec_block_rows>(matrixPointer + row * matrixStride, columns, matrixStride, xPointer + row, yPointer);
+	}
+	// Process remaining rows (if any)
+	for (; row < rows; row++) {
+		matvec_transposed_rows<ISA, 1>(matrixPointer + row * matrixStride, columns, matrixStride, xPointer + row, yPointer);
+	}
+}
+
+// A row of an N x N matrix in SIMD vectors, the last of which may be partial
+template <typename ISA, size_t N>
+struct matrix_row {
+	typedef matrix_pd<ISA> simd;
+	static const size_t full_vectors = N / simd::width;
+	static const size_t tail = N % simd::width;
+	static const size_t vectors = full_vectors + (tail != 0 ? 1 : 0);
+
+	typename simd::vector elements[vectors];
+
+	void load(const double* pointer) {
+		for (size_t i = 0; i < full_vectors; i++) {
+			elements[i] = simd::load(pointer + i * simd::width);
+		}
+		if (tail != 0) {
+			elements[full_vectors] = simd::load_partial(pointer + full_vectors * simd::width, tail);
+		}
+	}
+
+	void store(double* pointer) const {
+		for (size_t i = 0; i < full_vectors; i++) {
+			simd::store(pointer + i * simd::width, elements[i]);
+		}
+		if (tail != 0) {
+			simd::store_partial(pointer + full_vectors * simd::width, elements[full_vectors], tail);
+		}
+	}
+};
+
+template <typename ISA, size_t N>
+static void batched_matmul(const double* aPointer, const double* bPointer, double* cPointer, size_t matricesCount) {
+	typedef matrix_pd<ISA> simd;
+	typedef matrix_row<ISA, N> row;
+	for (; matricesCount != 0; matricesCount -= 1) {
+		row b[N];
+		for (size_t k = 0; k < N; k++) {
+			b[k].load(bPointer + k * N);
+		}
+		for (size_t i = 0; i < N; i++) {
+			row c;
+			const typename simd::vector a0 = simd::broadcast(aPointer[i * N]);
+			for (size_t j = 0; j < row::vectors; j++) {
+				c.elements[j] = simd::mul(a0, b[0].elements[j]);
+			}
+			for (size_t k = 1; k < N; k++) {
+				const typename simd::vector a = simd::broadcast(aPointer[i * N + k]);
+				for (size_t j = 0; j < row::vectors; j++) {
+					c.elements[j] = simd::multiply_add(a, b[k].elements[j], c.elements[j]);
+				}
+			}
+			c.store(cPointer + i * N);
+		}
+
+		// Advance pointers to the next matrices
+		aPointer += N * N;
+		bPointer += N * N;
+		cPointer += N * N;
+	}
+}
+
+template <size_t N>
+static void batched_matmul_naive(const double* aPointer, const double* bPointer, double* cPointer, size_t matricesCount) {
+	for (; matricesCount != 0; matricesCount -= 1) {
+		for (size_t i = 0; i < N; i++) {
+			for (size_t j = 0; j < N; j++) {
+				double c = 0.0;
+				for (size_t k = 0; k < N; k++) {
+					c += aPointer[i * N + k] * bPointer[k * N + j];
+				}
+				cPointer[i * N + j] = c;
+			}
+		}
+
+		// Advance pointers to the next matrices
+		aPointer += N * N;
+		bPointer += N * N;
+		cPointer += N * N;
+	}
+}
+
+void matvec_naive(const double *CSE6230_RESTRICT matrixPointer, size_t rows, size_t columns, size_t matrixStride, const double *CSE6230_RESTRICT xPointer, double *CSE6230_RESTRICT yPointer) {
+	for (size_t row = 0; row < rows; row++) {
+		double sum = 0.0;
+		for (size_t column = 0; column < columns; column++) {
+			sum += matrixPointer[row * matrixStride + column] * xPointer[column];
+		}
+		yPointer[row] = sum;
+	}
+}
+
+void matvec_transposed_naive(const double *CSE6230_RESTRICT matrixPointer, size_t rows, size_t columns, size_t matrixStride, const double *CSE6230_RESTRICT xPointer, double *CSE6230_RESTRICT yPointer) {
+	for (size_t column = 0; column < columns; column++) {
+		yPointer[column] = 0.0;
+	}
+	for (size_t row = 0; row < rows; row++) {
+		for (size_t column = 0; column < columns; column++) {
+			yPointer[column] += matrixPointer[row * matrixStride + column] * xPointer[row];
+		}
+	}
+}
+
+void batched_matmul_3x3_naive(const double *CSE6230_RESTRICT aPointer, const double *CSE6230_RESTRICT bPointer, double *CSE6230_RESTRICT cPointer, size_t matricesCount) {
+	batched_matmul_naive<3>(aPointer, bPointer, cPointer, matricesCount);
+}
+
+void batched_matmul_4x4_naive(const double *CSE6230_RESTRICT aPointer, const double *CSE6230_RESTRICT bPointer, double *CSE6230_RESTRICT cPointer, size_t matricesCount) {
+	batched_matmul_naive<4>(aPointer, bPointer, cPointer, matricesCount);
+}
+
+void batched_matmul_8x8_naive(const double *CSE6230_RESTRICT aPointer, const double *CSE6230_RESTRICT bPointer, double *CSE6230_RESTRICT cPointer, size_t matricesCount) {
+	batched_matmul_naive<8>(aPointer, bPointer, cPointer, matricesCount);
+}
+
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+void matvec_sse2(const double *CSE6230_RESTRICT matrixPointer, size_t rows, size_t columns, size_t matrixStride, const double *CSE6230_RESTRICT xPointer, double *CSE6230_RESTRICT yPointer) {
+	matvec<isa_sse2>(matrixPointer, rows, columns, matrixStride, xPointer, yPointer);
+}
+
+void matvec_transposed_sse2(const double *CSE6230_RESTRICT matrixPointer, size_t rows, size_t columns, size_t matrixStride, const double *CSE6230_RESTRICT xPointer, double *CSE6230_RESTRICT yPointer) {
+	matvec_transposed<isa_sse2>(matrixPointer, rows, columns, matrixStride, xPointer, yPointer);
+}
+
+void batched_matmul_3x3_sse2(const double *CSE6230_RESTRICT aPointer, const double *CSE6230_RESTRICT bPointer, double *CSE6230_RESTRICT cPointer, size_t matricesCount) {
+	batched_matmul<isa_sse2, 3>(aPointer, bPointer, cPointer, matricesCount);
+}
+
+void batched_matmul_4x4_sse2(const double *CSE6230_RESTRICT aPointer, const double *CSE6230_RESTRICT bPointer, double *CSE6230_RESTRICT cPointer, size_t matricesCount) {
+	batched_matmul<isa_sse2, 4>(aPointer, bPointer, cPointer, matricesCount);
+}
+
+void batched_matmul_8x8_sse2(const double *CSE6230_RESTRICT aPointer, const double *CSE6230_RESTRICT bPointer, double *CSE6230_RESTRICT cPointer, size_t matricesCount) {
+	batched_matmul<isa_sse2, 8>(aPointer, bPointer, cPointer, matricesCount);
+}
+#endif
+
+#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+void matvec_avx(const double *CSE6230_RESTRICT matrixPointer, size_t rows, size_t columns, size_t matrixStride, const double *CSE6230_RESTRICT xPointer, double *CSE6230_RESTRICT yPointer) {
+	matvec<isa_avx>(matrixPointer, rows, columns, matrixStride, xPointer, yPointer);
+}
+
+void matvec_transposed_avx(const double *CSE6230_RESTRICT matrixPointer, size_t rows, size_t columns, size_t matrixStride, const double *CSE6230_RESTRICT xPointer, double *CSE6230_RESTRICT yPointer) {
+	matvec_transposed<isa_avx>(matrixPointer, rows, columns, matrixStride, xPointer, yPointer);
+}
+
+void batched_matmul_3x3_avx(const double *CSE6230_RESTRICT aPointer, const double *CSE6230_RESTRICT bPointer, double *CSE6230_RESTRICT cPointer, size_t matricesCount) {
+	batched_matmul<isa_avx, 3>(aPointer, bPointer, cPointer, matricesCount);
+}
+
+void batched_matmul_4x4_avx(const double *CSE6230_RESTRICT aPointer, const double *CSE6230_RESTRICT bPointer, double *CSE6230_RESTRICT cPointer, size_t matricesCount) {
+	batched_matmul<isa_avx, 4>(aPointer, bPointer, cPointer, matricesCount);
+}
+
+void batched_matmul_8x8_avx(const double *CSE6230_RESTRICT aPointer, const double *CSE6230_RESTRICT bPointer, double *CSE6230_RESTRICT cPointer, size_t matricesCount) {
+	batched_matmul<isa_avx, 8>(aPointer, bPointer, cPointer, matricesCount);
+}
+#endif
+
+#if defined(CSE6230_AVX2_INTRINSICS_SUPPORTED) && defined(CSE6230_FMA3_INTRINSICS_SUPPORTED)
+void matvec_avx2(const double *CSE6230_RESTRICT matrixPointer, size_t rows, size_t columns, size_t matrixStride, const double *CSE6230_RESTRICT xPointer, double *CSE6230_RESTRICT yPointer) {
+	matvec<isa_avx2>(matrixPointer, rows, columns, matrixStride, xPointer, yPointer);
+}
+
+void matvec_transposed_avx2(const double *CSE6230_RESTRICT matrixPointer, size_t rows, size_t columns, size_t matrixStride, const double *CSE6230_RESTRICT xPointer, double *CSE6230_RESTRICT yPointer) {
+	matvec_transposed<isa_avx2>(matrixPointer, rows, columns, matrixStride, xPointer, yPointer);
+}
+
+void batched_matmul_3x3_avx2(const double *CSE6230_RESTRICT aPointer, const double *CSE6230_RESTRICT bPointer, double *CSE6230_RESTRICT cPointer, size_t matricesCount) {
+	batched_matmul<isa_avx2, 3>(aPointer, bPointer, cPointer, matricesCount);
+}
+
+void batched_matmul_4x4_avx2(const double *CSE6230_RESTRICT aPointer, const double *CSE6230_RESTRICT bPointer, double *CSE6230_RESTRICT cPointer, size_t matricesCount) {
+	batched_matmul<isa_avx2, 4>(aPointer, bPointer, cPointer, matricesCount);
+}
+
+void batched_matmul_8x8_avx2(const double *CSE6230_RESTRICT aPointer, const double *CSE6230_RESTRICT bPointer, double *CSE6230_RESTRICT cPointer, size_t matricesCount) {
+	batched_matmul<isa_avx2, 8>(aPointer, bPointer, cPointer, matricesCount);
+}
+#endif
+
+#ifdef CSE6230_AVX512F_INTRINSICS_SUPPORTED
+void matvec_avx512f(const double *CSE6230_RESTRICT matrixPointer, size_t rows, size_t columns, size_t matrixStride, const double *CSE6230_RESTRICT xPointer, double *CSE6230_RESTRICT yPointer) {
+	matvec<isa_avx512f>(matrixPointer, rows, columns, matrixStride, xPointer, yPointer);
+}
+
+void matvec_transposed_avx512f(const double *CSE6230_RESTRICT matrixPointer, size_t rows, size_t columns, size_t matrixStride, const double *CSE6230_RESTRICT xPointer, double *CSE6230_RESTRICT yPointer) {
+	matvec_transposed<isa_avx512f>(matrixPointer, rows, columns, matrixStride, xPointer, yPointer);
+}
+
+void batched_matmul_3x3_avx512f(const double *CSE6230_RESTRICT aPointer, const double *CSE6230_RESTRICT bPointer, double *CSE6230_RESTRICT cPointer, size_t matricesCount) {
+	batched_matmul<isa_avx512f, 3>(aPointer, bPointer, cPointer, matricesCount);
+}
+
+void batched_matmul_4x4_avx512f(const double *CSE6230_RESTRICT aPointer, const double *CSE6230_RESTRICT bPointer, double *CSE6230_RESTRICT cPointer, size_t matricesCount) {
+	batched_matmul<isa_avx512f, 4>(aPointer, bPointer, cPointer, matricesCount);
+}
+
+void batched_matmul_8x8_avx512f(const double *CSE6230_RESTRICT aPointer, const double *CSE6230_RESTRICT bPointer, double *CSE6230_RESTRICT cPointer, size_t matricesCount) {
+	batched_matmul<isa_avx512f, 8>(aPointer, bPointer, cPointer, matricesCount);
+}
+#endif
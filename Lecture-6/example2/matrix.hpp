@@ -0,0 +1,110 @@
+/******************************************************************************\
+ *                                                                            *
+ * Copyright (c) 2012 Marat Dukhan                                            *
+ *                                                                            *
+ * This software is provided 'as-is', without any express or implied          *
+ * warranty. In no event will the authors be held liable for any damages      *
+ * arising from the use of this software.                                     *
+ *                                                                            *
+ * Permission is granted to anyone to use this software for any purpose,      *
+ * including commercial applications, and to alter it and redistribute it     *
+ * freely, subject to the following restrictions:                             *
+ *                                                                            *
+ * 1. The origin of this software must not be misrepresented; you must not    *
+ * claim that you wrote the original software. If you use this software       *
+ * in a product, an acknowledgment in the product documentation would be      *
+ * appreciated but is not required.                                           *
+ *                                                                            *
+ * 2. Altered source versions must be plainly marked as such, and must not be *
+ * misrepresented as being the original software.                             *
+ *                                                                            *
+ * 3. This notice may not be removed or altered from any source               *
+ * distribution.                                                              *
+ *                                                                            *
+\******************************************************************************/
+
+#pragma once
+
+#include <compute.hpp>
+
+// Dense matrix-vector product y = A x of a row-major matrix with rows rows of columns elements, which start matrixStride
+// elements apart. SIMD versions compute 4 rows at an iteration, so each loaded vector of x is used for 4 rows, and keep
+// two accumulators per row to hide the latency of additions. The AVX2 and AVX-512 versions use fused multiply-adds.
+typedef void (*matvec_function)(const double*, size_t, size_t, size_t, const double*, double*);
+
+extern "C" void matvec_naive(const double *CSE6230_RESTRICT matrixPointer, size_t rows, size_t columns, size_t matrixStride, const double *CSE6230_RESTRICT xPointer, double *CSE6230_RESTRICT yPointer);
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+extern "C" void matvec_sse2(const double *CSE6230_RESTRICT matrixPointer, size_t rows, size_t columns, size_t matrixStride, const double *CSE6230_RESTRICT xPointer, double *CSE6230_RESTRICT yPointer);
+#endif
+#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+extern "C" void matvec_avx(const double *CSE6230_RESTRICT matrixPointer, size_t rows, size_t columns, size_t matrixStride, const double *CSE6230_RESTRICT xPointer, double *CSE6230_RESTRICT yPointer);
+#endif
+#if defined(CSE6230_AVX2_INTRINSICS_SUPPORTED) && defined(CSE6230_FMA3_INTRINSICS_SUPPORTED)
+extern "C" void matvec_avx2(const double *CSE6230_RESTRICT matrixPointer, size_t rows, size_t columns, size_t matrixStride, const double *CSE6230_RESTRICT xPointer, double *CSE6230_RESTRICT yPointer);
+#endif
+#ifdef CSE6230_AVX512F_INTRINSICS_SUPPORTED
+extern "C" void matvec_avx512f(const double *CSE6230_RESTRICT matrixPointer, size_t rows, size_t columns, size_t matrixStride, const double *CSE6230_RESTRICT xPointer, double *CSE6230_RESTRICT yPointer);
+#endif
+
+// Transposed matrix-vector product y = A^T x: x has rows elements and y has columns elements. SIMD versions add 4 rows
+// of the matrix scaled by the elements of x to y at an iteration, so y is loaded and stored once per 4 rows.
+extern "C" void matvec_transposed_naive(const double *CSE6230_RESTRICT matrixPointer, size_t rows, size_t columns, size_t matrixStride, const double *CSE6230_RESTRICT xPointer, double *CSE6230_RESTRICT yPointer);
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+extern "C" void matvec_transposed_sse2(const double *CSE6230_RESTRICT matrixPointer, size_t rows, size_t columns, size_t matrixStride, const double *CSE6230_RESTRICT xPointer, double *CSE6230_RESTRICT yPointer);
+#endif
+#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+extern "C" void matvec_transposed_avx(const double *CSE6230_RESTRICT matrixPointer, size_t rows, size_t columns, size_t matrixStride, const double *CSE6230_RESTRICT xPointer, double *CSE6230_RESTRICT yPointer);
+#endif
+#if defined(CSE6230_AVX2_INTRINSICS_SUPPORTED) && defined(CSE6230_FMA3_INTRINSICS_SUPPORTED)
+extern "C" void matvec_transposed_avx2(const double *CSE6230_RESTRICT matrixPointer, size_t rows, size_t columns, size_t matrixStride, const double *CSE6230_RESTRICT xPointer, double *CSE6230_RESTRICT yPointer);
+#endif
+#ifdef CSE6230_AVX512F_INTRINSICS_SUPPORTED
+extern "C" void matvec_transposed_avx512f(const double *CSE6230_RESTRICT matrixPointer, size_t rows, size_t columns, size_t matrixStride, const double *CSE6230_RESTRICT xPointer, double *CSE6230_RESTRICT yPointer);
+#endif
+
+// Products C[i] = A[i] B[i] of many independent row-major N x N matrices, which are stored one after another.
+// SIMD versions keep the rows of B[i] in registers and compute every row of C[i] as a sum of the rows of B[i] scaled by
+// broadcast elements of the row of A[i]. Rows which do not fill whole SIMD vectors are loaded and stored with masks.
+typedef void (*batched_matmul_function)(const double*, const double*, double*, size_t);
+
+extern "C" void batched_matmul_3x3_naive(const double *CSE6230_RESTRICT aPointer, const double *CSE6230_RESTRICT bPointer, double *CSE6230_RESTRICT cPointer, size_t matricesCount);
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+extern "C" void batched_matmul_3x3_sse2(const double *CSE6230_RESTRICT aPointer, const double *CSE6230_RESTRICT bPointer, double *CSE6230_RESTRICT cPointer, size_t matricesCount);
+#endif
+#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+extern "C" void batched_matmul_3x3_avx(const double *CSE6230_RESTRICT aPointer, const double *CSE6230_RESTRICT bPointer, double *CSE6230_RESTRICT cPointer, size_t matricesCount);
+#endif
+#if defined(CSE6230_AVX2_INTRINSICS_SUPPORTED) && defined(CSE6230_FMA3_INTRINSICS_SUPPORTED)
+extern "C" void batched_matmul_3x3_avx2(const double *CSE6230_RESTRICT aPointer, const double *CSE6230_RESTRICT bPointer, double *CSE6230_RESTRICT cPointer, size_t matricesCount);
+#endif
+#ifdef CSE6230_AVX512F_INTRINSICS_SUPPORTED
+extern "C" void batched_matmul_3x3_avx512f(const double *CSE6230_RESTRICT aPointer, const double *CSE6230_RESTRICT bPointer, double *CSE6230_RESTRICT cPointer, size_t matricesCount);
+#endif
+
+extern "C" void batched_matmul_4x4_naive(const double *CSE6230_RESTRICT aPointer, const double *CSE6230_RESTRICT bPointer, double *CSE6230_RESTRICT cPointer, size_t matricesCount);
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+extern "C" void batched_matmul_4x4_sse2(const double *CSE6230_RESTRICT aPointer, const double *CSE6230_RESTRICT bPointer, double *CSE6230_RESTRICT cPointer, size_t matricesCount);
+#endif
+#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+extern "C" void batched_matmul_4x4_avx(const double *CSE6230_RESTRICT aPointer, const double *CSE6230_RESTRICT bPointer, double *CSE6230_RESTRICT cPointer, size_t matricesCount);
+#endif
+#if defined(CSE6230_AVX2_INTRINSICS_SUPPORTED) && defined(CSE6230_FMA3_INTRINSICS_SUPPORTED)
+extern "C" void batched_matmul_4x4_avx2(const double *CSE6230_RESTRICT aPointer, const double *CSE6230_RESTRICT bPointer, double *CSE6230_RESTRICT cPointer, size_t matricesCount);
+#endif
+#ifdef CSE6230_AVX512F_INTRINSICS_SUPPORTED
+extern "C" void batched_matmul_4x4_avx512f(const double *CSE6230_RESTRICT aPointer, const double *CSE6230_RESTRICT bPointer, double *CSE6230_RESTRICT cPointer, size_t matricesCount);
+#endif
+
+extern "C" void batched_matmul_8x8_naive(const double *CSE6230_RESTRICT aPointer, const double *CSE6230_RESTRICT bPointer, double *CSE6230_RESTRICT cPointer, size_t matricesCount);
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+extern "C" void batched_matmul_8x8_sse2(const double *CSE6230_RESTRICT aPointer, const double *CSE6230_RESTRICT bPointer, double *CSE6230_RESTRICT cPointer, size_t matricesCount);
+#endif
+#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+extern "C" void batched_matmul_8x8_avx(const double *CSE6230_RESTRICT aPointer, const double *CSE6230_RESTRICT bPointer, double *CSE6230_RESTRICT cPointer, size_t matricesCount);
+#endif
+#if defined(CSE6230_AVX2_INTRINSICS_SUPPORTED) && defined(CSE6230_FMA3_INTRINSICS_SUPPORTED)
+extern "C" void batched_matmul_8x8_avx2(const double *CSE6230_RESTRICT aPointer, const double *CSE6230_RESTRICT bPointer, double *CSE6230_RESTRICT cPointer, size_t matricesCount);
+#endif
+#ifdef CSE6230_AVX512F_INTRINSICS_SUPPORTED
+extern "C" void batched_matmul_8x8_avx512f(const double *CSE6230_RESTRICT aPointer, const double *CSE6230_RESTRICT bPointer, double *CSE6230_RESTRICT cPointer, size_t matricesCount);
+#endif
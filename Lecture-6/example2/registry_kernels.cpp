@@ -0,0 +1,279 @@
+/******************************************************************************\
+ *                                                                            *
+ * Copyright (c) 2012 Marat Dukhan                                            *
+ *                                                                            *
+ * This software is provided 'as-is', without any express or implied          *
+ * warranty. In no event will the authors be held liable for any damages      *
+ * arising from the use of this software.                                     *
+ *                                                                            *
+ * Permission is granted to anyone to use this software for any purpose,      *
+ * including commercial applications, and to alter it and redistribute it     *
+ * freely, subject to the following restrictions:                             *
+ *                                                                            *
+ * 1. The origin of this software must not be misrepresented; you must not    *
+ * claim that you wrote the original software. If you use this software       *
+ * in a product, an acknowledgment in the product documentation would be      *
+ * appreciated but is not required.                                           *
+ *                                                                            *
+ * 2. Altered source versions must be plainly marked as such, and must not be *
+ * misrepresented as being the original software.                             *
+ *                                                                            *
+ * 3. This notice may not be removed or altered from any source               *
+ * distribution.                                                              *
+ *                                                                            *
+\******************************************************************************/
+
+#include <registry_table.hpp>
+#include <baseline.hpp>
+#include <typed.hpp>
+#include <vectornd.hpp>
+#include <reproducible_dot_products.hpp>
+#include <search.hpp>
+#include <gram.hpp>
+#include <matrix.hpp>
+
+// Kernels of every operation are listed in the order in which the benchmark reports them
+const kernel_info vector3d_registry_kernels[] = {
+	REGISTRY_KERNEL(vector3d_dot_products_naive, "Naive", vector3d_dot_products, naive, sizeof(double), 1),
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+	REGISTRY_KERNEL(vector3d_dot_products_sse2, "SSE2", vector3d_dot_products, sse2, sizeof(double), 2),
+#endif
+#ifdef CSE6230_SSE3_INTRINSICS_SUPPORTED
+	REGISTRY_KERNEL(vector3d_dot_products_sse3, "SSE3", vector3d_dot_products, sse3, sizeof(double), 2),
+#endif
+#ifdef CSE6230_FMA4_INTRINSICS_SUPPORTED
+	REGISTRY_KERNEL(vector3d_dot_products_fma4, "FMA4", vector3d_dot_products, fma4, sizeof(double), 2),
+#endif
+	// The 3-dimensional instances of vectornd_dot_products, which the hand-written kernels above do not cover
+#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+	REGISTRY_TEMPLATE_KERNEL("AVX N-D", vector3d_dot_products, avx, sizeof(double), 4, 0, vectornd_dot_products<3, isa_avx>),
+#endif
+#ifdef CSE6230_AVX512F_INTRINSICS_SUPPORTED
+	REGISTRY_TEMPLATE_KERNEL("AVX-512 N-D", vector3d_dot_products, avx512f, sizeof(double), 8, 0, vectornd_dot_products<3, isa_avx512f>),
+#endif
+	REGISTRY_KERNEL(vector3d_dot_products_omp_simd, "omp simd", vector3d_dot_products, compiler, sizeof(double), 0),
+#ifdef CSE6230_UNSEQ_SUPPORTED
+	REGISTRY_KERNEL(vector3d_dot_products_unseq, "unseq", vector3d_dot_products, compiler, sizeof(double), 0),
+#endif
+#ifdef CSE6230_PAR_UNSEQ_SUPPORTED
+	REGISTRY_KERNEL(vector3d_dot_products_par_unseq, "par_unseq", vector3d_dot_products, compiler, sizeof(double), 0),
+#endif
+#ifdef CSE6230_VECTOR_EXTENSIONS_SUPPORTED
+	REGISTRY_KERNEL(vector3d_dot_products_vector_extensions, "Vector extensions", vector3d_dot_products, compiler, sizeof(double), 4),
+#endif
+
+	REGISTRY_KERNEL(vector3d_dot_products_f32_naive, "F32 Naive", vector3d_dot_products_f32, naive, sizeof(float), 1),
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+	REGISTRY_KERNEL(vector3d_dot_products_f32_sse2, "F32 SSE2", vector3d_dot_products_f32, sse2, sizeof(float), 4),
+#endif
+#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+	REGISTRY_KERNEL(vector3d_dot_products_f32_avx, "F32 AVX", vector3d_dot_products_f32, avx, sizeof(float), 4),
+#endif
+
+	REGISTRY_KERNEL(vector3d_dot_products_f16_naive, "F16 Naive", vector3d_dot_products_f16, naive, sizeof(uint16_t), 1),
+#if defined(CSE6230_AVX_INTRINSICS_SUPPORTED) && defined(CSE6230_F16C_INTRINSICS_SUPPORTED)
+	REGISTRY_KERNEL(vector3d_dot_products_f16_f16c, "F16 F16C", vector3d_dot_products_f16, f16c, sizeof(uint16_t), 4),
+#endif
+
+	REGISTRY_TEMPLATE_KERNEL("float", typed_vector3d_dot_products_f32, naive, sizeof(float), 1, 0, vector3d_dot_products<float, isa_naive>),
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+	REGISTRY_TEMPLATE_KERNEL("float + SSE2", typed_vector3d_dot_products_f32, sse2, sizeof(float), 4, 0, vector3d_dot_products<float, isa_sse2>),
+#endif
+#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+	REGISTRY_TEMPLATE_KERNEL("float + AVX", typed_vector3d_dot_products_f32, avx, sizeof(float), 8, 0, vector3d_dot_products<float, isa_avx>),
+#endif
+#ifdef CSE6230_AVX2_INTRINSICS_SUPPORTED
+	REGISTRY_TEMPLATE_KERNEL("float + AVX2", typed_vector3d_dot_products_f32, avx2, sizeof(float), 8, 0, vector3d_dot_products<float, isa_avx2>),
+#endif
+#ifdef CSE6230_AVX512F_INTRINSICS_SUPPORTED
+	REGISTRY_TEMPLATE_KERNEL("float + AVX-512", typed_vector3d_dot_products_f32, avx512f, sizeof(float), 16, 0, vector3d_dot_products<float, isa_avx512f>),
+#endif
+
+	REGISTRY_TEMPLATE_KERNEL("int32", typed_vector3d_dot_products_i32, naive, sizeof(int32_t), 1, 0, vector3d_dot_products<int32_t, isa_naive>),
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+	REGISTRY_TEMPLATE_KERNEL("int32 + SSE2", typed_vector3d_dot_products_i32, sse2, sizeof(int32_t), 4, 0, vector3d_dot_products<int32_t, isa_sse2>),
+#endif
+#ifdef CSE6230_AVX2_INTRINSICS_SUPPORTED
+	REGISTRY_TEMPLATE_KERNEL("int32 + AVX2", typed_vector3d_dot_products_i32, avx2, sizeof(int32_t), 8, 0, vector3d_dot_products<int32_t, isa_avx2>),
+#endif
+#ifdef CSE6230_AVX512F_INTRINSICS_SUPPORTED
+	REGISTRY_TEMPLATE_KERNEL("int32 + AVX-512", typed_vector3d_dot_products_i32, avx512f, sizeof(int32_t), 16, 0, vector3d_dot_products<int32_t, isa_avx512f>),
+#endif
+
+	REGISTRY_TEMPLATE_KERNEL("int64", typed_vector3d_dot_products_i64, naive, sizeof(int64_t), 1, 0, vector3d_dot_products<int64_t, isa_naive>),
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+	REGISTRY_TEMPLATE_KERNEL("int64 + SSE2", typed_vector3d_dot_products_i64, sse2, sizeof(int64_t), 2, 0, vector3d_dot_products<int64_t, isa_sse2>),
+#endif
+#ifdef CSE6230_AVX2_INTRINSICS_SUPPORTED
+	REGISTRY_TEMPLATE_KERNEL("int64 + AVX2", typed_vector3d_dot_products_i64, avx2, sizeof(int64_t), 4, 0, vector3d_dot_products<int64_t, isa_avx2>),
+#endif
+#ifdef CSE6230_AVX512F_INTRINSICS_SUPPORTED
+	REGISTRY_TEMPLATE_KERNEL("int64 + AVX-512", typed_vector3d_dot_products_i64, avx512f, sizeof(int64_t), 8, 0, vector3d_dot_products<int64_t, isa_avx512f>),
+#endif
+
+	REGISTRY_TEMPLATE_KERNEL("bfloat16", typed_vector3d_dot_products_bf16, naive, sizeof(bfloat16), 1, 0, vector3d_dot_products<bfloat16, isa_naive>),
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+	REGISTRY_TEMPLATE_KERNEL("bfloat16 + SSE2", typed_vector3d_dot_products_bf16, sse2, sizeof(bfloat16), 4, 0, vector3d_dot_products<bfloat16, isa_sse2>),
+#endif
+#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+	REGISTRY_TEMPLATE_KERNEL("bfloat16 + AVX", typed_vector3d_dot_products_bf16, avx, sizeof(bfloat16), 8, 0, vector3d_dot_products<bfloat16, isa_avx>),
+#endif
+#ifdef CSE6230_AVX2_INTRINSICS_SUPPORTED
+	REGISTRY_TEMPLATE_KERNEL("bfloat16 + AVX2", typed_vector3d_dot_products_bf16, avx2, sizeof(bfloat16), 8, 0, vector3d_dot_products<bfloat16, isa_avx2>),
+#endif
+#ifdef CSE6230_AVX512F_INTRINSICS_SUPPORTED
+	REGISTRY_TEMPLATE_KERNEL("bfloat16 + AVX-512", typed_vector3d_dot_products_bf16, avx512f, sizeof(bfloat16), 16, 0, vector3d_dot_products<bfloat16, isa_avx512f>),
+#endif
+
+	REGISTRY_KERNEL(vectornd_dot_products_naive, "Naive", vectornd_dot_products, naive, sizeof(double), 1),
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+	REGISTRY_KERNEL(vectornd_dot_products_sse2, "SSE2", vectornd_dot_products, sse2, sizeof(double), 2),
+#endif
+#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+	REGISTRY_KERNEL(vectornd_dot_products_avx, "AVX", vectornd_dot_products, avx, sizeof(double), 4),
+#endif
+#ifdef CSE6230_AVX512F_INTRINSICS_SUPPORTED
+	REGISTRY_KERNEL(vectornd_dot_products_avx512f, "AVX-512", vectornd_dot_products, avx512f, sizeof(double), 8),
+#endif
+
+	REGISTRY_KERNEL(reproducible_dot_products_sum_naive, "Naive", reproducible_dot_products_sum, naive, sizeof(double), 1),
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+	REGISTRY_KERNEL(reproducible_dot_products_sum_sse2, "SSE2", reproducible_dot_products_sum, sse2, sizeof(double), 2),
+#endif
+#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+	REGISTRY_KERNEL(reproducible_dot_products_sum_avx, "AVX", reproducible_dot_products_sum, avx, sizeof(double), 4),
+#endif
+#ifdef CSE6230_AVX512F_INTRINSICS_SUPPORTED
+	REGISTRY_KERNEL(reproducible_dot_products_sum_avx512f, "AVX-512", reproducible_dot_products_sum, avx512f, sizeof(double), 8),
+#endif
+
+	REGISTRY_KERNEL(vector3d_dot_products_argmax_naive, "Naive", vector3d_dot_products_argmax, naive, sizeof(double), 1),
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+	REGISTRY_KERNEL(vector3d_dot_products_argmax_sse2, "SSE2", vector3d_dot_products_argmax, sse2, sizeof(double), 2),
+#endif
+#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+	REGISTRY_KERNEL(vector3d_dot_products_argmax_avx, "AVX", vector3d_dot_products_argmax, avx, sizeof(double), 4),
+#endif
+#ifdef CSE6230_AVX512F_INTRINSICS_SUPPORTED
+	REGISTRY_KERNEL(vector3d_dot_products_argmax_avx512f, "AVX-512", vector3d_dot_products_argmax, avx512f, sizeof(double), 8),
+#endif
+
+	REGISTRY_KERNEL(vector3d_query_argmax_naive, "Naive", vector3d_query_argmax, naive, sizeof(double), 1),
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+	REGISTRY_KERNEL(vector3d_query_argmax_sse2, "SSE2", vector3d_query_argmax, sse2, sizeof(double), 2),
+#endif
+#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+	REGISTRY_KERNEL(vector3d_query_argmax_avx, "AVX", vector3d_query_argmax, avx, sizeof(double), 4),
+#endif
+#ifdef CSE6230_AVX512F_INTRINSICS_SUPPORTED
+	REGISTRY_KERNEL(vector3d_query_argmax_avx512f, "AVX-512", vector3d_query_argmax, avx512f, sizeof(double), 8),
+#endif
+
+	REGISTRY_KERNEL(vector3d_query_topk_naive, "Naive", vector3d_query_topk, naive, sizeof(double), 1),
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+	REGISTRY_KERNEL(vector3d_query_topk_sse2, "SSE2", vector3d_query_topk, sse2, sizeof(double), 2),
+#endif
+#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+	REGISTRY_KERNEL(vector3d_query_topk_avx, "AVX", vector3d_query_topk, avx, sizeof(double), 4),
+#endif
+#ifdef CSE6230_AVX512F_INTRINSICS_SUPPORTED
+	REGISTRY_KERNEL(vector3d_query_topk_avx512f, "AVX-512", vector3d_query_topk, avx512f, sizeof(double), 8),
+#endif
+
+	REGISTRY_KERNEL(vector3d_dot_products_filter_naive, "Naive", vector3d_dot_products_filter, naive, sizeof(double), 1),
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+	REGISTRY_KERNEL(vector3d_dot_products_filter_sse2, "SSE2", vector3d_dot_products_filter, sse2, sizeof(double), 2),
+#endif
+#ifdef CSE6230_AVX2_INTRINSICS_SUPPORTED
+	REGISTRY_KERNEL(vector3d_dot_products_filter_avx2, "AVX2", vector3d_dot_products_filter, avx2, sizeof(double), 4),
+#endif
+#ifdef CSE6230_AVX512F_INTRINSICS_SUPPORTED
+	REGISTRY_KERNEL(vector3d_dot_products_filter_avx512f, "AVX-512", vector3d_dot_products_filter, avx512f, sizeof(double), 8),
+#endif
+
+	REGISTRY_KERNEL(vector3d_gram_matrix_naive, "Naive", vector3d_gram_matrix, naive, sizeof(double), 1),
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+	REGISTRY_KERNEL(vector3d_gram_matrix_sse2, "SSE2", vector3d_gram_matrix, sse2, sizeof(double), 2),
+#endif
+#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+	REGISTRY_KERNEL(vector3d_gram_matrix_avx, "AVX", vector3d_gram_matrix, avx, sizeof(double), 4),
+#endif
+#if defined(CSE6230_AVX2_INTRINSICS_SUPPORTED) && defined(CSE6230_FMA3_INTRINSICS_SUPPORTED)
+	REGISTRY_KERNEL(vector3d_gram_matrix_avx2, "AVX2 + FMA3", vector3d_gram_matrix, avx2_fma3, sizeof(double), 4),
+#endif
+#ifdef CSE6230_AVX512F_INTRINSICS_SUPPORTED
+	REGISTRY_KERNEL(vector3d_gram_matrix_avx512f, "AVX-512", vector3d_gram_matrix, avx512f, sizeof(double), 8),
+#endif
+
+	REGISTRY_KERNEL(matvec_naive, "Naive", matvec, naive, sizeof(double), 1),
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+	REGISTRY_KERNEL(matvec_sse2, "SSE2", matvec, sse2, sizeof(double), 2),
+#endif
+#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+	REGISTRY_KERNEL(matvec_avx, "AVX", matvec, avx, sizeof(double), 4),
+#endif
+#if defined(CSE6230_AVX2_INTRINSICS_SUPPORTED) && defined(CSE6230_FMA3_INTRINSICS_SUPPORTED)
+	REGISTRY_KERNEL(matvec_avx2, "AVX2 + FMA3", matvec, avx2_fma3, sizeof(double), 4),
+#endif
+#ifdef CSE6230_AVX512F_INTRINSICS_SUPPORTED
+	REGISTRY_KERNEL(matvec_avx512f, "AVX-512", matvec, avx512f, sizeof(double), 8),
+#endif
+
+	REGISTRY_KERNEL(matvec_transposed_naive, "Naive", matvec_transposed, naive, sizeof(double), 1),
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+	REGISTRY_KERNEL(matvec_transposed_sse2, "SSE2", matvec_transposed, sse2, sizeof(double), 2),
+#endif
+#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+	REGISTRY_KERNEL(matvec_transposed_avx, "AVX", matvec_transposed, avx, sizeof(double), 4),
+#endif
+#if defined(CSE6230_AVX2_INTRINSICS_SUPPORTED) && defined(CSE6230_FMA3_INTRINSICS_SUPPORTED)
+	REGISTRY_KERNEL(matvec_transposed_avx2, "AVX2 + FMA3", matvec_transposed, avx2_fma3, sizeof(double), 4),
+#endif
+#ifdef CSE6230_AVX512F_INTRINSICS_SUPPORTED
+	REGISTRY_KERNEL(matvec_transposed_avx512f, "AVX-512", matvec_transposed, avx512f, sizeof(double), 8),
+#endif
+
+	REGISTRY_KERNEL(batched_matmul_3x3_naive, "Naive", batched_matmul_3x3, naive, sizeof(double), 1),
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+	REGISTRY_KERNEL(batched_matmul_3x3_sse2, "SSE2", batched_matmul_3x3, sse2, sizeof(double), 2),
+#endif
+#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+	REGISTRY_KERNEL(batched_matmul_3x3_avx, "AVX", batched_matmul_3x3, avx, sizeof(double), 4),
+#endif
+#if defined(CSE6230_AVX2_INTRINSICS_SUPPORTED) && defined(CSE6230_FMA3_INTRINSICS_SUPPORTED)
+	REGISTRY_KERNEL(batched_matmul_3x3_avx2, "AVX2 + FMA3", batched_matmul_3x3, avx2_fma3, sizeof(double), 4),
+#endif
+#ifdef CSE6230_AVX512F_INTRINSICS_SUPPORTED
+	REGISTRY_KERNEL(batched_matmul_3x3_avx512f, "AVX-512", batched_matmul_3x3, avx512f, sizeof(double), 8),
+#endif
+
+	REGISTRY_KERNEL(batched_matmul_4x4_naive, "Naive", batched_matmul_4x4, naive, sizeof(double), 1),
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+	REGISTRY_KERNEL(batched_matmul_4x4_sse2, "SSE2", batched_matmul_4x4, sse2, sizeof(double), 2),
+#endif
+#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+	REGISTRY_KERNEL(batched_matmul_4x4_avx, "AVX", batched_matmul_4x4, avx, sizeof(double), 4),
+#endif
+#if defined(CSE6230_AVX2_INTRINSICS_SUPPORTED) && defined(CSE6230_FMA3_INTRINSICS_SUPPORTED)
+	REGISTRY_KERNEL(batched_matmul_4x4_avx2, "AVX2 + FMA3", batched_matmul_4x4, avx2_fma3, sizeof(double), 4),
+#endif
+#ifdef CSE6230_AVX512F_INTRINSICS_SUPPORTED
+	REGISTRY_KERNEL(batched_matmul_4x4_avx512f, "AVX-512", batched_matmul_4x4, avx512f, sizeof(double), 8),
+#endif
+
+	REGISTRY_KERNEL(batched_matmul_8x8_naive, "Naive", batched_matmul_8x8, naive, sizeof(double), 1),
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+	REGISTRY_KERNEL(batched_matmul_8x8_sse2, "SSE2", batched_matmul_8x8, sse2, sizeof(double), 2),
+#endif
+#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+	REGISTRY_KERNEL(batched_matmul_8x8_avx, "AVX", batched_matmul_8x8, avx, sizeof(double), 4),
+#endif
+#if defined(CSE6230_AVX2_INTRINSICS_SUPPORTED) && defined(CSE6230_FMA3_INTRINSICS_SUPPORTED)
+	REGISTRY_KERNEL(batched_matmul_8x8_avx2, "AVX2 + FMA3", batched_matmul_8x8, avx2_fma3, sizeof(double), 4),
+#endif
+#ifdef CSE6230_AVX512F_INTRINSICS_SUPPORTED
+	REGISTRY_KERNEL(batched_matmul_8x8_avx512f, "AVX-512", batched_matmul_8x8, avx512f, sizeof(double), 8),
+#endif
+};
+
+const size_t vector3d_registry_kernels_count = sizeof(vector3d_registry_kernels) / sizeof(vector3d_registry_kernels[0]);
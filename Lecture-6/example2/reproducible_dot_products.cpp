@@ -0,0 +1,171 @@
+/******************************************************************************\
+ *                                                                            *
+ * Copyright (c) 2012 Marat Dukhan                                            *
+ *                                                                            *
+ * This software is provided 'as-is', without any express or implied          *
+ * warranty. In no event will the authors be held liable for any damages      *
+ * arising from the use of this software.                                     *
+ *                                                                            *
+ * Permission is granted to anyone to use this software for any purpose,      *
+ * including commercial applications, and to alter it and redistribute it     *
+ * freely, subject to the following restrictions:                             *
+ *                                                                            *
+ * 1. The origin of this software must not be misrepresented; you must not    *
+ * claim that you wrote the original software. If you use this software       *
+ * in a product, an acknowledgment in the product documentation would be      *
+ * appreciated but is not required.                                           *
+ *                                                                            *
+ * 2. Altered source versions must be plainly marked as such, and must not be *
+ * misrepresented as being the original software.                             *
+ *                                                                            *
+ * 3. This notice may not be removed or altered from any source               *
+ * distribution.                                                              *
+ *                                                                            *
+\******************************************************************************/
+
+#include <reproducible_dot_products.hpp>
+#if defined(CSE6230_SSE2_INTRINSICS_SUPPORTED) || defined(CSE6230_AVX_INTRINSICS_SUPPORTED)
+	#if defined(__GNUC__)
+		#include <x86intrin.h>
+	#elif defined(_MSC_VER)
+		#include <intrin.h>
+	#else
+		#error Intrinsics headers are not included: unknown compiler
+	#endif
+#endif
+
+// Dot products of one block. Every version computes (v.x * u.x + v.y * u.y) + v.z * u.z for every pair of vectors,
+// so the dot products are the same for every instruction set. SIMD versions multiply the loaded vectors component by
+// component, and then transpose the products into vectors of x, y and z products.
+static void block_dot_products_naive(const double *CSE6230_RESTRICT vPointer, const double *CSE6230_RESTRICT uPointer, double *CSE6230_RESTRICT dpPointer, size_t vectorsCount) {
+	for (size_t i = 0; i < vectorsCount; i++) {
+		const double* v = vPointer + 3 * i;
+		const double* u = uPointer + 3 * i;
+		dpPointer[i] = (v[0] * u[0] + v[1] * u[1]) + v[2] * u[2];
+	}
+}
+
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+static void block_dot_products_sse2(const double *CSE6230_RESTRICT vPointer, const double *CSE6230_RESTRICT uPointer, double *CSE6230_RESTRICT dpPointer, size_t vectorsCount) {
+	size_t i = 0;
+	for (; i + 2 <= vectorsCount; i += 2) {
+		// Products of two pairs of vectors: a = [x0 y0], b = [z0 x1], c = [y1 z1]
+		const __m128d a = _mm_mul_pd(_mm_loadu_pd(vPointer + 3 * i), _mm_loadu_pd(uPointer + 3 * i));
+		const __m128d b = _mm_mul_pd(_mm_loadu_pd(vPointer + 3 * i + 2), _mm_loadu_pd(uPointer + 3 * i + 2));
+		const __m128d c = _mm_mul_pd(_mm_loadu_pd(vPointer + 3 * i + 4), _mm_loadu_pd(uPointer + 3 * i + 4));
+		const __m128d x = _mm_shuffle_pd(a, b, 2);
+		const __m128d y = _mm_shuffle_pd(a, c, 1);
+		const __m128d z = _mm_shuffle_pd(b, c, 2);
+		_mm_storeu_pd(dpPointer + i, _mm_add_pd(_mm_add_pd(x, y), z));
+	}
+	// Process remaining vectors (if any)
+	block_dot_products_naive(vPointer + 3 * i, uPointer + 3 * i, dpPointer + i, vectorsCount - i);
+}
+#endif
+
+#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+// Loads 12 doubles as pairs of 128-bit halves: [p0 p1 | p6 p7], [p2 p3 | p8 p9], [p4 p5 | p10 p11]
+static inline __m256d load_halves(const double* pointer, size_t offset) {
+	return _mm256_insertf128_pd(_mm256_castpd128_pd256(_mm_loadu_pd(pointer + offset)), _mm_loadu_pd(pointer + offset + 6), 1);
+}
+
+static void block_dot_products_avx(const double *CSE6230_RESTRICT vPointer, const double *CSE6230_RESTRICT uPointer, double *CSE6230_RESTRICT dpPointer, size_t vectorsCount) {
+	size_t i = 0;
+	for (; i + 4 <= vectorsCount; i += 4) {
+		// Products of four pairs of vectors: m0 = [x0 y0 | x2 y2], m1 = [z0 x1 | z2 x3], m2 = [y1 z1 | y3 z3]
+		const __m256d m0 = _mm256_mul_pd(load_halves(vPointer + 3 * i, 0), load_halves(uPointer + 3 * i, 0));
+		const __m256d m1 = _mm256_mul_pd(load_halves(vPointer + 3 * i, 2), load_halves(uPointer + 3 * i, 2));
+		const __m256d m2 = _mm256_mul_pd(load_halves(vPointer + 3 * i, 4), load_halves(uPointer + 3 * i, 4));
+		const __m256d x = _mm256_shuffle_pd(m0, m1, 0xA);
+		const __m256d y = _mm256_shuffle_pd(m0, m2, 0x5);
+		const __m256d z = _mm256_shuffle_pd(m1, m2, 0xA);
+		_mm256_storeu_pd(dpPointer + i, _mm256_add_pd(_mm256_add_pd(x, y), z));
+	}
+	// Process remaining vectors (if any)
+	block_dot_products_naive(vPointer + 3 * i, uPointer + 3 * i, dpPointer + i, vectorsCount - i);
+}
+#endif
+
+#ifdef CSE6230_AVX512F_INTRINSICS_SUPPORTED
+static void block_dot_products_avx512f(const double *CSE6230_RESTRICT vPointer, const double *CSE6230_RESTRICT uPointer, double *CSE6230_RESTRICT dpPointer, size_t vectorsCount) {
+	size_t i = 0;
+	for (; i + 8 <= vectorsCount; i += 8) {
+		// Products of eight pairs of vectors. The first 6 (x) or 5 (y, z) products come from a and b, and the rest from c.
+		const __m512d a = _mm512_mul_pd(_mm512_loadu_pd(vPointer + 3 * i), _mm512_loadu_pd(uPointer + 3 * i));
+		const __m512d b = _mm512_mul_pd(_mm512_loadu_pd(vPointer + 3 * i + 8), _mm512_loadu_pd(uPointer + 3 * i + 8));
+		const __m512d c = _mm512_mul_pd(_mm512_loadu_pd(vPointer + 3 * i + 16), _mm512_loadu_pd(uPointer + 3 * i + 16));
+		__m512d x = _mm512_permutex2var_pd(a, _mm512_setr_epi64(0, 3, 6, 9, 12, 15, 0, 0), b);
+		__m512d y = _mm512_permutex2var_pd(a, _mm512_setr_epi64(1, 4, 7, 10, 13, 0, 0, 0), b);
+		__m512d z = _mm512_permutex2var_pd(a, _mm512_setr_epi64(2, 5, 8, 11, 14, 0, 0, 0), b);
+		x = _mm512_mask_permutexvar_pd(x, 0xC0, _mm512_setr_epi64(0, 0, 0, 0, 0, 0, 2, 5), c);
+		y = _mm512_mask_permutexvar_pd(y, 0xE0, _mm512_setr_epi64(0, 0, 0, 0, 0, 0, 3, 6), c);
+		z = _mm512_mask_permutexvar_pd(z, 0xE0, _mm512_setr_epi64(0, 0, 0, 0, 0, 1, 4, 7), c);
+		_mm512_storeu_pd(dpPointer + i, _mm512_add_pd(_mm512_add_pd(x, y), z));
+	}
+	// Process remaining vectors (if any)
+	block_dot_products_naive(vPointer + 3 * i, uPointer + 3 * i, dpPointer + i, vectorsCount - i);
+}
+#endif
+
+typedef void (*block_dot_products_function)(const double*, const double*, double*, size_t);
+
+template <block_dot_products_function BlockDotProducts, reproducible_sum_function BlockSum>
+static double block_dot_products_sum(const double *CSE6230_RESTRICT vPointer, const double *CSE6230_RESTRICT uPointer, size_t vectorsCount) {
+	double dotProducts[reproducible_block_length];
+	BlockDotProducts(vPointer, uPointer, dotProducts, vectorsCount);
+	return BlockSum(dotProducts, vectorsCount);
+}
+
+template <block_dot_products_function BlockDotProducts, reproducible_sum_function BlockSum>
+static double reproducible_dot_products_sum(const double *CSE6230_RESTRICT vPointer, const double *CSE6230_RESTRICT uPointer, size_t vectorsCount) {
+	reproducible_pairwise_sum sum;
+	for (size_t blockStart = 0; blockStart < vectorsCount; blockStart += reproducible_block_length) {
+		sum.add_block(block_dot_products_sum<BlockDotProducts, BlockSum>(vPointer + 3 * blockStart, uPointer + 3 * blockStart, reproducible_block_size(vectorsCount, blockStart / reproducible_block_length)));
+	}
+	return sum.get();
+}
+
+double reproducible_dot_products_sum_naive(const double *CSE6230_RESTRICT vPointer, const double *CSE6230_RESTRICT uPointer, size_t vectorsCount) {
+	return reproducible_dot_products_sum<block_dot_products_naive, reproducible_sum_naive>(vPointer, uPointer, vectorsCount);
+}
+
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+double reproducible_dot_products_sum_sse2(const double *CSE6230_RESTRICT vPointer, const double *CSE6230_RESTRICT uPointer, size_t vectorsCount) {
+	return reproducible_dot_products_sum<block_dot_products_sse2, reproducible_sum_sse2>(vPointer, uPointer, vectorsCount);
+}
+#endif
+
+#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+double reproducible_dot_products_sum_avx(const double *CSE6230_RESTRICT vPointer, const double *CSE6230_RESTRICT uPointer, size_t vectorsCount) {
+	return reproducible_dot_products_sum<block_dot_products_avx, reproducible_sum_avx>(vPointer, uPointer, vectorsCount);
+}
+#endif
+
+#ifdef CSE6230_AVX512F_INTRINSICS_SUPPORTED
+double reproducible_dot_products_sum_avx512f(const double *CSE6230_RESTRICT vPointer, const double *CSE6230_RESTRICT uPointer, size_t vectorsCount) {
+	return reproducible_dot_products_sum<block_dot_products_avx512f, reproducible_sum_avx512f>(vPointer, uPointer, vectorsCount);
+}
+#endif
+
+struct parallel_dot_products_sum_context {
+	reproducible_dot_products_sum_function sum;
+	const double* vPointer;
+	const double* uPointer;
+	size_t vectorsCount;
+};
+
+static double parallel_dot_products_sum_block(void* context, size_t block) {
+	const parallel_dot_products_sum_context* sumContext = static_cast<const parallel_dot_products_sum_context*>(context);
+	const size_t blockStart = block * reproducible_block_length;
+	return sumContext->sum(sumContext->vPointer + 3 * blockStart, sumContext->uPointer + 3 * blockStart, reproducible_block_size(sumContext->vectorsCount, block));
+}
+
+double reproducible_dot_products_sum_parallel(reproducible_dot_products_sum_function sum, const double* vPointer, const double* uPointer, size_t vectorsCount, size_t threadsCount) {
+	parallel_dot_products_sum_context context;
+	context.sum = sum;
+	context.vPointer = vPointer;
+	context.uPointer = uPointer;
+	context.vectorsCount = vectorsCount;
+	const size_t blocksCount = (vectorsCount + reproducible_block_length - 1) / reproducible_block_length;
+	return reproducible_parallel_sum(blocksCount, threadsCount, parallel_dot_products_sum_block, &context);
+}
@@ -0,0 +1,47 @@
+/******************************************************************************\
+ *                                                                            *
+ * Copyright (c) 2012 Marat Dukhan                                            *
+ *                                                                            *
+ * This software is provided 'as-is', without any express or implied          *
+ * warranty. In no event will the authors be held liable for any damages      *
+ * arising from the use of this software.                                     *
+ *                                                                            *
+ * Permission is granted to anyone to use this software for any purpose,      *
+ * including commercial applications, and to alter it and redistribute it     *
+ * freely, subject to the following restrictions:                             *
+ *                                                                            *
+ * 1. The origin of this software must not be misrepresented; you must not    *
+ * claim that you wrote the original software. If you use this software       *
+ * in a product, an acknowledgment in the product documentation would be      *
+ * appreciated but is not required.                                           *
+ *                                                                            *
+ * 2. Altered source versions must be plainly marked as such, and must not be *
+ * misrepresented as being the original software.                             *
+ *                                                                            *
+ * 3. This notice may not be removed or altered from any source               *
+ * distribution.                                                              *
+ *                                                                            *
+\******************************************************************************/
+
+#pragma once
+
+#include <compute.hpp>
+#include <reproducible.hpp>
+
+typedef double (*reproducible_dot_products_sum_function)(const double*, const double*, size_t);
+
+// Reproducible sums of the outputs of vector3d_dot_products. Every dot product is computed as
+// (v.x * u.x + v.y * u.y) + v.z * u.z, and the dot products are added as the elements of reproducible_sum_*.
+// SIMD versions compute the dot products of a block and add them with vectors of their instruction set.
+// The source file must be compiled without contraction of multiplications and additions (-ffp-contract=off).
+extern "C" double reproducible_dot_products_sum_naive(const double *CSE6230_RESTRICT vPointer, const double *CSE6230_RESTRICT uPointer, size_t vectorsCount);
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+extern "C" double reproducible_dot_products_sum_sse2(const double *CSE6230_RESTRICT vPointer, const double *CSE6230_RESTRICT uPointer, size_t vectorsCount);
+#endif
+#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+extern "C" double reproducible_dot_products_sum_avx(const double *CSE6230_RESTRICT vPointer, const double *CSE6230_RESTRICT uPointer, size_t vectorsCount);
+#endif
+#ifdef CSE6230_AVX512F_INTRINSICS_SUPPORTED
+extern "C" double reproducible_dot_products_sum_avx512f(const double *CSE6230_RESTRICT vPointer, const double *CSE6230_RESTRICT uPointer, size_t vectorsCount);
+#endif
+extern "C" double reproducible_dot_products_sum_parallel(reproducible_dot_products_sum_function sum, const double* vPointer, const double* uPointer, size_t vectorsCount, size_t threadsCount);
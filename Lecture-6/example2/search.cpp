@@ -0,0 +1,635 @@
+/******************************************************************************\
+ *                                                                            *
+ * Copyright (c) 2012 Marat Dukhan                                            *
+ *                                                                            *
+ * This software is provided 'as-is', without any express or implied          *
+ * warranty. In no event will the authors be held liable for any damages      *
+ * arising from the use of this software.                                     *
+ *                                                                            *
+ * Permission is granted to anyone to use this software for any purpose,      *
+ * including commercial applications, and to alter it and redistribute it     *
+ * freely, subject to the following restrictions:                             *
+ *                                                                            *
+ * 1. The origin of this software must not be misrepresented; you must not    *
+ * claim that you wrote the original software. If you use this software       *
+ * in a product, an acknowledgment in the product documentation would be      *
+ * appreciated but is not required.                                           *
+ *                                                                            *
+ * 2. Altered source versions must be plainly marked as such, and must not be *
+ * misrepresented as being the original software.                             *
+ *                                                                            *
+ * 3. This notice may not be removed or altered from any source               *
+ * distribution.                                                              *
+ *                                                                            *
+\******************************************************************************/
+
+#include <search.hpp>
+#include <limits>
+#include <stdint.h>
+#include <thread>
+#include <vector>
+#if defined(CSE6230_SSE2_INTRINSICS_SUPPORTED) || defined(CSE6230_AVX_INTRINSICS_SUPPORTED)
+	#if defined(__GNUC__)
+		#include <x86intrin.h>
+	#elif defined(_MSC_VER)
+		#include <intrin.h>
+	#else
+		#error Intrinsics headers are not included: unknown compiler
+	#endif
+#endif
+
+// Operations on SIMD vectors of doubles for the search. Each specialization provides:
+//   load3: loads width 3D vectors and transposes them into vectors of x, y and z components
+//   positions: a vector of 0, 1, ..., width - 1
+//   greater: a mask of lanes where a > b, select: a where the mask is set and b elsewhere
+//   merge: combines two masks, and any: true if a lane of the mask is set
+template <typename ISA>
+struct search_pd;
+
+template <>
+struct search_pd<isa_naive> {
+	typedef double vector;
+	typedef bool mask;
+	static const size_t width = 1;
+
+	static void load3(const double* pointer, vector& x, vector& y, vector& z) {
+		x = pointer[0];
+		y = pointer[1];
+		z = pointer[2];
+	}
+	static void store(double* pointer, vector a) { *pointer = a; }
+	static vector broadcast(double value) { return value; }
+	static vector positions() { return 0.0; }
+	static vector add(vector a, vector b) { return a + b; }
+	static vector mul(vector a, vector b) { return a * b; }
+	static mask greater(vector a, vector b) { return a > b; }
+	static vector select(mask m, vector a, vector b) { return m ? a : b; }
+	static mask merge(mask a, mask b) { return a || b; }
+	static bool any(mask m) { return m; }
+};
+
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+template <>
+struct search_pd<isa_sse2> {
+	typedef __m128d vector;
+	typedef __m128d mask;
+	static const size_t width = 2;
+
+	static void load3(const double* pointer, vector& x, vector& y, vector& z) {
+		// a = [x0 y0], b = [z0 x1], c = [y1 z1]
+		const __m128d a = _mm_loadu_pd(pointer);
+		const __m128d b = _mm_loadu_pd(pointer + 2);
+		const __m128d c = _mm_loadu_pd(pointer + 4);
+		x = _mm_shuffle_pd(a, b, 2);
+		y = _mm_shuffle_pd(a, c, 1);
+		z = _mm_shuffle_pd(b, c, 2);
+	}
+	static void store(double* pointer, vector a) { _mm_storeu_pd(pointer, a); }
+	static vector broadcast(double value) { return _mm_set1_pd(value); }
+	static vector positions() { return _mm_setr_pd(0.0, 1.0); }
+	static vector add(vector a, vector b) { return _mm_add_pd(a, b); }
+	static vector mul(vector a, vector b) { return _mm_mul_pd(a, b); }
+	static mask greater(vector a, vector b) { return _mm_cmpgt_pd(a, b); }
+	// SSE2 has no blend instruction
+	static vector select(mask m, vector a, vector b) { return _mm_or_pd(_mm_and_pd(m, a), _mm_andnot_pd(m, b)); }
+	static mask merge(mask a, mask b) { return _mm_or_pd(a, b); }
+	static bool any(mask m) { return _mm_movemask_pd(m) != 0; }
+};
+#endif
+
+#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+template <>
+struct search_pd<isa_avx> {
+	typedef __m256d vector;
+	typedef __m256d mask;
+	static const size_t width = 4;
+
+	static void load3(const double* pointer, vector& x, vector& y, vector& z) {
+		// Pairs of 128-bit halves: m0 = [x0 y0 | x2 y2], m1 = [z0 x1 | z2 x3], m2 = [y1 z1 | y3 z3]
+		const __m256d m0 = _mm256_insertf128_pd(_mm256_castpd128_pd256(_mm_loadu_pd(pointer)), _mm_loadu_pd(pointer + 6), 1);
+		const __m256d m1 = _mm256_insertf128_pd(_mm256_castpd128_pd256(_mm_loadu_pd(pointer + 2)), _mm_loadu_pd(pointer + 8), 1);
+		const __m256d m2 = _mm256_insertf128_pd(_mm256_castpd128_pd256(_mm_loadu_pd(pointer + 4)), _mm_loadu_pd(pointer + 10), 1);
+		x = _mm256_shuffle_pd(m0, m1, 0xA);
+		y = _mm256_shuffle_pd(m0, m2, 0x5);
+		z = _mm256_shuffle_pd(m1, m2, 0xA);
+	}
+	static void store(double* pointer, vector a) { _mm256_storeu_pd(pointer, a); }
+	static vector broadcast(double value) { return _mm256_set1_pd(value); }
+	static vector positions() { return _mm256_setr_pd(0.0, 1.0, 2.0, 3.0); }
+	static vector add(vector a, vector b) { return _mm256_add_pd(a, b); }
+	static vector mul(vector a, vector b) { return _mm256_mul_pd(a, b); }
+	static mask greater(vector a, vector b) { return _mm256_cmp_pd(a, b, _CMP_GT_OQ); }
+	static vector select(mask m, vector a, vector b) { return _mm256_blendv_pd(b, a, m); }
+	static mask merge(mask a, mask b) { return _mm256_or_pd(a, b); }
+	static bool any(mask m) { return _mm256_movemask_pd(m) != 0; }
+};
+#endif
+
+#ifdef CSE6230_AVX512F_INTRINSICS_SUPPORTED
+template <>
+struct search_pd<isa_avx512f> {
+	typedef __m512d vector;
+	typedef __mmask8 mask;
+	static const size_t width = 8;
+
+	static void load3(const double* pointer, vector& x, vector& y, vector& z) {
+		// The first 6 (x) or 5 (y, z) components come from the first 16 doubles, and the rest from the last 8
+		const __m512d a = _mm512_loadu_pd(pointer);
+		const __m512d b = _mm512_loadu_pd(pointer + 8);
+		const __m512d c = _mm512_loadu_pd(pointer + 16);
+		x = _mm512_permutex2var_pd(a, _mm512_setr_epi64(0, 3, 6, 9, 12, 15, 0, 0), b);
+		y = _mm512_permutex2var_pd(a, _mm512_setr_epi64(1, 4, 7, 10, 13, 0, 0, 0), b);
+		z = _mm512_permutex2var_pd(a, _mm512_setr_epi64(2, 5, 8, 11, 14, 0, 0, 0), b);
+		x = _mm512_mask_permutexvar_pd(x, 0xC0, _mm512_setr_epi64(0, 0, 0, 0, 0, 0, 2, 5), c);
+		y = _mm512_mask_permutexvar_pd(y, 0xE0, _mm512_setr_epi64(0, 0, 0, 0, 0, 0, 3, 6), c);
+		z = _mm512_mask_permutexvar_pd(z, 0xE0, _mm512_setr_epi64(0, 0, 0, 0, 0, 1, 4, 7), c);
+	}
+	static void store(double* pointer, vector a) { _mm512_storeu_pd(pointer, a); }
+	static vector broadcast(double value) { return _mm512_set1_pd(value); }
+	static vector positions() { return _mm512_setr_pd(0.0, 1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0); }
+	static vector add(vector a, vector b) { return _mm512_add_pd(a, b); }
+	static vector mul(vector a, vector b) { return _mm512_mul_pd(a, b); }
+	static mask greater(vector a, vector b) { return _mm512_cmp_pd_mask(a, b, _CMP_GT_OQ); }
+	static vector select(mask m, vector a, vector b) { return _mm512_mask_blend_pd(m, b, a); }
+	static mask merge(mask a, mask b) { return a | b; }
+	static bool any(mask m) { return m != 0; }
+};
+#endif
+
+// Dot products of the pairs vPointer[i] and uPointer[i]
+template <typename ISA>
+struct pairs_dot {
+	typedef search_pd<ISA> simd;
+	const double* vPointer;
+	const double* uPointer;
+
+	pairs_dot(const double* vPointer, const double* uPointer) : vPointer(vPointer), uPointer(uPointer) {}
+
+	typename simd::vector dot_vector(size_t i) const {
+		typename simd::vector vx, vy, vz, ux, uy, uz;
+		simd::load3(vPointer + 3 * i, vx, vy, vz);
+		simd::load3(uPointer + 3 * i, ux, uy, uz);
+		return simd::add(simd::add(simd::mul(vx, ux), simd::mul(vy, uy)), simd::mul(vz, uz));
+	}
+
+	double dot_scalar(size_t i) const {
+		const double* v = vPointer + 3 * i;
+		const double* u = uPointer + 3 * i;
+		return (v[0] * u[0] + v[1] * u[1]) + v[2] * u[2];
+	}
+};
+
+// Dot products of the query and vectorsPointer[i]
+template <typename ISA>
+struct query_dot {
+	typedef search_pd<ISA> simd;
+	const double* vectorsPointer;
+	double qx, qy, qz;
+	typename simd::vector qxVector, qyVector, qzVector;
+
+	query_dot(const double* queryPointer, const double* vectorsPointer) :
+		vectorsPointer(vectorsPointer),
+		qx(queryPointer[0]), qy(queryPointer[1]), qz(queryPointer[2]),
+		qxVector(simd::broadcast(qx)), qyVector(simd::broadcast(qy)), qzVector(simd::broadcast(qz))
+	{
+	}
+
+	typename simd::vector dot_vector(size_t i) const {
+		typename simd::vector x, y, z;
+		simd::load3(vectorsPointer + 3 * i, x, y, z);
+		return simd::add(simd::add(simd::mul(x, qxVector), simd::mul(y, qyVector)), simd::mul(z, qzVector));
+	}
+
+	double dot_scalar(size_t i) const {
+		const double* v = vectorsPointer + 3 * i;
+		return (v[0] * qx + v[1] * qy) + v[2] * qz;
+	}
+};
+
+// Keeps the maxima and their indices (as doubles) in two pairs of SIMD vectors to hide the latency of compare-and-select.
+// As every lane sees increasing indices and only replaces its maximum by a greater value, each lane holds the smallest index of its maximum.
+template <typename ISA, typename Dot>
+static size_t search_argmax(const Dot& dot, size_t vectorsCount, double* maxPointer) {
+	typedef search_pd<ISA> simd;
+	const double infinity = std::numeric_limits<double>::infinity();
+	const size_t blockLength = 2 * simd::width;
+
+	typename simd::vector maxA = simd::broadcast(-infinity);
+	typename simd::vector maxB = simd::broadcast(-infinity);
+	typename simd::vector indexA = simd::broadcast(infinity);
+	typename simd::vector indexB = simd::broadcast(infinity);
+	typename simd::vector positionA = simd::positions();
+	typename simd::vector positionB = simd::add(positionA, simd::broadcast(double(simd::width)));
+	const typename simd::vector positionStep = simd::broadcast(double(blockLength));
+	size_t i = 0;
+	for (; i + blockLength <= vectorsCount; i += blockLength) {
+		const typename simd::vector dotA = dot.dot_vector(i);
+		const typename simd::vector dotB = dot.dot_vector(i + simd::width);
+		const typename simd::mask greaterA = simd::greater(dotA, maxA);
+		const typename simd::mask greaterB = simd::greater(dotB, maxB);
+		maxA = simd::select(greaterA, dotA, maxA);
+		maxB = simd::select(greaterB, dotB, maxB);
+		indexA = simd::select(greaterA, positionA, indexA);
+		indexB = simd::select(greaterB, positionB, indexB);
+		positionA = simd::add(positionA, positionStep);
+		positionB = simd::add(positionB, positionStep);
+	}
+
+	double maxes[blockLength], indices[blockLength];
+	simd::store(maxes, maxA);
+	simd::store(maxes + simd::width, maxB);
+	simd::store(indices, indexA);
+	simd::store(indices + simd::width, indexB);
+	double max = -infinity;
+	double index = infinity;
+	for (size_t lane = 0; lane < blockLength; lane++) {
+		if ((maxes[lane] > max) || ((maxes[lane] == max) && (indices[lane] < index))) {
+			max = maxes[lane];
+			index = indices[lane];
+		}
+	}
+	// Process remaining elements (if any)
+	size_t maxIndex = (index == infinity) ? SIZE_MAX : size_t(index);
+	for (; i < vectorsCount; i++) {
+		const double dotProduct = dot.dot_scalar(i);
+		if (dotProduct > max) {
+			max = dotProduct;
+			maxIndex = i;
+		}
+	}
+	// All dot products are -infinity
+	if ((maxIndex == SIZE_MAX) && (vectorsCount != 0)) {
+		maxIndex = 0;
+	}
+	*maxPointer = max;
+	return maxIndex;
+}
+
+// The k largest dot products seen so far, in descending order of values and ascending order of indices for equal values
+struct search_buffer {
+	double values[vector3d_query_topk_max_k];
+	size_t indices[vector3d_query_topk_max_k];
+	size_t count;
+	size_t k;
+
+	explicit search_buffer(size_t k) : count(0), k(k) {}
+
+	bool is_full() const {
+		return count == k;
+	}
+
+	// The dot products must be greater than this value to get into a full buffer, if their indices are greater than all in the buffer
+	double threshold() const {
+		return values[k - 1];
+	}
+
+	void insert(double value, size_t index) {
+		size_t position = count;
+		if (is_full()) {
+			if ((value < values[k - 1]) || ((value == values[k - 1]) && (index > indices[k - 1]))) {
+				return;
+			}
+			position = k - 1;
+		} else {
+			count += 1;
+		}
+		// Shift the smaller dot products by one position
+		for (; (position != 0) && ((values[position - 1] < value) || ((values[position - 1] == value) && (indices[position - 1] > index))); position--) {
+			values[position] = values[position - 1];
+			indices[position] = indices[position - 1];
+		}
+		values[position] = value;
+		indices[position] = index;
+	}
+
+	size_t store(double* valuesPointer, size_t* indicesPointer) const {
+		for (size_t i = 0; i < count; i++) {
+			valuesPointer[i] = values[i];
+			indicesPointer[i] = indices[i];
+		}
+		return count;
+	}
+};
+
+// Computes two SIMD vectors of dot products at an iteration, and inserts them one by one into the buffer
+// only if any of them is greater than the threshold
+template <typename ISA, typename Dot>
+static size_t search_topk(const Dot& dot, size_t vectorsCount, size_t k, double* valuesPointer, size_t* indicesPointer) {
+	typedef search_pd<ISA> simd;
+	if ((k == 0) || (k > vector3d_query_topk_max_k)) {
+		return 0;
+	}
+	search_buffer buffer(k);
+	size_t i = 0;
+	// The first k dot products fill the buffer
+	for (; (i < vectorsCount) && !buffer.is_full(); i++) {
+		buffer.insert(dot.dot_scalar(i), i);
+	}
+
+	const size_t blockLength = 2 * simd::width;
+	typename simd::vector threshold = simd::broadcast(buffer.threshold());
+	for (; i + blockLength <= vectorsCount; i += blockLength) {
+		const typename simd::vector dotA = dot.dot_vector(i);
+		const typename simd::vector dotB = dot.dot_vector(i + simd::width);
+		if (simd::any(simd::merge(simd::greater(dotA, threshold), simd::greater(dotB, threshold)))) {
+			double dotProducts[blockLength];
+			simd::store(dotProducts, dotA);
+			simd::store(dotProducts + simd::width, dotB);
+			for (size_t j = 0; j < blockLength; j++) {
+				if (dotProducts[j] > buffer.threshold()) {
+					buffer.insert(dotProducts[j], i + j);
+				}
+			}
+			threshold = simd::broadcast(buffer.threshold());
+		}
+	}
+	// Process remaining elements (if any)
+	for (; i < vectorsCount; i++) {
+		const double dotProduct = dot.dot_scalar(i);
+		if (dotProduct > buffer.threshold()) {
+			buffer.insert(dotProduct, i);
+		}
+	}
+	return buffer.store(valuesPointer, indicesPointer);
+}
+
+size_t vector3d_dot_products_argmax_naive(const double *CSE6230_RESTRICT vPointer, const double *CSE6230_RESTRICT uPointer, size_t vectorsCount, double *CSE6230_RESTRICT maxPointer) {
+	return search_argmax<isa_naive>(pairs_dot<isa_naive>(vPointer, uPointer), vectorsCount, maxPointer);
+}
+
+size_t vector3d_query_argmax_naive(const double *CSE6230_RESTRICT queryPointer, const double *CSE6230_RESTRICT vectorsPointer, size_t vectorsCount, double *CSE6230_RESTRICT maxPointer) {
+	return search_argmax<isa_naive>(query_dot<isa_naive>(queryPointer, vectorsPointer), vectorsCount, maxPointer);
+}
+
+size_t vector3d_query_topk_naive(const double *CSE6230_RESTRICT queryPointer, const double *CSE6230_RESTRICT vectorsPointer, size_t vectorsCount, size_t k, double *CSE6230_RESTRICT valuesPointer, size_t *CSE6230_RESTRICT indicesPointer) {
+	return search_topk<isa_naive>(query_dot<isa_naive>(queryPointer, vectorsPointer), vectorsCount, k, valuesPointer, indicesPointer);
+}
+
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+size_t vector3d_dot_products_argmax_sse2(const double *CSE6230_RESTRICT vPointer, const double *CSE6230_RESTRICT uPointer, size_t vectorsCount, double *CSE6230_RESTRICT maxPointer) {
+	return search_argmax<isa_sse2>(pairs_dot<isa_sse2>(vPointer, uPointer), vectorsCount, maxPointer);
+}
+
+size_t vector3d_query_argmax_sse2(const double *CSE6230_RESTRICT queryPointer, const double *CSE6230_RESTRICT vectorsPointer, size_t vectorsCount, double *CSE6230_RESTRICT maxPointer) {
+	return search_argmax<isa_sse2>(query_dot<isa_sse2>(queryPointer, vectorsPointer), vectorsCount, maxPointer);
+}
+
+size_t vector3d_query_topk_sse2(const double *CSE6230_RESTRICT queryPointer, const double *CSE6230_RESTRICT vectorsPointer, size_t vectorsCount, size_t k, double *CSE6230_RESTRICT valuesPointer, size_t *CSE6230_RESTRICT indicesPointer) {
+	return search_topk<isa_sse2>(query_dot<isa_sse2>(queryPointer, vectorsPointer), vectorsCount, k, valuesPointer, indicesPointer);
+}
+#endif
+
+#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+size_t vector3d_dot_products_argmax_avx(const double *CSE6230_RESTRICT vPointer, const double *CSE6230_RESTRICT uPointer, size_t vectorsCount, double *CSE6230_RESTRICT maxPointer) {
+	return search_argmax<isa_avx>(pairs_dot<isa_avx>(vPointer, uPointer), vectorsCount, maxPointer);
+}
+
+size_t vector3d_query_argmax_avx(const double *CSE6230_RESTRICT queryPointer, const double *CSE6230_RESTRICT vectorsPointer, size_t vectorsCount, double *CSE6230_RESTRICT maxPointer) {
+	return search_argmax<isa_avx>(query_dot<isa_avx>(queryPointer, vectorsPointer), vectorsCount, maxPointer);
+}
+
+size_t vector3d_query_topk_avx(const double *CSE6230_RESTRICT queryPointer, const double *CSE6230_RESTRICT vectorsPointer, size_t vectorsCount, size_t k, double *CSE6230_RESTRICT valuesPointer, size_t *CSE6230_RESTRICT indicesPointer) {
+	return search_topk<isa_avx>(query_dot<isa_avx>(queryPointer, vectorsPointer), vectorsCount, k, valuesPointer, indicesPointer);
+}
+#endif
+
+#ifdef CSE6230_AVX512F_INTRINSICS_SUPPORTED
+size_t vector3d_dot_products_argmax_avx512f(const double *CSE6230_RESTRICT vPointer, const double *CSE6230_RESTRICT uPointer, size_t vectorsCount, double *CSE6230_RESTRICT maxPointer) {
+	return search_argmax<isa_avx512f>(pairs_dot<isa_avx512f>(vPointer, uPointer), vectorsCount, maxPointer);
+}
+
+size_t vector3d_query_argmax_avx512f(const double *CSE6230_RESTRICT queryPointer, const double *CSE6230_RESTRICT vectorsPointer, size_t vectorsCount, double *CSE6230_RESTRICT maxPointer) {
+	return search_argmax<isa_avx512f>(query_dot<isa_avx512f>(queryPointer, vectorsPointer), vectorsCount, maxPointer);
+}
+
+size_t vector3d_query_topk_avx512f(const double *CSE6230_RESTRICT queryPointer, const double *CSE6230_RESTRICT vectorsPointer, size_t vectorsCount, size_t k, double *CSE6230_RESTRICT valuesPointer, size_t *CSE6230_RESTRICT indicesPointer) {
+	return search_topk<isa_avx512f>(query_dot<isa_avx512f>(queryPointer, vectorsPointer), vectorsCount, k, valuesPointer, indicesPointer);
+}
+#endif
+
+// The number of set bits in 4-bit masks
+static const size_t filter_counts[16] = { 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4 };
+
+// Writes the dot product to the output position, and advances it only if the dot product passes
+static size_t filter_remaining(const pairs_dot<isa_naive>& dot, size_t start, size_t vectorsCount, double threshold, double* valuesPointer, size_t* indicesPointer, size_t passedCount) {
+	for (size_t i = start; i < vectorsCount; i++) {
+		const double dotProduct = dot.dot_scalar(i);
+		valuesPointer[passedCount] = dotProduct;
+		indicesPointer[passedCount] = i;
+		passedCount += size_t(dotProduct > threshold);
+	}
+	return passedCount;
+}
+
+size_t vector3d_dot_products_filter_naive(const double *CSE6230_RESTRICT vPointer, const double *CSE6230_RESTRICT uPointer, size_t vectorsCount, double threshold, double *CSE6230_RESTRICT valuesPointer, size_t *CSE6230_RESTRICT indicesPointer) {
+	const pairs_dot<isa_naive> dot(vPointer, uPointer);
+	size_t passedCount = 0;
+	for (size_t i = 0; i < vectorsCount; i++) {
+		const double dotProduct = dot.dot_scalar(i);
+		if (dotProduct > threshold) {
+			valuesPointer[passedCount] = dotProduct;
+			indicesPointer[passedCount] = i;
+			passedCount += 1;
+		}
+	}
+	return passedCount;
+}
+
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+// SSE2 has no variable permutation of doubles: the lanes are stored one by one, and the output position is advanced by the mask bits
+size_t vector3d_dot_products_filter_sse2(const double *CSE6230_RESTRICT vPointer, const double *CSE6230_RESTRICT uPointer, size_t vectorsCount, double threshold, double *CSE6230_RESTRICT valuesPointer, size_t *CSE6230_RESTRICT indicesPointer) {
+	const pairs_dot<isa_sse2> dot(vPointer, uPointer);
+	const __m128d thresholdVector = _mm_set1_pd(threshold);
+	size_t passedCount = 0;
+	size_t i = 0;
+	for (; i + 2 <= vectorsCount; i += 2) {
+		const __m128d dotProducts = dot.dot_vector(i);
+		const int mask = _mm_movemask_pd(_mm_cmpgt_pd(dotProducts, thresholdVector));
+		_mm_storel_pd(valuesPointer + passedCount, dotProducts);
+		indicesPointer[passedCount] = i;
+		passedCount += size_t(mask & 1);
+		_mm_storeh_pd(valuesPointer + passedCount, dotProducts);
+		indicesPointer[passedCount] = i + 1;
+		passedCount += size_t(mask >> 1);
+	}
+	// Process remaining elements (if any)
+	return filter_remaining(pairs_dot<isa_naive>(vPointer, uPointer), i, vectorsCount, threshold, valuesPointer, indicesPointer, passedCount);
+}
+#endif
+
+#ifdef CSE6230_AVX2_INTRINSICS_SUPPORTED
+// Indices of 32-bit elements for _mm256_permutevar8x32 which move the passing 64-bit lanes of a 4-bit mask to the front
+static const int32_t filter_permutations[16][8] = {
+	{ 0, 0, 0, 0, 0, 0, 0, 0 },
+	{ 0, 1, 0, 0, 0, 0, 0, 0 },
+	{ 2, 3, 0, 0, 0, 0, 0, 0 },
+	{ 0, 1, 2, 3, 0, 0, 0, 0 },
+	{ 4, 5, 0, 0, 0, 0, 0, 0 },
+	{ 0, 1, 4, 5, 0, 0, 0, 0 },
+	{ 2, 3, 4, 5, 0, 0, 0, 0 },
+	{ 0, 1, 2, 3, 4, 5, 0, 0 },
+	{ 6, 7, 0, 0, 0, 0, 0, 0 },
+	{ 0, 1, 6, 7, 0, 0, 0, 0 },
+	{ 2, 3, 6, 7, 0, 0, 0, 0 },
+	{ 0, 1, 2, 3, 6, 7, 0, 0 },
+	{ 4, 5, 6, 7, 0, 0, 0, 0 },
+	{ 0, 1, 4, 5, 6, 7, 0, 0 },
+	{ 2, 3, 4, 5, 6, 7, 0, 0 },
+	{ 0, 1, 2, 3, 4, 5, 6, 7 },
+};
+
+size_t vector3d_dot_products_filter_avx2(const double *CSE6230_RESTRICT vPointer, const double *CSE6230_RESTRICT uPointer, size_t vectorsCount, double threshold, double *CSE6230_RESTRICT valuesPointer, size_t *CSE6230_RESTRICT indicesPointer) {
+	static_assert(sizeof(size_t) == sizeof(int64_t), "indices are packed as 64-bit elements");
+	const pairs_dot<isa_avx> dot(vPointer, uPointer);
+	const __m256d thresholdVector = _mm256_set1_pd(threshold);
+	const __m256i positionStep = _mm256_set1_epi64x(4);
+	__m256i positions = _mm256_setr_epi64x(0, 1, 2, 3);
+	size_t passedCount = 0;
+	size_t i = 0;
+	for (; i + 4 <= vectorsCount; i += 4) {
+		const __m256d dotProducts = dot.dot_vector(i);
+		const int mask = _mm256_movemask_pd(_mm256_cmp_pd(dotProducts, thresholdVector, _CMP_GT_OQ));
+		const __m256i permutation = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(filter_permutations[mask]));
+		_mm256_storeu_pd(valuesPointer + passedCount, _mm256_castps_pd(_mm256_permutevar8x32_ps(_mm256_castpd_ps(dotProducts), permutation)));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(indicesPointer + passedCount), _mm256_permutevar8x32_epi32(positions, permutation));
+		passedCount += filter_counts[mask];
+		positions = _mm256_add_epi64(positions, positionStep);
+	}
+	// Process remaining elements (if any)
+	return filter_remaining(pairs_dot<isa_naive>(vPointer, uPointer), i, vectorsCount, threshold, valuesPointer, indicesPointer, passedCount);
+}
+#endif
+
+#ifdef CSE6230_AVX512F_INTRINSICS_SUPPORTED
+// Compresses in registers and stores full vectors: compressing stores to memory are much slower on some processors
+size_t vector3d_dot_products_filter_avx512f(const double *CSE6230_RESTRICT vPointer, const double *CSE6230_RESTRICT uPointer, size_t vectorsCount, double threshold, double *CSE6230_RESTRICT valuesPointer, size_t *CSE6230_RESTRICT indicesPointer) {
+	static_assert(sizeof(size_t) == sizeof(int64_t), "indices are packed as 64-bit elements");
+	const pairs_dot<isa_avx512f> dot(vPointer, uPointer);
+	const __m512d thresholdVector = _mm512_set1_pd(threshold);
+	const __m512i positionStep = _mm512_set1_epi64(8);
+	__m512i positions = _mm512_setr_epi64(0, 1, 2, 3, 4, 5, 6, 7);
+	size_t passedCount = 0;
+	size_t i = 0;
+	for (; i + 8 <= vectorsCount; i += 8) {
+		const __m512d dotProducts = dot.dot_vector(i);
+		const __mmask8 mask = _mm512_cmp_pd_mask(dotProducts, thresholdVector, _CMP_GT_OQ);
+		_mm512_storeu_pd(valuesPointer + passedCount, _mm512_maskz_compress_pd(mask, dotProducts));
+		_mm512_storeu_si512(indicesPointer + passedCount, _mm512_maskz_compress_epi64(mask, positions));
+		passedCount += filter_counts[mask & 15] + filter_counts[mask >> 4];
+		positions = _mm512_add_epi64(positions, positionStep);
+	}
+	// Process remaining elements (if any)
+	return filter_remaining(pairs_dot<isa_naive>(vPointer, uPointer), i, vectorsCount, threshold, valuesPointer, indicesPointer, passedCount);
+}
+#endif
+
+// Every thread should get enough vectors to amortize its start
+static const size_t search_min_vectors_per_thread = 4096;
+
+static size_t search_threads_count(size_t threadsCount, size_t vectorsCount) {
+	if (threadsCount == 0) {
+		threadsCount = std::thread::hardware_concurrency();
+	}
+	const size_t maxThreadsCount = vectorsCount / search_min_vectors_per_thread;
+	if (threadsCount > maxThreadsCount) {
+		threadsCount = maxThreadsCount;
+	}
+	return threadsCount;
+}
+
+// Calls searchPart(part) for every part on its own thread. The calling thread processes the first part.
+template <typename SearchPart>
+static void search_parts(const SearchPart& searchPart, size_t threadsCount) {
+	std::vector<std::thread> threads;
+	for (size_t part = 1; part < threadsCount; part++) {
+		threads.push_back(std::thread(searchPart, part));
+	}
+	searchPart(0);
+	for (size_t thread = 0; thread < threads.size(); thread++) {
+		threads[thread].join();
+	}
+}
+
+// Merges the maxima of the parts in order, so the earlier part wins ties
+static size_t merge_argmax(const std::vector<double>& maxes, const std::vector<size_t>& indices, double* maxPointer) {
+	double max = maxes[0];
+	size_t maxIndex = indices[0];
+	for (size_t part = 1; part < maxes.size(); part++) {
+		if (maxes[part] > max) {
+			max = maxes[part];
+			maxIndex = indices[part];
+		}
+	}
+	*maxPointer = max;
+	return maxIndex;
+}
+
+size_t vector3d_dot_products_argmax_parallel(vector3d_dot_products_argmax_function argmax, const double *CSE6230_RESTRICT vPointer, const double *CSE6230_RESTRICT uPointer, size_t vectorsCount, double *CSE6230_RESTRICT maxPointer, size_t threadsCount) {
+	threadsCount = search_threads_count(threadsCount, vectorsCount);
+	if (threadsCount <= 1) {
+		return argmax(vPointer, uPointer, vectorsCount, maxPointer);
+	}
+
+	std::vector<double> maxes(threadsCount);
+	std::vector<size_t> indices(threadsCount);
+	const auto searchPart = [argmax, vPointer, uPointer, vectorsCount, threadsCount, &maxes, &indices](size_t part) {
+		const size_t partStart = vectorsCount * part / threadsCount;
+		const size_t partEnd = vectorsCount * (part + 1) / threadsCount;
+		indices[part] = partStart + argmax(vPointer + 3 * partStart, uPointer + 3 * partStart, partEnd - partStart, &maxes[part]);
+	};
+	search_parts(searchPart, threadsCount);
+	return merge_argmax(maxes, indices, maxPointer);
+}
+
+size_t vector3d_query_argmax_parallel(vector3d_query_argmax_function argmax, const double *CSE6230_RESTRICT queryPointer, const double *CSE6230_RESTRICT vectorsPointer, size_t vectorsCount, double *CSE6230_RESTRICT maxPointer, size_t threadsCount) {
+	threadsCount = search_threads_count(threadsCount, vectorsCount);
+	if (threadsCount <= 1) {
+		return argmax(queryPointer, vectorsPointer, vectorsCount, maxPointer);
+	}
+
+	std::vector<double> maxes(threadsCount);
+	std::vector<size_t> indices(threadsCount);
+	const auto searchPart = [argmax, queryPointer, vectorsPointer, vectorsCount, threadsCount, &maxes, &indices](size_t part) {
+		const size_t partStart = vectorsCount * part / threadsCount;
+		const size_t partEnd = vectorsCount * (part + 1) / threadsCount;
+		indices[part] = partStart + argmax(queryPointer, vectorsPointer + 3 * partStart, partEnd - partStart, &maxes[part]);
+	};
+	search_parts(searchPart, threadsCount);
+	return merge_argmax(maxes, indices, maxPointer);
+}
+
+// Part of the vectors for one thread of vector3d_query_topk_parallel
+struct search_topk_part {
+	double values[vector3d_query_topk_max_k];
+	size_t indices[vector3d_query_topk_max_k];
+	size_t count;
+};
+
+size_t vector3d_query_topk_parallel(vector3d_query_topk_function topk, const double *CSE6230_RESTRICT queryPointer, const double *CSE6230_RESTRICT vectorsPointer, size_t vectorsCount, size_t k, double *CSE6230_RESTRICT valuesPointer, size_t *CSE6230_RESTRICT indicesPointer, size_t threadsCount) {
+	if ((k == 0) || (k > vector3d_query_topk_max_k)) {
+		return 0;
+	}
+	threadsCount = search_threads_count(threadsCount, vectorsCount);
+	if (threadsCount <= 1) {
+		return topk(queryPointer, vectorsPointer, vectorsCount, k, valuesPointer, indicesPointer);
+	}
+
+	std::vector<search_topk_part> parts(threadsCount);
+	const auto searchPart = [topk, queryPointer, vectorsPointer, vectorsCount, k, threadsCount, &parts](size_t part) {
+		const size_t partStart = vectorsCount * part / threadsCount;
+		const size_t partEnd = vectorsCount * (part + 1) / threadsCount;
+		parts[part].count = topk(queryPointer, vectorsPointer + 3 * partStart, partEnd - partStart, k, parts[part].values, parts[part].indices);
+		for (size_t i = 0; i < parts[part].count; i++) {
+			parts[part].indices[i] += partStart;
+		}
+	};
+	search_parts(searchPart, threadsCount);
+
+	search_buffer buffer(k);
+	for (size_t part = 0; part < threadsCount; part++) {
+		for (size_t i = 0; i < parts[part].count; i++) {
+			buffer.insert(parts[part].values[i], parts[part].indices[i]);
+		}
+	}
+	return buffer.store(valuesPointer, indicesPointer);
+}
@@ -0,0 +1,106 @@
+/******************************************************************************\
+ *                                                                            *
+ * Copyright (c) 2012 Marat Dukhan                                            *
+ *                                                                            *
+ * This software is provided 'as-is', without any express or implied          *
+ * warranty. In no event will the authors be held liable for any damages      *
+ * arising from the use of this software.                                     *
+ *                                                                            *
+ * Permission is granted to anyone to use this software for any purpose,      *
+ * including commercial applications, and to alter it and redistribute it     *
+ * freely, subject to the following restrictions:                             *
+ *                                                                            *
+ * 1. The origin of this software must not be misrepresented; you must not    *
+ * claim that you wrote the original software. If you use this software       *
+ * in a product, an acknowledgment in the product documentation would be      *
+ * appreciated but is not required.                                           *
+ *                                                                            *
+ * 2. Altered source versions must be plainly marked as such, and must not be *
+ * misrepresented as being the original software.                             *
+ *                                                                            *
+ * 3. This notice may not be removed or altered from any source               *
+ * distribution.                                                              *
+ *                                                                            *
+\******************************************************************************/
+
+#pragma once
+
+#include <compute.hpp>
+#include <typed.hpp>
+
+// Maximum inner product search over 3D vectors: the dot products are computed and reduced in SIMD registers,
+// without writing them to an output array.
+// Every dot product is computed as (x * x' + y * y') + z * z'. SIMD versions load several 3D vectors at once and
+// transpose them into vectors of x, y and z components, and keep the running maxima and their indices in every lane.
+// Of equal dot products, the one with the smaller index wins. NaN dot products are not supported.
+
+// Returns the index of the maximum of the dot products of vPointer[i] and uPointer[i], and stores the maximum to *maxPointer.
+// Returns SIZE_MAX and stores -infinity if vectorsCount is 0.
+typedef size_t (*vector3d_dot_products_argmax_function)(const double*, const double*, size_t, double*);
+
+extern "C" size_t vector3d_dot_products_argmax_naive(const double *CSE6230_RESTRICT vPointer, const double *CSE6230_RESTRICT uPointer, size_t vectorsCount, double *CSE6230_RESTRICT maxPointer);
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+extern "C" size_t vector3d_dot_products_argmax_sse2(const double *CSE6230_RESTRICT vPointer, const double *CSE6230_RESTRICT uPointer, size_t vectorsCount, double *CSE6230_RESTRICT maxPointer);
+#endif
+#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+extern "C" size_t vector3d_dot_products_argmax_avx(const double *CSE6230_RESTRICT vPointer, const double *CSE6230_RESTRICT uPointer, size_t vectorsCount, double *CSE6230_RESTRICT maxPointer);
+#endif
+#ifdef CSE6230_AVX512F_INTRINSICS_SUPPORTED
+extern "C" size_t vector3d_dot_products_argmax_avx512f(const double *CSE6230_RESTRICT vPointer, const double *CSE6230_RESTRICT uPointer, size_t vectorsCount, double *CSE6230_RESTRICT maxPointer);
+#endif
+
+// Returns the index of the vector with the maximum dot product with the 3D query vector, and stores the maximum to *maxPointer.
+// Returns SIZE_MAX and stores -infinity if vectorsCount is 0.
+typedef size_t (*vector3d_query_argmax_function)(const double*, const double*, size_t, double*);
+
+extern "C" size_t vector3d_query_argmax_naive(const double *CSE6230_RESTRICT queryPointer, const double *CSE6230_RESTRICT vectorsPointer, size_t vectorsCount, double *CSE6230_RESTRICT maxPointer);
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+extern "C" size_t vector3d_query_argmax_sse2(const double *CSE6230_RESTRICT queryPointer, const double *CSE6230_RESTRICT vectorsPointer, size_t vectorsCount, double *CSE6230_RESTRICT maxPointer);
+#endif
+#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+extern "C" size_t vector3d_query_argmax_avx(const double *CSE6230_RESTRICT queryPointer, const double *CSE6230_RESTRICT vectorsPointer, size_t vectorsCount, double *CSE6230_RESTRICT maxPointer);
+#endif
+#ifdef CSE6230_AVX512F_INTRINSICS_SUPPORTED
+extern "C" size_t vector3d_query_argmax_avx512f(const double *CSE6230_RESTRICT queryPointer, const double *CSE6230_RESTRICT vectorsPointer, size_t vectorsCount, double *CSE6230_RESTRICT maxPointer);
+#endif
+
+// Writes the k largest dot products with the 3D query vector in descending order to valuesPointer, and the indices of
+// their vectors to indicesPointer. Supports 1 <= k <= vector3d_query_topk_max_k.
+// Returns the number of written results, i.e. min(k, vectorsCount), or 0 if k is not supported.
+static const size_t vector3d_query_topk_max_k = 64;
+
+typedef size_t (*vector3d_query_topk_function)(const double*, const double*, size_t, size_t, double*, size_t*);
+
+extern "C" size_t vector3d_query_topk_naive(const double *CSE6230_RESTRICT queryPointer, const double *CSE6230_RESTRICT vectorsPointer, size_t vectorsCount, size_t k, double *CSE6230_RESTRICT valuesPointer, size_t *CSE6230_RESTRICT indicesPointer);
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+extern "C" size_t vector3d_query_topk_sse2(const double *CSE6230_RESTRICT queryPointer, const double *CSE6230_RESTRICT vectorsPointer, size_t vectorsCount, size_t k, double *CSE6230_RESTRICT valuesPointer, size_t *CSE6230_RESTRICT indicesPointer);
+#endif
+#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+extern "C" size_t vector3d_query_topk_avx(const double *CSE6230_RESTRICT queryPointer, const double *CSE6230_RESTRICT vectorsPointer, size_t vectorsCount, size_t k, double *CSE6230_RESTRICT valuesPointer, size_t *CSE6230_RESTRICT indicesPointer);
+#endif
+#ifdef CSE6230_AVX512F_INTRINSICS_SUPPORTED
+extern "C" size_t vector3d_query_topk_avx512f(const double *CSE6230_RESTRICT queryPointer, const double *CSE6230_RESTRICT vectorsPointer, size_t vectorsCount, size_t k, double *CSE6230_RESTRICT valuesPointer, size_t *CSE6230_RESTRICT indicesPointer);
+#endif
+
+// Writes the dot products of vPointer[i] and uPointer[i] which are greater than the threshold to valuesPointer, and their indices
+// to indicesPointer, densely packed in the order of indices. Both output arrays must have space for vectorsCount elements:
+// SIMD versions write full vectors at the output position and then advance it only by the number of passing dot products.
+// Returns the number of passing dot products.
+typedef size_t (*vector3d_dot_products_filter_function)(const double*, const double*, size_t, double, double*, size_t*);
+
+extern "C" size_t vector3d_dot_products_filter_naive(const double *CSE6230_RESTRICT vPointer, const double *CSE6230_RESTRICT uPointer, size_t vectorsCount, double threshold, double *CSE6230_RESTRICT valuesPointer, size_t *CSE6230_RESTRICT indicesPointer);
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+extern "C" size_t vector3d_dot_products_filter_sse2(const double *CSE6230_RESTRICT vPointer, const double *CSE6230_RESTRICT uPointer, size_t vectorsCount, double threshold, double *CSE6230_RESTRICT valuesPointer, size_t *CSE6230_RESTRICT indicesPointer);
+#endif
+#ifdef CSE6230_AVX2_INTRINSICS_SUPPORTED
+extern "C" size_t vector3d_dot_products_filter_avx2(const double *CSE6230_RESTRICT vPointer, const double *CSE6230_RESTRICT uPointer, size_t vectorsCount, double threshold, double *CSE6230_RESTRICT valuesPointer, size_t *CSE6230_RESTRICT indicesPointer);
+#endif
+#ifdef CSE6230_AVX512F_INTRINSICS_SUPPORTED
+extern "C" size_t vector3d_dot_products_filter_avx512f(const double *CSE6230_RESTRICT vPointer, const double *CSE6230_RESTRICT uPointer, size_t vectorsCount, double threshold, double *CSE6230_RESTRICT valuesPointer, size_t *CSE6230_RESTRICT indicesPointer);
+#endif
+
+// Split the vectors into threadsCount parts (0 = all CPUs), search every part with the function on its own thread,
+// and merge the results. The results are the same as from the function on all vectors.
+extern "C" size_t vector3d_dot_products_argmax_parallel(vector3d_dot_products_argmax_function argmax, const double *CSE6230_RESTRICT vPointer, const double *CSE6230_RESTRICT uPointer, size_t vectorsCount, double *CSE6230_RESTRICT maxPointer, size_t threadsCount);
+extern "C" size_t vector3d_query_argmax_parallel(vector3d_query_argmax_function argmax, const double *CSE6230_RESTRICT queryPointer, const double *CSE6230_RESTRICT vectorsPointer, size_t vectorsCount, double *CSE6230_RESTRICT maxPointer, size_t threadsCount);
+extern "C" size_t vector3d_query_topk_parallel(vector3d_query_topk_function topk, const double *CSE6230_RESTRICT queryPointer, const double *CSE6230_RESTRICT vectorsPointer, size_t vectorsCount, size_t k, double *CSE6230_RESTRICT valuesPointer, size_t *CSE6230_RESTRICT indicesPointer, size_t threadsCount);
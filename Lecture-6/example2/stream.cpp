@@ -0,0 +1,72 @@
+/******************************************************************************\
+ *                                                                            *
+ * Copyright (c) 2012 Marat Dukhan                                            *
+ *                                                                            *
+ * This software is provided 'as-is', without any express or implied          *
+ * warranty. In no event will the authors be held liable for any damages      *
+ * arising from the use of this software.                                     *
+ *                                                                            *
+ * Permission is granted to anyone to use this software for any purpose,      *
+ * including commercial applications, and to alter it and redistribute it     *
+ * freely, subject to the following restrictions:                             *
+ *                                                                            *
+ * 1. The origin of this software must not be misrepresented; you must not    *
+ * claim that you wrote the original software. If you use this software       *
+ * in a product, an acknowledgment in the product documentation would be      *
+ * appreciated but is not required.                                           *
+ *                                                                            *
+ * 2. Altered source versions must be plainly marked as such, and must not be *
+ * misrepresented as being the original software.                             *
+ *                                                                            *
+ * 3. This notice may not be removed or altered from any source               *
+ * distribution.                                                              *
+ *                                                                            *
+\******************************************************************************/
+
+#include <stream.hpp>
+#include <stream_chunks.hpp>
+#include <stdlib.h>
+
+struct stream_dot_products_context {
+	vector3d_dot_products_function vector3d_dot_products;
+	int dpFile;
+	double* dpChunk;
+	double runningSum;
+};
+
+static bool dot_products_chunk(void* context, const double* const* inputs, size_t chunkStart, size_t chunkLength) {
+	stream_dot_products_context* dotProductsContext = static_cast<stream_dot_products_context*>(context);
+	double* dpChunk = dotProductsContext->dpChunk;
+	dotProductsContext->vector3d_dot_products(inputs[0], inputs[1], dpChunk, chunkLength);
+	double chunkSum = 0.0;
+	for (size_t i = 0; i < chunkLength; i++) {
+		chunkSum += dpChunk[i];
+	}
+	dotProductsContext->runningSum += chunkSum;
+	if (dotProductsContext->dpFile < 0) {
+		return true;
+	}
+	return write_fully(dotProductsContext->dpFile, dpChunk, chunkLength * sizeof(double), off_t(chunkStart * sizeof(double)));
+}
+
+bool stream_vector3d_dot_products(int vFile, int uFile, int dpFile, size_t vectorsCount, vector3d_dot_products_function vector3d_dot_products, size_t chunkLength, double* sumPointer) {
+	if (chunkLength == 0) {
+		chunkLength = stream_default_chunk_length;
+	}
+	stream_dot_products_context context;
+	context.vector3d_dot_products = vector3d_dot_products;
+	context.dpFile = dpFile;
+	context.runningSum = 0.0;
+	context.dpChunk = static_cast<double*>(malloc(chunkLength * sizeof(double)));
+	if (context.dpChunk == NULL) {
+		return false;
+	}
+	const int files[2] = { vFile, uFile };
+	const size_t components[2] = { 3, 3 };
+	const bool succeeded = stream_chunks(files, components, 2, vectorsCount, chunkLength, dot_products_chunk, &context);
+	free(context.dpChunk);
+	if (succeeded && (sumPointer != NULL)) {
+		*sumPointer = context.runningSum;
+	}
+	return succeeded;
+}
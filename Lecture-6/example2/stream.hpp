@@ -0,0 +1,39 @@
+/******************************************************************************\
+ *                                                                            *
+ * Copyright (c) 2012 Marat Dukhan                                            *
+ *                                                                            *
+ * This software is provided 'as-is', without any express or implied          *
+ * warranty. In no event will the authors be held liable for any damages      *
+ * arising from the use of this software.                                     *
+ *                                                                            *
+ * Permission is granted to anyone to use this software for any purpose,      *
+ * including commercial applications, and to alter it and redistribute it     *
+ * freely, subject to the following restrictions:                             *
+ *                                                                            *
+ * 1. The origin of this software must not be misrepresented; you must not    *
+ * claim that you wrote the original software. If you use this software       *
+ * in a product, an acknowledgment in the product documentation would be      *
+ * appreciated but is not required.                                           *
+ *                                                                            *
+ * 2. Altered source versions must be plainly marked as such, and must not be *
+ * misrepresented as being the original software.                             *
+ *                                                                            *
+ * 3. This notice may not be removed or altered from any source               *
+ * distribution.                                                              *
+ *                                                                            *
+\******************************************************************************/
+
+#pragma once
+
+#include <compute.hpp>
+
+// Out-of-core execution of vector3d_dot_products on arrays of 3D vectors stored in files.
+// A reader thread loads the next chunk of the inputs with pread into one half of a double buffer while the
+// calling thread runs the kernel on the other half, and the running sum of dot products is carried from chunk to chunk.
+// Arrays start at offset 0 of their files. chunkLength is the number of vectors per chunk (0 = 1M vectors);
+// chunk buffers are page-aligned, so files opened with O_DIRECT work if chunkLength is a multiple of 512: then every chunk
+// starts on a 4 KiB boundary, and the read of the last, partial chunk is rounded up to 512 bytes and trimmed to the array.
+// Returns false if an input can not be read in full or the output can not be written.
+
+// Writes the dot products to dpFile, unless it is negative, and their sum to *sumPointer, unless it is NULL
+extern "C" bool stream_vector3d_dot_products(int vFile, int uFile, int dpFile, size_t vectorsCount, vector3d_dot_products_function vector3d_dot_products, size_t chunkLength, double* sumPointer);
@@ -0,0 +1,408 @@
+/******************************************************************************\
+ *                                                                            *
+ * Copyright (c) 2012 Marat Dukhan                                            *
+ *                                                                            *
+ * This software is provided 'as-is', without any express or implied          *
+ * warranty. In no event will the authors be held liable for any damages      *
+ * arising from the use of this software.                                     *
+ *                                                                            *
+ * Permission is granted to anyone to use this software for any purpose,      *
+ * including commercial applications, and to alter it and redistribute it     *
+ * freely, subject to the following restrictions:                             *
+ *                                                                            *
+ * 1. The origin of this software must not be misrepresented; you must not    *
+ * claim that you wrote the original software. If you use this software       *
+ * in a product, an acknowledgment in the product documentation would be      *
+ * appreciated but is not required.                                           *
+ *                                                                            *
+ * 2. Altered source versions must be plainly marked as such, and must not be *
+ * misrepresented as being the original software.                             *
+ *                                                                            *
+ * 3. This notice may not be removed or altered from any source               *
+ * distribution.                                                              *
+ *                                                                            *
+\******************************************************************************/
+
+#include <typed.hpp>
+#include <transpose.hpp>
+#if defined(CSE6230_SSE2_INTRINSICS_SUPPORTED) || defined(CSE6230_AVX_INTRINSICS_SUPPORTED)
+	#if defined(__GNUC__)
+		#include <x86intrin.h>
+	#elif defined(_MSC_VER)
+		#include <intrin.h>
+	#else
+		#error Intrinsics headers are not included: unknown compiler
+	#endif
+#endif
+
+// Scalar dot products. Integer products wrap in unsigned arithmetic because signed overflow is undefined in C++.
+
+inline static float scalar_dot_product(const float* vPointer, const float* uPointer) {
+	return vPointer[0] * uPointer[0] + vPointer[1] * uPointer[1] + vPointer[2] * uPointer[2];
+}
+
+inline static int32_t scalar_dot_product(const int32_t* vPointer, const int32_t* uPointer) {
+	return int32_t(uint32_t(vPointer[0]) * uint32_t(uPointer[0]) + uint32_t(vPointer[1]) * uint32_t(uPointer[1]) + uint32_t(vPointer[2]) * uint32_t(uPointer[2]));
+}
+
+inline static int64_t scalar_dot_product(const int64_t* vPointer, const int64_t* uPointer) {
+	return int64_t(uint64_t(vPointer[0]) * uint64_t(uPointer[0]) + uint64_t(vPointer[1]) * uint64_t(uPointer[1]) + uint64_t(vPointer[2]) * uint64_t(uPointer[2]));
+}
+
+inline static float scalar_dot_product(const bfloat16* vPointer, const bfloat16* uPointer) {
+	return bfloat16_to_float(vPointer[0]) * bfloat16_to_float(uPointer[0]) +
+		bfloat16_to_float(vPointer[1]) * bfloat16_to_float(uPointer[1]) +
+		bfloat16_to_float(vPointer[2]) * bfloat16_to_float(uPointer[2]);
+}
+
+// SIMD operations: each specialization defines the vector type, the number of 3D vectors processed at once (width),
+// load3 which loads width 3D vectors and transposes them into X, Y and Z component vectors, mul, add and store.
+
+template <typename T, typename ISA>
+struct simd3;
+
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+// Transposes two 3D vectors stored as x0 y0 | z0 x1 | y1 z1
+inline static void sse2_transpose3_pd(__m128d a, __m128d b, __m128d c, __m128d& x, __m128d& y, __m128d& z) {
+	x = _mm_shuffle_pd(a, b, 2);
+	y = _mm_shuffle_pd(a, c, 1);
+	z = _mm_shuffle_pd(b, c, 2);
+}
+
+inline static void sse2_load3_ps(const float* pointer, __m128& x, __m128& y, __m128& z) {
+	transpose3_ps(_mm_loadu_ps(pointer), _mm_loadu_ps(pointer + 4), _mm_loadu_ps(pointer + 8), x, y, z);
+}
+
+inline static void sse2_load3_epi32(const int32_t* pointer, __m128i& x, __m128i& y, __m128i& z) {
+	__m128 xFloat, yFloat, zFloat;
+	sse2_load3_ps((const float*)pointer, xFloat, yFloat, zFloat);
+	x = _mm_castps_si128(xFloat);
+	y = _mm_castps_si128(yFloat);
+	z = _mm_castps_si128(zFloat);
+}
+
+inline static void sse2_load3_epi64(const int64_t* pointer, __m128i& x, __m128i& y, __m128i& z) {
+	__m128d xDouble, yDouble, zDouble;
+	sse2_transpose3_pd(_mm_loadu_pd((const double*)pointer), _mm_loadu_pd((const double*)pointer + 2), _mm_loadu_pd((const double*)pointer + 4), xDouble, yDouble, zDouble);
+	x = _mm_castpd_si128(xDouble);
+	y = _mm_castpd_si128(yDouble);
+	z = _mm_castpd_si128(zDouble);
+}
+
+inline static void sse2_load3_bf16(const bfloat16* pointer, __m128& x, __m128& y, __m128& z) {
+	const __m128i bits01 = _mm_loadu_si128((const __m128i*)pointer);
+	const __m128i bits2 = _mm_loadl_epi64((const __m128i*)(pointer + 8));
+	const __m128i zero = _mm_setzero_si128();
+	transpose3_ps(
+		_mm_castsi128_ps(_mm_unpacklo_epi16(zero, bits01)),
+		_mm_castsi128_ps(_mm_unpackhi_epi16(zero, bits01)),
+		_mm_castsi128_ps(_mm_unpacklo_epi16(zero, bits2)),
+		x, y, z);
+}
+
+// Low 32 bits of the products of 32-bit elements (SSE2 has no pmulld)
+inline static __m128i sse2_mullo_epi32(__m128i a, __m128i b) {
+	const __m128i productsEven = _mm_mul_epu32(a, b);
+	const __m128i productsOdd = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+	return _mm_unpacklo_epi32(_mm_shuffle_epi32(productsEven, _MM_SHUFFLE(0, 0, 2, 0)), _mm_shuffle_epi32(productsOdd, _MM_SHUFFLE(0, 0, 2, 0)));
+}
+
+// Low 64 bits of the products of 64-bit elements: lo(a) * lo(b) + ((hi(a) * lo(b) + lo(a) * hi(b)) << 32)
+inline static __m128i sse2_mullo_epi64(__m128i a, __m128i b) {
+	const __m128i low = _mm_mul_epu32(a, b);
+	const __m128i cross = _mm_add_epi64(_mm_mul_epu32(_mm_srli_epi64(a, 32), b), _mm_mul_epu32(a, _mm_srli_epi64(b, 32)));
+	return _mm_add_epi64(low, _mm_slli_epi64(cross, 32));
+}
+
+template <>
+struct simd3<float, isa_sse2> {
+	typedef __m128 vector;
+	static const size_t width = 4;
+
+	static void load3(const float* pointer, vector& x, vector& y, vector& z) { sse2_load3_ps(pointer, x, y, z); }
+	static vector mul(vector a, vector b) { return _mm_mul_ps(a, b); }
+	static vector add(vector a, vector b) { return _mm_add_ps(a, b); }
+	static void store(float* pointer, vector x) { _mm_storeu_ps(pointer, x); }
+};
+
+template <>
+struct simd3<int32_t, isa_sse2> {
+	typedef __m128i vector;
+	static const size_t width = 4;
+
+	static void load3(const int32_t* pointer, vector& x, vector& y, vector& z) { sse2_load3_epi32(pointer, x, y, z); }
+	static vector mul(vector a, vector b) { return sse2_mullo_epi32(a, b); }
+	static vector add(vector a, vector b) { return _mm_add_epi32(a, b); }
+	static void store(int32_t* pointer, vector x) { _mm_storeu_si128((__m128i*)pointer, x); }
+};
+
+template <>
+struct simd3<int64_t, isa_sse2> {
+	typedef __m128i vector;
+	static const size_t width = 2;
+
+	static void load3(const int64_t* pointer, vector& x, vector& y, vector& z) { sse2_load3_epi64(pointer, x, y, z); }
+	static vector mul(vector a, vector b) { return sse2_mullo_epi64(a, b); }
+	static vector add(vector a, vector b) { return _mm_add_epi64(a, b); }
+	static void store(int64_t* pointer, vector x) { _mm_storeu_si128((__m128i*)pointer, x); }
+};
+
+template <>
+struct simd3<bfloat16, isa_sse2> : simd3<float, isa_sse2> {
+	static void load3(const bfloat16* pointer, vector& x, vector& y, vector& z) { sse2_load3_bf16(pointer, x, y, z); }
+};
+#endif
+
+#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+// 256-bit transposes are done as two 128-bit transposes of the low and high four 3D vectors
+template <>
+struct simd3<float, isa_avx> {
+	typedef __m256 vector;
+	static const size_t width = 8;
+
+	static void load3(const float* pointer, vector& x, vector& y, vector& z) {
+		__m128 xLow, yLow, zLow, xHigh, yHigh, zHigh;
+		sse2_load3_ps(pointer, xLow, yLow, zLow);
+		sse2_load3_ps(pointer + 12, xHigh, yHigh, zHigh);
+		x = _mm256_insertf128_ps(_mm256_castps128_ps256(xLow), xHigh, 1);
+		y = _mm256_insertf128_ps(_mm256_castps128_ps256(yLow), yHigh, 1);
+		z = _mm256_insertf128_ps(_mm256_castps128_ps256(zLow), zHigh, 1);
+	}
+	static vector mul(vector a, vector b) { return _mm256_mul_ps(a, b); }
+	static vector add(vector a, vector b) { return _mm256_add_ps(a, b); }
+	static void store(float* pointer, vector x) { _mm256_storeu_ps(pointer, x); }
+};
+
+template <>
+struct simd3<bfloat16, isa_avx> : simd3<float, isa_avx> {
+	static void load3(const bfloat16* pointer, vector& x, vector& y, vector& z) {
+		__m128 xLow, yLow, zLow, xHigh, yHigh, zHigh;
+		sse2_load3_bf16(pointer, xLow, yLow, zLow);
+		sse2_load3_bf16(pointer + 12, xHigh, yHigh, zHigh);
+		x = _mm256_insertf128_ps(_mm256_castps128_ps256(xLow), xHigh, 1);
+		y = _mm256_insertf128_ps(_mm256_castps128_ps256(yLow), yHigh, 1);
+		z = _mm256_insertf128_ps(_mm256_castps128_ps256(zLow), zHigh, 1);
+	}
+};
+#endif
+
+#ifdef CSE6230_AVX2_INTRINSICS_SUPPORTED
+template <> struct simd3<float, isa_avx2> : simd3<float, isa_avx> {};
+template <> struct simd3<bfloat16, isa_avx2> : simd3<bfloat16, isa_avx> {};
+
+inline static __m256i avx2_combine(__m128i low, __m128i high) {
+	return _mm256_inserti128_si256(_mm256_castsi128_si256(low), high, 1);
+}
+
+template <>
+struct simd3<int32_t, isa_avx2> {
+	typedef __m256i vector;
+	static const size_t width = 8;
+
+	static void load3(const int32_t* pointer, vector& x, vector& y, vector& z) {
+		__m128i xLow, yLow, zLow, xHigh, yHigh, zHigh;
+		sse2_load3_epi32(pointer, xLow, yLow, zLow);
+		sse2_load3_epi32(pointer + 12, xHigh, yHigh, zHigh);
+		x = avx2_combine(xLow, xHigh);
+		y = avx2_combine(yLow, yHigh);
+		z = avx2_combine(zLow, zHigh);
+	}
+	static vector mul(vector a, vector b) { return _mm256_mullo_epi32(a, b); }
+	static vector add(vector a, vector b) { return _mm256_add_epi32(a, b); }
+	static void store(int32_t* pointer, vector x) { _mm256_storeu_si256((__m256i*)pointer, x); }
+};
+
+template <>
+struct simd3<int64_t, isa_avx2> {
+	typedef __m256i vector;
+	static const size_t width = 4;
+
+	static void load3(const int64_t* pointer, vector& x, vector& y, vector& z) {
+		__m128i xLow, yLow, zLow, xHigh, yHigh, zHigh;
+		sse2_load3_epi64(pointer, xLow, yLow, zLow);
+		sse2_load3_epi64(pointer + 6, xHigh, yHigh, zHigh);
+		x = avx2_combine(xLow, xHigh);
+		y = avx2_combine(yLow, yHigh);
+		z = avx2_combine(zLow, zHigh);
+	}
+	static vector mul(vector a, vector b) {
+		const __m256i low = _mm256_mul_epu32(a, b);
+		const __m256i cross = _mm256_add_epi64(_mm256_mul_epu32(_mm256_srli_epi64(a, 32), b), _mm256_mul_epu32(a, _mm256_srli_epi64(b, 32)));
+		return _mm256_add_epi64(low, _mm256_slli_epi64(cross, 32));
+	}
+	static vector add(vector a, vector b) { return _mm256_add_epi64(a, b); }
+	static void store(int64_t* pointer, vector x) { _mm256_storeu_si256((__m256i*)pointer, x); }
+};
+#endif
+
+#ifdef CSE6230_AVX512F_INTRINSICS_SUPPORTED
+// Element i of component C is element 3 * i + C of the concatenation a | b | c. The first permute gathers the elements
+// which are in a | b, and the second one replaces the rest with elements of c.
+#define CSE6230_AVX512_FIRST_INDEX(i, C, N) (((3 * (i) + (C)) < 2 * (N)) ? (3 * (i) + (C)) : 0)
+#define CSE6230_AVX512_SECOND_INDEX(i, C, N) (((3 * (i) + (C)) < 2 * (N)) ? (i) : (N) + (3 * (i) + (C) - 2 * (N)))
+
+template <int C>
+inline static __m512 avx512f_extract3_ps(__m512 a, __m512 b, __m512 c) {
+	#define CSE6230_FIRST(i) CSE6230_AVX512_FIRST_INDEX(i, C, 16)
+	#define CSE6230_SECOND(i) CSE6230_AVX512_SECOND_INDEX(i, C, 16)
+	const __m512i firstIndex = _mm512_set_epi32(
+		CSE6230_FIRST(15), CSE6230_FIRST(14), CSE6230_FIRST(13), CSE6230_FIRST(12), CSE6230_FIRST(11), CSE6230_FIRST(10), CSE6230_FIRST(9), CSE6230_FIRST(8),
+		CSE6230_FIRST(7), CSE6230_FIRST(6), CSE6230_FIRST(5), CSE6230_FIRST(4), CSE6230_FIRST(3), CSE6230_FIRST(2), CSE6230_FIRST(1), CSE6230_FIRST(0));
+	const __m512i secondIndex = _mm512_set_epi32(
+		CSE6230_SECOND(15), CSE6230_SECOND(14), CSE6230_SECOND(13), CSE6230_SECOND(12), CSE6230_SECOND(11), CSE6230_SECOND(10), CSE6230_SECOND(9), CSE6230_SECOND(8),
+		CSE6230_SECOND(7), CSE6230_SECOND(6), CSE6230_SECOND(5), CSE6230_SECOND(4), CSE6230_SECOND(3), CSE6230_SECOND(2), CSE6230_SECOND(1), CSE6230_SECOND(0));
+	#undef CSE6230_FIRST
+	#undef CSE6230_SECOND
+	return _mm512_permutex2var_ps(_mm512_permutex2var_ps(a, firstIndex, b), secondIndex, c);
+}
+
+template <int C>
+inline static __m512i avx512f_extract3_epi64(__m512i a, __m512i b, __m512i c) {
+	#define CSE6230_FIRST(i) CSE6230_AVX512_FIRST_INDEX(i, C, 8)
+	#define CSE6230_SECOND(i) CSE6230_AVX512_SECOND_INDEX(i, C, 8)
+	const __m512i firstIndex = _mm512_set_epi64(
+		CSE6230_FIRST(7), CSE6230_FIRST(6), CSE6230_FIRST(5), CSE6230_FIRST(4), CSE6230_FIRST(3), CSE6230_FIRST(2), CSE6230_FIRST(1), CSE6230_FIRST(0));
+	const __m512i secondIndex = _mm512_set_epi64(
+		CSE6230_SECOND(7), CSE6230_SECOND(6), CSE6230_SECOND(5), CSE6230_SECOND(4), CSE6230_SECOND(3), CSE6230_SECOND(2), CSE6230_SECOND(1), CSE6230_SECOND(0));
+	#undef CSE6230_FIRST
+	#undef CSE6230_SECOND
+	return _mm512_permutex2var_epi64(_mm512_permutex2var_epi64(a, firstIndex, b), secondIndex, c);
+}
+
+inline static void avx512f_transpose3_ps(__m512 a, __m512 b, __m512 c, __m512& x, __m512& y, __m512& z) {
+	x = avx512f_extract3_ps<0>(a, b, c);
+	y = avx512f_extract3_ps<1>(a, b, c);
+	z = avx512f_extract3_ps<2>(a, b, c);
+}
+
+inline static __m512 avx512f_load_bf16(const bfloat16* pointer) {
+	const __m512i bits = _mm512_cvtepu16_epi32(_mm256_loadu_si256((const __m256i*)pointer));
+	return _mm512_castsi512_ps(_mm512_slli_epi32(bits, 16));
+}
+
+template <>
+struct simd3<float, isa_avx512f> {
+	typedef __m512 vector;
+	static const size_t width = 16;
+
+	static void load3(const float* pointer, vector& x, vector& y, vector& z) {
+		avx512f_transpose3_ps(_mm512_loadu_ps(pointer), _mm512_loadu_ps(pointer + 16), _mm512_loadu_ps(pointer + 32), x, y, z);
+	}
+	static vector mul(vector a, vector b) { return _mm512_mul_ps(a, b); }
+	static vector add(vector a, vector b) { return _mm512_add_ps(a, b); }
+	static void store(float* pointer, vector x) { _mm512_storeu_ps(pointer, x); }
+};
+
+template <>
+struct simd3<bfloat16, isa_avx512f> : simd3<float, isa_avx512f> {
+	static void load3(const bfloat16* pointer, vector& x, vector& y, vector& z) {
+		avx512f_transpose3_ps(avx512f_load_bf16(pointer), avx512f_load_bf16(pointer + 16), avx512f_load_bf16(pointer + 32), x, y, z);
+	}
+};
+
+template <>
+struct simd3<int32_t, isa_avx512f> {
+	typedef __m512i vector;
+	static const size_t width = 16;
+
+	static void load3(const int32_t* pointer, vector& x, vector& y, vector& z) {
+		__m512 xFloat, yFloat, zFloat;
+		avx512f_transpose3_ps(_mm512_loadu_ps((const float*)pointer), _mm512_loadu_ps((const float*)pointer + 16), _mm512_loadu_ps((const float*)pointer + 32), xFloat, yFloat, zFloat);
+		x = _mm512_castps_si512(xFloat);
+		y = _mm512_castps_si512(yFloat);
+		z = _mm512_castps_si512(zFloat);
+	}
+	static vector mul(vector a, vector b) { return _mm512_mullo_epi32(a, b); }
+	static vector add(vector a, vector b) { return _mm512_add_epi32(a, b); }
+	static void store(int32_t* pointer, vector x) { _mm512_storeu_si512(pointer, x); }
+};
+
+template <>
+struct simd3<int64_t, isa_avx512f> {
+	typedef __m512i vector;
+	static const size_t width = 8;
+
+	static void load3(const int64_t* pointer, vector& x, vector& y, vector& z) {
+		const __m512i a = _mm512_loadu_si512(pointer);
+		const __m512i b = _mm512_loadu_si512(pointer + 8);
+		const __m512i c = _mm512_loadu_si512(pointer + 16);
+		x = avx512f_extract3_epi64<0>(a, b, c);
+		y = avx512f_extract3_epi64<1>(a, b, c);
+		z = avx512f_extract3_epi64<2>(a, b, c);
+	}
+	static vector mul(vector a, vector b) { return _mm512_mullox_epi64(a, b); }
+	static vector add(vector a, vector b) { return _mm512_add_epi64(a, b); }
+	static void store(int64_t* pointer, vector x) { _mm512_storeu_si512(pointer, x); }
+};
+#endif
+
+template <typename T, typename ISA>
+void vector3d_dot_products(const T *CSE6230_RESTRICT vPointer, const T *CSE6230_RESTRICT uPointer, typename dot_product_result<T>::type *CSE6230_RESTRICT dpPointer, size_t vectorsCount) {
+	typedef simd3<T, ISA> simd;
+	// Process arrays by one SIMD vector of dot products at an iteration
+	for (; vectorsCount >= simd::width; vectorsCount -= simd::width) {
+		typename simd::vector vX, vY, vZ, uX, uY, uZ;
+		simd::load3(vPointer, vX, vY, vZ);
+		simd::load3(uPointer, uX, uY, uZ);
+
+		const typename simd::vector dp = simd::add(simd::add(simd::mul(vX, uX), simd::mul(vY, uY)), simd::mul(vZ, uZ));
+		simd::store(dpPointer, dp);
+
+		vPointer += 3 * simd::width;
+		uPointer += 3 * simd::width;
+		dpPointer += simd::width;
+	}
+	// Process remaining vectors (if any)
+	for (; vectorsCount != 0; vectorsCount -= 1) {
+		*dpPointer = scalar_dot_product(vPointer, uPointer);
+
+		// Advance pointers to the next 3-element vectors
+		vPointer += 3;
+		uPointer += 3;
+		// Advance pointer to the next dot product
+		dpPointer += 1;
+	}
+}
+
+template <typename T>
+void vector3d_dot_products_naive(const T *CSE6230_RESTRICT vPointer, const T *CSE6230_RESTRICT uPointer, typename dot_product_result<T>::type *CSE6230_RESTRICT dpPointer, size_t vectorsCount) {
+	for (; vectorsCount != 0; vectorsCount -= 1) {
+		*dpPointer = scalar_dot_product(vPointer, uPointer);
+
+		vPointer += 3;
+		uPointer += 3;
+		dpPointer += 1;
+	}
+}
+
+#define CSE6230_INSTANTIATE_DOT_PRODUCTS(T, ISA) \
+	template void vector3d_dot_products<T, ISA>(const T*, const T*, dot_product_result<T>::type*, size_t);
+
+#define CSE6230_INSTANTIATE_NAIVE_DOT_PRODUCTS(T) \
+	template <> void vector3d_dot_products<T, isa_naive>(const T *CSE6230_RESTRICT vPointer, const T *CSE6230_RESTRICT uPointer, dot_product_result<T>::type *CSE6230_RESTRICT dpPointer, size_t vectorsCount) { \
+		vector3d_dot_products_naive<T>(vPointer, uPointer, dpPointer, vectorsCount); \
+	}
+
+#define CSE6230_INSTANTIATE_ALL_TYPES(ISA) \
+	CSE6230_INSTANTIATE_DOT_PRODUCTS(float, ISA) \
+	CSE6230_INSTANTIATE_DOT_PRODUCTS(int32_t, ISA) \
+	CSE6230_INSTANTIATE_DOT_PRODUCTS(int64_t, ISA) \
+	CSE6230_INSTANTIATE_DOT_PRODUCTS(bfloat16, ISA)
+
+CSE6230_INSTANTIATE_NAIVE_DOT_PRODUCTS(float)
+CSE6230_INSTANTIATE_NAIVE_DOT_PRODUCTS(int32_t)
+CSE6230_INSTANTIATE_NAIVE_DOT_PRODUCTS(int64_t)
+CSE6230_INSTANTIATE_NAIVE_DOT_PRODUCTS(bfloat16)
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+	CSE6230_INSTANTIATE_ALL_TYPES(isa_sse2)
+#endif
+#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+	CSE6230_INSTANTIATE_DOT_PRODUCTS(float, isa_avx)
+	CSE6230_INSTANTIATE_DOT_PRODUCTS(bfloat16, isa_avx)
+#endif
+#ifdef CSE6230_AVX2_INTRINSICS_SUPPORTED
+	CSE6230_INSTANTIATE_ALL_TYPES(isa_avx2)
+#endif
+#ifdef CSE6230_AVX512F_INTRINSICS_SUPPORTED
+	CSE6230_INSTANTIATE_ALL_TYPES(isa_avx512f)
+#endif
@@ -0,0 +1,53 @@
+/******************************************************************************\
+ *                                                                            *
+ * Copyright (c) 2012 Marat Dukhan                                            *
+ *                                                                            *
+ * This software is provided 'as-is', without any express or implied          *
+ * warranty. In no event will the authors be held liable for any damages      *
+ * arising from the use of this software.                                     *
+ *                                                                            *
+ * Permission is granted to anyone to use this software for any purpose,      *
+ * including commercial applications, and to alter it and redistribute it     *
+ * freely, subject to the following restrictions:                             *
+ *                                                                            *
+ * 1. The origin of this software must not be misrepresented; you must not    *
+ * claim that you wrote the original software. If you use this software       *
+ * in a product, an acknowledgment in the product documentation would be      *
+ * appreciated but is not required.                                           *
+ *                                                                            *
+ * 2. Altered source versions must be plainly marked as such, and must not be *
+ * misrepresented as being the original software.                             *
+ *                                                                            *
+ * 3. This notice may not be removed or altered from any source               *
+ * distribution.                                                              *
+ *                                                                            *
+\******************************************************************************/
+
+#pragma once
+
+#include <compute.hpp>
+#include <formats.hpp>
+#include <isa.hpp>
+
+// Element-type-generic versions of the vector3d_dot_products kernels.
+// Supported element types are float, int32_t, int64_t (wrapping arithmetic) and bfloat16.
+
+// Dot products of bfloat16 vectors (see formats.hpp) are computed and stored in single precision.
+
+template <typename T>
+struct dot_product_result {
+	typedef T type;
+};
+
+template <>
+struct dot_product_result<bfloat16> {
+	typedef float type;
+};
+
+
+template <typename T, typename ISA>
+void vector3d_dot_products(const T *CSE6230_RESTRICT vPointer, const T *CSE6230_RESTRICT uPointer, typename dot_product_result<T>::type *CSE6230_RESTRICT dpPointer, size_t vectorsCount);
+
+// Instantiations in typed.cpp:
+//   isa_naive, isa_sse2, isa_avx2 and isa_avx512f: all element types
+//   isa_avx: float and bfloat16 (AVX has no 256-bit integer instructions)
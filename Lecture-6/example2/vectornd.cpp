@@ -0,0 +1,275 @@
+/******************************************************************************\
+ *                                                                            *
+ * Copyright (c) 2012 Marat Dukhan                                            *
+ *                                                                            *
+ * This software is provided 'as-is', without any express or implied          *
+ * warranty. In no event will the authors be held liable for any damages      *
+ * arising from the use of this software.                                     *
+ *                                                                            *
+ * Permission is granted to anyone to use this software for any purpose,      *
+ * including commercial applications, and to alter it and redistribute it     *
+ * freely, subject to the following restrictions:                             *
+ *                                                                            *
+ * 1. The origin of this software must not be misrepresented; you must not    *
+ * claim that you wrote the original software. If you use this software       *
+ * in a product, an acknowledgment in the product documentation would be      *
+ * appreciated but is not required.                                           *
+ *                                                                            *
+ * 2. Altered source versions must be plainly marked as such, and must not be *
+ * misrepresented as being the original software.                             *
+ *                                                                            *
+ * 3. This notice may not be removed or altered from any source               *
+ * distribution.                                                              *
+ *                                                                            *
+\******************************************************************************/
+
+#include <vectornd.hpp>
+#if defined(CSE6230_SSE2_INTRINSICS_SUPPORTED) || defined(CSE6230_AVX_INTRINSICS_SUPPORTED)
+	#if defined(__GNUC__)
+		#include <x86intrin.h>
+	#elif defined(_MSC_VER)
+		#include <intrin.h>
+	#else
+		#error Intrinsics headers are not included: unknown compiler
+	#endif
+#endif
+
+// Operations on SIMD vectors of doubles. Each specialization provides:
+//   width: number of doubles in a SIMD vector
+//   load(pointer), load_partial(pointer, count): (partial) unaligned loads; lanes beyond count are zero
+//   add, mul, zero
+//   store(pointer, vector): unaligned store
+//   transpose_add(sums): given width vectors, returns a vector with the horizontal sum of sums[i] in lane i
+template <typename ISA>
+struct vectornd_simd;
+
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+template <>
+struct vectornd_simd<isa_sse2> {
+	typedef __m128d vector;
+	static const size_t width = 2;
+
+	static vector load(const double* pointer) { return _mm_loadu_pd(pointer); }
+	static vector load_partial(const double* pointer, size_t) { return _mm_load_sd(pointer); }
+	static vector zero() { return _mm_setzero_pd(); }
+	static vector add(vector a, vector b) { return _mm_add_pd(a, b); }
+	static vector mul(vector a, vector b) { return _mm_mul_pd(a, b); }
+	static void store(double* pointer, vector v) { _mm_storeu_pd(pointer, v); }
+
+	static vector transpose_add(const vector sums[2]) {
+		// (a0 + a1, b0 + b1)
+		return _mm_add_pd(_mm_unpacklo_pd(sums[0], sums[1]), _mm_unpackhi_pd(sums[0], sums[1]));
+	}
+};
+#endif
+
+#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+template <>
+struct vectornd_simd<isa_avx> {
+	typedef __m256d vector;
+	static const size_t width = 4;
+
+	static vector load(const double* pointer) { return _mm256_loadu_pd(pointer); }
+	static vector load_partial(const double* pointer, size_t count) {
+		// count is a compile-time constant in the fixed-dimension kernels, so the mask is a constant too
+		const __m256i mask = _mm256_set_epi64x(count > 3 ? -1 : 0, count > 2 ? -1 : 0, count > 1 ? -1 : 0, count > 0 ? -1 : 0);
+		return _mm256_maskload_pd(pointer, mask);
+	}
+	static vector zero() { return _mm256_setzero_pd(); }
+	static vector add(vector a, vector b) { return _mm256_add_pd(a, b); }
+	static vector mul(vector a, vector b) { return _mm256_mul_pd(a, b); }
+	static void store(double* pointer, vector v) { _mm256_storeu_pd(pointer, v); }
+
+	static vector transpose_add(const vector sums[4]) {
+		// Within 128-bit lanes: (a0 + a1, b0 + b1 | a2 + a3, b2 + b3)
+		const __m256d ab = _mm256_add_pd(_mm256_unpacklo_pd(sums[0], sums[1]), _mm256_unpackhi_pd(sums[0], sums[1]));
+		// Within 128-bit lanes: (c0 + c1, d0 + d1 | c2 + c3, d2 + d3)
+		const __m256d cd = _mm256_add_pd(_mm256_unpacklo_pd(sums[2], sums[3]), _mm256_unpackhi_pd(sums[2], sums[3]));
+		// Across 128-bit lanes: (a, b, c, d)
+		return _mm256_add_pd(_mm256_permute2f128_pd(ab, cd, 0x20), _mm256_permute2f128_pd(ab, cd, 0x31));
+	}
+};
+#endif
+
+#ifdef CSE6230_AVX512F_INTRINSICS_SUPPORTED
+template <>
+struct vectornd_simd<isa_avx512f> {
+	typedef __m512d vector;
+	static const size_t width = 8;
+
+	static vector load(const double* pointer) { return _mm512_loadu_pd(pointer); }
+	static vector load_partial(const double* pointer, size_t count) {
+		return _mm512_maskz_loadu_pd(__mmask8((1u << count) - 1), pointer);
+	}
+	static vector zero() { return _mm512_setzero_pd(); }
+	static vector add(vector a, vector b) { return _mm512_add_pd(a, b); }
+	static vector mul(vector a, vector b) { return _mm512_mul_pd(a, b); }
+	static void store(double* pointer, vector v) { _mm512_storeu_pd(pointer, v); }
+
+	static vector transpose_add(const vector sums[8]) {
+		// Each 128-bit lane of ab holds partial sums (a, b), of cd holds (c, d), etc
+		const __m512d ab = _mm512_add_pd(_mm512_unpacklo_pd(sums[0], sums[1]), _mm512_unpackhi_pd(sums[0], sums[1]));
+		const __m512d cd = _mm512_add_pd(_mm512_unpacklo_pd(sums[2], sums[3]), _mm512_unpackhi_pd(sums[2], sums[3]));
+		const __m512d ef = _mm512_add_pd(_mm512_unpacklo_pd(sums[4], sums[5]), _mm512_unpackhi_pd(sums[4], sums[5]));
+		const __m512d gh = _mm512_add_pd(_mm512_unpacklo_pd(sums[6], sums[7]), _mm512_unpackhi_pd(sums[6], sums[7]));
+		// 128-bit lanes: ((a, b), (a, b), (c, d), (c, d)), each (a, b) the sum of two lanes of ab
+		const __m512d abcd = _mm512_add_pd(_mm512_shuffle_f64x2(ab, cd, _MM_SHUFFLE(2, 0, 2, 0)), _mm512_shuffle_f64x2(ab, cd, _MM_SHUFFLE(3, 1, 3, 1)));
+		const __m512d efgh = _mm512_add_pd(_mm512_shuffle_f64x2(ef, gh, _MM_SHUFFLE(2, 0, 2, 0)), _mm512_shuffle_f64x2(ef, gh, _MM_SHUFFLE(3, 1, 3, 1)));
+		// (a, b, c, d, e, f, g, h)
+		return _mm512_add_pd(_mm512_shuffle_f64x2(abcd, efgh, _MM_SHUFFLE(2, 0, 2, 0)), _mm512_shuffle_f64x2(abcd, efgh, _MM_SHUFFLE(3, 1, 3, 1)));
+	}
+};
+#endif
+
+// N is the compile-time dimension; N = 0 means the dimension is only known at runtime (passed as dimension).
+template <size_t N, typename ISA>
+static void dot_products(const double *CSE6230_RESTRICT vPointer, const double *CSE6230_RESTRICT uPointer, double *CSE6230_RESTRICT dpPointer, size_t vectorsCount, size_t dimension) {
+	typedef vectornd_simd<ISA> simd;
+	if (N != 0) {
+		dimension = N;
+	}
+	// Every N-dimensional vector is loaded with fullLoads full SIMD loads and, if partialLength is non-zero, one partial load
+	const size_t fullLoads = dimension / simd::width;
+	const size_t partialLength = dimension % simd::width;
+	// Process arrays by one SIMD vector of dot products at an iteration
+	for (; vectorsCount >= simd::width; vectorsCount -= simd::width) {
+		typename simd::vector sums[simd::width];
+		for (size_t lane = 0; lane < simd::width; lane++) {
+			const double* v = vPointer + lane * dimension;
+			const double* u = uPointer + lane * dimension;
+			typename simd::vector sum = simd::zero();
+			for (size_t load = 0; load < fullLoads; load++) {
+				sum = simd::add(sum, simd::mul(simd::load(v), simd::load(u)));
+				v += simd::width;
+				u += simd::width;
+			}
+			if (partialLength != 0) {
+				sum = simd::add(sum, simd::mul(simd::load_partial(v, partialLength), simd::load_partial(u, partialLength)));
+			}
+			sums[lane] = sum;
+		}
+		simd::store(dpPointer, simd::transpose_add(sums));
+
+		vPointer += simd::width * dimension;
+		uPointer += simd::width * dimension;
+		dpPointer += simd::width;
+	}
+	// Process remaining vectors (if any)
+	for (; vectorsCount != 0; vectorsCount -= 1) {
+		double dp = 0.0;
+		for (size_t k = 0; k < dimension; k++) {
+			dp += vPointer[k] * uPointer[k];
+		}
+		*dpPointer = dp;
+
+		// Advance pointers to the next N-dimensional vectors
+		vPointer += dimension;
+		uPointer += dimension;
+		// Advance pointer to the next dot product
+		dpPointer += 1;
+	}
+}
+
+template <size_t N>
+static void dot_products_naive(const double *CSE6230_RESTRICT vPointer, const double *CSE6230_RESTRICT uPointer, double *CSE6230_RESTRICT dpPointer, size_t vectorsCount, size_t dimension) {
+	if (N != 0) {
+		dimension = N;
+	}
+	for (; vectorsCount != 0; vectorsCount -= 1) {
+		double dp = 0.0;
+		for (size_t k = 0; k < dimension; k++) {
+			dp += vPointer[k] * uPointer[k];
+		}
+		*dpPointer = dp;
+
+		vPointer += dimension;
+		uPointer += dimension;
+		dpPointer += 1;
+	}
+}
+
+template <size_t N, typename ISA>
+void vectornd_dot_products(const double *CSE6230_RESTRICT vPointer, const double *CSE6230_RESTRICT uPointer, double *CSE6230_RESTRICT dpPointer, size_t vectorsCount) {
+	dot_products<N, ISA>(vPointer, uPointer, dpPointer, vectorsCount, N);
+}
+
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+// For 3D vectors the hand-written shuffles load two vectors with three full loads instead of four partial ones
+template <>
+void vectornd_dot_products<3, isa_sse2>(const double *CSE6230_RESTRICT vPointer, const double *CSE6230_RESTRICT uPointer, double *CSE6230_RESTRICT dpPointer, size_t vectorsCount) {
+	vector3d_dot_products_sse2(vPointer, uPointer, dpPointer, vectorsCount);
+}
+#endif
+
+#define CSE6230_SPECIALIZE_NAIVE_DOT_PRODUCTS(N) \
+	template <> void vectornd_dot_products<N, isa_naive>(const double *CSE6230_RESTRICT vPointer, const double *CSE6230_RESTRICT uPointer, double *CSE6230_RESTRICT dpPointer, size_t vectorsCount) { \
+		dot_products_naive<N>(vPointer, uPointer, dpPointer, vectorsCount, N); \
+	}
+
+#define CSE6230_INSTANTIATE_DOT_PRODUCTS(N, ISA) \
+	template void vectornd_dot_products<N, ISA>(const double*, const double*, double*, size_t);
+
+#define CSE6230_INSTANTIATE_ALL_DIMENSIONS(ISA) \
+	CSE6230_INSTANTIATE_DOT_PRODUCTS(1, ISA) \
+	CSE6230_INSTANTIATE_DOT_PRODUCTS(2, ISA) \
+	CSE6230_INSTANTIATE_DOT_PRODUCTS(3, ISA) \
+	CSE6230_INSTANTIATE_DOT_PRODUCTS(4, ISA) \
+	CSE6230_INSTANTIATE_DOT_PRODUCTS(5, ISA) \
+	CSE6230_INSTANTIATE_DOT_PRODUCTS(6, ISA) \
+	CSE6230_INSTANTIATE_DOT_PRODUCTS(7, ISA) \
+	CSE6230_INSTANTIATE_DOT_PRODUCTS(8, ISA)
+
+CSE6230_SPECIALIZE_NAIVE_DOT_PRODUCTS(1)
+CSE6230_SPECIALIZE_NAIVE_DOT_PRODUCTS(2)
+CSE6230_SPECIALIZE_NAIVE_DOT_PRODUCTS(3)
+CSE6230_SPECIALIZE_NAIVE_DOT_PRODUCTS(4)
+CSE6230_SPECIALIZE_NAIVE_DOT_PRODUCTS(5)
+CSE6230_SPECIALIZE_NAIVE_DOT_PRODUCTS(6)
+CSE6230_SPECIALIZE_NAIVE_DOT_PRODUCTS(7)
+CSE6230_SPECIALIZE_NAIVE_DOT_PRODUCTS(8)
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+	CSE6230_INSTANTIATE_ALL_DIMENSIONS(isa_sse2)
+#endif
+#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+	CSE6230_INSTANTIATE_ALL_DIMENSIONS(isa_avx)
+#endif
+#ifdef CSE6230_AVX512F_INTRINSICS_SUPPORTED
+	CSE6230_INSTANTIATE_ALL_DIMENSIONS(isa_avx512f)
+#endif
+
+// Runtime-dimension entry points
+
+#define CSE6230_DISPATCH_DIMENSION(ISA, GENERIC) \
+	switch (dimension) { \
+		case 1: vectornd_dot_products<1, ISA>(vPointer, uPointer, dpPointer, vectorsCount); break; \
+		case 2: vectornd_dot_products<2, ISA>(vPointer, uPointer, dpPointer, vectorsCount); break; \
+		case 3: vectornd_dot_products<3, ISA>(vPointer, uPointer, dpPointer, vectorsCount); break; \
+		case 4: vectornd_dot_products<4, ISA>(vPointer, uPointer, dpPointer, vectorsCount); break; \
+		case 5: vectornd_dot_products<5, ISA>(vPointer, uPointer, dpPointer, vectorsCount); break; \
+		case 6: vectornd_dot_products<6, ISA>(vPointer, uPointer, dpPointer, vectorsCount); break; \
+		case 7: vectornd_dot_products<7, ISA>(vPointer, uPointer, dpPointer, vectorsCount); break; \
+		case 8: vectornd_dot_products<8, ISA>(vPointer, uPointer, dpPointer, vectorsCount); break; \
+		default: GENERIC(vPointer, uPointer, dpPointer, vectorsCount, dimension); break; \
+	}
+
+void vectornd_dot_products_naive(const double *CSE6230_RESTRICT vPointer, const double *CSE6230_RESTRICT uPointer, double *CSE6230_RESTRICT dpPointer, size_t vectorsCount, size_t dimension) {
+	CSE6230_DISPATCH_DIMENSION(isa_naive, dot_products_naive<0>)
+}
+
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+void vectornd_dot_products_sse2(const double *CSE6230_RESTRICT vPointer, const double *CSE6230_RESTRICT uPointer, double *CSE6230_RESTRICT dpPointer, size_t vectorsCount, size_t dimension) {
+	CSE6230_DISPATCH_DIMENSION(isa_sse2, (dot_products<0, isa_sse2>))
+}
+#endif
+
+#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+void vectornd_dot_products_avx(const double *CSE6230_RESTRICT vPointer, const double *CSE6230_RESTRICT uPointer, double *CSE6230_RESTRICT dpPointer, size_t vectorsCount, size_t dimension) {
+	CSE6230_DISPATCH_DIMENSION(isa_avx, (dot_products<0, isa_avx>))
+}
+#endif
+
+#ifdef CSE6230_AVX512F_INTRINSICS_SUPPORTED
+void vectornd_dot_products_avx512f(const double *CSE6230_RESTRICT vPointer, const double *CSE6230_RESTRICT uPointer, double *CSE6230_RESTRICT dpPointer, size_t vectorsCount, size_t dimension) {
+	CSE6230_DISPATCH_DIMENSION(isa_avx512f, (dot_products<0, isa_avx512f>))
+}
+#endif
@@ -0,0 +1,52 @@
+/******************************************************************************\
+ *                                                                            *
+ * Copyright (c) 2012 Marat Dukhan                                            *
+ *                                                                            *
+ * This software is provided 'as-is', without any express or implied          *
+ * warranty. In no event will the authors be held liable for any damages      *
+ * arising from the use of this software.                                     *
+ *                                                                            *
+ * Permission is granted to anyone to use this software for any purpose,      *
+ * including commercial applications, and to alter it and redistribute it     *
+ * freely, subject to the following restrictions:                             *
+ *                                                                            *
+ * 1. The origin of this software must not be misrepresented; you must not    *
+ * claim that you wrote the original software. If you use this software       *
+ * in a product, an acknowledgment in the product documentation would be      *
+ * appreciated but is not required.                                           *
+ *                                                                            *
+ * 2. Altered source versions must be plainly marked as such, and must not be *
+ * misrepresented as being the original software.                             *
+ *                                                                            *
+ * 3. This notice may not be removed or altered from any source               *
+ * distribution.                                                              *
+ *                                                                            *
+\******************************************************************************/
+
+#pragma once
+
+#include <compute.hpp>
+#include <isa.hpp>
+
+// Dot products of N-dimensional vectors of doubles: dp[i] = sum(v[N * i + k] * u[N * i + k] for k in 0..N-1).
+// Each iteration computes one SIMD vector of dot products: it loads every input vector with N / width full and one
+// partial (masked) load, accumulates the products, and transposes and reduces the per-vector sums with a shuffle network
+// for the instruction set. N is known at compile time, so the number of loads and the masks are constant.
+// Instantiated for N = 1..8 and instruction set tags isa_naive, isa_sse2, isa_avx and isa_avx512f. For N = 3 the SSE2
+// instantiation uses the hand-written vector3d_dot_products_sse2 kernel.
+template <size_t N, typename ISA>
+void vectornd_dot_products(const double *CSE6230_RESTRICT vPointer, const double *CSE6230_RESTRICT uPointer, double *CSE6230_RESTRICT dpPointer, size_t vectorsCount);
+
+// Runtime-dimension versions: dimensions 1..8 use the compile-time instantiations above, larger ones a generic loop.
+typedef void (*vectornd_dot_products_function)(const double*, const double*, double*, size_t, size_t);
+
+extern "C" void vectornd_dot_products_naive(const double *CSE6230_RESTRICT vPointer, const double *CSE6230_RESTRICT uPointer, double *CSE6230_RESTRICT dpPointer, size_t vectorsCount, size_t dimension);
+#ifdef CSE6230_SSE2_INTRINSICS_SUPPORTED
+extern "C" void vectornd_dot_products_sse2(const double *CSE6230_RESTRICT vPointer, const double *CSE6230_RESTRICT uPointer, double *CSE6230_RESTRICT dpPointer, size_t vectorsCount, size_t dimension);
+#endif
+#ifdef CSE6230_AVX_INTRINSICS_SUPPORTED
+extern "C" void vectornd_dot_products_avx(const double *CSE6230_RESTRICT vPointer, const double *CSE6230_RESTRICT uPointer, double *CSE6230_RESTRICT dpPointer, size_t vectorsCount, size_t dimension);
+#endif
+#ifdef CSE6230_AVX512F_INTRINSICS_SUPPORTED
+extern "C" void vectornd_dot_products_avx512f(const double *CSE6230_RESTRICT vPointer, const double *CSE6230_RESTRICT uPointer, double *CSE6230_RESTRICT dpPointer, size_t vectorsCount, size_t dimension);
+#endif